@@ -5,19 +5,84 @@
 
 #include "AudioEngineQt.h"
 #include "JuceAudioEngine.h"
+#include "LockProfiler.h"
 #include <QDebug>
+#include <QJsonObject>
+#include <QMetaObject>
+#include <QStandardPaths>
 
 namespace CueForge {
 
+    namespace {
+        bool eqFromJson(const QJsonArray& bands, std::vector<EqBand>& eq)
+        {
+            eq.clear();
+            for (const QJsonValue& value : bands) {
+                const QJsonObject bandObj = value.toObject();
+
+                EqBand band;
+                if (!EqBand::typeFromString(bandObj.value("type").toString("peak").toStdString(), band.type)) {
+                    return false;
+                }
+                band.frequency = bandObj.value("frequency").toDouble(1000.0);
+                band.gainDb = bandObj.value("gainDb").toDouble(0.0);
+                band.q = bandObj.value("q").toDouble(0.7071);
+                eq.push_back(band);
+            }
+            return true;
+        }
+
+        QJsonArray eqToJson(const std::vector<EqBand>& eq)
+        {
+            QJsonArray bands;
+            for (const EqBand& band : eq) {
+                QJsonObject bandObj;
+                bandObj.insert("type", QString::fromLatin1(EqBand::typeToString(band.type)));
+                bandObj.insert("frequency", band.frequency);
+                bandObj.insert("gainDb", band.gainDb);
+                bandObj.insert("q", band.q);
+                bands.append(bandObj);
+            }
+            return bands;
+        }
+    }
+
     AudioEngineQt::AudioEngineQt(QObject* parent)
         : QObject(parent)
         , juceEngine_(std::make_unique<JuceAudioEngine>())
     {
+        // Engine calls arrive on the thread that owns this bridge
+        LockProfiler::setThreadName("main");
+
+        // Results arrive on the analysis thread; the cache is written each
+        // time the queue empties
+        LoudnessAnalyzer& analyzer = juceEngine_->getLoudnessAnalyzer();
+        analyzer.loadCache(loudnessCachePath().toStdString());
+        analyzer.setListener([this](const std::string& path, int remaining) {
+            const QString filePath = QString::fromStdString(path);
+            QMetaObject::invokeMethod(this, [this, filePath, remaining]() {
+                emit loudnessAnalysed(filePath);
+                if (remaining == 0) {
+                    saveLoudnessCache();
+                }
+            }, Qt::QueuedConnection);
+        });
     }
 
     AudioEngineQt::~AudioEngineQt()
     {
         shutdown();
+
+        if (juceEngine_) {
+            juceEngine_->getLoudnessAnalyzer().setListener(nullptr);
+            saveLoudnessCache();
+        }
+    }
+
+    void AudioEngineQt::setNullAudio(const QString& spec)
+    {
+        useNullAudio_ = true;
+        nullAudioSpec_ = spec;
     }
 
     bool AudioEngineQt::initialize()
@@ -27,6 +92,10 @@ namespace CueForge {
             return false;
         }
 
+        if (useNullAudio_) {
+            return initializeNull(nullAudioSpec_);
+        }
+
         if (juceEngine_->initialize()) {
             qDebug() << "AudioEngineQt: Initialized successfully";
             return true;
@@ -36,6 +105,29 @@ namespace CueForge {
         return false;
     }
 
+    bool AudioEngineQt::initializeNull(const QString& spec)
+    {
+        if (!juceEngine_) {
+            emit error("Audio engine not created");
+            return false;
+        }
+
+        NullAudioSettings settings;
+        std::string parseError;
+        if (!NullAudioSettings::parse(spec.toStdString(), settings, &parseError)) {
+            emit error("Invalid null audio device spec: " + QString::fromStdString(parseError));
+            return false;
+        }
+
+        if (juceEngine_->initializeNull(settings)) {
+            qDebug() << "AudioEngineQt: Initialized on null device" << spec;
+            return true;
+        }
+
+        emit error("Failed to initialize null audio device");
+        return false;
+    }
+
     void AudioEngineQt::shutdown()
     {
         if (juceEngine_) {
@@ -135,6 +227,30 @@ namespace CueForge {
         return true;
     }
 
+    bool AudioEngineQt::crossfade(int fadeInPlayerId, const QList<int>& fadeOutPlayerIds, double seconds,
+        bool equalPower)
+    {
+        if (!juceEngine_) {
+            return false;
+        }
+
+        std::string fadeError;
+        const std::vector<int> fadeOut(fadeOutPlayerIds.begin(), fadeOutPlayerIds.end());
+        if (!juceEngine_->crossfadePlayers(fadeInPlayerId, fadeOut, seconds,
+                equalPower ? FadeCurve::EqualPower : FadeCurve::Linear, &fadeError)) {
+            emit error(QString("Crossfade failed: %1").arg(QString::fromStdString(fadeError)));
+            return false;
+        }
+
+        emit playbackStarted(fadeInPlayerId);
+        return true;
+    }
+
+    bool AudioEngineQt::isFadedOut(int playerId) const
+    {
+        return juceEngine_ && juceEngine_->isPlayerFadedOut(playerId);
+    }
+
     void AudioEngineQt::stop(int playerId)
     {
         if (!juceEngine_) {
@@ -249,4 +365,935 @@ namespace CueForge {
         return player ? player->getDuration() : 0.0;
     }
 
+    bool AudioEngineQt::setOutputDelay(int outputChannel, double delayMs)
+    {
+        if (!juceEngine_) {
+            return false;
+        }
+
+        OutputSettings settings = juceEngine_->getOutputSettings(outputChannel);
+        settings.delayMs = delayMs;
+        if (!juceEngine_->setOutputSettings(outputChannel, settings)) {
+            emit error(QString("Invalid delay for output %1: %2 ms").arg(outputChannel + 1).arg(delayMs));
+            return false;
+        }
+        return true;
+    }
+
+    bool AudioEngineQt::setOutputTrim(int outputChannel, double trimDb)
+    {
+        if (!juceEngine_) {
+            return false;
+        }
+
+        OutputSettings settings = juceEngine_->getOutputSettings(outputChannel);
+        settings.trimDb = trimDb;
+        return juceEngine_->setOutputSettings(outputChannel, settings);
+    }
+
+    bool AudioEngineQt::setOutputEq(int outputChannel, const QJsonArray& bands)
+    {
+        if (!juceEngine_) {
+            return false;
+        }
+
+        OutputSettings settings = juceEngine_->getOutputSettings(outputChannel);
+        if (!eqFromJson(bands, settings.eq) || !juceEngine_->setOutputSettings(outputChannel, settings)) {
+            emit error(QString("Invalid EQ for output %1").arg(outputChannel + 1));
+            return false;
+        }
+        return true;
+    }
+
+    QJsonArray AudioEngineQt::outputProcessing() const
+    {
+        QJsonArray outputs;
+        if (!juceEngine_) {
+            return outputs;
+        }
+
+        for (int output = 0; output < OutputProcessor::MaxOutputs; ++output) {
+            const OutputSettings settings = juceEngine_->getOutputSettings(output);
+            if (settings.isNeutral()) {
+                continue;
+            }
+
+            QJsonObject outputObj;
+            outputObj.insert("output", output);
+            outputObj.insert("delayMs", settings.delayMs);
+            outputObj.insert("trimDb", settings.trimDb);
+            outputObj.insert("eq", eqToJson(settings.eq));
+            outputs.append(outputObj);
+        }
+        return outputs;
+    }
+
+    bool AudioEngineQt::setOutputProcessing(const QJsonArray& outputs)
+    {
+        if (!juceEngine_) {
+            return false;
+        }
+
+        // Outputs not listed go back to neutral
+        bool ok = true;
+        std::vector<bool> listed(OutputProcessor::MaxOutputs, false);
+        for (const QJsonValue& value : outputs) {
+            const QJsonObject outputObj = value.toObject();
+            const int output = outputObj.value("output").toInt(-1);
+
+            OutputSettings settings;
+            settings.delayMs = outputObj.value("delayMs").toDouble(0.0);
+            settings.trimDb = outputObj.value("trimDb").toDouble(0.0);
+            if (output < 0 || output >= OutputProcessor::MaxOutputs
+                || !eqFromJson(outputObj.value("eq").toArray(), settings.eq)
+                || !juceEngine_->setOutputSettings(output, settings)) {
+                qWarning() << "AudioEngineQt::setOutputProcessing() - Skipping invalid entry for output" << output;
+                ok = false;
+                continue;
+            }
+            listed[output] = true;
+        }
+
+        for (int output = 0; output < OutputProcessor::MaxOutputs; ++output) {
+            if (!listed[output]) {
+                juceEngine_->setOutputSettings(output, OutputSettings());
+            }
+        }
+        return ok;
+    }
+
+    int AudioEngineQt::reverbBusCount() const
+    {
+        return JuceAudioEngine::MaxReverbBuses;
+    }
+
+    bool AudioEngineQt::loadReverbImpulse(int bus, const QString& filePath)
+    {
+        if (!juceEngine_) {
+            return false;
+        }
+
+        std::string loadError;
+        if (!juceEngine_->loadReverbImpulse(bus, filePath.toStdString(), &loadError)) {
+            emit error(QString("Failed to load reverb %1: %2").arg(bus + 1).arg(QString::fromStdString(loadError)));
+            return false;
+        }
+
+        qDebug() << "AudioEngineQt::loadReverbImpulse() - Bus" << bus + 1 << "loaded" << filePath;
+        return true;
+    }
+
+    void AudioEngineQt::clearReverbImpulse(int bus)
+    {
+        if (juceEngine_) {
+            juceEngine_->clearReverbImpulse(bus);
+        }
+    }
+
+    void AudioEngineQt::setReverbReturn(int bus, double gainDb, int firstOutput)
+    {
+        if (juceEngine_) {
+            juceEngine_->setReverbReturn(bus, juce::Decibels::decibelsToGain(static_cast<float>(gainDb)), firstOutput);
+        }
+    }
+
+    bool AudioEngineQt::setReverbSend(int playerId, int bus, double levelDb)
+    {
+        if (!juceEngine_) {
+            return false;
+        }
+        return juceEngine_->setPlayerReverbSend(playerId, bus,
+            juce::Decibels::decibelsToGain(static_cast<float>(levelDb)));
+    }
+
+    QJsonObject AudioEngineQt::reverbBusStats(int bus) const
+    {
+        QJsonObject statsObj;
+        if (!juceEngine_) {
+            return statsObj;
+        }
+
+        const ReverbBus::Stats stats = juceEngine_->getReverbBusStats(bus);
+        statsObj.insert("loaded", stats.loaded);
+        statsObj.insert("impulseSeconds", stats.impulseSeconds);
+        statsObj.insert("tailSegments", stats.tailSegments);
+        statsObj.insert("callbackLoad", stats.callbackLoad);
+        statsObj.insert("workerLoad", stats.workerLoad);
+        statsObj.insert("lateBlocks", static_cast<qint64>(stats.lateBlocks));
+        return statsObj;
+    }
+
+    QJsonArray AudioEngineQt::reverbBuses() const
+    {
+        QJsonArray buses;
+        if (!juceEngine_) {
+            return buses;
+        }
+
+        for (int bus = 0; bus < JuceAudioEngine::MaxReverbBuses; ++bus) {
+            const ReverbBus* reverb = juceEngine_->getReverbBus(bus);
+            if (!reverb->isLoaded()) {
+                continue;
+            }
+
+            QJsonObject busObj;
+            busObj.insert("bus", bus);
+            busObj.insert("impulse", QString::fromStdString(reverb->getImpulseSource()));
+            busObj.insert("returnDb", juce::Decibels::gainToDecibels(reverb->getReturnGain()));
+            busObj.insert("output", reverb->getReturnOutput());
+            buses.append(busObj);
+        }
+        return buses;
+    }
+
+    bool AudioEngineQt::setReverbBuses(const QJsonArray& buses)
+    {
+        if (!juceEngine_) {
+            return false;
+        }
+
+        // Buses not listed are cleared
+        bool ok = true;
+        std::vector<bool> listed(JuceAudioEngine::MaxReverbBuses, false);
+        for (const QJsonValue& value : buses) {
+            const QJsonObject busObj = value.toObject();
+            const int bus = busObj.value("bus").toInt(-1);
+            if (bus < 0 || bus >= JuceAudioEngine::MaxReverbBuses) {
+                qWarning() << "AudioEngineQt::setReverbBuses() - Skipping invalid bus" << bus;
+                ok = false;
+                continue;
+            }
+
+            setReverbReturn(bus, busObj.value("returnDb").toDouble(0.0), busObj.value("output").toInt(0));
+            listed[bus] = loadReverbImpulse(bus, busObj.value("impulse").toString());
+            ok = ok && listed[bus];
+        }
+
+        for (int bus = 0; bus < JuceAudioEngine::MaxReverbBuses; ++bus) {
+            if (!listed[bus]) {
+                juceEngine_->clearReverbImpulse(bus);
+            }
+        }
+        return ok;
+    }
+
+    void AudioEngineQt::prepareTimeStretch(const QString& filePath, double rate)
+    {
+        if (juceEngine_) {
+            juceEngine_->prepareTimeStretch(filePath.toStdString(), rate);
+        }
+    }
+
+    bool AudioEngineQt::isTimeStretchReady(const QString& filePath, double rate) const
+    {
+        return juceEngine_ && juceEngine_->isTimeStretchReady(filePath.toStdString(), rate);
+    }
+
+    bool AudioEngineQt::setTimeStretch(int playerId, double rate, bool automated)
+    {
+        if (!juceEngine_) {
+            return false;
+        }
+
+        std::string message;
+        if (!juceEngine_->setPlayerTimeStretch(playerId, rate, automated, &message)) {
+            emit error("Time stretch: " + QString::fromStdString(message));
+            return false;
+        }
+        return true;
+    }
+
+    bool AudioEngineQt::setStretchRate(int playerId, double rate)
+    {
+        return juceEngine_ && juceEngine_->setPlayerStretchRate(playerId, rate);
+    }
+
+    QJsonObject AudioEngineQt::stretchStats(int playerId) const
+    {
+        QJsonObject statsObj;
+        if (!juceEngine_) {
+            return statsObj;
+        }
+
+        const StretchStats stats = juceEngine_->getPlayerStretchStats(playerId);
+        statsObj.insert("active", stats.active);
+        statsObj.insert("rendered", stats.rendered);
+        statsObj.insert("rate", stats.rate);
+        statsObj.insert("load", stats.load);
+        statsObj.insert("underruns", static_cast<qint64>(stats.underruns));
+        statsObj.insert("renderSeconds", stats.renderSeconds);
+        return statsObj;
+    }
+
+    QString AudioEngineQt::loudnessCachePath()
+    {
+        return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/loudness-cache.json";
+    }
+
+    void AudioEngineQt::saveLoudnessCache() const
+    {
+        if (juceEngine_ && !juceEngine_->getLoudnessAnalyzer().saveCache(loudnessCachePath().toStdString())) {
+            qWarning() << "AudioEngineQt: could not write loudness cache" << loudnessCachePath();
+        }
+    }
+
+    void AudioEngineQt::requestLoudness(const QString& filePath)
+    {
+        if (juceEngine_ && !filePath.isEmpty()) {
+            juceEngine_->getLoudnessAnalyzer().request(filePath.toStdString());
+        }
+    }
+
+    QJsonObject AudioEngineQt::loudness(const QString& filePath) const
+    {
+        QJsonObject loudnessObj;
+        LoudnessInfo info;
+        if (!juceEngine_ || !juceEngine_->getLoudnessAnalyzer().find(filePath.toStdString(), info)) {
+            return loudnessObj;
+        }
+
+        loudnessObj.insert("lufs", info.integratedLufs);
+        loudnessObj.insert("truePeak", info.truePeakDbtp);
+        loudnessObj.insert("lra", info.loudnessRange);
+        loudnessObj.insert("seconds", info.seconds);
+        return loudnessObj;
+    }
+
+    bool AudioEngineQt::normalizationGain(const QString& filePath, double targetLufs, double& gainDb) const
+    {
+        LoudnessInfo info;
+        if (!juceEngine_ || !juceEngine_->getLoudnessAnalyzer().find(filePath.toStdString(), info)) {
+            return false;
+        }
+        gainDb = info.normalizationGainDb(targetLufs);
+        return true;
+    }
+
+    bool AudioEngineQt::setTrim(int playerId, double gainDb)
+    {
+        return juceEngine_ && juceEngine_->setPlayerTrim(playerId,
+            juce::Decibels::decibelsToGain(static_cast<float>(gainDb)));
+    }
+
+    double AudioEngineQt::audioClockSeconds() const
+    {
+        if (!juceEngine_ || !juceEngine_->isInitialized()) {
+            return 0.0;
+        }
+
+        return juceEngine_->getClockSeconds();
+    }
+
+    void AudioEngineQt::setLatencyProbeEnabled(bool enabled)
+    {
+        if (juceEngine_) {
+            juceEngine_->setOnsetProbeEnabled(enabled);
+        }
+    }
+
+    qint64 AudioEngineQt::lastAudioOnsetNanos() const
+    {
+        return juceEngine_ ? juceEngine_->getLastOnsetNanos() : 0;
+    }
+
+    double AudioEngineQt::outputLatencyMs() const
+    {
+        if (!juceEngine_ || !juceEngine_->isInitialized()) {
+            return 0.0;
+        }
+
+        return 1000.0 * juceEngine_->getOutputLatencySamples() / juceEngine_->getSampleRate();
+    }
+
+    int AudioEngineQt::createStemPlayer(const QStringList& filePaths)
+    {
+        if (!juceEngine_ || !juceEngine_->isInitialized()) {
+            emit error("Audio engine not initialized");
+            return -1;
+        }
+
+        std::vector<std::string> paths;
+        paths.reserve(filePaths.size());
+        for (const QString& path : filePaths) {
+            paths.push_back(path.toStdString());
+        }
+
+        std::string loadError;
+        const int stemPlayerId = juceEngine_->createStemPlayer(paths, &loadError);
+        if (stemPlayerId < 0) {
+            emit error(QString("Failed to create stem player: %1").arg(QString::fromStdString(loadError)));
+            return -1;
+        }
+
+        qDebug() << "AudioEngineQt::createStemPlayer() - Created stem player" << stemPlayerId
+                 << "with" << filePaths.size() << "stems";
+        return stemPlayerId;
+    }
+
+    void AudioEngineQt::removeStemPlayer(int stemPlayerId)
+    {
+        if (juceEngine_) {
+            juceEngine_->removeStemPlayer(stemPlayerId);
+        }
+    }
+
+    bool AudioEngineQt::playStems(int stemPlayerId)
+    {
+        if (!juceEngine_) {
+            return false;
+        }
+
+        auto* stems = juceEngine_->getStemPlayer(stemPlayerId);
+        if (!stems) {
+            emit error(QString("Stem player %1 not found").arg(stemPlayerId));
+            return false;
+        }
+
+        stems->play();
+        return true;
+    }
+
+    void AudioEngineQt::stopStems(int stemPlayerId)
+    {
+        if (!juceEngine_) {
+            return;
+        }
+
+        if (auto* stems = juceEngine_->getStemPlayer(stemPlayerId)) {
+            stems->stop();
+        }
+    }
+
+    void AudioEngineQt::pauseStems(int stemPlayerId)
+    {
+        if (!juceEngine_) {
+            return;
+        }
+
+        if (auto* stems = juceEngine_->getStemPlayer(stemPlayerId)) {
+            stems->pause();
+        }
+    }
+
+    void AudioEngineQt::resumeStems(int stemPlayerId)
+    {
+        if (!juceEngine_) {
+            return;
+        }
+
+        if (auto* stems = juceEngine_->getStemPlayer(stemPlayerId)) {
+            stems->resume();
+        }
+    }
+
+    bool AudioEngineQt::isStemPlaying(int stemPlayerId) const
+    {
+        if (!juceEngine_) {
+            return false;
+        }
+
+        auto* stems = juceEngine_->getStemPlayer(stemPlayerId);
+        return stems && stems->isPlaying();
+    }
+
+    void AudioEngineQt::setStemVolume(int stemPlayerId, double volume)
+    {
+        if (!juceEngine_) {
+            return;
+        }
+
+        if (auto* stems = juceEngine_->getStemPlayer(stemPlayerId)) {
+            stems->setVolume(static_cast<float>(volume));
+        }
+    }
+
+    bool AudioEngineQt::setStemRoute(int stemPlayerId, int stem, int stemChannel, int outputChannel, double gain)
+    {
+        if (!juceEngine_) {
+            return false;
+        }
+
+        auto* stems = juceEngine_->getStemPlayer(stemPlayerId);
+        return stems && stems->setRoute(stem, stemChannel, outputChannel, static_cast<float>(gain));
+    }
+
+    void AudioEngineQt::clearStemRoutes(int stemPlayerId, int stem)
+    {
+        if (!juceEngine_) {
+            return;
+        }
+
+        if (auto* stems = juceEngine_->getStemPlayer(stemPlayerId)) {
+            stems->clearRoutes(stem);
+        }
+    }
+
+    int AudioEngineQt::stemChannelCount(int stemPlayerId, int stem) const
+    {
+        if (!juceEngine_) {
+            return 0;
+        }
+
+        auto* stems = juceEngine_->getStemPlayer(stemPlayerId);
+        return stems ? stems->getStemChannels(stem) : 0;
+    }
+
+    double AudioEngineQt::stemPosition(int stemPlayerId) const
+    {
+        if (!juceEngine_) {
+            return 0.0;
+        }
+
+        auto* stems = juceEngine_->getStemPlayer(stemPlayerId);
+        return stems ? stems->getPosition() : 0.0;
+    }
+
+    double AudioEngineQt::stemDuration(int stemPlayerId) const
+    {
+        if (!juceEngine_) {
+            return 0.0;
+        }
+
+        auto* stems = juceEngine_->getStemPlayer(stemPlayerId);
+        return stems ? stems->getDuration() : 0.0;
+    }
+
+    int AudioEngineQt::createPlaylistPlayer(const QStringList& filePaths, double crossfadeSeconds,
+        bool shuffle, bool loop)
+    {
+        if (!juceEngine_ || !juceEngine_->isInitialized()) {
+            emit error("Audio engine not initialized");
+            return -1;
+        }
+
+        std::vector<std::string> paths;
+        paths.reserve(filePaths.size());
+        for (const QString& path : filePaths) {
+            paths.push_back(path.toStdString());
+        }
+
+        PlaylistPlayer::Options options;
+        options.crossfadeSeconds = crossfadeSeconds;
+        options.shuffle = shuffle;
+        options.loop = loop;
+
+        std::string loadError;
+        const int playlistPlayerId = juceEngine_->createPlaylistPlayer(paths, options, &loadError);
+        if (playlistPlayerId < 0) {
+            emit error(QString("Failed to create playlist: %1").arg(QString::fromStdString(loadError)));
+            return -1;
+        }
+
+        qDebug() << "AudioEngineQt::createPlaylistPlayer() - Created playlist" << playlistPlayerId
+                 << "with" << filePaths.size() << "tracks";
+        return playlistPlayerId;
+    }
+
+    void AudioEngineQt::removePlaylistPlayer(int playlistPlayerId)
+    {
+        if (juceEngine_) {
+            juceEngine_->removePlaylistPlayer(playlistPlayerId);
+        }
+    }
+
+    bool AudioEngineQt::playPlaylist(int playlistPlayerId)
+    {
+        if (!juceEngine_) {
+            return false;
+        }
+
+        auto* playlist = juceEngine_->getPlaylistPlayer(playlistPlayerId);
+        if (!playlist) {
+            emit error(QString("Playlist %1 not found").arg(playlistPlayerId));
+            return false;
+        }
+
+        playlist->play();
+        return true;
+    }
+
+    void AudioEngineQt::stopPlaylist(int playlistPlayerId)
+    {
+        if (!juceEngine_) {
+            return;
+        }
+
+        if (auto* playlist = juceEngine_->getPlaylistPlayer(playlistPlayerId)) {
+            playlist->stop();
+        }
+    }
+
+    void AudioEngineQt::pausePlaylist(int playlistPlayerId)
+    {
+        if (!juceEngine_) {
+            return;
+        }
+
+        if (auto* playlist = juceEngine_->getPlaylistPlayer(playlistPlayerId)) {
+            playlist->pause();
+        }
+    }
+
+    void AudioEngineQt::resumePlaylist(int playlistPlayerId)
+    {
+        if (!juceEngine_) {
+            return;
+        }
+
+        if (auto* playlist = juceEngine_->getPlaylistPlayer(playlistPlayerId)) {
+            playlist->resume();
+        }
+    }
+
+    bool AudioEngineQt::skipPlaylistTrack(int playlistPlayerId)
+    {
+        if (!juceEngine_) {
+            return false;
+        }
+
+        auto* playlist = juceEngine_->getPlaylistPlayer(playlistPlayerId);
+        return playlist && playlist->skipToNext();
+    }
+
+    bool AudioEngineQt::isPlaylistPlaying(int playlistPlayerId) const
+    {
+        if (!juceEngine_) {
+            return false;
+        }
+
+        auto* playlist = juceEngine_->getPlaylistPlayer(playlistPlayerId);
+        return playlist && playlist->isPlaying();
+    }
+
+    void AudioEngineQt::setPlaylistVolume(int playlistPlayerId, double volume)
+    {
+        if (!juceEngine_) {
+            return;
+        }
+
+        if (auto* playlist = juceEngine_->getPlaylistPlayer(playlistPlayerId)) {
+            playlist->setVolume(static_cast<float>(volume));
+        }
+    }
+
+    int AudioEngineQt::playlistCurrentTrack(int playlistPlayerId) const
+    {
+        if (!juceEngine_) {
+            return -1;
+        }
+
+        auto* playlist = juceEngine_->getPlaylistPlayer(playlistPlayerId);
+        return playlist ? playlist->getCurrentTrack() : -1;
+    }
+
+    int AudioEngineQt::createLiveInput()
+    {
+        if (!juceEngine_ || !juceEngine_->isInitialized()) {
+            emit error("Audio engine not initialized");
+            return -1;
+        }
+
+        const int liveInputId = juceEngine_->createLiveInput();
+        qDebug() << "AudioEngineQt::createLiveInput() - Created live input" << liveInputId
+                 << "with" << juceEngine_->getNumInputChannels() << "device inputs";
+        return liveInputId;
+    }
+
+    void AudioEngineQt::removeLiveInput(int liveInputId)
+    {
+        if (juceEngine_) {
+            juceEngine_->removeLiveInput(liveInputId);
+        }
+    }
+
+    bool AudioEngineQt::setLiveInputRoute(int liveInputId, int inputChannel, int outputChannel, double gain)
+    {
+        if (!juceEngine_) {
+            return false;
+        }
+        return juceEngine_->setLiveInputRoute(liveInputId, inputChannel, outputChannel, static_cast<float>(gain));
+    }
+
+    void AudioEngineQt::clearLiveInputRoutes(int liveInputId)
+    {
+        if (juceEngine_) {
+            juceEngine_->clearLiveInputRoutes(liveInputId);
+        }
+    }
+
+    void AudioEngineQt::setLiveInputGain(int liveInputId, double gain, double fadeSeconds)
+    {
+        if (juceEngine_) {
+            juceEngine_->setLiveInputGain(liveInputId, static_cast<float>(gain), fadeSeconds);
+        }
+    }
+
+    int AudioEngineQt::inputChannelCount() const
+    {
+        return juceEngine_ ? juceEngine_->getNumInputChannels() : 0;
+    }
+
+    int AudioEngineQt::outputChannelCount() const
+    {
+        return juceEngine_ ? juceEngine_->getNumOutputChannels() : 0;
+    }
+
+    // ============================================================================
+    // Recorders
+    // ============================================================================
+
+    int AudioEngineQt::createRecorder(const QString& filePath, bool fromMix, const QList<int>& channels,
+        bool flac, int bitDepth)
+    {
+        if (!juceEngine_ || !juceEngine_->isInitialized()) {
+            emit error("Audio engine not initialized");
+            return -1;
+        }
+
+        RecordSettings settings;
+        settings.source = fromMix ? RecordSettings::Source::Mix : RecordSettings::Source::Inputs;
+        settings.channels.assign(channels.begin(), channels.end());
+        settings.format = flac ? RecordSettings::Format::Flac : RecordSettings::Format::Wav;
+        settings.bitDepth = bitDepth;
+
+        std::string openError;
+        const int recorderId = juceEngine_->createRecorder(filePath.toStdString(), settings, &openError);
+        if (recorderId < 0) {
+            emit error(QString("Failed to create recorder: %1").arg(QString::fromStdString(openError)));
+            return -1;
+        }
+
+        qDebug() << "AudioEngineQt::createRecorder() - Created recorder" << recorderId
+                 << "for" << filePath;
+        return recorderId;
+    }
+
+    bool AudioEngineQt::startRecorder(int recorderId)
+    {
+        return juceEngine_ && juceEngine_->startRecorder(recorderId);
+    }
+
+    bool AudioEngineQt::pauseRecorder(int recorderId)
+    {
+        return juceEngine_ && juceEngine_->pauseRecorder(recorderId);
+    }
+
+    bool AudioEngineQt::stopRecorder(int recorderId)
+    {
+        if (!juceEngine_) {
+            return false;
+        }
+
+        if (!juceEngine_->stopRecorder(recorderId)) {
+            const RecordStats stats = juceEngine_->getRecorderStats(recorderId);
+            emit error(stats.writeFailed
+                ? QString("Recording %1 failed: disk write error").arg(recorderId)
+                : QString("Recording %1 could not be closed").arg(recorderId));
+            return false;
+        }
+        return true;
+    }
+
+    void AudioEngineQt::removeRecorder(int recorderId)
+    {
+        if (juceEngine_) {
+            juceEngine_->removeRecorder(recorderId);
+        }
+    }
+
+    QJsonObject AudioEngineQt::recorderStats(int recorderId) const
+    {
+        QJsonObject statsObj;
+        if (!juceEngine_) {
+            return statsObj;
+        }
+
+        const RecordStats stats = juceEngine_->getRecorderStats(recorderId);
+        const double sampleRate = juceEngine_->getSampleRate();
+        statsObj.insert("recording", stats.recording);
+        statsObj.insert("seconds", stats.samplesRecorded / sampleRate);
+        statsObj.insert("written", static_cast<qint64>(stats.samplesWritten));
+        statsObj.insert("droppedBlocks", static_cast<qint64>(stats.droppedBlocks));
+        statsObj.insert("droppedSamples", static_cast<qint64>(stats.droppedSamples));
+        statsObj.insert("peakRingFill", stats.peakRingFill);
+        statsObj.insert("writeFailed", stats.writeFailed);
+        return statsObj;
+    }
+
+    // ============================================================================
+    // Preview bus
+    // ============================================================================
+
+    int AudioEngineQt::createPreviewPlayer(const QString& filePath)
+    {
+        if (!juceEngine_ || !juceEngine_->isInitialized()) {
+            emit error("Audio engine not initialized");
+            return -1;
+        }
+
+        if (!isPreviewAvailable()) {
+            emit error(QString("Cannot preview %1: no preview output is set, or it is not open").arg(filePath));
+            return -1;
+        }
+
+        std::string createError;
+        const int playerId = juceEngine_->createPreviewPlayer(filePath.toStdString(), &createError);
+        if (playerId < 0) {
+            emit error(QString("Failed to preview %1: %2").arg(filePath, QString::fromStdString(createError)));
+            return -1;
+        }
+
+        emit playerCreated(playerId);
+        qDebug() << "Created preview player" << playerId << "for" << filePath;
+        return playerId;
+    }
+
+    bool AudioEngineQt::isPreviewPlayer(int playerId) const
+    {
+        return juceEngine_ && juceEngine_->isPreviewPlayer(playerId);
+    }
+
+    bool AudioEngineQt::isPreviewAvailable() const
+    {
+        if (!juceEngine_ || !juceEngine_->isInitialized()) {
+            return false;
+        }
+
+        const int previewOutput = juceEngine_->getPreviewStats().firstOutput;
+        return previewOutput >= 0 && previewOutput + PreviewBus::Channels <= juceEngine_->getNumOutputChannels();
+    }
+
+    void AudioEngineQt::setPreviewOutput(int firstOutput, double gainDb)
+    {
+        if (juceEngine_) {
+            juceEngine_->setPreviewOutput(firstOutput, juce::Decibels::decibelsToGain(static_cast<float>(gainDb)));
+        }
+    }
+
+    QJsonObject AudioEngineQt::previewBus() const
+    {
+        QJsonObject busObj;
+        if (!juceEngine_) {
+            return busObj;
+        }
+
+        busObj.insert("output", juceEngine_->getPreviewStats().firstOutput);
+        busObj.insert("gainDb", juce::Decibels::gainToDecibels(juceEngine_->getPreviewGain()));
+        busObj.insert("budget", juceEngine_->getPreviewBudget());
+        return busObj;
+    }
+
+    bool AudioEngineQt::setPreviewBus(const QJsonObject& bus)
+    {
+        if (!juceEngine_) {
+            return false;
+        }
+
+        setPreviewOutput(bus.value("output").toInt(-1), bus.value("gainDb").toDouble(0.0));
+        juceEngine_->setPreviewBudget(bus.value("budget").toDouble(PreviewBus::DefaultBudget));
+        return true;
+    }
+
+    QJsonObject AudioEngineQt::previewStats() const
+    {
+        QJsonObject statsObj;
+        if (!juceEngine_) {
+            return statsObj;
+        }
+
+        const PreviewBus::Stats stats = juceEngine_->getPreviewStats();
+        statsObj.insert("voices", stats.voices);
+        statsObj.insert("blocksRendered", static_cast<qint64>(stats.blocksRendered));
+        statsObj.insert("blocksShed", static_cast<qint64>(stats.blocksShed));
+        statsObj.insert("voiceBlocksShed", static_cast<qint64>(stats.voiceBlocksShed));
+        statsObj.insert("load", stats.load);
+        return statsObj;
+    }
+
+    double AudioEngineQt::callbackLoad() const
+    {
+        if (!juceEngine_ || !juceEngine_->isInitialized()) {
+            return 0.0;
+        }
+
+        return juceEngine_->getCpuUsage();
+    }
+
+    int AudioEngineQt::xrunCount() const
+    {
+        if (!juceEngine_ || !juceEngine_->isInitialized()) {
+            return 0;
+        }
+
+        return juceEngine_->getXRunCount();
+    }
+
+    int AudioEngineQt::playerCount() const
+    {
+        return juceEngine_ ? juceEngine_->getPlayerCount() : 0;
+    }
+
+    void AudioEngineQt::setLockProfilingEnabled(bool enabled)
+    {
+        LockProfiler::setEnabled(enabled);
+        qDebug() << "AudioEngineQt::setLockProfilingEnabled() -" << enabled;
+    }
+
+    bool AudioEngineQt::isLockProfilingEnabled() const
+    {
+        return LockProfiler::isEnabled();
+    }
+
+    QJsonArray AudioEngineQt::lockProfile() const
+    {
+        auto histogramJson = [](const LockProfiler::Histogram& histogram) {
+            QJsonArray buckets;
+            for (uint64_t count : histogram.buckets) {
+                buckets.append(static_cast<qint64>(count));
+            }
+
+            QJsonObject json;
+            json["meanUs"] = histogram.meanUs();
+            json["p99Us"] = histogram.percentileUs(0.99);
+            json["maxUs"] = histogram.maxUs();
+            json["buckets"] = buckets;   // <1us, <2us, <4us ...
+            return json;
+        };
+
+        QJsonArray sites;
+        for (const LockProfiler::SiteStats& site : LockProfiler::snapshot()) {
+            QJsonArray threads;
+            for (const LockProfiler::ThreadStats& thread : site.threads) {
+                QJsonObject blockedBy;
+                for (const auto& holder : thread.blockedBy) {
+                    blockedBy[QString::fromStdString(holder.first)] = static_cast<qint64>(holder.second);
+                }
+
+                QJsonObject threadJson;
+                threadJson["thread"] = QString::fromStdString(thread.thread);
+                threadJson["acquisitions"] = static_cast<qint64>(thread.acquisitions);
+                threadJson["contended"] = static_cast<qint64>(thread.contended);
+                threadJson["wait"] = histogramJson(thread.wait);
+                threadJson["hold"] = histogramJson(thread.hold);
+                threadJson["blockedBy"] = blockedBy;
+                threads.append(threadJson);
+            }
+
+            QJsonObject siteJson;
+            siteJson["site"] = QString::fromStdString(site.site);
+            siteJson["acquisitions"] = static_cast<qint64>(site.acquisitions);
+            siteJson["contended"] = static_cast<qint64>(site.contended);
+            siteJson["waitTotalMs"] = site.waitTotalNs / 1.0e6;
+            siteJson["threads"] = threads;
+            sites.append(siteJson);
+        }
+
+        return sites;
+    }
+
+    void AudioEngineQt::resetLockProfile()
+    {
+        LockProfiler::reset();
+    }
+
 } // namespace CueForge
\ No newline at end of file
@@ -5,6 +5,9 @@
 
 #pragma once
 
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QList>
 #include <QObject>
 #include <QString>
 #include <QStringList>
@@ -26,8 +29,12 @@ namespace CueForge {
         explicit AudioEngineQt(QObject* parent = nullptr);
         ~AudioEngineQt() override;
 
-        // Initialization
+        // Initialization. After setNullAudio(), initialize() starts the null
+        // device from that spec (see NullAudioSettings::parse) instead of
+        // opening hardware.
+        void setNullAudio(const QString& spec);
         bool initialize();
+        bool initializeNull(const QString& spec = QString());
         void shutdown();
         bool isInitialized() const;
 
@@ -49,6 +56,14 @@ namespace CueForge {
         bool isPlaying(int playerId) const;
         bool isPaused(int playerId) const;
 
+        // Starts fadeInPlayerId while the running players in fadeOutPlayerIds
+        // fade out, in one engine command with both ramps on the same
+        // sample. Faded-out players are silent but still need stopping once
+        // isFadedOut() (see JuceAudioEngine::crossfadePlayers).
+        bool crossfade(int fadeInPlayerId, const QList<int>& fadeOutPlayerIds, double seconds,
+            bool equalPower = true);
+        bool isFadedOut(int playerId) const;
+
         // Audio properties
         void setVolume(int playerId, double volume);
         double getVolume(int playerId) const;
@@ -57,6 +72,138 @@ namespace CueForge {
         double getPosition(int playerId) const;
         double getDuration(int playerId) const;
 
+        // Multitrack stems played sample-locked (see StemCue). Stems are
+        // addressed by their index in the list given at creation.
+        int createStemPlayer(const QStringList& filePaths);
+        void removeStemPlayer(int stemPlayerId);
+        bool playStems(int stemPlayerId);
+        void stopStems(int stemPlayerId);
+        void pauseStems(int stemPlayerId);
+        void resumeStems(int stemPlayerId);
+        bool isStemPlaying(int stemPlayerId) const;
+        void setStemVolume(int stemPlayerId, double volume);
+        bool setStemRoute(int stemPlayerId, int stem, int stemChannel, int outputChannel, double gain);
+        void clearStemRoutes(int stemPlayerId, int stem);
+        int stemChannelCount(int stemPlayerId, int stem) const;
+        double stemPosition(int stemPlayerId) const;
+        double stemDuration(int stemPlayerId) const;
+
+        // Gapless playlists (see PlaylistCue). Tracks are addressed by their
+        // index in the list given at creation.
+        int createPlaylistPlayer(const QStringList& filePaths, double crossfadeSeconds,
+            bool shuffle, bool loop);
+        void removePlaylistPlayer(int playlistPlayerId);
+        bool playPlaylist(int playlistPlayerId);
+        void stopPlaylist(int playlistPlayerId);
+        void pausePlaylist(int playlistPlayerId);
+        void resumePlaylist(int playlistPlayerId);
+        bool skipPlaylistTrack(int playlistPlayerId);
+        bool isPlaylistPlaying(int playlistPlayerId) const;
+        void setPlaylistVolume(int playlistPlayerId, double volume);
+        int playlistCurrentTrack(int playlistPlayerId) const;
+
+        // Live input passthrough (see LiveInputCue). Gains are linear.
+        int createLiveInput();
+        void removeLiveInput(int liveInputId);
+        bool setLiveInputRoute(int liveInputId, int inputChannel, int outputChannel, double gain);
+        void clearLiveInputRoutes(int liveInputId);
+        void setLiveInputGain(int liveInputId, double gain, double fadeSeconds = 0.0);
+        int inputChannelCount() const;
+        int outputChannelCount() const;
+
+        // Recording to WAV or FLAC (see RecordCue). Channels are zero-based
+        // device inputs, or mix outputs when fromMix. stopRecorder() returns
+        // once the file is complete. recorderStats() reports { recording,
+        // seconds, written, droppedBlocks, droppedSamples, peakRingFill,
+        // writeFailed }.
+        int createRecorder(const QString& filePath, bool fromMix, const QList<int>& channels,
+            bool flac, int bitDepth);
+        bool startRecorder(int recorderId);
+        bool pauseRecorder(int recorderId);
+        bool stopRecorder(int recorderId);
+        void removeRecorder(int recorderId);
+        QJsonObject recorderStats(int recorderId) const;
+
+        // Auditioning on the preview bus (see PreviewBus). A preview player
+        // is driven like any other and removed with removePlayer().
+        // previewBus() is { output, gainDb, budget }, in the form
+        // setPreviewBus() and the workspace take; output is zero-based, -1
+        // (the default) disables previews. isPreviewAvailable() says whether
+        // the output pair is set and open, and createPreviewPlayer() fails
+        // when it is not. previewStats() reports { voices, blocksRendered,
+        // blocksShed, voiceBlocksShed, load }.
+        int createPreviewPlayer(const QString& filePath);
+        bool isPreviewPlayer(int playerId) const;
+        bool isPreviewAvailable() const;
+        void setPreviewOutput(int firstOutput, double gainDb);
+        QJsonObject previewBus() const;
+        bool setPreviewBus(const QJsonObject& bus);
+        QJsonObject previewStats() const;
+
+        // Per-output delay, EQ and trim, applied live. EQ bands are objects
+        // { type: peak|lowShelf|highShelf|lowPass|highPass, frequency,
+        // gainDb, q }. outputProcessing() lists the outputs that aren't
+        // neutral, in the form setOutputProcessing() and the workspace take.
+        bool setOutputDelay(int outputChannel, double delayMs);
+        bool setOutputTrim(int outputChannel, double trimDb);
+        bool setOutputEq(int outputChannel, const QJsonArray& bands);
+        QJsonArray outputProcessing() const;
+        bool setOutputProcessing(const QJsonArray& outputs);
+
+        // Convolution reverb buses fed by audio cue sends (see ReverbBus).
+        // reverbBuses() lists the loaded buses as { bus, impulse, returnDb,
+        // output }, in the form setReverbBuses() and the workspace take.
+        // reverbBusStats() reports the bus's callback and worker load.
+        int reverbBusCount() const;
+        bool loadReverbImpulse(int bus, const QString& filePath);
+        void clearReverbImpulse(int bus);
+        void setReverbReturn(int bus, double gainDb, int firstOutput = 0);
+        bool setReverbSend(int playerId, int bus, double levelDb);
+        QJsonObject reverbBusStats(int bus) const;
+        QJsonArray reverbBuses() const;
+        bool setReverbBuses(const QJsonArray& buses);
+
+        // Pitch-preserving time stretch (see TimeStretch.h). Static rates
+        // render ahead with prepareTimeStretch(); automated ones stretch
+        // live so setStretchRate() applies while playing. stretchStats()
+        // reports { active, rendered, rate, load, underruns, renderSeconds }.
+        void prepareTimeStretch(const QString& filePath, double rate);
+        bool isTimeStretchReady(const QString& filePath, double rate) const;
+        bool setTimeStretch(int playerId, double rate, bool automated);
+        bool setStretchRate(int playerId, double rate);
+        QJsonObject stretchStats(int playerId) const;
+
+        // Loudness of audio files (BS.1770 integrated LUFS, true peak and
+        // loudness range), measured on a background thread and cached
+        // across sessions. loudness() is { lufs, truePeak, lra, seconds }
+        // once a file is measured and empty until then; loudnessAnalysed()
+        // fires as each file completes. setTrim() is the per-player gain
+        // normalisation applies on top of the volume.
+        void requestLoudness(const QString& filePath);
+        QJsonObject loudness(const QString& filePath) const;
+        bool normalizationGain(const QString& filePath, double targetLufs, double& gainDb) const;
+        bool setTrim(int playerId, double gainDb);
+
+        // Seconds of audio rendered by the device - the master clock that
+        // video and other time-based output follow
+        double audioClockSeconds() const;
+
+        // Command-to-audio measurement (see tools/remote_bench)
+        void setLatencyProbeEnabled(bool enabled);
+        qint64 lastAudioOnsetNanos() const;
+        double outputLatencyMs() const;
+
+        // Long-run health (see tools/soak)
+        double callbackLoad() const;
+        int xrunCount() const;
+        int playerCount() const;
+
+        // Engine lock contention, process-wide (see LockProfiler)
+        void setLockProfilingEnabled(bool enabled);
+        bool isLockProfilingEnabled() const;
+        QJsonArray lockProfile() const;
+        void resetLockProfile();
+
     signals:
         void deviceChanged(const QString& deviceName);
         void playerCreated(int playerId);
@@ -67,9 +214,16 @@ namespace CueForge {
         void playbackResumed(int playerId);
         void positionChanged(int playerId, double seconds);
         void error(const QString& message);
+        void loudnessAnalysed(const QString& filePath);
 
     private:
+        static QString loudnessCachePath();
+        void saveLoudnessCache() const;
+
         std::unique_ptr<JuceAudioEngine> juceEngine_;
+
+        bool useNullAudio_ = false;
+        QString nullAudioSpec_;
     };
 
 } // namespace CueForge
\ No newline at end of file
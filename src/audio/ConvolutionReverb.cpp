@@ -0,0 +1,856 @@
+// ============================================================================
+// ConvolutionReverb.cpp - Partitioned FFT convolution reverb buses
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#include "ConvolutionReverb.h"
+#include <algorithm>
+#include <cmath>
+
+namespace CueForge {
+
+    namespace {
+
+        int fftOrder(int size)
+        {
+            int order = 0;
+            while ((1 << order) < size) {
+                ++order;
+            }
+            return order;
+        }
+
+        // Smoothing for the load figures, per measurement
+        constexpr double LoadSmoothing = 0.1;
+
+        void smoothLoad(std::atomic<double>& load, double measured)
+        {
+            const double previous = load.load(std::memory_order_relaxed);
+            load.store(previous + LoadSmoothing * (measured - previous), std::memory_order_relaxed);
+        }
+
+    } // namespace
+
+    // ============================================================================
+    // UniformConvolver
+    // ============================================================================
+
+    UniformConvolver::UniformConvolver(const juce::AudioBuffer<float>& impulse, int offset, int length,
+        int partitionSize, int delayPartitions)
+        : fft_(fftOrder(2 * partitionSize))
+        , partitionSize_(partitionSize)
+        , bins_(partitionSize + 1)
+        , numPartitions_(std::max(1, (length + partitionSize - 1) / partitionSize))
+        , delayPartitions_(delayPartitions)
+        , depth_(delayPartitions + std::max(1, (length + partitionSize - 1) / partitionSize))
+        , kernelChannels_(juce::jlimit(1, MaxChannels, impulse.getNumChannels()))
+    {
+        const int kernelSize = numPartitions_ * bins_;
+        kernelRe_.assign(static_cast<size_t>(kernelChannels_ * kernelSize), 0.0f);
+        kernelIm_.assign(static_cast<size_t>(kernelChannels_ * kernelSize), 0.0f);
+        fdlRe_.assign(static_cast<size_t>(MaxChannels * depth_ * bins_), 0.0f);
+        fdlIm_.assign(static_cast<size_t>(MaxChannels * depth_ * bins_), 0.0f);
+        window_.assign(static_cast<size_t>(MaxChannels * 2 * partitionSize_), 0.0f);
+        fftBuffer_.assign(static_cast<size_t>(4 * partitionSize_), 0.0f);
+        accRe_.assign(static_cast<size_t>(bins_), 0.0f);
+        accIm_.assign(static_cast<size_t>(bins_), 0.0f);
+
+        const int end = std::min(offset + length, impulse.getNumSamples());
+
+        for (int channel = 0; channel < kernelChannels_; ++channel) {
+            const float* source = impulse.getReadPointer(channel);
+
+            for (int partition = 0; partition < numPartitions_; ++partition) {
+                std::fill(fftBuffer_.begin(), fftBuffer_.end(), 0.0f);
+
+                const int start = offset + partition * partitionSize_;
+                const int count = std::min(partitionSize_, end - start);
+                if (count > 0) {
+                    std::copy(source + start, source + start + count, fftBuffer_.begin());
+                }
+                fft_.performRealOnlyForwardTransform(fftBuffer_.data(), true);
+
+                float* re = kernelRe_.data() + channel * kernelSize + partition * bins_;
+                float* im = kernelIm_.data() + channel * kernelSize + partition * bins_;
+                for (int bin = 0; bin < bins_; ++bin) {
+                    re[bin] = fftBuffer_[static_cast<size_t>(2 * bin)];
+                    im[bin] = fftBuffer_[static_cast<size_t>(2 * bin + 1)];
+                }
+            }
+        }
+    }
+
+    void UniformConvolver::reset()
+    {
+        std::fill(fdlRe_.begin(), fdlRe_.end(), 0.0f);
+        std::fill(fdlIm_.begin(), fdlIm_.end(), 0.0f);
+        std::fill(window_.begin(), window_.end(), 0.0f);
+        fdlHead_ = 0;
+    }
+
+    void UniformConvolver::transformInput(int channel, const float* input)
+    {
+        float* window = window_.data() + channel * 2 * partitionSize_;
+        std::copy(window + partitionSize_, window + 2 * partitionSize_, window);
+        std::copy(input, input + partitionSize_, window + partitionSize_);
+
+        std::copy(window, window + 2 * partitionSize_, fftBuffer_.begin());
+        std::fill(fftBuffer_.begin() + 2 * partitionSize_, fftBuffer_.end(), 0.0f);
+        fft_.performRealOnlyForwardTransform(fftBuffer_.data(), true);
+
+        const int slot = (channel * depth_ + fdlHead_) * bins_;
+        float* re = fdlRe_.data() + slot;
+        float* im = fdlIm_.data() + slot;
+        for (int bin = 0; bin < bins_; ++bin) {
+            re[bin] = fftBuffer_[static_cast<size_t>(2 * bin)];
+            im[bin] = fftBuffer_[static_cast<size_t>(2 * bin + 1)];
+        }
+    }
+
+    void UniformConvolver::pushInput(const float* const* input)
+    {
+        fdlHead_ = (fdlHead_ + 1) % depth_;
+        for (int channel = 0; channel < MaxChannels; ++channel) {
+            transformInput(channel, input[channel]);
+        }
+    }
+
+    void UniformConvolver::process(const float* const* input, float* const* output)
+    {
+        fdlHead_ = (fdlHead_ + 1) % depth_;
+        const int kernelSize = numPartitions_ * bins_;
+
+        for (int channel = 0; channel < MaxChannels; ++channel) {
+            transformInput(channel, input[channel]);
+
+            std::fill(accRe_.begin(), accRe_.end(), 0.0f);
+            std::fill(accIm_.begin(), accIm_.end(), 0.0f);
+            float* accRe = accRe_.data();
+            float* accIm = accIm_.data();
+
+            const int kernelChannel = std::min(channel, kernelChannels_ - 1);
+            for (int partition = 0; partition < numPartitions_; ++partition) {
+                int slot = fdlHead_ - delayPartitions_ - partition;
+                if (slot < 0) {
+                    slot += depth_;
+                }
+
+                const float* xRe = fdlRe_.data() + (channel * depth_ + slot) * bins_;
+                const float* xIm = fdlIm_.data() + (channel * depth_ + slot) * bins_;
+                const float* hRe = kernelRe_.data() + kernelChannel * kernelSize + partition * bins_;
+                const float* hIm = kernelIm_.data() + kernelChannel * kernelSize + partition * bins_;
+
+                for (int bin = 0; bin < bins_; ++bin) {
+                    accRe[bin] += xRe[bin] * hRe[bin] - xIm[bin] * hIm[bin];
+                    accIm[bin] += xRe[bin] * hIm[bin] + xIm[bin] * hRe[bin];
+                }
+            }
+
+            for (int bin = 0; bin < bins_; ++bin) {
+                fftBuffer_[static_cast<size_t>(2 * bin)] = accRe[bin];
+                fftBuffer_[static_cast<size_t>(2 * bin + 1)] = accIm[bin];
+            }
+            std::fill(fftBuffer_.begin() + 2 * bins_, fftBuffer_.end(), 0.0f);
+            fft_.performRealOnlyInverseTransform(fftBuffer_.data());
+
+            // Overlap-save: the second half is the linear convolution
+            std::copy(fftBuffer_.begin() + partitionSize_, fftBuffer_.begin() + 2 * partitionSize_, output[channel]);
+        }
+    }
+
+    // ============================================================================
+    // Convolution state
+    // ============================================================================
+
+    struct ReverbBus::TailSegment
+    {
+        static constexpr int OutputSlots = 4;
+
+        TailSegment(const juce::AudioBuffer<float>& impulse, int offset, int length, int delayPartitions, int loadSlot)
+            : convolver(impulse, offset, length, TailPartition, delayPartitions)
+            , output(static_cast<size_t>(OutputSlots * Channels * TailPartition), 0.0f)
+            , silence(static_cast<size_t>(TailPartition), 0.0f)
+            , loadSlot(loadSlot)
+        {
+        }
+
+        float* slot(int64_t chunk, int channel)
+        {
+            return output.data() + (static_cast<int>(chunk % OutputSlots) * Channels + channel) * TailPartition;
+        }
+
+        UniformConvolver convolver;
+        std::vector<float> output;          // [slot][channel][TailPartition]
+        std::vector<float> silence;
+        const int loadSlot;
+
+        std::atomic<int64_t> processed{ 0 };    // Tail blocks done, published by the worker
+        std::atomic<bool> busy{ false };        // Claimed by a worker
+        bool ready = false;                     // Audio thread: this chunk's block arrived in time
+    };
+
+    struct ReverbBus::Convolution
+    {
+        static constexpr int InputSlots = 8;
+
+        double sampleRate = 0.0;
+        double seconds = 0.0;
+        int capacity = 0;
+
+        std::vector<float> direct;                  // [channel][HeadPartition]
+        std::unique_ptr<UniformConvolver> head;     // IR [HeadPartition, 2 * TailPartition)
+        std::vector<std::unique_ptr<TailSegment>> tail;
+
+        // Audio thread
+        std::vector<float> history;                 // [channel][HeadPartition - 1 + capacity]
+        std::vector<float> headIn, headOut;         // [channel][HeadPartition]
+        int headPosition = 0;
+        int tailPosition = 0;
+        int64_t chunk = 0;
+
+        // Written by the audio thread, read by workers
+        std::vector<float> tailIn;                  // [channel][InputSlots][TailPartition]
+        std::atomic<int64_t> inputChunks{ 0 };
+        std::atomic<bool> retired{ false };
+
+        float* tailInput(int64_t index, int channel)
+        {
+            return tailIn.data() + (channel * InputSlots + static_cast<int>(index % InputSlots)) * TailPartition;
+        }
+    };
+
+    // ============================================================================
+    // ReverbWorkerPool
+    // ============================================================================
+
+    class ReverbWorkerPool::Worker : public juce::Thread
+    {
+    public:
+        Worker(ReverbWorkerPool& pool, int number)
+            : juce::Thread("Reverb worker " + juce::String(number))
+            , pool_(pool)
+        {
+        }
+
+        void run() override
+        {
+            while (!threadShouldExit()) {
+                if (!pool_.runOnce()) {
+                    wait(1);
+                }
+            }
+        }
+
+    private:
+        ReverbWorkerPool& pool_;
+    };
+
+    ReverbWorkerPool::ReverbWorkerPool(int numThreads)
+        : numThreads_(numThreads > 0 ? numThreads : juce::jlimit(1, 4, juce::SystemStats::getNumCpus() - 1))
+    {
+    }
+
+    ReverbWorkerPool::~ReverbWorkerPool()
+    {
+        stop();
+    }
+
+    void ReverbWorkerPool::start()
+    {
+        if (!workers_.empty()) {
+            return;
+        }
+
+        for (int i = 0; i < numThreads_; ++i) {
+            workers_.push_back(std::make_unique<Worker>(*this, i + 1));
+            workers_.back()->startThread(juce::Thread::Priority::high);
+        }
+    }
+
+    void ReverbWorkerPool::stop()
+    {
+        for (auto& worker : workers_) {
+            worker->signalThreadShouldExit();
+        }
+        for (auto& worker : workers_) {
+            worker->stopThread(2000);
+        }
+        workers_.clear();
+    }
+
+    void ReverbWorkerPool::addBus(ReverbBus* bus)
+    {
+        const juce::ScopedWriteLock lock(lock_);
+        buses_.push_back(bus);
+    }
+
+    void ReverbWorkerPool::removeBus(ReverbBus* bus)
+    {
+        const juce::ScopedWriteLock lock(lock_);
+        buses_.erase(std::remove(buses_.begin(), buses_.end(), bus), buses_.end());
+    }
+
+    bool ReverbWorkerPool::runOnce()
+    {
+        const juce::ScopedReadLock lock(lock_);
+
+        bool worked = false;
+        for (ReverbBus* bus : buses_) {
+            worked = bus->processTails() || worked;
+        }
+        return worked;
+    }
+
+    // ============================================================================
+    // ReverbBus
+    // ============================================================================
+
+    ReverbBus::ReverbBus(int index, ReverbWorkerPool& pool)
+        : index_(index)
+        , pool_(pool)
+    {
+        for (auto& load : segmentLoad_) {
+            load.store(0.0, std::memory_order_relaxed);
+        }
+        pool_.addBus(this);
+    }
+
+    ReverbBus::~ReverbBus()
+    {
+        pool_.removeBus(this);
+    }
+
+    void ReverbBus::prepare(double sampleRate, int maxBlockSize)
+    {
+        const juce::ScopedLock lock(impulseLock_);
+
+        sampleRate_ = sampleRate;
+        maxBlockSize_ = maxBlockSize;
+
+        // Some devices deliver blocks larger than they announce
+        capacity_ = std::max(maxBlockSize, 4096);
+        send_.setSize(Channels, capacity_);
+        wet_.setSize(Channels, capacity_);
+        wetIncoming_.setSize(Channels, capacity_);
+        fadeLength_ = std::max(1, static_cast<int>(CrossfadeSeconds * sampleRate));
+
+        // Audio isn't running: drop everything and start clean
+        {
+            const juce::SpinLock::ScopedLockType pendingLock(pendingLock_);
+            pending_ = nullptr;
+            hasPending_ = false;
+            pendingChanged_.store(false, std::memory_order_release);
+        }
+        current_ = nullptr;
+        incoming_ = nullptr;
+        fading_ = false;
+        active_ = false;
+        lastReturnGain_ = 0.0f;
+
+        std::unique_ptr<Convolution> convolution;
+        if (impulse_.getNumSamples() > 0) {
+            convolution = build(impulse_, impulseRate_);
+            current_ = convolution.get();
+            tailSegments_.store(static_cast<int>(convolution->tail.size()), std::memory_order_relaxed);
+        }
+
+        const juce::ScopedWriteLock poolLock(pool_.getLock());
+        owned_.clear();
+        if (convolution) {
+            owned_.push_back(std::move(convolution));
+        }
+    }
+
+    void ReverbBus::release()
+    {
+        const juce::ScopedLock lock(impulseLock_);
+
+        sampleRate_ = 0.0;
+        {
+            const juce::SpinLock::ScopedLockType pendingLock(pendingLock_);
+            pending_ = nullptr;
+            hasPending_ = false;
+            pendingChanged_.store(false, std::memory_order_release);
+        }
+        current_ = nullptr;
+        incoming_ = nullptr;
+        fading_ = false;
+        active_ = false;
+        callbackLoad_.store(0.0, std::memory_order_relaxed);
+
+        const juce::ScopedWriteLock poolLock(pool_.getLock());
+        owned_.clear();
+    }
+
+    bool ReverbBus::setImpulse(const juce::AudioBuffer<float>& impulse, double impulseSampleRate,
+        const std::string& source, std::string* error)
+    {
+        if (impulse.getNumChannels() == 0 || impulse.getNumSamples() == 0 || impulseSampleRate <= 0.0) {
+            if (error) {
+                *error = "Impulse response is empty: " + source;
+            }
+            return false;
+        }
+        if (impulse.getNumSamples() > MaxImpulseSeconds * impulseSampleRate) {
+            if (error) {
+                *error = "Impulse response is longer than " + std::to_string(static_cast<int>(MaxImpulseSeconds))
+                    + " seconds: " + source;
+            }
+            return false;
+        }
+
+        const juce::ScopedLock lock(impulseLock_);
+
+        const int channels = std::min(Channels, impulse.getNumChannels());
+        impulse_.setSize(channels, impulse.getNumSamples());
+        for (int channel = 0; channel < channels; ++channel) {
+            impulse_.copyFrom(channel, 0, impulse, channel, 0, impulse.getNumSamples());
+        }
+        impulseRate_ = impulseSampleRate;
+        impulseSource_ = source;
+        impulseSeconds_.store(impulse.getNumSamples() / impulseSampleRate, std::memory_order_relaxed);
+        loaded_.store(true, std::memory_order_release);
+
+        if (sampleRate_ > 0.0) {
+            auto convolution = build(impulse_, impulseRate_);
+            tailSegments_.store(static_cast<int>(convolution->tail.size()), std::memory_order_relaxed);
+            for (auto& load : segmentLoad_) {
+                load.store(0.0, std::memory_order_relaxed);
+            }
+            stage(std::move(convolution));
+        }
+        return true;
+    }
+
+    void ReverbBus::clearImpulse()
+    {
+        const juce::ScopedLock lock(impulseLock_);
+
+        impulse_.setSize(0, 0);
+        impulseSource_.clear();
+        loaded_.store(false, std::memory_order_release);
+        impulseSeconds_.store(0.0, std::memory_order_relaxed);
+        tailSegments_.store(0, std::memory_order_relaxed);
+
+        if (sampleRate_ > 0.0) {
+            stage(nullptr);
+        }
+    }
+
+    std::string ReverbBus::getImpulseSource() const
+    {
+        const juce::ScopedLock lock(impulseLock_);
+        return impulseSource_;
+    }
+
+    void ReverbBus::setReturn(float gain, int firstOutput)
+    {
+        returnGain_.store(std::max(0.0f, gain), std::memory_order_relaxed);
+        returnOutput_.store(std::max(0, firstOutput), std::memory_order_relaxed);
+    }
+
+    ReverbBus::Stats ReverbBus::getStats() const
+    {
+        Stats stats;
+        stats.loaded = isLoaded();
+        stats.impulseSeconds = impulseSeconds_.load(std::memory_order_relaxed);
+        stats.tailSegments = tailSegments_.load(std::memory_order_relaxed);
+        stats.callbackLoad = callbackLoad_.load(std::memory_order_relaxed);
+        for (const auto& load : segmentLoad_) {
+            stats.workerLoad += load.load(std::memory_order_relaxed);
+        }
+        stats.lateBlocks = lateBlocks_.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    std::unique_ptr<ReverbBus::Convolution> ReverbBus::build(const juce::AudioBuffer<float>& impulse, double impulseRate) const
+    {
+        // At the device rate, scaled so the wet level doesn't follow the rate
+        juce::AudioBuffer<float> ir;
+        if (std::abs(impulseRate - sampleRate_) > 0.5) {
+            const double ratio = impulseRate / sampleRate_;
+            const int length = static_cast<int>(std::ceil(impulse.getNumSamples() / ratio));
+            ir.setSize(impulse.getNumChannels(), length);
+
+            std::vector<float> padded(static_cast<size_t>(impulse.getNumSamples() + 16), 0.0f);
+            for (int channel = 0; channel < impulse.getNumChannels(); ++channel) {
+                std::copy(impulse.getReadPointer(channel), impulse.getReadPointer(channel) + impulse.getNumSamples(),
+                    padded.begin());
+                juce::LagrangeInterpolator interpolator;
+                interpolator.process(ratio, padded.data(), ir.getWritePointer(channel), length);
+            }
+            ir.applyGain(static_cast<float>(ratio));
+        } else {
+            ir.makeCopyOf(impulse);
+        }
+
+        const int length = ir.getNumSamples();
+        const int irChannels = ir.getNumChannels();
+
+        auto convolution = std::make_unique<Convolution>();
+        convolution->sampleRate = sampleRate_;
+        convolution->seconds = length / sampleRate_;
+        convolution->capacity = capacity_;
+
+        convolution->direct.assign(static_cast<size_t>(Channels * HeadPartition), 0.0f);
+        for (int channel = 0; channel < Channels; ++channel) {
+            const float* source = ir.getReadPointer(std::min(channel, irChannels - 1));
+            std::copy(source, source + std::min(length, HeadPartition),
+                convolution->direct.begin() + channel * HeadPartition);
+        }
+
+        const int headEnd = std::min(length, 2 * TailPartition);
+        if (headEnd > HeadPartition) {
+            convolution->head = std::make_unique<UniformConvolver>(ir, HeadPartition, headEnd - HeadPartition, HeadPartition);
+        }
+
+        if (length > 2 * TailPartition) {
+            // Enough partitions per segment that the extra FFTs stay small
+            constexpr int MinPartitionsPerSegment = 32;
+            const int partitions = (length - 2 * TailPartition + TailPartition - 1) / TailPartition;
+            const int segments = juce::jlimit(1, std::min(MaxTailSegments, pool_.getNumThreads()),
+                (partitions + MinPartitionsPerSegment - 1) / MinPartitionsPerSegment);
+            const int perSegment = (partitions + segments - 1) / segments;
+
+            for (int first = 0, segment = 0; first < partitions; first += perSegment, ++segment) {
+                const int offset = 2 * TailPartition + first * TailPartition;
+                const int segmentLength = std::min(perSegment * TailPartition, length - offset);
+                convolution->tail.push_back(std::make_unique<TailSegment>(ir, offset, segmentLength, first, segment));
+            }
+        }
+
+        convolution->history.assign(static_cast<size_t>(Channels * (HeadPartition - 1 + capacity_)), 0.0f);
+        convolution->headIn.assign(static_cast<size_t>(Channels * HeadPartition), 0.0f);
+        convolution->headOut.assign(static_cast<size_t>(Channels * HeadPartition), 0.0f);
+        if (!convolution->tail.empty()) {
+            convolution->tailIn.assign(static_cast<size_t>(Channels * Convolution::InputSlots * TailPartition), 0.0f);
+        }
+
+        return convolution;
+    }
+
+    void ReverbBus::stage(std::unique_ptr<Convolution> convolution)
+    {
+        Convolution* staged = convolution.get();
+
+        {
+            const juce::ScopedWriteLock poolLock(pool_.getLock());
+            collectRetired();
+            if (convolution) {
+                owned_.push_back(std::move(convolution));
+            }
+        }
+
+        const juce::SpinLock::ScopedLockType lock(pendingLock_);
+        if (hasPending_ && pending_ != nullptr) {
+            // Replaced before the audio thread took it
+            pending_->retired.store(true, std::memory_order_release);
+        }
+        pending_ = staged;
+        hasPending_ = true;
+        pendingChanged_.store(true, std::memory_order_release);
+    }
+
+    void ReverbBus::collectRetired()
+    {
+        owned_.erase(std::remove_if(owned_.begin(), owned_.end(),
+            [](const std::unique_ptr<Convolution>& convolution) {
+                return convolution->retired.load(std::memory_order_acquire);
+            }), owned_.end());
+    }
+
+    void ReverbBus::retire(Convolution* convolution)
+    {
+        // The audio thread's last touch; the control thread frees it later
+        if (convolution != nullptr) {
+            convolution->retired.store(true, std::memory_order_release);
+        }
+    }
+
+    void ReverbBus::applyPending()
+    {
+        // One crossfade at a time; a newer impulse waits for it to finish
+        if (fading_ || !pendingChanged_.load(std::memory_order_acquire)) {
+            return;
+        }
+
+        const juce::SpinLock::ScopedTryLockType lock(pendingLock_);
+        if (!lock.isLocked() || !hasPending_) {
+            return;
+        }
+
+        incoming_ = pending_;
+        pending_ = nullptr;
+        hasPending_ = false;
+        pendingChanged_.store(false, std::memory_order_release);
+
+        if (incoming_ != nullptr) {
+            startChunk(*incoming_);
+        }
+        fading_ = current_ != nullptr || incoming_ != nullptr;
+        fadePosition_ = 0;
+    }
+
+    void ReverbBus::beginBlock(int numSamples)
+    {
+        applyPending();
+
+        active_ = (current_ != nullptr || incoming_ != nullptr) && numSamples <= capacity_;
+        if (!active_) {
+            sendSamples_ = 0;
+            return;
+        }
+
+        sendSamples_ = numSamples;
+        send_.clear(0, numSamples);
+    }
+
+    void ReverbBus::addToSend(const juce::AudioBuffer<float>& source, int startSample, int numSamples,
+        float startGain, float endGain)
+    {
+        if (!active_ || source.getNumChannels() == 0) {
+            return;
+        }
+
+        const int count = std::min(numSamples, sendSamples_);
+        for (int channel = 0; channel < Channels; ++channel) {
+            const int sourceChannel = std::min(channel, source.getNumChannels() - 1);
+            send_.addFromWithRamp(channel, 0, source.getReadPointer(sourceChannel, startSample), count, startGain, endGain);
+        }
+    }
+
+    void ReverbBus::startChunk(Convolution& convolution)
+    {
+        // Tail block k is heard during chunk k + 2
+        const int64_t needed = convolution.chunk - 2;
+        for (auto& segment : convolution.tail) {
+            segment->ready = needed >= 0 && segment->processed.load(std::memory_order_acquire) > needed;
+            if (needed >= 0 && !segment->ready) {
+                lateBlocks_.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void ReverbBus::renderConvolution(Convolution& convolution, const float* const* input, float* const* wet, int numSamples)
+    {
+        constexpr int historyLength = HeadPartition - 1;
+        const int lineLength = historyLength + convolution.capacity;
+
+        // Direct FIR for the first HeadPartition taps - no latency at any block size
+        for (int channel = 0; channel < Channels; ++channel) {
+            float* line = convolution.history.data() + channel * lineLength;
+            const float* taps = convolution.direct.data() + channel * HeadPartition;
+
+            std::copy(input[channel], input[channel] + numSamples, line + historyLength);
+            juce::FloatVectorOperations::clear(wet[channel], numSamples);
+            for (int tap = 0; tap < HeadPartition; ++tap) {
+                juce::FloatVectorOperations::addWithMultiply(wet[channel], line + historyLength - tap, taps[tap], numSamples);
+            }
+            std::copy(line + numSamples, line + numSamples + historyLength, line);
+        }
+
+        // Head and tail convolvers, split at partition boundaries. The head
+        // block computed at the end of one partition plays during the next,
+        // which is the HeadPartition offset its IR segment starts at.
+        int done = 0;
+        while (done < numSamples) {
+            const int count = std::min({ numSamples - done,
+                HeadPartition - convolution.headPosition,
+                TailPartition - convolution.tailPosition });
+
+            for (int channel = 0; channel < Channels; ++channel) {
+                float* headIn = convolution.headIn.data() + channel * HeadPartition;
+                std::copy(input[channel] + done, input[channel] + done + count, headIn + convolution.headPosition);
+                if (convolution.head) {
+                    juce::FloatVectorOperations::add(wet[channel] + done,
+                        convolution.headOut.data() + channel * HeadPartition + convolution.headPosition, count);
+                }
+
+                if (!convolution.tail.empty()) {
+                    float* tailIn = convolution.tailInput(convolution.chunk, channel);
+                    std::copy(input[channel] + done, input[channel] + done + count, tailIn + convolution.tailPosition);
+
+                    for (auto& segment : convolution.tail) {
+                        if (segment->ready) {
+                            juce::FloatVectorOperations::add(wet[channel] + done,
+                                segment->slot(convolution.chunk - 2, channel) + convolution.tailPosition, count);
+                        }
+                    }
+                }
+            }
+
+            done += count;
+            convolution.headPosition += count;
+            convolution.tailPosition += count;
+
+            if (convolution.headPosition == HeadPartition) {
+                convolution.headPosition = 0;
+                if (convolution.head) {
+                    const float* in[Channels] = { convolution.headIn.data(), convolution.headIn.data() + HeadPartition };
+                    float* out[Channels] = { convolution.headOut.data(), convolution.headOut.data() + HeadPartition };
+                    convolution.head->process(in, out);
+                }
+            }
+
+            if (convolution.tailPosition == TailPartition) {
+                convolution.tailPosition = 0;
+                ++convolution.chunk;
+                convolution.inputChunks.store(convolution.chunk, std::memory_order_release);
+                startChunk(convolution);
+            }
+        }
+    }
+
+    void ReverbBus::process(juce::AudioBuffer<float>& output, int numSamples)
+    {
+        if (!active_) {
+            return;
+        }
+
+        const auto startTicks = juce::Time::getHighResolutionTicks();
+        numSamples = std::min(numSamples, sendSamples_);
+
+        const float* input[Channels] = { send_.getReadPointer(0), send_.getReadPointer(1) };
+        float* wet[Channels] = { wet_.getWritePointer(0), wet_.getWritePointer(1) };
+
+        if (current_ != nullptr) {
+            renderConvolution(*current_, input, wet, numSamples);
+        } else {
+            wet_.clear(0, numSamples);
+        }
+
+        if (fading_) {
+            float* wetIncoming[Channels] = { wetIncoming_.getWritePointer(0), wetIncoming_.getWritePointer(1) };
+            if (incoming_ != nullptr) {
+                renderConvolution(*incoming_, input, wetIncoming, numSamples);
+            } else {
+                wetIncoming_.clear(0, numSamples);
+            }
+
+            // Equal power: the two reverbs are uncorrelated
+            for (int i = 0; i < numSamples; ++i) {
+                const double t = std::min(1.0, static_cast<double>(fadePosition_ + i) / fadeLength_);
+                const float outGain = static_cast<float>(std::cos(t * juce::MathConstants<double>::halfPi));
+                const float inGain = static_cast<float>(std::sin(t * juce::MathConstants<double>::halfPi));
+                for (int channel = 0; channel < Channels; ++channel) {
+                    wet[channel][i] = wet[channel][i] * outGain + wetIncoming[channel][i] * inGain;
+                }
+            }
+
+            fadePosition_ += numSamples;
+            if (fadePosition_ >= fadeLength_) {
+                retire(current_);
+                current_ = incoming_;
+                incoming_ = nullptr;
+                fading_ = false;
+            }
+        }
+
+        const float returnGain = returnGain_.load(std::memory_order_relaxed);
+        const int firstOutput = returnOutput_.load(std::memory_order_relaxed);
+        for (int channel = 0; channel < Channels; ++channel) {
+            if (firstOutput + channel < output.getNumChannels()) {
+                output.addFromWithRamp(firstOutput + channel, 0, wet[channel], numSamples, lastReturnGain_, returnGain);
+            }
+        }
+        lastReturnGain_ = returnGain;
+
+        const double elapsed = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+        smoothLoad(callbackLoad_, elapsed * sampleRate_ / numSamples);
+    }
+
+    bool ReverbBus::processTails()
+    {
+        bool worked = false;
+
+        for (auto& convolution : owned_) {
+            if (convolution->retired.load(std::memory_order_acquire)) {
+                continue;
+            }
+
+            const double period = TailPartition / convolution->sampleRate;
+            for (auto& segment : convolution->tail) {
+                if (segment->busy.exchange(true, std::memory_order_acquire)) {
+                    continue;
+                }
+
+                const int64_t available = convolution->inputChunks.load(std::memory_order_acquire);
+                int64_t next = segment->processed.load(std::memory_order_relaxed);
+
+                while (next < available) {
+                    const float* input[Channels] = { convolution->tailInput(next, 0), convolution->tailInput(next, 1) };
+
+                    if (next + 1 < available) {
+                        // Already missed: keep the delay line whole but skip
+                        // the output. Far enough behind that the audio thread
+                        // may be rewriting the input, feed silence instead.
+                        if (available - next > Convolution::InputSlots - 2) {
+                            input[0] = segment->silence.data();
+                            input[1] = segment->silence.data();
+                        }
+                        segment->convolver.pushInput(input);
+                    } else {
+                        const auto startTicks = juce::Time::getHighResolutionTicks();
+                        float* output[Channels] = { segment->slot(next, 0), segment->slot(next, 1) };
+                        segment->convolver.process(input, output);
+
+                        const double elapsed = juce::Time::highResolutionTicksToSeconds(
+                            juce::Time::getHighResolutionTicks() - startTicks);
+                        smoothLoad(segmentLoad_[segment->loadSlot], elapsed / period);
+                    }
+
+                    ++next;
+                    segment->processed.store(next, std::memory_order_release);
+                    worked = true;
+                }
+
+                segment->busy.store(false, std::memory_order_release);
+            }
+        }
+
+        return worked;
+    }
+
+    // ============================================================================
+    // ReverbSendSource
+    // ============================================================================
+
+    void ReverbSendSource::setSend(ReverbBus* bus, float level)
+    {
+        level_.store(std::max(0.0f, level), std::memory_order_relaxed);
+        bus_.store(bus, std::memory_order_release);
+    }
+
+    void ReverbSendSource::prepareToPlay(int samplesPerBlockExpected, double sampleRate)
+    {
+        source_->prepareToPlay(samplesPerBlockExpected, sampleRate);
+    }
+
+    void ReverbSendSource::releaseResources()
+    {
+        source_->releaseResources();
+    }
+
+    void ReverbSendSource::getNextAudioBlock(const juce::AudioSourceChannelInfo& info)
+    {
+        source_->getNextAudioBlock(info);
+
+        ReverbBus* bus = bus_.load(std::memory_order_acquire);
+        const float level = bus != nullptr ? level_.load(std::memory_order_relaxed) : 0.0f;
+
+        // Moving to another bus fades the old send out over this block
+        if (bus != lastBus_) {
+            if (lastBus_ != nullptr && lastLevel_ > 0.0f) {
+                lastBus_->addToSend(*info.buffer, info.startSample, info.numSamples, lastLevel_, 0.0f);
+            }
+            lastBus_ = bus;
+            lastLevel_ = 0.0f;
+        }
+
+        if (bus != nullptr && (level > 0.0f || lastLevel_ > 0.0f)) {
+            bus->addToSend(*info.buffer, info.startSample, info.numSamples, lastLevel_, level);
+        }
+        lastLevel_ = level;
+    }
+
+} // namespace CueForge
@@ -0,0 +1,269 @@
+// ============================================================================
+// ConvolutionReverb.h - Partitioned FFT convolution reverb buses
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_dsp/juce_dsp.h>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace CueForge {
+
+    /**
+     * Uniformly partitioned overlap-save convolution of one impulse
+     * response segment: the segment is cut into partitions of B samples,
+     * each kept as a 2B-point spectrum, and every B input samples produce B
+     * output samples from one forward FFT, a multiply-accumulate against
+     * the frequency-domain delay line of past input spectra, and one
+     * inverse FFT.
+     *
+     * The output of a block is the segment's response to everything up to
+     * and including that block, as if the segment started at IR sample 0;
+     * the owner places it at the segment's real offset. delayPartitions
+     * shifts the segment by whole partitions without storing the zeros, so
+     * a tail can be split into pieces that are computed independently.
+     */
+    class UniformConvolver
+    {
+    public:
+        static constexpr int MaxChannels = 2;
+
+        // The segment is impulse[offset, offset + length) of every IR
+        // channel; a mono IR serves both channels. Allocates.
+        UniformConvolver(const juce::AudioBuffer<float>& impulse, int offset, int length,
+            int partitionSize, int delayPartitions = 0);
+
+        int getPartitionSize() const { return partitionSize_; }
+        int getNumPartitions() const { return numPartitions_; }
+
+        void reset();
+
+        // One partition of each channel: input and output are B samples
+        void process(const float* const* input, float* const* output);
+
+        // Feeds a block into the delay line without computing its output,
+        // for catching up after a missed deadline
+        void pushInput(const float* const* input);
+
+    private:
+        void transformInput(int channel, const float* input);
+
+        juce::dsp::FFT fft_;
+        int partitionSize_;
+        int bins_;                      // partitionSize_ + 1
+        int numPartitions_;
+        int delayPartitions_;
+        int depth_;                     // Delay line slots: delay + partitions
+        int fdlHead_ = 0;
+
+        // Split real/imaginary so the multiply-accumulate vectorizes
+        std::vector<float> kernelRe_, kernelIm_;   // [channel][partition][bin]
+        std::vector<float> fdlRe_, fdlIm_;         // [channel][slot][bin]
+        std::vector<float> window_;                // [channel][2B], previous block then current
+        std::vector<float> fftBuffer_;             // 4B, as juce::dsp::FFT wants
+        std::vector<float> accRe_, accIm_;
+        int kernelChannels_ = 1;
+    };
+
+    class ReverbBus;
+
+    /**
+     * Background threads that compute reverb tails. Workers poll the
+     * registered buses, claim any tail segment with a completed input block
+     * and process it; the audio thread never waits on or signals them. A
+     * tail segment runs on one worker at a time, so a long tail split into
+     * segments spreads across workers.
+     */
+    class ReverbWorkerPool
+    {
+    public:
+        explicit ReverbWorkerPool(int numThreads = 0);   // 0: cores - 1, at most 4
+        ~ReverbWorkerPool();
+
+        void start();
+        void stop();
+        int getNumThreads() const { return numThreads_; }
+
+        // Control thread. Buses hold the write lock while adding or
+        // deleting convolutions, workers the read lock while processing.
+        void addBus(ReverbBus* bus);
+        void removeBus(ReverbBus* bus);
+        juce::ReadWriteLock& getLock() { return lock_; }
+
+    private:
+        class Worker;
+
+        bool runOnce();
+
+        int numThreads_;
+        juce::ReadWriteLock lock_;
+        std::vector<ReverbBus*> buses_;     // Guarded by lock_
+        std::vector<std::unique_ptr<Worker>> workers_;
+    };
+
+    /**
+     * A stereo reverb return fed by cue sends.
+     *
+     * The impulse response is split three ways so the bus adds no latency:
+     *   - the first HeadPartition samples as a direct FIR in the callback,
+     *   - up to 2 * TailPartition with a small uniform convolver, also in
+     *     the callback, fed HeadPartition samples at a time,
+     *   - the rest with TailPartition-sized convolvers on the worker pool.
+     * A tail block is computed once its input block is complete and isn't
+     * heard until the block after next, so a worker has a whole
+     * TailPartition period to deliver it. A block that misses that deadline
+     * plays without its tail contribution and is counted in the stats.
+     *
+     * A new impulse response is built off the audio thread, then the bus
+     * crossfades from the old convolution to the new one over
+     * CrossfadeSeconds, so loading never interrupts audio. Convolutions the
+     * audio thread has finished with are freed on the next load.
+     *
+     * Threads: setImpulse/clearImpulse/setReturn/getStats from the control
+     * thread, prepare/release with the device stopped, beginBlock/addToSend/
+     * process from the audio thread.
+     */
+    class ReverbBus
+    {
+    public:
+        static constexpr int Channels = 2;
+        static constexpr int HeadPartition = 64;
+        static constexpr int TailPartition = 1024;
+        static constexpr int MaxTailSegments = 4;
+        static constexpr double MaxImpulseSeconds = 10.0;
+        static constexpr double CrossfadeSeconds = 0.05;
+
+        struct Stats
+        {
+            bool loaded = false;
+            double impulseSeconds = 0.0;
+            int tailSegments = 0;
+            double callbackLoad = 0.0;  // Fraction of the block period spent in the callback
+            double workerLoad = 0.0;    // Worker time per tail block over its period, summed over segments
+            int64_t lateBlocks = 0;     // Tail blocks that missed their deadline
+        };
+
+        ReverbBus(int index, ReverbWorkerPool& pool);
+        ~ReverbBus();
+
+        int getIndex() const { return index_; }
+
+        // Device thread, audio stopped. Rebuilds a loaded IR at the new rate.
+        void prepare(double sampleRate, int maxBlockSize);
+        void release();
+
+        // Control thread. Up to two IR channels are used; the IR is
+        // resampled to the device rate when they differ.
+        bool setImpulse(const juce::AudioBuffer<float>& impulse, double impulseSampleRate,
+            const std::string& source, std::string* error = nullptr);
+        void clearImpulse();
+        bool isLoaded() const { return loaded_.load(std::memory_order_acquire); }
+        std::string getImpulseSource() const;
+
+        void setReturn(float gain, int firstOutput);
+        float getReturnGain() const { return returnGain_.load(std::memory_order_relaxed); }
+        int getReturnOutput() const { return returnOutput_.load(std::memory_order_relaxed); }
+
+        Stats getStats() const;
+
+        // Audio thread: clear the send, let sources add to it, then add the
+        // wet signal to the outputs
+        bool isActive() const { return active_; }
+        void beginBlock(int numSamples);
+        void addToSend(const juce::AudioBuffer<float>& source, int startSample, int numSamples,
+            float startGain, float endGain);
+        void process(juce::AudioBuffer<float>& output, int numSamples);
+
+    private:
+        friend class ReverbWorkerPool;
+
+        struct Convolution;
+        struct TailSegment;
+
+        std::unique_ptr<Convolution> build(const juce::AudioBuffer<float>& impulse, double impulseRate) const;
+        void stage(std::unique_ptr<Convolution> convolution);
+        void collectRetired();              // Pool write lock held
+        void applyPending();
+        void retire(Convolution* convolution);
+        void startChunk(Convolution& convolution);
+        void renderConvolution(Convolution& convolution, const float* const* input, float* const* wet, int numSamples);
+        bool processTails();                // Worker thread, pool read lock held
+
+        const int index_;
+        ReverbWorkerPool& pool_;
+
+        // Control thread side
+        mutable juce::CriticalSection impulseLock_;     // Not taken by the audio thread
+        juce::AudioBuffer<float> impulse_;
+        double impulseRate_ = 0.0;
+        std::string impulseSource_;
+        double sampleRate_ = 0.0;
+        int maxBlockSize_ = 0;
+        std::vector<std::unique_ptr<Convolution>> owned_;   // Modified under the pool write lock
+
+        // Handoff to the audio thread
+        juce::SpinLock pendingLock_;
+        Convolution* pending_ = nullptr;
+        bool hasPending_ = false;
+        std::atomic<bool> pendingChanged_{ false };
+
+        std::atomic<float> returnGain_{ 1.0f };
+        std::atomic<int> returnOutput_{ 0 };
+
+        // Audio thread side
+        Convolution* current_ = nullptr;
+        Convolution* incoming_ = nullptr;
+        bool fading_ = false;
+        int fadePosition_ = 0;
+        int fadeLength_ = 0;
+        bool active_ = false;
+        float lastReturnGain_ = 0.0f;
+        int capacity_ = 0;
+        int sendSamples_ = 0;
+        juce::AudioBuffer<float> send_;
+        juce::AudioBuffer<float> wet_;
+        juce::AudioBuffer<float> wetIncoming_;
+
+        // Stats
+        std::atomic<double> callbackLoad_{ 0.0 };
+        std::atomic<double> segmentLoad_[MaxTailSegments];
+        std::atomic<int64_t> lateBlocks_{ 0 };
+        std::atomic<bool> loaded_{ false };
+        std::atomic<double> impulseSeconds_{ 0.0 };
+        std::atomic<int> tailSegments_{ 0 };
+
+        JUCE_DECLARE_NON_COPYABLE(ReverbBus)
+    };
+
+    /**
+     * Wraps a player's source in the mixer and adds its output, post
+     * volume, to a reverb bus send. The bus and level may be changed from
+     * any thread; level changes ramp over one block.
+     */
+    class ReverbSendSource : public juce::AudioSource
+    {
+    public:
+        explicit ReverbSendSource(juce::AudioSource* source) : source_(source) {}
+
+        void setSend(ReverbBus* bus, float level);
+        ReverbBus* getSendBus() const { return bus_.load(std::memory_order_relaxed); }
+        float getSendLevel() const { return level_.load(std::memory_order_relaxed); }
+
+        void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
+        void releaseResources() override;
+        void getNextAudioBlock(const juce::AudioSourceChannelInfo& info) override;
+
+    private:
+        juce::AudioSource* source_;
+        std::atomic<ReverbBus*> bus_{ nullptr };
+        std::atomic<float> level_{ 0.0f };
+        ReverbBus* lastBus_ = nullptr;      // Audio thread
+        float lastLevel_ = 0.0f;
+    };
+
+} // namespace CueForge
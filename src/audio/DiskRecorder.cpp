@@ -0,0 +1,326 @@
+// ============================================================================
+// DiskRecorder.cpp - Callback-fed recording to WAV or FLAC
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#include "DiskRecorder.h"
+#include <algorithm>
+#include <iostream>
+
+#if JUCE_LINUX
+#include <fcntl.h>
+#include <linux/falloc.h>
+#include <unistd.h>
+#endif
+
+namespace CueForge {
+
+    DiskRecorder::DiskRecorder(int id, juce::TimeSliceThread& writerThread)
+        : id_(id)
+        , writerThread_(writerThread)
+    {
+        closed_.signal();
+    }
+
+    DiskRecorder::~DiskRecorder()
+    {
+        // Waits for a slice in progress on this recorder to finish; an
+        // unfinished take is closed here with what reached the ring
+        writerThread_.removeTimeSliceClient(this);
+        closeWriter();
+    }
+
+    bool DiskRecorder::open(const std::string& filePath, const RecordSettings& settings,
+        double sampleRate, std::string* error)
+    {
+        auto fail = [error](const std::string& message) {
+            std::cerr << "DiskRecorder: " << message << std::endl;
+            if (error) {
+                *error = message;
+            }
+            return false;
+        };
+
+        writerThread_.removeTimeSliceClient(this);
+        closeWriter();
+
+        const int numChannels = static_cast<int>(settings.channels.size());
+        if (numChannels < 1 || numChannels > MaxChannels) {
+            return fail("Need 1 to " + std::to_string(MaxChannels) + " channels");
+        }
+        for (int channel : settings.channels) {
+            if (channel < 0) {
+                return fail("Negative channel index");
+            }
+        }
+        if (sampleRate <= 0.0) {
+            return fail("No audio device running");
+        }
+
+        const juce::File file(filePath);
+        if (!file.getParentDirectory().createDirectory()) {
+            return fail("Cannot create folder for: " + filePath);
+        }
+        file.deleteFile();
+        if (!file.create()) {
+            return fail("Cannot create: " + filePath);
+        }
+
+        const int64_t bytes = static_cast<int64_t>(settings.preallocateSeconds * sampleRate)
+            * numChannels * (settings.bitDepth / 8);
+        reserved_ = bytes > 0 && reserveSpace(file, bytes);
+
+        auto stream = std::make_unique<juce::FileOutputStream>(file, StreamBufferBytes);
+        if (!stream->openedOk()) {
+            return fail("Cannot write: " + filePath);
+        }
+
+        std::unique_ptr<juce::AudioFormat> format;
+        if (settings.format == RecordSettings::Format::Flac) {
+            format = std::make_unique<juce::FlacAudioFormat>();
+        }
+        else {
+            format = std::make_unique<juce::WavAudioFormat>();
+        }
+
+        writer_.reset(format->createWriterFor(stream.get(), sampleRate,
+            static_cast<unsigned int>(numChannels), settings.bitDepth, {}, 0));
+        if (!writer_) {
+            stream.reset();
+            file.deleteFile();
+            return fail(format->getFormatName().toStdString() + " cannot record " + std::to_string(numChannels)
+                + " channels at " + std::to_string(settings.bitDepth) + " bits");
+        }
+        stream.release();   // Owned by the writer now
+
+        filePath_ = filePath;
+        settings_ = settings;
+        sampleRate_ = sampleRate;
+
+        // Sized so the writer thread can stall for a few seconds (a slow
+        // disk, a busy machine) before the callback has to drop anything
+        const int ringSize = std::max(2 * WriteChunk + 1, static_cast<int>(sampleRate * RingSeconds));
+        fifo_.setTotalSize(ringSize);
+        fifo_.reset();
+        ring_.setSize(numChannels, ringSize);
+        ring_.clear();
+
+        recording_.store(false, std::memory_order_release);
+        finishing_.store(false, std::memory_order_release);
+        samplesRecorded_.store(0, std::memory_order_relaxed);
+        samplesWritten_.store(0, std::memory_order_relaxed);
+        droppedBlocks_.store(0, std::memory_order_relaxed);
+        droppedSamples_.store(0, std::memory_order_relaxed);
+        peakFill_.store(0, std::memory_order_relaxed);
+        writeFailed_.store(false, std::memory_order_relaxed);
+        closed_.reset();
+
+        writerThread_.addTimeSliceClient(this);
+        return true;
+    }
+
+    void DiskRecorder::start()
+    {
+        if (!closed_.wait(0)) {
+            recording_.store(true, std::memory_order_release);
+        }
+    }
+
+    void DiskRecorder::stop()
+    {
+        recording_.store(false, std::memory_order_release);
+    }
+
+    bool DiskRecorder::finish(int timeoutMs)
+    {
+        stop();
+        if (closed_.wait(0)) {
+            return !writeFailed_.load(std::memory_order_relaxed);
+        }
+
+        finishing_.store(true, std::memory_order_release);
+        writerThread_.moveToFrontOfQueue(this);
+        if (!closed_.wait(timeoutMs)) {
+            std::cerr << "DiskRecorder: timed out closing " << filePath_ << std::endl;
+            return false;
+        }
+        return !writeFailed_.load(std::memory_order_relaxed);
+    }
+
+    double DiskRecorder::getSeconds() const
+    {
+        return sampleRate_ > 0.0 ? samplesRecorded_.load(std::memory_order_relaxed) / sampleRate_ : 0.0;
+    }
+
+    RecordStats DiskRecorder::getStats() const
+    {
+        RecordStats stats;
+        stats.recording = isRecording();
+        stats.samplesRecorded = samplesRecorded_.load(std::memory_order_relaxed);
+        stats.samplesWritten = samplesWritten_.load(std::memory_order_relaxed);
+        stats.droppedBlocks = droppedBlocks_.load(std::memory_order_relaxed);
+        stats.droppedSamples = droppedSamples_.load(std::memory_order_relaxed);
+        stats.peakRingFill = ring_.getNumSamples() > 0
+            ? static_cast<double>(peakFill_.load(std::memory_order_relaxed)) / (fifo_.getTotalSize() - 1)
+            : 0.0;
+        stats.writeFailed = writeFailed_.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    // ============================================================================
+    // Audio thread
+    // ============================================================================
+
+    void DiskRecorder::push(const float* const* channels, int numChannels, int numSamples)
+    {
+        if (!recording_.load(std::memory_order_acquire)) {
+            return;
+        }
+
+        // All or nothing: a partial block would splice a gap into the take
+        // without a trace, a dropped one is at least counted
+        if (fifo_.getFreeSpace() < numSamples) {
+            droppedBlocks_.fetch_add(1, std::memory_order_relaxed);
+            droppedSamples_.fetch_add(numSamples, std::memory_order_relaxed);
+            return;
+        }
+
+        int start1, size1, start2, size2;
+        fifo_.prepareToWrite(numSamples, start1, size1, start2, size2);
+
+        for (int ch = 0; ch < ring_.getNumChannels(); ++ch) {
+            const int source = settings_.channels[static_cast<size_t>(ch)];
+            const float* data = source < numChannels ? channels[source] : nullptr;
+            if (data == nullptr) {
+                ring_.clear(ch, start1, size1);
+                if (size2 > 0) {
+                    ring_.clear(ch, start2, size2);
+                }
+                continue;
+            }
+
+            ring_.copyFrom(ch, start1, data, size1);
+            if (size2 > 0) {
+                ring_.copyFrom(ch, start2, data + size1, size2);
+            }
+        }
+
+        fifo_.finishedWrite(size1 + size2);
+        samplesRecorded_.fetch_add(numSamples, std::memory_order_relaxed);
+
+        const int fill = fifo_.getNumReady();
+        if (fill > peakFill_.load(std::memory_order_relaxed)) {
+            peakFill_.store(fill, std::memory_order_relaxed);
+        }
+    }
+
+    // ============================================================================
+    // Writer thread
+    // ============================================================================
+
+    int DiskRecorder::useTimeSlice()
+    {
+        if (!writer_) {
+            return 500;
+        }
+
+        // Whole chunks only while recording, so each write is a long run;
+        // the tail goes out once the take has finished
+        const bool finishing = finishing_.load(std::memory_order_acquire);
+        const int ready = fifo_.getNumReady();
+        if (ready >= WriteChunk || (finishing && ready > 0)) {
+            writeChunk(std::min(ready, WriteChunk));
+            return 0;
+        }
+
+        if (finishing) {
+            closeWriter();
+            return 500;
+        }
+        return 20;
+    }
+
+    void DiskRecorder::writeChunk(int numSamples)
+    {
+        int start1, size1, start2, size2;
+        fifo_.prepareToRead(numSamples, start1, size1, start2, size2);
+
+        const int numChannels = ring_.getNumChannels();
+        const float* pointers[MaxChannels];
+        bool ok = !writeFailed_.load(std::memory_order_relaxed);
+
+        for (const auto& [start, size] : { std::make_pair(start1, size1), std::make_pair(start2, size2) }) {
+            if (size == 0 || !ok) {
+                continue;
+            }
+            for (int ch = 0; ch < numChannels; ++ch) {
+                pointers[ch] = ring_.getReadPointer(ch, start);
+            }
+            ok = writer_->writeFromFloatArrays(pointers, numChannels, size);
+        }
+
+        fifo_.finishedRead(size1 + size2);
+
+        if (ok) {
+            samplesWritten_.fetch_add(size1 + size2, std::memory_order_relaxed);
+        }
+        else {
+            if (!writeFailed_.exchange(true, std::memory_order_relaxed)) {
+                std::cerr << "DiskRecorder: write failed, dropping the rest of " << filePath_ << std::endl;
+            }
+            droppedSamples_.fetch_add(size1 + size2, std::memory_order_relaxed);
+        }
+    }
+
+    void DiskRecorder::closeWriter()
+    {
+        if (!writer_) {
+            return;
+        }
+
+        // The writer fills in the header and flushes the stream as it goes
+        writer_.reset();
+        if (reserved_) {
+            releaseUnusedSpace(juce::File(filePath_));
+            reserved_ = false;
+        }
+        closed_.signal();
+    }
+
+    // ============================================================================
+    // Space reservation
+    // ============================================================================
+
+    bool DiskRecorder::reserveSpace(const juce::File& file, int64_t bytes)
+    {
+#if JUCE_LINUX
+        const int fd = ::open(file.getFullPathName().toRawUTF8(), O_WRONLY);
+        if (fd < 0) {
+            return false;
+        }
+
+        // KEEP_SIZE allocates the blocks but leaves the length at zero, so
+        // the encoder still writes from the start of an empty file
+        const bool ok = ::fallocate(fd, FALLOC_FL_KEEP_SIZE, 0, static_cast<off_t>(bytes)) == 0;
+        ::close(fd);
+        return ok;
+#else
+        juce::ignoreUnused(file, bytes);
+        return false;
+#endif
+    }
+
+    void DiskRecorder::releaseUnusedSpace(const juce::File& file)
+    {
+#if JUCE_LINUX
+        // Truncating to the current length frees the blocks past the end
+        const juce::String path = file.getFullPathName();
+        if (::truncate(path.toRawUTF8(), static_cast<off_t>(file.getSize())) != 0) {
+            std::cerr << "DiskRecorder: could not release reserved space of " << path << std::endl;
+        }
+#else
+        juce::ignoreUnused(file);
+#endif
+    }
+
+} // namespace CueForge
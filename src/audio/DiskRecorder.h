@@ -0,0 +1,133 @@
+// ============================================================================
+// DiskRecorder.h - Callback-fed recording to WAV or FLAC
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace CueForge {
+
+    /**
+     * What a recorder takes from the callback and how it is written
+     */
+    struct RecordSettings
+    {
+        enum class Source {
+            Inputs,     // Device inputs as delivered to the callback
+            Mix         // The programme mix, before the output stage
+        };
+
+        enum class Format {
+            Wav,
+            Flac
+        };
+
+        Source source = Source::Inputs;
+        std::vector<int> channels{ 0, 1 };  // Zero-based, of the source
+        Format format = Format::Wav;
+        int bitDepth = 24;                  // 16 or 24; WAV also takes 32 (float)
+
+        // Disk space reserved when the file is opened, so a long take does
+        // not grow the file block by block; the unused rest is given back
+        // when it closes. Linux only; elsewhere the file grows as written.
+        double preallocateSeconds = 600.0;
+    };
+
+    struct RecordStats
+    {
+        bool recording = false;
+        int64_t samplesRecorded = 0;    // Taken from the callback
+        int64_t samplesWritten = 0;     // Handed to the encoder
+        int64_t droppedBlocks = 0;      // Callback blocks that found the ring full
+        int64_t droppedSamples = 0;     // Their length, plus anything a failed write lost
+        double peakRingFill = 0.0;      // Highest fraction of the ring in use
+        bool writeFailed = false;       // Disk full or gone; the rest is dropped
+    };
+
+    /**
+     * Records one take. The audio callback hands each block to push(), which
+     * copies the selected channels into a lock-free ring and never waits: if
+     * the ring is full the whole block is dropped and counted. A shared
+     * writer thread drains the ring in WriteChunk runs into the encoder,
+     * whose file stream has a large buffer, so the disk sees long sequential
+     * writes.
+     *
+     * Threads: open(), start(), stop() and finish() from the control thread,
+     * push() from the audio thread, useTimeSlice() from the writer thread.
+     * finish() expects push() to be done for good: the engine calls stop(),
+     * then waits out any callback block still pushing. Once
+     * finish() returns the file is complete and can be opened for playback.
+     */
+    class DiskRecorder : private juce::TimeSliceClient
+    {
+    public:
+        static constexpr int MaxChannels = 16;
+        static constexpr double RingSeconds = 4.0;
+        static constexpr int WriteChunk = 32768;            // Samples per encoder write
+        static constexpr int StreamBufferBytes = 1 << 20;
+
+        DiskRecorder(int id, juce::TimeSliceThread& writerThread);
+        ~DiskRecorder() override;
+
+        // Creates the file, reserves its space and allocates the ring
+        bool open(const std::string& filePath, const RecordSettings& settings,
+            double sampleRate, std::string* error = nullptr);
+
+        void start();
+        void stop();                        // No more blocks are taken
+        bool finish(int timeoutMs = 5000);  // Drains the ring and closes the file
+
+        int getId() const { return id_; }
+        const std::string& getFilePath() const { return filePath_; }
+        const RecordSettings& getSettings() const { return settings_; }
+        bool isRecording() const { return recording_.load(std::memory_order_acquire); }
+        double getSeconds() const;
+        RecordStats getStats() const;
+
+        // Audio thread
+        void push(const float* const* channels, int numChannels, int numSamples);
+
+    private:
+        int useTimeSlice() override;
+        void writeChunk(int numSamples);
+        void closeWriter();
+
+        static bool reserveSpace(const juce::File& file, int64_t bytes);
+        static void releaseUnusedSpace(const juce::File& file);
+
+        const int id_;
+        juce::TimeSliceThread& writerThread_;
+
+        std::string filePath_;
+        RecordSettings settings_;
+        double sampleRate_ = 0.0;
+
+        // Writer thread, until closed
+        std::unique_ptr<juce::AudioFormatWriter> writer_;
+        bool reserved_ = false;
+
+        juce::AbstractFifo fifo_{ 1 };
+        juce::AudioBuffer<float> ring_;
+
+        std::atomic<bool> recording_{ false };
+        std::atomic<bool> finishing_{ false };
+        juce::WaitableEvent closed_{ true };
+
+        std::atomic<int64_t> samplesRecorded_{ 0 };
+        std::atomic<int64_t> samplesWritten_{ 0 };
+        std::atomic<int64_t> droppedBlocks_{ 0 };
+        std::atomic<int64_t> droppedSamples_{ 0 };
+        std::atomic<int> peakFill_{ 0 };     // Samples; written by the audio thread only
+        std::atomic<bool> writeFailed_{ false };
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DiskRecorder)
+    };
+
+} // namespace CueForge
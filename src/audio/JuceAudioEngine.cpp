@@ -4,7 +4,11 @@
 // ============================================================================
 
 #include "JuceAudioEngine.h"
+#include "RealtimeSanitizer.h"
+#include <algorithm>
 #include <iostream>
+#include <chrono>
+#include <cmath>
 
 namespace CueForge {
 
@@ -14,8 +18,21 @@ namespace CueForge {
 
     JuceAudioEngine::JuceAudioEngine()
         : nextPlayerId_(1)
+        , nextStemPlayerId_(1)
+        , nextPlaylistPlayerId_(1)
+        , nextLiveInputId_(1)
+        , nextRecorderId_(1)
         , initialized_(false)
+        , samplesRendered_(0)
+        , clockSampleRate_(44100.0)
+        , onsetProbeEnabled_(false)
+        , lastOnsetNanos_(0)
+        , probeWasAudible_(false)
     {
+        for (int bus = 0; bus < MaxReverbBuses; ++bus) {
+            reverbBuses_.push_back(std::make_unique<ReverbBus>(bus, reverbWorkers_));
+        }
+
         // Register audio formats
         formatManager_.registerBasicFormats(); // WAV, AIFF
 
@@ -39,9 +56,10 @@ namespace CueForge {
             return true;
         }
 
-        // Initialize with default device
+        // Initialize with default device. Inputs are opened for live input
+        // cues; a device with fewer simply opens what it has.
         juce::String error = deviceManager_.initialise(
-            0,      // numInputChannelsNeeded
+            DefaultInputChannels,   // numInputChannelsNeeded
             2,      // numOutputChannelsNeeded (stereo)
             nullptr, // preferredDefaultDevice
             true    // selectDefaultDeviceOnFailure
@@ -65,6 +83,52 @@ namespace CueForge {
         return true;
     }
 
+    bool JuceAudioEngine::initializeNull(const NullAudioSettings& settings)
+    {
+        if (initialized_) {
+            return true;
+        }
+
+        // With a type registered up front, AudioDeviceManager skips creating
+        // the platform types - so no hardware is probed at all
+        deviceManager_.addAudioDeviceType(std::make_unique<NullAudioIODeviceType>(settings));
+
+        juce::AudioDeviceManager::AudioDeviceSetup setup;
+        setup.outputDeviceName = NullAudioIODevice::DeviceName;
+        setup.inputDeviceName = settings.inputChannels > 0 ? NullAudioIODevice::DeviceName : "";
+        setup.sampleRate = settings.sampleRate;
+        setup.bufferSize = settings.bufferSize;
+
+        juce::String error = deviceManager_.initialise(
+            settings.inputChannels,
+            settings.outputChannels,
+            nullptr,
+            false,
+            {},
+            &setup
+        );
+
+        if (error.isNotEmpty()) {
+            std::cerr << "Null audio device init failed: " << error.toStdString() << std::endl;
+            return false;
+        }
+
+        deviceManager_.addAudioCallback(this);
+
+        initialized_ = true;
+
+        std::cout << "Audio engine initialized (null device)" << std::endl;
+        std::cout << "  Sample Rate: " << getSampleRate() << " Hz" << std::endl;
+        std::cout << "  Buffer Size: " << getBufferSize() << " samples" << std::endl;
+
+        return true;
+    }
+
+    NullAudioIODevice* JuceAudioEngine::getNullDevice() const
+    {
+        return dynamic_cast<NullAudioIODevice*>(deviceManager_.getCurrentAudioDevice());
+    }
+
     void JuceAudioEngine::shutdown()
     {
         if (!initialized_) {
@@ -74,7 +138,41 @@ namespace CueForge {
         deviceManager_.removeAudioCallback(this);
         deviceManager_.closeAudioDevice();
 
+        // Takes still running are closed with what reached the disk writer
+        {
+            const ProfiledLock::ScopedLockType lock(recorderLock_);
+            for (auto& entry : recorders_) {
+                entry.second->stop();
+            }
+            recorderSet_.publish(std::make_unique<std::vector<DiskRecorder*>>());
+        }
+        for (auto& entry : recorders_) {
+            entry.second->finish();
+        }
+        recorders_.clear();
+        diskWriterThread_.stopThread(2000);
+
+        previewBus_.clear();
+        {
+            const juce::SpinLock::ScopedLockType fadeLock(fadeLock_);
+            pendingFadeCount_ = 0;
+        }
         players_.clear();
+        for (auto& entry : stemPlayers_) {
+            mixer_.removeInputSource(entry.second.get());
+        }
+        for (auto& entry : playlistPlayers_) {
+            mixer_.removeInputSource(entry.second.get());
+        }
+        stemPlayers_.clear();
+        playlistPlayers_.clear();
+        readAheadThread_.stopThread(2000);
+        reverbWorkers_.stop();
+        {
+            const ProfiledLock::ScopedLockType lock(liveInputLock_);
+            liveInputTable_.publish(std::make_unique<LiveInputTable>());
+            liveInputs_.clear();
+        }
 
         initialized_ = false;
 
@@ -126,13 +224,25 @@ namespace CueForge {
     }
 
     void JuceAudioEngine::audioDeviceIOCallbackWithContext(
-        const float* const* /*inputChannelData*/,
-        int /*numInputChannels*/,
+        const float* const* inputChannelData,
+        int numInputChannels,
         float* const* outputChannelData,
         int numOutputChannels,
         int numSamples,
         const juce::AudioIODeviceCallbackContext& /*context*/)
     {
+        RealtimeSanitizer::ScopedRealtime realtimeScope("JuceAudioEngine::audioDeviceIOCallbackWithContext");
+        LockProfiler::setThreadName("audio");
+
+        // The preview bus measures its budget from here
+        const int64_t callbackStartTicks = juce::Time::getHighResolutionTicks();
+
+        const bool probe = onsetProbeEnabled_.load(std::memory_order_relaxed);
+        const int64_t blockStartNs = probe
+            ? std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count()
+            : 0;
+
         // Create audio buffer for output
         juce::AudioBuffer<float> buffer(outputChannelData, numOutputChannels, numSamples);
 
@@ -145,11 +255,71 @@ namespace CueForge {
         channelInfo.startSample = 0;
         channelInfo.numSamples = numSamples;
 
-        mixer_.getNextAudioBlock(channelInfo);
+        // Players add to the reverb sends as the mixer pulls them
+        for (auto& bus : reverbBuses_) {
+            bus->beginBlock(numSamples);
+        }
+
+        startPendingFades();
+
+        // MixerAudioSource serialises this pull against add/remove with its
+        // own private lock; the pull is timed so it reads next to the
+        // engine's lock sites
+        if (LockProfiler::isEnabled()) {
+            const int64_t pullStartNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+            mixer_.getNextAudioBlock(channelInfo);
+            LockProfiler::recordSection(mixerPullSite_, LockProfiler::currentThread(),
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()).count() - pullStartNs);
+        }
+        else {
+            mixer_.getNextAudioBlock(channelInfo);
+        }
+
+        for (auto& bus : reverbBuses_) {
+            bus->process(buffer, numSamples);
+        }
+
+        mixLiveInputs(inputChannelData, numInputChannels, buffer, numSamples);
+        recordBlock(inputChannelData, numInputChannels, buffer, numSamples);
+
+        // Speaker alignment and voicing - the last thing before the device
+        outputProcessor_.process(buffer, numSamples);
+
+        if (probe) {
+            // -80 dBFS counts as silence
+            const bool audible = buffer.getMagnitude(0, numSamples) > 1.0e-4f;
+            if (audible && !probeWasAudible_) {
+                lastOnsetNanos_.store(blockStartNs, std::memory_order_release);
+            }
+            probeWasAudible_ = audible;
+        }
+
+        // Auditions last, in whatever time the show has left over
+        previewBus_.process(buffer, numSamples, callbackStartTicks);
+
+        samplesRendered_.fetch_add(numSamples, std::memory_order_release);
     }
 
     void JuceAudioEngine::audioDeviceAboutToStart(juce::AudioIODevice* device)
     {
+        clockSampleRate_.store(device->getCurrentSampleRate(), std::memory_order_release);
+
+        outputProcessor_.prepare(device->getActiveOutputChannels().countNumberOfSetBits(),
+            device->getCurrentBufferSizeSamples(), device->getCurrentSampleRate());
+
+        bool anyReverb = false;
+        for (auto& bus : reverbBuses_) {
+            bus->prepare(device->getCurrentSampleRate(), device->getCurrentBufferSizeSamples());
+            anyReverb = anyReverb || bus->isLoaded();
+        }
+        if (anyReverb) {
+            reverbWorkers_.start();
+        }
+
+        previewBus_.prepare(device->getCurrentBufferSizeSamples(), device->getCurrentSampleRate());
+
         mixer_.prepareToPlay(device->getCurrentBufferSizeSamples(),
             device->getCurrentSampleRate());
     }
@@ -157,11 +327,194 @@ namespace CueForge {
     void JuceAudioEngine::audioDeviceStopped()
     {
         mixer_.releaseResources();
+        outputProcessor_.release();
+
+        for (auto& bus : reverbBuses_) {
+            bus->release();
+        }
+
+        previewBus_.release();
+    }
+
+    bool JuceAudioEngine::setOutputSettings(int outputChannel, const OutputSettings& settings)
+    {
+        return outputProcessor_.setOutput(outputChannel, settings);
+    }
+
+    OutputSettings JuceAudioEngine::getOutputSettings(int outputChannel) const
+    {
+        return outputProcessor_.getOutput(outputChannel);
+    }
+
+    // ============================================================================
+    // Reverb buses
+    // ============================================================================
+
+    bool JuceAudioEngine::loadReverbImpulse(int bus, const std::string& filePath, std::string* error)
+    {
+        ReverbBus* reverb = getReverbBus(bus);
+        if (!reverb) {
+            if (error) {
+                *error = "No reverb bus " + std::to_string(bus);
+            }
+            return false;
+        }
+
+        // Read and transform off the audio thread; the bus crossfades to
+        // the new IR once it is ready
+        std::unique_ptr<juce::AudioFormatReader> reader(formatManager_.createReaderFor(juce::File(filePath)));
+        if (!reader) {
+            if (error) {
+                *error = "Could not open impulse response: " + filePath;
+            }
+            return false;
+        }
+        if (reader->lengthInSamples > static_cast<juce::int64>(ReverbBus::MaxImpulseSeconds * reader->sampleRate)) {
+            if (error) {
+                *error = "Impulse response is longer than "
+                    + std::to_string(static_cast<int>(ReverbBus::MaxImpulseSeconds)) + " seconds: " + filePath;
+            }
+            return false;
+        }
+
+        const int length = static_cast<int>(reader->lengthInSamples);
+        juce::AudioBuffer<float> impulse(static_cast<int>(std::min(2u, reader->numChannels)), length);
+        reader->read(&impulse, 0, length, 0, true, true);
+
+        reverbWorkers_.start();
+        return reverb->setImpulse(impulse, reader->sampleRate, filePath, error);
+    }
+
+    void JuceAudioEngine::clearReverbImpulse(int bus)
+    {
+        if (ReverbBus* reverb = getReverbBus(bus)) {
+            reverb->clearImpulse();
+        }
+    }
+
+    void JuceAudioEngine::setReverbReturn(int bus, float gain, int firstOutput)
+    {
+        if (ReverbBus* reverb = getReverbBus(bus)) {
+            reverb->setReturn(gain, firstOutput);
+        }
+    }
+
+    bool JuceAudioEngine::setPlayerReverbSend(int playerId, int bus, float level)
+    {
+        ReverbBus* reverb = bus >= 0 ? getReverbBus(bus) : nullptr;
+        if (bus >= 0 && !reverb) {
+            return false;
+        }
+
+        const ProfiledLock::ScopedLockType lock(playerLock_);
+        auto it = players_.find(playerId);
+        if (it == players_.end()) {
+            return false;
+        }
+        if (reverb && previewBus_.contains(it->second->getMixerSource())) {
+            return false;   // Reverb returns feed the show outputs
+        }
+        it->second->setReverbSend(reverb, reverb ? level : 0.0f);
+        return true;
+    }
+
+    ReverbBus* JuceAudioEngine::getReverbBus(int bus)
+    {
+        return bus >= 0 && bus < MaxReverbBuses ? reverbBuses_[static_cast<size_t>(bus)].get() : nullptr;
+    }
+
+    ReverbBus::Stats JuceAudioEngine::getReverbBusStats(int bus) const
+    {
+        return bus >= 0 && bus < MaxReverbBuses ? reverbBuses_[static_cast<size_t>(bus)]->getStats() : ReverbBus::Stats();
+    }
+
+    // ============================================================================
+    // Time stretch
+    // ============================================================================
+
+    void JuceAudioEngine::prepareTimeStretch(const std::string& filePath, double rate)
+    {
+        if (std::abs(rate - 1.0) > 1.0e-4) {
+            stretchCache_.prepare(filePath, rate);
+        }
+    }
+
+    bool JuceAudioEngine::isTimeStretchReady(const std::string& filePath, double rate) const
+    {
+        return std::abs(rate - 1.0) <= 1.0e-4 || stretchCache_.isReady(filePath, rate);
+    }
+
+    bool JuceAudioEngine::setPlayerTimeStretch(int playerId, double rate, bool automated, std::string* error)
+    {
+        auto fail = [error](const std::string& message) {
+            std::cerr << "Time stretch: " << message << std::endl;
+            if (error) {
+                *error = message;
+            }
+            return false;
+        };
+
+        const ProfiledLock::ScopedLockType lock(playerLock_);
+        auto it = players_.find(playerId);
+        if (it == players_.end()) {
+            return fail("No player " + std::to_string(playerId));
+        }
+        AudioPlayer& player = *it->second;
+
+        if (!automated && std::abs(rate - 1.0) <= 1.0e-4) {
+            return player.setTimeStretch(1.0, nullptr, nullptr);
+        }
+
+        if (!automated) {
+            if (auto rendered = stretchCache_.find(player.getFilePath(), rate)) {
+                return player.setTimeStretch(rate, std::move(rendered), nullptr);
+            }
+        }
+
+        // Live stretching costs a share of the read-ahead thread per voice
+        int live = 0;
+        for (const auto& entry : players_) {
+            const StretchStats stats = entry.second->getStretchStats();
+            live += (entry.first != playerId && stats.active && !stats.rendered) ? 1 : 0;
+        }
+        if (live >= MaxLiveStretchVoices) {
+            player.setTimeStretch(1.0, nullptr, nullptr);
+            return fail(std::to_string(MaxLiveStretchVoices) + " voices already stretching live; "
+                + player.getFilePath() + " plays at its original tempo");
+        }
+
+        startReadAheadThread();
+        return player.setTimeStretch(rate, nullptr, &readAheadThread_);
+    }
+
+    bool JuceAudioEngine::setPlayerStretchRate(int playerId, double rate)
+    {
+        const ProfiledLock::ScopedLockType lock(playerLock_);
+        auto it = players_.find(playerId);
+        return it != players_.end() && it->second->setStretchRate(rate);
+    }
+
+    bool JuceAudioEngine::setPlayerTrim(int playerId, float gain)
+    {
+        const ProfiledLock::ScopedLockType lock(playerLock_);
+        auto it = players_.find(playerId);
+        if (it == players_.end()) {
+            return false;
+        }
+        it->second->setTrim(gain);
+        return true;
+    }
+
+    StretchStats JuceAudioEngine::getPlayerStretchStats(int playerId) const
+    {
+        const ProfiledLock::ScopedLockType lock(playerLock_);
+        auto it = players_.find(playerId);
+        return it != players_.end() ? it->second->getStretchStats() : StretchStats();
     }
 
     int JuceAudioEngine::createPlayer(const std::string& filePath)
     {
-        juce::ScopedLock lock(playerLock_);
+        const ProfiledLock::ScopedLockType lock(playerLock_);
 
         int playerId = nextPlayerId_++;
 
@@ -171,8 +524,9 @@ namespace CueForge {
             return -1;
         }
 
-        // Add player's audio source to mixer
-        mixer_.addInputSource(player->getTransportSource(), false);
+        // Add player's audio source to mixer, which prepares it before
+        // taking the lock the callback's pull holds
+        mixer_.addInputSource(player->getMixerSource(), false);
 
         players_[playerId] = std::move(player);
 
@@ -181,12 +535,17 @@ namespace CueForge {
 
     void JuceAudioEngine::removePlayer(int playerId)
     {
-        juce::ScopedLock lock(playerLock_);
+        const ProfiledLock::ScopedLockType lock(playerLock_);
 
         auto it = players_.find(playerId);
         if (it != players_.end()) {
-            // Remove from mixer
-            mixer_.removeInputSource(it->second->getTransportSource());
+            // Remove from mixer, or from the preview bus
+            if (!previewBus_.removeVoice(it->second->getMixerSource())) {
+                mixer_.removeInputSource(it->second->getMixerSource());
+            }
+
+            // And from any crossfade the audio thread has not started yet
+            cancelPendingFades(&it->second->getFader());
 
             // Delete player
             players_.erase(it);
@@ -195,7 +554,7 @@ namespace CueForge {
 
     AudioPlayer* JuceAudioEngine::getPlayer(int playerId)
     {
-        juce::ScopedLock lock(playerLock_);
+        const ProfiledLock::ScopedLockType lock(playerLock_);
 
         auto it = players_.find(playerId);
         if (it != players_.end()) {
@@ -205,6 +564,286 @@ namespace CueForge {
         return nullptr;
     }
 
+    // ============================================================================
+    // Stem and playlist players
+    // ============================================================================
+
+    void JuceAudioEngine::startReadAheadThread()
+    {
+        if (!readAheadThread_.isThreadRunning()) {
+            readAheadThread_.startThread(juce::Thread::Priority::high);
+        }
+    }
+
+    int JuceAudioEngine::createStemPlayer(const std::vector<std::string>& filePaths, std::string* error)
+    {
+        const ProfiledLock::ScopedLockType lock(playerLock_);
+
+        startReadAheadThread();
+
+        const int stemPlayerId = nextStemPlayerId_++;
+        auto stemPlayer = std::make_unique<StemPlayer>(stemPlayerId, formatManager_, readAheadThread_);
+
+        if (!stemPlayer->loadFiles(filePaths, error)) {
+            return -1;
+        }
+        stemPlayer->setDefaultRoutes(getNumOutputChannels());
+
+        mixer_.addInputSource(stemPlayer.get(), false);
+
+        stemPlayers_[stemPlayerId] = std::move(stemPlayer);
+        return stemPlayerId;
+    }
+
+    void JuceAudioEngine::removeStemPlayer(int stemPlayerId)
+    {
+        const ProfiledLock::ScopedLockType lock(playerLock_);
+
+        auto it = stemPlayers_.find(stemPlayerId);
+        if (it != stemPlayers_.end()) {
+            mixer_.removeInputSource(it->second.get());
+            stemPlayers_.erase(it);
+        }
+    }
+
+    StemPlayer* JuceAudioEngine::getStemPlayer(int stemPlayerId)
+    {
+        const ProfiledLock::ScopedLockType lock(playerLock_);
+
+        auto it = stemPlayers_.find(stemPlayerId);
+        return it != stemPlayers_.end() ? it->second.get() : nullptr;
+    }
+
+    int JuceAudioEngine::getStemPlayerCount() const
+    {
+        const ProfiledLock::ScopedLockType lock(playerLock_);
+        return static_cast<int>(stemPlayers_.size());
+    }
+
+    int JuceAudioEngine::createPlaylistPlayer(const std::vector<std::string>& filePaths,
+        const PlaylistPlayer::Options& options, std::string* error)
+    {
+        const ProfiledLock::ScopedLockType lock(playerLock_);
+
+        startReadAheadThread();
+
+        const int playlistPlayerId = nextPlaylistPlayerId_++;
+        auto playlistPlayer = std::make_unique<PlaylistPlayer>(playlistPlayerId, formatManager_, readAheadThread_);
+
+        if (!playlistPlayer->loadTracks(filePaths, options, getSampleRate(), error)) {
+            return -1;
+        }
+
+        mixer_.addInputSource(playlistPlayer.get(), false);
+
+        playlistPlayers_[playlistPlayerId] = std::move(playlistPlayer);
+        return playlistPlayerId;
+    }
+
+    void JuceAudioEngine::removePlaylistPlayer(int playlistPlayerId)
+    {
+        const ProfiledLock::ScopedLockType lock(playerLock_);
+
+        auto it = playlistPlayers_.find(playlistPlayerId);
+        if (it != playlistPlayers_.end()) {
+            mixer_.removeInputSource(it->second.get());
+            playlistPlayers_.erase(it);
+        }
+    }
+
+    PlaylistPlayer* JuceAudioEngine::getPlaylistPlayer(int playlistPlayerId)
+    {
+        const ProfiledLock::ScopedLockType lock(playerLock_);
+
+        auto it = playlistPlayers_.find(playlistPlayerId);
+        return it != playlistPlayers_.end() ? it->second.get() : nullptr;
+    }
+
+    // ============================================================================
+    // Live inputs
+    // ============================================================================
+
+    void JuceAudioEngine::mixLiveInputs(const float* const* inputChannelData, int numInputChannels,
+        juce::AudioBuffer<float>& output, int numSamples)
+    {
+        // Never waits: the control thread swaps tables, not this one
+        const RealtimeSnapshot<LiveInputTable>::ScopedAccess table(liveInputTable_);
+
+        for (const LiveInputRouting& entry : *table) {
+            LiveInput& live = *entry.input;
+
+            const uint32_t serial = live.fadeSerial.load(std::memory_order_acquire);
+            if (serial != live.seenSerial) {
+                live.seenSerial = serial;
+                live.rampTarget = live.targetGain.load(std::memory_order_relaxed);
+                live.rampSamples = live.fadeSamples.load(std::memory_order_relaxed);
+            }
+
+            // Advance the gain ramp; it may finish part way through the block
+            const float startGain = live.gain;
+            const int rampLength = std::min(live.rampSamples, numSamples);
+            float endGain = startGain;
+            if (rampLength > 0) {
+                endGain = startGain + (live.rampTarget - startGain) * rampLength / live.rampSamples;
+                live.rampSamples -= rampLength;
+                if (live.rampSamples == 0) {
+                    endGain = live.rampTarget;
+                }
+            }
+            live.gain = endGain;
+            live.currentGain.store(endGain, std::memory_order_relaxed);
+
+            if (startGain == 0.0f && endGain == 0.0f) {
+                continue;
+            }
+
+            for (const LiveInput::Route& route : entry.routes) {
+                if (route.input >= numInputChannels || route.output >= output.getNumChannels()
+                    || inputChannelData[route.input] == nullptr) {
+                    continue;
+                }
+
+                const float* source = inputChannelData[route.input];
+                if (rampLength > 0) {
+                    output.addFromWithRamp(route.output, 0, source, rampLength,
+                        startGain * route.gain, endGain * route.gain);
+                }
+                if (rampLength < numSamples) {
+                    output.addFrom(route.output, rampLength, source + rampLength,
+                        numSamples - rampLength, endGain * route.gain);
+                }
+            }
+        }
+    }
+
+    int JuceAudioEngine::createLiveInput()
+    {
+        const ProfiledLock::ScopedLockType lock(liveInputLock_);
+
+        const int liveInputId = nextLiveInputId_++;
+        liveInputs_[liveInputId] = std::make_unique<LiveInput>();
+        publishLiveInputs();
+        return liveInputId;
+    }
+
+    void JuceAudioEngine::removeLiveInput(int liveInputId)
+    {
+        const ProfiledLock::ScopedLockType lock(liveInputLock_);
+
+        auto it = liveInputs_.find(liveInputId);
+        if (it == liveInputs_.end()) {
+            return;
+        }
+
+        // Unpublished before it is freed, so the callback cannot be using it
+        std::unique_ptr<LiveInput> removed = std::move(it->second);
+        liveInputs_.erase(it);
+        publishLiveInputs();
+    }
+
+    void JuceAudioEngine::publishLiveInputs()
+    {
+        auto table = std::make_unique<LiveInputTable>();
+        table->reserve(liveInputs_.size());
+        for (auto& entry : liveInputs_) {
+            table->push_back({ entry.second.get(), entry.second->routes });
+        }
+        liveInputTable_.publish(std::move(table));
+    }
+
+    bool JuceAudioEngine::setLiveInputRoute(int liveInputId, int inputChannel, int outputChannel, float gain)
+    {
+        if (inputChannel < 0 || outputChannel < 0) {
+            return false;
+        }
+
+        const ProfiledLock::ScopedLockType lock(liveInputLock_);
+
+        auto it = liveInputs_.find(liveInputId);
+        if (it == liveInputs_.end()) {
+            return false;
+        }
+
+        auto& routes = it->second->routes;
+        auto route = std::find_if(routes.begin(), routes.end(), [&](const LiveInput::Route& r) {
+            return r.input == inputChannel && r.output == outputChannel;
+        });
+
+        if (gain == 0.0f) {
+            if (route != routes.end()) {
+                routes.erase(route);
+            }
+        }
+        else if (route != routes.end()) {
+            route->gain = gain;
+        }
+        else {
+            routes.push_back({ inputChannel, outputChannel, gain });
+        }
+
+        publishLiveInputs();
+        return true;
+    }
+
+    void JuceAudioEngine::clearLiveInputRoutes(int liveInputId)
+    {
+        const ProfiledLock::ScopedLockType lock(liveInputLock_);
+
+        auto it = liveInputs_.find(liveInputId);
+        if (it != liveInputs_.end()) {
+            it->second->routes.clear();
+            publishLiveInputs();
+        }
+    }
+
+    void JuceAudioEngine::setLiveInputGain(int liveInputId, float gain, double fadeSeconds)
+    {
+        const int rampSamples = fadeSeconds > 0.0
+            ? std::max(1, static_cast<int>(fadeSeconds * clockSampleRate_.load(std::memory_order_acquire)))
+            : std::max(1, getBufferSize());
+
+        const ProfiledLock::ScopedLockType lock(liveInputLock_);
+
+        auto it = liveInputs_.find(liveInputId);
+        if (it != liveInputs_.end()) {
+            it->second->targetGain.store(gain, std::memory_order_relaxed);
+            it->second->fadeSamples.store(rampSamples, std::memory_order_relaxed);
+            it->second->fadeSerial.fetch_add(1, std::memory_order_release);
+        }
+    }
+
+    float JuceAudioEngine::getLiveInputGain(int liveInputId) const
+    {
+        const ProfiledLock::ScopedLockType lock(liveInputLock_);
+
+        auto it = liveInputs_.find(liveInputId);
+        return it != liveInputs_.end() ? it->second->currentGain.load(std::memory_order_relaxed) : 0.0f;
+    }
+
+    int JuceAudioEngine::getLiveInputCount() const
+    {
+        const ProfiledLock::ScopedLockType lock(liveInputLock_);
+        return static_cast<int>(liveInputs_.size());
+    }
+
+    int JuceAudioEngine::getNumInputChannels() const
+    {
+        auto* device = deviceManager_.getCurrentAudioDevice();
+        if (device) {
+            return device->getActiveInputChannels().countNumberOfSetBits();
+        }
+        return 0;
+    }
+
+    int JuceAudioEngine::getNumOutputChannels() const
+    {
+        auto* device = deviceManager_.getCurrentAudioDevice();
+        if (device) {
+            return device->getActiveOutputChannels().countNumberOfSetBits();
+        }
+        return 0;
+    }
+
     double JuceAudioEngine::getSampleRate() const
     {
         auto* device = deviceManager_.getCurrentAudioDevice();
@@ -214,6 +853,12 @@ namespace CueForge {
         return 44100.0;
     }
 
+    double JuceAudioEngine::getClockSeconds() const
+    {
+        return static_cast<double>(getSamplesRendered())
+            / clockSampleRate_.load(std::memory_order_acquire);
+    }
+
     int JuceAudioEngine::getBufferSize() const
     {
         auto* device = deviceManager_.getCurrentAudioDevice();
@@ -223,6 +868,292 @@ namespace CueForge {
         return 512;
     }
 
+    int JuceAudioEngine::getOutputLatencySamples() const
+    {
+        auto* device = deviceManager_.getCurrentAudioDevice();
+        if (device) {
+            return device->getOutputLatencyInSamples();
+        }
+        return 0;
+    }
+
+    int JuceAudioEngine::getPlayerCount() const
+    {
+        const ProfiledLock::ScopedLockType lock(playerLock_);
+        return static_cast<int>(players_.size());
+    }
+
+    // ============================================================================
+    // Recorders
+    // ============================================================================
+
+    void JuceAudioEngine::recordBlock(const float* const* inputChannelData, int numInputChannels,
+        const juce::AudioBuffer<float>& mix, int numSamples)
+    {
+        // Never waits: the control thread swaps recorder sets, not this one
+        const RealtimeSnapshot<std::vector<DiskRecorder*>>::ScopedAccess recorders(recorderSet_);
+
+        for (DiskRecorder* recorder : *recorders) {
+            if (recorder->getSettings().source == RecordSettings::Source::Mix) {
+                recorder->push(mix.getArrayOfReadPointers(), mix.getNumChannels(), numSamples);
+            }
+            else {
+                recorder->push(inputChannelData, numInputChannels, numSamples);
+            }
+        }
+    }
+
+    int JuceAudioEngine::createRecorder(const std::string& filePath, const RecordSettings& settings,
+        std::string* error)
+    {
+        if (!initialized_ || deviceManager_.getCurrentAudioDevice() == nullptr) {
+            if (error) {
+                *error = "Audio device not running";
+            }
+            return -1;
+        }
+
+        if (!diskWriterThread_.isThreadRunning()) {
+            diskWriterThread_.startThread(juce::Thread::Priority::high);
+        }
+
+        // Opened outside the lock: creating and reserving the file may
+        // take a while, and the callback must not wait for it
+        int recorderId = -1;
+        {
+            const ProfiledLock::ScopedLockType lock(recorderLock_);
+            recorderId = nextRecorderId_++;
+        }
+        auto recorder = std::make_unique<DiskRecorder>(recorderId, diskWriterThread_);
+        if (!recorder->open(filePath, settings, getSampleRate(), error)) {
+            return -1;
+        }
+
+        const ProfiledLock::ScopedLockType lock(recorderLock_);
+        recorders_[recorderId] = std::move(recorder);
+        publishRecorders();
+        return recorderId;
+    }
+
+    void JuceAudioEngine::publishRecorders()
+    {
+        auto set = std::make_unique<std::vector<DiskRecorder*>>();
+        set->reserve(recorders_.size());
+        for (auto& entry : recorders_) {
+            set->push_back(entry.second.get());
+        }
+        recorderSet_.publish(std::move(set));
+    }
+
+    bool JuceAudioEngine::startRecorder(int recorderId)
+    {
+        const ProfiledLock::ScopedLockType lock(recorderLock_);
+        auto it = recorders_.find(recorderId);
+        if (it == recorders_.end()) {
+            return false;
+        }
+        it->second->start();
+        return it->second->isRecording();
+    }
+
+    bool JuceAudioEngine::pauseRecorder(int recorderId)
+    {
+        const ProfiledLock::ScopedLockType lock(recorderLock_);
+        auto it = recorders_.find(recorderId);
+        if (it == recorders_.end()) {
+            return false;
+        }
+        it->second->stop();
+        return true;
+    }
+
+    bool JuceAudioEngine::stopRecorder(int recorderId)
+    {
+        DiskRecorder* recorder = nullptr;
+        {
+            // Once sync() returns, no block that saw the recorder running
+            // is still pushing into it, so the ring can be drained
+            const ProfiledLock::ScopedLockType lock(recorderLock_);
+            auto it = recorders_.find(recorderId);
+            if (it == recorders_.end()) {
+                return false;
+            }
+            recorder = it->second.get();
+            recorder->stop();
+            recorderSet_.sync();
+        }
+        return recorder->finish();
+    }
+
+    void JuceAudioEngine::removeRecorder(int recorderId)
+    {
+        std::unique_ptr<DiskRecorder> removed;
+        {
+            const ProfiledLock::ScopedLockType lock(recorderLock_);
+            auto it = recorders_.find(recorderId);
+            if (it == recorders_.end()) {
+                return;
+            }
+            removed = std::move(it->second);
+            recorders_.erase(it);
+            publishRecorders();
+        }
+
+        // Unpublished above, so the callback no longer pushes into it;
+        // closed outside the lock so other control calls don't wait on the disk
+        removed->finish();
+    }
+
+    RecordStats JuceAudioEngine::getRecorderStats(int recorderId) const
+    {
+        const ProfiledLock::ScopedLockType lock(recorderLock_);
+        auto it = recorders_.find(recorderId);
+        return it != recorders_.end() ? it->second->getStats() : RecordStats();
+    }
+
+    int JuceAudioEngine::getRecorderCount() const
+    {
+        const ProfiledLock::ScopedLockType lock(recorderLock_);
+        return static_cast<int>(recorders_.size());
+    }
+
+    // ============================================================================
+    // Crossfades
+    // ============================================================================
+
+    bool JuceAudioEngine::crossfadePlayers(int fadeInId, const std::vector<int>& fadeOutIds, double seconds,
+        FadeCurve curve, std::string* error)
+    {
+        auto fail = [error](const std::string& message) {
+            std::cerr << "Crossfade: " << message << std::endl;
+            if (error) {
+                *error = message;
+            }
+            return false;
+        };
+
+        const ProfiledLock::ScopedLockType lock(playerLock_);
+
+        auto it = players_.find(fadeInId);
+        if (it == players_.end()) {
+            return fail("No player " + std::to_string(fadeInId));
+        }
+        AudioPlayer& fadeIn = *it->second;
+        if (previewBus_.contains(fadeIn.getMixerSource())) {
+            return fail("Preview players cannot crossfade");
+        }
+
+        std::vector<AudioPlayer*> fadeOut;
+        for (int id : fadeOutIds) {
+            auto out = players_.find(id);
+            if (id != fadeInId && out != players_.end() && out->second->isPlaying()
+                && !previewBus_.contains(out->second->getMixerSource())) {
+                fadeOut.push_back(out->second.get());
+            }
+        }
+
+        const int64_t length = std::max<int64_t>(1, std::llround(std::max(0.0, seconds) * getSampleRate()));
+
+        // Only crossfadePlayers() queues, under playerLock_, so the room
+        // checked here is still there below
+        {
+            const juce::SpinLock::ScopedLockType fadeLock(fadeLock_);
+            if (pendingFadeCount_ + static_cast<int>(fadeOut.size()) + 1 > MaxPendingFades) {
+                return fail("Too many crossfades pending");
+            }
+        }
+
+        // Held silent and unpulled until its fade starts, so the transport
+        // can start here, off the audio thread, without losing its start
+        fadeIn.getFader().hold();
+        fadeIn.getTransportSource()->start();
+
+        // One batch, so every ramp begins on the first sample of one block
+        const juce::SpinLock::ScopedLockType fadeLock(fadeLock_);
+        for (AudioPlayer* player : fadeOut) {
+            pendingFades_[pendingFadeCount_++] = PendingFade{ &player->getFader(), false, length, curve };
+        }
+        pendingFades_[pendingFadeCount_++] = PendingFade{ &fadeIn.getFader(), true, length, curve };
+        return true;
+    }
+
+    void JuceAudioEngine::startPendingFades()
+    {
+        // Audio thread. A busy lock only means a crossfade is being queued
+        // right now; it starts with the next block instead.
+        const juce::SpinLock::ScopedTryLockType fadeLock(fadeLock_);
+        if (!fadeLock.isLocked()) {
+            return;
+        }
+
+        for (int i = 0; i < pendingFadeCount_; ++i) {
+            const PendingFade& fade = pendingFades_[i];
+            fade.fader->startFade(fade.fadeIn, fade.length, fade.curve);
+        }
+        pendingFadeCount_ = 0;
+    }
+
+    void JuceAudioEngine::cancelPendingFades(const VoiceFader* fader)
+    {
+        const juce::SpinLock::ScopedLockType fadeLock(fadeLock_);
+        pendingFadeCount_ = static_cast<int>(std::remove_if(pendingFades_, pendingFades_ + pendingFadeCount_,
+            [fader](const PendingFade& fade) { return fade.fader == fader; }) - pendingFades_);
+    }
+
+    bool JuceAudioEngine::isPlayerFadedOut(int playerId) const
+    {
+        const ProfiledLock::ScopedLockType lock(playerLock_);
+        auto it = players_.find(playerId);
+        return it != players_.end() && it->second->getFader().isFadedOut();
+    }
+
+    // ============================================================================
+    // Preview bus
+    // ============================================================================
+
+    int JuceAudioEngine::createPreviewPlayer(const std::string& filePath, std::string* error)
+    {
+        auto fail = [error](const std::string& message) {
+            std::cerr << "Preview: " << message << std::endl;
+            if (error) {
+                *error = message;
+            }
+            return -1;
+        };
+
+        const ProfiledLock::ScopedLockType lock(playerLock_);
+
+        const int playerId = nextPlayerId_++;
+        auto player = std::make_unique<AudioPlayer>(this, playerId);
+        if (!player->loadFile(filePath)) {
+            return fail("Cannot load " + filePath);
+        }
+
+        if (!previewBus_.addVoice(player->getMixerSource())) {
+            return fail(std::to_string(PreviewBus::MaxVoices) + " previews already playing");
+        }
+
+        players_[playerId] = std::move(player);
+        return playerId;
+    }
+
+    bool JuceAudioEngine::isPreviewPlayer(int playerId) const
+    {
+        const ProfiledLock::ScopedLockType lock(playerLock_);
+        auto it = players_.find(playerId);
+        return it != players_.end() && previewBus_.contains(it->second->getMixerSource());
+    }
+
+    void JuceAudioEngine::setPreviewOutput(int firstOutput, float gain)
+    {
+        previewBus_.setOutput(firstOutput, gain);
+    }
+
+    void JuceAudioEngine::setPreviewBudget(double fraction)
+    {
+        previewBus_.setBudget(fraction);
+    }
+
     // ============================================================================
     // AudioPlayer Implementation
     // ============================================================================
@@ -230,7 +1161,10 @@ namespace CueForge {
     AudioPlayer::AudioPlayer(JuceAudioEngine* engine, int id)
         : engine_(engine)
         , id_(id)
+        , fader_(&transportSource_)
+        , sendSource_(&fader_)
         , volume_(1.0f)
+        , trim_(1.0f)
         , loaded_(false)
     {
     }
@@ -279,6 +1213,8 @@ namespace CueForge {
 
         stop();
         transportSource_.setSource(nullptr);
+        liveStretch_ = nullptr;
+        stretchSource_.reset();
         readerSource_.reset();
 
         loaded_ = false;
@@ -299,6 +1235,10 @@ namespace CueForge {
     {
         transportSource_.stop();
         transportSource_.setPosition(0.0);
+
+        // Audible again when played next, even if a crossfade was queued
+        engine_->cancelPendingFades(&fader_);
+        fader_.reset();
     }
 
     void AudioPlayer::pause()
@@ -328,7 +1268,13 @@ namespace CueForge {
     void AudioPlayer::setVolume(float volume)
     {
         volume_ = juce::jlimit(0.0f, 1.0f, volume);
-        transportSource_.setGain(volume_);
+        transportSource_.setGain(volume_ * trim_);
+    }
+
+    void AudioPlayer::setTrim(float gain)
+    {
+        trim_ = juce::jmax(0.0f, gain);
+        transportSource_.setGain(volume_ * trim_);
     }
 
     float AudioPlayer::getVolume() const
@@ -351,4 +1297,61 @@ namespace CueForge {
         return transportSource_.getLengthInSeconds();
     }
 
+    bool AudioPlayer::setTimeStretch(double rate, std::shared_ptr<const RenderedStretch> rendered,
+        juce::TimeSliceThread* liveThread)
+    {
+        // The transport stops when its source changes
+        if (!loaded_ || transportSource_.isPlaying()) {
+            return false;
+        }
+
+        juce::AudioFormatReader* reader = readerSource_->getAudioFormatReader();
+        std::unique_ptr<juce::PositionableAudioSource> source;
+        LiveStretchSource* live = nullptr;
+        if (rendered) {
+            source = std::make_unique<RenderedStretchSource>(std::move(rendered));
+        }
+        else if (liveThread) {
+            auto liveSource = std::make_unique<LiveStretchSource>(*reader, *liveThread, rate);
+            live = liveSource.get();
+            source = std::move(liveSource);
+        }
+
+        const double position = transportSource_.getCurrentPosition();
+        transportSource_.setSource(source ? source.get() : readerSource_.get(), 0, nullptr, reader->sampleRate);
+        transportSource_.setPosition(position);
+
+        // The old stretch source goes only once the transport has let go
+        stretchSource_ = std::move(source);
+        liveStretch_ = live;
+        return true;
+    }
+
+    bool AudioPlayer::setStretchRate(double rate)
+    {
+        if (!liveStretch_) {
+            return false;
+        }
+        liveStretch_->setRate(rate);
+        return true;
+    }
+
+    StretchStats AudioPlayer::getStretchStats() const
+    {
+        StretchStats stats;
+        if (liveStretch_) {
+            stats.active = true;
+            stats.rate = liveStretch_->getRate();
+            stats.load = liveStretch_->getLoad();
+            stats.underruns = liveStretch_->getUnderruns();
+        }
+        else if (auto* rendered = dynamic_cast<const RenderedStretchSource*>(stretchSource_.get())) {
+            stats.active = true;
+            stats.rendered = true;
+            stats.rate = rendered->getRendered().rate;
+            stats.renderSeconds = rendered->getRendered().renderSeconds;
+        }
+        return stats;
+    }
+
 } // namespace CueForge
\ No newline at end of file
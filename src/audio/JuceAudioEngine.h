@@ -9,6 +9,19 @@
 #include <juce_audio_devices/juce_audio_devices.h>
 #include <juce_audio_formats/juce_audio_formats.h>
 #include <juce_audio_utils/juce_audio_utils.h>
+#include "ConvolutionReverb.h"
+#include "DiskRecorder.h"
+#include "LoudnessAnalyzer.h"
+#include "NullAudioDevice.h"
+#include "OutputProcessor.h"
+#include "ProfiledLock.h"
+#include "PlaylistPlayer.h"
+#include "PreviewBus.h"
+#include "RealtimeSnapshot.h"
+#include "StemPlayer.h"
+#include "TimeStretch.h"
+#include "VoiceFader.h"
+#include <atomic>
 #include <memory>
 #include <vector>
 #include <string>
@@ -34,6 +47,10 @@ namespace CueForge {
         void shutdown();
         bool isInitialized() const { return initialized_; }
 
+        // Run on the soundcard-free null device instead of real hardware
+        bool initializeNull(const NullAudioSettings& settings);
+        NullAudioIODevice* getNullDevice() const;
+
         std::vector<std::string> getAvailableDevices() const;
         std::string getCurrentDevice() const;
         bool setDevice(const std::string& deviceName);
@@ -54,23 +71,243 @@ namespace CueForge {
         void removePlayer(int playerId);
         AudioPlayer* getPlayer(int playerId);
 
+        // Multitrack stems played sample-locked as one voice. Stem and
+        // playlist players share one read-ahead thread, started with the
+        // first of them.
+        int createStemPlayer(const std::vector<std::string>& filePaths, std::string* error = nullptr);
+        void removeStemPlayer(int stemPlayerId);
+        StemPlayer* getStemPlayer(int stemPlayerId);
+        int getStemPlayerCount() const;
+
+        // Gapless track lists, decoded ahead at the current device rate
+        int createPlaylistPlayer(const std::vector<std::string>& filePaths,
+            const PlaylistPlayer::Options& options, std::string* error = nullptr);
+        void removePlaylistPlayer(int playlistPlayerId);
+        PlaylistPlayer* getPlaylistPlayer(int playlistPlayerId);
+
+        // Live input passthrough. Routed device inputs are mixed into the
+        // outputs straight from the callback's input pointers, so a live
+        // input adds no buffering beyond the device block. Gain changes ramp
+        // over fadeSeconds (one block when 0) like a player's volume.
+        static constexpr int DefaultInputChannels = 2;
+        int createLiveInput();
+        void removeLiveInput(int liveInputId);
+        bool setLiveInputRoute(int liveInputId, int inputChannel, int outputChannel, float gain);
+        void clearLiveInputRoutes(int liveInputId);
+        void setLiveInputGain(int liveInputId, float gain, double fadeSeconds = 0.0);
+        float getLiveInputGain(int liveInputId) const;
+        int getLiveInputCount() const;
+        int getNumInputChannels() const;
+        int getNumOutputChannels() const;
+
+        // Per-output delay, EQ and trim after the mix; changes apply while
+        // audio runs (see OutputProcessor)
+        bool setOutputSettings(int outputChannel, const OutputSettings& settings);
+        OutputSettings getOutputSettings(int outputChannel) const;
+
+        // Convolution reverb returns fed by player sends (see ReverbBus).
+        // The buses are fixed and cost nothing until an IR is loaded; the
+        // worker threads start with the first one.
+        static constexpr int MaxReverbBuses = 4;
+        bool loadReverbImpulse(int bus, const std::string& filePath, std::string* error = nullptr);
+        void clearReverbImpulse(int bus);
+        void setReverbReturn(int bus, float gain, int firstOutput = 0);
+        bool setPlayerReverbSend(int playerId, int bus, float level);   // bus -1 removes the send
+        ReverbBus* getReverbBus(int bus);
+        ReverbBus::Stats getReverbBusStats(int bus) const;
+
+        // Pitch-preserving time stretch for players (see TimeStretch.h). A
+        // static rate should be rendered ahead with prepareTimeStretch; the
+        // player then plays the render if it is finished and stretches live
+        // on the read-ahead thread otherwise. automated always stretches
+        // live so setPlayerStretchRate can change the rate while playing.
+        // At most MaxLiveStretchVoices stretch live at once. Set before play.
+        static constexpr int MaxLiveStretchVoices = 8;
+        void prepareTimeStretch(const std::string& filePath, double rate);
+        bool isTimeStretchReady(const std::string& filePath, double rate) const;
+        bool setPlayerTimeStretch(int playerId, double rate, bool automated, std::string* error = nullptr);
+        bool setPlayerStretchRate(int playerId, double rate);
+        StretchStats getPlayerStretchStats(int playerId) const;
+
+        // Background loudness measurement of audio files (see
+        // LoudnessAnalyzer), and a per-player gain trim on top of the
+        // volume for normalisation. The trim may boost; volume may not.
+        LoudnessAnalyzer& getLoudnessAnalyzer() { return loudness_; }
+        bool setPlayerTrim(int playerId, float gain);
+
+        // Recording of device inputs or the programme mix to WAV or FLAC
+        // (see DiskRecorder). The file is created and its space reserved by
+        // createRecorder(), blocks are taken from startRecorder() on, and
+        // stopRecorder() returns once the file is complete and playable.
+        // Recorders share one disk writer thread, started with the first.
+        int createRecorder(const std::string& filePath, const RecordSettings& settings,
+            std::string* error = nullptr);
+        bool startRecorder(int recorderId);
+        bool pauseRecorder(int recorderId);     // Keeps the file open; start again to resume
+        bool stopRecorder(int recorderId);
+        void removeRecorder(int recorderId);
+        RecordStats getRecorderStats(int recorderId) const;
+        int getRecorderCount() const;
+
+        // Audition players on the preview bus (see PreviewBus): rendered
+        // after the show into their own outputs and shed first when the
+        // callback runs short. They are ordinary players otherwise, removed
+        // with removePlayer(), but cannot send to the reverb buses.
+        int createPreviewPlayer(const std::string& filePath, std::string* error = nullptr);
+        bool isPreviewPlayer(int playerId) const;
+        void setPreviewOutput(int firstOutput, float gain);    // -1 mutes previews
+        float getPreviewGain() const { return previewBus_.getGain(); }
+        void setPreviewBudget(double fraction);
+        double getPreviewBudget() const { return previewBus_.getBudget(); }
+        PreviewBus::Stats getPreviewStats() const { return previewBus_.getStats(); }
+
+        // Crossfade as one command: fadeInId starts from silence while every
+        // running player in fadeOutIds fades to silence, on mirrored ramps
+        // of the same curve that all begin on the same sample. Players that
+        // are not running are left alone. A faded-out player stays silent
+        // until it is stopped; isPlayerFadedOut() says when to stop it.
+        bool crossfadePlayers(int fadeInId, const std::vector<int>& fadeOutIds, double seconds,
+            FadeCurve curve = FadeCurve::EqualPower, std::string* error = nullptr);
+        bool isPlayerFadedOut(int playerId) const;
+
         // Mixer access
         double getSampleRate() const;
         int getBufferSize() const;
 
+        // Audio clock - total samples rendered since the device started.
+        // Written only by the audio callback; safe to read from any thread.
+        int64_t getSamplesRendered() const { return samplesRendered_.load(std::memory_order_acquire); }
+        double getClockSeconds() const;
+
+        // Latency probe - while enabled, the callback stamps the start of the
+        // first audible block after silence (steady_clock nanoseconds)
+        void setOnsetProbeEnabled(bool enabled) { onsetProbeEnabled_.store(enabled, std::memory_order_release); }
+        int64_t getLastOnsetNanos() const { return lastOnsetNanos_.load(std::memory_order_acquire); }
+        int getOutputLatencySamples() const;
+
+        // Health - fraction of each block period spent in the callback
+        // (JUCE's smoothed measurement), device xruns and live players
+        double getCpuUsage() const { return deviceManager_.getCpuUsage(); }
+        int getXRunCount() const { return deviceManager_.getXRunCount(); }
+        int getPlayerCount() const;
+
     private:
         friend class AudioPlayer;
 
+        struct LiveInput
+        {
+            struct Route
+            {
+                int input;
+                int output;
+                float gain;
+            };
+
+            std::vector<Route> routes;      // Control copy, under liveInputLock_
+
+            // Gain fades: the control thread sets target and length, then
+            // bumps fadeSerial; the audio thread starts the ramp when it
+            // sees a new serial
+            std::atomic<float> targetGain{ 0.0f };
+            std::atomic<int> fadeSamples{ 0 };
+            std::atomic<uint32_t> fadeSerial{ 0 };
+            std::atomic<float> currentGain{ 0.0f };
+
+            // Audio thread only
+            uint32_t seenSerial = 0;
+            float gain = 0.0f;          // Applied at the start of the next block
+            float rampTarget = 0.0f;
+            int rampSamples = 0;        // Left in the current gain ramp
+        };
+
+        // What the callback mixes: every live input with its routes, built
+        // on the control thread and swapped in whole
+        struct LiveInputRouting
+        {
+            LiveInput* input;
+            std::vector<LiveInput::Route> routes;
+        };
+
+        using LiveInputTable = std::vector<LiveInputRouting>;
+
+        // One fade of a queued crossfade
+        struct PendingFade
+        {
+            VoiceFader* fader = nullptr;
+            bool fadeIn = false;
+            int64_t length = 0;
+            FadeCurve curve = FadeCurve::EqualPower;
+        };
+
+        static constexpr int MaxPendingFades = 64;
+
+        void startReadAheadThread();
+        void startPendingFades();
+        void publishLiveInputs();
+        void publishRecorders();
+        void cancelPendingFades(const VoiceFader* fader);
+        void mixLiveInputs(const float* const* inputChannelData, int numInputChannels,
+            juce::AudioBuffer<float>& output, int numSamples);
+        void recordBlock(const float* const* inputChannelData, int numInputChannels,
+            const juce::AudioBuffer<float>& mix, int numSamples);
+
         juce::AudioDeviceManager deviceManager_;
         juce::AudioFormatManager formatManager_;
         juce::MixerAudioSource mixer_;
+        OutputProcessor outputProcessor_;
+        PreviewBus previewBus_;     // Holds sources of players_, cleared first
+
+        // Declared first so the workers outlive the buses they process
+        ReverbWorkerPool reverbWorkers_;
+        std::vector<std::unique_ptr<ReverbBus>> reverbBuses_;   // MaxReverbBuses, fixed
+
+        TimeStretchCache stretchCache_{ formatManager_ };
+        LoudnessAnalyzer loudness_{ formatManager_ };
+
+        // Declared before the player maps so it outlives the players and
+        // live time stretches registered with it
+        juce::TimeSliceThread readAheadThread_{ "Audio read-ahead" };
 
         std::map<int, std::unique_ptr<AudioPlayer>> players_;
         int nextPlayerId_;
 
+        // Crossfades waiting for the audio thread, which starts every fade
+        // queued so far together at the top of its next block
+        juce::SpinLock fadeLock_;
+        PendingFade pendingFades_[MaxPendingFades];    // Guarded by fadeLock_
+        int pendingFadeCount_ = 0;                     // Guarded by fadeLock_
+
+        std::map<int, std::unique_ptr<StemPlayer>> stemPlayers_;   // Guarded by playerLock_
+        int nextStemPlayerId_;
+        std::map<int, std::unique_ptr<PlaylistPlayer>> playlistPlayers_;   // Guarded by playerLock_
+        int nextPlaylistPlayerId_;
+
+        std::map<int, std::unique_ptr<LiveInput>> liveInputs_;   // Guarded by liveInputLock_
+        RealtimeSnapshot<LiveInputTable> liveInputTable_;       // Published under liveInputLock_
+        int nextLiveInputId_;
+
+        // Declared first so it outlives the recorders registered with it
+        juce::TimeSliceThread diskWriterThread_{ "Disk writer" };
+        std::map<int, std::unique_ptr<DiskRecorder>> recorders_;   // Guarded by recorderLock_
+        RealtimeSnapshot<std::vector<DiskRecorder*>> recorderSet_; // Published under recorderLock_
+        int nextRecorderId_;
+
         bool initialized_;
 
-        juce::CriticalSection playerLock_;
+        std::atomic<int64_t> samplesRendered_;
+        std::atomic<double> clockSampleRate_;
+
+        std::atomic<bool> onsetProbeEnabled_;
+        std::atomic<int64_t> lastOnsetNanos_;
+        bool probeWasAudible_;   // Audio thread only
+
+        // Profiled engine locks (see LockProfiler). mixer_ is not wrapped:
+        // add/remove prepare and release sources, which allocates, so the
+        // callback's pull is timed under mixerPullSite_ instead.
+        ProfiledLock playerLock_{ "JuceAudioEngine::playerLock" };
+        const int mixerPullSite_{ LockProfiler::registerSite("JuceAudioEngine::mixerPull") };
+        ProfiledLock liveInputLock_{ "JuceAudioEngine::liveInputLock" };
+        ProfiledLock recorderLock_{ "JuceAudioEngine::recorderLock" };
 
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(JuceAudioEngine)
     };
@@ -97,6 +334,7 @@ namespace CueForge {
 
         void setVolume(float volume); // 0.0 to 1.0
         float getVolume() const;
+        void setTrim(float gain);     // Linear, applied with the volume
 
         void setPosition(double seconds);
         double getPosition() const;
@@ -105,8 +343,22 @@ namespace CueForge {
         std::string getFilePath() const { return filePath_; }
         int getId() const { return id_; }
 
+        // Reverb send, post volume; level is linear
+        void setReverbSend(ReverbBus* bus, float level) { sendSource_.setSend(bus, level); }
+
+        // Swaps the file source for a stretched one while stopped: the
+        // render when given, otherwise a live stretch on liveThread. Rate
+        // 1.0 with neither restores plain playback. Positions stay in file
+        // time either way.
+        bool setTimeStretch(double rate, std::shared_ptr<const RenderedStretch> rendered,
+            juce::TimeSliceThread* liveThread);
+        bool setStretchRate(double rate);   // Live stretch only
+        StretchStats getStretchStats() const;
+
         // Internal - get audio source for mixing
         juce::AudioTransportSource* getTransportSource() { return &transportSource_; }
+        juce::AudioSource* getMixerSource() { return &sendSource_; }
+        VoiceFader& getFader() { return fader_; }
 
     private:
         JuceAudioEngine* engine_;
@@ -114,9 +366,14 @@ namespace CueForge {
         std::string filePath_;
 
         std::unique_ptr<juce::AudioFormatReaderSource> readerSource_;
+        std::unique_ptr<juce::PositionableAudioSource> stretchSource_;  // Reads readerSource_'s reader
+        LiveStretchSource* liveStretch_ = nullptr;                       // stretchSource_ when live
         juce::AudioTransportSource transportSource_;
+        VoiceFader fader_;              // Wraps transportSource_
+        ReverbSendSource sendSource_;   // Wraps fader_ in the mixer
 
         float volume_;
+        float trim_;
         bool loaded_;
 
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AudioPlayer)
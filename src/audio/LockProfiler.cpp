@@ -0,0 +1,276 @@
+// ============================================================================
+// LockProfiler.cpp - Wait/hold time histograms per lock site and thread
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#include "LockProfiler.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+
+namespace CueForge {
+
+    namespace {
+        struct AtomicHistogram
+        {
+            std::atomic<uint64_t> count{ 0 };
+            std::atomic<uint64_t> totalNs{ 0 };
+            std::atomic<uint64_t> maxNs{ 0 };
+            std::atomic<uint64_t> buckets[LockProfiler::Buckets] = {};
+        };
+
+        struct Slot
+        {
+            std::atomic<uint64_t> contended{ 0 };
+            AtomicHistogram wait;
+            AtomicHistogram hold;
+            std::atomic<uint64_t> blockedBy[LockProfiler::MaxThreads] = {};
+        };
+
+        Slot slots[LockProfiler::MaxSites][LockProfiler::MaxThreads];
+
+        std::atomic<const char*> siteNames[LockProfiler::MaxSites] = {};
+        std::atomic<int> siteCount{ 0 };
+        std::mutex registerMutex;
+
+        std::atomic<const char*> threadNames[LockProfiler::MaxThreads] = {};
+        std::atomic<int> threadCount{ 0 };
+        thread_local int threadIndex = -1;
+
+        std::atomic<bool> enabled{ false };
+
+        int bucketFor(int64_t ns)
+        {
+            const uint64_t us = ns > 0 ? static_cast<uint64_t>(ns) / 1000 : 0;
+            int bucket = 0;
+            for (uint64_t bound = 1; us >= bound && bucket < LockProfiler::Buckets - 1; bound <<= 1) {
+                ++bucket;
+            }
+            return bucket;
+        }
+
+        void add(AtomicHistogram& histogram, int64_t ns)
+        {
+            const uint64_t value = ns > 0 ? static_cast<uint64_t>(ns) : 0;
+            histogram.count.fetch_add(1, std::memory_order_relaxed);
+            histogram.totalNs.fetch_add(value, std::memory_order_relaxed);
+            histogram.buckets[bucketFor(ns)].fetch_add(1, std::memory_order_relaxed);
+
+            uint64_t previous = histogram.maxNs.load(std::memory_order_relaxed);
+            while (value > previous
+                && !histogram.maxNs.compare_exchange_weak(previous, value, std::memory_order_relaxed)) {
+            }
+        }
+
+        LockProfiler::Histogram read(const AtomicHistogram& source)
+        {
+            LockProfiler::Histogram histogram;
+            histogram.count = source.count.load(std::memory_order_relaxed);
+            histogram.totalNs = source.totalNs.load(std::memory_order_relaxed);
+            histogram.maxNs = source.maxNs.load(std::memory_order_relaxed);
+            for (int b = 0; b < LockProfiler::Buckets; ++b) {
+                histogram.buckets[b] = source.buckets[b].load(std::memory_order_relaxed);
+            }
+            return histogram;
+        }
+
+        void clear(AtomicHistogram& histogram)
+        {
+            histogram.count.store(0, std::memory_order_relaxed);
+            histogram.totalNs.store(0, std::memory_order_relaxed);
+            histogram.maxNs.store(0, std::memory_order_relaxed);
+            for (auto& bucket : histogram.buckets) {
+                bucket.store(0, std::memory_order_relaxed);
+            }
+        }
+
+        std::string threadLabel(int thread)
+        {
+            if (const char* name = threadNames[thread].load(std::memory_order_acquire)) {
+                return thread == LockProfiler::MaxThreads - 1 ? std::string(name) + " (+ later threads)" : name;
+            }
+            return "thread " + std::to_string(thread);
+        }
+    }
+
+    double LockProfiler::Histogram::percentileUs(double quantile) const
+    {
+        if (count == 0) {
+            return 0.0;
+        }
+        const uint64_t target = static_cast<uint64_t>(quantile * count);
+        uint64_t seen = 0;
+        for (int b = 0; b < Buckets; ++b) {
+            seen += buckets[b];
+            if (seen > target) {
+                return b == Buckets - 1 ? maxUs() : std::min(static_cast<double>(1ull << b), maxUs());
+            }
+        }
+        return maxUs();
+    }
+
+    void LockProfiler::setEnabled(bool on)
+    {
+        enabled.store(on, std::memory_order_relaxed);
+    }
+
+    bool LockProfiler::isEnabled()
+    {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+    int LockProfiler::registerSite(const char* name)
+    {
+        std::lock_guard<std::mutex> lock(registerMutex);
+
+        const int count = siteCount.load(std::memory_order_relaxed);
+        for (int i = 0; i < count; ++i) {
+            if (std::strcmp(siteNames[i].load(std::memory_order_relaxed), name) == 0) {
+                return i;
+            }
+        }
+        if (count == MaxSites) {
+            std::fprintf(stderr, "LockProfiler::registerSite() - site table full, '%s' shares the last site\n", name);
+            return MaxSites - 1;
+        }
+
+        siteNames[count].store(name, std::memory_order_release);
+        siteCount.store(count + 1, std::memory_order_release);
+        return count;
+    }
+
+    int LockProfiler::currentThread()
+    {
+        if (threadIndex < 0) {
+            threadIndex = std::min(threadCount.fetch_add(1, std::memory_order_relaxed), MaxThreads - 1);
+        }
+        return threadIndex;
+    }
+
+    void LockProfiler::setThreadName(const char* name)
+    {
+        const int thread = currentThread();
+        if (threadNames[thread].load(std::memory_order_relaxed) != name) {
+            threadNames[thread].store(name, std::memory_order_release);
+        }
+    }
+
+    void LockProfiler::recordAcquire(int site, int thread, int64_t waitNs, bool contended, int holderThread)
+    {
+        Slot& slot = slots[site][thread];
+        add(slot.wait, waitNs);
+        if (contended) {
+            slot.contended.fetch_add(1, std::memory_order_relaxed);
+            if (holderThread >= 0) {
+                slot.blockedBy[holderThread].fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void LockProfiler::recordRelease(int site, int thread, int64_t holdNs)
+    {
+        add(slots[site][thread].hold, holdNs);
+    }
+
+    void LockProfiler::recordSection(int site, int thread, int64_t durationNs)
+    {
+        recordAcquire(site, thread, 0, false, -1);
+        recordRelease(site, thread, durationNs);
+    }
+
+    std::vector<LockProfiler::SiteStats> LockProfiler::snapshot()
+    {
+        std::vector<SiteStats> sites;
+        const int siteTotal = siteCount.load(std::memory_order_acquire);
+        const int threadTotal = std::min(threadCount.load(std::memory_order_relaxed), MaxThreads);
+
+        for (int s = 0; s < siteTotal; ++s) {
+            SiteStats site;
+            site.site = siteNames[s].load(std::memory_order_acquire);
+
+            for (int t = 0; t < threadTotal; ++t) {
+                const Slot& slot = slots[s][t];
+                ThreadStats stats;
+                stats.wait = read(slot.wait);
+                stats.hold = read(slot.hold);
+                stats.acquisitions = stats.wait.count;
+                if (stats.acquisitions == 0) {
+                    continue;
+                }
+
+                stats.thread = threadLabel(t);
+                stats.contended = slot.contended.load(std::memory_order_relaxed);
+                for (int h = 0; h < threadTotal; ++h) {
+                    const uint64_t times = slot.blockedBy[h].load(std::memory_order_relaxed);
+                    if (times > 0) {
+                        stats.blockedBy.emplace_back(threadLabel(h), times);
+                    }
+                }
+
+                site.acquisitions += stats.acquisitions;
+                site.contended += stats.contended;
+                site.waitTotalNs += stats.wait.totalNs;
+                site.threads.push_back(std::move(stats));
+            }
+
+            if (site.acquisitions > 0) {
+                sites.push_back(std::move(site));
+            }
+        }
+
+        std::sort(sites.begin(), sites.end(), [](const SiteStats& a, const SiteStats& b) {
+            return a.waitTotalNs > b.waitTotalNs;
+        });
+        return sites;
+    }
+
+    std::string LockProfiler::describe()
+    {
+        std::string text;
+        char line[256];
+
+        for (const SiteStats& site : snapshot()) {
+            std::snprintf(line, sizeof(line), "%s: %llu acquisitions, %llu contended, %.1f ms total wait\n",
+                site.site.c_str(),
+                static_cast<unsigned long long>(site.acquisitions),
+                static_cast<unsigned long long>(site.contended),
+                site.waitTotalNs / 1.0e6);
+            text += line;
+
+            for (const ThreadStats& thread : site.threads) {
+                std::snprintf(line, sizeof(line),
+                    "  %-24s n=%-8llu wait mean %.1f p99 %.0f max %.1f us | hold mean %.1f p99 %.0f max %.1f us\n",
+                    thread.thread.c_str(),
+                    static_cast<unsigned long long>(thread.acquisitions),
+                    thread.wait.meanUs(), thread.wait.percentileUs(0.99), thread.wait.maxUs(),
+                    thread.hold.meanUs(), thread.hold.percentileUs(0.99), thread.hold.maxUs());
+                text += line;
+
+                for (const auto& holder : thread.blockedBy) {
+                    std::snprintf(line, sizeof(line), "    blocked by %s x%llu\n",
+                        holder.first.c_str(), static_cast<unsigned long long>(holder.second));
+                    text += line;
+                }
+            }
+        }
+
+        return text.empty() ? "No lock activity recorded\n" : text;
+    }
+
+    void LockProfiler::reset()
+    {
+        for (auto& site : slots) {
+            for (Slot& slot : site) {
+                slot.contended.store(0, std::memory_order_relaxed);
+                clear(slot.wait);
+                clear(slot.hold);
+                for (auto& holder : slot.blockedBy) {
+                    holder.store(0, std::memory_order_relaxed);
+                }
+            }
+        }
+    }
+
+} // namespace CueForge
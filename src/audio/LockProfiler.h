@@ -0,0 +1,92 @@
+// ============================================================================
+// LockProfiler.h - Wait/hold time histograms per lock site and thread
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace CueForge {
+
+    /**
+     * Process-wide lock contention statistics, fed by ProfiledLock.
+     *
+     * Every lock site (one name per lock member, shared by all instances)
+     * keeps a histogram per thread of how long acquisitions waited and how
+     * long the lock was then held, plus which thread held it whenever an
+     * acquisition had to wait. Storage is fixed and each slot has a single
+     * writer, so recording never allocates or locks and is safe from the
+     * audio callback.
+     *
+     * Off by default; while disabled a ProfiledLock costs one relaxed load.
+     */
+    class LockProfiler
+    {
+    public:
+        static constexpr int MaxSites = 32;
+        static constexpr int MaxThreads = 16;   // Later threads share the last slot
+        static constexpr int Buckets = 20;      // <1us, then powers of two up to ~262ms
+
+        struct Histogram
+        {
+            uint64_t count = 0;
+            uint64_t totalNs = 0;
+            uint64_t maxNs = 0;
+            uint64_t buckets[Buckets] = {};
+
+            double meanUs() const { return count ? totalNs / 1000.0 / count : 0.0; }
+            double maxUs() const { return maxNs / 1000.0; }
+            // Upper bound of the bucket holding the given quantile
+            double percentileUs(double quantile) const;
+        };
+
+        struct ThreadStats
+        {
+            std::string thread;
+            uint64_t acquisitions = 0;
+            uint64_t contended = 0;         // Had to wait for another thread
+            Histogram wait;
+            Histogram hold;
+            // Holder thread name -> times it made this thread wait
+            std::vector<std::pair<std::string, uint64_t>> blockedBy;
+        };
+
+        struct SiteStats
+        {
+            std::string site;
+            uint64_t acquisitions = 0;
+            uint64_t contended = 0;
+            uint64_t waitTotalNs = 0;
+            std::vector<ThreadStats> threads;
+        };
+
+        static void setEnabled(bool enabled);
+        static bool isEnabled();
+
+        // Lock sites are registered once per name and never removed
+        static int registerSite(const char* name);
+
+        // Names the calling thread in reports ("audio", "message", ...).
+        // The string must outlive the profiler, e.g. a literal.
+        static void setThreadName(const char* name);
+        static int currentThread();
+
+        // holderThread is -1 when unknown (taken while profiling was off)
+        static void recordAcquire(int site, int thread, int64_t waitNs, bool contended, int holderThread);
+        static void recordRelease(int site, int thread, int64_t holdNs);
+
+        // A timed section that takes no lock of ours, e.g. a pull through
+        // a JUCE class with a private lock: one uncontended acquisition
+        // held for durationNs
+        static void recordSection(int site, int thread, int64_t durationNs);
+
+        // Sites sorted by total wait time, threads with no activity omitted
+        static std::vector<SiteStats> snapshot();
+        static std::string describe();
+        static void reset();
+    };
+
+} // namespace CueForge
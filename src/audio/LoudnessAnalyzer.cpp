@@ -0,0 +1,509 @@
+// ============================================================================
+// LoudnessAnalyzer.cpp - Background file loudness measurement and cache
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#include "LoudnessAnalyzer.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace CueForge {
+
+    namespace {
+
+        constexpr int TapsPerPhase = 12;
+        constexpr int BlockSegments = 4;        // 400 ms momentary blocks
+        constexpr int ShortTermSegments = 30;   // 3 s short-term windows
+        constexpr int ReadChunk = 32768;
+
+        double energyToLufs(double energy)
+        {
+            return energy > 0.0 ? -0.691 + 10.0 * std::log10(energy) : -1000.0;
+        }
+
+        double lufsToEnergy(double lufs)
+        {
+            return std::pow(10.0, (lufs + 0.691) / 10.0);
+        }
+
+        // Mean of the energies above threshold, or 0 if there are none
+        double gatedMean(const std::vector<double>& energies, double threshold)
+        {
+            double sum = 0.0;
+            int count = 0;
+            for (double energy : energies) {
+                if (energy > threshold) {
+                    sum += energy;
+                    ++count;
+                }
+            }
+            return count > 0 ? sum / count : 0.0;
+        }
+
+        // BS.1770 pre-filter (high shelf) and RLB high-pass, for any rate
+        void kWeightingCoefficients(double sampleRate, BiquadBank::Coefficients* sections)
+        {
+            {
+                const double f0 = 1681.974450955533;
+                const double gainDb = 3.999843853973347;
+                const double q = 0.7071752369554196;
+                const double k = std::tan(juce::MathConstants<double>::pi * f0 / sampleRate);
+                const double vh = std::pow(10.0, gainDb / 20.0);
+                const double vb = std::pow(vh, 0.4996667741545416);
+                const double a0 = 1.0 + k / q + k * k;
+
+                sections[0].b0 = static_cast<float>((vh + vb * k / q + k * k) / a0);
+                sections[0].b1 = static_cast<float>(2.0 * (k * k - vh) / a0);
+                sections[0].b2 = static_cast<float>((vh - vb * k / q + k * k) / a0);
+                sections[0].a1 = static_cast<float>(2.0 * (k * k - 1.0) / a0);
+                sections[0].a2 = static_cast<float>((1.0 - k / q + k * k) / a0);
+            }
+            {
+                const double f0 = 38.13547087602444;
+                const double q = 0.5003270373238773;
+                const double k = std::tan(juce::MathConstants<double>::pi * f0 / sampleRate);
+                const double a0 = 1.0 + k / q + k * k;
+
+                sections[1].b0 = 1.0f;
+                sections[1].b1 = -2.0f;
+                sections[1].b2 = 1.0f;
+                sections[1].a1 = static_cast<float>(2.0 * (k * k - 1.0) / a0);
+                sections[1].a2 = static_cast<float>((1.0 - k / q + k * k) / a0);
+            }
+        }
+
+    } // namespace
+
+    double LoudnessInfo::normalizationGainDb(double targetLufs, double ceilingDbtp, double maxGainDb) const
+    {
+        if (!valid || integratedLufs <= SilenceLufs) {
+            return 0.0;
+        }
+
+        double gain = targetLufs - integratedLufs;
+        if (gain > 0.0) {
+            gain = std::min(gain, std::max(0.0, ceilingDbtp - truePeakDbtp));
+        }
+        return juce::jlimit(-maxGainDb, maxGainDb, gain);
+    }
+
+    // ============================================================================
+    // LoudnessMeter
+    // ============================================================================
+
+    void LoudnessMeter::prepare(int numChannels, double sampleRate)
+    {
+        channels_ = juce::jlimit(1, MaxChannels, numChannels);
+        sampleRate_ = sampleRate;
+
+        weights_.assign(static_cast<size_t>(channels_), 1.0f);
+        if (channels_ == 1) {
+            weights_[0] = 2.0f;     // Dual mono
+        }
+        else if (channels_ >= 5) {
+            for (int channel = 3; channel < channels_; ++channel) {
+                weights_[static_cast<size_t>(channel)] = 1.41f;
+            }
+            if (channels_ >= 6) {
+                weights_[3] = 0.0f;     // LFE
+            }
+        }
+
+        BiquadBank::Coefficients sections[2];
+        kWeightingCoefficients(sampleRate, sections);
+        kWeighting_.prepare(channels_, ChunkSize);
+        for (int channel = 0; channel < channels_; ++channel) {
+            kWeighting_.setCoefficients(channel, sections, 2);
+        }
+        filtered_.setSize(channels_, ChunkSize);
+
+        segmentLength_ = std::max(1, static_cast<int>(std::lround(sampleRate * 0.1)));
+        segmentFill_ = 0;
+        segmentSum_ = 0.0;
+        segments_.clear();
+
+        // Windowed-sinc interpolator, each phase normalised to unity at DC
+        oversampling_ = sampleRate < 96000.0 ? 4 : (sampleRate < 192000.0 ? 2 : 1);
+        tapsPerPhase_ = oversampling_ > 1 ? TapsPerPhase : 1;
+        const int length = oversampling_ * tapsPerPhase_;
+        const double centre = (length - 1) / 2.0;
+        interpolator_.assign(static_cast<size_t>(length), 0.0f);
+        for (int phase = 0; phase < oversampling_; ++phase) {
+            double sum = 0.0;
+            for (int tap = 0; tap < tapsPerPhase_; ++tap) {
+                const int k = phase + tap * oversampling_;
+                const double x = (k - centre) / oversampling_;
+                const double sinc = x == 0.0 ? 1.0 : std::sin(juce::MathConstants<double>::pi * x) / (juce::MathConstants<double>::pi * x);
+                const double w = 2.0 * juce::MathConstants<double>::pi * (k + 0.5) / length;
+                const double window = 0.35875 - 0.48829 * std::cos(w) + 0.14128 * std::cos(2.0 * w) - 0.01168 * std::cos(3.0 * w);
+                interpolator_[static_cast<size_t>(phase * tapsPerPhase_ + tap)] = static_cast<float>(sinc * window);
+                sum += sinc * window;
+            }
+            for (int tap = 0; tap < tapsPerPhase_; ++tap) {
+                interpolator_[static_cast<size_t>(phase * tapsPerPhase_ + tap)] /= static_cast<float>(sum);
+            }
+        }
+        history_.assign(static_cast<size_t>(channels_ * (tapsPerPhase_ - 1 + ChunkSize)), 0.0f);
+        phaseOutput_.assign(static_cast<size_t>(ChunkSize), 0.0f);
+        truePeak_ = 0.0f;
+
+        samples_ = 0;
+    }
+
+    void LoudnessMeter::process(const float* const* channels, int numSamples)
+    {
+        const float* chunk[MaxChannels];
+        for (int offset = 0; offset < numSamples; offset += ChunkSize) {
+            for (int channel = 0; channel < channels_; ++channel) {
+                chunk[channel] = channels[channel] + offset;
+            }
+            processChunk(chunk, std::min(ChunkSize, numSamples - offset));
+        }
+    }
+
+    void LoudnessMeter::processChunk(const float* const* channels, int numSamples)
+    {
+        for (int channel = 0; channel < channels_; ++channel) {
+            measureTruePeak(channel, channels[channel], numSamples);
+            filtered_.copyFrom(channel, 0, channels[channel], numSamples);
+        }
+        kWeighting_.process(filtered_.getArrayOfWritePointers(), channels_, numSamples);
+
+        for (int done = 0; done < numSamples;) {
+            const int count = std::min(numSamples - done, segmentLength_ - segmentFill_);
+            for (int channel = 0; channel < channels_; ++channel) {
+                const float* y = filtered_.getReadPointer(channel, done);
+                float sum = 0.0f;
+                for (int i = 0; i < count; ++i) {
+                    sum += y[i] * y[i];
+                }
+                segmentSum_ += weights_[static_cast<size_t>(channel)] * static_cast<double>(sum);
+            }
+
+            done += count;
+            segmentFill_ += count;
+            if (segmentFill_ == segmentLength_) {
+                segments_.push_back(segmentSum_ / segmentLength_);
+                segmentSum_ = 0.0;
+                segmentFill_ = 0;
+            }
+        }
+
+        samples_ += numSamples;
+    }
+
+    void LoudnessMeter::measureTruePeak(int channel, const float* input, int numSamples)
+    {
+        const juce::Range<float> range = juce::FloatVectorOperations::findMinAndMax(input, numSamples);
+        truePeak_ = std::max({ truePeak_, -range.getStart(), range.getEnd() });
+        if (oversampling_ == 1) {
+            return;
+        }
+
+        // [taps - 1 samples of history][this chunk]
+        const int historyLength = tapsPerPhase_ - 1;
+        float* extended = &history_[static_cast<size_t>(channel * (historyLength + ChunkSize))];
+        std::copy(input, input + numSamples, extended + historyLength);
+
+        // Tap by tap across the chunk, so each pass is one vector
+        // multiply-add over the samples
+        for (int phase = 0; phase < oversampling_; ++phase) {
+            const float* taps = &interpolator_[static_cast<size_t>(phase * tapsPerPhase_)];
+            juce::FloatVectorOperations::clear(phaseOutput_.data(), numSamples);
+            for (int tap = 0; tap < tapsPerPhase_; ++tap) {
+                juce::FloatVectorOperations::addWithMultiply(phaseOutput_.data(),
+                    extended + historyLength - tap, taps[tap], numSamples);
+            }
+            const juce::Range<float> interpolated = juce::FloatVectorOperations::findMinAndMax(phaseOutput_.data(), numSamples);
+            truePeak_ = std::max({ truePeak_, -interpolated.getStart(), interpolated.getEnd() });
+        }
+
+        std::copy(extended + numSamples, extended + numSamples + historyLength, extended);
+    }
+
+    LoudnessInfo LoudnessMeter::getResult() const
+    {
+        LoudnessInfo info;
+        info.valid = true;
+        info.seconds = sampleRate_ > 0.0 ? static_cast<double>(samples_) / sampleRate_ : 0.0;
+        info.truePeakDbtp = juce::Decibels::gainToDecibels(static_cast<double>(truePeak_), -120.0);
+
+        std::vector<double> segments = segments_;
+        if (segmentFill_ > 0) {
+            segments.push_back(segmentSum_ / segmentFill_);
+        }
+        if (segments.empty()) {
+            return info;
+        }
+
+        // Gating blocks; a file shorter than one block is a single block
+        std::vector<double> blocks;
+        if (segments.size() < static_cast<size_t>(BlockSegments)) {
+            double sum = 0.0;
+            for (double energy : segments) {
+                sum += energy;
+            }
+            blocks.push_back(sum / segments.size());
+        }
+        else {
+            for (size_t i = 0; i + BlockSegments <= segments.size(); ++i) {
+                blocks.push_back((segments[i] + segments[i + 1] + segments[i + 2] + segments[i + 3]) / BlockSegments);
+            }
+        }
+
+        const double absoluteGate = lufsToEnergy(LoudnessInfo::SilenceLufs);
+        const double absoluteMean = gatedMean(blocks, absoluteGate);
+        if (absoluteMean > 0.0) {
+            const double relativeGate = lufsToEnergy(energyToLufs(absoluteMean) - 10.0);
+            info.integratedLufs = energyToLufs(gatedMean(blocks, std::max(absoluteGate, relativeGate)));
+        }
+
+        // Loudness range over sliding 3 s windows
+        if (segments.size() >= static_cast<size_t>(ShortTermSegments)) {
+            std::vector<double> shortTerm;
+            double sum = 0.0;
+            for (size_t i = 0; i < segments.size(); ++i) {
+                sum += segments[i];
+                if (i >= static_cast<size_t>(ShortTermSegments)) {
+                    sum -= segments[i - ShortTermSegments];
+                }
+                if (i + 1 >= static_cast<size_t>(ShortTermSegments)) {
+                    shortTerm.push_back(std::max(0.0, sum) / ShortTermSegments);
+                }
+            }
+
+            const double shortTermMean = gatedMean(shortTerm, absoluteGate);
+            if (shortTermMean > 0.0) {
+                const double gate = std::max(absoluteGate, lufsToEnergy(energyToLufs(shortTermMean) - 20.0));
+                std::vector<double> loudness;
+                for (double energy : shortTerm) {
+                    if (energy > gate) {
+                        loudness.push_back(energyToLufs(energy));
+                    }
+                }
+                std::sort(loudness.begin(), loudness.end());
+                const size_t last = loudness.size() - 1;
+                const double low = loudness[static_cast<size_t>(std::lround(last * 0.10))];
+                const double high = loudness[static_cast<size_t>(std::lround(last * 0.95))];
+                info.loudnessRange = high - low;
+            }
+        }
+
+        return info;
+    }
+
+    // ============================================================================
+    // LoudnessAnalyzer
+    // ============================================================================
+
+    class LoudnessAnalyzer::AnalysisJob : public juce::ThreadPoolJob
+    {
+    public:
+        AnalysisJob(LoudnessAnalyzer& analyzer, std::string filePath)
+            : juce::ThreadPoolJob("Loudness analysis")
+            , analyzer_(analyzer)
+            , filePath_(std::move(filePath))
+        {
+        }
+
+        JobStatus runJob() override
+        {
+            const juce::File file(filePath_);
+            Entry entry;
+            entry.fileSize = file.getSize();
+            entry.modified = file.getLastModificationTime().toMilliseconds();
+
+            // An unreadable file is remembered as invalid until it changes
+            std::unique_ptr<juce::AudioFormatReader> reader(analyzer_.formats_.createReaderFor(file));
+            if (reader) {
+                entry.info = analyse(*reader, [this] { return shouldExit(); });
+            }
+            else {
+                std::cerr << "LoudnessAnalyzer: could not create reader for: " << filePath_ << std::endl;
+            }
+
+            analyzer_.finished(filePath_, shouldExit() ? nullptr : &entry);
+            return jobHasFinished;
+        }
+
+    private:
+        LoudnessAnalyzer& analyzer_;
+        const std::string filePath_;
+    };
+
+    LoudnessAnalyzer::LoudnessAnalyzer(juce::AudioFormatManager& formats)
+        : formats_(formats)
+    {
+    }
+
+    LoudnessAnalyzer::~LoudnessAnalyzer()
+    {
+        // Jobs report back into entries_, which goes before pool_
+        pool_.removeAllJobs(true, 5000);
+    }
+
+    void LoudnessAnalyzer::setListener(Listener listener)
+    {
+        const juce::ScopedLock lock(lock_);
+        listener_ = std::move(listener);
+    }
+
+    bool LoudnessAnalyzer::isCurrent(const Entry& entry, const juce::File& file)
+    {
+        return entry.fileSize == file.getSize()
+            && entry.modified == file.getLastModificationTime().toMilliseconds();
+    }
+
+    void LoudnessAnalyzer::request(const std::string& filePath)
+    {
+        const juce::File file(filePath);
+        if (!file.existsAsFile()) {
+            return;
+        }
+
+        {
+            const juce::ScopedLock lock(lock_);
+            auto it = entries_.find(filePath);
+            if (it != entries_.end() && isCurrent(it->second, file)) {
+                return;
+            }
+            if (!pending_.insert(filePath).second) {
+                return;
+            }
+        }
+
+        pool_.addJob(new AnalysisJob(*this, filePath), true);
+    }
+
+    bool LoudnessAnalyzer::find(const std::string& filePath, LoudnessInfo& info) const
+    {
+        Entry entry;
+        {
+            const juce::ScopedLock lock(lock_);
+            auto it = entries_.find(filePath);
+            if (it == entries_.end()) {
+                return false;
+            }
+            entry = it->second;
+        }
+
+        if (!entry.info.valid || !isCurrent(entry, juce::File(filePath))) {
+            return false;
+        }
+        info = entry.info;
+        return true;
+    }
+
+    int LoudnessAnalyzer::getPendingCount() const
+    {
+        const juce::ScopedLock lock(lock_);
+        return static_cast<int>(pending_.size());
+    }
+
+    void LoudnessAnalyzer::finished(const std::string& filePath, const Entry* entry)
+    {
+        Listener listener;
+        int remaining = 0;
+        {
+            const juce::ScopedLock lock(lock_);
+            pending_.erase(filePath);
+            if (entry) {
+                entries_[filePath] = *entry;
+            }
+            listener = listener_;
+            remaining = static_cast<int>(pending_.size());
+        }
+
+        if (entry && listener) {
+            listener(filePath, remaining);
+        }
+    }
+
+    LoudnessInfo LoudnessAnalyzer::analyse(juce::AudioFormatReader& reader, const std::function<bool()>& cancelled)
+    {
+        LoudnessMeter meter;
+        meter.prepare(static_cast<int>(reader.numChannels), reader.sampleRate);
+
+        const int channels = std::min(LoudnessMeter::MaxChannels, static_cast<int>(reader.numChannels));
+        juce::AudioBuffer<float> buffer(channels, ReadChunk);
+        for (juce::int64 position = 0; position < reader.lengthInSamples; position += ReadChunk) {
+            if (cancelled && cancelled()) {
+                return LoudnessInfo();
+            }
+
+            const int count = static_cast<int>(std::min<juce::int64>(ReadChunk, reader.lengthInSamples - position));
+            reader.read(buffer.getArrayOfWritePointers(), channels, position, count);
+            meter.process(buffer.getArrayOfReadPointers(), count);
+        }
+
+        return meter.getResult();
+    }
+
+    // ============================================================================
+    // Cache file
+    // ============================================================================
+
+    bool LoudnessAnalyzer::loadCache(const std::string& cacheFile)
+    {
+        const juce::File file(cacheFile);
+        if (!file.existsAsFile()) {
+            return false;
+        }
+
+        const juce::var root = juce::JSON::parse(file);
+        const juce::Array<juce::var>* files = root.getProperty("files", juce::var()).getArray();
+        if (files == nullptr) {
+            std::cerr << "LoudnessAnalyzer: ignoring unreadable cache " << cacheFile << std::endl;
+            return false;
+        }
+
+        const juce::ScopedLock lock(lock_);
+        for (const juce::var& item : *files) {
+            const std::string path = item.getProperty("path", juce::var()).toString().toStdString();
+            if (path.empty() || entries_.count(path) > 0) {
+                continue;   // This session's results are newer
+            }
+
+            Entry entry;
+            entry.fileSize = static_cast<juce::int64>(item.getProperty("size", 0));
+            entry.modified = static_cast<juce::int64>(item.getProperty("modified", 0));
+            entry.info.valid = static_cast<bool>(item.getProperty("valid", false));
+            entry.info.integratedLufs = item.getProperty("lufs", LoudnessInfo::SilenceLufs);
+            entry.info.truePeakDbtp = item.getProperty("truePeak", -120.0);
+            entry.info.loudnessRange = item.getProperty("lra", 0.0);
+            entry.info.seconds = item.getProperty("seconds", 0.0);
+            entries_[path] = entry;
+        }
+        return true;
+    }
+
+    bool LoudnessAnalyzer::saveCache(const std::string& cacheFile) const
+    {
+        juce::Array<juce::var> files;
+        {
+            const juce::ScopedLock lock(lock_);
+            for (const auto& [path, entry] : entries_) {
+                auto* item = new juce::DynamicObject();
+                item->setProperty("path", juce::String(path));
+                item->setProperty("size", entry.fileSize);
+                item->setProperty("modified", entry.modified);
+                item->setProperty("valid", entry.info.valid);
+                item->setProperty("lufs", entry.info.integratedLufs);
+                item->setProperty("truePeak", entry.info.truePeakDbtp);
+                item->setProperty("lra", entry.info.loudnessRange);
+                item->setProperty("seconds", entry.info.seconds);
+                files.add(juce::var(item));
+            }
+        }
+
+        auto* root = new juce::DynamicObject();
+        root->setProperty("version", 1);
+        root->setProperty("files", files);
+
+        const juce::File file(cacheFile);
+        file.getParentDirectory().createDirectory();
+        return file.replaceWithText(juce::JSON::toString(juce::var(root)));
+    }
+
+} // namespace CueForge
@@ -0,0 +1,142 @@
+// ============================================================================
+// LoudnessAnalyzer.h - Background file loudness measurement and cache
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#pragma once
+
+#include "OutputProcessor.h"
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <functional>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace CueForge {
+
+    struct LoudnessInfo
+    {
+        static constexpr double SilenceLufs = -70.0;   // The absolute gate
+
+        bool valid = false;
+        double integratedLufs = SilenceLufs;
+        double truePeakDbtp = -120.0;
+        double loudnessRange = 0.0;     // LU
+        double seconds = 0.0;
+
+        // Gain that brings the file to targetLufs, held back so the true
+        // peak stays under ceilingDbtp and limited to +/- maxGainDb. Silent
+        // files get 0.
+        double normalizationGainDb(double targetLufs, double ceilingDbtp = -1.0, double maxGainDb = 20.0) const;
+    };
+
+    /**
+     * ITU-R BS.1770-4 / EBU R128 measurement of a whole programme:
+     * integrated loudness (400 ms blocks every 100 ms, -70 LUFS absolute
+     * and -10 LU relative gates), loudness range (EBU Tech 3342, 3 s
+     * windows, -20 LU relative gate, 10th to 95th percentile) and true peak
+     * (4x oversampled below 96 kHz, 2x below 192 kHz).
+     *
+     * K-weighting runs through a BiquadBank, every channel in one pass.
+     * Channels are weighted as L R C LFE Ls Rs: the LFE is left out and the
+     * surrounds count 1.41. A mono file is measured as dual mono, the way
+     * the players put it on both sides.
+     */
+    class LoudnessMeter
+    {
+    public:
+        static constexpr int MaxChannels = 8;
+        static constexpr int ChunkSize = 4096;
+
+        // Allocates and resets
+        void prepare(int numChannels, double sampleRate);
+        void process(const float* const* channels, int numSamples);
+        LoudnessInfo getResult() const;
+
+    private:
+        void processChunk(const float* const* channels, int numSamples);
+        void measureTruePeak(int channel, const float* input, int numSamples);
+
+        int channels_ = 0;
+        double sampleRate_ = 0.0;
+        std::vector<float> weights_;
+
+        BiquadBank kWeighting_;
+        juce::AudioBuffer<float> filtered_;
+
+        // Mean square energy of every 100 ms segment, weighted and summed
+        // over channels; blocks and short-term windows are built from these
+        int segmentLength_ = 0;
+        int segmentFill_ = 0;
+        double segmentSum_ = 0.0;
+        std::vector<double> segments_;
+
+        // True peak: polyphase interpolator with a history per channel
+        int oversampling_ = 1;
+        int tapsPerPhase_ = 0;
+        std::vector<float> interpolator_;   // [phase][tap]
+        std::vector<float> history_;        // [channel][taps - 1 + ChunkSize]
+        std::vector<float> phaseOutput_;
+        float truePeak_ = 0.0f;
+
+        int64_t samples_ = 0;
+    };
+
+    /**
+     * Measures the loudness of audio files on a low-priority background
+     * thread and keeps the results, keyed by path and checked against the
+     * file's size and modification time, so an edited file is measured
+     * again. The cache can be saved to and loaded from a JSON file.
+     *
+     * request() and find() may be called from any thread; the listener is
+     * called on the analysis thread after each file.
+     */
+    class LoudnessAnalyzer
+    {
+    public:
+        // File path, and files still waiting after this one
+        using Listener = std::function<void(const std::string&, int)>;
+
+        explicit LoudnessAnalyzer(juce::AudioFormatManager& formats);
+        ~LoudnessAnalyzer();
+
+        void setListener(Listener listener);
+
+        // Queues the file unless its result is cached and current
+        void request(const std::string& filePath);
+        bool find(const std::string& filePath, LoudnessInfo& info) const;
+        int getPendingCount() const;
+
+        bool loadCache(const std::string& cacheFile);
+        bool saveCache(const std::string& cacheFile) const;
+
+        // Measures a file on the calling thread; stops early and returns an
+        // invalid result if cancelled() turns true
+        static LoudnessInfo analyse(juce::AudioFormatReader& reader,
+            const std::function<bool()>& cancelled = nullptr);
+
+    private:
+        class AnalysisJob;
+
+        struct Entry
+        {
+            int64_t fileSize = 0;
+            int64_t modified = 0;   // Milliseconds since the epoch
+            LoudnessInfo info;
+        };
+
+        static bool isCurrent(const Entry& entry, const juce::File& file);
+        void finished(const std::string& filePath, const Entry* entry);    // Null if cancelled
+
+        juce::AudioFormatManager& formats_;
+        juce::ThreadPool pool_{ 1, 0, juce::Thread::Priority::low };
+
+        mutable juce::CriticalSection lock_;
+        std::map<std::string, Entry> entries_;
+        std::set<std::string> pending_;
+        Listener listener_;
+    };
+
+} // namespace CueForge
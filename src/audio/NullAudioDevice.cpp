@@ -0,0 +1,450 @@
+// ============================================================================
+// NullAudioDevice.cpp - Soundcard-free JUCE device for headless runs
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#include "NullAudioDevice.h"
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+#include <thread>
+
+namespace CueForge {
+
+    // ============================================================================
+    // NullAudioSettings
+    // ============================================================================
+
+    bool NullAudioSettings::parse(const std::string& spec, NullAudioSettings& settings, std::string* error)
+    {
+        auto fail = [error](const std::string& message) {
+            if (error) {
+                *error = message;
+            }
+            return false;
+        };
+
+        NullAudioSettings parsed = settings;
+        std::stringstream stream(spec);
+        std::string entry;
+
+        while (std::getline(stream, entry, ',')) {
+            if (entry.empty() || entry == "default") {
+                continue;
+            }
+
+            const auto equals = entry.find('=');
+            if (equals == std::string::npos) {
+                return fail("expected key=value: " + entry);
+            }
+
+            const std::string key = entry.substr(0, equals);
+            const std::string value = entry.substr(equals + 1);
+            const juce::String number(value);
+
+            if (key == "rate") {
+                parsed.sampleRate = number.getDoubleValue();
+            }
+            else if (key == "buffer") {
+                parsed.bufferSize = number.getIntValue();
+            }
+            else if (key == "channels") {
+                parsed.outputChannels = number.getIntValue();
+            }
+            else if (key == "inputs") {
+                parsed.inputChannels = number.getIntValue();
+            }
+            else if (key == "loopback") {
+                parsed.loopback = number.getIntValue() != 0;
+            }
+            else if (key == "ring") {
+                parsed.captureRingSeconds = number.getDoubleValue();
+            }
+            else if (key == "capture") {
+                parsed.captureFile = value;
+            }
+            else if (key == "clock") {
+                if (value == "realtime") {
+                    parsed.clock = Clock::RealTime;
+                }
+                else if (value == "freewheel") {
+                    parsed.clock = Clock::Freewheel;
+                }
+                else if (value == "manual") {
+                    parsed.clock = Clock::Manual;
+                }
+                else {
+                    return fail("unknown clock: " + value);
+                }
+            }
+            else {
+                return fail("unknown key: " + key);
+            }
+        }
+
+        if (parsed.sampleRate < 8000.0 || parsed.sampleRate > 384000.0) {
+            return fail("sample rate out of range");
+        }
+        if (parsed.bufferSize < 16 || parsed.bufferSize > 8192) {
+            return fail("buffer size out of range");
+        }
+        if (parsed.outputChannels < 1 || parsed.outputChannels > 64
+            || parsed.inputChannels < 0 || parsed.inputChannels > 64) {
+            return fail("channel count out of range");
+        }
+
+        settings = parsed;
+        return true;
+    }
+
+    // ============================================================================
+    // NullAudioIODevice
+    // ============================================================================
+
+    NullAudioIODevice::NullAudioIODevice(const NullAudioSettings& settings)
+        : juce::AudioIODevice(DeviceName, NullAudioIODeviceType::TypeName)
+        , juce::Thread("Null audio device")
+        , settings_(settings)
+        , isOpen_(false)
+        , callback_(nullptr)
+        , blocksRendered_(0)
+        , xruns_(0)
+        , captureFifo_(1)
+        , captureOverruns_(0)
+    {
+    }
+
+    NullAudioIODevice::~NullAudioIODevice()
+    {
+        close();
+    }
+
+    juce::StringArray NullAudioIODevice::getOutputChannelNames()
+    {
+        juce::StringArray names;
+        for (int i = 0; i < settings_.outputChannels; ++i) {
+            names.add("Output " + juce::String(i + 1));
+        }
+        return names;
+    }
+
+    juce::StringArray NullAudioIODevice::getInputChannelNames()
+    {
+        juce::StringArray names;
+        for (int i = 0; i < settings_.inputChannels; ++i) {
+            names.add("Input " + juce::String(i + 1));
+        }
+        return names;
+    }
+
+    juce::Array<double> NullAudioIODevice::getAvailableSampleRates()
+    {
+        juce::Array<double> rates{ 44100.0, 48000.0, 88200.0, 96000.0 };
+        rates.addIfNotAlreadyThere(settings_.sampleRate);
+        rates.sort();
+        return rates;
+    }
+
+    juce::Array<int> NullAudioIODevice::getAvailableBufferSizes()
+    {
+        juce::Array<int> sizes{ 32, 64, 128, 256, 512, 1024, 2048 };
+        sizes.addIfNotAlreadyThere(settings_.bufferSize);
+        sizes.sort();
+        return sizes;
+    }
+
+    juce::String NullAudioIODevice::open(const juce::BigInteger& inputChannels,
+        const juce::BigInteger& outputChannels,
+        double sampleRate,
+        int bufferSizeSamples)
+    {
+        close();
+        lastError_.clear();
+
+        if (sampleRate > 0.0) {
+            settings_.sampleRate = sampleRate;
+        }
+        if (bufferSizeSamples > 0) {
+            settings_.bufferSize = bufferSizeSamples;
+        }
+
+        activeOutputs_ = outputChannels;
+        activeOutputs_.setRange(settings_.outputChannels, activeOutputs_.getHighestBit() + 1, false);
+        activeInputs_ = inputChannels;
+        activeInputs_.setRange(settings_.inputChannels, activeInputs_.getHighestBit() + 1, false);
+
+        const int numOutputs = activeOutputs_.countNumberOfSetBits();
+        const int numInputs = activeInputs_.countNumberOfSetBits();
+
+        outputBuffer_.setSize(numOutputs, settings_.bufferSize);
+        outputBuffer_.clear();
+        inputBuffer_.setSize(numInputs, settings_.bufferSize);
+        inputBuffer_.clear();
+
+        // +1: AbstractFifo keeps one slot free
+        const int ringSamples = settings_.captureRingSeconds > 0.0
+            ? static_cast<int>(settings_.captureRingSeconds * settings_.sampleRate)
+            : 0;
+        captureRing_.setSize(numOutputs, ringSamples + 1);
+        captureFifo_.setTotalSize(ringSamples + 1);
+        captureFifo_.reset();
+        captureOverruns_.store(0, std::memory_order_relaxed);
+
+        if (!settings_.captureFile.empty()) {
+            juce::File file(juce::String(settings_.captureFile));
+            file.deleteFile();
+
+            std::unique_ptr<juce::OutputStream> stream = file.createOutputStream();
+            juce::WavAudioFormat wav;
+            std::unique_ptr<juce::AudioFormatWriter> writer(stream
+                ? wav.createWriterFor(stream.get(), settings_.sampleRate,
+                    static_cast<unsigned int>(numOutputs), 32, {}, 0)
+                : nullptr);
+
+            if (!writer) {
+                lastError_ = "Cannot open capture file " + file.getFullPathName();
+                return lastError_;
+            }
+            stream.release();   // Owned by the writer now
+
+            writerThread_ = std::make_unique<juce::TimeSliceThread>("Null device capture");
+            writerThread_->startThread();
+            captureWriter_ = std::make_unique<juce::AudioFormatWriter::ThreadedWriter>(
+                writer.release(), *writerThread_, 1 << 17);
+        }
+
+        blocksRendered_.store(0, std::memory_order_release);
+        xruns_.store(0, std::memory_order_relaxed);
+        isOpen_ = true;
+        return {};
+    }
+
+    void NullAudioIODevice::close()
+    {
+        stop();
+        closeCaptureFile();
+        isOpen_ = false;
+    }
+
+    void NullAudioIODevice::closeCaptureFile()
+    {
+        // ThreadedWriter flushes what it still holds on destruction
+        captureWriter_.reset();
+        if (writerThread_) {
+            writerThread_->stopThread(2000);
+            writerThread_.reset();
+        }
+    }
+
+    void NullAudioIODevice::start(juce::AudioIODeviceCallback* callback)
+    {
+        if (!isOpen_ || callback == nullptr || callback_ == callback) {
+            return;
+        }
+
+        stop();
+        callback->audioDeviceAboutToStart(this);
+
+        {
+            const ProfiledLock::ScopedLockType lock(callbackLock_);
+            callback_ = callback;
+        }
+
+        if (settings_.clock != NullAudioSettings::Clock::Manual) {
+            startThread(juce::Thread::Priority::highest);
+        }
+    }
+
+    void NullAudioIODevice::stop()
+    {
+        stopThread(2000);
+
+        juce::AudioIODeviceCallback* previous = nullptr;
+        {
+            const ProfiledLock::ScopedLockType lock(callbackLock_);
+            previous = callback_;
+            callback_ = nullptr;
+        }
+
+        if (previous) {
+            previous->audioDeviceStopped();
+        }
+    }
+
+    int NullAudioIODevice::renderBlocks(int count)
+    {
+        if (!isPlaying() || isThreadRunning()) {
+            return 0;
+        }
+
+        for (int i = 0; i < count; ++i) {
+            renderBlock();
+        }
+        return count;
+    }
+
+    void NullAudioIODevice::run()
+    {
+        using Clock = std::chrono::steady_clock;
+
+        const auto period = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(settings_.bufferSize / settings_.sampleRate));
+
+        // Deadlines are counted from an epoch so pacing never drifts
+        auto epoch = Clock::now();
+        int64_t blocks = 0;
+
+        while (!threadShouldExit()) {
+            renderBlock();
+
+            if (settings_.clock != NullAudioSettings::Clock::RealTime) {
+                continue;
+            }
+
+            const auto deadline = epoch + period * (++blocks);
+            const auto now = Clock::now();
+
+            if (now > deadline + period) {
+                // Fell more than a block behind - count it and resync
+                xruns_.fetch_add(1, std::memory_order_relaxed);
+                epoch = now;
+                blocks = 0;
+                continue;
+            }
+
+            // Sleep most of the way, then yield-spin for sub-millisecond accuracy
+            const auto coarse = deadline - std::chrono::milliseconds(1);
+            if (now < coarse) {
+                std::this_thread::sleep_until(coarse);
+            }
+            while (Clock::now() < deadline && !threadShouldExit()) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void NullAudioIODevice::renderBlock()
+    {
+        const ProfiledLock::ScopedLockType lock(callbackLock_);
+        if (!callback_) {
+            return;
+        }
+
+        if (settings_.loopback) {
+            // outputBuffer_ still holds the previous block
+            const int looped = std::min(inputBuffer_.getNumChannels(), outputBuffer_.getNumChannels());
+            for (int ch = 0; ch < looped; ++ch) {
+                inputBuffer_.copyFrom(ch, 0, outputBuffer_, ch, 0, settings_.bufferSize);
+            }
+        }
+
+        outputBuffer_.clear();
+
+        const uint64_t hostTimeNs = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+        juce::AudioIODeviceCallbackContext context;
+        context.hostTimeNs = &hostTimeNs;
+
+        callback_->audioDeviceIOCallbackWithContext(
+            inputBuffer_.getArrayOfReadPointers(), inputBuffer_.getNumChannels(),
+            outputBuffer_.getArrayOfWritePointers(), outputBuffer_.getNumChannels(),
+            settings_.bufferSize, context);
+
+        capture(outputBuffer_);
+        blocksRendered_.fetch_add(1, std::memory_order_release);
+    }
+
+    void NullAudioIODevice::capture(const juce::AudioBuffer<float>& block)
+    {
+        const int numSamples = block.getNumSamples();
+
+        if (captureRing_.getNumSamples() > 1) {
+            int start1, size1, start2, size2;
+            captureFifo_.prepareToWrite(numSamples, start1, size1, start2, size2);
+
+            for (int ch = 0; ch < block.getNumChannels(); ++ch) {
+                if (size1 > 0) {
+                    captureRing_.copyFrom(ch, start1, block, ch, 0, size1);
+                }
+                if (size2 > 0) {
+                    captureRing_.copyFrom(ch, start2, block, ch, size1, size2);
+                }
+            }
+
+            captureFifo_.finishedWrite(size1 + size2);
+            if (size1 + size2 < numSamples) {
+                captureOverruns_.fetch_add(numSamples - size1 - size2, std::memory_order_relaxed);
+            }
+        }
+
+        if (captureWriter_ && !captureWriter_->write(block.getArrayOfReadPointers(), numSamples)) {
+            captureOverruns_.fetch_add(numSamples, std::memory_order_relaxed);
+        }
+    }
+
+    int NullAudioIODevice::getCaptureAvailable() const
+    {
+        return captureFifo_.getNumReady();
+    }
+
+    int NullAudioIODevice::readCapture(juce::AudioBuffer<float>& destination, int maxSamples)
+    {
+        int start1, size1, start2, size2;
+        captureFifo_.prepareToRead(maxSamples, start1, size1, start2, size2);
+
+        const int total = size1 + size2;
+        destination.setSize(captureRing_.getNumChannels(), total, false, false, true);
+
+        for (int ch = 0; ch < captureRing_.getNumChannels(); ++ch) {
+            if (size1 > 0) {
+                destination.copyFrom(ch, 0, captureRing_, ch, start1, size1);
+            }
+            if (size2 > 0) {
+                destination.copyFrom(ch, size1, captureRing_, ch, start2, size2);
+            }
+        }
+
+        captureFifo_.finishedRead(total);
+        return total;
+    }
+
+    // ============================================================================
+    // NullAudioIODeviceType
+    // ============================================================================
+
+    NullAudioIODeviceType::NullAudioIODeviceType(const NullAudioSettings& settings)
+        : juce::AudioIODeviceType(TypeName)
+        , settings_(settings)
+    {
+    }
+
+    juce::StringArray NullAudioIODeviceType::getDeviceNames(bool wantInputNames) const
+    {
+        juce::ignoreUnused(wantInputNames);
+        return { NullAudioIODevice::DeviceName };
+    }
+
+    int NullAudioIODeviceType::getDefaultDeviceIndex(bool forInput) const
+    {
+        juce::ignoreUnused(forInput);
+        return 0;
+    }
+
+    int NullAudioIODeviceType::getIndexOfDevice(juce::AudioIODevice* device, bool asInput) const
+    {
+        juce::ignoreUnused(asInput);
+        return dynamic_cast<NullAudioIODevice*>(device) != nullptr ? 0 : -1;
+    }
+
+    juce::AudioIODevice* NullAudioIODeviceType::createDevice(const juce::String& outputDeviceName,
+        const juce::String& inputDeviceName)
+    {
+        const juce::String name = outputDeviceName.isNotEmpty() ? outputDeviceName : inputDeviceName;
+        if (name.isNotEmpty() && name != NullAudioIODevice::DeviceName) {
+            return nullptr;
+        }
+        return new NullAudioIODevice(settings_);
+    }
+
+} // namespace CueForge
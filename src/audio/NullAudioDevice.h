@@ -0,0 +1,162 @@
+// ============================================================================
+// NullAudioDevice.h - Soundcard-free JUCE device for headless runs
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_audio_devices/juce_audio_devices.h>
+#include <juce_audio_formats/juce_audio_formats.h>
+#include "ProfiledLock.h"
+#include <atomic>
+#include <memory>
+#include <string>
+
+namespace CueForge {
+
+    /**
+     * Configuration for the null device
+     */
+    struct NullAudioSettings
+    {
+        enum class Clock {
+            RealTime,   // Callback paced by an internal drift-free clock
+            Freewheel,  // Callback runs back-to-back, as fast as possible
+            Manual      // No thread - the caller drives renderBlocks()
+        };
+
+        double sampleRate = 48000.0;
+        int bufferSize = 256;
+        int outputChannels = 2;
+        int inputChannels = 0;
+        Clock clock = Clock::RealTime;
+
+        // Cable from each output back to the same-numbered input: a block's
+        // inputs are what the previous block rendered, as on hardware with a
+        // physical loop, so input-to-output latency can be measured
+        bool loopback = false;
+
+        // Capture of everything the callback renders
+        double captureRingSeconds = 10.0;   // 0 disables the in-memory ring
+        std::string captureFile;            // 32-bit float WAV; empty disables
+
+        // "rate=48000,buffer=256,channels=2,inputs=0,clock=realtime|freewheel|manual,
+        //  loopback=0|1,ring=10,capture=/path/out.wav" or "default" - unknown keys are an error
+        static bool parse(const std::string& spec, NullAudioSettings& settings, std::string* error = nullptr);
+    };
+
+    /**
+     * An AudioIODevice with no hardware behind it. The callback is driven by
+     * its own thread (or by the caller in Manual mode) with silent or
+     * looped-back inputs, and every rendered block is copied into a capture
+     * ring and/or a WAV file so output can be inspected after the fact.
+     */
+    class NullAudioIODevice : public juce::AudioIODevice,
+                              private juce::Thread
+    {
+    public:
+        static constexpr const char* DeviceName = "CueForge Null Output";
+
+        explicit NullAudioIODevice(const NullAudioSettings& settings);
+        ~NullAudioIODevice() override;
+
+        // juce::AudioIODevice
+        juce::StringArray getOutputChannelNames() override;
+        juce::StringArray getInputChannelNames() override;
+        juce::Array<double> getAvailableSampleRates() override;
+        juce::Array<int> getAvailableBufferSizes() override;
+        int getDefaultBufferSize() override { return settings_.bufferSize; }
+
+        juce::String open(const juce::BigInteger& inputChannels,
+            const juce::BigInteger& outputChannels,
+            double sampleRate,
+            int bufferSizeSamples) override;
+        void close() override;
+        bool isOpen() override { return isOpen_; }
+
+        void start(juce::AudioIODeviceCallback* callback) override;
+        void stop() override;
+        bool isPlaying() override { return callback_ != nullptr; }
+
+        juce::String getLastError() override { return lastError_; }
+        int getCurrentBufferSizeSamples() override { return settings_.bufferSize; }
+        double getCurrentSampleRate() override { return settings_.sampleRate; }
+        int getCurrentBitDepth() override { return 32; }
+        juce::BigInteger getActiveOutputChannels() const override { return activeOutputs_; }
+        juce::BigInteger getActiveInputChannels() const override { return activeInputs_; }
+        int getOutputLatencyInSamples() override { return 0; }
+        int getInputLatencyInSamples() override { return 0; }
+        int getXRunCount() const noexcept override { return xruns_.load(std::memory_order_relaxed); }
+
+        // Manual clock: render blocks synchronously on the calling thread.
+        // Returns the number rendered (0 if the device isn't started).
+        int renderBlocks(int count);
+
+        int64_t getBlocksRendered() const { return blocksRendered_.load(std::memory_order_acquire); }
+        const NullAudioSettings& getSettings() const { return settings_; }
+
+        // Pull captured samples out of the ring (deinterleaved, one block of
+        // channels as configured). Returns the number of samples read.
+        int readCapture(juce::AudioBuffer<float>& destination, int maxSamples);
+        int getCaptureAvailable() const;
+        int64_t getCaptureOverruns() const { return captureOverruns_.load(std::memory_order_relaxed); }
+
+    private:
+        void run() override;
+        void renderBlock();
+        void capture(const juce::AudioBuffer<float>& block);
+        void closeCaptureFile();
+
+        NullAudioSettings settings_;
+        juce::BigInteger activeOutputs_;
+        juce::BigInteger activeInputs_;
+        juce::String lastError_;
+        bool isOpen_;
+
+        ProfiledLock callbackLock_{ "NullAudioIODevice::callbackLock" };
+        juce::AudioIODeviceCallback* callback_;
+
+        juce::AudioBuffer<float> outputBuffer_;
+        juce::AudioBuffer<float> inputBuffer_;
+
+        std::atomic<int64_t> blocksRendered_;
+        std::atomic<int> xruns_;
+
+        // Capture ring - written by the render thread, read by anyone
+        juce::AbstractFifo captureFifo_;
+        juce::AudioBuffer<float> captureRing_;
+        std::atomic<int64_t> captureOverruns_;
+
+        // Capture file - ThreadedWriter keeps disk I/O off the render thread
+        std::unique_ptr<juce::TimeSliceThread> writerThread_;
+        std::unique_ptr<juce::AudioFormatWriter::ThreadedWriter> captureWriter_;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(NullAudioIODevice)
+    };
+
+    /**
+     * Device type that offers the single null device to AudioDeviceManager
+     */
+    class NullAudioIODeviceType : public juce::AudioIODeviceType
+    {
+    public:
+        static constexpr const char* TypeName = "Null";
+
+        explicit NullAudioIODeviceType(const NullAudioSettings& settings);
+
+        void scanForDevices() override {}
+        juce::StringArray getDeviceNames(bool wantInputNames = false) const override;
+        int getDefaultDeviceIndex(bool forInput) const override;
+        int getIndexOfDevice(juce::AudioIODevice* device, bool asInput) const override;
+        bool hasSeparateInputsAndOutputs() const override { return false; }
+        juce::AudioIODevice* createDevice(const juce::String& outputDeviceName,
+            const juce::String& inputDeviceName) override;
+
+    private:
+        NullAudioSettings settings_;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(NullAudioIODeviceType)
+    };
+
+} // namespace CueForge
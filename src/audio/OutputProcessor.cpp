@@ -0,0 +1,446 @@
+// ============================================================================
+// OutputProcessor.cpp - Per-output delay alignment, EQ and trim
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#include "OutputProcessor.h"
+#include <algorithm>
+#include <cmath>
+
+namespace CueForge {
+
+    // ============================================================================
+    // EqBand
+    // ============================================================================
+
+    const char* EqBand::typeToString(Type type)
+    {
+        switch (type) {
+        case Type::Peak:      return "peak";
+        case Type::LowShelf:  return "lowShelf";
+        case Type::HighShelf: return "highShelf";
+        case Type::LowPass:   return "lowPass";
+        case Type::HighPass:  return "highPass";
+        }
+        return "peak";
+    }
+
+    bool EqBand::typeFromString(const std::string& name, Type& type)
+    {
+        for (Type candidate : { Type::Peak, Type::LowShelf, Type::HighShelf, Type::LowPass, Type::HighPass }) {
+            if (name == typeToString(candidate)) {
+                type = candidate;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // ============================================================================
+    // BiquadBank
+    // ============================================================================
+
+    BiquadBank::Coefficients BiquadBank::Coefficients::make(const EqBand& band, double sampleRate)
+    {
+        const double frequency = juce::jlimit(10.0, sampleRate * 0.49, band.frequency);
+        const double q = juce::jlimit(0.1, 40.0, band.q);
+        const double w0 = juce::MathConstants<double>::twoPi * frequency / sampleRate;
+        const double cosW0 = std::cos(w0);
+        const double alpha = std::sin(w0) / (2.0 * q);
+        const double a = std::pow(10.0, band.gainDb / 40.0);
+
+        double b0 = 1.0, b1 = 0.0, b2 = 0.0, a0 = 1.0, a1 = 0.0, a2 = 0.0;
+
+        switch (band.type) {
+        case EqBand::Type::Peak:
+            b0 = 1.0 + alpha * a;
+            b1 = -2.0 * cosW0;
+            b2 = 1.0 - alpha * a;
+            a0 = 1.0 + alpha / a;
+            a1 = -2.0 * cosW0;
+            a2 = 1.0 - alpha / a;
+            break;
+
+        case EqBand::Type::LowShelf: {
+            const double sqrtA = 2.0 * std::sqrt(a) * alpha;
+            b0 = a * ((a + 1.0) - (a - 1.0) * cosW0 + sqrtA);
+            b1 = 2.0 * a * ((a - 1.0) - (a + 1.0) * cosW0);
+            b2 = a * ((a + 1.0) - (a - 1.0) * cosW0 - sqrtA);
+            a0 = (a + 1.0) + (a - 1.0) * cosW0 + sqrtA;
+            a1 = -2.0 * ((a - 1.0) + (a + 1.0) * cosW0);
+            a2 = (a + 1.0) + (a - 1.0) * cosW0 - sqrtA;
+            break;
+        }
+
+        case EqBand::Type::HighShelf: {
+            const double sqrtA = 2.0 * std::sqrt(a) * alpha;
+            b0 = a * ((a + 1.0) + (a - 1.0) * cosW0 + sqrtA);
+            b1 = -2.0 * a * ((a - 1.0) + (a + 1.0) * cosW0);
+            b2 = a * ((a + 1.0) + (a - 1.0) * cosW0 - sqrtA);
+            a0 = (a + 1.0) - (a - 1.0) * cosW0 + sqrtA;
+            a1 = 2.0 * ((a - 1.0) - (a + 1.0) * cosW0);
+            a2 = (a + 1.0) - (a - 1.0) * cosW0 - sqrtA;
+            break;
+        }
+
+        case EqBand::Type::LowPass:
+            b0 = (1.0 - cosW0) / 2.0;
+            b1 = 1.0 - cosW0;
+            b2 = (1.0 - cosW0) / 2.0;
+            a0 = 1.0 + alpha;
+            a1 = -2.0 * cosW0;
+            a2 = 1.0 - alpha;
+            break;
+
+        case EqBand::Type::HighPass:
+            b0 = (1.0 + cosW0) / 2.0;
+            b1 = -(1.0 + cosW0);
+            b2 = (1.0 + cosW0) / 2.0;
+            a0 = 1.0 + alpha;
+            a1 = -2.0 * cosW0;
+            a2 = 1.0 - alpha;
+            break;
+        }
+
+        Coefficients c;
+        c.b0 = static_cast<float>(b0 / a0);
+        c.b1 = static_cast<float>(b1 / a0);
+        c.b2 = static_cast<float>(b2 / a0);
+        c.a1 = static_cast<float>(a1 / a0);
+        c.a2 = static_cast<float>(a2 / a0);
+        return c;
+    }
+
+    void BiquadBank::prepare(int numChannels, int maxBlockSize)
+    {
+        lanes_ = std::max(LaneWidth, (numChannels + LaneWidth - 1) / LaneWidth * LaneWidth);
+        maxBlockSize_ = std::max(1, maxBlockSize);
+        activeBands_ = 0;
+
+        channelBands_.assign(static_cast<size_t>(lanes_), 0);
+        coefficients_.assign(static_cast<size_t>(MaxBands * 5 * lanes_), 0.0f);
+        state_.assign(static_cast<size_t>(MaxBands * 2 * lanes_), 0.0f);
+        frames_.assign(static_cast<size_t>(maxBlockSize_ * lanes_), 0.0f);
+
+        // Pass-through everywhere until told otherwise
+        for (int band = 0; band < MaxBands; ++band) {
+            std::fill_n(&coefficients_[static_cast<size_t>((band * 5) * lanes_)], lanes_, 1.0f);
+        }
+    }
+
+    void BiquadBank::reset()
+    {
+        std::fill(state_.begin(), state_.end(), 0.0f);
+    }
+
+    void BiquadBank::setCoefficients(int channel, const Coefficients* bands, int numBands)
+    {
+        if (channel < 0 || channel >= lanes_) {
+            return;
+        }
+
+        numBands = juce::jlimit(0, MaxBands, numBands);
+        for (int band = 0; band < MaxBands; ++band) {
+            const Coefficients c = band < numBands ? bands[band] : Coefficients();
+            float* base = &coefficients_[static_cast<size_t>(band * 5 * lanes_ + channel)];
+            base[0 * lanes_] = c.b0;
+            base[1 * lanes_] = c.b1;
+            base[2 * lanes_] = c.b2;
+            base[3 * lanes_] = c.a1;
+            base[4 * lanes_] = c.a2;
+
+            // A section leaving the chain starts clean if it comes back
+            if (band >= numBands) {
+                state_[static_cast<size_t>(band * 2 * lanes_ + channel)] = 0.0f;
+                state_[static_cast<size_t>((band * 2 + 1) * lanes_ + channel)] = 0.0f;
+            }
+        }
+
+        channelBands_[static_cast<size_t>(channel)] = numBands;
+        activeBands_ = *std::max_element(channelBands_.begin(), channelBands_.end());
+    }
+
+    void BiquadBank::process(float* const* channels, int numChannels, int numSamples)
+    {
+        if (activeBands_ == 0) {
+            return;
+        }
+
+        numChannels = std::min(numChannels, lanes_);
+        const int lanes = lanes_;
+
+        for (int offset = 0; offset < numSamples; offset += maxBlockSize_) {
+            const int count = std::min(maxBlockSize_, numSamples - offset);
+
+            // Planar -> interleaved; padding lanes stay at zero
+            for (int channel = 0; channel < numChannels; ++channel) {
+                const float* in = channels[channel] + offset;
+                for (int i = 0; i < count; ++i) {
+                    frames_[static_cast<size_t>(i * lanes + channel)] = in[i];
+                }
+            }
+
+            // One section at a time over the whole block keeps its
+            // coefficients and state in registers
+            for (int band = 0; band < activeBands_; ++band) {
+                const float* b0 = &coefficients_[static_cast<size_t>((band * 5 + 0) * lanes)];
+                const float* b1 = &coefficients_[static_cast<size_t>((band * 5 + 1) * lanes)];
+                const float* b2 = &coefficients_[static_cast<size_t>((band * 5 + 2) * lanes)];
+                const float* a1 = &coefficients_[static_cast<size_t>((band * 5 + 3) * lanes)];
+                const float* a2 = &coefficients_[static_cast<size_t>((band * 5 + 4) * lanes)];
+                float* z1 = &state_[static_cast<size_t>((band * 2) * lanes)];
+                float* z2 = &state_[static_cast<size_t>((band * 2 + 1) * lanes)];
+
+                for (int i = 0; i < count; ++i) {
+                    float* x = &frames_[static_cast<size_t>(i * lanes)];
+                    for (int lane = 0; lane < lanes; ++lane) {
+                        const float in = x[lane];
+                        const float out = b0[lane] * in + z1[lane];
+                        z1[lane] = b1[lane] * in - a1[lane] * out + z2[lane];
+                        z2[lane] = b2[lane] * in - a2[lane] * out;
+                        x[lane] = out;
+                    }
+                }
+            }
+
+            for (int channel = 0; channel < numChannels; ++channel) {
+                float* out = channels[channel] + offset;
+                for (int i = 0; i < count; ++i) {
+                    out[i] = frames_[static_cast<size_t>(i * lanes + channel)];
+                }
+            }
+        }
+    }
+
+    // ============================================================================
+    // OutputProcessor
+    // ============================================================================
+
+    OutputProcessor::OutputProcessor()
+        : settings_(MaxOutputs)
+        , pending_(MaxOutputs)
+        , active_(MaxOutputs)
+        , currentDelay_(MaxOutputs, 0)
+        , currentGain_(MaxOutputs, 1.0f)
+    {
+    }
+
+    void OutputProcessor::prepare(int numChannels, int maxBlockSize, double sampleRate)
+    {
+        numChannels_ = juce::jlimit(0, MaxOutputs, numChannels);
+        maxBlockSize_ = std::max(1, maxBlockSize);
+        sampleRate_.store(sampleRate, std::memory_order_release);
+
+        const int maxDelay = static_cast<int>(std::ceil(MaxDelaySeconds * sampleRate));
+        delaySize_ = juce::nextPowerOfTwo(maxDelay + maxBlockSize_ + 1);
+        delayWrite_ = 0;
+        delayLines_.assign(static_cast<size_t>(numChannels_) * static_cast<size_t>(delaySize_), 0.0f);
+        tapScratch_.assign(static_cast<size_t>(maxBlockSize_), 0.0f);
+
+        eq_.prepare(numChannels_, maxBlockSize_);
+
+        // Coefficients depend on the rate: recompute everything and take it
+        // without ramps, since nothing is playing through it yet
+        stageAll();
+        {
+            const juce::SpinLock::ScopedLockType lock(settingsLock_);
+            takePending();
+        }
+        for (int output = 0; output < MaxOutputs; ++output) {
+            currentDelay_[output] = active_[output].delaySamples;
+            currentGain_[output] = active_[output].gain;
+        }
+    }
+
+    void OutputProcessor::release()
+    {
+        eq_.reset();
+        std::fill(delayLines_.begin(), delayLines_.end(), 0.0f);
+    }
+
+    OutputProcessor::Params OutputProcessor::makeParams(const OutputSettings& settings, double sampleRate) const
+    {
+        Params params;
+        if (sampleRate <= 0.0) {
+            return params;
+        }
+
+        params.delaySamples = juce::jlimit(0, static_cast<int>(MaxDelaySeconds * sampleRate),
+            static_cast<int>(std::lround(settings.delayMs * 0.001 * sampleRate)));
+        params.gain = juce::Decibels::decibelsToGain(static_cast<float>(settings.trimDb), -120.0f);
+        params.numBands = std::min(MaxBands, static_cast<int>(settings.eq.size()));
+        for (int band = 0; band < params.numBands; ++band) {
+            params.bands[band] = BiquadBank::Coefficients::make(settings.eq[static_cast<size_t>(band)], sampleRate);
+        }
+        return params;
+    }
+
+    void OutputProcessor::stageAll()
+    {
+        const double sampleRate = sampleRate_.load(std::memory_order_acquire);
+        const juce::SpinLock::ScopedLockType lock(settingsLock_);
+
+        for (int output = 0; output < MaxOutputs; ++output) {
+            pending_[output] = makeParams(settings_[output], sampleRate);
+        }
+        pendingChanged_.store(true, std::memory_order_release);
+    }
+
+    bool OutputProcessor::setOutput(int output, const OutputSettings& settings)
+    {
+        if (output < 0 || output >= MaxOutputs || settings.delayMs < 0.0
+            || settings.delayMs > MaxDelaySeconds * 1000.0 || static_cast<int>(settings.eq.size()) > MaxBands) {
+            return false;
+        }
+
+        // Coefficients are worked out here, not on the audio thread
+        const Params params = makeParams(settings, sampleRate_.load(std::memory_order_acquire));
+
+        const juce::SpinLock::ScopedLockType lock(settingsLock_);
+        settings_[output] = settings;
+        pending_[output] = params;
+        pendingChanged_.store(true, std::memory_order_release);
+        return true;
+    }
+
+    OutputSettings OutputProcessor::getOutput(int output) const
+    {
+        if (output < 0 || output >= MaxOutputs) {
+            return OutputSettings();
+        }
+
+        const juce::SpinLock::ScopedLockType lock(settingsLock_);
+        return settings_[output];
+    }
+
+    void OutputProcessor::resetAll()
+    {
+        {
+            const juce::SpinLock::ScopedLockType lock(settingsLock_);
+            std::fill(settings_.begin(), settings_.end(), OutputSettings());
+        }
+        stageAll();
+    }
+
+    void OutputProcessor::applyPending()
+    {
+        if (!pendingChanged_.load(std::memory_order_acquire)) {
+            return;
+        }
+
+        // Never wait on the control thread; pick it up next block instead
+        const juce::SpinLock::ScopedTryLockType lock(settingsLock_);
+        if (lock.isLocked()) {
+            takePending();
+        }
+    }
+
+    void OutputProcessor::takePending()
+    {
+        std::copy(pending_.begin(), pending_.end(), active_.begin());
+        pendingChanged_.store(false, std::memory_order_release);
+
+        anyActive_ = false;
+        for (int output = 0; output < numChannels_; ++output) {
+            const Params& params = active_[output];
+            eq_.setCoefficients(output, params.bands, params.numBands);
+            anyActive_ = anyActive_ || params.delaySamples > 0 || params.gain != 1.0f || params.numBands > 0
+                || currentDelay_[output] > 0 || currentGain_[output] != 1.0f;
+        }
+    }
+
+    void OutputProcessor::process(juce::AudioBuffer<float>& buffer, int numSamples)
+    {
+        applyPending();
+        if (numChannels_ == 0) {
+            return;
+        }
+
+        const juce::ScopedNoDenormals noDenormals;
+        const int channels = std::min(numChannels_, buffer.getNumChannels());
+
+        for (int offset = 0; offset < numSamples; offset += maxBlockSize_) {
+            const int count = std::min(maxBlockSize_, numSamples - offset);
+            float* pointers[MaxOutputs];
+            for (int channel = 0; channel < channels; ++channel) {
+                pointers[channel] = buffer.getWritePointer(channel, offset);
+            }
+            processBlock(pointers, channels, count);
+        }
+    }
+
+    void OutputProcessor::processBlock(float* const* channels, int numChannels, int numSamples)
+    {
+        const int mask = delaySize_ - 1;
+
+        // Delay lines are written even when nothing is active, so turning a
+        // delay on plays recent history rather than stale audio
+        for (int channel = 0; channel < numChannels; ++channel) {
+            float* line = &delayLines_[static_cast<size_t>(channel) * static_cast<size_t>(delaySize_)];
+            const int first = std::min(numSamples, delaySize_ - delayWrite_);
+            std::copy_n(channels[channel], first, line + delayWrite_);
+            std::copy_n(channels[channel] + first, numSamples - first, line);
+        }
+
+        if (!anyActive_) {
+            delayWrite_ = (delayWrite_ + numSamples) & mask;
+            return;
+        }
+
+        // A changed delay crossfades old tap -> new tap over the block
+        for (int channel = 0; channel < numChannels; ++channel) {
+            float* data = channels[channel];
+            const float* line = &delayLines_[static_cast<size_t>(channel) * static_cast<size_t>(delaySize_)];
+
+            const int target = active_[channel].delaySamples;
+            const int current = currentDelay_[channel];
+            if (target == 0 && current == 0) {
+                continue;
+            }
+
+            auto readTap = [&](int delay, float* destination) {
+                const int start = (delayWrite_ - delay) & mask;
+                const int run = std::min(numSamples, delaySize_ - start);
+                std::copy_n(line + start, run, destination);
+                std::copy_n(line, numSamples - run, destination + run);
+            };
+
+            if (target == current) {
+                readTap(target, data);
+            }
+            else {
+                float* old = tapScratch_.data();
+                readTap(current, old);
+                readTap(target, data);
+                for (int i = 0; i < numSamples; ++i) {
+                    const float t = (static_cast<float>(i) + 0.5f) / static_cast<float>(numSamples);
+                    data[i] = old[i] + (data[i] - old[i]) * t;
+                }
+                currentDelay_[channel] = target;
+            }
+        }
+        delayWrite_ = (delayWrite_ + numSamples) & mask;
+
+        eq_.process(channels, numChannels, numSamples);
+
+        // Trim, ramped across the block when it changes
+        for (int channel = 0; channel < numChannels; ++channel) {
+            const float target = active_[channel].gain;
+            const float current = currentGain_[channel];
+            if (target == current) {
+                if (target != 1.0f) {
+                    juce::FloatVectorOperations::multiply(channels[channel], target, numSamples);
+                }
+                continue;
+            }
+
+            const float step = (target - current) / static_cast<float>(numSamples);
+            float* data = channels[channel];
+            for (int i = 0; i < numSamples; ++i) {
+                data[i] *= current + step * static_cast<float>(i + 1);
+            }
+            currentGain_[channel] = target;
+        }
+    }
+
+} // namespace CueForge
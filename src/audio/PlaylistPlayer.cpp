@@ -0,0 +1,470 @@
+// ============================================================================
+// PlaylistPlayer.cpp - Gapless track list voice with optional crossfades
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#include "PlaylistPlayer.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <numeric>
+
+namespace CueForge {
+
+    PlaylistPlayer::PlaylistPlayer(int id, juce::AudioFormatManager& formats, juce::TimeSliceThread& readThread)
+        : id_(id)
+        , formats_(formats)
+        , readThread_(readThread)
+    {
+    }
+
+    PlaylistPlayer::~PlaylistPlayer()
+    {
+        // Waits for a slice in progress on this player to finish
+        readThread_.removeTimeSliceClient(this);
+    }
+
+    bool PlaylistPlayer::loadTracks(const std::vector<std::string>& filePaths, const Options& options,
+        double deviceSampleRate, std::string* error)
+    {
+        auto fail = [error](const std::string& message) {
+            std::cerr << "PlaylistPlayer: " << message << std::endl;
+            if (error) {
+                *error = message;
+            }
+            return false;
+        };
+
+        readThread_.removeTimeSliceClient(this);
+
+        if (filePaths.empty()) {
+            return fail("Playlist has no tracks");
+        }
+        if (deviceSampleRate <= 0.0) {
+            return fail("Device sample rate unknown");
+        }
+
+        // Fail on GO rather than as a gap mid-show
+        for (const std::string& path : filePaths) {
+            std::unique_ptr<juce::AudioFormatReader> reader(formats_.createReaderFor(juce::File(path)));
+            if (!reader) {
+                return fail("Could not create reader for: " + path);
+            }
+        }
+
+        paths_ = filePaths;
+        options_ = options;
+        options_.crossfadeSeconds = juce::jlimit(0.0, MaxCrossfadeSeconds, options.crossfadeSeconds);
+        deviceSampleRate_ = deviceSampleRate;
+        crossfadeSamples_ = static_cast<int64_t>(options_.crossfadeSeconds * deviceSampleRate_);
+
+        const int ringSize = std::max(2 * ChunkSamples + 1,
+            static_cast<int>(deviceSampleRate_ * ReadAheadSeconds));
+        fifo_.setTotalSize(ringSize);
+        ring_.setSize(Channels, ringSize);
+        ring_.clear();
+        chunk_.setSize(Channels, ChunkSamples);
+        fadeBuffer_.setSize(Channels, ChunkSamples);
+
+        random_.setSeed(options_.seed != 0 ? options_.seed : juce::Time::currentTimeMillis());
+        order_.resize(paths_.size());
+        std::iota(order_.begin(), order_.end(), 0);
+        if (options_.shuffle) {
+            shuffleOrder(-1);
+        }
+
+        restartAt(0);
+        readThread_.addTimeSliceClient(this);
+
+        std::cout << "Loaded playlist of " << paths_.size() << " tracks" << std::endl;
+        return true;
+    }
+
+    std::string PlaylistPlayer::getTrackPath(int track) const
+    {
+        return (track >= 0 && track < getNumTracks()) ? paths_[track] : std::string();
+    }
+
+    int PlaylistPlayer::getCurrentTrack() const
+    {
+        if (isFinished()) {
+            return -1;
+        }
+
+        const int64_t position = playPosition_.load(std::memory_order_acquire);
+        const juce::SpinLock::ScopedLockType lock(boundaryLock_);
+
+        int track = -1;
+        for (const Boundary& boundary : boundaries_) {
+            if (boundary.start > position) {
+                break;
+            }
+            track = boundary.track;
+        }
+        return track;
+    }
+
+    // ============================================================================
+    // Transport
+    // ============================================================================
+
+    void PlaylistPlayer::play()
+    {
+        if (paths_.empty()) {
+            return;
+        }
+
+        // Preroll, so the first block (and the first track's first sample)
+        // doesn't wait on the read-ahead thread
+        while (fifo_.getNumReady() < ChunkSamples && fillChunk()) {
+        }
+
+        playing_.store(true, std::memory_order_release);
+    }
+
+    void PlaylistPlayer::stop()
+    {
+        playing_.store(false, std::memory_order_release);
+        restartAt(0);
+    }
+
+    void PlaylistPlayer::pause()
+    {
+        playing_.store(false, std::memory_order_release);
+    }
+
+    void PlaylistPlayer::resume()
+    {
+        if (paths_.empty() || isFinished()) {
+            return;
+        }
+        play();
+    }
+
+    bool PlaylistPlayer::skipToNext()
+    {
+        const int track = getCurrentTrack();
+
+        int orderIndex = -1;
+        {
+            const juce::ScopedLock lock(readLock_);
+            auto it = std::find(order_.begin(), order_.end(), track);
+            if (it != order_.end()) {
+                const int following = static_cast<int>(it - order_.begin()) + 1;
+                orderIndex = following < static_cast<int>(order_.size()) ? following : (options_.loop ? 0 : -1);
+            }
+        }
+
+        if (orderIndex < 0) {
+            return false;
+        }
+
+        // A cut, not a splice: what is already read ahead is dropped
+        const bool wasPlaying = isPlaying();
+        restartAt(orderIndex);
+        if (wasPlaying) {
+            play();
+        }
+        return true;
+    }
+
+    bool PlaylistPlayer::isFinished() const
+    {
+        const int64_t end = streamEnd_.load(std::memory_order_acquire);
+        return !isPlaying() && end >= 0 && playPosition_.load(std::memory_order_acquire) >= end;
+    }
+
+    void PlaylistPlayer::setVolume(float volume)
+    {
+        volume_.store(juce::jlimit(0.0f, 1.0f, volume), std::memory_order_relaxed);
+    }
+
+    double PlaylistPlayer::getPosition() const
+    {
+        return deviceSampleRate_ > 0.0
+            ? static_cast<double>(playPosition_.load(std::memory_order_acquire)) / deviceSampleRate_
+            : 0.0;
+    }
+
+    void PlaylistPlayer::restartAt(int orderIndex)
+    {
+        // Callback first, then read-ahead. Readers are only closed here;
+        // opening the files again happens on the next fill.
+        const juce::ScopedLock callbackLock(callbackLock_);
+        const juce::ScopedLock readLock(readLock_);
+
+        current_ = Deck();
+        next_ = Deck();
+        pendingOrderIndex_ = orderIndex;
+        written_ = 0;
+
+        fifo_.reset();
+        playPosition_.store(0, std::memory_order_release);
+        streamEnd_.store(-1, std::memory_order_release);
+        lastGain_ = 0.0f;
+
+        const juce::SpinLock::ScopedLockType lock(boundaryLock_);
+        boundaries_.clear();
+    }
+
+    // ============================================================================
+    // Read-ahead thread
+    // ============================================================================
+
+    int PlaylistPlayer::useTimeSlice()
+    {
+        // One chunk per slice, so other players on the thread take turns
+        return fillChunk() ? 0 : 20;
+    }
+
+    void PlaylistPlayer::shuffleOrder(int avoidFirst)
+    {
+        for (int i = static_cast<int>(order_.size()) - 1; i > 0; --i) {
+            std::swap(order_[i], order_[random_.nextInt(i + 1)]);
+        }
+
+        // No track twice in a row across a reshuffle
+        if (order_.size() > 1 && order_[0] == avoidFirst) {
+            std::swap(order_[0], order_[1]);
+        }
+    }
+
+    int PlaylistPlayer::followingOrderIndex(int orderIndex)
+    {
+        if (orderIndex + 1 < static_cast<int>(order_.size())) {
+            return orderIndex + 1;
+        }
+        if (!options_.loop) {
+            return -1;
+        }
+        if (options_.shuffle) {
+            shuffleOrder(order_[orderIndex]);
+        }
+        return 0;
+    }
+
+    bool PlaylistPlayer::openDeck(Deck& deck, int orderIndex)
+    {
+        deck = Deck();
+
+        const int track = order_[orderIndex];
+        auto* reader = formats_.createReaderFor(juce::File(paths_[track]));
+        if (!reader) {
+            std::cerr << "PlaylistPlayer: Could not open " << paths_[track] << ", skipped" << std::endl;
+            return false;
+        }
+
+        const double ratio = reader->sampleRate / deviceSampleRate_;
+        deck.length = static_cast<int64_t>(std::llround(static_cast<double>(reader->lengthInSamples) / ratio));
+        deck.source = std::make_unique<juce::AudioFormatReaderSource>(reader, true);
+
+        if (std::abs(ratio - 1.0) > 1.0e-9) {
+            deck.resampler = std::make_unique<juce::ResamplingAudioSource>(deck.source.get(), false, Channels);
+            deck.resampler->setResamplingRatio(ratio);
+            deck.resampler->prepareToPlay(ChunkSamples, deviceSampleRate_);
+        }
+
+        deck.track = track;
+        deck.orderIndex = orderIndex;
+        return true;
+    }
+
+    bool PlaylistPlayer::openFollowing(Deck& deck, int afterOrderIndex)
+    {
+        // Unreadable files are skipped, bounded so a list that has all gone
+        // missing ends instead of spinning
+        int orderIndex = afterOrderIndex;
+        for (int attempt = 0; attempt < static_cast<int>(order_.size()); ++attempt) {
+            orderIndex = followingOrderIndex(orderIndex);
+            if (orderIndex < 0) {
+                break;
+            }
+            if (openDeck(deck, orderIndex)) {
+                return true;
+            }
+        }
+
+        deck = Deck();
+        return false;
+    }
+
+    void PlaylistPlayer::renderDeck(Deck& deck, juce::AudioBuffer<float>& destination, int startSample, int numSamples)
+    {
+        // Both sources pad past the end of the file with silence, so a
+        // deck always delivers exactly its computed length
+        const juce::AudioSourceChannelInfo info(&destination, startSample, numSamples);
+        if (deck.resampler) {
+            deck.resampler->getNextAudioBlock(info);
+        }
+        else {
+            deck.source->getNextAudioBlock(info);
+        }
+        deck.position += numSamples;
+    }
+
+    void PlaylistPlayer::markBoundary(int64_t start, int track)
+    {
+        const int64_t played = playPosition_.load(std::memory_order_acquire);
+        const juce::SpinLock::ScopedLockType lock(boundaryLock_);
+
+        // Keep the track now audible and everything after it
+        while (boundaries_.size() > 1 && boundaries_[1].start <= played) {
+            boundaries_.erase(boundaries_.begin());
+        }
+        boundaries_.push_back({ start, track });
+    }
+
+    bool PlaylistPlayer::fillChunk()
+    {
+        const juce::ScopedLock lock(readLock_);
+
+        if (!current_.isOpen() && pendingOrderIndex_ >= 0) {
+            const int orderIndex = pendingOrderIndex_;
+            pendingOrderIndex_ = -1;
+            if (openDeck(current_, orderIndex) || openFollowing(current_, orderIndex)) {
+                markBoundary(written_, current_.track);
+                openFollowing(next_, current_.orderIndex);
+            }
+        }
+
+        if (!current_.isOpen() || fifo_.getFreeSpace() < ChunkSamples) {
+            return false;
+        }
+
+        int filled = 0;
+        while (filled < ChunkSamples && current_.isOpen()) {
+            const int64_t remaining = current_.length - current_.position;
+            const int64_t fadeLength = next_.isOpen()
+                ? std::min({ crossfadeSamples_, current_.length, next_.length })
+                : 0;
+
+            int count = 0;
+            if (remaining > fadeLength) {
+                count = static_cast<int>(std::min<int64_t>(ChunkSamples - filled, remaining - fadeLength));
+                renderDeck(current_, chunk_, filled, count);
+            }
+            else {
+                // Equal-power crossfade into the next track
+                count = static_cast<int>(std::min<int64_t>(ChunkSamples - filled, remaining));
+                const int64_t fadeStart = fadeLength - remaining;
+                if (next_.position == 0) {
+                    markBoundary(written_ + filled, next_.track);
+                }
+
+                renderDeck(current_, chunk_, filled, count);
+                renderDeck(next_, fadeBuffer_, 0, count);
+
+                for (int channel = 0; channel < Channels; ++channel) {
+                    float* out = chunk_.getWritePointer(channel, filled);
+                    const float* in = fadeBuffer_.getReadPointer(channel);
+                    for (int i = 0; i < count; ++i) {
+                        const double t = (static_cast<double>(fadeStart + i) + 0.5) / static_cast<double>(fadeLength);
+                        const double angle = t * juce::MathConstants<double>::halfPi;
+                        out[i] = out[i] * static_cast<float>(std::cos(angle)) + in[i] * static_cast<float>(std::sin(angle));
+                    }
+                }
+            }
+
+            filled += count;
+
+            if (current_.position >= current_.length) {
+                // Splice: the next track's first (unfaded) sample follows
+                // this one's last
+                const int lastOrderIndex = next_.isOpen() ? next_.orderIndex : current_.orderIndex;
+                current_ = std::move(next_);
+                next_ = Deck();
+
+                if (current_.isOpen()) {
+                    if (current_.position == 0) {
+                        markBoundary(written_ + filled, current_.track);
+                    }
+                    openFollowing(next_, lastOrderIndex);
+                }
+            }
+        }
+
+        int start1, size1, start2, size2;
+        fifo_.prepareToWrite(filled, start1, size1, start2, size2);
+        for (int channel = 0; channel < Channels; ++channel) {
+            if (size1 > 0) {
+                ring_.copyFrom(channel, start1, chunk_, channel, 0, size1);
+            }
+            if (size2 > 0) {
+                ring_.copyFrom(channel, start2, chunk_, channel, size1, size2);
+            }
+        }
+        fifo_.finishedWrite(size1 + size2);
+        written_ += size1 + size2;
+
+        if (!current_.isOpen()) {
+            streamEnd_.store(written_, std::memory_order_release);
+        }
+        return true;
+    }
+
+    // ============================================================================
+    // Audio thread
+    // ============================================================================
+
+    void PlaylistPlayer::prepareToPlay(int samplesPerBlockExpected, double sampleRate)
+    {
+        juce::ignoreUnused(samplesPerBlockExpected);
+
+        // Tracks are decoded for the rate given to loadTracks()
+        if (deviceSampleRate_ > 0.0 && std::abs(sampleRate - deviceSampleRate_) > 0.01) {
+            std::cerr << "PlaylistPlayer: device now runs at " << sampleRate << " Hz, playlist was loaded for "
+                      << deviceSampleRate_ << " Hz" << std::endl;
+        }
+    }
+
+    void PlaylistPlayer::releaseResources()
+    {
+    }
+
+    void PlaylistPlayer::getNextAudioBlock(const juce::AudioSourceChannelInfo& info)
+    {
+        const juce::ScopedLock lock(callbackLock_);
+
+        info.clearActiveBufferRegion();
+        if (!playing_.load(std::memory_order_acquire)) {
+            lastGain_ = 0.0f;   // Next start ramps up from silence
+            return;
+        }
+
+        int start1, size1, start2, size2;
+        fifo_.prepareToRead(info.numSamples, start1, size1, start2, size2);
+
+        const float targetGain = volume_.load(std::memory_order_relaxed);
+        const float midGain = lastGain_ + (targetGain - lastGain_) * size1 / info.numSamples;
+        const float endGain = lastGain_ + (targetGain - lastGain_) * (size1 + size2) / info.numSamples;
+
+        const int channels = std::min(Channels, info.buffer->getNumChannels());
+        for (int channel = 0; channel < channels; ++channel) {
+            if (size1 > 0) {
+                info.buffer->addFromWithRamp(channel, info.startSample,
+                    ring_.getReadPointer(channel, start1), size1, lastGain_, midGain);
+            }
+            if (size2 > 0) {
+                info.buffer->addFromWithRamp(channel, info.startSample + size1,
+                    ring_.getReadPointer(channel, start2), size2, midGain, endGain);
+            }
+        }
+        fifo_.finishedRead(size1 + size2);
+        lastGain_ = endGain;
+
+        const int read = size1 + size2;
+        const int64_t position = playPosition_.load(std::memory_order_relaxed) + read;
+        playPosition_.store(position, std::memory_order_release);
+
+        if (read < info.numSamples) {
+            const int64_t end = streamEnd_.load(std::memory_order_acquire);
+            if (end >= 0 && position >= end) {
+                playing_.store(false, std::memory_order_release);
+            }
+            else {
+                underruns_.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+} // namespace CueForge
@@ -0,0 +1,159 @@
+// ============================================================================
+// PlaylistPlayer.h - Gapless track list voice with optional crossfades
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace CueForge {
+
+    /**
+     * Plays a list of files back to back as one continuous stereo stream.
+     *
+     * The engine's read-ahead thread decodes the tracks into a FIFO at the
+     * device rate, so every splice is decided there on an exact output
+     * sample: the next track's reader is opened while the current one is
+     * still playing, and its first sample follows the current one's last
+     * (or overlaps it by the crossfade length, with an equal-power curve).
+     * The audio callback only ever copies out of the FIFO, so track
+     * boundaries cannot stall it on disk.
+     *
+     * Threads: transport calls from the control thread, getNextAudioBlock()
+     * from the audio thread, useTimeSlice() from the read-ahead thread.
+     * Restarting (stop, skip) only empties the FIFO under the locks; the
+     * read-ahead thread, or play()'s preroll, opens the files again.
+     */
+    class PlaylistPlayer : public juce::AudioSource,
+                           private juce::TimeSliceClient
+    {
+    public:
+        static constexpr int Channels = 2;
+        static constexpr int ChunkSamples = 8192;       // Output samples per read-ahead pass
+        static constexpr double ReadAheadSeconds = 4.0;
+        static constexpr double MaxCrossfadeSeconds = 30.0;
+
+        struct Options
+        {
+            double crossfadeSeconds = 0.0;  // 0 = butt splice
+            bool shuffle = false;           // Reshuffled on every pass when looping
+            bool loop = false;
+            int64_t seed = 0;               // Shuffle seed; 0 picks one
+        };
+
+        PlaylistPlayer(int id, juce::AudioFormatManager& formats, juce::TimeSliceThread& readThread);
+        ~PlaylistPlayer() override;
+
+        // The device rate is needed up front: tracks are converted to it as
+        // they are read so that splices land on exact output samples
+        bool loadTracks(const std::vector<std::string>& filePaths, const Options& options,
+            double deviceSampleRate, std::string* error = nullptr);
+
+        int getId() const { return id_; }
+        int getNumTracks() const { return static_cast<int>(paths_.size()); }
+        std::string getTrackPath(int track) const;
+
+        // Index into the loaded list of the track now audible (the incoming
+        // one from the start of a crossfade), -1 before play or after the end
+        int getCurrentTrack() const;
+
+        void play();
+        void stop();
+        void pause();
+        void resume();
+        bool skipToNext();
+        bool isPlaying() const { return playing_.load(std::memory_order_acquire); }
+        bool isFinished() const;
+
+        void setVolume(float volume);
+        float getVolume() const { return volume_.load(std::memory_order_relaxed); }
+
+        // Seconds of playlist output since play() from the top
+        double getPosition() const;
+
+        // Blocks where the read-ahead fell behind the callback
+        int64_t getUnderruns() const { return underruns_.load(std::memory_order_relaxed); }
+
+        // juce::AudioSource
+        void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
+        void releaseResources() override;
+        void getNextAudioBlock(const juce::AudioSourceChannelInfo& info) override;
+
+    private:
+        // One open track: its reader, a resampler when its rate differs from
+        // the device, and its length and progress in device-rate samples
+        struct Deck
+        {
+            std::unique_ptr<juce::AudioFormatReaderSource> source;
+            std::unique_ptr<juce::ResamplingAudioSource> resampler;
+            int track = -1;
+            int orderIndex = -1;
+            int64_t length = 0;
+            int64_t position = 0;
+
+            bool isOpen() const { return source != nullptr; }
+        };
+
+        struct Boundary
+        {
+            int64_t start;      // Stream sample the track becomes audible
+            int track;
+        };
+
+        int useTimeSlice() override;
+        bool fillChunk();
+        bool openDeck(Deck& deck, int orderIndex);
+        bool openFollowing(Deck& deck, int afterOrderIndex);
+        int followingOrderIndex(int orderIndex);
+        void renderDeck(Deck& deck, juce::AudioBuffer<float>& destination, int startSample, int numSamples);
+        void markBoundary(int64_t start, int track);
+        void shuffleOrder(int avoidFirst);
+        void restartAt(int orderIndex);
+
+        const int id_;
+        juce::AudioFormatManager& formats_;
+        juce::TimeSliceThread& readThread_;
+
+        std::vector<std::string> paths_;
+        Options options_;
+        double deviceSampleRate_ = 0.0;
+        int64_t crossfadeSamples_ = 0;
+
+        // Read-ahead thread state, guarded by readLock_
+        juce::CriticalSection readLock_;
+        std::vector<int> order_;
+        juce::Random random_;
+        Deck current_;
+        Deck next_;
+        int pendingOrderIndex_ = 0;     // Where to open from when no deck is open; -1 none
+        int64_t written_ = 0;           // Stream samples pushed into the FIFO
+        juce::AudioBuffer<float> chunk_;
+        juce::AudioBuffer<float> fadeBuffer_;
+
+        // Shared with the audio thread
+        juce::AbstractFifo fifo_{ 1 };
+        juce::AudioBuffer<float> ring_;
+        std::atomic<int64_t> playPosition_{ 0 };
+        std::atomic<int64_t> streamEnd_{ -1 };  // Total stream length once the last track is read
+
+        mutable juce::SpinLock boundaryLock_;
+        std::vector<Boundary> boundaries_;
+
+        // Audio thread
+        juce::CriticalSection callbackLock_;
+        float lastGain_ = 0.0f;
+
+        std::atomic<bool> playing_{ false };
+        std::atomic<float> volume_{ 1.0f };
+        std::atomic<int64_t> underruns_{ 0 };
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PlaylistPlayer)
+    };
+
+} // namespace CueForge
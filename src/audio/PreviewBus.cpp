@@ -0,0 +1,225 @@
+// ============================================================================
+// PreviewBus.cpp - Low-priority audition bus for headphone previews
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#include "PreviewBus.h"
+#include <algorithm>
+
+namespace CueForge {
+
+    namespace {
+        // Weight of the latest block in the smoothed cost and load
+        constexpr double Smoothing = 0.1;
+    }
+
+    void PreviewBus::prepare(int maxBlockSize, double sampleRate)
+    {
+        scratch_.setSize(Channels, maxBlockSize);
+        mix_.setSize(Channels, maxBlockSize);
+        lastGain_ = 0.0f;
+
+        const ProfiledLock::ScopedLockType lock(lock_);
+        maxBlockSize_ = maxBlockSize;
+        sampleRate_ = sampleRate;
+        prepared_ = true;
+        for (auto& voice : voices_) {
+            if (voice.source != nullptr) {
+                voice.source->prepareToPlay(maxBlockSize, sampleRate);
+                voice.costTicks = 0.0;
+            }
+        }
+    }
+
+    void PreviewBus::release()
+    {
+        const ProfiledLock::ScopedLockType lock(lock_);
+        prepared_ = false;
+        for (auto& voice : voices_) {
+            if (voice.source != nullptr) {
+                voice.source->releaseResources();
+            }
+        }
+    }
+
+    // ============================================================================
+    // Voices
+    // ============================================================================
+
+    bool PreviewBus::addVoice(juce::AudioSource* source)
+    {
+        if (source == nullptr) {
+            return false;
+        }
+
+        int blockSize = 0;
+        double sampleRate = 0.0;
+        {
+            const ProfiledLock::ScopedLockType lock(lock_);
+            const bool full = std::none_of(std::begin(voices_), std::end(voices_),
+                [](const Voice& voice) { return voice.source == nullptr; });
+            if (full || contains(source)) {
+                return false;
+            }
+            if (prepared_) {
+                blockSize = maxBlockSize_;
+                sampleRate = sampleRate_;
+            }
+        }
+
+        // Not yet visible to the callback, so it can be prepared unlocked
+        if (sampleRate > 0.0) {
+            source->prepareToPlay(blockSize, sampleRate);
+        }
+
+        const ProfiledLock::ScopedLockType lock(lock_);
+        for (auto& voice : voices_) {
+            if (voice.source == nullptr) {
+                voice.source = source;
+                voice.order = nextOrder_++;
+                voice.costTicks = 0.0;
+                voiceCount_.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        source->releaseResources();     // Filled up by another thread meanwhile
+        return false;
+    }
+
+    bool PreviewBus::removeVoice(juce::AudioSource* source)
+    {
+        bool removed = false;
+        {
+            const ProfiledLock::ScopedLockType lock(lock_);
+            for (auto& voice : voices_) {
+                if (source != nullptr && voice.source == source) {
+                    voice = Voice();
+                    voiceCount_.fetch_sub(1, std::memory_order_relaxed);
+                    removed = true;
+                }
+            }
+        }
+
+        if (removed) {
+            source->releaseResources();
+        }
+        return removed;
+    }
+
+    bool PreviewBus::contains(juce::AudioSource* source) const
+    {
+        const ProfiledLock::ScopedLockType lock(lock_);
+        return source != nullptr && std::any_of(std::begin(voices_), std::end(voices_),
+            [source](const Voice& voice) { return voice.source == source; });
+    }
+
+    void PreviewBus::clear()
+    {
+        const ProfiledLock::ScopedLockType lock(lock_);
+        for (auto& voice : voices_) {
+            if (voice.source != nullptr) {
+                voice.source->releaseResources();
+                voice = Voice();
+            }
+        }
+        voiceCount_.store(0, std::memory_order_relaxed);
+    }
+
+    void PreviewBus::setOutput(int firstOutput, float gain)
+    {
+        firstOutput_.store(std::max(-1, firstOutput), std::memory_order_relaxed);
+        gain_.store(std::max(0.0f, gain), std::memory_order_relaxed);
+    }
+
+    void PreviewBus::setBudget(double fraction)
+    {
+        budget_.store(juce::jlimit(0.0, 1.0, fraction), std::memory_order_relaxed);
+    }
+
+    PreviewBus::Stats PreviewBus::getStats() const
+    {
+        Stats stats;
+        stats.voices = voiceCount_.load(std::memory_order_relaxed);
+        stats.firstOutput = getFirstOutput();
+        stats.blocksRendered = blocksRendered_.load(std::memory_order_relaxed);
+        stats.blocksShed = blocksShed_.load(std::memory_order_relaxed);
+        stats.voiceBlocksShed = voiceBlocksShed_.load(std::memory_order_relaxed);
+        stats.load = load_.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    // ============================================================================
+    // Audio thread
+    // ============================================================================
+
+    void PreviewBus::process(juce::AudioBuffer<float>& output, int numSamples, int64_t callbackStartTicks)
+    {
+        const int firstOutput = firstOutput_.load(std::memory_order_relaxed);
+        if (voiceCount_.load(std::memory_order_relaxed) == 0 || firstOutput < 0
+            || firstOutput >= output.getNumChannels()) {
+            return;
+        }
+
+        const ProfiledLock::ScopedTryLockType lock(lock_);
+        if (!lock.isLocked() || !prepared_ || numSamples > maxBlockSize_) {
+            blocksShed_.fetch_add(1, std::memory_order_relaxed);
+            voiceBlocksShed_.fetch_add(voiceCount_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            return;
+        }
+
+        const auto startTicks = juce::Time::getHighResolutionTicks();
+        const double ticksPerSecond = static_cast<double>(juce::Time::getHighResolutionTicksPerSecond());
+        const double periodTicks = numSamples / sampleRate_ * ticksPerSecond;
+        const double deadline = static_cast<double>(callbackStartTicks)
+            + budget_.load(std::memory_order_relaxed) * periodTicks;
+
+        // Newest first
+        Voice* order[MaxVoices];
+        int count = 0;
+        for (auto& voice : voices_) {
+            if (voice.source != nullptr) {
+                order[count++] = &voice;
+            }
+        }
+        std::sort(order, order + count, [](const Voice* a, const Voice* b) { return a->order > b->order; });
+
+        mix_.clear(0, numSamples);
+        juce::AudioSourceChannelInfo info(&scratch_, 0, numSamples);
+
+        int rendered = 0;
+        for (; rendered < count; ++rendered) {
+            Voice& voice = *order[rendered];
+            const auto before = juce::Time::getHighResolutionTicks();
+            if (before + voice.costTicks * numSamples >= deadline) {
+                break;      // This voice and every older one sit this block out
+            }
+
+            scratch_.clear(0, numSamples);
+            voice.source->getNextAudioBlock(info);
+            for (int channel = 0; channel < Channels; ++channel) {
+                mix_.addFrom(channel, 0, scratch_, channel, 0, numSamples);
+            }
+
+            const double cost = static_cast<double>(juce::Time::getHighResolutionTicks() - before) / numSamples;
+            voice.costTicks = voice.costTicks == 0.0 ? cost : voice.costTicks + Smoothing * (cost - voice.costTicks);
+        }
+
+        if (rendered < count) {
+            blocksShed_.fetch_add(1, std::memory_order_relaxed);
+            voiceBlocksShed_.fetch_add(count - rendered, std::memory_order_relaxed);
+        }
+        blocksRendered_.fetch_add(1, std::memory_order_relaxed);
+
+        const float gain = gain_.load(std::memory_order_relaxed);
+        for (int channel = 0; channel < Channels && rendered > 0; ++channel) {
+            if (firstOutput + channel < output.getNumChannels()) {
+                output.addFromWithRamp(firstOutput + channel, 0, mix_.getReadPointer(channel), numSamples, lastGain_, gain);
+            }
+        }
+        lastGain_ = gain;
+
+        const double load = static_cast<double>(juce::Time::getHighResolutionTicks() - startTicks) / periodTicks;
+        load_.store(load_.load(std::memory_order_relaxed) * (1.0 - Smoothing) + load * Smoothing, std::memory_order_relaxed);
+    }
+
+} // namespace CueForge
@@ -0,0 +1,117 @@
+// ============================================================================
+// PreviewBus.h - Low-priority audition bus for headphone previews
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include "ProfiledLock.h"
+#include <atomic>
+#include <cstdint>
+
+namespace CueForge {
+
+    /**
+     * A second bus for auditioning cues on headphones while the show runs.
+     *
+     * Preview voices never go through the show mixer. The callback renders
+     * the show first, all the way through the output stage, and only then
+     * this bus, into its own outputs. Each voice is given a slice of the
+     * time left in the block: before rendering one the bus predicts its cost
+     * from the blocks before, and if that would take the callback past
+     * budget * block period the voice, and every voice after it, is shed for
+     * this block. Newest voices render first, so the audition the operator
+     * just started is the last to go. A block where the control thread holds
+     * the lock is shed whole rather than waited for.
+     *
+     * The pool is MaxVoices fixed slots with a scratch buffer allocated in
+     * prepare(), so the audio thread never allocates.
+     *
+     * Threads: addVoice/removeVoice/setOutput/setBudget/getStats from the
+     * control thread, prepare/release with the device stopped, process from
+     * the audio thread.
+     */
+    class PreviewBus
+    {
+    public:
+        static constexpr int MaxVoices = 4;
+        static constexpr int Channels = 2;
+        static constexpr double DefaultBudget = 0.7;
+
+        struct Stats
+        {
+            int voices = 0;
+            int firstOutput = -1;
+            int64_t blocksRendered = 0;
+            int64_t blocksShed = 0;         // Blocks with at least one voice shed
+            int64_t voiceBlocksShed = 0;    // Voices left out, summed over blocks
+            double load = 0.0;              // Fraction of the block period spent on previews
+        };
+
+        PreviewBus() = default;
+
+        // Device thread, audio stopped
+        void prepare(int maxBlockSize, double sampleRate);
+        void release();
+
+        // Control thread. The bus does not own the sources; a removed source
+        // is no longer touched by the audio thread once removeVoice returns.
+        bool addVoice(juce::AudioSource* source);
+        bool removeVoice(juce::AudioSource* source);
+        bool contains(juce::AudioSource* source) const;
+        void clear();
+
+        // Previews play on firstOutput and the one after it; -1 mutes the
+        // bus, and is the default, since the usual device opens only the
+        // show's stereo pair. Gain changes ramp over one block.
+        void setOutput(int firstOutput, float gain);
+        int getFirstOutput() const { return firstOutput_.load(std::memory_order_relaxed); }
+        float getGain() const { return gain_.load(std::memory_order_relaxed); }
+
+        // Fraction of the block period, from the start of the callback, that
+        // may be used before previews are shed. 0 sheds everything.
+        void setBudget(double fraction);
+        double getBudget() const { return budget_.load(std::memory_order_relaxed); }
+
+        Stats getStats() const;
+
+        // Audio thread, after the show bus. callbackStartTicks is
+        // juce::Time::getHighResolutionTicks() at the start of the callback.
+        void process(juce::AudioBuffer<float>& output, int numSamples, int64_t callbackStartTicks);
+
+    private:
+        struct Voice
+        {
+            juce::AudioSource* source = nullptr;
+            int64_t order = 0;          // Higher is newer
+            double costTicks = 0.0;     // Smoothed render time per sample
+        };
+
+        mutable ProfiledLock lock_{ "PreviewBus::lock" };
+        Voice voices_[MaxVoices];       // Guarded by lock_
+        int64_t nextOrder_ = 0;
+        bool prepared_ = false;
+        int maxBlockSize_ = 0;
+        double sampleRate_ = 0.0;
+
+        std::atomic<int> firstOutput_{ -1 };
+        std::atomic<float> gain_{ 1.0f };
+        std::atomic<double> budget_{ DefaultBudget };
+
+        // Audio thread side
+        juce::AudioBuffer<float> scratch_;
+        juce::AudioBuffer<float> mix_;
+        float lastGain_ = 0.0f;
+
+        // Stats
+        std::atomic<int> voiceCount_{ 0 };
+        std::atomic<int64_t> blocksRendered_{ 0 };
+        std::atomic<int64_t> blocksShed_{ 0 };
+        std::atomic<int64_t> voiceBlocksShed_{ 0 };
+        std::atomic<double> load_{ 0.0 };
+
+        JUCE_DECLARE_NON_COPYABLE(PreviewBus)
+    };
+
+} // namespace CueForge
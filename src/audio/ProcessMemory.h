@@ -0,0 +1,54 @@
+// ============================================================================
+// ProcessMemory.h - Resident memory of this process
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#pragma once
+
+#include <fstream>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#elif defined(__APPLE__)
+#include <mach/mach.h>
+#elif defined(__linux__)
+#include <unistd.h>
+#endif
+
+namespace CueForge {
+
+    // Working set / RSS in MB, or -1 where the platform cannot say. Plain
+    // C++, so the Qt tools and the JUCE-only phase 1 targets share it.
+    inline double residentMemoryMb()
+    {
+        constexpr double MB = 1024.0 * 1024.0;
+
+#if defined(_WIN32)
+        PROCESS_MEMORY_COUNTERS counters;
+        if (K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+            return counters.WorkingSetSize / MB;
+        }
+#elif defined(__APPLE__)
+        mach_task_basic_info info;
+        mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+        if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO,
+                reinterpret_cast<task_info_t>(&info), &count) == KERN_SUCCESS) {
+            return info.resident_size / MB;
+        }
+#elif defined(__linux__)
+        std::ifstream statm("/proc/self/statm");
+        long pages = 0;
+        long resident = 0;
+        if (statm >> pages >> resident) {
+            return resident * static_cast<double>(sysconf(_SC_PAGESIZE)) / MB;
+        }
+#endif
+
+        return -1.0;
+    }
+
+} // namespace CueForge
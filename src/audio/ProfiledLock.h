@@ -0,0 +1,106 @@
+// ============================================================================
+// ProfiledLock.h - juce::CriticalSection that reports to LockProfiler
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "LockProfiler.h"
+#include <atomic>
+#include <chrono>
+
+namespace CueForge {
+
+    /**
+     * Drop-in replacement for juce::CriticalSection on engine locks.
+     *
+     * While LockProfiler is enabled each acquisition records its wait time,
+     * the thread that held the lock if it had to wait, and on release the
+     * hold time, under the site name given at construction. Re-entrant like
+     * CriticalSection; only the outermost enter/exit pair is measured.
+     */
+    class ProfiledLock
+    {
+    public:
+        using ScopedLockType = juce::GenericScopedLock<ProfiledLock>;
+        using ScopedUnlockType = juce::GenericScopedUnlock<ProfiledLock>;
+        using ScopedTryLockType = juce::GenericScopedTryLock<ProfiledLock>;
+
+        explicit ProfiledLock(const char* site)
+            : site_(LockProfiler::registerSite(site))
+        {
+        }
+
+        void enter() const noexcept
+        {
+            if (!LockProfiler::isEnabled()) {
+                lock_.enter();
+                ++depth_;
+                return;
+            }
+
+            const int thread = LockProfiler::currentThread();
+            const bool contended = !lock_.tryEnter();
+            int holder = -1;
+            int64_t waitNs = 0;
+
+            if (contended) {
+                holder = owner_.load(std::memory_order_relaxed);
+                const int64_t start = now();
+                lock_.enter();
+                waitNs = now() - start;
+            }
+
+            if (depth_++ == 0) {
+                owner_.store(thread, std::memory_order_relaxed);
+                acquiredNs_ = now();
+                LockProfiler::recordAcquire(site_, thread, waitNs, contended, holder);
+            }
+        }
+
+        bool tryEnter() const noexcept
+        {
+            if (!lock_.tryEnter()) {
+                return false;
+            }
+            if (depth_++ == 0 && LockProfiler::isEnabled()) {
+                const int thread = LockProfiler::currentThread();
+                owner_.store(thread, std::memory_order_relaxed);
+                acquiredNs_ = now();
+                LockProfiler::recordAcquire(site_, thread, 0, false, -1);
+            }
+            return true;
+        }
+
+        void exit() const noexcept
+        {
+            if (--depth_ == 0) {
+                if (acquiredNs_ != 0) {
+                    LockProfiler::recordRelease(site_, owner_.load(std::memory_order_relaxed), now() - acquiredNs_);
+                    acquiredNs_ = 0;
+                }
+                owner_.store(-1, std::memory_order_relaxed);
+            }
+            lock_.exit();
+        }
+
+    private:
+        static int64_t now() noexcept
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        juce::CriticalSection lock_;
+        const int site_;
+
+        // Guarded by lock_, except owner_ which waiters read for attribution
+        mutable std::atomic<int> owner_{ -1 };
+        mutable int depth_ = 0;
+        mutable int64_t acquiredNs_ = 0;
+
+        JUCE_DECLARE_NON_COPYABLE(ProfiledLock)
+    };
+
+} // namespace CueForge
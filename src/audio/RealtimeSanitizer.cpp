@@ -0,0 +1,628 @@
+// ============================================================================
+// RealtimeSanitizer.cpp - Flags allocations, locks and blocking calls made on
+// real-time threads (opt-in, CUEFORGE_RT_SANITIZER builds only)
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+// The interposed stdio and file functions must not collide with the
+// fortified inline wrappers glibc provides when _FORTIFY_SOURCE is on
+#ifdef _FORTIFY_SOURCE
+#undef _FORTIFY_SOURCE
+#endif
+
+#include "RealtimeSanitizer.h"
+
+#if CUEFORGE_RT_SANITIZER
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <new>
+
+#if defined(__GLIBC__)
+#define CUEFORGE_RT_INTERPOSE_LIBC 1
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <time.h>
+#include <unistd.h>
+#elif defined(__APPLE__)
+#include <cxxabi.h>
+#include <execinfo.h>
+#elif defined(_WIN32)
+#include <windows.h>
+#endif
+
+namespace CueForge {
+
+    namespace {
+        constexpr int MaxFrames = 32;
+        constexpr int MaxRecords = 512;
+
+        // Filled on the offending thread without allocating; symbolized later
+        struct Record
+        {
+            std::atomic<bool> ready{ false };
+            RealtimeSanitizer::Kind kind = RealtimeSanitizer::Allocation;
+            const char* function = nullptr;
+            const char* scope = nullptr;
+            int frameCount = 0;
+            void* frames[MaxFrames];
+        };
+
+        Record records[MaxRecords];
+        std::atomic<int> recordCount{ 0 };
+        std::atomic<uint64_t> kindCounts[3];
+        std::atomic<uint32_t> enabledChecks{ RealtimeSanitizer::AllKinds };
+        std::atomic<bool> abortOnViolation{ false };
+
+        // Plain thread_locals - no dynamic initialisation, so reading them
+        // from inside malloc cannot recurse
+        thread_local int realtimeDepth = 0;
+        thread_local int allowDepth = 0;
+        thread_local bool reporting = false;
+        thread_local const char* currentScope = nullptr;
+
+        int kindIndex(RealtimeSanitizer::Kind kind)
+        {
+            return kind == RealtimeSanitizer::Allocation ? 0 : kind == RealtimeSanitizer::Lock ? 1 : 2;
+        }
+
+        const char* kindName(RealtimeSanitizer::Kind kind)
+        {
+            return kind == RealtimeSanitizer::Allocation ? "allocation"
+                 : kind == RealtimeSanitizer::Lock ? "lock" : "blocking call";
+        }
+
+        int captureStack(void** frames, int maxFrames)
+        {
+#if defined(__GLIBC__) || defined(__APPLE__)
+            return backtrace(frames, maxFrames);
+#elif defined(_WIN32)
+            return static_cast<int>(CaptureStackBackTrace(0, static_cast<DWORD>(maxFrames), frames, nullptr));
+#else
+            (void)frames;
+            (void)maxFrames;
+            return 0;
+#endif
+        }
+
+        std::vector<std::string> symbolize(void* const* frames, int count)
+        {
+            std::vector<std::string> lines;
+#if defined(__GLIBC__) || defined(__APPLE__)
+            char** symbols = backtrace_symbols(frames, count);
+            for (int i = 0; i < count; ++i) {
+                std::string line = symbols ? symbols[i] : "?";
+
+                // "binary(_ZN8CueForge...+0x1f) [0x...]" -> demangled name
+                const size_t open = line.find('(');
+                const size_t plus = line.find('+', open);
+                if (open != std::string::npos && plus != std::string::npos && plus > open + 1) {
+                    int status = 0;
+                    char* demangled = abi::__cxa_demangle(line.substr(open + 1, plus - open - 1).c_str(),
+                        nullptr, nullptr, &status);
+                    if (status == 0 && demangled) {
+                        line = std::string(demangled) + "  " + line;
+                    }
+                    std::free(demangled);
+                }
+
+                if (line.find("RealtimeSanitizer") == std::string::npos) {
+                    lines.push_back(line);
+                }
+            }
+            std::free(symbols);
+#else
+            for (int i = 0; i < count; ++i) {
+                char address[32];
+                std::snprintf(address, sizeof(address), "%p", frames[i]);
+                lines.push_back(address);
+            }
+#endif
+            return lines;
+        }
+
+        struct Startup
+        {
+            Startup()
+            {
+                const char* value = std::getenv("CUEFORGE_RT_SANITIZER_ABORT");
+                abortOnViolation.store(value && value[0] == '1');
+
+                // First backtrace() loads the unwinder, which allocates
+                void* frames[1];
+                captureStack(frames, 1);
+            }
+        };
+
+        Startup startup;
+    }
+
+    // ============================================================================
+    // Scopes
+    // ============================================================================
+
+    RealtimeSanitizer::ScopedRealtime::ScopedRealtime(const char* name)
+        : previous_(currentScope)
+    {
+        currentScope = name;
+        ++realtimeDepth;
+    }
+
+    RealtimeSanitizer::ScopedRealtime::~ScopedRealtime()
+    {
+        --realtimeDepth;
+        currentScope = previous_;
+    }
+
+    RealtimeSanitizer::ScopedAllow::ScopedAllow()
+    {
+        ++allowDepth;
+    }
+
+    RealtimeSanitizer::ScopedAllow::~ScopedAllow()
+    {
+        --allowDepth;
+    }
+
+    // ============================================================================
+    // Recording
+    // ============================================================================
+
+    void RealtimeSanitizer::check(Kind kind, const char* function)
+    {
+        if (realtimeDepth == 0 || allowDepth > 0 || reporting) {
+            return;
+        }
+        if ((enabledChecks.load(std::memory_order_relaxed) & kind) == 0) {
+            return;
+        }
+
+        // Anything the recording itself calls must not be reported again
+        reporting = true;
+
+        kindCounts[kindIndex(kind)].fetch_add(1, std::memory_order_relaxed);
+
+        const int slot = recordCount.fetch_add(1, std::memory_order_relaxed);
+        if (slot < MaxRecords) {
+            Record& record = records[slot];
+            record.kind = kind;
+            record.function = function;
+            record.scope = currentScope;
+            record.frameCount = captureStack(record.frames, MaxFrames);
+            record.ready.store(true, std::memory_order_release);
+        }
+
+        if (abortOnViolation.load(std::memory_order_relaxed)) {
+            std::fprintf(stderr, "RealtimeSanitizer: %s '%s' in real-time scope '%s'\n",
+                kindName(kind), function, currentScope ? currentScope : "?");
+            void* frames[MaxFrames];
+            const int count = captureStack(frames, MaxFrames);
+            for (const std::string& line : symbolize(frames, count)) {
+                std::fprintf(stderr, "    %s\n", line.c_str());
+            }
+            std::abort();
+        }
+
+        reporting = false;
+    }
+
+    void RealtimeSanitizer::setChecks(uint32_t kinds)
+    {
+        enabledChecks.store(kinds & AllKinds, std::memory_order_relaxed);
+    }
+
+    void RealtimeSanitizer::setAbortOnViolation(bool shouldAbort)
+    {
+        abortOnViolation.store(shouldAbort, std::memory_order_relaxed);
+    }
+
+    uint64_t RealtimeSanitizer::violationCount(uint32_t kinds)
+    {
+        uint64_t total = 0;
+        if (kinds & Allocation) total += kindCounts[0].load(std::memory_order_relaxed);
+        if (kinds & Lock) total += kindCounts[1].load(std::memory_order_relaxed);
+        if (kinds & Blocking) total += kindCounts[2].load(std::memory_order_relaxed);
+        return total;
+    }
+
+    std::vector<RealtimeSanitizer::Violation> RealtimeSanitizer::describeViolations()
+    {
+        std::vector<Violation> violations;
+        std::map<std::string, size_t> seen;
+
+        const int count = std::min(recordCount.load(std::memory_order_acquire), MaxRecords);
+        for (int i = 0; i < count; ++i) {
+            const Record& record = records[i];
+            if (!record.ready.load(std::memory_order_acquire)) {
+                continue;
+            }
+
+            // Group identical call sites so a per-block hit prints once
+            std::string key = record.function;
+            for (int f = 0; f < record.frameCount; ++f) {
+                char address[32];
+                std::snprintf(address, sizeof(address), ":%p", record.frames[f]);
+                key += address;
+            }
+
+            auto it = seen.find(key);
+            if (it != seen.end()) {
+                violations[it->second].occurrences++;
+                continue;
+            }
+
+            Violation violation;
+            violation.kind = record.kind;
+            violation.function = record.function;
+            violation.scope = record.scope ? record.scope : "";
+            violation.stack = symbolize(record.frames, record.frameCount);
+            violation.occurrences = 1;
+
+            seen[key] = violations.size();
+            violations.push_back(std::move(violation));
+        }
+
+        return violations;
+    }
+
+    void RealtimeSanitizer::reset()
+    {
+        const int count = std::min(recordCount.load(std::memory_order_acquire), MaxRecords);
+        for (int i = 0; i < count; ++i) {
+            records[i].ready.store(false, std::memory_order_relaxed);
+        }
+        recordCount.store(0, std::memory_order_release);
+        for (auto& counter : kindCounts) {
+            counter.store(0, std::memory_order_relaxed);
+        }
+    }
+
+} // namespace CueForge
+
+// ============================================================================
+// Interposed functions
+// ============================================================================
+
+using CueForge::RealtimeSanitizer;
+
+#if CUEFORGE_RT_INTERPOSE_LIBC
+
+// glibc exports its allocator under these names, so the wrappers can call
+// through without dlsym (which itself allocates)
+extern "C" {
+    void* __libc_malloc(size_t size);
+    void* __libc_calloc(size_t count, size_t size);
+    void* __libc_realloc(void* pointer, size_t size);
+    void* __libc_memalign(size_t alignment, size_t size);
+    void __libc_free(void* pointer);
+}
+
+namespace {
+    // Resolved lazily without function-local statics: a static guard can
+    // itself take a pthread mutex and recurse into the wrapper
+    void* nextSymbol(std::atomic<void*>& cache, const char* name, const char* version = nullptr)
+    {
+        void* symbol = cache.load(std::memory_order_relaxed);
+        if (!symbol) {
+            if (version) {
+                symbol = dlvsym(RTLD_NEXT, name, version);
+            }
+            if (!symbol) {
+                symbol = dlsym(RTLD_NEXT, name);
+            }
+            cache.store(symbol, std::memory_order_relaxed);
+        }
+        return symbol;
+    }
+
+#define CUEFORGE_RT_NEXT(name, ...) \
+    static std::atomic<void*> cache_##name{ nullptr }; \
+    const auto real_##name = reinterpret_cast<decltype(&name)>(nextSymbol(cache_##name, #name, ##__VA_ARGS__))
+}
+
+extern "C" {
+
+    // --- Allocation ---------------------------------------------------------
+
+    void* malloc(size_t size) noexcept
+    {
+        RealtimeSanitizer::check(RealtimeSanitizer::Allocation, "malloc");
+        return __libc_malloc(size);
+    }
+
+    void* calloc(size_t count, size_t size) noexcept
+    {
+        RealtimeSanitizer::check(RealtimeSanitizer::Allocation, "calloc");
+        return __libc_calloc(count, size);
+    }
+
+    void* realloc(void* pointer, size_t size) noexcept
+    {
+        RealtimeSanitizer::check(RealtimeSanitizer::Allocation, "realloc");
+        return __libc_realloc(pointer, size);
+    }
+
+    void free(void* pointer) noexcept
+    {
+        if (pointer) {
+            RealtimeSanitizer::check(RealtimeSanitizer::Allocation, "free");
+        }
+        __libc_free(pointer);
+    }
+
+    void* memalign(size_t alignment, size_t size) noexcept
+    {
+        RealtimeSanitizer::check(RealtimeSanitizer::Allocation, "memalign");
+        return __libc_memalign(alignment, size);
+    }
+
+    void* aligned_alloc(size_t alignment, size_t size) noexcept
+    {
+        RealtimeSanitizer::check(RealtimeSanitizer::Allocation, "aligned_alloc");
+        return __libc_memalign(alignment, size);
+    }
+
+    int posix_memalign(void** result, size_t alignment, size_t size) noexcept
+    {
+        RealtimeSanitizer::check(RealtimeSanitizer::Allocation, "posix_memalign");
+        if (alignment % sizeof(void*) != 0 || (alignment & (alignment - 1)) != 0) {
+            return EINVAL;
+        }
+        void* pointer = __libc_memalign(alignment, size);
+        if (!pointer) {
+            return ENOMEM;
+        }
+        *result = pointer;
+        return 0;
+    }
+
+    // --- Locks --------------------------------------------------------------
+
+    int pthread_mutex_lock(pthread_mutex_t* mutex) noexcept
+    {
+        CUEFORGE_RT_NEXT(pthread_mutex_lock);
+        RealtimeSanitizer::check(RealtimeSanitizer::Lock, "pthread_mutex_lock");
+        return real_pthread_mutex_lock(mutex);
+    }
+
+    int pthread_rwlock_rdlock(pthread_rwlock_t* lock) noexcept
+    {
+        CUEFORGE_RT_NEXT(pthread_rwlock_rdlock);
+        RealtimeSanitizer::check(RealtimeSanitizer::Lock, "pthread_rwlock_rdlock");
+        return real_pthread_rwlock_rdlock(lock);
+    }
+
+    int pthread_rwlock_wrlock(pthread_rwlock_t* lock) noexcept
+    {
+        CUEFORGE_RT_NEXT(pthread_rwlock_wrlock);
+        RealtimeSanitizer::check(RealtimeSanitizer::Lock, "pthread_rwlock_wrlock");
+        return real_pthread_rwlock_wrlock(lock);
+    }
+
+    // --- Blocking calls -----------------------------------------------------
+
+    int pthread_cond_wait(pthread_cond_t* condition, pthread_mutex_t* mutex)
+    {
+        // The unversioned symbol is the pre-2.3.2 compatibility implementation
+        CUEFORGE_RT_NEXT(pthread_cond_wait, "GLIBC_2.3.2");
+        RealtimeSanitizer::check(RealtimeSanitizer::Blocking, "pthread_cond_wait");
+        return real_pthread_cond_wait(condition, mutex);
+    }
+
+    int pthread_cond_timedwait(pthread_cond_t* condition, pthread_mutex_t* mutex, const struct timespec* until)
+    {
+        CUEFORGE_RT_NEXT(pthread_cond_timedwait, "GLIBC_2.3.2");
+        RealtimeSanitizer::check(RealtimeSanitizer::Blocking, "pthread_cond_timedwait");
+        return real_pthread_cond_timedwait(condition, mutex, until);
+    }
+
+    int pthread_join(pthread_t thread, void** result)
+    {
+        CUEFORGE_RT_NEXT(pthread_join);
+        RealtimeSanitizer::check(RealtimeSanitizer::Blocking, "pthread_join");
+        return real_pthread_join(thread, result);
+    }
+
+    int sem_wait(sem_t* semaphore)
+    {
+        CUEFORGE_RT_NEXT(sem_wait);
+        RealtimeSanitizer::check(RealtimeSanitizer::Blocking, "sem_wait");
+        return real_sem_wait(semaphore);
+    }
+
+    int nanosleep(const struct timespec* duration, struct timespec* remaining)
+    {
+        CUEFORGE_RT_NEXT(nanosleep);
+        RealtimeSanitizer::check(RealtimeSanitizer::Blocking, "nanosleep");
+        return real_nanosleep(duration, remaining);
+    }
+
+    int usleep(useconds_t microseconds)
+    {
+        CUEFORGE_RT_NEXT(usleep);
+        RealtimeSanitizer::check(RealtimeSanitizer::Blocking, "usleep");
+        return real_usleep(microseconds);
+    }
+
+    int open(const char* path, int flags, ...)
+    {
+        CUEFORGE_RT_NEXT(open);
+        RealtimeSanitizer::check(RealtimeSanitizer::Blocking, "open");
+
+        mode_t mode = 0;
+        if (flags & (O_CREAT | O_TMPFILE)) {
+            va_list args;
+            va_start(args, flags);
+            mode = static_cast<mode_t>(va_arg(args, int));
+            va_end(args);
+        }
+        return real_open(path, flags, mode);
+    }
+
+    int close(int fd)
+    {
+        CUEFORGE_RT_NEXT(close);
+        RealtimeSanitizer::check(RealtimeSanitizer::Blocking, "close");
+        return real_close(fd);
+    }
+
+    ssize_t read(int fd, void* buffer, size_t count)
+    {
+        CUEFORGE_RT_NEXT(read);
+        RealtimeSanitizer::check(RealtimeSanitizer::Blocking, "read");
+        return real_read(fd, buffer, count);
+    }
+
+    ssize_t write(int fd, const void* buffer, size_t count)
+    {
+        CUEFORGE_RT_NEXT(write);
+        RealtimeSanitizer::check(RealtimeSanitizer::Blocking, "write");
+        return real_write(fd, buffer, count);
+    }
+
+    int fsync(int fd)
+    {
+        CUEFORGE_RT_NEXT(fsync);
+        RealtimeSanitizer::check(RealtimeSanitizer::Blocking, "fsync");
+        return real_fsync(fd);
+    }
+
+    // glibc's stdio calls its internal write directly, so std::cout and
+    // printf are caught at the stdio entry points instead
+
+    size_t fwrite(const void* data, size_t size, size_t count, FILE* stream)
+    {
+        CUEFORGE_RT_NEXT(fwrite);
+        RealtimeSanitizer::check(RealtimeSanitizer::Blocking, "fwrite");
+        return real_fwrite(data, size, count, stream);
+    }
+
+    int fputs(const char* text, FILE* stream)
+    {
+        CUEFORGE_RT_NEXT(fputs);
+        RealtimeSanitizer::check(RealtimeSanitizer::Blocking, "fputs");
+        return real_fputs(text, stream);
+    }
+
+    int puts(const char* text)
+    {
+        CUEFORGE_RT_NEXT(puts);
+        RealtimeSanitizer::check(RealtimeSanitizer::Blocking, "puts");
+        return real_puts(text);
+    }
+
+    int fputc(int c, FILE* stream)
+    {
+        CUEFORGE_RT_NEXT(fputc);
+        RealtimeSanitizer::check(RealtimeSanitizer::Blocking, "fputc");
+        return real_fputc(c, stream);
+    }
+
+#ifdef putc
+#undef putc
+#endif
+    int putc(int c, FILE* stream)
+    {
+        CUEFORGE_RT_NEXT(putc);
+        RealtimeSanitizer::check(RealtimeSanitizer::Blocking, "putc");
+        return real_putc(c, stream);
+    }
+
+    int fflush(FILE* stream)
+    {
+        CUEFORGE_RT_NEXT(fflush);
+        RealtimeSanitizer::check(RealtimeSanitizer::Blocking, "fflush");
+        return real_fflush(stream);
+    }
+
+    int vfprintf(FILE* stream, const char* format, va_list args)
+    {
+        CUEFORGE_RT_NEXT(vfprintf);
+        RealtimeSanitizer::check(RealtimeSanitizer::Blocking, "vfprintf");
+        return real_vfprintf(stream, format, args);
+    }
+
+    int fprintf(FILE* stream, const char* format, ...)
+    {
+        CUEFORGE_RT_NEXT(vfprintf);
+        RealtimeSanitizer::check(RealtimeSanitizer::Blocking, "fprintf");
+        va_list args;
+        va_start(args, format);
+        const int result = real_vfprintf(stream, format, args);
+        va_end(args);
+        return result;
+    }
+
+    int printf(const char* format, ...)
+    {
+        CUEFORGE_RT_NEXT(vfprintf);
+        RealtimeSanitizer::check(RealtimeSanitizer::Blocking, "printf");
+        va_list args;
+        va_start(args, format);
+        const int result = real_vfprintf(stdout, format, args);
+        va_end(args);
+        return result;
+    }
+
+} // extern "C"
+
+#else
+
+// Without libc interposition, C++ allocations are still caught here
+
+void* operator new(std::size_t size)
+{
+    RealtimeSanitizer::check(RealtimeSanitizer::Allocation, "operator new");
+    if (void* pointer = std::malloc(size ? size : 1)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    RealtimeSanitizer::check(RealtimeSanitizer::Allocation, "operator new[]");
+    if (void* pointer = std::malloc(size ? size : 1)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept
+{
+    if (pointer) {
+        RealtimeSanitizer::check(RealtimeSanitizer::Allocation, "operator delete");
+    }
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+    if (pointer) {
+        RealtimeSanitizer::check(RealtimeSanitizer::Allocation, "operator delete[]");
+    }
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    operator delete(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept
+{
+    operator delete[](pointer);
+}
+
+#endif // CUEFORGE_RT_INTERPOSE_LIBC
+
+#endif // CUEFORGE_RT_SANITIZER
@@ -0,0 +1,106 @@
+// ============================================================================
+// RealtimeSanitizer.h - Flags allocations, locks and blocking calls made on
+// real-time threads (opt-in, CUEFORGE_RT_SANITIZER builds only)
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace CueForge {
+
+    /**
+     * Debug instrumentation that proves the callback path is real-time safe.
+     *
+     * Code that must never block marks itself with a ScopedRealtime. In a
+     * CUEFORGE_RT_SANITIZER build, malloc/free, mutex locks and blocking
+     * calls (stdio, file I/O, sleeps, condition waits, joins) made while a
+     * scope is active are recorded with a raw stack trace. Traces are
+     * captured without allocating and symbolized later, off the audio
+     * thread, by describeViolations().
+     *
+     * Coverage: Linux/glibc interposes the C allocator, pthread locks and
+     * blocking calls. Other platforms replace the global operator new and
+     * delete only.
+     *
+     * In normal builds every member is an inline no-op.
+     */
+    class RealtimeSanitizer
+    {
+    public:
+        enum Kind : uint32_t {
+            Allocation = 1u << 0,
+            Lock       = 1u << 1,
+            Blocking   = 1u << 2,
+            AllKinds   = Allocation | Lock | Blocking
+        };
+
+        struct Violation
+        {
+            Kind kind;
+            std::string function;          // Intercepted call, e.g. "malloc"
+            std::string scope;             // Innermost ScopedRealtime name
+            std::vector<std::string> stack;
+            int occurrences;               // Identical call site and stack
+        };
+
+        // Marks the current thread real-time for the lifetime of the scope
+        class ScopedRealtime
+        {
+        public:
+#if CUEFORGE_RT_SANITIZER
+            explicit ScopedRealtime(const char* name);
+            ~ScopedRealtime();
+        private:
+            const char* previous_;
+#else
+            explicit ScopedRealtime(const char*) {}
+#endif
+            ScopedRealtime(const ScopedRealtime&) = delete;
+            ScopedRealtime& operator=(const ScopedRealtime&) = delete;
+        };
+
+        // Suspends checking inside a real-time scope for a reviewed exception
+        class ScopedAllow
+        {
+        public:
+#if CUEFORGE_RT_SANITIZER
+            ScopedAllow();
+            ~ScopedAllow();
+#else
+            ScopedAllow() {}
+#endif
+            ScopedAllow(const ScopedAllow&) = delete;
+            ScopedAllow& operator=(const ScopedAllow&) = delete;
+        };
+
+#if CUEFORGE_RT_SANITIZER
+        static constexpr bool isCompiledIn() { return true; }
+
+        // Which kinds are recorded (default AllKinds)
+        static void setChecks(uint32_t kinds);
+        // Print and abort on the first recorded violation (default off, or
+        // CUEFORGE_RT_SANITIZER_ABORT=1 in the environment)
+        static void setAbortOnViolation(bool shouldAbort);
+
+        static uint64_t violationCount(uint32_t kinds = AllKinds);
+        static std::vector<Violation> describeViolations();
+        static void reset();
+
+        // Called by the interposed functions
+        static void check(Kind kind, const char* function);
+#else
+        static constexpr bool isCompiledIn() { return false; }
+        static void setChecks(uint32_t) {}
+        static void setAbortOnViolation(bool) {}
+        static uint64_t violationCount(uint32_t = AllKinds) { return 0; }
+        static std::vector<Violation> describeViolations() { return {}; }
+        static void reset() {}
+        static void check(Kind, const char*) {}
+#endif
+    };
+
+} // namespace CueForge
@@ -0,0 +1,96 @@
+// ============================================================================
+// RealtimeSnapshot.h - Control-built state handed to the audio thread lock-free
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <atomic>
+#include <memory>
+
+namespace CueForge {
+
+    /**
+     * Publishes an object built on the control thread to the audio thread
+     * without the audio thread ever taking a lock.
+     *
+     * The audio thread borrows the current object for one block through
+     * ScopedAccess, which takes it out of the slot and puts it back.
+     * publish() swaps a replacement in; if the audio thread has the old one
+     * borrowed it yields until it is put back, which is at most one block,
+     * or no time at all with the device stopped. Once publish() returns the
+     * audio thread can no longer reach the old object, so it is returned to
+     * be freed on the control thread.
+     *
+     * One audio thread reads; publishers must be serialised by the caller,
+     * which may read current() under the same serialisation.
+     */
+    template <typename T>
+    class RealtimeSnapshot
+    {
+    public:
+        RealtimeSnapshot()
+            : owned_(std::make_unique<T>())
+            , slot_(owned_.get())
+        {
+        }
+
+        // Audio thread, for the length of one block
+        class ScopedAccess
+        {
+        public:
+            explicit ScopedAccess(RealtimeSnapshot& snapshot)
+                : snapshot_(snapshot)
+                , object_(snapshot.slot_.exchange(nullptr, std::memory_order_acquire))
+            {
+            }
+
+            ~ScopedAccess()
+            {
+                snapshot_.slot_.store(object_, std::memory_order_release);
+            }
+
+            T& operator*() const { return *object_; }
+            T* operator->() const { return object_; }
+
+        private:
+            RealtimeSnapshot& snapshot_;
+            T* const object_;
+
+            JUCE_DECLARE_NON_COPYABLE(ScopedAccess)
+        };
+
+        // Control thread
+        const T& current() const { return *owned_; }
+
+        std::unique_ptr<T> publish(std::unique_ptr<T> next)
+        {
+            swapIn(next.get());
+            std::swap(owned_, next);
+            return next;
+        }
+
+        // Returns once any block that could see current() has finished
+        void sync()
+        {
+            swapIn(owned_.get());
+        }
+
+    private:
+        void swapIn(T* next)
+        {
+            T* expected = owned_.get();
+            while (!slot_.compare_exchange_weak(expected, next, std::memory_order_acq_rel)) {
+                expected = owned_.get();
+                juce::Thread::yield();
+            }
+        }
+
+        std::unique_ptr<T> owned_;
+        std::atomic<T*> slot_;
+
+        JUCE_DECLARE_NON_COPYABLE(RealtimeSnapshot)
+    };
+
+} // namespace CueForge
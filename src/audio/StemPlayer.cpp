@@ -0,0 +1,407 @@
+// ============================================================================
+// StemPlayer.cpp - Sample-locked multitrack voice with shared read-ahead
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#include "StemPlayer.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace CueForge {
+
+    StemPlayer::StemPlayer(int id, juce::AudioFormatManager& formats, juce::TimeSliceThread& readThread)
+        : id_(id)
+        , formats_(formats)
+        , readThread_(readThread)
+    {
+    }
+
+    StemPlayer::~StemPlayer()
+    {
+        // Waits for a slice in progress on this player to finish
+        readThread_.removeTimeSliceClient(this);
+    }
+
+    bool StemPlayer::loadFiles(const std::vector<std::string>& filePaths, std::string* error)
+    {
+        auto fail = [error](const std::string& message) {
+            std::cerr << "StemPlayer: " << message << std::endl;
+            if (error) {
+                *error = message;
+            }
+            return false;
+        };
+
+        readThread_.removeTimeSliceClient(this);
+        stems_.clear();
+        totalChannels_ = 0;
+        length_ = 0;
+        fileSampleRate_ = 0.0;
+
+        if (filePaths.empty() || static_cast<int>(filePaths.size()) > MaxStems) {
+            return fail("Need 1 to " + std::to_string(MaxStems) + " stems");
+        }
+
+        for (const std::string& path : filePaths) {
+            juce::File file(path);
+            if (!file.existsAsFile()) {
+                return fail("File not found: " + path);
+            }
+
+            std::unique_ptr<juce::AudioFormatReader> reader(formats_.createReaderFor(file));
+            if (!reader) {
+                return fail("Could not create reader for: " + path);
+            }
+
+            if (fileSampleRate_ == 0.0) {
+                fileSampleRate_ = reader->sampleRate;
+            }
+            else if (std::abs(reader->sampleRate - fileSampleRate_) > 0.01) {
+                // One resampler drives every stem; mixed rates would drift
+                return fail("Stem " + path + " is " + std::to_string(static_cast<int>(reader->sampleRate))
+                    + " Hz, expected " + std::to_string(static_cast<int>(fileSampleRate_)) + " Hz");
+            }
+
+            Stem stem;
+            stem.channels = juce::jlimit(1, MaxStemChannels, static_cast<int>(reader->numChannels));
+            stem.firstChannel = totalChannels_;
+            stem.path = path;
+            totalChannels_ += stem.channels;
+            length_ = std::max<int64_t>(length_, reader->lengthInSamples);
+            stem.reader = std::move(reader);
+            stems_.push_back(std::move(stem));
+        }
+
+        // Read-ahead ring: every stem channel, same index for all of them
+        const int ringSize = std::max(2 * ChunkSamples + 1,
+            static_cast<int>(fileSampleRate_ * ReadAheadSeconds));
+        fifo_.setTotalSize(ringSize);
+        ring_.setSize(totalChannels_, ringSize);
+        ring_.clear();
+        readPosition_ = 0;
+        playPosition_.store(0, std::memory_order_release);
+
+        readThread_.addTimeSliceClient(this);
+
+        std::cout << "Loaded " << stems_.size() << " stems (" << totalChannels_ << " channels, "
+                  << getDuration() << " seconds)" << std::endl;
+        return true;
+    }
+
+    int StemPlayer::getStemChannels(int stem) const
+    {
+        return (stem >= 0 && stem < getNumStems()) ? stems_[stem].channels : 0;
+    }
+
+    std::string StemPlayer::getStemPath(int stem) const
+    {
+        return (stem >= 0 && stem < getNumStems()) ? stems_[stem].path : std::string();
+    }
+
+    // ============================================================================
+    // Routing
+    // ============================================================================
+
+    void StemPlayer::setDefaultRoutes(int numOutputs)
+    {
+        const juce::ScopedLock lock(callbackLock_);
+
+        routes_.clear();
+        for (const Stem& stem : stems_) {
+            if (stem.channels == 1) {
+                // Centre-panned at equal power
+                const float gain = numOutputs > 1 ? juce::MathConstants<float>::sqrt2 * 0.5f : 1.0f;
+                for (int output = 0; output < std::min(2, numOutputs); ++output) {
+                    routes_.push_back({ stem.firstChannel, output, gain });
+                }
+            }
+            else {
+                for (int channel = 0; channel < std::min(stem.channels, numOutputs); ++channel) {
+                    routes_.push_back({ stem.firstChannel + channel, channel, 1.0f });
+                }
+            }
+        }
+    }
+
+    bool StemPlayer::setRoute(int stem, int stemChannel, int output, float gain)
+    {
+        if (stem < 0 || stem >= getNumStems() || stemChannel < 0
+            || stemChannel >= stems_[stem].channels || output < 0) {
+            return false;
+        }
+
+        const int channel = stems_[stem].firstChannel + stemChannel;
+        const juce::ScopedLock lock(callbackLock_);
+
+        auto it = std::find_if(routes_.begin(), routes_.end(), [channel, output](const Route& route) {
+            return route.channel == channel && route.output == output;
+        });
+
+        if (gain <= 0.0f) {
+            if (it != routes_.end()) {
+                routes_.erase(it);
+            }
+        }
+        else if (it != routes_.end()) {
+            it->gain = gain;
+        }
+        else {
+            routes_.push_back({ channel, output, gain });
+        }
+        return true;
+    }
+
+    void StemPlayer::clearRoutes(int stem)
+    {
+        if (stem < 0 || stem >= getNumStems()) {
+            return;
+        }
+
+        const int first = stems_[stem].firstChannel;
+        const int last = first + stems_[stem].channels;
+        const juce::ScopedLock lock(callbackLock_);
+
+        routes_.erase(std::remove_if(routes_.begin(), routes_.end(), [first, last](const Route& route) {
+            return route.channel >= first && route.channel < last;
+        }), routes_.end());
+    }
+
+    // ============================================================================
+    // Transport
+    // ============================================================================
+
+    void StemPlayer::play()
+    {
+        if (stems_.empty()) {
+            return;
+        }
+
+        // Preroll: the first block must find every stem's samples already
+        // in the ring, or the stems would start on different blocks
+        while (fifo_.getNumReady() < ChunkSamples && fillChunk()) {
+        }
+
+        playing_.store(true, std::memory_order_release);
+    }
+
+    void StemPlayer::stop()
+    {
+        playing_.store(false, std::memory_order_release);
+        setPosition(0.0);
+    }
+
+    void StemPlayer::pause()
+    {
+        playing_.store(false, std::memory_order_release);
+    }
+
+    void StemPlayer::resume()
+    {
+        if (stems_.empty() || isFinished()) {
+            return;
+        }
+        play();
+    }
+
+    bool StemPlayer::isFinished() const
+    {
+        return !isPlaying() && length_ > 0
+            && playPosition_.load(std::memory_order_acquire) >= length_;
+    }
+
+    void StemPlayer::setVolume(float volume)
+    {
+        volume_.store(juce::jlimit(0.0f, 1.0f, volume), std::memory_order_relaxed);
+    }
+
+    void StemPlayer::setPosition(double seconds)
+    {
+        if (fileSampleRate_ <= 0.0) {
+            return;
+        }
+
+        const int64_t target = juce::jlimit<int64_t>(0, length_,
+            static_cast<int64_t>(seconds * fileSampleRate_));
+
+        // Callback first, then read-ahead: neither can touch the ring while
+        // it is emptied and repositioned
+        const juce::ScopedLock callbackLock(callbackLock_);
+        const juce::ScopedLock readLock(readLock_);
+
+        fifo_.reset();
+        readPosition_ = target;
+        playPosition_.store(target, std::memory_order_release);
+        if (resampler_) {
+            resampler_->flushBuffers();
+        }
+    }
+
+    double StemPlayer::getPosition() const
+    {
+        return fileSampleRate_ > 0.0
+            ? static_cast<double>(playPosition_.load(std::memory_order_acquire)) / fileSampleRate_
+            : 0.0;
+    }
+
+    double StemPlayer::getDuration() const
+    {
+        return fileSampleRate_ > 0.0 ? static_cast<double>(length_) / fileSampleRate_ : 0.0;
+    }
+
+    // ============================================================================
+    // Read-ahead thread
+    // ============================================================================
+
+    int StemPlayer::useTimeSlice()
+    {
+        // One chunk per slice, so several stem players on the thread take
+        // turns instead of one draining the disk for all of its ring
+        return fillChunk() ? 0 : 20;
+    }
+
+    bool StemPlayer::fillChunk()
+    {
+        const juce::ScopedLock lock(readLock_);
+
+        const int64_t remaining = length_ - readPosition_;
+        if (remaining <= 0) {
+            return false;
+        }
+
+        // Whole chunks only, so each read stays a long sequential run
+        const int wanted = static_cast<int>(std::min<int64_t>(ChunkSamples, remaining));
+        if (fifo_.getFreeSpace() < wanted) {
+            return false;
+        }
+
+        int start1, size1, start2, size2;
+        fifo_.prepareToWrite(wanted, start1, size1, start2, size2);
+
+        // Same file region of every stem back to back: stem 1, stem 2, ...
+        // then the next region
+        float* dest[MaxStemChannels];
+        for (Stem& stem : stems_) {
+            for (int channel = 0; channel < stem.channels; ++channel) {
+                dest[channel] = ring_.getWritePointer(stem.firstChannel + channel, start1);
+            }
+            stem.reader->read(dest, stem.channels, readPosition_, size1);
+
+            if (size2 > 0) {
+                for (int channel = 0; channel < stem.channels; ++channel) {
+                    dest[channel] = ring_.getWritePointer(stem.firstChannel + channel, start2);
+                }
+                stem.reader->read(dest, stem.channels, readPosition_ + size1, size2);
+            }
+        }
+
+        fifo_.finishedWrite(size1 + size2);
+        readPosition_ += size1 + size2;
+        return true;
+    }
+
+    // ============================================================================
+    // Audio thread
+    // ============================================================================
+
+    void StemPlayer::prepareToPlay(int samplesPerBlockExpected, double sampleRate)
+    {
+        const juce::ScopedLock lock(callbackLock_);
+
+        scratch_.setSize(std::max(1, totalChannels_), std::max(1, samplesPerBlockExpected));
+
+        if (fileSampleRate_ > 0.0 && std::abs(fileSampleRate_ - sampleRate) > 0.01) {
+            resampler_ = std::make_unique<juce::ResamplingAudioSource>(&fifoSource_, false, std::max(1, totalChannels_));
+            resampler_->setResamplingRatio(fileSampleRate_ / sampleRate);
+            resampler_->prepareToPlay(samplesPerBlockExpected, sampleRate);
+        }
+        else {
+            resampler_.reset();
+        }
+    }
+
+    void StemPlayer::releaseResources()
+    {
+        const juce::ScopedLock lock(callbackLock_);
+
+        if (resampler_) {
+            resampler_->releaseResources();
+        }
+    }
+
+    void StemPlayer::readFifo(const juce::AudioSourceChannelInfo& info)
+    {
+        int start1, size1, start2, size2;
+        fifo_.prepareToRead(info.numSamples, start1, size1, start2, size2);
+
+        const int channels = std::min(totalChannels_, info.buffer->getNumChannels());
+        for (int channel = 0; channel < channels; ++channel) {
+            if (size1 > 0) {
+                info.buffer->copyFrom(channel, info.startSample, ring_, channel, start1, size1);
+            }
+            if (size2 > 0) {
+                info.buffer->copyFrom(channel, info.startSample + size1, ring_, channel, start2, size2);
+            }
+        }
+        fifo_.finishedRead(size1 + size2);
+
+        const int read = size1 + size2;
+        const int64_t position = playPosition_.load(std::memory_order_relaxed) + read;
+        playPosition_.store(position, std::memory_order_release);
+
+        if (read < info.numSamples) {
+            for (int channel = 0; channel < info.buffer->getNumChannels(); ++channel) {
+                info.buffer->clear(channel, info.startSample + read, info.numSamples - read);
+            }
+            if (position < length_) {
+                underruns_.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void StemPlayer::getNextAudioBlock(const juce::AudioSourceChannelInfo& info)
+    {
+        const juce::ScopedLock lock(callbackLock_);
+
+        info.clearActiveBufferRegion();
+        if (!playing_.load(std::memory_order_acquire) || totalChannels_ == 0) {
+            lastGain_ = 0.0f;   // Next start ramps up from silence
+            return;
+        }
+
+        const float targetGain = volume_.load(std::memory_order_relaxed);
+        const int outputs = info.buffer->getNumChannels();
+        const int chunk = scratch_.getNumSamples();
+
+        // Blocks larger than prepareToPlay promised are rendered in pieces
+        // rather than growing the scratch buffer on the audio thread
+        for (int done = 0; done < info.numSamples; done += chunk) {
+            const int count = std::min(chunk, info.numSamples - done);
+            const float startGain = lastGain_ + (targetGain - lastGain_) * done / info.numSamples;
+            const float endGain = lastGain_ + (targetGain - lastGain_) * (done + count) / info.numSamples;
+
+            const juce::AudioSourceChannelInfo stemInfo(&scratch_, 0, count);
+            if (resampler_) {
+                resampler_->getNextAudioBlock(stemInfo);
+            }
+            else {
+                readFifo(stemInfo);
+            }
+
+            for (const Route& route : routes_) {
+                if (route.output < outputs) {
+                    info.buffer->addFromWithRamp(route.output, info.startSample + done,
+                        scratch_.getReadPointer(route.channel), count,
+                        startGain * route.gain, endGain * route.gain);
+                }
+            }
+        }
+
+        lastGain_ = targetGain;
+
+        if (playPosition_.load(std::memory_order_relaxed) >= length_) {
+            playing_.store(false, std::memory_order_release);
+        }
+    }
+
+} // namespace CueForge
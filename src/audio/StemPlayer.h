@@ -0,0 +1,148 @@
+// ============================================================================
+// StemPlayer.h - Sample-locked multitrack voice with shared read-ahead
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace CueForge {
+
+    /**
+     * One voice that plays N stem files in lockstep.
+     *
+     * All stems share a single FIFO (one channel block per stem channel) and
+     * a single read position, so they cannot drift apart: the read-ahead
+     * thread fills the same file region of every stem back to back before
+     * moving on, which keeps disk access in long sequential runs, and the
+     * audio callback consumes every stem's samples from the same FIFO index.
+     * play() prerolls the FIFO first, so all stems start on the same sample.
+     *
+     * Routing is per stem channel to any device output with its own gain;
+     * stems at a different rate from the device go through one resampler
+     * for the whole set.
+     *
+     * Threads: transport and routing calls from the control thread,
+     * getNextAudioBlock() from the audio thread, useTimeSlice() from the
+     * engine's read-ahead thread. Like AudioTransportSource, anything the
+     * callback reads is changed under callbackLock_. loadFiles() must be
+     * called before the player is added to a mixer.
+     */
+    class StemPlayer : public juce::AudioSource,
+                       private juce::TimeSliceClient
+    {
+    public:
+        static constexpr int MaxStems = 32;
+        static constexpr int MaxStemChannels = 8;
+        static constexpr int ChunkSamples = 16384;      // Per stem per read-ahead pass
+        static constexpr double ReadAheadSeconds = 2.0;
+
+        StemPlayer(int id, juce::AudioFormatManager& formats, juce::TimeSliceThread& readThread);
+        ~StemPlayer() override;
+
+        // All stems must share one sample rate; shorter stems pad with silence
+        bool loadFiles(const std::vector<std::string>& filePaths, std::string* error = nullptr);
+
+        int getId() const { return id_; }
+        int getNumStems() const { return static_cast<int>(stems_.size()); }
+        int getStemChannels(int stem) const;
+        std::string getStemPath(int stem) const;
+
+        // Mono stems to outputs 1+2 at -3 dB, wider stems channel for channel
+        void setDefaultRoutes(int numOutputs);
+        bool setRoute(int stem, int stemChannel, int output, float gain);
+        void clearRoutes(int stem);
+
+        void play();
+        void stop();
+        void pause();
+        void resume();
+        bool isPlaying() const { return playing_.load(std::memory_order_acquire); }
+        bool isFinished() const;
+
+        void setVolume(float volume);
+        float getVolume() const { return volume_.load(std::memory_order_relaxed); }
+
+        void setPosition(double seconds);
+        double getPosition() const;
+        double getDuration() const;
+
+        // Blocks where the read-ahead fell behind the callback
+        int64_t getUnderruns() const { return underruns_.load(std::memory_order_relaxed); }
+
+        // juce::AudioSource
+        void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
+        void releaseResources() override;
+        void getNextAudioBlock(const juce::AudioSourceChannelInfo& info) override;
+
+    private:
+        struct Stem
+        {
+            std::unique_ptr<juce::AudioFormatReader> reader;
+            std::string path;
+            int channels = 0;
+            int firstChannel = 0;       // Offset into the FIFO's channels
+        };
+
+        struct Route
+        {
+            int channel;                // FIFO channel (stem firstChannel + stem channel)
+            int output;
+            float gain;
+        };
+
+        // Pulls stem channels out of the FIFO at the file rate
+        class FifoSource : public juce::AudioSource
+        {
+        public:
+            explicit FifoSource(StemPlayer& owner) : owner_(owner) {}
+            void prepareToPlay(int, double) override {}
+            void releaseResources() override {}
+            void getNextAudioBlock(const juce::AudioSourceChannelInfo& info) override { owner_.readFifo(info); }
+
+        private:
+            StemPlayer& owner_;
+        };
+
+        int useTimeSlice() override;
+        bool fillChunk();
+        void readFifo(const juce::AudioSourceChannelInfo& info);
+
+        const int id_;
+        juce::AudioFormatManager& formats_;
+        juce::TimeSliceThread& readThread_;
+
+        std::vector<Stem> stems_;
+        int totalChannels_ = 0;
+        int64_t length_ = 0;            // Longest stem, file samples
+        double fileSampleRate_ = 0.0;
+
+        // Shared read-ahead: written by fillChunk(), read by readFifo()
+        juce::AbstractFifo fifo_{ 1 };
+        juce::AudioBuffer<float> ring_;
+        juce::CriticalSection readLock_;    // fillChunk() vs setPosition()
+        int64_t readPosition_ = 0;          // Next file sample to read, guarded by readLock_
+        std::atomic<int64_t> playPosition_{ 0 };
+
+        // Audio thread
+        FifoSource fifoSource_{ *this };
+        std::unique_ptr<juce::ResamplingAudioSource> resampler_;
+        juce::CriticalSection callbackLock_;
+        juce::AudioBuffer<float> scratch_;
+        std::vector<Route> routes_;         // Guarded by callbackLock_
+        float lastGain_ = 0.0f;
+
+        std::atomic<bool> playing_{ false };
+        std::atomic<float> volume_{ 1.0f };
+        std::atomic<int64_t> underruns_{ 0 };
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StemPlayer)
+    };
+
+} // namespace CueForge
@@ -0,0 +1,666 @@
+// ============================================================================
+// TimeStretch.cpp - Pitch-preserving tempo change (WSOLA)
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#include "TimeStretch.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace CueForge {
+
+    namespace {
+
+        constexpr int Decimation = 4;      // Coarse search step
+        constexpr int PrerollFrames = 4096;
+
+        float dot(const float* a, const float* b, int count)
+        {
+            float sum = 0.0f;
+            for (int i = 0; i < count; ++i) {
+                sum += a[i] * b[i];
+            }
+            return sum;
+        }
+
+        // Normalised against the candidate only; the reference is the same
+        // for every candidate
+        float similarity(const float* reference, const float* candidate, int count)
+        {
+            return dot(reference, candidate, count) / std::sqrt(dot(candidate, candidate, count) + 1.0e-9f);
+        }
+
+        int64_t floorPosition(double position)
+        {
+            return static_cast<int64_t>(std::floor(position));
+        }
+
+    } // namespace
+
+    // ============================================================================
+    // WsolaStretcher
+    // ============================================================================
+
+    void WsolaStretcher::prepare(int numChannels, double sampleRate)
+    {
+        channels_ = juce::jlimit(1, MaxChannels, numChannels);
+        frame_ = juce::nextPowerOfTwo(std::max(64, static_cast<int>(sampleRate * FrameSeconds)));
+        hop_ = frame_ / 2;
+        search_ = frame_ / 4;
+
+        // The widest span one hop needs is frame + 3 * search + hop, and a
+        // push never brings more than that
+        capacity_ = 4 * frame_;
+
+        // Periodic Hann: overlapping at half a frame, the windows sum to 1
+        window_.resize(static_cast<size_t>(frame_));
+        for (int i = 0; i < frame_; ++i) {
+            window_[static_cast<size_t>(i)] = 0.5f - 0.5f * std::cos(juce::MathConstants<float>::twoPi * i / frame_);
+        }
+
+        input_.assign(static_cast<size_t>(channels_), std::vector<float>(static_cast<size_t>(capacity_)));
+        accum_.assign(static_cast<size_t>(channels_), std::vector<float>(static_cast<size_t>(frame_)));
+        mono_.resize(static_cast<size_t>(2 * search_ + frame_));
+        reference_.resize(static_cast<size_t>(frame_));
+        monoDecimated_.resize(mono_.size() / Decimation);
+        referenceDecimated_.resize(reference_.size() / Decimation);
+
+        reset(0);
+    }
+
+    void WsolaStretcher::reset(int64_t sourcePosition)
+    {
+        // A lead-in frame one hop early is overlapped but not output, so
+        // the first hop starts exactly at sourcePosition
+        nominal_ = static_cast<double>(sourcePosition - hop_);
+        previous_ = sourcePosition - 2 * hop_;
+        primed_ = false;
+
+        bufferStart_ = sourcePosition - hop_ - search_;
+        buffered_ = 0;
+        for (auto& channel : accum_) {
+            std::fill(channel.begin(), channel.end(), 0.0f);
+        }
+    }
+
+    void WsolaStretcher::setRate(double rate)
+    {
+        rate_ = juce::jlimit(MinRate, MaxRate, rate);
+    }
+
+    int64_t WsolaStretcher::getRequiredInputEnd() const
+    {
+        const int64_t nominal = floorPosition(nominal_);
+        if (!primed_) {
+            return nominal + hop_ + search_ + frame_;
+        }
+        return std::max(previous_ + hop_, nominal + search_) + frame_;
+    }
+
+    int64_t WsolaStretcher::getSourcePosition() const
+    {
+        return floorPosition(nominal_) + (primed_ ? 0 : hop_);
+    }
+
+    void WsolaStretcher::pushInput(const float* const* input, int numFrames)
+    {
+        if (buffered_ + numFrames > capacity_) {
+            compact();
+        }
+        jassert(buffered_ + numFrames <= capacity_);
+        numFrames = std::min(numFrames, capacity_ - buffered_);
+
+        for (int channel = 0; channel < channels_; ++channel) {
+            std::copy(input[channel], input[channel] + numFrames,
+                input_[static_cast<size_t>(channel)].data() + buffered_);
+        }
+        buffered_ += numFrames;
+    }
+
+    void WsolaStretcher::compact()
+    {
+        // Everything before the earliest sample the next hop can touch
+        const int64_t keepFrom = std::min(previous_ + hop_, floorPosition(nominal_) - search_);
+        const int drop = static_cast<int>(juce::jlimit<int64_t>(0, buffered_, keepFrom - bufferStart_));
+        if (drop == 0) {
+            return;
+        }
+
+        for (auto& channel : input_) {
+            std::copy(channel.begin() + drop, channel.begin() + buffered_, channel.begin());
+        }
+        bufferStart_ += drop;
+        buffered_ -= drop;
+    }
+
+    int64_t WsolaStretcher::findPosition()
+    {
+        const int64_t nominal = floorPosition(nominal_);
+        const int64_t natural = previous_ + hop_;
+
+        // Nothing to stretch: keep reading contiguously, which also makes
+        // rate 1.0 an exact copy
+        if (rate_ == 1.0 && std::abs(natural - nominal) <= search_) {
+            return natural;
+        }
+
+        // Candidates start anywhere in [nominal - search, nominal + search]
+        const int span = static_cast<int>(mono_.size());
+        std::fill(mono_.begin(), mono_.end(), 0.0f);
+        std::fill(reference_.begin(), reference_.end(), 0.0f);
+        for (int channel = 0; channel < channels_; ++channel) {
+            const float* candidates = at(channel, nominal - search_);
+            const float* continuation = at(channel, natural);
+            for (int i = 0; i < span; ++i) {
+                mono_[static_cast<size_t>(i)] += candidates[i];
+            }
+            for (int i = 0; i < frame_; ++i) {
+                reference_[static_cast<size_t>(i)] += continuation[i];
+            }
+        }
+
+        auto decimate = [](const std::vector<float>& source, std::vector<float>& dest) {
+            for (size_t i = 0; i < dest.size(); ++i) {
+                const float* group = source.data() + i * Decimation;
+                dest[i] = group[0] + group[1] + group[2] + group[3];
+            }
+        };
+        decimate(mono_, monoDecimated_);
+        decimate(reference_, referenceDecimated_);
+
+        // Coarse pass, starting from the nominal position so that silence
+        // and ties keep to the timeline
+        const int coarseLength = frame_ / Decimation;
+        int best = search_;
+        float bestScore = similarity(referenceDecimated_.data(), monoDecimated_.data() + search_ / Decimation, coarseLength);
+        for (int step = 0; step <= 2 * search_ / Decimation; ++step) {
+            const float score = similarity(referenceDecimated_.data(), monoDecimated_.data() + step, coarseLength);
+            if (score > bestScore) {
+                bestScore = score;
+                best = step * Decimation;
+            }
+        }
+
+        // Fine pass around the coarse match
+        const int coarse = best;
+        bestScore = similarity(reference_.data(), mono_.data() + coarse, frame_);
+        for (int offset = std::max(0, coarse - Decimation + 1); offset <= std::min(2 * search_, coarse + Decimation - 1); ++offset) {
+            const float score = similarity(reference_.data(), mono_.data() + offset, frame_);
+            if (score > bestScore) {
+                bestScore = score;
+                best = offset;
+            }
+        }
+
+        return nominal - search_ + best;
+    }
+
+    void WsolaStretcher::overlapAdd(int64_t position)
+    {
+        for (int channel = 0; channel < channels_; ++channel) {
+            const float* source = at(channel, position);
+            float* accum = accum_[static_cast<size_t>(channel)].data();
+            for (int i = 0; i < frame_; ++i) {
+                accum[i] += window_[static_cast<size_t>(i)] * source[i];
+            }
+        }
+    }
+
+    void WsolaStretcher::produceHop(float* const* output)
+    {
+        jassert(getInputEnd() >= getRequiredInputEnd());
+
+        if (!primed_) {
+            const int64_t position = floorPosition(nominal_);
+            overlapAdd(position);
+            previous_ = position;
+            nominal_ += hop_;
+            for (auto& accum : accum_) {
+                std::copy(accum.begin() + hop_, accum.end(), accum.begin());
+                std::fill(accum.begin() + hop_, accum.end(), 0.0f);
+            }
+            primed_ = true;
+        }
+
+        const int64_t position = findPosition();
+        overlapAdd(position);
+        previous_ = position;
+        nominal_ += hop_ * rate_;
+
+        for (int channel = 0; channel < channels_; ++channel) {
+            auto& accum = accum_[static_cast<size_t>(channel)];
+            std::copy(accum.begin(), accum.begin() + hop_, output[channel]);
+            std::copy(accum.begin() + hop_, accum.end(), accum.begin());
+            std::fill(accum.begin() + hop_, accum.end(), 0.0f);
+        }
+    }
+
+    // ============================================================================
+    // TimeStretchCache
+    // ============================================================================
+
+    class TimeStretchCache::RenderJob : public juce::ThreadPoolJob
+    {
+    public:
+        RenderJob(TimeStretchCache& cache, Key key, double rate, int64_t renderId)
+            : juce::ThreadPoolJob("Time stretch render")
+            , cache_(cache)
+            , key_(std::move(key))
+            , rate_(rate)
+            , renderId_(renderId)
+        {
+        }
+
+        const Key& getKey() const { return key_; }
+
+        JobStatus runJob() override
+        {
+            std::unique_ptr<juce::AudioFormatReader> reader(
+                cache_.formats_.createReaderFor(juce::File(key_.first)));
+
+            std::shared_ptr<RenderedStretch> rendered;
+            if (!reader) {
+                std::cerr << "TimeStretchCache: could not create reader for: " << key_.first << std::endl;
+            }
+            else {
+                const int channels = std::min<int>(WsolaStretcher::MaxChannels, static_cast<int>(reader->numChannels));
+                const double bytes = 4.0 * channels * static_cast<double>(reader->lengthInSamples) / rate_;
+                if (bytes > static_cast<double>(MaxRenderBytes)) {
+                    std::cout << "TimeStretchCache: " << key_.first << " too long to render ahead, stretching live" << std::endl;
+                }
+                else {
+                    rendered = render(*reader, rate_, [this] { return shouldExit(); });
+                }
+            }
+
+            cache_.finished(key_, renderId_, std::move(rendered));
+            return jobHasFinished;
+        }
+
+    private:
+        TimeStretchCache& cache_;
+        const Key key_;
+        const double rate_;
+        const int64_t renderId_;
+    };
+
+    TimeStretchCache::TimeStretchCache(juce::AudioFormatManager& formats)
+        : formats_(formats)
+    {
+    }
+
+    TimeStretchCache::~TimeStretchCache()
+    {
+        // Jobs report back into entries_, which goes before pool_
+        pool_.removeAllJobs(true, 5000);
+    }
+
+    TimeStretchCache::Key TimeStretchCache::makeKey(const std::string& filePath, double rate)
+    {
+        return { filePath, static_cast<int>(std::lround(rate * 10000.0)) };
+    }
+
+    void TimeStretchCache::prepare(const std::string& filePath, double rate)
+    {
+        rate = juce::jlimit(WsolaStretcher::MinRate, WsolaStretcher::MaxRate, rate);
+        const Key key = makeKey(filePath, rate);
+        {
+            const juce::ScopedLock lock(lock_);
+            auto it = entries_.find(key);
+            if (it != entries_.end()) {
+                it->second.lastUsed = ++useCounter_;
+                return;
+            }
+        }
+
+        class Superseded : public juce::ThreadPool::JobSelector
+        {
+        public:
+            explicit Superseded(const Key& key) : key_(key) {}
+
+            bool isJobSuitable(juce::ThreadPoolJob* job) override
+            {
+                const Key& other = static_cast<RenderJob*>(job)->getKey();
+                if (other.first != key_.first || other == key_) {
+                    return false;
+                }
+                dropped.push_back(other);
+                return true;
+            }
+
+            std::vector<Key> dropped;
+
+        private:
+            const Key& key_;
+        };
+
+        // A running job is only told to stop; it reports back empty
+        Superseded superseded(key);
+        pool_.removeAllJobs(true, 0, &superseded);
+
+        int64_t renderId = 0;
+        {
+            const juce::ScopedLock lock(lock_);
+            for (const Key& dropped : superseded.dropped) {
+                auto it = entries_.find(dropped);
+                if (it != entries_.end() && !it->second.rendered) {
+                    entries_.erase(it);
+                }
+            }
+
+            Entry& entry = entries_[key];
+            entry.lastUsed = ++useCounter_;
+            entry.renderId = renderId = useCounter_;
+        }
+
+        pool_.addJob(new RenderJob(*this, key, rate, renderId), true);
+    }
+
+    std::shared_ptr<const RenderedStretch> TimeStretchCache::find(const std::string& filePath, double rate)
+    {
+        const juce::ScopedLock lock(lock_);
+
+        auto it = entries_.find(makeKey(filePath, rate));
+        if (it == entries_.end() || !it->second.rendered) {
+            return nullptr;
+        }
+        it->second.lastUsed = ++useCounter_;
+        return it->second.rendered;
+    }
+
+    bool TimeStretchCache::isReady(const std::string& filePath, double rate) const
+    {
+        const juce::ScopedLock lock(lock_);
+
+        auto it = entries_.find(makeKey(filePath, rate));
+        return it != entries_.end() && it->second.rendered != nullptr;
+    }
+
+    void TimeStretchCache::clear()
+    {
+        pool_.removeAllJobs(true, 5000);
+
+        const juce::ScopedLock lock(lock_);
+        entries_.clear();
+    }
+
+    void TimeStretchCache::finished(const Key& key, int64_t renderId, std::shared_ptr<RenderedStretch> rendered)
+    {
+        const juce::ScopedLock lock(lock_);
+
+        auto it = entries_.find(key);
+        if (it == entries_.end() || it->second.renderId != renderId) {
+            return;     // Cleared or superseded while rendering
+        }
+        if (!rendered) {
+            entries_.erase(it);     // Failed or cancelled; a later prepare() retries
+            return;
+        }
+
+        std::cout << "Time stretch " << key.first << " at " << rendered->rate << "x rendered in "
+                  << rendered->renderSeconds << " s" << std::endl;
+        it->second.rendered = std::move(rendered);
+        evict();
+    }
+
+    void TimeStretchCache::evict()
+    {
+        auto bytesOf = [](const Entry& entry) {
+            return entry.rendered ? static_cast<int64_t>(entry.rendered->audio.getNumChannels())
+                * entry.rendered->audio.getNumSamples() * static_cast<int64_t>(sizeof(float)) : 0;
+        };
+
+        int64_t total = 0;
+        for (const auto& entry : entries_) {
+            total += bytesOf(entry.second);
+        }
+
+        while (total > MaxCacheBytes) {
+            // Oldest render no player is holding
+            auto victim = entries_.end();
+            for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+                if (it->second.rendered && it->second.rendered.use_count() == 1
+                    && (victim == entries_.end() || it->second.lastUsed < victim->second.lastUsed)) {
+                    victim = it;
+                }
+            }
+            if (victim == entries_.end()) {
+                break;
+            }
+            total -= bytesOf(victim->second);
+            entries_.erase(victim);
+        }
+    }
+
+    std::shared_ptr<RenderedStretch> TimeStretchCache::render(juce::AudioFormatReader& reader, double rate,
+        const std::function<bool()>& cancelled)
+    {
+        const double started = juce::Time::getMillisecondCounterHiRes();
+
+        WsolaStretcher stretcher;
+        stretcher.prepare(static_cast<int>(reader.numChannels), reader.sampleRate);
+        stretcher.setRate(rate);
+        stretcher.reset(0);
+
+        auto rendered = std::make_shared<RenderedStretch>();
+        rendered->sampleRate = reader.sampleRate;
+        rendered->rate = stretcher.getRate();
+        rendered->sourceLength = reader.lengthInSamples;
+
+        const int channels = stretcher.getNumChannels();
+        const int hop = stretcher.getHopSize();
+        const int length = static_cast<int>(std::ceil(static_cast<double>(reader.lengthInSamples) / rendered->rate));
+        rendered->audio.setSize(channels, length);
+
+        juce::AudioBuffer<float> input(channels, 4 * stretcher.getFrameSize());
+        juce::AudioBuffer<float> hopBuffer(channels, hop);
+
+        for (int written = 0; written < length; written += hop) {
+            if (cancelled && (written / hop) % 64 == 0 && cancelled()) {
+                return nullptr;
+            }
+
+            // Positions before and past the file read back as silence
+            while (stretcher.getInputEnd() < stretcher.getRequiredInputEnd()) {
+                const int count = static_cast<int>(std::min<int64_t>(input.getNumSamples(),
+                    stretcher.getRequiredInputEnd() - stretcher.getInputEnd()));
+                reader.read(input.getArrayOfWritePointers(), channels, stretcher.getInputEnd(), count);
+                stretcher.pushInput(input.getArrayOfReadPointers(), count);
+            }
+
+            stretcher.produceHop(hopBuffer.getArrayOfWritePointers());
+            for (int channel = 0; channel < channels; ++channel) {
+                rendered->audio.copyFrom(channel, written, hopBuffer, channel, 0, std::min(hop, length - written));
+            }
+        }
+
+        rendered->renderSeconds = (juce::Time::getMillisecondCounterHiRes() - started) / 1000.0;
+        return rendered;
+    }
+
+    // ============================================================================
+    // RenderedStretchSource
+    // ============================================================================
+
+    RenderedStretchSource::RenderedStretchSource(std::shared_ptr<const RenderedStretch> rendered)
+        : rendered_(std::move(rendered))
+    {
+    }
+
+    void RenderedStretchSource::getNextAudioBlock(const juce::AudioSourceChannelInfo& info)
+    {
+        const juce::AudioBuffer<float>& audio = rendered_->audio;
+        const int64_t position = outputPosition_.load(std::memory_order_relaxed);
+
+        // Past the end the position keeps moving so the transport sees it
+        const int available = static_cast<int>(juce::jlimit<int64_t>(0, info.numSamples,
+            audio.getNumSamples() - position));
+
+        for (int channel = 0; channel < info.buffer->getNumChannels(); ++channel) {
+            if (available > 0) {
+                // Mono files play on both sides, as AudioFormatReaderSource does
+                const int source = std::min(channel, audio.getNumChannels() - 1);
+                info.buffer->copyFrom(channel, info.startSample, audio, source,
+                    static_cast<int>(position), available);
+            }
+            if (available < info.numSamples) {
+                info.buffer->clear(channel, info.startSample + available, info.numSamples - available);
+            }
+        }
+
+        outputPosition_.store(position + info.numSamples, std::memory_order_relaxed);
+    }
+
+    void RenderedStretchSource::setNextReadPosition(juce::int64 newPosition)
+    {
+        outputPosition_.store(static_cast<int64_t>(std::llround(newPosition / rendered_->rate)),
+            std::memory_order_relaxed);
+    }
+
+    juce::int64 RenderedStretchSource::getNextReadPosition() const
+    {
+        return static_cast<juce::int64>(std::llround(
+            outputPosition_.load(std::memory_order_relaxed) * rendered_->rate));
+    }
+
+    // ============================================================================
+    // LiveStretchSource
+    // ============================================================================
+
+    LiveStretchSource::LiveStretchSource(juce::AudioFormatReader& reader, juce::TimeSliceThread& thread, double rate)
+        : reader_(reader)
+        , thread_(thread)
+        , channels_(juce::jlimit(1, WsolaStretcher::MaxChannels, static_cast<int>(reader.numChannels)))
+        , targetRate_(juce::jlimit(WsolaStretcher::MinRate, WsolaStretcher::MaxRate, rate))
+    {
+        stretcher_.prepare(channels_, reader_.sampleRate);
+        readBuffer_.setSize(channels_, 4 * stretcher_.getFrameSize());
+        hopBuffer_.setSize(channels_, stretcher_.getHopSize());
+        fifoBuffer_.setSize(channels_, FifoFrames);
+        fifoPositions_.resize(FifoFrames);
+
+        setNextReadPosition(0);
+        thread_.addTimeSliceClient(this);
+    }
+
+    LiveStretchSource::~LiveStretchSource()
+    {
+        // Waits for a slice in progress on this source to finish
+        thread_.removeTimeSliceClient(this);
+    }
+
+    void LiveStretchSource::setRate(double rate)
+    {
+        targetRate_.store(juce::jlimit(WsolaStretcher::MinRate, WsolaStretcher::MaxRate, rate),
+            std::memory_order_relaxed);
+    }
+
+    void LiveStretchSource::setNextReadPosition(juce::int64 newPosition)
+    {
+        {
+            // Callback first, then read-ahead, as in StemPlayer::setPosition
+            const juce::ScopedLock callbackLock(callbackLock_);
+            const juce::ScopedLock readLock(readLock_);
+
+            fifo_.reset();
+            stretcher_.reset(newPosition);
+            playPosition_.store(newPosition, std::memory_order_relaxed);
+        }
+
+        // Preroll, so playback can start on the next block
+        while (fifo_.getNumReady() < PrerollFrames && fillHop()) {
+        }
+    }
+
+    int LiveStretchSource::useTimeSlice()
+    {
+        // One hop per slice, so stretching voices on the thread take turns
+        return fillHop() ? 0 : 5;
+    }
+
+    bool LiveStretchSource::fillHop()
+    {
+        const juce::ScopedLock lock(readLock_);
+
+        // A frame of silence past the end carries the position beyond the
+        // length, which is how the transport notices the end
+        if (stretcher_.getSourcePosition() > reader_.lengthInSamples + stretcher_.getFrameSize()) {
+            return false;
+        }
+
+        const int hop = stretcher_.getHopSize();
+        if (fifo_.getFreeSpace() < hop) {
+            return false;
+        }
+
+        const double started = juce::Time::getMillisecondCounterHiRes();
+        const double rate = targetRate_.load(std::memory_order_relaxed);
+        stretcher_.setRate(rate);
+
+        while (stretcher_.getInputEnd() < stretcher_.getRequiredInputEnd()) {
+            const int count = static_cast<int>(std::min<int64_t>(readBuffer_.getNumSamples(),
+                stretcher_.getRequiredInputEnd() - stretcher_.getInputEnd()));
+            reader_.read(readBuffer_.getArrayOfWritePointers(), channels_, stretcher_.getInputEnd(), count);
+            stretcher_.pushInput(readBuffer_.getArrayOfReadPointers(), count);
+        }
+
+        const int64_t hopStart = stretcher_.getSourcePosition();
+        stretcher_.produceHop(hopBuffer_.getArrayOfWritePointers());
+
+        int start1, size1, start2, size2;
+        fifo_.prepareToWrite(hop, start1, size1, start2, size2);
+        for (int channel = 0; channel < channels_; ++channel) {
+            fifoBuffer_.copyFrom(channel, start1, hopBuffer_, channel, 0, size1);
+            if (size2 > 0) {
+                fifoBuffer_.copyFrom(channel, start2, hopBuffer_, channel, size1, size2);
+            }
+        }
+        // Source position reached after each output frame
+        for (int i = 0; i < hop; ++i) {
+            const int index = i < size1 ? start1 + i : start2 + (i - size1);
+            fifoPositions_[static_cast<size_t>(index)] = hopStart + static_cast<int64_t>((i + 1) * rate);
+        }
+        fifo_.finishedWrite(size1 + size2);
+
+        const double seconds = (juce::Time::getMillisecondCounterHiRes() - started) / 1000.0;
+        const double load = seconds * reader_.sampleRate / hop;
+        load_.store(load_.load(std::memory_order_relaxed) * 0.9 + load * 0.1, std::memory_order_relaxed);
+        return true;
+    }
+
+    void LiveStretchSource::getNextAudioBlock(const juce::AudioSourceChannelInfo& info)
+    {
+        const juce::ScopedLock lock(callbackLock_);
+
+        int start1, size1, start2, size2;
+        fifo_.prepareToRead(info.numSamples, start1, size1, start2, size2);
+
+        for (int channel = 0; channel < info.buffer->getNumChannels(); ++channel) {
+            const int source = std::min(channel, channels_ - 1);
+            if (size1 > 0) {
+                info.buffer->copyFrom(channel, info.startSample, fifoBuffer_, source, start1, size1);
+            }
+            if (size2 > 0) {
+                info.buffer->copyFrom(channel, info.startSample + size1, fifoBuffer_, source, start2, size2);
+            }
+        }
+
+        const int read = size1 + size2;
+        if (read > 0) {
+            const int last = size2 > 0 ? start2 + size2 - 1 : start1 + size1 - 1;
+            playPosition_.store(fifoPositions_[static_cast<size_t>(last)], std::memory_order_relaxed);
+        }
+        fifo_.finishedRead(read);
+
+        if (read < info.numSamples) {
+            for (int channel = 0; channel < info.buffer->getNumChannels(); ++channel) {
+                info.buffer->clear(channel, info.startSample + read, info.numSamples - read);
+            }
+            if (playPosition_.load(std::memory_order_relaxed) < reader_.lengthInSamples) {
+                underruns_.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+} // namespace CueForge
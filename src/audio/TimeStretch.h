@@ -0,0 +1,246 @@
+// ============================================================================
+// TimeStretch.h - Pitch-preserving tempo change (WSOLA)
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace CueForge {
+
+    /**
+     * Waveform-similarity overlap-add time stretching. Output is built from
+     * Hann-windowed frames at a fixed synthesis hop; each frame is read
+     * from the input near its nominal position (output position x rate),
+     * nudged within +/- a search range to the offset whose start best
+     * matches the natural continuation of the previous frame. Matching
+     * waveforms rather than moving phases keeps speech and transients
+     * clean, and at rate 1.0 the input comes back unchanged.
+     *
+     * The alignment search runs on a mono mix, first on 4:1 decimated sums
+     * then at full rate around the best coarse match, and every channel
+     * uses the same offset so the stereo image holds. The work per hop is
+     * fixed by the frame and search sizes, whatever the rate, so the cost
+     * per output second is bounded.
+     *
+     * The caller feeds input in order: push until getInputEnd() reaches
+     * getRequiredInputEnd(), then produceHop(). Positions are source
+     * samples and may be negative before the file start (feed silence).
+     */
+    class WsolaStretcher
+    {
+    public:
+        static constexpr double MinRate = 0.5;
+        static constexpr double MaxRate = 2.0;
+        static constexpr int MaxChannels = 2;
+        static constexpr double FrameSeconds = 0.02;   // Rounded up to a power of two
+
+        void prepare(int numChannels, double sampleRate);
+        void reset(int64_t sourcePosition);
+
+        // Tempo factor, > 1 is faster; applies from the next hop
+        void setRate(double rate);
+        double getRate() const { return rate_; }
+
+        int getNumChannels() const { return channels_; }
+        int getHopSize() const { return hop_; }
+        int getFrameSize() const { return frame_; }
+
+        int64_t getInputEnd() const { return bufferStart_ + buffered_; }
+        int64_t getRequiredInputEnd() const;
+        void pushInput(const float* const* input, int numFrames);
+
+        // Writes exactly getHopSize() frames per channel
+        void produceHop(float* const* output);
+
+        // Source sample the next hop starts from
+        int64_t getSourcePosition() const;
+
+    private:
+        int64_t findPosition();
+        void overlapAdd(int64_t position);
+        void compact();
+        float* at(int channel, int64_t position) { return input_[static_cast<size_t>(channel)].data() + (position - bufferStart_); }
+
+        int channels_ = 0;
+        int frame_ = 0;
+        int hop_ = 0;
+        int search_ = 0;
+        int capacity_ = 0;
+        double rate_ = 1.0;
+
+        std::vector<float> window_;
+        std::vector<std::vector<float>> input_;     // [channel][capacity_]
+        std::vector<std::vector<float>> accum_;     // [channel][frame_]
+        std::vector<float> mono_, reference_, monoDecimated_, referenceDecimated_;
+        int64_t bufferStart_ = 0;
+        int buffered_ = 0;
+
+        double nominal_ = 0.0;      // Nominal source position of the next frame
+        int64_t previous_ = 0;      // Where the previous frame was read from
+        bool primed_ = false;
+    };
+
+    // A whole file stretched ahead of playback
+    struct RenderedStretch
+    {
+        juce::AudioBuffer<float> audio;     // At the file's sample rate
+        double sampleRate = 0.0;
+        double rate = 1.0;
+        int64_t sourceLength = 0;
+        double renderSeconds = 0.0;         // CPU time the render took
+    };
+
+    struct StretchStats
+    {
+        bool active = false;
+        bool rendered = false;      // Playing a pre-rendered buffer
+        double rate = 1.0;
+        double load = 0.0;          // Live: stretch CPU time per second of output
+        int64_t underruns = 0;      // Live: blocks the read-ahead thread didn't fill in time
+        double renderSeconds = 0.0; // Rendered: CPU time the render took
+    };
+
+    /**
+     * Renders static-rate stretches on a background thread and keeps them
+     * for reuse, keyed by file and rate, up to MaxCacheBytes; the least
+     * recently used renders that no player holds are evicted first.
+     */
+    class TimeStretchCache
+    {
+    public:
+        static constexpr int64_t MaxCacheBytes = 512LL * 1024 * 1024;
+        static constexpr int64_t MaxRenderBytes = MaxCacheBytes / 2;   // Longer files stretch live
+
+        explicit TimeStretchCache(juce::AudioFormatManager& formats);
+        ~TimeStretchCache();
+
+        // Starts a render unless one is cached or under way. Unfinished
+        // renders of the same file at other rates are dropped, so sweeping
+        // a rate control doesn't queue a render per step. Thread safe.
+        void prepare(const std::string& filePath, double rate);
+        std::shared_ptr<const RenderedStretch> find(const std::string& filePath, double rate);
+        bool isReady(const std::string& filePath, double rate) const;
+        void clear();
+
+        // Renders a whole file on the calling thread; returns null if
+        // cancelled() turns true part way
+        static std::shared_ptr<RenderedStretch> render(juce::AudioFormatReader& reader, double rate,
+            const std::function<bool()>& cancelled = nullptr);
+
+    private:
+        class RenderJob;
+        using Key = std::pair<std::string, int>;    // Rate in 1/10000ths
+
+        static Key makeKey(const std::string& filePath, double rate);
+        void finished(const Key& key, int64_t renderId, std::shared_ptr<RenderedStretch> rendered);
+        void evict();
+
+        juce::AudioFormatManager& formats_;
+        juce::ThreadPool pool_{ 1 };
+
+        struct Entry
+        {
+            std::shared_ptr<RenderedStretch> rendered;  // Null while rendering
+            int64_t lastUsed = 0;
+            int64_t renderId = 0;                       // Job that fills it in
+        };
+
+        mutable juce::CriticalSection lock_;
+        std::map<Key, Entry> entries_;
+        int64_t useCounter_ = 0;
+    };
+
+    /**
+     * Plays a RenderedStretch. Positions are reported in source samples, so
+     * the transport's position and length stay in file time.
+     */
+    class RenderedStretchSource : public juce::PositionableAudioSource
+    {
+    public:
+        explicit RenderedStretchSource(std::shared_ptr<const RenderedStretch> rendered);
+
+        const RenderedStretch& getRendered() const { return *rendered_; }
+
+        void prepareToPlay(int, double) override {}
+        void releaseResources() override {}
+        void getNextAudioBlock(const juce::AudioSourceChannelInfo& info) override;
+
+        void setNextReadPosition(juce::int64 newPosition) override;
+        juce::int64 getNextReadPosition() const override;
+        juce::int64 getTotalLength() const override { return rendered_->sourceLength; }
+        bool isLooping() const override { return false; }
+
+    private:
+        std::shared_ptr<const RenderedStretch> rendered_;
+        std::atomic<int64_t> outputPosition_{ 0 };
+    };
+
+    /**
+     * Stretches while playing, for rates that change during playback. The
+     * engine's read-ahead thread runs the stretcher into a FIFO a little
+     * ahead of the callback, so a rate change is heard after at most
+     * FifoFrames. Positions are source samples, as for the rendered source.
+     *
+     * Threads: setRate from any thread, setNextReadPosition from the
+     * control thread (it prerolls the FIFO), getNextAudioBlock from the
+     * audio thread, useTimeSlice from the read-ahead thread. As in
+     * StemPlayer, callbackLock_ keeps a reposition out of the callback and
+     * readLock_ keeps it out of a fill.
+     */
+    class LiveStretchSource : public juce::PositionableAudioSource,
+                              private juce::TimeSliceClient
+    {
+    public:
+        static constexpr int FifoFrames = 8192;
+
+        LiveStretchSource(juce::AudioFormatReader& reader, juce::TimeSliceThread& thread, double rate);
+        ~LiveStretchSource() override;
+
+        void setRate(double rate);
+        double getRate() const { return targetRate_.load(std::memory_order_relaxed); }
+        double getLoad() const { return load_.load(std::memory_order_relaxed); }
+        int64_t getUnderruns() const { return underruns_.load(std::memory_order_relaxed); }
+
+        void prepareToPlay(int, double) override {}
+        void releaseResources() override {}
+        void getNextAudioBlock(const juce::AudioSourceChannelInfo& info) override;
+
+        void setNextReadPosition(juce::int64 newPosition) override;
+        juce::int64 getNextReadPosition() const override { return playPosition_.load(std::memory_order_relaxed); }
+        juce::int64 getTotalLength() const override { return reader_.lengthInSamples; }
+        bool isLooping() const override { return false; }
+
+    private:
+        int useTimeSlice() override;
+        bool fillHop();
+
+        juce::AudioFormatReader& reader_;
+        juce::TimeSliceThread& thread_;
+        const int channels_;
+
+        juce::CriticalSection readLock_;
+        WsolaStretcher stretcher_;              // Guarded by readLock_
+        juce::AudioBuffer<float> readBuffer_;
+        juce::AudioBuffer<float> hopBuffer_;
+
+        juce::CriticalSection callbackLock_;
+        juce::AbstractFifo fifo_{ FifoFrames };
+        juce::AudioBuffer<float> fifoBuffer_;
+        std::vector<int64_t> fifoPositions_;    // Source position of each FIFO frame
+
+        std::atomic<double> targetRate_;
+        std::atomic<int64_t> playPosition_{ 0 };
+        std::atomic<double> load_{ 0.0 };
+        std::atomic<int64_t> underruns_{ 0 };
+    };
+
+} // namespace CueForge
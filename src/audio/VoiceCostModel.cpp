@@ -0,0 +1,461 @@
+// ============================================================================
+// VoiceCostModel.cpp - Measured per-voice render cost for capacity planning
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#include "VoiceCostModel.h"
+#include "JuceAudioEngine.h"
+#include "NullAudioDevice.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <map>
+
+namespace CueForge {
+
+    namespace {
+        constexpr int WarmupBlocks = 16;
+
+        struct BlockTimes
+        {
+            double meanUs = 0.0;
+            double p99Us = 0.0;
+        };
+
+        BlockTimes summarise(std::vector<double>& times)
+        {
+            BlockTimes result;
+            if (times.empty()) {
+                return result;
+            }
+            double total = 0.0;
+            for (double t : times) {
+                total += t;
+            }
+            result.meanUs = total / times.size();
+            std::sort(times.begin(), times.end());
+            result.p99Us = times[std::min(times.size() - 1, static_cast<size_t>(times.size() * 0.99))];
+            return result;
+        }
+
+        // Render blocks one at a time, timing each callback. With fading on,
+        // every voice gets a new gain before each block so the transport
+        // source ramps for the whole measurement.
+        BlockTimes timeBlocks(NullAudioIODevice* device, JuceAudioEngine& engine,
+            const std::vector<int>& players, int blocks, bool fading)
+        {
+            std::vector<double> times;
+            times.reserve(static_cast<size_t>(blocks));
+
+            for (int block = 0; block < blocks; ++block) {
+                if (fading) {
+                    const float gain = (block % 2) ? 0.9f : 0.3f;
+                    for (int id : players) {
+                        if (AudioPlayer* player = engine.getPlayer(id)) {
+                            player->setVolume(gain);
+                        }
+                    }
+                }
+
+                const auto start = std::chrono::steady_clock::now();
+                device->renderBlocks(1);
+                times.push_back(std::chrono::duration<double, std::micro>(
+                    std::chrono::steady_clock::now() - start).count());
+            }
+
+            return summarise(times);
+        }
+
+        bool writeTestFile(const juce::File& file, const VoiceConfig& config, double seconds)
+        {
+            juce::AudioFormatManager formats;
+            formats.registerBasicFormats();
+
+            juce::AudioFormat* format = formats.findFormatForFileExtension(config.format);
+            if (!format || !format->canHandleFile(file)) {
+                return false;
+            }
+
+            const int length = static_cast<int>(config.fileSampleRate * seconds);
+            juce::AudioBuffer<float> buffer(config.channels, length);
+            for (int ch = 0; ch < config.channels; ++ch) {
+                // A different partial per channel so lossy codecs can't fold them
+                const double frequency = 220.0 * (ch + 1);
+                for (int i = 0; i < length; ++i) {
+                    buffer.setSample(ch, i, 0.25f * static_cast<float>(
+                        std::sin(juce::MathConstants<double>::twoPi * frequency * i / config.fileSampleRate)));
+                }
+            }
+
+            const juce::Array<int> depths = format->getPossibleBitDepths();
+            const int bits = depths.contains(24) ? 24 : (depths.isEmpty() ? 16 : depths.getLast());
+
+            file.deleteFile();
+            std::unique_ptr<juce::OutputStream> stream = file.createOutputStream();
+            if (!stream) {
+                return false;
+            }
+
+            std::unique_ptr<juce::AudioFormatWriter> writer(format->createWriterFor(stream.get(),
+                config.fileSampleRate, static_cast<unsigned int>(config.channels), bits, {}, 0));
+            if (!writer) {
+                return false;
+            }
+            stream.release();   // Owned by the writer now
+
+            return writer->writeFromAudioSampleBuffer(buffer, 0, length);
+        }
+
+        bool isResampled(const VoiceConfig& config, double deviceRate)
+        {
+            return std::abs(config.fileSampleRate - deviceRate) > 0.5;
+        }
+    }
+
+    // ============================================================================
+    // VoiceConfig
+    // ============================================================================
+
+    bool VoiceConfig::operator==(const VoiceConfig& other) const
+    {
+        return format == other.format
+            && channels == other.channels
+            && std::abs(fileSampleRate - other.fileSampleRate) < 0.5
+            && outputs == other.outputs
+            && fading == other.fading;
+    }
+
+    std::string VoiceConfig::describe() const
+    {
+        return format + " " + std::to_string(channels) + "ch "
+            + std::to_string(static_cast<int>(fileSampleRate)) + "Hz -> "
+            + std::to_string(outputs) + " out" + (fading ? ", fading" : "");
+    }
+
+    // ============================================================================
+    // Calibration
+    // ============================================================================
+
+    std::vector<VoiceConfig> VoiceCostModel::defaultConfigs(double deviceSampleRate, int outputs)
+    {
+        const double otherRate = std::abs(deviceSampleRate - 44100.0) < 0.5 ? 48000.0 : 44100.0;
+
+        auto make = [deviceSampleRate](const std::string& format, int channels, int outs) {
+            VoiceConfig config;
+            config.format = format;
+            config.channels = channels;
+            config.fileSampleRate = deviceSampleRate;
+            config.outputs = outs;
+            return config;
+        };
+
+        std::vector<VoiceConfig> configs;
+        configs.push_back(make("wav", 2, 2));
+        configs.push_back(make("wav", 1, 2));
+        configs.push_back(make("wav", 6, 2));
+        configs.push_back(make("wav", 8, 2));
+        configs.push_back(make("aiff", 2, 2));
+        configs.push_back(make("flac", 2, 2));
+        configs.push_back(make("ogg", 2, 2));
+
+        VoiceConfig resampled = make("wav", 2, 2);
+        resampled.fileSampleRate = otherRate;
+        configs.push_back(resampled);
+
+        VoiceConfig fading = make("wav", 2, 2);
+        fading.fading = true;
+        configs.push_back(fading);
+
+        resampled.fading = true;
+        configs.push_back(resampled);
+
+        if (outputs > 2) {
+            configs.push_back(make("wav", 2, outputs));
+            configs.push_back(make("wav", std::min(outputs, 8), outputs));
+        }
+
+        return configs;
+    }
+
+    bool VoiceCostModel::calibrate(const CalibrationSettings& settings,
+        std::string* error,
+        const std::function<void(const std::string&)>& progress)
+    {
+        auto fail = [error](const std::string& message) {
+            if (error) {
+                *error = message;
+            }
+            return false;
+        };
+        auto report = [&progress](const std::string& message) {
+            if (progress) {
+                progress(message);
+            }
+        };
+
+        const std::vector<VoiceConfig> configs = settings.configs.empty()
+            ? defaultConfigs(settings.sampleRate, 2)
+            : settings.configs;
+        const int voices = std::max(1, settings.voices);
+        const int blocks = std::max(16, settings.blocks);
+
+        // Enough material that no voice runs out during its measurement
+        const double fileSeconds = (WarmupBlocks * 2 + blocks) * settings.bufferSize / settings.sampleRate + 1.0;
+        const juce::File tempDir = juce::File::getSpecialLocation(juce::File::tempDirectory)
+            .getChildFile("cueforge-voice-cost");
+        tempDir.createDirectory();
+
+        std::vector<Entry> entries;
+        std::map<std::string, juce::File> files;
+        double baseTotal = 0.0;
+        double baseP99 = 0.0;
+
+        for (const VoiceConfig& config : configs) {
+            // One test file per format/channels/rate, shared by outputs and fades
+            const std::string fileKey = config.format + "-" + std::to_string(config.channels) + "ch-"
+                + std::to_string(static_cast<int>(config.fileSampleRate));
+            auto existing = files.find(fileKey);
+            if (existing == files.end()) {
+                const juce::File file = tempDir.getChildFile(fileKey + "." + config.format);
+                if (!writeTestFile(file, config, fileSeconds)) {
+                    report("skipped " + config.describe() + " (no writer for this format)");
+                    continue;
+                }
+                existing = files.emplace(fileKey, file).first;
+            }
+
+            NullAudioSettings nullSettings;
+            nullSettings.sampleRate = settings.sampleRate;
+            nullSettings.bufferSize = settings.bufferSize;
+            nullSettings.outputChannels = config.outputs;
+            nullSettings.clock = NullAudioSettings::Clock::Manual;
+            nullSettings.captureRingSeconds = 0.0;
+
+            JuceAudioEngine engine;
+            if (!engine.initializeNull(nullSettings) || engine.getNullDevice() == nullptr) {
+                return fail("null device failed to start for " + config.describe());
+            }
+            NullAudioIODevice* device = engine.getNullDevice();
+
+            device->renderBlocks(WarmupBlocks);
+            const BlockTimes idle = timeBlocks(device, engine, {}, blocks, false);
+
+            std::vector<int> players;
+            const std::string path = existing->second.getFullPathName().toStdString();
+            for (int v = 0; v < voices; ++v) {
+                const int id = engine.createPlayer(path);
+                if (id < 0) {
+                    break;
+                }
+                players.push_back(id);
+                engine.getPlayer(id)->play();
+            }
+            if (static_cast<int>(players.size()) != voices) {
+                engine.shutdown();
+                return fail("could not create players for " + config.describe());
+            }
+
+            device->renderBlocks(WarmupBlocks);
+            const BlockTimes loaded = timeBlocks(device, engine, players, blocks, config.fading);
+
+            for (int id : players) {
+                engine.removePlayer(id);
+            }
+            engine.shutdown();
+
+            Entry entry;
+            entry.config = config;
+            entry.perVoiceUs = std::max(0.0, (loaded.meanUs - idle.meanUs) / voices);
+            entry.perVoiceP99Us = std::max(entry.perVoiceUs, (loaded.p99Us - idle.p99Us) / voices);
+            entries.push_back(entry);
+
+            baseTotal += idle.meanUs;
+            baseP99 = std::max(baseP99, idle.p99Us);
+
+            char line[160];
+            std::snprintf(line, sizeof(line), "%-36s %8.2f us/voice mean  %8.2f p99",
+                config.describe().c_str(), entry.perVoiceUs, entry.perVoiceP99Us);
+            report(line);
+        }
+
+        for (const auto& file : files) {
+            file.second.deleteFile();
+        }
+
+        if (entries.empty()) {
+            return fail("no configuration could be measured");
+        }
+
+        entries_ = std::move(entries);
+        sampleRate_ = settings.sampleRate;
+        bufferSize_ = settings.bufferSize;
+        baseUs_ = baseTotal / entries_.size();
+        baseP99Us_ = baseP99;
+        return true;
+    }
+
+    // ============================================================================
+    // Estimation
+    // ============================================================================
+
+    double VoiceCostModel::blockPeriodUs() const
+    {
+        return sampleRate_ > 0.0 ? bufferSize_ * 1.0e6 / sampleRate_ : 0.0;
+    }
+
+    double VoiceCostModel::voiceCostUs(const VoiceConfig& config, bool peak) const
+    {
+        const Entry* best = nullptr;
+        double bestScore = 0.0;
+        const bool resampled = isResampled(config, sampleRate_);
+
+        for (const Entry& entry : entries_) {
+            if (entry.config == config) {
+                return peak ? entry.perVoiceP99Us : entry.perVoiceUs;
+            }
+
+            // Lower is closer; properties that change the per-sample work
+            // outweigh the ones that only scale it
+            double score = 0.0;
+            score += entry.config.format != config.format ? 8.0 : 0.0;
+            score += isResampled(entry.config, sampleRate_) != resampled ? 4.0 : 0.0;
+            score += entry.config.fading != config.fading ? 2.0 : 0.0;
+            score += std::abs(entry.config.channels - config.channels) * 0.1;
+            score += std::abs(entry.config.outputs - config.outputs) * 0.01;
+
+            if (!best || score < bestScore) {
+                best = &entry;
+                bestScore = score;
+            }
+        }
+
+        if (!best) {
+            return 0.0;
+        }
+        const double cost = peak ? best->perVoiceP99Us : best->perVoiceUs;
+        return cost * config.channels / std::max(1, best->config.channels);
+    }
+
+    // ============================================================================
+    // Persistence
+    // ============================================================================
+
+    std::string VoiceCostModel::toJson() const
+    {
+        juce::Array<juce::var> list;
+        for (const Entry& entry : entries_) {
+            auto* object = new juce::DynamicObject();
+            object->setProperty("format", juce::String(entry.config.format));
+            object->setProperty("channels", entry.config.channels);
+            object->setProperty("fileSampleRate", entry.config.fileSampleRate);
+            object->setProperty("outputs", entry.config.outputs);
+            object->setProperty("fading", entry.config.fading);
+            object->setProperty("perVoiceUs", entry.perVoiceUs);
+            object->setProperty("perVoiceP99Us", entry.perVoiceP99Us);
+            list.add(juce::var(object));
+        }
+
+        auto* root = new juce::DynamicObject();
+        root->setProperty("version", 1);
+        root->setProperty("host", juce::SystemStats::getComputerName());
+        root->setProperty("cpu", juce::SystemStats::getCpuModel());
+        root->setProperty("sampleRate", sampleRate_);
+        root->setProperty("bufferSize", bufferSize_);
+        root->setProperty("baseUs", baseUs_);
+        root->setProperty("baseP99Us", baseP99Us_);
+        root->setProperty("entries", list);
+
+        return juce::JSON::toString(juce::var(root)).toStdString();
+    }
+
+    bool VoiceCostModel::fromJson(const std::string& json, std::string* error)
+    {
+        auto fail = [error](const std::string& message) {
+            if (error) {
+                *error = message;
+            }
+            return false;
+        };
+
+        juce::var root;
+        const juce::Result parsed = juce::JSON::parse(juce::String(json), root);
+        if (parsed.failed() || !root.isObject()) {
+            return fail("not a cost profile: " + parsed.getErrorMessage().toStdString());
+        }
+
+        const juce::Array<juce::var>* list = root["entries"].getArray();
+        const double sampleRate = root["sampleRate"];
+        const int bufferSize = root["bufferSize"];
+        if (!list || list->isEmpty() || sampleRate <= 0.0 || bufferSize <= 0) {
+            return fail("cost profile has no entries");
+        }
+
+        std::vector<Entry> entries;
+        for (const juce::var& item : *list) {
+            Entry entry;
+            entry.config.format = item["format"].toString().toStdString();
+            entry.config.channels = item["channels"];
+            entry.config.fileSampleRate = item["fileSampleRate"];
+            entry.config.outputs = item["outputs"];
+            entry.config.fading = item["fading"];
+            entry.perVoiceUs = item["perVoiceUs"];
+            entry.perVoiceP99Us = item["perVoiceP99Us"];
+            entries.push_back(entry);
+        }
+
+        entries_ = std::move(entries);
+        sampleRate_ = sampleRate;
+        bufferSize_ = bufferSize;
+        baseUs_ = root["baseUs"];
+        baseP99Us_ = root["baseP99Us"];
+        return true;
+    }
+
+    bool VoiceCostModel::save(const std::string& path, std::string* error) const
+    {
+        if (!juce::File(path).replaceWithText(toJson())) {
+            if (error) {
+                *error = "cannot write " + path;
+            }
+            return false;
+        }
+        return true;
+    }
+
+    bool VoiceCostModel::load(const std::string& path, std::string* error)
+    {
+        const juce::File file(path);
+        if (!file.existsAsFile()) {
+            if (error) {
+                *error = "cannot read " + path;
+            }
+            return false;
+        }
+        return fromJson(file.loadFileAsString().toStdString(), error);
+    }
+
+    bool VoiceCostModel::probeFile(const std::string& path, VoiceConfig& config, double* durationSeconds)
+    {
+        const juce::File file(path);
+        if (!file.existsAsFile()) {
+            return false;
+        }
+
+        juce::AudioFormatManager formats;
+        formats.registerBasicFormats();
+        std::unique_ptr<juce::AudioFormatReader> reader(formats.createReaderFor(file));
+        if (!reader || reader->sampleRate <= 0.0) {
+            return false;
+        }
+
+        config.format = file.getFileExtension().trimCharactersAtStart(".").toLowerCase().toStdString();
+        config.channels = static_cast<int>(reader->numChannels);
+        config.fileSampleRate = reader->sampleRate;
+        if (durationSeconds) {
+            *durationSeconds = reader->lengthInSamples / reader->sampleRate;
+        }
+        return true;
+    }
+
+} // namespace CueForge
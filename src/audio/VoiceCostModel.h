@@ -0,0 +1,100 @@
+// ============================================================================
+// VoiceCostModel.h - Measured per-voice render cost for capacity planning
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace CueForge {
+
+    /**
+     * What one playing voice looks like to the engine - enough to tell
+     * configurations with different render costs apart
+     */
+    struct VoiceConfig
+    {
+        std::string format = "wav";     // File extension: wav, aiff, flac, ogg, mp3
+        int channels = 2;               // Source channels
+        double fileSampleRate = 48000.0;// Resampled when it differs from the device
+        int outputs = 2;                // Device outputs mixed into (routing width)
+        bool fading = false;            // Gain changing every block
+
+        bool operator==(const VoiceConfig& other) const;
+        std::string describe() const;   // "wav 2ch 44100Hz -> 2 out, fading"
+    };
+
+    /**
+     * Render cost of each voice configuration on this host.
+     *
+     * calibrate() drives a fresh JuceAudioEngine on a manually clocked null
+     * device for every configuration: a generated test file in that format
+     * is played by N simultaneous players and the callback is timed block by
+     * block, with and without the players, so the difference is what one
+     * voice adds to the audio callback. Results are kept as mean and p99
+     * microseconds per block and can be saved, so a show is planned against
+     * the machine that will run it without recalibrating each time.
+     */
+    class VoiceCostModel
+    {
+    public:
+        struct CalibrationSettings
+        {
+            double sampleRate = 48000.0;
+            int bufferSize = 256;
+            int voices = 8;         // Players per measurement
+            int blocks = 400;       // Timed callbacks per measurement
+            std::vector<VoiceConfig> configs;   // Empty = defaultConfigs()
+        };
+
+        struct Entry
+        {
+            VoiceConfig config;
+            double perVoiceUs = 0.0;      // Mean added callback time per voice
+            double perVoiceP99Us = 0.0;   // p99 added callback time per voice
+        };
+
+        // Formats x channel counts x resampling x fades x output widths
+        // that cover what cues in a typical show play
+        static std::vector<VoiceConfig> defaultConfigs(double deviceSampleRate, int outputs);
+
+        bool calibrate(const CalibrationSettings& settings,
+            std::string* error = nullptr,
+            const std::function<void(const std::string&)>& progress = {});
+
+        bool isCalibrated() const { return !entries_.empty(); }
+        const std::vector<Entry>& entries() const { return entries_; }
+
+        double sampleRate() const { return sampleRate_; }
+        int bufferSize() const { return bufferSize_; }
+        double blockPeriodUs() const;
+
+        // Callback time with no voices playing (mixer, device, bookkeeping)
+        double baseUs(bool peak = false) const { return peak ? baseP99Us_ : baseUs_; }
+
+        // Per-block cost of one voice. Without an exact calibrated match the
+        // closest entry (format, resampling, fade, then channels and outputs)
+        // is scaled by the source channel ratio.
+        double voiceCostUs(const VoiceConfig& config, bool peak = false) const;
+
+        std::string toJson() const;
+        bool fromJson(const std::string& json, std::string* error = nullptr);
+        bool save(const std::string& path, std::string* error = nullptr) const;
+        bool load(const std::string& path, std::string* error = nullptr);
+
+        // Read an audio file header into the fields of a VoiceConfig
+        // (format, channels, sample rate). Outputs and fading are untouched.
+        static bool probeFile(const std::string& path, VoiceConfig& config, double* durationSeconds = nullptr);
+
+    private:
+        std::vector<Entry> entries_;
+        double sampleRate_ = 0.0;
+        int bufferSize_ = 0;
+        double baseUs_ = 0.0;
+        double baseP99Us_ = 0.0;
+    };
+
+} // namespace CueForge
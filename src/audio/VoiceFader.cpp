@@ -0,0 +1,126 @@
+// ============================================================================
+// VoiceFader.cpp - Sample-accurate fade stage for crossfading players
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#include "VoiceFader.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace CueForge {
+
+    namespace {
+        // Quarter sine sampled once at load, so the audio thread never calls
+        // std::sin. Linear interpolation between 1024 segments stays within
+        // 3e-7 of the true curve.
+        struct EqualPowerTable
+        {
+            static constexpr int Segments = 1024;
+            std::array<float, Segments + 1> gains;
+
+            EqualPowerTable()
+            {
+                for (int i = 0; i <= Segments; ++i) {
+                    gains[static_cast<size_t>(i)] = static_cast<float>(
+                        std::sin(juce::MathConstants<double>::halfPi * i / Segments));
+                }
+            }
+        };
+
+        const EqualPowerTable equalPower;
+    }
+
+    float VoiceFader::gainAt(FadeCurve curve, double t)
+    {
+        t = juce::jlimit(0.0, 1.0, t);
+        if (curve == FadeCurve::Linear) {
+            return static_cast<float>(t);
+        }
+
+        const double position = t * EqualPowerTable::Segments;
+        const int index = std::min(static_cast<int>(position), EqualPowerTable::Segments - 1);
+        const float from = equalPower.gains[static_cast<size_t>(index)];
+        const float to = equalPower.gains[static_cast<size_t>(index) + 1];
+        return from + static_cast<float>(position - index) * (to - from);
+    }
+
+    void VoiceFader::startFade(bool fadeIn, int64_t lengthSamples, FadeCurve curve)
+    {
+        fadeIn_ = fadeIn;
+        curve_ = curve;
+        length_ = std::max<int64_t>(1, lengthSamples);
+        position_ = 0;
+        resetPending_.store(false, std::memory_order_relaxed);
+        fadedOut_.store(false, std::memory_order_release);
+        fading_.store(true, std::memory_order_release);
+        held_.store(false, std::memory_order_release);
+    }
+
+    void VoiceFader::hold()
+    {
+        held_.store(true, std::memory_order_release);
+    }
+
+    void VoiceFader::reset()
+    {
+        // The audio thread clears its own state at the start of its next block
+        resetPending_.store(true, std::memory_order_release);
+        held_.store(false, std::memory_order_release);
+        fading_.store(false, std::memory_order_release);
+        fadedOut_.store(false, std::memory_order_release);
+    }
+
+    void VoiceFader::prepareToPlay(int samplesPerBlockExpected, double sampleRate)
+    {
+        source_->prepareToPlay(samplesPerBlockExpected, sampleRate);
+    }
+
+    void VoiceFader::releaseResources()
+    {
+        source_->releaseResources();
+    }
+
+    void VoiceFader::getNextAudioBlock(const juce::AudioSourceChannelInfo& info)
+    {
+        if (resetPending_.exchange(false, std::memory_order_acquire)) {
+            length_ = 0;
+            position_ = 0;
+            fading_.store(false, std::memory_order_release);
+            fadedOut_.store(false, std::memory_order_release);
+        }
+
+        // Not pulled while held, so the source stays at its start
+        if (held_.load(std::memory_order_relaxed) || fadedOut_.load(std::memory_order_relaxed)) {
+            info.clearActiveBufferRegion();
+            return;
+        }
+
+        source_->getNextAudioBlock(info);
+        if (!fading_.load(std::memory_order_relaxed)) {
+            return;
+        }
+
+        // Per sample, so the ramp is exact whatever the block size
+        const int numChannels = info.buffer->getNumChannels();
+        float* const* data = info.buffer->getArrayOfWritePointers();
+        const int count = static_cast<int>(std::min<int64_t>(info.numSamples, length_ - position_));
+        for (int i = 0; i < count; ++i) {
+            const double t = static_cast<double>(position_ + i) / length_;
+            const float gain = gainAt(curve_, fadeIn_ ? t : 1.0 - t);
+            for (int channel = 0; channel < numChannels; ++channel) {
+                data[channel][info.startSample + i] *= gain;
+            }
+        }
+        if (!fadeIn_ && count < info.numSamples) {
+            info.buffer->clear(info.startSample + count, info.numSamples - count);
+        }
+
+        position_ += count;
+        if (position_ >= length_) {
+            fading_.store(false, std::memory_order_release);
+            fadedOut_.store(!fadeIn_, std::memory_order_release);
+        }
+    }
+
+} // namespace CueForge
@@ -0,0 +1,73 @@
+// ============================================================================
+// VoiceFader.h - Sample-accurate fade stage for crossfading players
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <atomic>
+#include <cstdint>
+
+namespace CueForge {
+
+    enum class FadeCurve {
+        EqualPower,     // sin/cos: constant power, for uncorrelated material
+        Linear          // Constant amplitude, for correlated material
+    };
+
+    /**
+     * Wraps a player's transport in the mixer and applies a fade envelope
+     * counted in output samples. With no fade it passes audio through
+     * untouched; after a fade out it stays silent until reset.
+     *
+     * Fades in and out follow the same curve mirrored in time, so two
+     * faders started in the same block cross on matching ramps from the
+     * same sample. The engine makes that so by queueing every fade of a
+     * crossfade as one batch that the audio thread starts before it pulls
+     * the players: startFade() and getNextAudioBlock() run on the audio
+     * thread only. A voice waiting to fade in is held silent, without
+     * pulling its source, so its transport can be started beforehand from
+     * the control thread.
+     */
+    class VoiceFader : public juce::AudioSource
+    {
+    public:
+        explicit VoiceFader(juce::AudioSource* source) : source_(source) {}
+
+        // Gain at t in [0, 1] of a fade in; a fade out is gainAt(1 - t).
+        // Equal power reads a table, so it is cheap enough per sample.
+        static float gainAt(FadeCurve curve, double t);
+
+        // Audio thread. The fade's first sample is the first sample of the
+        // next block pulled.
+        void startFade(bool fadeIn, int64_t lengthSamples, FadeCurve curve);
+
+        // Control thread. hold() silences the voice until its fade in
+        // starts; reset() drops any fade so the voice is audible again.
+        void hold();
+        void reset();
+
+        bool isFading() const { return fading_.load(std::memory_order_acquire); }
+        bool isFadedOut() const { return fadedOut_.load(std::memory_order_acquire); }
+
+        void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
+        void releaseResources() override;
+        void getNextAudioBlock(const juce::AudioSourceChannelInfo& info) override;
+
+    private:
+        juce::AudioSource* source_;
+
+        // Audio thread only
+        bool fadeIn_ = false;
+        FadeCurve curve_ = FadeCurve::EqualPower;
+        int64_t length_ = 0;
+        int64_t position_ = 0;
+
+        std::atomic<bool> held_{ false };
+        std::atomic<bool> resetPending_{ false };
+        std::atomic<bool> fading_{ false };
+        std::atomic<bool> fadedOut_{ false };
+    };
+
+} // namespace CueForge
@@ -5,10 +5,27 @@
 // ============================================================================
 
 #include "JuceEngineStandalone.h"
+#include <chrono>
 #include <iostream>
 
 namespace CueForgePhase1 {
 
+    namespace {
+        int64_t nowNanos()
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        void updateMax(std::atomic<int64_t>& target, int64_t value)
+        {
+            int64_t current = target.load(std::memory_order_relaxed);
+            while (value > current &&
+                !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+            }
+        }
+    }
+
     // ============================================================================
     // JuceEngineStandalone Implementation
     // ============================================================================
@@ -16,6 +33,14 @@ namespace CueForgePhase1 {
     JuceEngineStandalone::JuceEngineStandalone()
         : nextPlayerId_(1)
         , initialized_(false)
+        , blockNanos_(0)
+        , callbackCount_(0)
+        , callbackOverruns_(0)
+        , callbackNanosTotal_(0)
+        , callbackNanosMax_(0)
+        , lockCount_(0)
+        , lockWaitNanosTotal_(0)
+        , lockWaitNanosMax_(0)
     {
         // Register audio formats - basic formats included by default
         formatManager_.registerBasicFormats(); // WAV, AIFF
@@ -89,6 +114,53 @@ namespace CueForgePhase1 {
         return true;
     }
 
+    bool JuceEngineStandalone::initializeNull(const CueForge::NullAudioSettings& settings)
+    {
+        if (initialized_) {
+            std::cout << "JuceEngineStandalone: Already initialized" << std::endl;
+            return true;
+        }
+
+        std::cout << "JuceEngineStandalone: Initializing null device..." << std::endl;
+
+        // Registering the type first stops AudioDeviceManager probing hardware
+        deviceManager_.addAudioDeviceType(std::make_unique<CueForge::NullAudioIODeviceType>(settings));
+
+        juce::AudioDeviceManager::AudioDeviceSetup setup;
+        setup.outputDeviceName = CueForge::NullAudioIODevice::DeviceName;
+        setup.sampleRate = settings.sampleRate;
+        setup.bufferSize = settings.bufferSize;
+
+        juce::String error = deviceManager_.initialise(
+            0,
+            settings.outputChannels,
+            nullptr,
+            false,
+            {},
+            &setup
+        );
+
+        if (error.isNotEmpty()) {
+            std::cerr << "Null device init failed: " << error.toStdString() << std::endl;
+            return false;
+        }
+
+        deviceManager_.addAudioCallback(this);
+
+        initialized_ = true;
+
+        std::cout << "Null device initialized:" << std::endl;
+        std::cout << "  Sample Rate: " << getSampleRate() << " Hz" << std::endl;
+        std::cout << "  Buffer Size: " << getBufferSize() << " samples" << std::endl;
+
+        return true;
+    }
+
+    CueForge::NullAudioIODevice* JuceEngineStandalone::getNullDevice() const
+    {
+        return dynamic_cast<CueForge::NullAudioIODevice*>(deviceManager_.getCurrentAudioDevice());
+    }
+
     void JuceEngineStandalone::shutdown()
     {
         if (!initialized_) {
@@ -196,6 +268,8 @@ namespace CueForgePhase1 {
         // CRITICAL: This runs on the audio thread - must be real-time safe!
         // NO allocations, NO locks (except very brief ones), NO I/O
 
+        const int64_t callbackStart = nowNanos();
+
         // Create audio buffer for output
         juce::AudioBuffer<float> buffer(outputChannelData, numOutputChannels, numSamples);
 
@@ -209,6 +283,16 @@ namespace CueForgePhase1 {
         channelInfo.numSamples = numSamples;
 
         mixer_.getNextAudioBlock(channelInfo);
+
+        const int64_t elapsed = nowNanos() - callbackStart;
+        callbackCount_.fetch_add(1, std::memory_order_relaxed);
+        callbackNanosTotal_.fetch_add(elapsed, std::memory_order_relaxed);
+        updateMax(callbackNanosMax_, elapsed);
+
+        const int64_t blockNanos = blockNanos_.load(std::memory_order_relaxed);
+        if (blockNanos > 0 && elapsed > blockNanos) {
+            callbackOverruns_.fetch_add(1, std::memory_order_relaxed);
+        }
     }
 
     void JuceEngineStandalone::audioDeviceAboutToStart(juce::AudioIODevice* device)
@@ -221,6 +305,10 @@ namespace CueForgePhase1 {
         std::cout << "  Sample Rate: " << device->getCurrentSampleRate() << " Hz" << std::endl;
         std::cout << "  Buffer Size: " << device->getCurrentBufferSizeSamples() << " samples" << std::endl;
 
+        blockNanos_.store(static_cast<int64_t>(
+            device->getCurrentBufferSizeSamples() * 1.0e9 / device->getCurrentSampleRate()),
+            std::memory_order_relaxed);
+
         // Prepare mixer for playback
         mixer_.prepareToPlay(
             device->getCurrentBufferSizeSamples(),
@@ -241,7 +329,9 @@ namespace CueForgePhase1 {
             return -1;
         }
 
+        const int64_t waitStart = nowNanos();
         juce::ScopedLock lock(playerLock_);
+        recordLockWait(nowNanos() - waitStart);
 
         int playerId = nextPlayerId_++;
 
@@ -267,7 +357,9 @@ namespace CueForgePhase1 {
 
     void JuceEngineStandalone::removePlayer(int playerId)
     {
+        const int64_t waitStart = nowNanos();
         juce::ScopedLock lock(playerLock_);
+        recordLockWait(nowNanos() - waitStart);
 
         auto it = players_.find(playerId);
         if (it != players_.end()) {
@@ -286,7 +378,9 @@ namespace CueForgePhase1 {
 
     AudioPlayer* JuceEngineStandalone::getPlayer(int playerId)
     {
+        const int64_t waitStart = nowNanos();
         juce::ScopedLock lock(playerLock_);
+        recordLockWait(nowNanos() - waitStart);
 
         auto it = players_.find(playerId);
         if (it != players_.end()) {
@@ -314,6 +408,44 @@ namespace CueForgePhase1 {
         return 512; // Default fallback
     }
 
+    EngineStats JuceEngineStandalone::getStats() const
+    {
+        EngineStats stats;
+
+        stats.callbacks = callbackCount_.load(std::memory_order_relaxed);
+        stats.callbackOverruns = callbackOverruns_.load(std::memory_order_relaxed);
+        stats.callbackMaxUs = callbackNanosMax_.load(std::memory_order_relaxed) / 1000.0;
+        if (stats.callbacks > 0) {
+            stats.callbackMeanUs = callbackNanosTotal_.load(std::memory_order_relaxed) / 1000.0 / stats.callbacks;
+        }
+
+        stats.lockAcquisitions = lockCount_.load(std::memory_order_relaxed);
+        stats.lockWaitMaxUs = lockWaitNanosMax_.load(std::memory_order_relaxed) / 1000.0;
+        if (stats.lockAcquisitions > 0) {
+            stats.lockWaitMeanUs = lockWaitNanosTotal_.load(std::memory_order_relaxed) / 1000.0 / stats.lockAcquisitions;
+        }
+
+        return stats;
+    }
+
+    void JuceEngineStandalone::resetStats()
+    {
+        callbackCount_.store(0, std::memory_order_relaxed);
+        callbackOverruns_.store(0, std::memory_order_relaxed);
+        callbackNanosTotal_.store(0, std::memory_order_relaxed);
+        callbackNanosMax_.store(0, std::memory_order_relaxed);
+        lockCount_.store(0, std::memory_order_relaxed);
+        lockWaitNanosTotal_.store(0, std::memory_order_relaxed);
+        lockWaitNanosMax_.store(0, std::memory_order_relaxed);
+    }
+
+    void JuceEngineStandalone::recordLockWait(int64_t waitNs)
+    {
+        lockCount_.fetch_add(1, std::memory_order_relaxed);
+        lockWaitNanosTotal_.fetch_add(waitNs, std::memory_order_relaxed);
+        updateMax(lockWaitNanosMax_, waitNs);
+    }
+
     // ============================================================================
     // AudioPlayer Implementation
     // ============================================================================
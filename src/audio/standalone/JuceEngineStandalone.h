@@ -9,6 +9,9 @@
 #include <juce_audio_devices/juce_audio_devices.h>
 #include <juce_audio_formats/juce_audio_formats.h>
 #include <juce_audio_utils/juce_audio_utils.h>
+#include "audio/NullAudioDevice.h"
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <vector>
 #include <string>
@@ -18,6 +21,23 @@ namespace CueForgePhase1 {  // Different namespace to avoid conflicts
 
     class AudioPlayer;
 
+    /**
+     * Counters for validating the concurrency model under load. Callback
+     * figures are measured on the audio thread, lock figures on whichever
+     * control thread acquired playerLock_.
+     */
+    struct EngineStats
+    {
+        uint64_t callbacks = 0;
+        uint64_t callbackOverruns = 0;      // Callback took longer than its block
+        double callbackMeanUs = 0.0;
+        double callbackMaxUs = 0.0;
+
+        uint64_t lockAcquisitions = 0;
+        double lockWaitMeanUs = 0.0;
+        double lockWaitMaxUs = 0.0;
+    };
+
     class JuceEngineStandalone : public juce::AudioIODeviceCallback
     {
     public:
@@ -29,6 +49,10 @@ namespace CueForgePhase1 {  // Different namespace to avoid conflicts
         void shutdown();
         bool isInitialized() const { return initialized_; }
 
+        // Headless: open the CueForge null device instead of hardware
+        bool initializeNull(const CueForge::NullAudioSettings& settings);
+        CueForge::NullAudioIODevice* getNullDevice() const;
+
         std::vector<std::string> getAvailableDevices();
         std::string getCurrentDevice() const;
         bool setDevice(const std::string& deviceName);
@@ -54,9 +78,15 @@ namespace CueForgePhase1 {  // Different namespace to avoid conflicts
         double getSampleRate() const;
         int getBufferSize() const;
 
+        // Instrumentation
+        EngineStats getStats() const;
+        void resetStats();
+
     private:
         friend class AudioPlayer;
 
+        void recordLockWait(int64_t waitNs);
+
         juce::AudioDeviceManager deviceManager_;
         juce::AudioFormatManager formatManager_;
         juce::MixerAudioSource mixer_;
@@ -68,6 +98,16 @@ namespace CueForgePhase1 {  // Different namespace to avoid conflicts
 
         juce::CriticalSection playerLock_;
 
+        // Instrumentation - relaxed atomics, safe to update on the audio thread
+        std::atomic<int64_t> blockNanos_;
+        std::atomic<uint64_t> callbackCount_;
+        std::atomic<uint64_t> callbackOverruns_;
+        std::atomic<int64_t> callbackNanosTotal_;
+        std::atomic<int64_t> callbackNanosMax_;
+        std::atomic<uint64_t> lockCount_;
+        std::atomic<int64_t> lockWaitNanosTotal_;
+        std::atomic<int64_t> lockWaitNanosMax_;
+
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(JuceEngineStandalone)
     };
 
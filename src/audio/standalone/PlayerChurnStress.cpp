@@ -0,0 +1,320 @@
+// ============================================================================
+// PlayerChurnStress.cpp - Phase 1 player churn stress test
+// Creates, plays, seeks and removes players from several control threads
+// while the null device runs the callback in real time
+// ============================================================================
+
+#include "JuceEngineStandalone.h"
+#include "audio/ProcessMemory.h"
+#include <juce_events/juce_events.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace CueForgePhase1;
+
+namespace {
+
+    struct StressOptions
+    {
+        int threads = 4;
+        double seconds = 10.0;
+        int opsPerSecond = 1000;     // Per control thread; 0 = unthrottled
+        int maxLivePlayers = 16;     // Per control thread
+        int sampleRate = 48000;
+        int bufferSize = 256;
+        std::string file;            // Empty = synthesize a test tone
+        double maxGrowthMb = 32.0;
+        uint64_t maxDropped = 0;
+    };
+
+    struct ThreadCounters
+    {
+        std::atomic<uint64_t> ops{ 0 };
+        std::atomic<uint64_t> creates{ 0 };
+        std::atomic<uint64_t> removes{ 0 };
+        std::atomic<uint64_t> failures{ 0 };
+        std::atomic<int> live{ 0 };
+    };
+
+    // Swallows output without growing, unlike a string stream
+    class NullBuffer : public std::streambuf
+    {
+    protected:
+        int overflow(int c) override { return traits_type::not_eof(c); }
+    };
+
+    bool writeTestTone(const juce::File& file, int sampleRate)
+    {
+        juce::AudioBuffer<float> buffer(2, sampleRate * 2);
+        for (int i = 0; i < buffer.getNumSamples(); ++i) {
+            const float sample = 0.25f * std::sin(juce::MathConstants<float>::twoPi * 440.0f * i / sampleRate);
+            buffer.setSample(0, i, sample);
+            buffer.setSample(1, i, sample);
+        }
+
+        file.deleteFile();
+        std::unique_ptr<juce::OutputStream> stream = file.createOutputStream();
+        if (!stream) {
+            return false;
+        }
+
+        juce::WavAudioFormat wav;
+        std::unique_ptr<juce::AudioFormatWriter> writer(wav.createWriterFor(stream.get(), sampleRate, 2, 16, {}, 0));
+        if (!writer) {
+            return false;
+        }
+        stream.release();
+        return writer->writeFromAudioSampleBuffer(buffer, 0, buffer.getNumSamples());
+    }
+
+    // Each control thread owns its players, so a removed player is never
+    // touched by another thread - what is under test is the engine's own
+    // locking between control threads and the audio callback
+    void controlThread(JuceEngineStandalone& engine, const StressOptions& options,
+        const std::string& file, int index, ThreadCounters& counters, std::atomic<bool>& running)
+    {
+        std::mt19937 random(static_cast<unsigned int>(0x5eed + index));
+        std::vector<int> players;
+
+        const auto interval = options.opsPerSecond > 0
+            ? std::chrono::nanoseconds(1000000000LL / options.opsPerSecond)
+            : std::chrono::nanoseconds(0);
+        auto next = std::chrono::steady_clock::now();
+
+        while (running.load(std::memory_order_relaxed)) {
+            const int choice = static_cast<int>(random() % 100);
+
+            if (players.empty() || (choice < 25 && static_cast<int>(players.size()) < options.maxLivePlayers)) {
+                const int id = engine.createPlayer(file);
+                if (id < 0) {
+                    counters.failures.fetch_add(1, std::memory_order_relaxed);
+                } else {
+                    players.push_back(id);
+                    counters.creates.fetch_add(1, std::memory_order_relaxed);
+                    if (auto* player = engine.getPlayer(id)) {
+                        player->play();
+                    }
+                }
+            } else {
+                const size_t slot = random() % players.size();
+                const int id = players[slot];
+
+                if (choice < 45) {
+                    engine.removePlayer(id);
+                    players[slot] = players.back();
+                    players.pop_back();
+                    counters.removes.fetch_add(1, std::memory_order_relaxed);
+                } else if (auto* player = engine.getPlayer(id)) {
+                    if (choice < 65) {
+                        player->setPosition(player->getDuration() * (random() % 1000) / 1000.0);
+                    } else if (choice < 75) {
+                        player->pause();
+                    } else if (choice < 85) {
+                        player->resume();
+                    } else if (choice < 92) {
+                        player->setVolume((random() % 100) / 100.0f);
+                    } else {
+                        player->stop();
+                        player->play();
+                    }
+                } else {
+                    counters.failures.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+
+            counters.ops.fetch_add(1, std::memory_order_relaxed);
+            counters.live.store(static_cast<int>(players.size()), std::memory_order_relaxed);
+
+            if (interval.count() > 0) {
+                next += interval;
+                std::this_thread::sleep_until(next);
+            }
+        }
+
+        for (int id : players) {
+            engine.removePlayer(id);
+        }
+        counters.live.store(0, std::memory_order_relaxed);
+    }
+
+    bool parseArguments(int argc, char* argv[], StressOptions& options)
+    {
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            const bool hasValue = i + 1 < argc;
+
+            if (arg == "--threads" && hasValue) options.threads = std::max(1, std::atoi(argv[++i]));
+            else if (arg == "--seconds" && hasValue) options.seconds = std::atof(argv[++i]);
+            else if (arg == "--ops" && hasValue) options.opsPerSecond = std::max(0, std::atoi(argv[++i]));
+            else if (arg == "--max-live" && hasValue) options.maxLivePlayers = std::max(1, std::atoi(argv[++i]));
+            else if (arg == "--rate" && hasValue) options.sampleRate = std::atoi(argv[++i]);
+            else if (arg == "--buffer" && hasValue) options.bufferSize = std::atoi(argv[++i]);
+            else if (arg == "--file" && hasValue) options.file = argv[++i];
+            else if (arg == "--max-growth-mb" && hasValue) options.maxGrowthMb = std::atof(argv[++i]);
+            else if (arg == "--max-dropped" && hasValue) options.maxDropped = std::strtoull(argv[++i], nullptr, 10);
+            else return false;
+        }
+        return true;
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    StressOptions options;
+    if (!parseArguments(argc, argv, options)) {
+        std::cerr << "Usage: " << argv[0] << " [--threads N] [--seconds S] [--ops N] [--max-live N]\n"
+                  << "       [--rate Hz] [--buffer N] [--file audio.wav] [--max-growth-mb MB] [--max-dropped N]\n"
+                  << "  --ops is per control thread per second (0 = as fast as possible)" << std::endl;
+        return 2;
+    }
+
+    juce::ScopedJuceInitialiser_GUI juceInit;
+
+    // The engine logs every player operation; keep that off the report
+    std::ostream report(std::cout.rdbuf());
+    NullBuffer discard;
+    std::streambuf* originalCout = std::cout.rdbuf(&discard);
+
+    std::string file = options.file;
+    const juce::File tone = juce::File::getSpecialLocation(juce::File::tempDirectory)
+        .getChildFile("cueforge_churn_tone.wav");
+    if (file.empty()) {
+        if (!writeTestTone(tone, options.sampleRate)) {
+            std::cout.rdbuf(originalCout);
+            std::cerr << "✗ FAIL: Could not write test tone to " << tone.getFullPathName() << std::endl;
+            return 1;
+        }
+        file = tone.getFullPathName().toStdString();
+    }
+
+    CueForge::NullAudioSettings settings;
+    settings.sampleRate = options.sampleRate;
+    settings.bufferSize = options.bufferSize;
+    settings.clock = CueForge::NullAudioSettings::Clock::RealTime;
+    settings.captureRingSeconds = 0.0;
+
+    JuceEngineStandalone engine;
+    if (!engine.initializeNull(settings)) {
+        std::cout.rdbuf(originalCout);
+        std::cerr << "✗ FAIL: Could not open the null device" << std::endl;
+        return 1;
+    }
+
+    report << "Player churn: " << options.threads << " threads x "
+           << (options.opsPerSecond > 0 ? std::to_string(options.opsPerSecond) : std::string("unthrottled"))
+           << " ops/s, " << options.seconds << " s, " << options.sampleRate << " Hz / "
+           << options.bufferSize << " samples" << std::endl;
+    report << "   t     ops/s   live  cb mean/max us   overruns  xruns  lock mean/max us   RSS MB" << std::endl;
+
+    std::vector<std::unique_ptr<ThreadCounters>> counters;
+    std::vector<std::thread> threads;
+    std::atomic<bool> running{ true };
+
+    engine.resetStats();
+    const double startRss = CueForge::residentMemoryMb();
+    double warmRss = startRss;
+
+    for (int i = 0; i < options.threads; ++i) {
+        counters.push_back(std::make_unique<ThreadCounters>());
+        threads.emplace_back(controlThread, std::ref(engine), std::cref(options), std::cref(file), i,
+            std::ref(*counters.back()), std::ref(running));
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    uint64_t lastOps = 0;
+    int second = 0;
+
+    while (std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() < options.seconds) {
+        std::this_thread::sleep_until(start + std::chrono::seconds(++second));
+
+        uint64_t ops = 0;
+        int live = 0;
+        for (const auto& c : counters) {
+            ops += c->ops.load(std::memory_order_relaxed);
+            live += c->live.load(std::memory_order_relaxed);
+        }
+
+        const EngineStats stats = engine.getStats();
+        const int xruns = engine.getNullDevice() ? engine.getNullDevice()->getXRunCount() : 0;
+        const double rss = CueForge::residentMemoryMb();
+
+        // First second is warm-up: allocator pools, reader caches
+        if (second == 1) {
+            warmRss = rss;
+        }
+
+        char line[160];
+        std::snprintf(line, sizeof(line), "%4d %9llu %6d %7.1f / %7.1f %9llu %6d %8.1f / %8.1f %8.1f",
+            second, static_cast<unsigned long long>(ops - lastOps), live,
+            stats.callbackMeanUs, stats.callbackMaxUs,
+            static_cast<unsigned long long>(stats.callbackOverruns), xruns,
+            stats.lockWaitMeanUs, stats.lockWaitMaxUs, rss);
+        report << line << std::endl;
+        lastOps = ops;
+    }
+
+    running.store(false);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    const EngineStats stats = engine.getStats();
+    const int xruns = engine.getNullDevice() ? engine.getNullDevice()->getXRunCount() : 0;
+    const double endRss = CueForge::residentMemoryMb();
+
+    uint64_t ops = 0, creates = 0, removes = 0, failures = 0;
+    for (const auto& c : counters) {
+        ops += c->ops.load();
+        creates += c->creates.load();
+        removes += c->removes.load();
+        failures += c->failures.load();
+    }
+
+    engine.shutdown();
+    std::cout.rdbuf(originalCout);
+    if (options.file.empty()) {
+        tone.deleteFile();
+    }
+
+    const uint64_t dropped = stats.callbackOverruns + static_cast<uint64_t>(xruns);
+    const double growth = endRss - warmRss;
+
+    std::cout << "\n" << std::string(50, '=') << "\n" << std::endl;
+    std::cout << "Operations:      " << ops << " (" << creates << " created, " << removes << " removed, "
+              << failures << " failed)" << std::endl;
+    std::cout << "Callbacks:       " << stats.callbacks << ", mean " << stats.callbackMeanUs
+              << " us, max " << stats.callbackMaxUs << " us" << std::endl;
+    std::cout << "Dropped blocks:  " << dropped << " (" << stats.callbackOverruns << " overruns, "
+              << xruns << " xruns)" << std::endl;
+    std::cout << "playerLock_:     " << stats.lockAcquisitions << " acquisitions, wait mean "
+              << stats.lockWaitMeanUs << " us, max " << stats.lockWaitMaxUs << " us" << std::endl;
+    std::cout << "Memory:          " << startRss << " MB start, " << warmRss << " MB warm, "
+              << endRss << " MB end (" << (growth >= 0 ? "+" : "") << growth << " MB)" << std::endl;
+
+    bool passed = true;
+    if (failures > 0) {
+        std::cerr << "✗ FAIL: " << failures << " player operations failed" << std::endl;
+        passed = false;
+    }
+    if (dropped > options.maxDropped) {
+        std::cerr << "✗ FAIL: " << dropped << " dropped blocks (limit " << options.maxDropped << ")" << std::endl;
+        passed = false;
+    }
+    if (growth > options.maxGrowthMb) {
+        std::cerr << "✗ FAIL: memory grew " << growth << " MB (limit " << options.maxGrowthMb << " MB)" << std::endl;
+        passed = false;
+    }
+
+    if (passed) {
+        std::cout << "✓ Player churn stress PASSED" << std::endl;
+    }
+    return passed ? 0 : 1;
+}
@@ -5,6 +5,8 @@
 
 #include "Cue.h"
 #include "CueManager.h"
+#include "CueJsonKeys.h"
+#include <QHash>
 #include <QUuid>
 #include <QDebug>
 
@@ -36,33 +38,33 @@ namespace CueForge {
         case CueType::Text:     return "Text";
         case CueType::Network:  return "Network";
         case CueType::Light:    return "Light";
+        case CueType::LiveInput: return "LiveInput";
+        case CueType::Stem: return "Stem";
+        case CueType::Playlist: return "Playlist";
+        case CueType::Record: return "Record";
         default:                return "Unknown";
         }
     }
 
     CueType stringToCueType(const QString& str)
     {
-        QString lower = str.toLower();
-        if (lower == "audio") return CueType::Audio;
-        if (lower == "video") return CueType::Video;
-        if (lower == "midi") return CueType::Midi;
-        if (lower == "group") return CueType::Group;
-        if (lower == "fade") return CueType::Fade;
-        if (lower == "wait") return CueType::Wait;
-        if (lower == "start") return CueType::Start;
-        if (lower == "stop") return CueType::Stop;
-        if (lower == "goto") return CueType::Goto;
-        if (lower == "pause") return CueType::Pause;
-        if (lower == "load") return CueType::Load;
-        if (lower == "reset") return CueType::Reset;
-        if (lower == "arm") return CueType::Arm;
-        if (lower == "disarm") return CueType::Disarm;
-        if (lower == "devamp") return CueType::Devamp;
-        if (lower == "memo") return CueType::Memo;
-        if (lower == "text") return CueType::Text;
-        if (lower == "network") return CueType::Network;
-        if (lower == "light") return CueType::Light;
-        return CueType::Audio;
+        // Built once from cueTypeToString(): the canonical spelling (what
+        // toJson() writes) hits directly, other casings after one toLower()
+        static const QHash<QString, CueType> table = [] {
+            QHash<QString, CueType> names;
+            for (int i = static_cast<int>(CueType::Audio); i < static_cast<int>(CueType::Count); ++i) {
+                const CueType type = static_cast<CueType>(i);
+                names.insert(cueTypeToString(type), type);
+                names.insert(cueTypeToString(type).toLower(), type);
+            }
+            return names;
+        }();
+
+        auto it = table.constFind(str);
+        if (it == table.constEnd()) {
+            it = table.constFind(str.toLower());
+        }
+        return it != table.constEnd() ? it.value() : CueType::Audio;
     }
 
     QString cueStatusToString(CueStatus status)
@@ -97,6 +99,9 @@ namespace CueForge {
         , isBroken_(false)
         , createdTime_(QDateTime::currentDateTime())
         , modifiedTime_(QDateTime::currentDateTime())
+        , loadDepth_(0)
+        , loadChanged_(false)
+        , loadHasTimestamp_(false)
     {
     }
 
@@ -192,6 +197,7 @@ namespace CueForge {
         if (isArmed_ != armed) {
             isArmed_ = armed;
             updateModifiedTime();
+            emit armedChanged(armed);
         }
     }
 
@@ -291,62 +297,101 @@ namespace CueForge {
 
     QJsonObject Cue::toJson() const
     {
+        using namespace CueJsonKeys;
         QJsonObject json;
 
-        json["id"] = id_;
-        json["type"] = cueTypeToString(type_);
-        json["number"] = number_;
-        json["name"] = name_;
-        json["duration"] = duration_;
-        json["preWait"] = preWait_;
-        json["postWait"] = postWait_;
-        json["continueMode"] = continueMode_;
-        json["color"] = color_.name();
-        json["notes"] = notes_;
-        json["isArmed"] = isArmed_;
-        json["targetCueId"] = targetCueId_;
-        json["createdTime"] = createdTime_.toString(Qt::ISODate);
-        json["modifiedTime"] = modifiedTime_.toString(Qt::ISODate);
+        json.insert(Id, id_);
+        json.insert(Type, cueTypeToString(type_));
+        json.insert(Number, number_);
+        json.insert(Name, name_);
+        json.insert(Duration, duration_);
+        json.insert(PreWait, preWait_);
+        json.insert(PostWait, postWait_);
+        json.insert(ContinueMode, continueMode_);
+        json.insert(Color, color_.name());
+        json.insert(Notes, notes_);
+        json.insert(IsArmed, isArmed_);
+        json.insert(TargetCueId, targetCueId_);
+        json.insert(CreatedTime, createdTime_.toString(Qt::ISODate));
+        json.insert(ModifiedTime, modifiedTime_.toString(Qt::ISODate));
 
         return json;
     }
 
     void Cue::fromJson(const QJsonObject& json)
     {
-        if (json.contains("id")) {
-            id_ = json["id"].toString();
+        using namespace CueJsonKeys;
+        const LoadScope scope(this);
+
+        // One lookup per key; value() of a missing key is Undefined, which
+        // falls through to the defaults below
+        const QJsonValue idValue = json.value(Id);
+        if (!idValue.isUndefined()) {
+            id_ = idValue.toString();
         }
 
-        setNumber(json.value("number").toString("1"));
-        setName(json.value("name").toString("New Cue"));
-        setDuration(json.value("duration").toDouble(0.0));
-        setPreWait(json.value("preWait").toDouble(0.0));
-        setPostWait(json.value("postWait").toDouble(0.0));
-        setContinueMode(json.value("continueMode").toBool(false));
+        setNumber(json.value(Number).toString("1"));
+        setName(json.value(Name).toString("New Cue"));
+        setDuration(json.value(Duration).toDouble(0.0));
+        setPreWait(json.value(PreWait).toDouble(0.0));
+        setPostWait(json.value(PostWait).toDouble(0.0));
+        setContinueMode(json.value(ContinueMode).toBool(false));
 
-        if (json.contains("color")) {
-            setColor(QColor(json["color"].toString()));
+        const QJsonValue colorValue = json.value(Color);
+        if (!colorValue.isUndefined()) {
+            setColor(QColor(colorValue.toString()));
         }
 
-        setNotes(json.value("notes").toString());
-        setArmed(json.value("isArmed").toBool(true));
-        setTargetCueId(json.value("targetCueId").toString());
+        setNotes(json.value(Notes).toString());
+        setArmed(json.value(IsArmed).toBool(true));
+        setTargetCueId(json.value(TargetCueId).toString());
 
-        if (json.contains("createdTime")) {
-            createdTime_ = QDateTime::fromString(json["createdTime"].toString(), Qt::ISODate);
+        const QJsonValue createdValue = json.value(CreatedTime);
+        if (!createdValue.isUndefined()) {
+            createdTime_ = QDateTime::fromString(createdValue.toString(), Qt::ISODate);
+        }
+        const QJsonValue modifiedValue = json.value(ModifiedTime);
+        if (!modifiedValue.isUndefined()) {
+            modifiedTime_ = QDateTime::fromString(modifiedValue.toString(), Qt::ISODate);
+            loadHasTimestamp_ = true;
         }
-        if (json.contains("modifiedTime")) {
-            modifiedTime_ = QDateTime::fromString(json["modifiedTime"].toString(), Qt::ISODate);
+    }
+
+    Cue::LoadScope::LoadScope(Cue* cue)
+        : cue_(cue)
+    {
+        if (cue_->loadDepth_++ == 0) {
+            cue_->loadChanged_ = false;
+            cue_->loadHasTimestamp_ = false;
         }
     }
 
+    Cue::LoadScope::~LoadScope()
+    {
+        if (--cue_->loadDepth_ > 0 || !cue_->loadChanged_) {
+            return;
+        }
+
+        if (!cue_->loadHasTimestamp_) {
+            cue_->modifiedTime_ = QDateTime::currentDateTime();
+        }
+        emit cue_->modified();
+    }
+
     // ============================================================================
     // Timestamps
     // ============================================================================
 
     void Cue::updateModifiedTime()
     {
+        // Inside fromJson() - stamped and signalled once by LoadScope
+        if (loadDepth_ > 0) {
+            loadChanged_ = true;
+            return;
+        }
+
         modifiedTime_ = QDateTime::currentDateTime();
+        emit modified();
     }
 
 } // namespace CueForge
\ No newline at end of file
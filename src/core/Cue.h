@@ -36,7 +36,13 @@ namespace CueForge {
         Memo,
         Text,
         Network,
-        Light
+        Light,
+        LiveInput,
+        Stem,
+        Playlist,
+        Record,
+
+        Count   // Not a type: the number of types, so loops cover new ones
     };
 
     enum class CueStatus {
@@ -149,13 +155,35 @@ namespace CueForge {
         void colorChanged(const QColor& color);
         void notesChanged(const QString& notes);
         void statusChanged(CueStatus status);
+        void armedChanged(bool armed);
         void executionStarted();
         void executionFinished();
         void executionProgress(double progress);
+        void modified();
         void error(const QString& message);
         void warning(const QString& message);
 
     protected:
+        /**
+         * Held by every fromJson() override for its whole body. Setters run
+         * inside it skip their per-call timestamp and modified() signal;
+         * when the outermost scope closes, the saved modifiedTime is kept
+         * (or the cue is stamped once if none was saved) and modified() is
+         * emitted a single time if anything changed.
+         */
+        class LoadScope
+        {
+        public:
+            explicit LoadScope(Cue* cue);
+            ~LoadScope();
+
+            LoadScope(const LoadScope&) = delete;
+            LoadScope& operator=(const LoadScope&) = delete;
+
+        private:
+            Cue* cue_;
+        };
+
         QString id_;
         CueType type_;
         QString number_;
@@ -172,6 +200,11 @@ namespace CueForge {
         QString targetCueId_;
         QDateTime createdTime_;
         QDateTime modifiedTime_;
+
+    private:
+        int loadDepth_;
+        bool loadChanged_;
+        bool loadHasTimestamp_;
     };
 
     QString cueTypeToString(CueType type);
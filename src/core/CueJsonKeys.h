@@ -0,0 +1,101 @@
+// ============================================================================
+// CueJsonKeys.h - Workspace/cue JSON key constants
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#pragma once
+
+#include <QString>
+
+namespace CueForge {
+
+    /**
+     * Keys used by Cue::toJson()/fromJson() and the workspace format.
+     *
+     * Latin-1 views are built at compile time and QJsonObject stores and
+     * compares ASCII keys without converting to UTF-16, so a lookup or
+     * insert through these never allocates a temporary QString the way a
+     * json["key"] literal does.
+     */
+    namespace CueJsonKeys {
+
+        // Cue
+        inline constexpr QLatin1StringView Id("id");
+        inline constexpr QLatin1StringView Type("type");
+        inline constexpr QLatin1StringView Number("number");
+        inline constexpr QLatin1StringView Name("name");
+        inline constexpr QLatin1StringView Duration("duration");
+        inline constexpr QLatin1StringView PreWait("preWait");
+        inline constexpr QLatin1StringView PostWait("postWait");
+        inline constexpr QLatin1StringView ContinueMode("continueMode");
+        inline constexpr QLatin1StringView Color("color");
+        inline constexpr QLatin1StringView Notes("notes");
+        inline constexpr QLatin1StringView IsArmed("isArmed");
+        inline constexpr QLatin1StringView TargetCueId("targetCueId");
+        inline constexpr QLatin1StringView CreatedTime("createdTime");
+        inline constexpr QLatin1StringView ModifiedTime("modifiedTime");
+
+        // Media (audio/video)
+        inline constexpr QLatin1StringView FilePath("filePath");
+        inline constexpr QLatin1StringView Volume("volume");
+        inline constexpr QLatin1StringView Pan("pan");
+        inline constexpr QLatin1StringView Rate("rate");
+        inline constexpr QLatin1StringView StartTime("startTime");
+        inline constexpr QLatin1StringView EndTime("endTime");
+        inline constexpr QLatin1StringView AudioOutputPatch("audioOutputPatch");
+        inline constexpr QLatin1StringView MatrixRouting("matrixRouting");
+        inline constexpr QLatin1StringView Opacity("opacity");
+        inline constexpr QLatin1StringView LoopEnabled("loopEnabled");
+        inline constexpr QLatin1StringView VideoStage("videoStage");
+        inline constexpr QLatin1StringView Geometry("geometry");
+        inline constexpr QLatin1StringView FadeInTime("fadeInTime");
+        inline constexpr QLatin1StringView Stems("stems");
+        inline constexpr QLatin1StringView Tracks("tracks");
+        inline constexpr QLatin1StringView CrossfadeTime("crossfadeTime");
+        inline constexpr QLatin1StringView Shuffle("shuffle");
+        inline constexpr QLatin1StringView ReverbSendBus("reverbBus");
+        inline constexpr QLatin1StringView ReverbSendLevel("reverbSendDb");
+        inline constexpr QLatin1StringView TimeStretch("timeStretch");
+        inline constexpr QLatin1StringView RateAutomated("rateAutomated");
+        inline constexpr QLatin1StringView Normalize("normalize");
+        inline constexpr QLatin1StringView NormalizeTarget("normalizeTargetLufs");
+        inline constexpr QLatin1StringView CrossfadeCues("crossfadeCues");
+        inline constexpr QLatin1StringView CrossfadeCurve("crossfadeCurve");
+
+        // Record
+        inline constexpr QLatin1StringView RecordFolder("recordFolder");
+        inline constexpr QLatin1StringView RecordSource("recordSource");
+        inline constexpr QLatin1StringView RecordChannels("recordChannels");
+        inline constexpr QLatin1StringView RecordFormat("recordFormat");
+        inline constexpr QLatin1StringView BitDepth("bitDepth");
+        inline constexpr QLatin1StringView MaxDuration("maxDuration");
+        inline constexpr QLatin1StringView LastTake("lastTake");
+
+        // Control / group
+        inline constexpr QLatin1StringView FadeTime("fadeTime");
+        inline constexpr QLatin1StringView Children("children");
+        inline constexpr QLatin1StringView Mode("mode");
+
+        // Network
+        inline constexpr QLatin1StringView Protocol("protocol");
+        inline constexpr QLatin1StringView Host("host");
+        inline constexpr QLatin1StringView Port("port");
+        inline constexpr QLatin1StringView Message("message");
+        inline constexpr QLatin1StringView HttpMethod("httpMethod");
+        inline constexpr QLatin1StringView HttpPath("httpPath");
+        inline constexpr QLatin1StringView ContentType("contentType");
+        inline constexpr QLatin1StringView ExpectReply("expectReply");
+        inline constexpr QLatin1StringView ReplyTerminator("replyTerminator");
+        inline constexpr QLatin1StringView TimeoutMs("timeoutMs");
+
+        // Workspace
+        inline constexpr QLatin1StringView Cues("cues");
+        inline constexpr QLatin1StringView Version("version");
+        inline constexpr QLatin1StringView StandbyCue("standbyCue");
+        inline constexpr QLatin1StringView OutputProcessing("outputProcessing");
+        inline constexpr QLatin1StringView ReverbBuses("reverbBuses");
+        inline constexpr QLatin1StringView PreviewBus("previewBus");
+
+    } // namespace CueJsonKeys
+
+} // namespace CueForge
@@ -4,7 +4,14 @@
 // ============================================================================
 
 #include "CueManager.h"
+#include "CueJsonKeys.h"
 #include "cues/AudioCue.h"
+#include "cues/VideoCue.h"
+#include "cues/NetworkCue.h"
+#include "cues/LiveInputCue.h"
+#include "cues/PlaylistCue.h"
+#include "cues/RecordCue.h"
+#include "cues/StemCue.h"
 #include "../audio/AudioEngineQt.h"
 #include "cues/GroupCue.h"
 #include "cues/WaitCue.h"
@@ -21,6 +28,8 @@ CueManager::CueManager(QObject* parent)
     , standByCue_(nullptr)
     , hasUnsavedChanges_(false)
 	, audioEngine_(nullptr)
+    , videoCompositor_(nullptr)
+    , connectionPool_(nullptr)
 {
     qDebug() << "CueManager initialized";
 }
@@ -34,11 +43,51 @@ void CueManager::setAudioEngine(AudioEngineQt* engine)
         if (AudioCue* audioCue = qobject_cast<AudioCue*>(cues_[i].get())) {
             audioCue->setAudioEngine(engine);
         }
+        else if (LiveInputCue* liveInputCue = qobject_cast<LiveInputCue*>(cues_[i].get())) {
+            liveInputCue->setAudioEngine(engine);
+        }
+        else if (StemCue* stemCue = qobject_cast<StemCue*>(cues_[i].get())) {
+            stemCue->setAudioEngine(engine);
+        }
+        else if (PlaylistCue* playlistCue = qobject_cast<PlaylistCue*>(cues_[i].get())) {
+            playlistCue->setAudioEngine(engine);
+        }
+        else if (RecordCue* recordCue = qobject_cast<RecordCue*>(cues_[i].get())) {
+            recordCue->setAudioEngine(engine);
+        }
     }
 
     qDebug() << "CueManager: Audio engine connected";
 }
 
+void CueManager::setVideoCompositor(VideoCompositor* compositor)
+{
+    videoCompositor_ = compositor;
+
+    // Update any existing video cues - armed ones start pre-rolling
+    for (int i = 0; i < cues_.size(); ++i) {
+        if (VideoCue* videoCue = qobject_cast<VideoCue*>(cues_[i].get())) {
+            videoCue->setVideoCompositor(compositor);
+        }
+    }
+
+    qDebug() << "CueManager: Video compositor connected";
+}
+
+void CueManager::setConnectionPool(ConnectionPool* pool)
+{
+    connectionPool_ = pool;
+
+    // Update any existing network cues - armed ones open their connection
+    for (int i = 0; i < cues_.size(); ++i) {
+        if (NetworkCue* networkCue = qobject_cast<NetworkCue*>(cues_[i].get())) {
+            networkCue->setConnectionPool(pool);
+        }
+    }
+
+    qDebug() << "CueManager: Connection pool connected";
+}
+
 // ============================================================================
 // Cue Creation and Management
 // ============================================================================
@@ -56,6 +105,54 @@ Cue* CueManager::createCue(CueType type, int index)
         cue = audioCue;
         break;
     }
+    case CueType::Video: {
+        VideoCue* videoCue = new VideoCue(this);
+        if (videoCompositor_) {
+            videoCue->setVideoCompositor(videoCompositor_);
+        }
+        cue = videoCue;
+        break;
+    }
+    case CueType::LiveInput: {
+        LiveInputCue* liveInputCue = new LiveInputCue(this);
+        if (audioEngine_) {
+            liveInputCue->setAudioEngine(audioEngine_);
+        }
+        cue = liveInputCue;
+        break;
+    }
+    case CueType::Stem: {
+        StemCue* stemCue = new StemCue(this);
+        if (audioEngine_) {
+            stemCue->setAudioEngine(audioEngine_);
+        }
+        cue = stemCue;
+        break;
+    }
+    case CueType::Playlist: {
+        PlaylistCue* playlistCue = new PlaylistCue(this);
+        if (audioEngine_) {
+            playlistCue->setAudioEngine(audioEngine_);
+        }
+        cue = playlistCue;
+        break;
+    }
+    case CueType::Record: {
+        RecordCue* recordCue = new RecordCue(this);
+        if (audioEngine_) {
+            recordCue->setAudioEngine(audioEngine_);
+        }
+        cue = recordCue;
+        break;
+    }
+    case CueType::Network: {
+        NetworkCue* networkCue = new NetworkCue(this);
+        if (connectionPool_) {
+            networkCue->setConnectionPool(connectionPool_);
+        }
+        cue = networkCue;
+        break;
+    }
     case CueType::Group:
         cue = new GroupCue(this);
         break;
@@ -96,11 +193,11 @@ Cue* CueManager::createCue(CueType type, int index)
         cues_.append(cuePtr);
     }
 
-    // Connect signals
-    connect(cue, &Cue::numberChanged, this, &CueManager::onCueUpdated);
-    connect(cue, &Cue::nameChanged, this, &CueManager::onCueUpdated);
-    connect(cue, &Cue::durationChanged, this, &CueManager::onCueUpdated);
+    // Connect signals. Every property setter, number, name and duration
+    // included, signals modified() once, so it is the only source of
+    // cueUpdated and each edit reaches the UI and the mirror once.
     connect(cue, &Cue::executionFinished, this, &CueManager::onCueFinished);
+    connect(cue, &Cue::modified, this, [this, cue]() { emit cueUpdated(cue); });
 
     // Mark as changed
     hasUnsavedChanges_ = true;
@@ -260,6 +357,41 @@ Cue* CueManager::duplicateCue(const QString& cueId)
     return duplicate;
 }
 
+Cue* CueManager::insertCueFromJson(const QJsonObject& json, int index)
+{
+    CueType type = stringToCueType(json.value(CueJsonKeys::Type).toString());
+
+    Cue* cue = createCue(type, index);
+    if (!cue) {
+        return nullptr;
+    }
+
+    cue->fromJson(json);
+
+    if (type == CueType::Group) {
+        loadGroupChildren(static_cast<GroupCue*>(cue), json.value(CueJsonKeys::Children).toArray());
+    }
+
+    return cue;
+}
+
+bool CueManager::updateCueFromJson(const QJsonObject& json)
+{
+    Cue* cue = getCue(json.value(CueJsonKeys::Id).toString());
+    if (!cue) {
+        return false;
+    }
+
+    cue->fromJson(json);
+
+    // GroupCue::fromJson drops its children - rebuild them from the payload
+    if (cue->type() == CueType::Group) {
+        loadGroupChildren(static_cast<GroupCue*>(cue), json.value(CueJsonKeys::Children).toArray());
+    }
+
+    return true;
+}
+
 // ============================================================================
 // Standby and Playback
 // ============================================================================
@@ -292,6 +424,32 @@ QStringList CueManager::activeCueIds() const
     return activeCueIds_;
 }
 
+bool CueManager::goCue(const QString& cueId)
+{
+    Cue* cue = getCue(cueId);
+    if (!cue) {
+        return false;
+    }
+
+    setStandByCue(cue);
+    return go();
+}
+
+bool CueManager::startCue(const QString& cueId)
+{
+    Cue* cue = getCue(cueId);
+    if (!cue || !cue->execute()) {
+        return false;
+    }
+
+    if (!activeCueIds_.contains(cueId)) {
+        activeCueIds_.append(cueId);
+    }
+
+    emit playbackStateChanged();
+    return true;
+}
+
 bool CueManager::go()
 {
     if (!standByCue_) {
@@ -308,7 +466,9 @@ bool CueManager::go()
     }
     
     // Execute the cue
+    QString executedId = standByCue_->id();
     standByCue_->execute();
+    emit goTriggered(executedId);
     
     // Add to active list
     if (!activeCueIds_.contains(standByCue_->id())) {
@@ -343,6 +503,7 @@ void CueManager::stop()
     
     activeCueIds_.clear();
     emit playbackStateChanged();
+    emit stopAllTriggered();
     
     qDebug() << "All cues stopped";
 }
@@ -362,6 +523,7 @@ void CueManager::pause()
     }
     
     emit playbackStateChanged();
+    emit pauseToggled();
     
     qDebug() << "Pause/Resume toggled";
 }
@@ -377,6 +539,7 @@ void CueManager::panic()
     
     activeCueIds_.clear();
     emit playbackStateChanged();
+    emit panicTriggered();
     emit error("PANIC STOP");
     
     qDebug() << "PANIC STOP executed";
@@ -684,7 +847,7 @@ void CueManager::paste(int index)
     
     QStringList pastedIds;
     for (const QJsonObject& cueJson : clipboard_) {
-        QString typeStr = cueJson["type"].toString();
+        QString typeStr = cueJson.value(CueJsonKeys::Type).toString();
         CueType type = stringToCueType(typeStr);
         
         Cue* cue = createCue(type, pasteIndex);
@@ -731,14 +894,14 @@ bool CueManager::loadWorkspace(const QJsonObject& workspace)
 {
     newWorkspace();
 
-    QJsonArray cuesArray = workspace["cues"].toArray();
+    QJsonArray cuesArray = workspace.value(CueJsonKeys::Cues).toArray();
 
     // PASS 1: Create all cues (but don't load children yet)
     QList<QPair<Cue*, QJsonObject>> cuesToProcess;
 
     for (const QJsonValue& value : cuesArray) {
         QJsonObject cueObj = value.toObject();
-        QString typeStr = cueObj["type"].toString();
+        QString typeStr = cueObj.value(CueJsonKeys::Type).toString();
         CueType type = stringToCueType(typeStr);
 
         Cue* cue = createCue(type);
@@ -755,51 +918,24 @@ bool CueManager::loadWorkspace(const QJsonObject& workspace)
 
     // PASS 2: Now load group children
     for (const auto& pair : cuesToProcess) {
-        Cue* groupCue = pair.first;
-        QJsonObject groupObj = pair.second;
-
-        if (groupCue->type() == CueType::Group) {
-            GroupCue* group = static_cast<GroupCue*>(groupCue);
-            QJsonArray childrenArray = groupObj["children"].toArray();
-
-            for (const QJsonValue& childValue : childrenArray) {
-                QJsonObject childObj = childValue.toObject();
-                QString childTypeStr = childObj["type"].toString();
-                CueType childType = stringToCueType(childTypeStr);
-
-                // Create child cue (but don't add to main list)
-                Cue* childCue = nullptr;
-
-                switch (childType) {
-                case CueType::Audio:
-                    childCue = new AudioCue(this);
-                    break;
-                case CueType::Group:
-                    childCue = new GroupCue(this);
-                    break;
-                case CueType::Wait:
-                    childCue = new WaitCue(this);
-                    break;
-                case CueType::Start:
-                case CueType::Stop:
-                case CueType::Pause:
-                case CueType::Goto:
-                    childCue = new ControlCue(childType, this);
-                    break;
-                default:
-                    break;
-                }
-
-                if (childCue) {
-                    childCue->fromJson(childObj);
-                    group->addChild(Cue::CuePtr(childCue));
-                }
-            }
+        if (pair.first->type() == CueType::Group) {
+            loadGroupChildren(static_cast<GroupCue*>(pair.first), pair.second.value(CueJsonKeys::Children).toArray());
         }
     }
 
+    // Venue speaker alignment and reverb buses travel with the show
+    if (audioEngine_ && workspace.contains(CueJsonKeys::OutputProcessing)) {
+        audioEngine_->setOutputProcessing(workspace.value(CueJsonKeys::OutputProcessing).toArray());
+    }
+    if (audioEngine_ && workspace.contains(CueJsonKeys::ReverbBuses)) {
+        audioEngine_->setReverbBuses(workspace.value(CueJsonKeys::ReverbBuses).toArray());
+    }
+    if (audioEngine_ && workspace.contains(CueJsonKeys::PreviewBus)) {
+        audioEngine_->setPreviewBus(workspace.value(CueJsonKeys::PreviewBus).toObject());
+    }
+
     // Restore standby cue if saved
-    QString standbyCueId = workspace["standbyCue"].toString();
+    QString standbyCueId = workspace.value(CueJsonKeys::StandbyCue).toString();
     if (!standbyCueId.isEmpty()) {
         setStandByCue(standbyCueId);
     }
@@ -822,11 +958,17 @@ QJsonObject CueManager::saveWorkspace() const
         }
     }
     
-    workspace["cues"] = cuesArray;
-    workspace["version"] = "2.0.0";
+    workspace.insert(CueJsonKeys::Cues, cuesArray);
+    workspace.insert(CueJsonKeys::Version, QStringLiteral("2.0.0"));
     
     if (standByCue_) {
-        workspace["standbyCue"] = standByCue_->id();
+        workspace.insert(CueJsonKeys::StandbyCue, standByCue_->id());
+    }
+
+    if (audioEngine_) {
+        workspace.insert(CueJsonKeys::OutputProcessing, audioEngine_->outputProcessing());
+        workspace.insert(CueJsonKeys::ReverbBuses, audioEngine_->reverbBuses());
+        workspace.insert(CueJsonKeys::PreviewBus, audioEngine_->previewBus());
     }
     
     qDebug() << "Saved workspace with" << cues_.size() << "cues";
@@ -849,6 +991,83 @@ void CueManager::markUnsaved()
     }
 }
 
+void CueManager::loadGroupChildren(GroupCue* group, const QJsonArray& childrenArray)
+{
+    for (const QJsonValue& childValue : childrenArray) {
+        QJsonObject childObj = childValue.toObject();
+        QString childTypeStr = childObj.value(CueJsonKeys::Type).toString();
+        CueType childType = stringToCueType(childTypeStr);
+
+        // Create child cue (but don't add to main list)
+        Cue* childCue = nullptr;
+
+        switch (childType) {
+        case CueType::Audio:
+            childCue = new AudioCue(this);
+            break;
+        case CueType::Video: {
+            VideoCue* videoCue = new VideoCue(this);
+            if (videoCompositor_) {
+                videoCue->setVideoCompositor(videoCompositor_);
+            }
+            childCue = videoCue;
+            break;
+        }
+        case CueType::LiveInput: {
+            LiveInputCue* liveInputCue = new LiveInputCue(this);
+            liveInputCue->setAudioEngine(audioEngine_);
+            childCue = liveInputCue;
+            break;
+        }
+        case CueType::Stem: {
+            StemCue* stemCue = new StemCue(this);
+            stemCue->setAudioEngine(audioEngine_);
+            childCue = stemCue;
+            break;
+        }
+        case CueType::Playlist: {
+            PlaylistCue* playlistCue = new PlaylistCue(this);
+            playlistCue->setAudioEngine(audioEngine_);
+            childCue = playlistCue;
+            break;
+        }
+        case CueType::Record: {
+            RecordCue* recordCue = new RecordCue(this);
+            recordCue->setAudioEngine(audioEngine_);
+            childCue = recordCue;
+            break;
+        }
+        case CueType::Network: {
+            NetworkCue* networkCue = new NetworkCue(this);
+            if (connectionPool_) {
+                networkCue->setConnectionPool(connectionPool_);
+            }
+            childCue = networkCue;
+            break;
+        }
+        case CueType::Group:
+            childCue = new GroupCue(this);
+            break;
+        case CueType::Wait:
+            childCue = new WaitCue(this);
+            break;
+        case CueType::Start:
+        case CueType::Stop:
+        case CueType::Pause:
+        case CueType::Goto:
+            childCue = new ControlCue(childType, this);
+            break;
+        default:
+            break;
+        }
+
+        if (childCue) {
+            childCue->fromJson(childObj);
+            group->addChild(Cue::CuePtr(childCue));
+        }
+    }
+}
+
 // ============================================================================
 // Utility Methods
 // ============================================================================
@@ -11,14 +11,18 @@
 #include <QList>
 #include <QPointer>
 #include <QJsonObject>
+#include <QJsonArray>
 #include <memory>
 #include "Cue.h"
 
 namespace CueForge {
 
     class ErrorHandler;
+    class GroupCue;
 
     class AudioEngineQt;
+    class VideoCompositor;
+    class ConnectionPool;
 
     class CueManager : public QObject
     {
@@ -33,6 +37,9 @@ namespace CueForge {
         // Cue creation and management
         Cue* createCue(CueType type, int index = -1);
 		void setAudioEngine(AudioEngineQt* engine);
+        AudioEngineQt* audioEngine() const { return audioEngine_; }
+        void setVideoCompositor(VideoCompositor* compositor);
+        void setConnectionPool(ConnectionPool* pool);
         Cue::CuePtr removeChild(int index);
         bool removeCue(const QString& cueId);
         void removeCueWithoutSignals(const QString& cueId);
@@ -42,6 +49,8 @@ namespace CueForge {
         bool moveCueUp(const QString& cueId);
         bool moveCueDown(const QString& cueId);
         Cue* duplicateCue(const QString& cueId);
+        Cue* insertCueFromJson(const QJsonObject& json, int index = -1);
+        bool updateCueFromJson(const QJsonObject& json);
 
         // Standby and playback
         Cue* standByCue() const;
@@ -50,6 +59,10 @@ namespace CueForge {
         QStringList activeCueIds() const;
 
         bool go();
+        bool goCue(const QString& cueId);
+        // Runs a cue as active without a GO: standby stays put and no
+        // goTriggered is emitted (mirror catch-up)
+        bool startCue(const QString& cueId);
         void stop();
         void pause();
         void panic();
@@ -97,6 +110,10 @@ namespace CueForge {
         void selectionChanged();
         void standByCueChanged(const QString& cueId);
         void playbackStateChanged();
+        void goTriggered(const QString& cueId);
+        void stopAllTriggered();
+        void pauseToggled();
+        void panicTriggered();
 
         void workspaceCleared();
         void unsavedChangesChanged(bool hasChanges);
@@ -106,6 +123,8 @@ namespace CueForge {
         void info(const QString& message);
 
     private:
+        void loadGroupChildren(GroupCue* group, const QJsonArray& childrenArray);
+
         CueList cues_;
         QStringList selectedCueIds_;
         QStringList activeCueIds_;
@@ -114,6 +133,8 @@ namespace CueForge {
         QString currentWorkspacePath_;
         bool hasUnsavedChanges_;
         AudioEngineQt* audioEngine_;
+        VideoCompositor* videoCompositor_;
+        ConnectionPool* connectionPool_;
     };
 
 } // namespace CueForge
\ No newline at end of file
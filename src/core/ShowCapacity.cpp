@@ -0,0 +1,432 @@
+// ============================================================================
+// ShowCapacity.cpp - Peak audio callback load estimate across a workspace
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#include "ShowCapacity.h"
+#include "CueManager.h"
+#include "cues/AudioCue.h"
+#include "cues/ControlCue.h"
+#include "cues/GroupCue.h"
+#include "cues/PlaylistCue.h"
+#include "cues/StemCue.h"
+#include <QJsonArray>
+#include <QSet>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace CueForge {
+
+    namespace {
+        constexpr int MaxTriggerDepth = 16;   // Start cues pointing at each other
+
+        QString cueLabel(const Cue* cue)
+        {
+            return cue->number().isEmpty() ? cue->name() : cue->number();
+        }
+
+        void collectIds(const Cue* cue, QSet<QString>& ids)
+        {
+            ids.insert(cue->id());
+            if (auto* group = qobject_cast<const GroupCue*>(cue)) {
+                for (int i = 0; i < group->childCount(); ++i) {
+                    if (Cue* child = group->getChildAt(i)) {
+                        collectIds(child, ids);
+                    }
+                }
+            }
+        }
+    }
+
+    QJsonObject CapacityReport::toJson() const
+    {
+        QJsonArray moments;
+        for (const CapacityMoment& moment : overBudget) {
+            moments.append(QJsonObject{
+                { "start", moment.startSeconds },
+                { "end", moment.endSeconds },
+                { "peakLoad", moment.peakLoad },
+                { "peakCostUs", moment.peakCostUs },
+                { "voices", moment.voices },
+                { "goCue", moment.goCue },
+                { "cues", QJsonArray::fromStringList(moment.cues) },
+            });
+        }
+
+        return QJsonObject{
+            { "blockPeriodUs", blockPeriodUs },
+            { "budgetUs", budgetUs },
+            { "showSeconds", showSeconds },
+            { "peakLoad", peakLoad },
+            { "peakSeconds", peakSeconds },
+            { "peakVoices", peakVoices },
+            { "withinBudget", withinBudget() },
+            { "overBudget", moments },
+            { "warnings", QJsonArray::fromStringList(warnings) },
+        };
+    }
+
+    ShowCapacity::ShowCapacity(const VoiceCostModel& model, const CapacitySettings& settings)
+        : model_(model)
+        , settings_(settings)
+    {
+    }
+
+    CapacityReport ShowCapacity::estimate(const CueManager& manager)
+    {
+        voices_.clear();
+        stops_.clear();
+        warnings_.clear();
+        lastStart_ = 0.0;
+
+        if (!model_.isCalibrated()) {
+            CapacityReport report;
+            report.warnings << "Voice cost model is not calibrated";
+            return report;
+        }
+
+        QList<Cue*> cues;
+        for (const auto& cue : manager.allCues()) {
+            cues.append(cue.get());
+        }
+
+        // One GO per cue that isn't reached by the previous cue's continue
+        double goTime = 0.0;
+        for (int index = 0; index < cues.size(); goTime += settings_.goIntervalSeconds) {
+            currentGo_ = cueLabel(cues[index]);
+            index = runChain(cues, index, goTime, 0) + 1;
+        }
+
+        applyStops();
+
+        // Loops and unknown lengths play until the end of the last GO
+        double showEnd = lastStart_ + settings_.goIntervalSeconds;
+        for (const Voice& voice : voices_) {
+            if (std::isfinite(voice.end)) {
+                showEnd = std::max(showEnd, voice.end);
+            }
+        }
+        for (Voice& voice : voices_) {
+            voice.end = std::min(voice.end, showEnd);
+        }
+
+        CapacityReport report = sweep();
+        report.showSeconds = showEnd;
+        report.warnings = warnings_;
+        return report;
+    }
+
+    int ShowCapacity::runChain(const QList<Cue*>& cues, int index, double time, int depth)
+    {
+        while (index < cues.size()) {
+            Cue* cue = cues[index];
+            const double start = fire(cue, time, depth);
+
+            if (!cue->continueMode() || index + 1 >= cues.size()) {
+                break;
+            }
+            time = start + cue->postWait() + (cue->type() == CueType::Wait ? cue->duration() : 0.0);
+            ++index;
+        }
+        return index;
+    }
+
+    double ShowCapacity::fire(Cue* cue, double time, int depth)
+    {
+        const double start = time + cue->preWait();
+        lastStart_ = std::max(lastStart_, start);
+
+        if (depth > MaxTriggerDepth) {
+            warnings_ << QString("Cue %1: trigger chain too deep, not followed").arg(cueLabel(cue));
+            return start;
+        }
+
+        switch (cue->type()) {
+        case CueType::Audio:
+            addAudioVoice(cue, start);
+            break;
+
+        case CueType::Stem:
+            addStemVoices(cue, start);
+            break;
+
+        case CueType::Playlist:
+            addPlaylistVoices(cue, start);
+            break;
+
+        case CueType::Group:
+            if (auto* group = qobject_cast<GroupCue*>(cue)) {
+                QList<Cue*> children;
+                for (int i = 0; i < group->childCount(); ++i) {
+                    if (Cue* child = group->getChildAt(i)) {
+                        children.append(child);
+                    }
+                }
+                if (group->mode() == GroupMode::Sequential) {
+                    runChain(children, 0, start, depth + 1);
+                }
+                else {
+                    for (Cue* child : children) {
+                        fire(child, start, depth + 1);
+                    }
+                }
+            }
+            break;
+
+        case CueType::Start:
+            if (Cue* target = cue->targetCue()) {
+                fire(target, start, depth + 1);
+            }
+            break;
+
+        case CueType::Stop:
+            if (Cue* target = cue->targetCue()) {
+                auto* control = qobject_cast<ControlCue*>(cue);
+                stops_.append({ start, target, control ? control->fadeTime() : 0.0 });
+            }
+            break;
+
+        default:
+            break;
+        }
+
+        return start;
+    }
+
+    void ShowCapacity::addAudioVoice(Cue* cue, double start)
+    {
+        auto* audio = qobject_cast<AudioCue*>(cue);
+        if (!audio || audio->filePath().isEmpty()) {
+            return;
+        }
+
+        const Probe& info = probe(audio->filePath());
+        if (!info.valid) {
+            warnings_ << QString("Cue %1: cannot read %2, not costed").arg(cueLabel(cue), audio->filePath());
+            return;
+        }
+
+        // Same arithmetic as AudioCue::effectiveDuration(), falling back to
+        // the file when the cue hasn't been loaded yet
+        double length = audio->effectiveDuration();
+        if (length <= 0.0) {
+            const double end = audio->endTime() > audio->startTime() ? audio->endTime() : info.duration;
+            length = std::max(0.0, end - audio->startTime()) / std::max(0.01, audio->rate());
+        }
+
+        Voice voice;
+        voice.start = start;
+        voice.end = audio->loopEnabled() ? std::numeric_limits<double>::infinity() : start + length;
+        voice.config = info.config;
+        voice.config.outputs = settings_.outputs;
+        voice.cueId = cue->id();
+        voice.cueNumber = cueLabel(cue);
+        voice.goCue = currentGo_;
+        voices_.append(voice);
+
+        if (audio->loopEnabled()) {
+            warnings_ << QString("Cue %1: loops, costed until stopped or the end of the show").arg(voice.cueNumber);
+        }
+    }
+
+    void ShowCapacity::addStemVoices(Cue* cue, double start)
+    {
+        auto* stemCue = qobject_cast<StemCue*>(cue);
+        if (!stemCue) {
+            return;
+        }
+
+        // Costed as one player per stem; the shared read-ahead moves disk
+        // work off the callback, so this errs on the safe side
+        const QList<StemCue::Stem> stems = stemCue->stems();
+        for (const StemCue::Stem& stem : stems) {
+            const Probe& info = probe(stem.filePath);
+            if (!info.valid) {
+                warnings_ << QString("Cue %1: cannot read %2, not costed").arg(cueLabel(cue), stem.filePath);
+                continue;
+            }
+
+            Voice voice;
+            voice.start = start;
+            voice.end = start + info.duration;
+            voice.config = info.config;
+            voice.config.outputs = settings_.outputs;
+            voice.cueId = cue->id();
+            voice.cueNumber = cueLabel(cue);
+            voice.goCue = currentGo_;
+            voices_.append(voice);
+        }
+    }
+
+    void ShowCapacity::addPlaylistVoices(Cue* cue, double start)
+    {
+        auto* playlist = qobject_cast<PlaylistCue*>(cue);
+        if (!playlist) {
+            return;
+        }
+
+        // Tracks in list order (shuffle changes the order, not the load);
+        // during a crossfade two tracks are decoding at once
+        double trackStart = start;
+        const QStringList tracks = playlist->tracks();
+        for (const QString& track : tracks) {
+            const Probe& info = probe(track);
+            if (!info.valid) {
+                warnings_ << QString("Cue %1: cannot read %2, not costed").arg(cueLabel(cue), track);
+                continue;
+            }
+
+            Voice voice;
+            voice.start = trackStart;
+            voice.end = trackStart + info.duration;
+            voice.config = info.config;
+            voice.config.outputs = settings_.outputs;
+            voice.cueId = cue->id();
+            voice.cueNumber = cueLabel(cue);
+            voice.goCue = currentGo_;
+            voices_.append(voice);
+
+            trackStart = std::max(trackStart, voice.end - playlist->crossfadeTime());
+        }
+
+        if (playlist->loopEnabled() && !voices_.isEmpty() && voices_.last().cueId == cue->id()) {
+            voices_.last().end = std::numeric_limits<double>::infinity();
+            warnings_ << QString("Cue %1: loops, costed until stopped or the end of the show").arg(cueLabel(cue));
+        }
+    }
+
+    void ShowCapacity::applyStops()
+    {
+        std::sort(stops_.begin(), stops_.end(), [](const StopAction& a, const StopAction& b) {
+            return a.time < b.time;
+        });
+
+        for (const StopAction& stop : stops_) {
+            // Stopping a group stops every voice underneath it
+            QSet<QString> targets;
+            collectIds(stop.target, targets);
+
+            const int count = voices_.size();
+            for (int i = 0; i < count; ++i) {
+                Voice& voice = voices_[i];
+                if (!targets.contains(voice.cueId) || voice.start > stop.time || voice.end <= stop.time) {
+                    continue;
+                }
+
+                const double end = voice.end;
+                voice.end = stop.time;
+                if (stop.fadeSeconds > 0.0) {
+                    Voice fade = voice;
+                    fade.start = stop.time;
+                    fade.end = std::min(end, stop.time + stop.fadeSeconds);
+                    fade.config.fading = true;
+                    voices_.append(fade);
+                }
+            }
+        }
+    }
+
+    CapacityReport ShowCapacity::sweep() const
+    {
+        CapacityReport report;
+        report.blockPeriodUs = model_.blockPeriodUs();
+        report.budgetUs = report.blockPeriodUs * settings_.budget;
+
+        // (time, voice index); ends sort before starts at the same instant
+        std::vector<std::pair<double, int>> events;
+        std::vector<double> cost(static_cast<size_t>(voices_.size()));
+        for (int i = 0; i < voices_.size(); ++i) {
+            const Voice& voice = voices_[i];
+            if (voice.end <= voice.start) {
+                continue;
+            }
+            cost[i] = model_.voiceCostUs(voice.config, settings_.peak);
+            events.emplace_back(voice.start, i + 1);
+            events.emplace_back(voice.end, -(i + 1));
+        }
+        std::sort(events.begin(), events.end());
+
+        QSet<int> active;
+        double load = model_.baseUs(settings_.peak);
+        CapacityMoment current;
+        bool inMoment = false;
+
+        for (size_t e = 0; e < events.size();) {
+            const double time = events[e].first;
+            for (; e < events.size() && events[e].first == time; ++e) {
+                const int index = std::abs(events[e].second) - 1;
+                if (events[e].second > 0) {
+                    active.insert(index);
+                    load += cost[index];
+                }
+                else {
+                    active.remove(index);
+                    load -= cost[index];
+                }
+            }
+            if (e == events.size()) {
+                break;   // Only the last voice ending - nothing plays after it
+            }
+
+            const double fraction = report.blockPeriodUs > 0.0 ? load / report.blockPeriodUs : 0.0;
+            if (fraction > report.peakLoad) {
+                report.peakLoad = fraction;
+                report.peakSeconds = time;
+                report.peakVoices = active.size();
+            }
+
+            if (load <= report.budgetUs) {
+                if (inMoment) {
+                    report.overBudget.append(current);
+                    inMoment = false;
+                }
+                continue;
+            }
+
+            if (!inMoment) {
+                current = CapacityMoment();
+                current.startSeconds = time;
+                inMoment = true;
+            }
+            current.endSeconds = events[e].first;
+
+            if (fraction > current.peakLoad) {
+                current.peakLoad = fraction;
+                current.peakCostUs = load;
+                current.voices = active.size();
+                current.cues.clear();
+
+                double latest = -1.0;
+                QList<int> sorted = active.values();
+                std::sort(sorted.begin(), sorted.end());
+                for (int index : sorted) {
+                    const Voice& voice = voices_[index];
+                    current.cues << voice.cueNumber;
+                    if (voice.start >= latest) {
+                        latest = voice.start;
+                        current.goCue = voice.goCue;
+                    }
+                }
+            }
+        }
+        if (inMoment) {
+            report.overBudget.append(current);
+        }
+
+        return report;
+    }
+
+    const ShowCapacity::Probe& ShowCapacity::probe(const QString& path)
+    {
+        auto cached = probes_.find(path);
+        if (cached == probes_.end()) {
+            Probe info;
+            info.valid = VoiceCostModel::probeFile(path.toStdString(), info.config, &info.duration);
+            cached = probes_.insert(path, info);
+        }
+        return cached.value();
+    }
+
+} // namespace CueForge
@@ -0,0 +1,119 @@
+// ============================================================================
+// ShowCapacity.h - Peak audio callback load estimate across a workspace
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#pragma once
+
+#include "../audio/VoiceCostModel.h"
+#include <QHash>
+#include <QJsonObject>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+namespace CueForge {
+
+    class Cue;
+    class CueManager;
+
+    struct CapacitySettings
+    {
+        double budget = 0.7;                // Fraction of the block period the callback may use
+        double goIntervalSeconds = 10.0;    // Assumed time between operator GOs
+        int outputs = 2;                    // Device outputs every voice is mixed into
+        bool peak = true;                   // Plan against p99 rather than mean costs
+    };
+
+    // A stretch of the timeline where the estimated load stays over budget
+    struct CapacityMoment
+    {
+        double startSeconds = 0.0;
+        double endSeconds = 0.0;
+        double peakLoad = 0.0;          // Callback time / block period at the worst point
+        double peakCostUs = 0.0;
+        int voices = 0;                 // Voices playing at the worst point
+        QString goCue;                  // GO that started the latest of them
+        QStringList cues;               // Cue numbers playing at the worst point
+    };
+
+    struct CapacityReport
+    {
+        double blockPeriodUs = 0.0;
+        double budgetUs = 0.0;
+        double showSeconds = 0.0;
+        double peakLoad = 0.0;
+        double peakSeconds = 0.0;
+        int peakVoices = 0;
+        QList<CapacityMoment> overBudget;
+        QStringList warnings;           // Unreadable files, open-ended loops
+
+        bool withinBudget() const { return overBudget.isEmpty(); }
+        QJsonObject toJson() const;
+    };
+
+    /**
+     * Lays a workspace out on a timeline the way it would play and sums the
+     * calibrated cost of every voice sounding at each moment.
+     *
+     * Each GO starts the standby cue and every cue chained after it by
+     * continue mode (postWait after it starts; after its duration for a
+     * Wait cue). Groups fire their first child and its chain (sequential)
+     * or all children at once (simultaneous); Start cues fire their target
+     * and Stop cues end the target's voices, with the stop fade costed as a
+     * fading voice. Operator GOs are assumed goIntervalSeconds apart, so
+     * lowering it models a fast-paced sequence where more cues overlap.
+     */
+    class ShowCapacity
+    {
+    public:
+        ShowCapacity(const VoiceCostModel& model, const CapacitySettings& settings = CapacitySettings());
+
+        CapacityReport estimate(const CueManager& manager);
+
+    private:
+        struct Voice
+        {
+            double start = 0.0;
+            double end = 0.0;
+            VoiceConfig config;
+            QString cueId;
+            QString cueNumber;
+            QString goCue;
+        };
+
+        struct StopAction
+        {
+            double time = 0.0;
+            Cue* target = nullptr;
+            double fadeSeconds = 0.0;
+        };
+
+        struct Probe
+        {
+            bool valid = false;
+            VoiceConfig config;
+            double duration = 0.0;
+        };
+
+        int runChain(const QList<Cue*>& cues, int index, double time, int depth);
+        double fire(Cue* cue, double time, int depth);
+        void addAudioVoice(Cue* cue, double start);
+        void addStemVoices(Cue* cue, double start);
+        void addPlaylistVoices(Cue* cue, double start);
+        void applyStops();
+        CapacityReport sweep() const;
+        const Probe& probe(const QString& path);
+
+        const VoiceCostModel& model_;
+        CapacitySettings settings_;
+
+        QList<Voice> voices_;
+        QList<StopAction> stops_;
+        QHash<QString, Probe> probes_;
+        QStringList warnings_;
+        QString currentGo_;
+        double lastStart_ = 0.0;
+    };
+
+} // namespace CueForge
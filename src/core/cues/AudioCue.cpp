@@ -5,6 +5,8 @@
 
 #include "AudioCue.h"
 #include "../../audio/AudioEngineQt.h"
+#include "../CueJsonKeys.h"
+#include "../CueManager.h"
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QFileInfo>
@@ -16,13 +18,28 @@ namespace CueForge {
         : Cue(CueType::Audio, parent)
         , audioEngine_(nullptr)
         , playerId_(-1)
+        , previewPlayerId_(-1)
         , volume_(0.8)
         , pan_(0.0)
         , rate_(1.0)
+        , timeStretch_(false)
+        , rateAutomated_(false)
+        , normalize_(false)
+        , normalizeTargetLufs_(-23.0)
         , startTime_(0.0)
         , endTime_(0.0)
+        , reverbBus_(-1)
+        , reverbSendDb_(-12.0)
+        , crossfadeTime_(0.0)
+        , crossfadeEqualPower_(true)
+        , crossfadeTimer_(new QTimer(this))
     {
         setColor(QColor(100, 255, 150)); // QLab-style green
+
+        crossfadeTimer_->setInterval(50);
+        connect(crossfadeTimer_, &QTimer::timeout, this, &AudioCue::stopFadedOutCues);
+
+        connect(this, &Cue::armedChanged, this, [this](bool) { prepareTimeStretch(); });
     }
 
     AudioCue::~AudioCue()
@@ -32,11 +49,19 @@ namespace CueForge {
             audioEngine_->removePlayer(playerId_);
             playerId_ = -1;
         }
+        stopPreview();
     }
 
     void AudioCue::setAudioEngine(AudioEngineQt* engine)
     {
         audioEngine_ = engine;
+        prepareTimeStretch();
+
+        // Every referenced file is measured, so switching normalisation on
+        // later finds the result waiting
+        if (audioEngine_) {
+            audioEngine_->requestLoudness(filePath_);
+        }
     }
 
     void AudioCue::setFilePath(const QString& filePath)
@@ -45,6 +70,10 @@ namespace CueForge {
             filePath_ = filePath;
             loadFileInfo();
             updateModifiedTime();
+            prepareTimeStretch();
+            if (audioEngine_) {
+                audioEngine_->requestLoudness(filePath_);
+            }
 
             // Update cue name if empty
             if (name().isEmpty()) {
@@ -96,6 +125,32 @@ namespace CueForge {
         }
     }
 
+    void AudioCue::setReverbBus(int bus)
+    {
+        bus = qMax(-1, bus);
+        if (reverbBus_ != bus) {
+            reverbBus_ = bus;
+            updateModifiedTime();
+
+            if (audioEngine_ && playerId_ >= 0) {
+                audioEngine_->setReverbSend(playerId_, reverbBus_, reverbSendDb_);
+            }
+        }
+    }
+
+    void AudioCue::setReverbSendDb(double db)
+    {
+        db = qBound(-60.0, db, 12.0);
+        if (!qFuzzyCompare(reverbSendDb_, db)) {
+            reverbSendDb_ = db;
+            updateModifiedTime();
+
+            if (audioEngine_ && playerId_ >= 0 && reverbBus_ >= 0) {
+                audioEngine_->setReverbSend(playerId_, reverbBus_, reverbSendDb_);
+            }
+        }
+    }
+
     void AudioCue::setRate(double rate)
     {
         rate = qBound(0.5, rate, 2.0);
@@ -103,6 +158,79 @@ namespace CueForge {
             rate_ = rate;
             validateTrimPoints();
             updateModifiedTime();
+
+            // Only a live stretch follows the rate while playing; a
+            // rendered one picks it up on the next GO
+            if (audioEngine_ && playerId_ >= 0 && timeStretch_ && rateAutomated_) {
+                audioEngine_->setStretchRate(playerId_, rate_);
+            }
+            prepareTimeStretch();
+        }
+    }
+
+    void AudioCue::setTimeStretch(bool enabled)
+    {
+        if (timeStretch_ != enabled) {
+            timeStretch_ = enabled;
+            updateModifiedTime();
+            prepareTimeStretch();
+        }
+    }
+
+    void AudioCue::setRateAutomated(bool automated)
+    {
+        if (rateAutomated_ != automated) {
+            rateAutomated_ = automated;
+            updateModifiedTime();
+            prepareTimeStretch();
+        }
+    }
+
+    void AudioCue::setNormalize(bool enabled)
+    {
+        if (normalize_ != enabled) {
+            normalize_ = enabled;
+            updateModifiedTime();
+            applyNormalization();
+        }
+    }
+
+    void AudioCue::setNormalizeTargetLufs(double lufs)
+    {
+        lufs = qBound(-40.0, lufs, -5.0);
+        if (!qFuzzyCompare(normalizeTargetLufs_, lufs)) {
+            normalizeTargetLufs_ = lufs;
+            updateModifiedTime();
+            applyNormalization();
+        }
+    }
+
+    double AudioCue::normalizationGainDb() const
+    {
+        double gainDb = 0.0;
+        if (audioEngine_ && !filePath_.isEmpty()) {
+            audioEngine_->normalizationGain(filePath_, normalizeTargetLufs_, gainDb);
+        }
+        return gainDb;
+    }
+
+    void AudioCue::applyNormalization()
+    {
+        if (!audioEngine_ || playerId_ < 0) {
+            return;
+        }
+
+        double gainDb = 0.0;
+        if (normalize_ && !audioEngine_->normalizationGain(filePath_, normalizeTargetLufs_, gainDb)) {
+            qWarning() << "AudioCue: loudness of" << filePath_ << "not measured yet; playing at file level";
+        }
+        audioEngine_->setTrim(playerId_, gainDb);
+    }
+
+    void AudioCue::prepareTimeStretch()
+    {
+        if (audioEngine_ && timeStretch_ && !rateAutomated_ && isArmed() && !filePath_.isEmpty()) {
+            audioEngine_->prepareTimeStretch(filePath_, rate_);
         }
     }
 
@@ -135,6 +263,22 @@ namespace CueForge {
         return duration() / rate_;
     }
 
+    double AudioCue::playbackPosition() const
+    {
+        if (!audioEngine_ || playerId_ < 0) {
+            return 0.0;
+        }
+        return audioEngine_->getPosition(playerId_);
+    }
+
+    void AudioCue::seekTo(double seconds)
+    {
+        if (!audioEngine_ || playerId_ < 0) {
+            return;
+        }
+        audioEngine_->setPosition(playerId_, qMax(0.0, seconds));
+    }
+
     void AudioCue::validateTrimPoints()
     {
         if (startTime_ >= endTime_ && endTime_ > 0) {
@@ -249,7 +393,8 @@ namespace CueForge {
 
         // Start playback
         qDebug() << "AudioCue::execute() - Starting playback";
-        if (!audioEngine_->play(playerId_)) {
+        const bool started = crossfadeTime_ > 0.0 ? startCrossfade() : audioEngine_->play(playerId_);
+        if (!started) {
             qWarning() << "AudioCue::execute() - Failed to start playback";
             audioEngine_->removePlayer(playerId_);
             playerId_ = -1;
@@ -317,6 +462,122 @@ namespace CueForge {
         setStatus(CueStatus::Running);
     }
 
+    void AudioCue::setCrossfadeTime(double seconds)
+    {
+        seconds = qMax(0.0, seconds);
+        if (!qFuzzyCompare(crossfadeTime_, seconds)) {
+            crossfadeTime_ = seconds;
+            updateModifiedTime();
+        }
+    }
+
+    void AudioCue::setCrossfadeCues(const QStringList& cueIds)
+    {
+        if (crossfadeCues_ != cueIds) {
+            crossfadeCues_ = cueIds;
+            updateModifiedTime();
+        }
+    }
+
+    void AudioCue::setCrossfadeEqualPower(bool equalPower)
+    {
+        if (crossfadeEqualPower_ != equalPower) {
+            crossfadeEqualPower_ = equalPower;
+            updateModifiedTime();
+        }
+    }
+
+    bool AudioCue::startCrossfade()
+    {
+        QList<int> fadeOut;
+        QList<QPair<QPointer<AudioCue>, int>> fading;
+        CueManager* manager = cueManager();
+        for (const QString& cueId : crossfadeCues_) {
+            auto* cue = manager ? qobject_cast<AudioCue*>(manager->getCue(cueId)) : nullptr;
+            if (cue && cue != this && cue->playerId() >= 0 && audioEngine_->isPlaying(cue->playerId())) {
+                fadeOut.append(cue->playerId());
+                fading.append({ cue, cue->playerId() });
+            }
+        }
+
+        if (!audioEngine_->crossfade(playerId_, fadeOut, crossfadeTime_, crossfadeEqualPower_)) {
+            return false;
+        }
+
+        fadingOut_.append(fading);
+        if (!fadingOut_.isEmpty()) {
+            crossfadeTimer_->start();
+        }
+        qDebug() << "AudioCue::startCrossfade() - Cue" << number() << "crossfading from"
+                 << fading.size() << "cues over" << crossfadeTime_ << "s";
+        return true;
+    }
+
+    void AudioCue::stopFadedOutCues()
+    {
+        for (auto it = fadingOut_.begin(); it != fadingOut_.end();) {
+            AudioCue* cue = it->first;
+            if (!cue || !audioEngine_ || cue->playerId() != it->second) {
+                it = fadingOut_.erase(it);      // Gone, stopped or started again meanwhile
+            }
+            else if (audioEngine_->isFadedOut(it->second)) {
+                cue->stop();
+                it = fadingOut_.erase(it);
+            }
+            else {
+                ++it;
+            }
+        }
+
+        if (fadingOut_.isEmpty()) {
+            crossfadeTimer_->stop();
+        }
+    }
+
+    bool AudioCue::startPreview()
+    {
+        if (!audioEngine_ || !audioEngine_->isInitialized() || filePath_.isEmpty()) {
+            qWarning() << "AudioCue::startPreview() - Nothing to preview for cue" << number();
+            return false;
+        }
+
+        stopPreview();
+        previewPlayerId_ = audioEngine_->createPreviewPlayer(filePath_);
+        if (previewPlayerId_ < 0) {
+            return false;
+        }
+
+        audioEngine_->setVolume(previewPlayerId_, volume_);
+        if (normalize_) {
+            audioEngine_->setTrim(previewPlayerId_, normalizationGainDb());
+        }
+        if (startTime_ > 0.0) {
+            audioEngine_->setPosition(previewPlayerId_, startTime_);
+        }
+
+        if (!audioEngine_->play(previewPlayerId_)) {
+            stopPreview();
+            return false;
+        }
+
+        qDebug() << "AudioCue::startPreview() - Previewing cue" << number();
+        return true;
+    }
+
+    void AudioCue::stopPreview()
+    {
+        if (audioEngine_ && previewPlayerId_ >= 0) {
+            audioEngine_->stop(previewPlayerId_);
+            audioEngine_->removePlayer(previewPlayerId_);
+        }
+        previewPlayerId_ = -1;
+    }
+
+    bool AudioCue::isPreviewing() const
+    {
+        return audioEngine_ && previewPlayerId_ >= 0 && audioEngine_->isPlaying(previewPlayerId_);
+    }
+
     void AudioCue::applyPlaybackSettings()
     {
         if (!audioEngine_ || playerId_ < 0) {
@@ -325,62 +586,118 @@ namespace CueForge {
 
         // Apply volume
         audioEngine_->setVolume(playerId_, volume_);
+        if (normalize_) {
+            applyNormalization();
+        }
+
+        if (reverbBus_ >= 0) {
+            audioEngine_->setReverbSend(playerId_, reverbBus_, reverbSendDb_);
+        }
+
+        // Before positioning: the stretched source takes over the transport
+        if (timeStretch_) {
+            audioEngine_->setTimeStretch(playerId_, rate_, rateAutomated_);
+        }
 
         // Apply start position if trimmed
         if (startTime_ > 0.0) {
             audioEngine_->setPosition(playerId_, startTime_);
         }
 
-        // Note: Pan and rate will require additional engine support
-        // For now, volume and position are applied
+        // Note: Pan and varispeed rate will require additional engine support
+        // For now, volume, position and time-stretched rate are applied
     }
 
     // ============================================================================
     // Serialization
     // ============================================================================
 
-    void AudioCue::toJson(QJsonObject& json) const
+    QJsonObject AudioCue::toJson() const
     {
-        Cue::toJson(json);
-
-        json["filePath"] = filePath_;
-        json["volume"] = volume_;
-        json["pan"] = pan_;
-        json["rate"] = rate_;
-        json["startTime"] = startTime_;
-        json["endTime"] = endTime_;
-        json["audioOutputPatch"] = audioOutputPatch_;
-
-        // Matrix routing
+        using namespace CueJsonKeys;
+        QJsonObject json = Cue::toJson();
+
+        json.insert(FilePath, filePath_);
+        json.insert(Volume, volume_);
+        json.insert(Pan, pan_);
+        json.insert(Rate, rate_);
+        json.insert(StartTime, startTime_);
+        json.insert(EndTime, endTime_);
+        json.insert(AudioOutputPatch, audioOutputPatch_);
+
+        // Matrix routing - keys arrive sorted from the map, so every insert
+        // appends
         if (!matrixRouting_.isEmpty()) {
             QJsonObject routingObj;
             for (auto it = matrixRouting_.constBegin(); it != matrixRouting_.constEnd(); ++it) {
-                routingObj[it.key()] = it.value().toDouble();
+                routingObj.insert(it.key(), it.value().toDouble());
             }
-            json["matrixRouting"] = routingObj;
+            json.insert(MatrixRouting, routingObj);
+        }
+
+        if (reverbBus_ >= 0) {
+            json.insert(ReverbSendBus, reverbBus_);
+            json.insert(ReverbSendLevel, reverbSendDb_);
         }
+
+        if (timeStretch_) {
+            json.insert(TimeStretch, true);
+            json.insert(RateAutomated, rateAutomated_);
+        }
+
+        if (normalize_) {
+            json.insert(Normalize, true);
+            json.insert(NormalizeTarget, normalizeTargetLufs_);
+        }
+
+        if (crossfadeTime_ > 0.0) {
+            json.insert(CrossfadeTime, crossfadeTime_);
+            json.insert(CrossfadeCues, QJsonArray::fromStringList(crossfadeCues_));
+            json.insert(CrossfadeCurve, crossfadeEqualPower_ ? "equalPower" : "linear");
+        }
+
+        return json;
     }
 
     void AudioCue::fromJson(const QJsonObject& json)
     {
+        using namespace CueJsonKeys;
+        const LoadScope scope(this);
+
         Cue::fromJson(json);
 
-        setFilePath(json["filePath"].toString());
-        setVolume(json["volume"].toDouble(0.8));
-        setPan(json["pan"].toDouble(0.0));
-        setRate(json["rate"].toDouble(1.0));
-        setStartTime(json["startTime"].toDouble(0.0));
-        setEndTime(json["endTime"].toDouble(0.0));
-        setAudioOutputPatch(json["audioOutputPatch"].toString());
-
-        // Matrix routing
-        if (json.contains("matrixRouting")) {
-            QJsonObject routingObj = json["matrixRouting"].toObject();
-            QVariantMap routing;
+        setFilePath(json.value(FilePath).toString());
+        setVolume(json.value(Volume).toDouble(0.8));
+        setPan(json.value(Pan).toDouble(0.0));
+        setRate(json.value(Rate).toDouble(1.0));
+        setStartTime(json.value(StartTime).toDouble(0.0));
+        setEndTime(json.value(EndTime).toDouble(0.0));
+        setAudioOutputPatch(json.value(AudioOutputPatch).toString());
+        setReverbBus(json.value(ReverbSendBus).toInt(-1));
+        setReverbSendDb(json.value(ReverbSendLevel).toDouble(-12.0));
+        setRateAutomated(json.value(RateAutomated).toBool(false));
+        setTimeStretch(json.value(TimeStretch).toBool(false));
+        setNormalizeTargetLufs(json.value(NormalizeTarget).toDouble(-23.0));
+        setNormalize(json.value(Normalize).toBool(false));
+        setCrossfadeTime(json.value(CrossfadeTime).toDouble(0.0));
+        setCrossfadeEqualPower(json.value(CrossfadeCurve).toString() != QLatin1String("linear"));
+
+        QStringList crossfadeCues;
+        for (const QJsonValue& value : json.value(CrossfadeCues).toArray()) {
+            crossfadeCues.append(value.toString());
+        }
+        setCrossfadeCues(crossfadeCues);
+
+        // Matrix routing, filled in place rather than through a temporary
+        // map handed to setMatrixRouting()
+        const QJsonValue routing = json.value(MatrixRouting);
+        if (routing.isObject()) {
+            const QJsonObject routingObj = routing.toObject();
+            matrixRouting_.clear();
             for (auto it = routingObj.constBegin(); it != routingObj.constEnd(); ++it) {
-                routing[it.key()] = it.value().toDouble();
+                matrixRouting_.insert(it.key(), it.value().toDouble());
             }
-            setMatrixRouting(routing);
+            updateModifiedTime();
         }
     }
 
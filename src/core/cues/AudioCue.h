@@ -6,7 +6,12 @@
 #pragma once
 
 #include "../Cue.h"
+#include <QList>
+#include <QPair>
+#include <QPointer>
 #include <QString>
+#include <QStringList>
+#include <QTimer>
 #include <QUrl>
 #include <QVariantMap>
 
@@ -67,6 +72,23 @@ namespace CueForge {
         double rate() const { return rate_; }
         void setRate(double rate);
 
+        // Rate changes tempo at the original pitch. A static rate is
+        // rendered ahead while the cue is armed; an automated one is
+        // stretched live so setRate() is heard while the cue plays.
+        bool timeStretch() const { return timeStretch_; }
+        void setTimeStretch(bool enabled);
+        bool rateAutomated() const { return rateAutomated_; }
+        void setRateAutomated(bool automated);
+
+        // Loudness normalisation: a gain trim in the player that brings the
+        // file to the target integrated loudness, from the engine's
+        // background analysis. 0 dB until the file has been measured.
+        bool normalize() const { return normalize_; }
+        void setNormalize(bool enabled);
+        double normalizeTargetLufs() const { return normalizeTargetLufs_; }
+        void setNormalizeTargetLufs(double lufs);
+        double normalizationGainDb() const;
+
         // Trim controls
         double startTime() const { return startTime_; }
         void setStartTime(double seconds);
@@ -78,6 +100,28 @@ namespace CueForge {
 
         double effectiveDuration() const;
 
+        // Crossfade on GO: the cue fades in over crossfadeTime while those
+        // of crossfadeCues that are playing fade out, as one engine command
+        // with both ramps starting on the same sample. The faded-out cues
+        // are stopped once silent. 0 starts the cue as usual.
+        double crossfadeTime() const { return crossfadeTime_; }
+        void setCrossfadeTime(double seconds);
+        QStringList crossfadeCues() const { return crossfadeCues_; }
+        void setCrossfadeCues(const QStringList& cueIds);
+        bool crossfadeEqualPower() const { return crossfadeEqualPower_; }   // Linear when false
+        void setCrossfadeEqualPower(bool equalPower);
+
+        // Audition on the engine's preview bus (headphones), separate from
+        // the cue's own playback and status. Plays from the start time at
+        // the cue's volume and normalisation.
+        bool startPreview();
+        void stopPreview();
+        bool isPreviewing() const;
+
+        // Live playhead (seconds into the file, 0.0 when no player is active)
+        double playbackPosition() const;
+        void seekTo(double seconds);
+
         // Matrix routing
         QVariantMap matrixRouting() const { return matrixRouting_; }
         void setMatrixRouting(const QVariantMap& routing);
@@ -88,6 +132,12 @@ namespace CueForge {
         QString audioOutputPatch() const { return audioOutputPatch_; }
         void setAudioOutputPatch(const QString& patchName);
 
+        // Post-volume send to a workspace reverb bus (-1 for none)
+        int reverbBus() const { return reverbBus_; }
+        void setReverbBus(int bus);
+        double reverbSendDb() const { return reverbSendDb_; }
+        void setReverbSendDb(double db);
+
         // Cue interface overrides - MATCH BASE CLASS SIGNATURES
         bool execute() override;
         void stop(double fadeTime = 0.0) override;  // Note: fadeTime parameter
@@ -113,10 +163,15 @@ namespace CueForge {
         void validateTrimPoints();
         QString makeRoutingKey(int input, int output) const;
         void applyPlaybackSettings();
+        void prepareTimeStretch();
+        void applyNormalization();
+        bool startCrossfade();
+        void stopFadedOutCues();
 
         // *** AUDIO ENGINE CONNECTION - NEW ***
         AudioEngineQt* audioEngine_;  // Not owned - just a reference
         int playerId_;                // ID of player in audio engine (-1 if none)
+        int previewPlayerId_;         // Preview bus player (-1 if none)
 
         // Existing members
         QString filePath_;
@@ -124,16 +179,24 @@ namespace CueForge {
         double volume_;
         double pan_;
         double rate_;
+        bool timeStretch_;
+        bool rateAutomated_;
+        bool normalize_;
+        double normalizeTargetLufs_;
         double startTime_;
         double endTime_;
         bool loopEnabled_;
         QVariantMap matrixRouting_;
         QString audioOutputPatch_;
+        int reverbBus_;
+        double reverbSendDb_;
+        double crossfadeTime_;
+        QStringList crossfadeCues_;
+        bool crossfadeEqualPower_;
+        QTimer* crossfadeTimer_;        // Stops cues this one faded out
+        QList<QPair<QPointer<AudioCue>, int>> fadingOut_;   // Cue and its player at the crossfade
         double currentPosition_;
         bool isPlaying_;
-
-        protected:
-            void updateModifiedTime() { modifiedTime_ = QDateTime::currentDateTime(); }
     };
 
 } // namespace CueForge
\ No newline at end of file
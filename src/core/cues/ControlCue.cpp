@@ -5,6 +5,7 @@
 
 #include "ControlCue.h"
 #include "../CueManager.h"
+#include "../CueJsonKeys.h"
 #include <QDebug>
 
 namespace CueForge {
@@ -162,14 +163,15 @@ namespace CueForge {
     QJsonObject ControlCue::toJson() const
     {
         QJsonObject json = Cue::toJson();
-        json["fadeTime"] = fadeTime_;
+        json.insert(CueJsonKeys::FadeTime, fadeTime_);
         return json;
     }
 
     void ControlCue::fromJson(const QJsonObject& json)
     {
+        const LoadScope scope(this);
         Cue::fromJson(json);
-        setFadeTime(json.value("fadeTime").toDouble(0.0));
+        setFadeTime(json.value(CueJsonKeys::FadeTime).toDouble(0.0));
     }
 
     std::unique_ptr<Cue> ControlCue::clone() const
@@ -4,6 +4,7 @@
 // ============================================================================
 
 #include "GroupCue.h"
+#include "../CueJsonKeys.h"
 #include <QJsonArray>
 #include <QDebug>
 #include <QCoreApplication>
@@ -101,21 +102,22 @@ namespace CueForge {
             }
         }
 
-        json["children"] = childrenArray;
-        json["mode"] = groupModeToString(mode_);
+        json.insert(CueJsonKeys::Children, childrenArray);
+        json.insert(CueJsonKeys::Mode, groupModeToString(mode_));
 
         return json;
     }
 
     void GroupCue::fromJson(const QJsonObject& json)
     {
+        const LoadScope scope(this);
         Cue::fromJson(json);
 
         // Clear existing children
         children_.clear();
 
         // Load mode
-        QString modeStr = json["mode"].toString();
+        const QString modeStr = json.value(CueJsonKeys::Mode).toString();
         if (modeStr == "Sequential") {
             mode_ = GroupMode::Sequential;
         }
@@ -0,0 +1,303 @@
+// ============================================================================
+// LiveInputCue.cpp - Live device input passthrough cue implementation
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#include "LiveInputCue.h"
+#include "../../audio/AudioEngineQt.h"
+#include "../CueJsonKeys.h"
+#include <QDebug>
+#include <QJsonObject>
+#include <QTimer>
+#include <cmath>
+
+namespace CueForge {
+
+    namespace {
+        QString routingKey(int input, int output)
+        {
+            return QString("%1_%2").arg(input).arg(output);
+        }
+    }
+
+    LiveInputCue::LiveInputCue(QObject* parent)
+        : Cue(CueType::LiveInput, parent)
+        , audioEngine_(nullptr)
+        , liveInputId_(-1)
+        , volume_(1.0)
+        , fadeInTime_(0.0)
+    {
+        setName("Live Input");
+        setColor(QColor(255, 140, 90));
+
+        matrixRouting_.insert(routingKey(0, 0), 0.0);
+        matrixRouting_.insert(routingKey(1, 1), 0.0);
+    }
+
+    LiveInputCue::~LiveInputCue()
+    {
+        releaseLiveInput();
+        if (audioEngine_) {
+            for (int id : fadingOut_) {
+                audioEngine_->removeLiveInput(id);
+            }
+        }
+    }
+
+    void LiveInputCue::setAudioEngine(AudioEngineQt* engine)
+    {
+        audioEngine_ = engine;
+    }
+
+    void LiveInputCue::setVolume(double volume)
+    {
+        volume = qBound(0.0, volume, 1.0);
+        if (!qFuzzyCompare(volume_, volume)) {
+            volume_ = volume;
+            updateModifiedTime();
+            emit volumeChanged(volume_);
+
+            if (audioEngine_ && liveInputId_ >= 0 && status() == CueStatus::Running) {
+                audioEngine_->setLiveInputGain(liveInputId_, volume_);
+            }
+        }
+    }
+
+    void LiveInputCue::setFadeInTime(double seconds)
+    {
+        seconds = qMax(0.0, seconds);
+        if (!qFuzzyCompare(fadeInTime_, seconds)) {
+            fadeInTime_ = seconds;
+            updateModifiedTime();
+            emit fadeInTimeChanged(fadeInTime_);
+        }
+    }
+
+    // ============================================================================
+    // Routing
+    // ============================================================================
+
+    void LiveInputCue::setMatrixRouting(const QVariantMap& routing)
+    {
+        matrixRouting_ = routing;
+        updateModifiedTime();
+        applyRouting();
+    }
+
+    void LiveInputCue::setRoutingLevel(int inputChannel, int outputChannel, double levelDb)
+    {
+        const QString key = routingKey(inputChannel, outputChannel);
+
+        if (levelDb <= -96.0) {
+            matrixRouting_.remove(key);
+        }
+        else {
+            matrixRouting_[key] = levelDb;
+        }
+
+        updateModifiedTime();
+        applyRouting();
+    }
+
+    double LiveInputCue::getRoutingLevel(int inputChannel, int outputChannel) const
+    {
+        return matrixRouting_.value(routingKey(inputChannel, outputChannel), -96.0).toDouble();
+    }
+
+    void LiveInputCue::applyRouting()
+    {
+        if (!audioEngine_ || liveInputId_ < 0) {
+            return;
+        }
+
+        audioEngine_->clearLiveInputRoutes(liveInputId_);
+        for (auto it = matrixRouting_.constBegin(); it != matrixRouting_.constEnd(); ++it) {
+            const QStringList channels = it.key().split('_');
+            if (channels.size() != 2) {
+                continue;
+            }
+            const double gain = std::pow(10.0, it.value().toDouble() / 20.0);
+            audioEngine_->setLiveInputRoute(liveInputId_, channels[0].toInt(), channels[1].toInt(), gain);
+        }
+    }
+
+    // ============================================================================
+    // Playback Control
+    // ============================================================================
+
+    bool LiveInputCue::execute()
+    {
+        if (!canExecute()) {
+            qWarning() << "LiveInputCue::execute() - Cannot execute cue:" << number();
+            return false;
+        }
+
+        if (!audioEngine_ || !audioEngine_->isInitialized()) {
+            qWarning() << "LiveInputCue::execute() - Audio engine not initialized";
+            return false;
+        }
+
+        if (audioEngine_->inputChannelCount() == 0) {
+            emit warning("Audio device has no inputs open");
+        }
+
+        releaseLiveInput();
+        liveInputId_ = audioEngine_->createLiveInput();
+        if (liveInputId_ < 0) {
+            qWarning() << "LiveInputCue::execute() - Failed to create live input";
+            return false;
+        }
+
+        applyRouting();
+        audioEngine_->setLiveInputGain(liveInputId_, volume_, fadeInTime_);
+
+        setStatus(CueStatus::Running);
+        qDebug() << "LiveInputCue::execute() - Live input" << liveInputId_ << "open for cue" << number();
+        return true;
+    }
+
+    void LiveInputCue::stop(double fadeTime)
+    {
+        if (liveInputId_ < 0) {
+            return;
+        }
+
+        qDebug() << "LiveInputCue::stop() - Stopping cue" << number() << "fade:" << fadeTime;
+
+        if (fadeTime > 0.0 && audioEngine_ && status() == CueStatus::Running) {
+            // Ramp down in the engine and drop the input once it is silent;
+            // a new GO meanwhile opens a fresh one
+            const int id = liveInputId_;
+            liveInputId_ = -1;
+            fadingOut_.append(id);
+            audioEngine_->setLiveInputGain(id, 0.0, fadeTime);
+
+            QTimer::singleShot(static_cast<int>(fadeTime * 1000.0) + 50, this, [this, id]() {
+                if (fadingOut_.removeOne(id) && audioEngine_) {
+                    audioEngine_->removeLiveInput(id);
+                }
+            });
+        }
+        else {
+            releaseLiveInput();
+        }
+
+        setStatus(CueStatus::Stopped);
+    }
+
+    void LiveInputCue::pause()
+    {
+        if (status() != CueStatus::Running) {
+            return;
+        }
+
+        // Muted rather than closed, so resume is immediate
+        if (audioEngine_ && liveInputId_ >= 0) {
+            audioEngine_->setLiveInputGain(liveInputId_, 0.0);
+        }
+        setStatus(CueStatus::Paused);
+    }
+
+    void LiveInputCue::resume()
+    {
+        if (status() != CueStatus::Paused) {
+            return;
+        }
+
+        if (audioEngine_ && liveInputId_ >= 0) {
+            audioEngine_->setLiveInputGain(liveInputId_, volume_);
+        }
+        setStatus(CueStatus::Running);
+    }
+
+    void LiveInputCue::releaseLiveInput()
+    {
+        if (audioEngine_ && liveInputId_ >= 0) {
+            audioEngine_->removeLiveInput(liveInputId_);
+        }
+        liveInputId_ = -1;
+    }
+
+    bool LiveInputCue::canExecute() const
+    {
+        return Cue::canExecute() && audioEngine_ != nullptr;
+    }
+
+    bool LiveInputCue::validate()
+    {
+        return Cue::validate() && !matrixRouting_.isEmpty();
+    }
+
+    QString LiveInputCue::validationError() const
+    {
+        if (matrixRouting_.isEmpty()) {
+            return "No inputs routed";
+        }
+        return Cue::validationError();
+    }
+
+    // ============================================================================
+    // Serialization
+    // ============================================================================
+
+    QJsonObject LiveInputCue::toJson() const
+    {
+        using namespace CueJsonKeys;
+        QJsonObject json = Cue::toJson();
+
+        json.insert(Volume, volume_);
+        json.insert(FadeInTime, fadeInTime_);
+
+        QJsonObject routingObj;
+        for (auto it = matrixRouting_.constBegin(); it != matrixRouting_.constEnd(); ++it) {
+            routingObj.insert(it.key(), it.value().toDouble());
+        }
+        json.insert(MatrixRouting, routingObj);
+
+        return json;
+    }
+
+    void LiveInputCue::fromJson(const QJsonObject& json)
+    {
+        using namespace CueJsonKeys;
+        const LoadScope scope(this);
+
+        Cue::fromJson(json);
+
+        setVolume(json.value(Volume).toDouble(1.0));
+        setFadeInTime(json.value(FadeInTime).toDouble(0.0));
+
+        const QJsonValue routing = json.value(MatrixRouting);
+        if (routing.isObject()) {
+            const QJsonObject routingObj = routing.toObject();
+            matrixRouting_.clear();
+            for (auto it = routingObj.constBegin(); it != routingObj.constEnd(); ++it) {
+                matrixRouting_.insert(it.key(), it.value().toDouble());
+            }
+            updateModifiedTime();
+        }
+    }
+
+    std::unique_ptr<Cue> LiveInputCue::clone() const
+    {
+        auto cloned = std::make_unique<LiveInputCue>();
+
+        cloned->setNumber(number());
+        cloned->setName(name() + " Copy");
+        cloned->setDuration(duration());
+        cloned->setPreWait(preWait());
+        cloned->setPostWait(postWait());
+        cloned->setContinueMode(continueMode());
+        cloned->setColor(color());
+        cloned->setNotes(notes());
+        cloned->setArmed(isArmed());
+
+        cloned->setAudioEngine(audioEngine_);
+        cloned->setVolume(volume_);
+        cloned->setFadeInTime(fadeInTime_);
+        cloned->setMatrixRouting(matrixRouting_);
+
+        return cloned;
+    }
+
+} // namespace CueForge
@@ -0,0 +1,79 @@
+// ============================================================================
+// LiveInputCue.h - Live device input passthrough cue
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#pragma once
+
+#include "../Cue.h"
+#include <QList>
+#include <QVariantMap>
+
+namespace CueForge {
+
+    class AudioEngineQt;
+
+    /**
+     * Routes audio device inputs (a presenter mic, a playback rig) through
+     * the engine to the outputs while running. Input samples are mixed in
+     * the same callback that delivers them, so the path adds nothing beyond
+     * the device block. Runs until stopped; fade in on GO and fade out on
+     * stop use the engine's per-sample gain ramp.
+     */
+    class LiveInputCue : public Cue
+    {
+        Q_OBJECT
+            Q_PROPERTY(double volume READ volume WRITE setVolume NOTIFY volumeChanged)
+            Q_PROPERTY(double fadeInTime READ fadeInTime WRITE setFadeInTime NOTIFY fadeInTimeChanged)
+
+    public:
+        explicit LiveInputCue(QObject* parent = nullptr);
+        ~LiveInputCue() override;
+
+        void setAudioEngine(AudioEngineQt* engine);
+        AudioEngineQt* audioEngine() const { return audioEngine_; }
+        int liveInputId() const { return liveInputId_; }
+
+        // Linear, 0.0 to 1.0
+        double volume() const { return volume_; }
+        void setVolume(double volume);
+
+        double fadeInTime() const { return fadeInTime_; }
+        void setFadeInTime(double seconds);
+
+        // Input -> output levels in dB, keyed "in_out" as on AudioCue.
+        // Defaults to inputs 1 and 2 straight to outputs 1 and 2.
+        QVariantMap matrixRouting() const { return matrixRouting_; }
+        void setMatrixRouting(const QVariantMap& routing);
+        void setRoutingLevel(int inputChannel, int outputChannel, double levelDb);
+        double getRoutingLevel(int inputChannel, int outputChannel) const;
+
+        bool execute() override;
+        void stop(double fadeTime = 0.0) override;
+        void pause() override;
+        void resume() override;
+        bool canExecute() const override;
+        bool validate() override;
+        QString validationError() const override;
+
+        QJsonObject toJson() const override;
+        void fromJson(const QJsonObject& json) override;
+        std::unique_ptr<Cue> clone() const override;
+
+    signals:
+        void volumeChanged(double volume);
+        void fadeInTimeChanged(double seconds);
+
+    private:
+        void applyRouting();
+        void releaseLiveInput();
+
+        AudioEngineQt* audioEngine_;    // Not owned
+        int liveInputId_;               // -1 when not running
+        QList<int> fadingOut_;          // Stopped with a fade, removed when it ends
+        double volume_;
+        double fadeInTime_;
+        QVariantMap matrixRouting_;
+    };
+
+} // namespace CueForge
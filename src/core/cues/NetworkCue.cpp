@@ -0,0 +1,402 @@
+// ============================================================================
+// NetworkCue.cpp - TCP/HTTP command cue implementation
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#include "NetworkCue.h"
+#include "../CueJsonKeys.h"
+#include <QJsonObject>
+#include <QDebug>
+
+namespace CueForge {
+
+    namespace {
+        NetworkCommand::Protocol toCommandProtocol(NetworkCue::Protocol protocol)
+        {
+            return protocol == NetworkCue::Protocol::Http
+                ? NetworkCommand::Protocol::Http
+                : NetworkCommand::Protocol::Tcp;
+        }
+    }
+
+    NetworkCue::NetworkCue(QObject* parent)
+        : Cue(CueType::Network, parent)
+        , pool_(nullptr)
+        , pendingId_(0)
+        , protocol_(Protocol::Tcp)
+        , port_(0)
+        , httpMethod_("GET")
+        , httpPath_("/")
+        , expectReply_(false)
+        , replyTerminator_("\\r\\n")
+        , timeoutMs_(2000)
+        , lastLatencyMs_(0.0)
+    {
+        setName("Network");
+        setColor(QColor(100, 200, 255));
+        setDuration(0.0);
+
+        connect(this, &Cue::armedChanged, this, &NetworkCue::updateWarmConnection);
+    }
+
+    NetworkCue::~NetworkCue()
+    {
+        if (pool_ && !warmedKey_.isEmpty()) {
+            pool_->release(warmed_.protocol, warmed_.host, warmed_.port);
+        }
+    }
+
+    void NetworkCue::setConnectionPool(ConnectionPool* pool)
+    {
+        if (pool_ == pool) {
+            return;
+        }
+
+        if (pool_) {
+            if (!warmedKey_.isEmpty()) {
+                pool_->release(warmed_.protocol, warmed_.host, warmed_.port);
+            }
+            pool_->disconnect(this);
+        }
+
+        pool_ = pool;
+        warmedKey_.clear();
+
+        if (pool_) {
+            connect(pool_, &ConnectionPool::commandFinished, this, &NetworkCue::onCommandFinished);
+        }
+
+        updateWarmConnection();
+    }
+
+    void NetworkCue::setProtocol(Protocol protocol)
+    {
+        if (protocol_ != protocol) {
+            protocol_ = protocol;
+            updateModifiedTime();
+            emit destinationChanged();
+            updateWarmConnection();
+        }
+    }
+
+    void NetworkCue::setHost(const QString& host)
+    {
+        const QString trimmed = host.trimmed();
+        if (host_ != trimmed) {
+            host_ = trimmed;
+            updateModifiedTime();
+            emit destinationChanged();
+            updateWarmConnection();
+        }
+    }
+
+    void NetworkCue::setPort(int port)
+    {
+        port = qBound(0, port, 65535);
+        if (port_ != port) {
+            port_ = port;
+            updateModifiedTime();
+            emit destinationChanged();
+            updateWarmConnection();
+        }
+    }
+
+    void NetworkCue::setMessage(const QString& message)
+    {
+        if (message_ != message) {
+            message_ = message;
+            updateModifiedTime();
+            emit messageChanged(message_);
+        }
+    }
+
+    void NetworkCue::setHttpMethod(const QString& method)
+    {
+        const QString upper = method.trimmed().toUpper();
+        if (!upper.isEmpty() && httpMethod_ != upper) {
+            httpMethod_ = upper;
+            updateModifiedTime();
+        }
+    }
+
+    void NetworkCue::setHttpPath(const QString& path)
+    {
+        QString normalized = path.trimmed();
+        if (!normalized.startsWith('/')) {
+            normalized.prepend('/');
+        }
+        if (httpPath_ != normalized) {
+            httpPath_ = normalized;
+            updateModifiedTime();
+        }
+    }
+
+    void NetworkCue::setContentType(const QString& contentType)
+    {
+        if (contentType_ != contentType) {
+            contentType_ = contentType;
+            updateModifiedTime();
+        }
+    }
+
+    void NetworkCue::setExpectReply(bool expect)
+    {
+        if (expectReply_ != expect) {
+            expectReply_ = expect;
+            updateModifiedTime();
+        }
+    }
+
+    void NetworkCue::setReplyTerminator(const QString& terminator)
+    {
+        if (replyTerminator_ != terminator) {
+            replyTerminator_ = terminator;
+            updateModifiedTime();
+        }
+    }
+
+    void NetworkCue::setTimeoutMs(int ms)
+    {
+        ms = qBound(10, ms, 60000);
+        if (timeoutMs_ != ms) {
+            timeoutMs_ = ms;
+            updateModifiedTime();
+        }
+    }
+
+    void NetworkCue::updateWarmConnection()
+    {
+        if (!pool_) {
+            return;
+        }
+
+        const bool wanted = isArmed() && !host_.isEmpty() && port_ > 0;
+        const NetworkCommand::Protocol protocol = toCommandProtocol(protocol_);
+        const QString key = wanted
+            ? NetworkCommand::endpointKey(protocol, host_, static_cast<quint16>(port_))
+            : QString();
+
+        if (key == warmedKey_) {
+            return;
+        }
+
+        if (!warmedKey_.isEmpty()) {
+            pool_->release(warmed_.protocol, warmed_.host, warmed_.port);
+        }
+
+        warmedKey_ = key;
+        if (wanted) {
+            warmed_.protocol = protocol;
+            warmed_.host = host_;
+            warmed_.port = static_cast<quint16>(port_);
+            pool_->warm(protocol, host_, warmed_.port);
+        }
+    }
+
+    QByteArray NetworkCue::expandEscapes(const QString& text)
+    {
+        const QByteArray in = text.toUtf8();
+        QByteArray out;
+        out.reserve(in.size());
+
+        for (int i = 0; i < in.size(); ++i) {
+            const char c = in[i];
+            if (c != '\\' || i + 1 >= in.size()) {
+                out.append(c);
+                continue;
+            }
+
+            const char next = in[++i];
+            switch (next) {
+            case 'r': out.append('\r'); break;
+            case 'n': out.append('\n'); break;
+            case 't': out.append('\t'); break;
+            case '0': out.append('\0'); break;
+            case '\\': out.append('\\'); break;
+            case 'x': {
+                bool ok = false;
+                const int value = in.mid(i + 1, 2).toInt(&ok, 16);
+                if (ok && i + 2 < in.size()) {
+                    out.append(static_cast<char>(value));
+                    i += 2;
+                }
+                else {
+                    out.append("\\x");
+                }
+                break;
+            }
+            default:
+                out.append('\\');
+                out.append(next);
+                break;
+            }
+        }
+
+        return out;
+    }
+
+    // ============================================================================
+    // Execution
+    // ============================================================================
+
+    bool NetworkCue::execute()
+    {
+        if (!canExecute()) {
+            qWarning() << "NetworkCue::execute() - Cannot execute cue:" << number();
+            return false;
+        }
+
+        if (!pool_) {
+            qWarning() << "NetworkCue::execute() - No connection pool connected!";
+            return false;
+        }
+
+        NetworkCommand command;
+        command.protocol = toCommandProtocol(protocol_);
+        command.host = host_;
+        command.port = static_cast<quint16>(port_);
+        command.payload = expandEscapes(message_);
+        command.httpMethod = httpMethod_.toUtf8();
+        command.httpPath = httpPath_.toUtf8();
+        command.contentType = contentType_.toUtf8();
+        command.expectReply = expectReply_;
+        command.replyTerminator = expandEscapes(replyTerminator_);
+        command.timeoutMs = timeoutMs_;
+
+        pendingId_ = pool_->send(command);
+
+        setStatus(CueStatus::Running);
+        emit executionStarted();
+        return true;
+    }
+
+    void NetworkCue::stop(double fadeTime)
+    {
+        Q_UNUSED(fadeTime);
+
+        // A command already on the wire can't be recalled; just stop waiting
+        pendingId_ = 0;
+        if (status() == CueStatus::Running) {
+            setStatus(CueStatus::Stopped);
+        }
+    }
+
+    void NetworkCue::onCommandFinished(const NetworkCommandResult& result)
+    {
+        if (result.id != pendingId_ || pendingId_ == 0) {
+            return;
+        }
+
+        pendingId_ = 0;
+        lastLatencyMs_ = result.latencyMs;
+        lastReply_ = QString::fromUtf8(result.reply);
+
+        if (result.ok) {
+            qDebug() << "NetworkCue: Cue" << number() << "sent to" << result.endpoint
+                << "in" << QString::number(result.latencyMs, 'f', 2) << "ms";
+        }
+        else {
+            emit warning(QString("Network cue %1 failed (%2): %3")
+                .arg(number(), result.endpoint, result.error));
+        }
+
+        emit commandCompleted(result.ok, result.latencyMs, lastReply_);
+
+        setStatus(CueStatus::Finished);
+        emit executionFinished();
+    }
+
+    bool NetworkCue::canExecute() const
+    {
+        return Cue::canExecute() && !host_.isEmpty() && port_ > 0;
+    }
+
+    bool NetworkCue::validate()
+    {
+        return Cue::validate() && !host_.isEmpty() && port_ > 0;
+    }
+
+    QString NetworkCue::validationError() const
+    {
+        if (host_.isEmpty()) {
+            return "No destination host";
+        }
+        if (port_ <= 0) {
+            return "No destination port";
+        }
+        return Cue::validationError();
+    }
+
+    // ============================================================================
+    // Serialization
+    // ============================================================================
+
+    QJsonObject NetworkCue::toJson() const
+    {
+        using namespace CueJsonKeys;
+        QJsonObject json = Cue::toJson();
+
+        json.insert(CueJsonKeys::Protocol, protocol_ == Protocol::Http ? QStringLiteral("http") : QStringLiteral("tcp"));
+        json.insert(Host, host_);
+        json.insert(Port, port_);
+        json.insert(Message, message_);
+        json.insert(HttpMethod, httpMethod_);
+        json.insert(HttpPath, httpPath_);
+        json.insert(ContentType, contentType_);
+        json.insert(ExpectReply, expectReply_);
+        json.insert(ReplyTerminator, replyTerminator_);
+        json.insert(TimeoutMs, timeoutMs_);
+
+        return json;
+    }
+
+    void NetworkCue::fromJson(const QJsonObject& json)
+    {
+        using namespace CueJsonKeys;
+        const LoadScope scope(this);
+
+        Cue::fromJson(json);
+
+        setMessage(json.value(Message).toString());
+        setHttpMethod(json.value(HttpMethod).toString("GET"));
+        setHttpPath(json.value(HttpPath).toString("/"));
+        setContentType(json.value(ContentType).toString());
+        setExpectReply(json.value(ExpectReply).toBool(false));
+        setReplyTerminator(json.value(ReplyTerminator).toString("\\r\\n"));
+        setTimeoutMs(json.value(TimeoutMs).toInt(2000));
+
+        // Destination last so the pool warms the final endpoint only
+        setProtocol(json.value(CueJsonKeys::Protocol).toString() == QLatin1StringView("http") ? Protocol::Http : Protocol::Tcp);
+        setHost(json.value(Host).toString());
+        setPort(json.value(Port).toInt(0));
+    }
+
+    std::unique_ptr<Cue> NetworkCue::clone() const
+    {
+        auto cloned = std::make_unique<NetworkCue>();
+
+        cloned->setNumber(number());
+        cloned->setName(name() + " Copy");
+        cloned->setDuration(duration());
+        cloned->setPreWait(preWait());
+        cloned->setPostWait(postWait());
+        cloned->setContinueMode(continueMode());
+        cloned->setColor(color());
+        cloned->setNotes(notes());
+        cloned->setArmed(isArmed());
+
+        cloned->setMessage(message_);
+        cloned->setHttpMethod(httpMethod_);
+        cloned->setHttpPath(httpPath_);
+        cloned->setContentType(contentType_);
+        cloned->setExpectReply(expectReply_);
+        cloned->setReplyTerminator(replyTerminator_);
+        cloned->setTimeoutMs(timeoutMs_);
+        cloned->setProtocol(protocol_);
+        cloned->setHost(host_);
+        cloned->setPort(port_);
+
+        return cloned;
+    }
+
+} // namespace CueForge
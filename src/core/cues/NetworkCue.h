@@ -0,0 +1,117 @@
+// ============================================================================
+// NetworkCue.h - TCP/HTTP command cue
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#pragma once
+
+#include "../Cue.h"
+#include "../../network/ConnectionPool.h"
+#include <QString>
+#include <QByteArray>
+
+namespace CueForge {
+
+    /**
+     * Sends a command to a device over a pooled, pre-connected TCP socket
+     * or HTTP/1.1 keep-alive connection. The connection is opened as soon
+     * as the cue is armed with a destination, so GO only writes bytes.
+     */
+    class NetworkCue : public Cue
+    {
+        Q_OBJECT
+            Q_PROPERTY(QString host READ host WRITE setHost NOTIFY destinationChanged)
+            Q_PROPERTY(int port READ port WRITE setPort NOTIFY destinationChanged)
+            Q_PROPERTY(QString message READ message WRITE setMessage NOTIFY messageChanged)
+
+    public:
+        enum class Protocol {
+            Tcp,
+            Http
+        };
+
+        explicit NetworkCue(QObject* parent = nullptr);
+        ~NetworkCue() override;
+
+        void setConnectionPool(ConnectionPool* pool);
+        ConnectionPool* connectionPool() const { return pool_; }
+
+        Protocol protocol() const { return protocol_; }
+        void setProtocol(Protocol protocol);
+
+        QString host() const { return host_; }
+        void setHost(const QString& host);
+
+        int port() const { return port_; }
+        void setPort(int port);
+
+        // TCP payload or HTTP body. Escapes \r \n \t \\ and \xHH are expanded.
+        QString message() const { return message_; }
+        void setMessage(const QString& message);
+
+        QString httpMethod() const { return httpMethod_; }
+        void setHttpMethod(const QString& method);
+
+        QString httpPath() const { return httpPath_; }
+        void setHttpPath(const QString& path);
+
+        QString contentType() const { return contentType_; }
+        void setContentType(const QString& contentType);
+
+        // TCP: wait for a reply ending in the terminator before finishing
+        bool expectReply() const { return expectReply_; }
+        void setExpectReply(bool expect);
+
+        QString replyTerminator() const { return replyTerminator_; }
+        void setReplyTerminator(const QString& terminator);
+
+        int timeoutMs() const { return timeoutMs_; }
+        void setTimeoutMs(int ms);
+
+        double lastLatencyMs() const { return lastLatencyMs_; }
+        QString lastReply() const { return lastReply_; }
+
+        static QByteArray expandEscapes(const QString& text);
+
+        bool execute() override;
+        void stop(double fadeTime = 0.0) override;
+        bool canExecute() const override;
+        bool validate() override;
+        QString validationError() const override;
+
+        QJsonObject toJson() const override;
+        void fromJson(const QJsonObject& json) override;
+        std::unique_ptr<Cue> clone() const override;
+
+    signals:
+        void destinationChanged();
+        void messageChanged(const QString& message);
+        void commandCompleted(bool ok, double latencyMs, const QString& reply);
+
+    private slots:
+        void onCommandFinished(const CueForge::NetworkCommandResult& result);
+
+    private:
+        void updateWarmConnection();
+
+        ConnectionPool* pool_;  // Not owned
+        quint64 pendingId_;
+        QString warmedKey_;
+        NetworkCommand warmed_;   // Endpoint currently held open in the pool
+
+        Protocol protocol_;
+        QString host_;
+        int port_;
+        QString message_;
+        QString httpMethod_;
+        QString httpPath_;
+        QString contentType_;
+        bool expectReply_;
+        QString replyTerminator_;
+        int timeoutMs_;
+
+        double lastLatencyMs_;
+        QString lastReply_;
+    };
+
+} // namespace CueForge
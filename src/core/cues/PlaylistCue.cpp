@@ -0,0 +1,317 @@
+// ============================================================================
+// PlaylistCue.cpp - Gapless music playlist cue implementation
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#include "PlaylistCue.h"
+#include "../../audio/AudioEngineQt.h"
+#include "../CueJsonKeys.h"
+#include <QDebug>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonObject>
+
+namespace CueForge {
+
+    PlaylistCue::PlaylistCue(QObject* parent)
+        : Cue(CueType::Playlist, parent)
+        , audioEngine_(nullptr)
+        , playlistPlayerId_(-1)
+        , pollTimer_(new QTimer(this))
+        , currentTrack_(-1)
+        , volume_(1.0)
+        , crossfadeTime_(0.0)
+        , shuffle_(false)
+        , loopEnabled_(false)
+    {
+        setName("Playlist");
+        setColor(QColor(150, 200, 120));
+
+        pollTimer_->setInterval(100);
+        connect(pollTimer_, &QTimer::timeout, this, &PlaylistCue::onPollTimer);
+    }
+
+    PlaylistCue::~PlaylistCue()
+    {
+        releasePlaylist();
+    }
+
+    void PlaylistCue::setAudioEngine(AudioEngineQt* engine)
+    {
+        audioEngine_ = engine;
+    }
+
+    // ============================================================================
+    // Tracks and options
+    // ============================================================================
+
+    void PlaylistCue::setTracks(const QStringList& tracks)
+    {
+        if (tracks_ != tracks) {
+            tracks_ = tracks;
+            updateModifiedTime();
+            emit tracksChanged();
+        }
+    }
+
+    void PlaylistCue::addTrack(const QString& filePath)
+    {
+        tracks_.append(filePath);
+        updateModifiedTime();
+        emit tracksChanged();
+    }
+
+    void PlaylistCue::removeTrack(int index)
+    {
+        if (index >= 0 && index < tracks_.size()) {
+            tracks_.removeAt(index);
+            updateModifiedTime();
+            emit tracksChanged();
+        }
+    }
+
+    bool PlaylistCue::skipTrack()
+    {
+        if (!audioEngine_ || playlistPlayerId_ < 0) {
+            return false;
+        }
+        return audioEngine_->skipPlaylistTrack(playlistPlayerId_);
+    }
+
+    void PlaylistCue::setVolume(double volume)
+    {
+        volume = qBound(0.0, volume, 1.0);
+        if (!qFuzzyCompare(volume_, volume)) {
+            volume_ = volume;
+            updateModifiedTime();
+            emit volumeChanged(volume_);
+
+            if (audioEngine_ && playlistPlayerId_ >= 0) {
+                audioEngine_->setPlaylistVolume(playlistPlayerId_, volume_);
+            }
+        }
+    }
+
+    void PlaylistCue::setCrossfadeTime(double seconds)
+    {
+        seconds = qBound(0.0, seconds, 30.0);
+        if (!qFuzzyCompare(crossfadeTime_, seconds)) {
+            crossfadeTime_ = seconds;
+            updateModifiedTime();
+            emit crossfadeTimeChanged(crossfadeTime_);
+        }
+    }
+
+    void PlaylistCue::setShuffle(bool shuffle)
+    {
+        if (shuffle_ != shuffle) {
+            shuffle_ = shuffle;
+            updateModifiedTime();
+            emit shuffleChanged(shuffle_);
+        }
+    }
+
+    void PlaylistCue::setLoopEnabled(bool enabled)
+    {
+        if (loopEnabled_ != enabled) {
+            loopEnabled_ = enabled;
+            updateModifiedTime();
+            emit loopEnabledChanged(loopEnabled_);
+        }
+    }
+
+    // ============================================================================
+    // Playback Control
+    // ============================================================================
+
+    bool PlaylistCue::execute()
+    {
+        if (!canExecute()) {
+            qWarning() << "PlaylistCue::execute() - Cannot execute cue:" << number();
+            return false;
+        }
+
+        if (!audioEngine_ || !audioEngine_->isInitialized()) {
+            qWarning() << "PlaylistCue::execute() - Audio engine not initialized";
+            return false;
+        }
+
+        // Options are fixed for a run; changes apply from the next GO
+        releasePlaylist();
+        playlistPlayerId_ = audioEngine_->createPlaylistPlayer(tracks_, crossfadeTime_, shuffle_, loopEnabled_);
+        if (playlistPlayerId_ < 0) {
+            qWarning() << "PlaylistCue::execute() - Failed to load playlist for cue" << number();
+            setStatus(CueStatus::Broken);
+            return false;
+        }
+
+        audioEngine_->setPlaylistVolume(playlistPlayerId_, volume_);
+        if (!audioEngine_->playPlaylist(playlistPlayerId_)) {
+            releasePlaylist();
+            return false;
+        }
+
+        pollTimer_->start();
+        setStatus(CueStatus::Running);
+        qDebug() << "PlaylistCue::execute() - Playing" << tracks_.size() << "tracks for cue" << number();
+        return true;
+    }
+
+    void PlaylistCue::stop(double fadeTime)
+    {
+        Q_UNUSED(fadeTime);
+
+        if (playlistPlayerId_ < 0) {
+            return;
+        }
+
+        qDebug() << "PlaylistCue::stop() - Stopping cue" << number();
+        releasePlaylist();
+        setStatus(CueStatus::Stopped);
+    }
+
+    void PlaylistCue::pause()
+    {
+        if (status() != CueStatus::Running) {
+            return;
+        }
+
+        if (audioEngine_ && playlistPlayerId_ >= 0) {
+            audioEngine_->pausePlaylist(playlistPlayerId_);
+        }
+        setStatus(CueStatus::Paused);
+    }
+
+    void PlaylistCue::resume()
+    {
+        if (status() != CueStatus::Paused) {
+            return;
+        }
+
+        if (audioEngine_ && playlistPlayerId_ >= 0) {
+            audioEngine_->resumePlaylist(playlistPlayerId_);
+        }
+        setStatus(CueStatus::Running);
+    }
+
+    void PlaylistCue::onPollTimer()
+    {
+        if (!audioEngine_ || playlistPlayerId_ < 0) {
+            pollTimer_->stop();
+            return;
+        }
+
+        const int track = audioEngine_->playlistCurrentTrack(playlistPlayerId_);
+        if (track != currentTrack_) {
+            currentTrack_ = track;
+            emit currentTrackChanged(currentTrack_);
+        }
+
+        if (status() == CueStatus::Running && !audioEngine_->isPlaylistPlaying(playlistPlayerId_)) {
+            qDebug() << "PlaylistCue::onPollTimer() - Playlist finished for cue" << number();
+            releasePlaylist();
+            setStatus(CueStatus::Finished);
+            emit executionFinished();
+        }
+    }
+
+    void PlaylistCue::releasePlaylist()
+    {
+        pollTimer_->stop();
+        if (audioEngine_ && playlistPlayerId_ >= 0) {
+            audioEngine_->removePlaylistPlayer(playlistPlayerId_);
+        }
+        playlistPlayerId_ = -1;
+
+        if (currentTrack_ != -1) {
+            currentTrack_ = -1;
+            emit currentTrackChanged(currentTrack_);
+        }
+    }
+
+    bool PlaylistCue::canExecute() const
+    {
+        return Cue::canExecute() && audioEngine_ != nullptr && !tracks_.isEmpty();
+    }
+
+    bool PlaylistCue::validate()
+    {
+        return Cue::validate() && validationError().isEmpty();
+    }
+
+    QString PlaylistCue::validationError() const
+    {
+        if (tracks_.isEmpty()) {
+            return "Playlist is empty";
+        }
+        for (const QString& track : tracks_) {
+            if (!QFileInfo::exists(track)) {
+                return QString("Track not found: %1").arg(track);
+            }
+        }
+        return Cue::validationError();
+    }
+
+    // ============================================================================
+    // Serialization
+    // ============================================================================
+
+    QJsonObject PlaylistCue::toJson() const
+    {
+        using namespace CueJsonKeys;
+        QJsonObject json = Cue::toJson();
+
+        json.insert(Tracks, QJsonArray::fromStringList(tracks_));
+        json.insert(Volume, volume_);
+        json.insert(CrossfadeTime, crossfadeTime_);
+        json.insert(Shuffle, shuffle_);
+        json.insert(LoopEnabled, loopEnabled_);
+
+        return json;
+    }
+
+    void PlaylistCue::fromJson(const QJsonObject& json)
+    {
+        using namespace CueJsonKeys;
+        const LoadScope scope(this);
+
+        Cue::fromJson(json);
+
+        QStringList tracks;
+        const QJsonArray tracksArray = json.value(Tracks).toArray();
+        for (const QJsonValue& value : tracksArray) {
+            tracks.append(value.toString());
+        }
+        setTracks(tracks);
+
+        setVolume(json.value(Volume).toDouble(1.0));
+        setCrossfadeTime(json.value(CrossfadeTime).toDouble(0.0));
+        setShuffle(json.value(Shuffle).toBool(false));
+        setLoopEnabled(json.value(LoopEnabled).toBool(false));
+    }
+
+    std::unique_ptr<Cue> PlaylistCue::clone() const
+    {
+        auto cloned = std::make_unique<PlaylistCue>();
+
+        cloned->setNumber(number());
+        cloned->setName(name() + " Copy");
+        cloned->setDuration(duration());
+        cloned->setPreWait(preWait());
+        cloned->setPostWait(postWait());
+        cloned->setContinueMode(continueMode());
+        cloned->setColor(color());
+        cloned->setNotes(notes());
+        cloned->setArmed(isArmed());
+
+        cloned->setAudioEngine(audioEngine_);
+        cloned->setTracks(tracks_);
+        cloned->setVolume(volume_);
+        cloned->setCrossfadeTime(crossfadeTime_);
+        cloned->setShuffle(shuffle_);
+        cloned->setLoopEnabled(loopEnabled_);
+
+        return cloned;
+    }
+
+} // namespace CueForge
@@ -0,0 +1,97 @@
+// ============================================================================
+// PlaylistCue.h - Gapless music playlist cue
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#pragma once
+
+#include "../Cue.h"
+#include <QStringList>
+#include <QTimer>
+
+namespace CueForge {
+
+    class AudioEngineQt;
+
+    /**
+     * Pre-show and interval music: a list of tracks played back to back as
+     * one engine voice, spliced on the exact sample (or crossfaded) instead
+     * of being chained through post-waits. Optional shuffle and loop.
+     */
+    class PlaylistCue : public Cue
+    {
+        Q_OBJECT
+            Q_PROPERTY(double volume READ volume WRITE setVolume NOTIFY volumeChanged)
+            Q_PROPERTY(double crossfadeTime READ crossfadeTime WRITE setCrossfadeTime NOTIFY crossfadeTimeChanged)
+            Q_PROPERTY(bool shuffle READ shuffle WRITE setShuffle NOTIFY shuffleChanged)
+            Q_PROPERTY(bool loopEnabled READ loopEnabled WRITE setLoopEnabled NOTIFY loopEnabledChanged)
+
+    public:
+        explicit PlaylistCue(QObject* parent = nullptr);
+        ~PlaylistCue() override;
+
+        void setAudioEngine(AudioEngineQt* engine);
+        AudioEngineQt* audioEngine() const { return audioEngine_; }
+        int playlistPlayerId() const { return playlistPlayerId_; }
+
+        QStringList tracks() const { return tracks_; }
+        void setTracks(const QStringList& tracks);
+        void addTrack(const QString& filePath);
+        void removeTrack(int index);
+
+        // Index into tracks() now playing, -1 when not running
+        int currentTrack() const { return currentTrack_; }
+        bool skipTrack();
+
+        // Linear, 0.0 to 1.0
+        double volume() const { return volume_; }
+        void setVolume(double volume);
+
+        // Seconds each track overlaps the next; 0 splices back to back
+        double crossfadeTime() const { return crossfadeTime_; }
+        void setCrossfadeTime(double seconds);
+
+        bool shuffle() const { return shuffle_; }
+        void setShuffle(bool shuffle);
+
+        bool loopEnabled() const { return loopEnabled_; }
+        void setLoopEnabled(bool enabled);
+
+        bool execute() override;
+        void stop(double fadeTime = 0.0) override;
+        void pause() override;
+        void resume() override;
+        bool canExecute() const override;
+        bool validate() override;
+        QString validationError() const override;
+
+        QJsonObject toJson() const override;
+        void fromJson(const QJsonObject& json) override;
+        std::unique_ptr<Cue> clone() const override;
+
+    signals:
+        void tracksChanged();
+        void currentTrackChanged(int track);
+        void volumeChanged(double volume);
+        void crossfadeTimeChanged(double seconds);
+        void shuffleChanged(bool shuffle);
+        void loopEnabledChanged(bool enabled);
+
+    private slots:
+        void onPollTimer();
+
+    private:
+        void releasePlaylist();
+
+        AudioEngineQt* audioEngine_;    // Not owned
+        int playlistPlayerId_;          // -1 when not running
+        QTimer* pollTimer_;             // Track changes and the end of the list
+        QStringList tracks_;
+        int currentTrack_;
+        double volume_;
+        double crossfadeTime_;
+        bool shuffle_;
+        bool loopEnabled_;
+    };
+
+} // namespace CueForge
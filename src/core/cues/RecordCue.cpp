@@ -0,0 +1,384 @@
+// ============================================================================
+// RecordCue.cpp - Record device inputs or the mix to disk implementation
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#include "RecordCue.h"
+#include "AudioCue.h"
+#include "../../audio/AudioEngineQt.h"
+#include "../CueJsonKeys.h"
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QRegularExpression>
+#include <QStandardPaths>
+
+namespace CueForge {
+
+    RecordCue::RecordCue(QObject* parent)
+        : Cue(CueType::Record, parent)
+        , audioEngine_(nullptr)
+        , recorderId_(-1)
+        , pollTimer_(new QTimer(this))
+        , recordFolder_(QStandardPaths::writableLocation(QStandardPaths::MusicLocation) + "/CueForge Recordings")
+        , fromMix_(false)
+        , channels_({ 0, 1 })
+        , flac_(false)
+        , bitDepth_(24)
+        , maxDuration_(0.0)
+        , droppedBlocks_(0)
+    {
+        setName("Record");
+        setColor(QColor(220, 60, 60));
+
+        pollTimer_->setInterval(250);
+        connect(pollTimer_, &QTimer::timeout, this, &RecordCue::onPollTimer);
+    }
+
+    RecordCue::~RecordCue()
+    {
+        // A take still running is closed with what was captured
+        releaseRecorder();
+    }
+
+    void RecordCue::setAudioEngine(AudioEngineQt* engine)
+    {
+        audioEngine_ = engine;
+    }
+
+    // ============================================================================
+    // Settings
+    // ============================================================================
+
+    void RecordCue::setRecordFolder(const QString& folder)
+    {
+        if (recordFolder_ != folder) {
+            recordFolder_ = folder;
+            updateModifiedTime();
+            emit recordFolderChanged(recordFolder_);
+        }
+    }
+
+    void RecordCue::setFromMix(bool fromMix)
+    {
+        if (fromMix_ != fromMix) {
+            fromMix_ = fromMix;
+            updateModifiedTime();
+            emit sourceChanged();
+        }
+    }
+
+    void RecordCue::setChannels(const QList<int>& channels)
+    {
+        if (channels_ != channels) {
+            channels_ = channels;
+            updateModifiedTime();
+            emit sourceChanged();
+        }
+    }
+
+    void RecordCue::setFlac(bool flac)
+    {
+        if (flac_ != flac) {
+            flac_ = flac;
+            if (flac_ && bitDepth_ > 24) {
+                bitDepth_ = 24;     // FLAC is integer only
+            }
+            updateModifiedTime();
+            emit formatChanged();
+        }
+    }
+
+    void RecordCue::setBitDepth(int bits)
+    {
+        bits = bits <= 16 ? 16 : (bits <= 24 || flac_ ? 24 : 32);
+        if (bitDepth_ != bits) {
+            bitDepth_ = bits;
+            updateModifiedTime();
+            emit formatChanged();
+        }
+    }
+
+    void RecordCue::setMaxDuration(double seconds)
+    {
+        seconds = qMax(0.0, seconds);
+        if (!qFuzzyCompare(maxDuration_, seconds)) {
+            maxDuration_ = seconds;
+            updateModifiedTime();
+            emit maxDurationChanged(maxDuration_);
+        }
+    }
+
+    double RecordCue::recordedSeconds() const
+    {
+        if (!audioEngine_ || recorderId_ < 0) {
+            return 0.0;
+        }
+        return audioEngine_->recorderStats(recorderId_).value("seconds").toDouble();
+    }
+
+    QString RecordCue::nextTakePath() const
+    {
+        const QString label = number().isEmpty() ? name() : number();
+        QString base = QString("%1 %2").arg(label, QDateTime::currentDateTime().toString("yyyyMMdd-HHmmss"));
+        base.replace(QRegularExpression("[\\\\/:*?\"<>|]"), "_");
+
+        const QString extension = flac_ ? "flac" : "wav";
+        QString path = QDir(recordFolder_).filePath(base + "." + extension);
+        for (int n = 2; QFileInfo::exists(path); ++n) {
+            path = QDir(recordFolder_).filePath(QString("%1 (%2).%3").arg(base).arg(n).arg(extension));
+        }
+        return path;
+    }
+
+    // ============================================================================
+    // Playback Control
+    // ============================================================================
+
+    bool RecordCue::execute()
+    {
+        if (!canExecute()) {
+            qWarning() << "RecordCue::execute() - Cannot execute cue:" << number();
+            return false;
+        }
+
+        if (!audioEngine_ || !audioEngine_->isInitialized()) {
+            qWarning() << "RecordCue::execute() - Audio engine not initialized";
+            return false;
+        }
+
+        if (!fromMix_ && audioEngine_->inputChannelCount() == 0) {
+            emit warning("Audio device has no inputs open");
+        }
+
+        // A GO while recording closes that take and starts a new one
+        finishTake();
+
+        currentTake_ = nextTakePath();
+        recorderId_ = audioEngine_->createRecorder(currentTake_, fromMix_, channels_, flac_, bitDepth_);
+        if (recorderId_ < 0 || !audioEngine_->startRecorder(recorderId_)) {
+            qWarning() << "RecordCue::execute() - Failed to start recording for cue" << number();
+            releaseRecorder();
+            setStatus(CueStatus::Broken);
+            return false;
+        }
+
+        droppedBlocks_ = 0;
+        pollTimer_->start();
+        setStatus(CueStatus::Running);
+        qDebug() << "RecordCue::execute() - Recording" << currentTake_ << "for cue" << number();
+        return true;
+    }
+
+    void RecordCue::stop(double fadeTime)
+    {
+        Q_UNUSED(fadeTime);
+
+        if (recorderId_ < 0) {
+            return;
+        }
+
+        qDebug() << "RecordCue::stop() - Stopping cue" << number();
+        finishTake();
+        setStatus(CueStatus::Stopped);
+    }
+
+    void RecordCue::pause()
+    {
+        if (status() != CueStatus::Running) {
+            return;
+        }
+
+        // The file stays open; resume carries on in the same take
+        if (audioEngine_ && recorderId_ >= 0) {
+            audioEngine_->pauseRecorder(recorderId_);
+        }
+        setStatus(CueStatus::Paused);
+    }
+
+    void RecordCue::resume()
+    {
+        if (status() != CueStatus::Paused) {
+            return;
+        }
+
+        if (audioEngine_ && recorderId_ >= 0) {
+            audioEngine_->startRecorder(recorderId_);
+        }
+        setStatus(CueStatus::Running);
+    }
+
+    void RecordCue::onPollTimer()
+    {
+        if (!audioEngine_ || recorderId_ < 0) {
+            pollTimer_->stop();
+            return;
+        }
+
+        const QJsonObject stats = audioEngine_->recorderStats(recorderId_);
+
+        const qint64 dropped = stats.value("droppedBlocks").toInteger();
+        if (dropped > droppedBlocks_) {
+            emit warning(QString("Recording dropped %1 blocks: the disk is not keeping up")
+                .arg(dropped - droppedBlocks_));
+            droppedBlocks_ = dropped;
+        }
+
+        if (stats.value("writeFailed").toBool()) {
+            emit error("Recording failed: disk write error on " + currentTake_);
+            finishTake();
+            setStatus(CueStatus::Broken);
+            return;
+        }
+
+        if (maxDuration_ > 0.0 && stats.value("seconds").toDouble() >= maxDuration_) {
+            qDebug() << "RecordCue::onPollTimer() - Reached" << maxDuration_ << "s for cue" << number();
+            finishTake();
+            setStatus(CueStatus::Finished);
+            emit executionFinished();
+        }
+    }
+
+    void RecordCue::finishTake()
+    {
+        pollTimer_->stop();
+        if (!audioEngine_ || recorderId_ < 0) {
+            return;
+        }
+
+        // Returns once the file is complete, so it can be played at once
+        const bool complete = audioEngine_->stopRecorder(recorderId_);
+        droppedBlocks_ = audioEngine_->recorderStats(recorderId_).value("droppedBlocks").toInteger();
+        audioEngine_->removeRecorder(recorderId_);
+        recorderId_ = -1;
+
+        if (!complete) {
+            return;
+        }
+
+        lastTake_ = currentTake_;
+        updateModifiedTime();
+        emit takeFinished(lastTake_);
+
+        if (AudioCue* audioCue = qobject_cast<AudioCue*>(targetCue())) {
+            audioCue->setFilePath(lastTake_);
+        }
+    }
+
+    void RecordCue::releaseRecorder()
+    {
+        pollTimer_->stop();
+        if (audioEngine_ && recorderId_ >= 0) {
+            audioEngine_->removeRecorder(recorderId_);
+        }
+        recorderId_ = -1;
+    }
+
+    bool RecordCue::canExecute() const
+    {
+        return Cue::canExecute() && audioEngine_ != nullptr && !channels_.isEmpty();
+    }
+
+    bool RecordCue::validate()
+    {
+        return Cue::validate() && validationError().isEmpty();
+    }
+
+    QString RecordCue::validationError() const
+    {
+        if (channels_.isEmpty()) {
+            return "No channels to record";
+        }
+        if (recordFolder_.isEmpty()) {
+            return "No recording folder";
+        }
+        if (!targetCueId().isEmpty() && !qobject_cast<AudioCue*>(targetCue())) {
+            return "Target is not an audio cue: " + targetCueId();
+        }
+        return Cue::validationError();
+    }
+
+    // ============================================================================
+    // Serialization
+    // ============================================================================
+
+    QJsonObject RecordCue::toJson() const
+    {
+        using namespace CueJsonKeys;
+        QJsonObject json = Cue::toJson();
+
+        QJsonArray channelsArray;
+        for (int channel : channels_) {
+            channelsArray.append(channel);
+        }
+
+        json.insert(RecordFolder, recordFolder_);
+        json.insert(RecordSource, fromMix_ ? "mix" : "inputs");
+        json.insert(RecordChannels, channelsArray);
+        json.insert(RecordFormat, flac_ ? "flac" : "wav");
+        json.insert(BitDepth, bitDepth_);
+        json.insert(MaxDuration, maxDuration_);
+        if (!lastTake_.isEmpty()) {
+            json.insert(LastTake, lastTake_);
+        }
+
+        return json;
+    }
+
+    void RecordCue::fromJson(const QJsonObject& json)
+    {
+        using namespace CueJsonKeys;
+        const LoadScope scope(this);
+
+        Cue::fromJson(json);
+
+        if (json.contains(RecordFolder)) {
+            setRecordFolder(json.value(RecordFolder).toString());
+        }
+        setFromMix(json.value(RecordSource).toString() == QLatin1String("mix"));
+
+        const QJsonValue channelsValue = json.value(RecordChannels);
+        if (channelsValue.isArray()) {
+            QList<int> channels;
+            for (const QJsonValue& value : channelsValue.toArray()) {
+                channels.append(value.toInt());
+            }
+            setChannels(channels);
+        }
+
+        setFlac(json.value(RecordFormat).toString() == QLatin1String("flac"));
+        setBitDepth(json.value(BitDepth).toInt(24));
+        setMaxDuration(json.value(MaxDuration).toDouble(0.0));
+        lastTake_ = json.value(LastTake).toString();
+    }
+
+    std::unique_ptr<Cue> RecordCue::clone() const
+    {
+        auto cloned = std::make_unique<RecordCue>();
+
+        cloned->setNumber(number());
+        cloned->setName(name() + " Copy");
+        cloned->setDuration(duration());
+        cloned->setPreWait(preWait());
+        cloned->setPostWait(postWait());
+        cloned->setContinueMode(continueMode());
+        cloned->setColor(color());
+        cloned->setNotes(notes());
+        cloned->setArmed(isArmed());
+        cloned->setTargetCueId(targetCueId());
+
+        cloned->setAudioEngine(audioEngine_);
+        cloned->setRecordFolder(recordFolder_);
+        cloned->setFromMix(fromMix_);
+        cloned->setChannels(channels_);
+        cloned->setFlac(flac_);
+        cloned->setBitDepth(bitDepth_);
+        cloned->setMaxDuration(maxDuration_);
+
+        return cloned;
+    }
+
+} // namespace CueForge
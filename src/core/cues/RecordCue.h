@@ -0,0 +1,107 @@
+// ============================================================================
+// RecordCue.h - Record device inputs or the mix to disk
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#pragma once
+
+#include "../Cue.h"
+#include <QList>
+#include <QTimer>
+
+namespace CueForge {
+
+    class AudioEngineQt;
+
+    /**
+     * Records device inputs or the programme mix to a new WAV or FLAC file
+     * on each GO, until stopped or maxDuration runs out. The engine copies
+     * blocks out of the callback into a ring and a disk writer thread
+     * encodes them, so recording never holds up the audio.
+     *
+     * When a take stops its file is complete. lastTake() holds it, and if
+     * the target cue is an audio cue the take becomes its file, ready to
+     * play back straight away.
+     */
+    class RecordCue : public Cue
+    {
+        Q_OBJECT
+            Q_PROPERTY(QString recordFolder READ recordFolder WRITE setRecordFolder NOTIFY recordFolderChanged)
+            Q_PROPERTY(bool fromMix READ fromMix WRITE setFromMix NOTIFY sourceChanged)
+            Q_PROPERTY(bool flac READ flac WRITE setFlac NOTIFY formatChanged)
+            Q_PROPERTY(int bitDepth READ bitDepth WRITE setBitDepth NOTIFY formatChanged)
+            Q_PROPERTY(double maxDuration READ maxDuration WRITE setMaxDuration NOTIFY maxDurationChanged)
+
+    public:
+        explicit RecordCue(QObject* parent = nullptr);
+        ~RecordCue() override;
+
+        void setAudioEngine(AudioEngineQt* engine);
+        AudioEngineQt* audioEngine() const { return audioEngine_; }
+        int recorderId() const { return recorderId_; }
+
+        // Takes are named "<cue number or name> <date-time>.<wav|flac>"
+        QString recordFolder() const { return recordFolder_; }
+        void setRecordFolder(const QString& folder);
+
+        // Device inputs (zero-based) by default; the mix's outputs when fromMix
+        bool fromMix() const { return fromMix_; }
+        void setFromMix(bool fromMix);
+        QList<int> channels() const { return channels_; }
+        void setChannels(const QList<int>& channels);
+
+        bool flac() const { return flac_; }
+        void setFlac(bool flac);
+        int bitDepth() const { return bitDepth_; }
+        void setBitDepth(int bits);     // 16 or 24; WAV also 32 (float)
+
+        // Seconds; 0 records until stopped
+        double maxDuration() const { return maxDuration_; }
+        void setMaxDuration(double seconds);
+
+        QString lastTake() const { return lastTake_; }
+        double recordedSeconds() const;
+        qint64 droppedBlocks() const { return droppedBlocks_; }
+
+        bool execute() override;
+        void stop(double fadeTime = 0.0) override;
+        void pause() override;
+        void resume() override;
+        bool canExecute() const override;
+        bool validate() override;
+        QString validationError() const override;
+
+        QJsonObject toJson() const override;
+        void fromJson(const QJsonObject& json) override;
+        std::unique_ptr<Cue> clone() const override;
+
+    signals:
+        void recordFolderChanged(const QString& folder);
+        void sourceChanged();
+        void formatChanged();
+        void maxDurationChanged(double seconds);
+        void takeFinished(const QString& filePath);
+
+    private slots:
+        void onPollTimer();
+
+    private:
+        QString nextTakePath() const;
+        void finishTake();
+        void releaseRecorder();
+
+        AudioEngineQt* audioEngine_;    // Not owned
+        int recorderId_;                // -1 when not recording
+        QTimer* pollTimer_;             // Drops, write errors and maxDuration
+        QString recordFolder_;
+        bool fromMix_;
+        QList<int> channels_;
+        bool flac_;
+        int bitDepth_;
+        double maxDuration_;
+        QString currentTake_;
+        QString lastTake_;
+        qint64 droppedBlocks_;          // Of the current or last take
+    };
+
+} // namespace CueForge
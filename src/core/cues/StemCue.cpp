@@ -0,0 +1,326 @@
+// ============================================================================
+// StemCue.cpp - Multitrack stem playback cue implementation
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#include "StemCue.h"
+#include "../../audio/AudioEngineQt.h"
+#include "../CueJsonKeys.h"
+#include <QDebug>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QStringList>
+#include <cmath>
+
+namespace CueForge {
+
+    namespace {
+        QString routingKey(int stemChannel, int output)
+        {
+            return QString("%1_%2").arg(stemChannel).arg(output);
+        }
+    }
+
+    StemCue::StemCue(QObject* parent)
+        : Cue(CueType::Stem, parent)
+        , audioEngine_(nullptr)
+        , stemPlayerId_(-1)
+        , volume_(1.0)
+    {
+        setName("Stems");
+        setColor(QColor(120, 170, 255));
+    }
+
+    StemCue::~StemCue()
+    {
+        releaseStemPlayer();
+    }
+
+    void StemCue::setAudioEngine(AudioEngineQt* engine)
+    {
+        audioEngine_ = engine;
+    }
+
+    void StemCue::setVolume(double volume)
+    {
+        volume = qBound(0.0, volume, 1.0);
+        if (!qFuzzyCompare(volume_, volume)) {
+            volume_ = volume;
+            updateModifiedTime();
+            emit volumeChanged(volume_);
+
+            if (audioEngine_ && stemPlayerId_ >= 0) {
+                audioEngine_->setStemVolume(stemPlayerId_, volume_);
+            }
+        }
+    }
+
+    // ============================================================================
+    // Stems
+    // ============================================================================
+
+    void StemCue::setStems(const QList<Stem>& stems)
+    {
+        // The engine voice is built from the file list; rebuild on next GO
+        releaseStemPlayer();
+        stems_ = stems;
+        updateModifiedTime();
+        emit stemsChanged();
+    }
+
+    void StemCue::addStem(const QString& filePath)
+    {
+        releaseStemPlayer();
+        stems_.append(Stem{ filePath, QVariantMap() });
+        updateModifiedTime();
+        emit stemsChanged();
+    }
+
+    void StemCue::removeStem(int index)
+    {
+        if (index < 0 || index >= stems_.size()) {
+            return;
+        }
+
+        releaseStemPlayer();
+        stems_.removeAt(index);
+        updateModifiedTime();
+        emit stemsChanged();
+    }
+
+    void StemCue::setRoutingLevel(int stem, int stemChannel, int outputChannel, double levelDb)
+    {
+        if (stem < 0 || stem >= stems_.size()) {
+            return;
+        }
+
+        QVariantMap& routing = stems_[stem].matrixRouting;
+        const QString key = routingKey(stemChannel, outputChannel);
+
+        if (levelDb <= -96.0) {
+            routing.remove(key);
+        }
+        else {
+            routing[key] = levelDb;
+        }
+
+        updateModifiedTime();
+        applyRouting(stem);
+    }
+
+    double StemCue::getRoutingLevel(int stem, int stemChannel, int outputChannel) const
+    {
+        if (stem < 0 || stem >= stems_.size()) {
+            return -96.0;
+        }
+        return stems_[stem].matrixRouting.value(routingKey(stemChannel, outputChannel), -96.0).toDouble();
+    }
+
+    void StemCue::applyRouting(int stem)
+    {
+        if (!audioEngine_ || stemPlayerId_ < 0 || stems_[stem].matrixRouting.isEmpty()) {
+            return;
+        }
+
+        const QVariantMap& routing = stems_[stem].matrixRouting;
+        audioEngine_->clearStemRoutes(stemPlayerId_, stem);
+        for (auto it = routing.constBegin(); it != routing.constEnd(); ++it) {
+            const QStringList channels = it.key().split('_');
+            if (channels.size() != 2) {
+                continue;
+            }
+            const double gain = std::pow(10.0, it.value().toDouble() / 20.0);
+            audioEngine_->setStemRoute(stemPlayerId_, stem, channels[0].toInt(), channels[1].toInt(), gain);
+        }
+    }
+
+    // ============================================================================
+    // Playback Control
+    // ============================================================================
+
+    bool StemCue::execute()
+    {
+        if (!canExecute()) {
+            qWarning() << "StemCue::execute() - Cannot execute cue:" << number();
+            return false;
+        }
+
+        if (!audioEngine_ || !audioEngine_->isInitialized()) {
+            qWarning() << "StemCue::execute() - Audio engine not initialized";
+            return false;
+        }
+
+        releaseStemPlayer();
+
+        QStringList paths;
+        for (const Stem& stem : stems_) {
+            paths.append(stem.filePath);
+        }
+
+        stemPlayerId_ = audioEngine_->createStemPlayer(paths);
+        if (stemPlayerId_ < 0) {
+            qWarning() << "StemCue::execute() - Failed to load stems for cue" << number();
+            setStatus(CueStatus::Broken);
+            return false;
+        }
+
+        for (int stem = 0; stem < stems_.size(); ++stem) {
+            applyRouting(stem);
+        }
+        audioEngine_->setStemVolume(stemPlayerId_, volume_);
+
+        if (!audioEngine_->playStems(stemPlayerId_)) {
+            releaseStemPlayer();
+            return false;
+        }
+
+        setStatus(CueStatus::Running);
+        qDebug() << "StemCue::execute() - Playing" << stems_.size() << "stems for cue" << number();
+        return true;
+    }
+
+    void StemCue::stop(double fadeTime)
+    {
+        Q_UNUSED(fadeTime);
+
+        if (stemPlayerId_ < 0) {
+            return;
+        }
+
+        qDebug() << "StemCue::stop() - Stopping cue" << number();
+        releaseStemPlayer();
+        setStatus(CueStatus::Stopped);
+    }
+
+    void StemCue::pause()
+    {
+        if (status() != CueStatus::Running) {
+            return;
+        }
+
+        if (audioEngine_ && stemPlayerId_ >= 0) {
+            audioEngine_->pauseStems(stemPlayerId_);
+        }
+        setStatus(CueStatus::Paused);
+    }
+
+    void StemCue::resume()
+    {
+        if (status() != CueStatus::Paused) {
+            return;
+        }
+
+        if (audioEngine_ && stemPlayerId_ >= 0) {
+            audioEngine_->resumeStems(stemPlayerId_);
+        }
+        setStatus(CueStatus::Running);
+    }
+
+    void StemCue::releaseStemPlayer()
+    {
+        if (audioEngine_ && stemPlayerId_ >= 0) {
+            audioEngine_->removeStemPlayer(stemPlayerId_);
+        }
+        stemPlayerId_ = -1;
+    }
+
+    bool StemCue::canExecute() const
+    {
+        return Cue::canExecute() && audioEngine_ != nullptr && !stems_.isEmpty();
+    }
+
+    bool StemCue::validate()
+    {
+        return Cue::validate() && validationError().isEmpty();
+    }
+
+    QString StemCue::validationError() const
+    {
+        if (stems_.isEmpty()) {
+            return "No stems";
+        }
+        for (const Stem& stem : stems_) {
+            if (!QFileInfo::exists(stem.filePath)) {
+                return QString("Stem file not found: %1").arg(stem.filePath);
+            }
+        }
+        return Cue::validationError();
+    }
+
+    // ============================================================================
+    // Serialization
+    // ============================================================================
+
+    QJsonObject StemCue::toJson() const
+    {
+        using namespace CueJsonKeys;
+        QJsonObject json = Cue::toJson();
+
+        json.insert(Volume, volume_);
+
+        QJsonArray stemsArray;
+        for (const Stem& stem : stems_) {
+            QJsonObject stemObj;
+            stemObj.insert(FilePath, stem.filePath);
+
+            QJsonObject routingObj;
+            for (auto it = stem.matrixRouting.constBegin(); it != stem.matrixRouting.constEnd(); ++it) {
+                routingObj.insert(it.key(), it.value().toDouble());
+            }
+            stemObj.insert(MatrixRouting, routingObj);
+
+            stemsArray.append(stemObj);
+        }
+        json.insert(Stems, stemsArray);
+
+        return json;
+    }
+
+    void StemCue::fromJson(const QJsonObject& json)
+    {
+        using namespace CueJsonKeys;
+        const LoadScope scope(this);
+
+        Cue::fromJson(json);
+
+        setVolume(json.value(Volume).toDouble(1.0));
+
+        QList<Stem> stems;
+        const QJsonArray stemsArray = json.value(Stems).toArray();
+        for (const QJsonValue& value : stemsArray) {
+            const QJsonObject stemObj = value.toObject();
+
+            Stem stem;
+            stem.filePath = stemObj.value(FilePath).toString();
+            const QJsonObject routingObj = stemObj.value(MatrixRouting).toObject();
+            for (auto it = routingObj.constBegin(); it != routingObj.constEnd(); ++it) {
+                stem.matrixRouting.insert(it.key(), it.value().toDouble());
+            }
+            stems.append(stem);
+        }
+        setStems(stems);
+    }
+
+    std::unique_ptr<Cue> StemCue::clone() const
+    {
+        auto cloned = std::make_unique<StemCue>();
+
+        cloned->setNumber(number());
+        cloned->setName(name() + " Copy");
+        cloned->setDuration(duration());
+        cloned->setPreWait(preWait());
+        cloned->setPostWait(postWait());
+        cloned->setContinueMode(continueMode());
+        cloned->setColor(color());
+        cloned->setNotes(notes());
+        cloned->setArmed(isArmed());
+
+        cloned->setAudioEngine(audioEngine_);
+        cloned->setVolume(volume_);
+        cloned->setStems(stems_);
+
+        return cloned;
+    }
+
+} // namespace CueForge
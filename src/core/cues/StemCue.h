@@ -0,0 +1,83 @@
+// ============================================================================
+// StemCue.h - Multitrack stem playback cue
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#pragma once
+
+#include "../Cue.h"
+#include <QList>
+#include <QString>
+#include <QVariantMap>
+
+namespace CueForge {
+
+    class AudioEngineQt;
+
+    /**
+     * Plays a set of stems (8-16 mono or stereo files of one song, say) as
+     * a single sample-locked voice. Every stem starts on the same sample
+     * and cannot drift, since the engine reads them all through one shared
+     * read-ahead. Each stem has its own channel -> output routing.
+     */
+    class StemCue : public Cue
+    {
+        Q_OBJECT
+            Q_PROPERTY(double volume READ volume WRITE setVolume NOTIFY volumeChanged)
+
+    public:
+        struct Stem
+        {
+            QString filePath;
+            QVariantMap matrixRouting;  // "channel_output" -> dB; empty = engine default
+        };
+
+        explicit StemCue(QObject* parent = nullptr);
+        ~StemCue() override;
+
+        void setAudioEngine(AudioEngineQt* engine);
+        AudioEngineQt* audioEngine() const { return audioEngine_; }
+        int stemPlayerId() const { return stemPlayerId_; }
+
+        QList<Stem> stems() const { return stems_; }
+        void setStems(const QList<Stem>& stems);
+        void addStem(const QString& filePath);
+        void removeStem(int index);
+        int stemCount() const { return static_cast<int>(stems_.size()); }
+
+        // Unset stems follow the engine default: mono to outputs 1+2 at
+        // -3 dB, stereo channel for channel
+        void setRoutingLevel(int stem, int stemChannel, int outputChannel, double levelDb);
+        double getRoutingLevel(int stem, int stemChannel, int outputChannel) const;
+
+        // Linear, 0.0 to 1.0
+        double volume() const { return volume_; }
+        void setVolume(double volume);
+
+        bool execute() override;
+        void stop(double fadeTime = 0.0) override;
+        void pause() override;
+        void resume() override;
+        bool canExecute() const override;
+        bool validate() override;
+        QString validationError() const override;
+
+        QJsonObject toJson() const override;
+        void fromJson(const QJsonObject& json) override;
+        std::unique_ptr<Cue> clone() const override;
+
+    signals:
+        void stemsChanged();
+        void volumeChanged(double volume);
+
+    private:
+        void applyRouting(int stem);
+        void releaseStemPlayer();
+
+        AudioEngineQt* audioEngine_;    // Not owned
+        int stemPlayerId_;              // -1 when not loaded
+        QList<Stem> stems_;
+        double volume_;
+    };
+
+} // namespace CueForge
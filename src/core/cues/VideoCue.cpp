@@ -0,0 +1,459 @@
+// ============================================================================
+// VideoCue.cpp - Video playback cue implementation
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#include "VideoCue.h"
+#include "../../video/VideoCompositor.h"
+#include "../../video/VideoPlayback.h"
+#include "../../video/VideoDecoder.h"
+#include "../CueJsonKeys.h"
+#include <QJsonObject>
+#include <QFileInfo>
+#include <QDebug>
+
+namespace CueForge {
+
+    VideoCue::VideoCue(QObject* parent)
+        : Cue(CueType::Video, parent)
+        , compositor_(nullptr)
+        , playback_(nullptr)
+        , layerId_(-1)
+        , stopAfterFade_(false)
+        , opacity_(1.0)
+        , volume_(1.0)
+        , startTime_(0.0)
+        , endTime_(0.0)
+        , loopEnabled_(false)
+        , videoStage_("Main")
+        , isPlaying_(false)
+    {
+        setColor(QColor(200, 140, 255)); // QLab-style purple
+
+        connect(this, &Cue::armedChanged, this, &VideoCue::updatePreroll);
+    }
+
+    VideoCue::~VideoCue()
+    {
+        if (compositor_ && layerId_ >= 0) {
+            compositor_->removeLayer(layerId_);
+        }
+        releasePlayback();
+    }
+
+    void VideoCue::setVideoCompositor(VideoCompositor* compositor)
+    {
+        if (compositor_ == compositor) {
+            return;
+        }
+
+        if (compositor_) {
+            if (layerId_ >= 0) {
+                compositor_->removeLayer(layerId_);
+                layerId_ = -1;
+            }
+            compositor_->disconnect(this);
+        }
+
+        compositor_ = compositor;
+
+        if (compositor_) {
+            connect(compositor_, &VideoCompositor::layerFinished, this, &VideoCue::onLayerFinished);
+            connect(compositor_, &VideoCompositor::fadeFinished, this, &VideoCue::onFadeFinished);
+        }
+
+        updatePreroll();
+    }
+
+    bool VideoCue::isPrerolled() const
+    {
+        return playback_ && playback_->isPrerolled();
+    }
+
+    void VideoCue::setFilePath(const QString& path)
+    {
+        if (filePath_ != path) {
+            filePath_ = path;
+            loadFileInfo();
+            updateModifiedTime();
+            emit filePathChanged(filePath_);
+
+            if (name().isEmpty()) {
+                setName(QFileInfo(path).baseName());
+            }
+
+            updatePreroll();
+        }
+    }
+
+    void VideoCue::loadFileInfo()
+    {
+        fileInfo_ = VideoFileInfo();
+
+        if (filePath_.isEmpty()) {
+            return;
+        }
+
+        if (!VideoDecoder::isPatternSource(filePath_)) {
+            QFileInfo fileInfo(filePath_);
+            if (!fileInfo.exists() || !fileInfo.isReadable()) {
+                qWarning() << "VideoCue: File not accessible:" << filePath_;
+                return;
+            }
+        }
+
+        // Stream details are filled in once the decoder has opened the file
+        fileInfo_.isValid = true;
+    }
+
+    void VideoCue::setOpacity(double opacity)
+    {
+        opacity = qBound(0.0, opacity, 1.0);
+        if (!qFuzzyCompare(opacity_, opacity)) {
+            opacity_ = opacity;
+            updateModifiedTime();
+            emit opacityChanged(opacity_);
+
+            if (compositor_ && layerId_ >= 0) {
+                compositor_->fadeLayer(layerId_, opacity_, 0.0);
+            }
+        }
+    }
+
+    void VideoCue::fadeOpacity(double target, double seconds)
+    {
+        if (compositor_ && layerId_ >= 0) {
+            compositor_->fadeLayer(layerId_, target, seconds);
+        }
+    }
+
+    void VideoCue::setVolume(double volume)
+    {
+        volume = qBound(0.0, volume, 1.0);
+        if (!qFuzzyCompare(volume_, volume)) {
+            volume_ = volume;
+            updateModifiedTime();
+            emit volumeChanged(volume_);
+        }
+    }
+
+    void VideoCue::setStartTime(double seconds)
+    {
+        seconds = qMax(0.0, seconds);
+        if (!qFuzzyCompare(startTime_, seconds)) {
+            startTime_ = seconds;
+            updateModifiedTime();
+            updatePreroll();
+        }
+    }
+
+    void VideoCue::setEndTime(double seconds)
+    {
+        seconds = qMax(0.0, seconds);
+        if (!qFuzzyCompare(endTime_, seconds)) {
+            endTime_ = seconds;
+            updateModifiedTime();
+            updatePreroll();
+        }
+    }
+
+    void VideoCue::setLoopEnabled(bool enabled)
+    {
+        if (loopEnabled_ != enabled) {
+            loopEnabled_ = enabled;
+            updateModifiedTime();
+            updatePreroll();
+        }
+    }
+
+    void VideoCue::setVideoStage(const QString& stage)
+    {
+        if (videoStage_ != stage) {
+            videoStage_ = stage;
+            updateModifiedTime();
+        }
+    }
+
+    void VideoCue::setGeometry(const QVariantMap& geometry)
+    {
+        geometry_ = geometry;
+        updateModifiedTime();
+
+        if (compositor_ && layerId_ >= 0) {
+            compositor_->setLayerGeometry(layerId_, geometry_);
+        }
+    }
+
+    // ============================================================================
+    // Pre-roll
+    // ============================================================================
+
+    void VideoCue::updatePreroll()
+    {
+        // The playing instance keeps its settings until it ends
+        if (layerId_ >= 0) {
+            return;
+        }
+
+        const bool wanted = compositor_ && isArmed() && hasValidFile();
+        if (!wanted) {
+            releasePlayback();
+            return;
+        }
+
+        if (playback_ && !playback_->isFailed()
+            && playback_->path() == filePath_
+            && qFuzzyCompare(playback_->startTime() + 1.0, startTime_ + 1.0)
+            && qFuzzyCompare(playback_->endTime() + 1.0, endTime_ + 1.0)
+            && playback_->loops() == loopEnabled_) {
+            return;
+        }
+
+        if (!playback_) {
+            playback_ = new VideoPlayback(this);
+            connect(playback_, &VideoPlayback::prerolled, this, &VideoCue::onPrerolled);
+        }
+
+        playback_->preroll(filePath_, startTime_, endTime_, loopEnabled_);
+    }
+
+    void VideoCue::releasePlayback()
+    {
+        if (playback_) {
+            playback_->disconnect(this);
+            delete playback_;
+            playback_ = nullptr;
+        }
+    }
+
+    void VideoCue::onPrerolled(bool ok)
+    {
+        if (!playback_) {
+            return;
+        }
+
+        if (!ok) {
+            fileInfo_.isValid = false;
+            emit warning(QString("Video cue %1: cannot open %2").arg(number(), filePath_));
+            return;
+        }
+
+        const VideoStreamInfo info = playback_->info();
+        fileInfo_.width = info.width;
+        fileInfo_.height = info.height;
+        fileInfo_.frameRate = info.frameRate;
+        fileInfo_.duration = info.duration;
+        fileInfo_.codec = info.codec;
+        fileInfo_.hasAudio = info.hasAudio;
+        fileInfo_.isValid = true;
+
+        if (info.duration > 0.0 && !loopEnabled_) {
+            const double outPoint = (endTime_ > startTime_) ? qMin(endTime_, info.duration) : info.duration;
+            setDuration(qMax(0.0, outPoint - startTime_));
+        }
+    }
+
+    // ============================================================================
+    // Playback Control
+    // ============================================================================
+
+    bool VideoCue::execute()
+    {
+        if (!canExecute()) {
+            qWarning() << "VideoCue::execute() - Cannot execute cue:" << number();
+            return false;
+        }
+
+        if (!compositor_) {
+            qWarning() << "VideoCue::execute() - No video compositor connected!";
+            return false;
+        }
+
+        if (!playback_) {
+            // Not armed in advance - open now, the layer starts on its first frame
+            qWarning() << "VideoCue::execute() - Cue" << number() << "was not pre-rolled";
+            playback_ = new VideoPlayback(this);
+            connect(playback_, &VideoPlayback::prerolled, this, &VideoCue::onPrerolled);
+            playback_->preroll(filePath_, startTime_, endTime_, loopEnabled_);
+        }
+
+        layerId_ = compositor_->addLayer(playback_, geometry_, opacity_);
+        if (layerId_ < 0) {
+            qWarning() << "VideoCue::execute() - Failed to add compositor layer";
+            return false;
+        }
+
+        stopAfterFade_ = false;
+        isPlaying_ = true;
+        setStatus(CueStatus::Running);
+        emit executionStarted();
+
+        qDebug() << "VideoCue::execute() - Started cue" << number()
+            << (playback_->isPrerolled() ? "(pre-rolled)" : "(cold start)");
+        return true;
+    }
+
+    void VideoCue::stop(double fadeTime)
+    {
+        if (layerId_ < 0) {
+            return;
+        }
+
+        if (fadeTime > 0.0 && compositor_ && status() == CueStatus::Running) {
+            stopAfterFade_ = true;
+            compositor_->fadeLayer(layerId_, 0.0, fadeTime);
+            return;
+        }
+
+        qDebug() << "VideoCue::stop() - Stopping cue" << number();
+        endPlayback(CueStatus::Stopped);
+    }
+
+    void VideoCue::pause()
+    {
+        if (status() != CueStatus::Running) {
+            return;
+        }
+
+        if (compositor_ && layerId_ >= 0) {
+            compositor_->pauseLayer(layerId_);
+        }
+        setStatus(CueStatus::Paused);
+    }
+
+    void VideoCue::resume()
+    {
+        if (status() != CueStatus::Paused) {
+            return;
+        }
+
+        if (compositor_ && layerId_ >= 0) {
+            compositor_->resumeLayer(layerId_);
+        }
+        setStatus(CueStatus::Running);
+    }
+
+    void VideoCue::endPlayback(CueStatus finalStatus)
+    {
+        if (compositor_ && layerId_ >= 0) {
+            compositor_->removeLayer(layerId_);
+        }
+        layerId_ = -1;
+        stopAfterFade_ = false;
+        isPlaying_ = false;
+
+        // The decoder has moved past the in point - re-arm for the next GO
+        releasePlayback();
+        setStatus(finalStatus);
+        updatePreroll();
+    }
+
+    void VideoCue::onLayerFinished(int layerId)
+    {
+        if (layerId != layerId_) {
+            return;
+        }
+
+        qDebug() << "VideoCue: Cue" << number() << "finished";
+        endPlayback(CueStatus::Finished);
+        emit executionFinished();
+    }
+
+    void VideoCue::onFadeFinished(int layerId)
+    {
+        if (layerId == layerId_ && stopAfterFade_) {
+            endPlayback(CueStatus::Stopped);
+        }
+    }
+
+    bool VideoCue::canExecute() const
+    {
+        return Cue::canExecute() && hasValidFile();
+    }
+
+    bool VideoCue::validate()
+    {
+        return Cue::validate() && hasValidFile();
+    }
+
+    QString VideoCue::validationError() const
+    {
+        if (filePath_.isEmpty()) {
+            return "No video file set";
+        }
+        if (!hasValidFile()) {
+            return "Video file not accessible: " + filePath_;
+        }
+        return Cue::validationError();
+    }
+
+    // ============================================================================
+    // Serialization
+    // ============================================================================
+
+    QJsonObject VideoCue::toJson() const
+    {
+        using namespace CueJsonKeys;
+        QJsonObject json = Cue::toJson();
+
+        json.insert(FilePath, filePath_);
+        json.insert(Opacity, opacity_);
+        json.insert(Volume, volume_);
+        json.insert(StartTime, startTime_);
+        json.insert(EndTime, endTime_);
+        json.insert(LoopEnabled, loopEnabled_);
+        json.insert(VideoStage, videoStage_);
+
+        if (!geometry_.isEmpty()) {
+            json.insert(Geometry, QJsonObject::fromVariantMap(geometry_));
+        }
+
+        return json;
+    }
+
+    void VideoCue::fromJson(const QJsonObject& json)
+    {
+        using namespace CueJsonKeys;
+        const LoadScope scope(this);
+
+        Cue::fromJson(json);
+
+        setOpacity(json.value(Opacity).toDouble(1.0));
+        setVolume(json.value(Volume).toDouble(1.0));
+        setStartTime(json.value(StartTime).toDouble(0.0));
+        setEndTime(json.value(EndTime).toDouble(0.0));
+        setLoopEnabled(json.value(LoopEnabled).toBool(false));
+        setVideoStage(json.value(VideoStage).toString("Main"));
+        setGeometry(json.value(Geometry).toObject().toVariantMap());
+
+        // Last, so the pre-roll starts with the final trim settings
+        setFilePath(json.value(FilePath).toString());
+    }
+
+    std::unique_ptr<Cue> VideoCue::clone() const
+    {
+        auto cloned = std::make_unique<VideoCue>();
+
+        cloned->setNumber(number());
+        cloned->setName(name() + " Copy");
+        cloned->setDuration(duration());
+        cloned->setPreWait(preWait());
+        cloned->setPostWait(postWait());
+        cloned->setContinueMode(continueMode());
+        cloned->setColor(color());
+        cloned->setNotes(notes());
+        cloned->setArmed(isArmed());
+
+        cloned->setOpacity(opacity_);
+        cloned->setVolume(volume_);
+        cloned->setStartTime(startTime_);
+        cloned->setEndTime(endTime_);
+        cloned->setLoopEnabled(loopEnabled_);
+        cloned->setVideoStage(videoStage_);
+        cloned->setGeometry(geometry_);
+        cloned->setFilePath(filePath_);
+
+        return cloned;
+    }
+
+} // namespace CueForge
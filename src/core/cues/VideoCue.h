@@ -11,6 +11,9 @@
 
 namespace CueForge {
 
+    class VideoCompositor;
+    class VideoPlayback;
+
     class VideoCue : public Cue
     {
         Q_OBJECT
@@ -20,7 +23,7 @@ namespace CueForge {
 
     public:
         explicit VideoCue(QObject* parent = nullptr);
-        ~VideoCue() override = default;
+        ~VideoCue() override;
 
         struct VideoFileInfo {
             int width = 0;
@@ -32,6 +35,11 @@ namespace CueForge {
             bool isValid = false;
         };
 
+        // Compositor connection - armed cues pre-roll once this is set
+        void setVideoCompositor(VideoCompositor* compositor);
+        VideoCompositor* videoCompositor() const { return compositor_; }
+        bool isPrerolled() const;
+
         QString filePath() const { return filePath_; }
         void setFilePath(const QString& path);
 
@@ -41,6 +49,9 @@ namespace CueForge {
         double opacity() const { return opacity_; }
         void setOpacity(double opacity);
 
+        // Fade the live layer's opacity without changing the stored value
+        void fadeOpacity(double target, double seconds);
+
         double volume() const { return volume_; }
         void setVolume(double volume);
 
@@ -76,8 +87,21 @@ namespace CueForge {
         void opacityChanged(double opacity);
         void volumeChanged(double volume);
 
+    private slots:
+        void onPrerolled(bool ok);
+        void onLayerFinished(int layerId);
+        void onFadeFinished(int layerId);
+
     private:
         void loadFileInfo();
+        void updatePreroll();
+        void releasePlayback();
+        void endPlayback(CueStatus finalStatus);
+
+        VideoCompositor* compositor_;  // Not owned
+        VideoPlayback* playback_;
+        int layerId_;
+        bool stopAfterFade_;
 
         QString filePath_;
         VideoFileInfo fileInfo_;
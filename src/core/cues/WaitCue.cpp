@@ -96,6 +96,7 @@ namespace CueForge {
 
     void WaitCue::fromJson(const QJsonObject& json)
     {
+        const LoadScope scope(this);
         Cue::fromJson(json);
         remainingTime_ = duration();
     }
@@ -1,7 +1,12 @@
 ﻿#include <QApplication>
 #include <QDebug>
+#include <QCommandLineParser>
 #include "core/CueManager.h"
 #include "core/ErrorHandler.h"
+#include "audio/AudioEngineQt.h"
+#include "network/ConnectionPool.h"
+#include "network/MirrorSync.h"
+#include "network/RemoteApiServer.h"
 #include "ui/MainWindow.h"
 
 int main(int argc, char* argv[])
@@ -13,6 +18,33 @@ int main(int argc, char* argv[])
     app.setApplicationName("CueForge");
     app.setApplicationVersion("2.0.0");
 
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    parser.addVersionOption();
+    QCommandLineOption mirrorPrimaryOption("mirror-primary",
+        "Act as mirror primary, accepting backups on <port>.", "port");
+    QCommandLineOption mirrorBackupOption("mirror-backup",
+        "Act as mirror backup of the primary at <host[:port]>.", "host");
+    QCommandLineOption remotePortOption("remote-port",
+        "Accept WebSocket remote control clients on <port>.", "port");
+    parser.addOption(mirrorPrimaryOption);
+    parser.addOption(mirrorBackupOption);
+    QCommandLineOption nullAudioOption("null-audio",
+        "Run without a soundcard on the null device, e.g. \"rate=48000,buffer=256,clock=freewheel\" "
+        "(\"default\" for defaults).", "spec");
+    parser.addOption(remotePortOption);
+    parser.addOption(nullAudioOption);
+    parser.process(app);
+
+    // Handed to the audio engine before it opens a device
+    QString nullAudioSpec;
+    if (parser.isSet(nullAudioOption)) {
+        nullAudioSpec = parser.value(nullAudioOption);
+        if (nullAudioSpec.isEmpty()) {
+            nullAudioSpec = "default";
+        }
+    }
+
     qDebug() << "========================================";
     qDebug() << "CueForge Qt6 v2.0.0";
     qDebug() << "========================================";
@@ -25,8 +57,75 @@ int main(int argc, char* argv[])
     qDebug() << "✓ Error handler initialized";
     qDebug() << "✓ Cue manager initialized";
 
+    // Optional primary/backup mirroring
+    CueForge::MirrorPrimary mirrorPrimary(&cueManager);
+    CueForge::MirrorBackup mirrorBackup(&cueManager);
+
+    if (parser.isSet(mirrorPrimaryOption)) {
+        quint16 port = static_cast<quint16>(parser.value(mirrorPrimaryOption).toUInt());
+        if (mirrorPrimary.listen(QHostAddress::Any, port ? port : CueForge::MirrorProtocol::DefaultPort)) {
+            qDebug() << "✓ Mirror primary listening";
+        }
+    }
+    else if (parser.isSet(mirrorBackupOption)) {
+        QString target = parser.value(mirrorBackupOption);
+        quint16 port = CueForge::MirrorProtocol::DefaultPort;
+        int colon = target.lastIndexOf(':');
+        if (colon > 0) {
+            port = static_cast<quint16>(target.mid(colon + 1).toUInt());
+            target = target.left(colon);
+        }
+        mirrorBackup.connectToPrimary(target, port);
+        qDebug() << "✓ Mirror backup following" << target << port;
+    }
+
+    // Optional remote control API for tablets/laptops
+    CueForge::RemoteApiServer remoteApi(&cueManager, &errorHandler);
+
+    // {"cmd":"latencyProbe","enable":true} - audio onset stamps for tools/remote_bench
+    // {"cmd":"lockProfile","enable":true,"reset":true} - engine lock contention
+    remoteApi.setCommandHandler([&cueManager](const QJsonObject& command, QJsonObject& reply) {
+        const QString cmd = command["cmd"].toString();
+        if (cmd != "latencyProbe" && cmd != "lockProfile") {
+            return false;
+        }
+
+        CueForge::AudioEngineQt* engine = cueManager.audioEngine();
+        if (!engine || !engine->isInitialized()) {
+            reply["error"] = "no audio engine";
+            return false;
+        }
+
+        if (cmd == "lockProfile") {
+            if (command.contains("enable")) {
+                engine->setLockProfilingEnabled(command["enable"].toBool());
+            }
+            reply["enabled"] = engine->isLockProfilingEnabled();
+            reply["locks"] = engine->lockProfile();
+            if (command["reset"].toBool()) {
+                engine->resetLockProfile();
+            }
+            return true;
+        }
+
+        if (command.contains("enable")) {
+            engine->setLatencyProbeEnabled(command["enable"].toBool());
+        }
+        reply["onsetNs"] = engine->lastAudioOnsetNanos();
+        reply["outputLatencyMs"] = engine->outputLatencyMs();
+        reply["nowNs"] = CueForge::monotonicNanoseconds();
+        return true;
+    });
+
+    if (parser.isSet(remotePortOption)) {
+        quint16 port = static_cast<quint16>(parser.value(remotePortOption).toUInt());
+        if (remoteApi.listen(QHostAddress::Any, port ? port : CueForge::RemoteApiServer::DefaultPort)) {
+            qDebug() << "✓ Remote API listening on port" << remoteApi.serverPort();
+        }
+    }
+
     // Create and show main window
-    CueForge::MainWindow mainWindow(&cueManager, &errorHandler);
+    CueForge::MainWindow mainWindow(&cueManager, &errorHandler, nullAudioSpec);
     mainWindow.show();
 
     qDebug() << "✓ Main window displayed";
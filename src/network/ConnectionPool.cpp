@@ -0,0 +1,548 @@
+// ============================================================================
+// ConnectionPool.cpp - Persistent TCP/HTTP connections on an I/O thread
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#include "ConnectionPool.h"
+#include <QThread>
+#include <QTcpSocket>
+#include <QTimer>
+#include <QRandomGenerator>
+#include <QMutexLocker>
+#include <QDebug>
+#include <chrono>
+
+namespace CueForge {
+
+    qint64 monotonicNanoseconds()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    QString NetworkCommand::endpointKey() const
+    {
+        return endpointKey(protocol, host, port);
+    }
+
+    QString NetworkCommand::endpointKey(Protocol protocol, const QString& host, quint16 port)
+    {
+        return QString("%1://%2:%3")
+            .arg(protocol == Protocol::Http ? "http" : "tcp", host.toLower())
+            .arg(port);
+    }
+
+    // ============================================================================
+    // ConnectionPool (caller side)
+    // ============================================================================
+
+    ConnectionPool::ConnectionPool(QObject* parent)
+        : QObject(parent)
+        , thread_(new QThread)
+        , worker_(new ConnectionPoolWorker)
+        , nextId_(1)
+    {
+        qRegisterMetaType<CueForge::NetworkCommand>();
+        qRegisterMetaType<CueForge::NetworkCommandResult>();
+
+        thread_->setObjectName("NetworkIO");
+        worker_->moveToThread(thread_);
+
+        connect(worker_, &ConnectionPoolWorker::finished, this, &ConnectionPool::commandFinished);
+        connect(worker_, &ConnectionPoolWorker::connectionStateChanged, this,
+            [this](const QString& key, bool connected) {
+                {
+                    QMutexLocker locker(&stateMutex_);
+                    connected_[key] = connected;
+                }
+                emit connectionStateChanged(key, connected);
+            });
+
+        thread_->start();
+    }
+
+    ConnectionPool::~ConnectionPool()
+    {
+        QMetaObject::invokeMethod(worker_, &ConnectionPoolWorker::shutdown, Qt::BlockingQueuedConnection);
+        thread_->quit();
+        thread_->wait();
+        delete worker_;
+        delete thread_;
+    }
+
+    void ConnectionPool::warm(NetworkCommand::Protocol protocol, const QString& host, quint16 port)
+    {
+        if (host.isEmpty() || port == 0) {
+            return;
+        }
+
+        ConnectionPoolWorker* worker = worker_;
+        const int protocolValue = static_cast<int>(protocol);
+        QMetaObject::invokeMethod(worker_, [worker, protocolValue, host, port]() {
+            worker->warm(protocolValue, host, port);
+        }, Qt::QueuedConnection);
+    }
+
+    void ConnectionPool::release(NetworkCommand::Protocol protocol, const QString& host, quint16 port)
+    {
+        ConnectionPoolWorker* worker = worker_;
+        const QString key = NetworkCommand::endpointKey(protocol, host, port);
+        QMetaObject::invokeMethod(worker_, [worker, key]() { worker->release(key); }, Qt::QueuedConnection);
+    }
+
+    quint64 ConnectionPool::send(const NetworkCommand& command)
+    {
+        const quint64 id = nextId_.fetch_add(1);
+        const qint64 submittedNs = monotonicNanoseconds();
+
+        ConnectionPoolWorker* worker = worker_;
+        QMetaObject::invokeMethod(worker_, [worker, id, command, submittedNs]() {
+            worker->submit(id, command, submittedNs);
+        }, Qt::QueuedConnection);
+
+        return id;
+    }
+
+    void ConnectionPool::setReconnectBackoff(int minimumMs, int maximumMs)
+    {
+        ConnectionPoolWorker* worker = worker_;
+        QMetaObject::invokeMethod(worker_, [worker, minimumMs, maximumMs]() {
+            worker->setReconnectBackoff(minimumMs, maximumMs);
+        }, Qt::QueuedConnection);
+    }
+
+    bool ConnectionPool::isConnected(const QString& endpointKey) const
+    {
+        QMutexLocker locker(&stateMutex_);
+        return connected_.value(endpointKey, false);
+    }
+
+    // ============================================================================
+    // ConnectionPoolWorker (I/O thread)
+    // ============================================================================
+
+    ConnectionPoolWorker::ConnectionPoolWorker(QObject* parent)
+        : QObject(parent)
+        , backoffMinMs_(250)
+        , backoffMaxMs_(10000)
+    {
+    }
+
+    ConnectionPoolWorker::~ConnectionPoolWorker()
+    {
+        shutdown();
+    }
+
+    void ConnectionPoolWorker::shutdown()
+    {
+        const QList<Connection*> connections = connections_.values();
+        connections_.clear();
+        for (Connection* connection : connections) {
+            closeConnection(connection);
+        }
+    }
+
+    void ConnectionPoolWorker::setReconnectBackoff(int minimumMs, int maximumMs)
+    {
+        backoffMinMs_ = qMax(10, minimumMs);
+        backoffMaxMs_ = qMax(backoffMinMs_, maximumMs);
+    }
+
+    void ConnectionPoolWorker::warm(int protocol, const QString& host, quint16 port)
+    {
+        Connection* connection = connectionFor(static_cast<NetworkCommand::Protocol>(protocol), host, port);
+        connection->users++;
+    }
+
+    void ConnectionPoolWorker::release(const QString& key)
+    {
+        Connection* connection = connections_.value(key);
+        if (!connection || --connection->users > 0) {
+            return;
+        }
+
+        connections_.remove(key);
+        closeConnection(connection);
+    }
+
+    void ConnectionPoolWorker::closeConnection(Connection* connection)
+    {
+        const QString key = connection->key;
+
+        if (connection->inFlight) {
+            complete(connection, false, QByteArray(), 0, "Connection released");
+        }
+        failQueued(connection, "Connection released");
+
+        connection->socket->disconnect();
+        connection->socket->abort();
+        delete connection->socket;
+        delete connection->reconnectTimer;
+        delete connection->timeoutTimer;
+
+        if (connection->connected) {
+            emit connectionStateChanged(key, false);
+        }
+        delete connection;
+    }
+
+    ConnectionPoolWorker::Connection* ConnectionPoolWorker::connectionFor(
+        NetworkCommand::Protocol protocol, const QString& host, quint16 port)
+    {
+        const QString key = NetworkCommand::endpointKey(protocol, host, port);
+
+        if (Connection* existing = connections_.value(key)) {
+            return existing;
+        }
+
+        auto* connection = new Connection;
+        connection->key = key;
+        connection->protocol = protocol;
+        connection->host = host;
+        connection->port = port;
+        connection->socket = new QTcpSocket(this);
+        connection->reconnectTimer = new QTimer(this);
+        connection->reconnectTimer->setSingleShot(true);
+        connection->timeoutTimer = new QTimer(this);
+        connection->timeoutTimer->setSingleShot(true);
+        connections_.insert(key, connection);
+
+        QTcpSocket* socket = connection->socket;
+
+        connect(socket, &QTcpSocket::connected, socket, [this, connection]() {
+            connection->connected = true;
+            connection->failures = 0;
+            connection->socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+            connection->socket->setSocketOption(QAbstractSocket::KeepAliveOption, 1);
+            emit connectionStateChanged(connection->key, true);
+            dispatchNext(connection);
+        });
+        connect(socket, &QTcpSocket::readyRead, socket, [this, connection]() { handleReadyRead(connection); });
+        connect(socket, &QTcpSocket::bytesWritten, socket, [this, connection]() { handleBytesWritten(connection); });
+        connect(socket, &QTcpSocket::disconnected, socket, [this, connection]() { handleDisconnected(connection); });
+        connect(socket, &QTcpSocket::errorOccurred, socket, [this, connection](QAbstractSocket::SocketError) {
+            // Failed connection attempts report an error but never "disconnected"
+            if (connection->socket->state() == QAbstractSocket::UnconnectedState) {
+                handleDisconnected(connection);
+            }
+        });
+        connect(connection->reconnectTimer, &QTimer::timeout, this, [this, connection]() { openConnection(connection); });
+        connect(connection->timeoutTimer, &QTimer::timeout, this, [this, connection]() { handleTimeout(connection); });
+
+        openConnection(connection);
+        return connection;
+    }
+
+    void ConnectionPoolWorker::openConnection(Connection* connection)
+    {
+        if (connection->socket->state() != QAbstractSocket::UnconnectedState) {
+            return;
+        }
+
+        connection->rx.clear();
+        connection->socket->connectToHost(connection->host, connection->port);
+    }
+
+    void ConnectionPoolWorker::scheduleReconnect(Connection* connection)
+    {
+        if (connection->reconnectTimer->isActive()) {
+            return;
+        }
+
+        // Exponential backoff with +/-20% jitter so a rack of devices that
+        // drops together doesn't reconnect in lockstep
+        const int exponent = qMin(connection->failures, 16);
+        const qint64 base = qMin<qint64>(backoffMaxMs_, static_cast<qint64>(backoffMinMs_) << exponent);
+        const double jitter = 0.8 + 0.4 * QRandomGenerator::global()->generateDouble();
+        connection->failures++;
+
+        connection->reconnectTimer->start(static_cast<int>(base * jitter));
+    }
+
+    void ConnectionPoolWorker::submit(quint64 id, const NetworkCommand& command, qint64 submittedNs)
+    {
+        Pending pending;
+        pending.id = id;
+        pending.command = command;
+        pending.submittedNs = submittedNs;
+
+        if (command.host.isEmpty() || command.port == 0) {
+            NetworkCommandResult result;
+            result.id = id;
+            result.endpoint = command.endpointKey();
+            result.error = "No destination";
+            emit finished(result);
+            return;
+        }
+
+        Connection* connection = connectionFor(command.protocol, command.host, command.port);
+        connection->queue.enqueue(pending);
+
+        if (!connection->connected && connection->reconnectTimer->isActive()) {
+            // Someone is waiting - try now rather than at the end of the backoff
+            connection->reconnectTimer->stop();
+            openConnection(connection);
+        }
+
+        dispatchNext(connection);
+    }
+
+    void ConnectionPoolWorker::dispatchNext(Connection* connection)
+    {
+        while (connection->connected && !connection->inFlight && !connection->queue.isEmpty()) {
+            Pending pending = connection->queue.dequeue();
+            const NetworkCommand& command = pending.command;
+
+            const qint64 now = monotonicNanoseconds();
+            if ((now - pending.submittedNs) / 1000000 > command.timeoutMs) {
+                NetworkCommandResult result;
+                result.id = pending.id;
+                result.endpoint = connection->key;
+                result.error = "Timed out waiting for connection";
+                result.latencyMs = (now - pending.submittedNs) / 1e6;
+                emit finished(result);
+                continue;
+            }
+
+            QByteArray bytes;
+            if (command.protocol == NetworkCommand::Protocol::Http) {
+                bytes.reserve(command.payload.size() + 256);
+                bytes += command.httpMethod + ' ' + (command.httpPath.isEmpty() ? QByteArray("/") : command.httpPath) + " HTTP/1.1\r\n";
+                bytes += "Host: " + connection->host.toUtf8() + ':' + QByteArray::number(connection->port) + "\r\n";
+                bytes += "Connection: keep-alive\r\n";
+                if (!command.payload.isEmpty() || command.httpMethod != "GET") {
+                    if (!command.contentType.isEmpty()) {
+                        bytes += "Content-Type: " + command.contentType + "\r\n";
+                    }
+                    bytes += "Content-Length: " + QByteArray::number(command.payload.size()) + "\r\n";
+                }
+                bytes += "\r\n";
+                bytes += command.payload;
+            }
+            else {
+                bytes = command.payload;
+            }
+
+            connection->current = pending;
+            connection->inFlight = true;
+            connection->rx.clear();
+
+            connection->socket->write(bytes);
+            connection->current.dispatchedNs = monotonicNanoseconds();
+            connection->timeoutTimer->start(qMax(1, command.timeoutMs));
+        }
+    }
+
+    void ConnectionPoolWorker::handleBytesWritten(Connection* connection)
+    {
+        if (!connection->inFlight || connection->socket->bytesToWrite() > 0) {
+            return;
+        }
+
+        // Fire-and-forget TCP completes once the kernel has the bytes
+        const NetworkCommand& command = connection->current.command;
+        if (command.protocol == NetworkCommand::Protocol::Tcp && !command.expectReply) {
+            complete(connection, true, QByteArray());
+        }
+    }
+
+    void ConnectionPoolWorker::handleReadyRead(Connection* connection)
+    {
+        connection->rx += connection->socket->readAll();
+
+        if (!connection->inFlight) {
+            // Unsolicited device chatter
+            connection->rx.clear();
+            return;
+        }
+
+        const NetworkCommand& command = connection->current.command;
+
+        if (command.protocol == NetworkCommand::Protocol::Http) {
+            int status = 0;
+            QByteArray body;
+            bool closeAfter = false;
+            if (parseHttpResponse(connection->rx, false, status, body, closeAfter)) {
+                const bool ok = status >= 200 && status < 300;
+                complete(connection, ok, body, status, ok ? QString() : QString("HTTP %1").arg(status));
+                if (closeAfter) {
+                    connection->socket->disconnectFromHost();
+                }
+            }
+        }
+        else if (command.expectReply) {
+            const QByteArray& terminator = command.replyTerminator;
+            const int end = terminator.isEmpty() ? connection->rx.size() : connection->rx.indexOf(terminator);
+            if (end >= 0) {
+                complete(connection, true, connection->rx.left(end));
+            }
+        }
+    }
+
+    void ConnectionPoolWorker::handleDisconnected(Connection* connection)
+    {
+        const bool wasConnected = connection->connected;
+        connection->connected = false;
+
+        if (connection->inFlight) {
+            int status = 0;
+            QByteArray body;
+            bool closeAfter = false;
+            if (connection->current.command.protocol == NetworkCommand::Protocol::Http
+                && parseHttpResponse(connection->rx, true, status, body, closeAfter)) {
+                const bool ok = status >= 200 && status < 300;
+                complete(connection, ok, body, status, ok ? QString() : QString("HTTP %1").arg(status));
+            }
+            else {
+                complete(connection, false, QByteArray(), 0, "Connection lost");
+            }
+        }
+
+        if (wasConnected) {
+            emit connectionStateChanged(connection->key, false);
+        }
+        else {
+            // Device unreachable - report now rather than firing stale commands later
+            failQueued(connection, connection->socket->errorString());
+        }
+
+        scheduleReconnect(connection);
+    }
+
+    void ConnectionPoolWorker::handleTimeout(Connection* connection)
+    {
+        if (!connection->inFlight) {
+            return;
+        }
+
+        complete(connection, false, QByteArray(), 0, "Timed out");
+
+        // A late reply would be matched to the next command - start clean
+        connection->socket->abort();
+    }
+
+    void ConnectionPoolWorker::complete(Connection* connection, bool ok, const QByteArray& reply,
+        int httpStatus, const QString& error)
+    {
+        connection->timeoutTimer->stop();
+        connection->inFlight = false;
+
+        const qint64 now = monotonicNanoseconds();
+        const Pending& pending = connection->current;
+
+        NetworkCommandResult result;
+        result.id = pending.id;
+        result.endpoint = connection->key;
+        result.ok = ok;
+        result.latencyMs = (now - pending.submittedNs) / 1e6;
+        result.dispatchMs = pending.dispatchedNs > 0 ? (pending.dispatchedNs - pending.submittedNs) / 1e6 : 0.0;
+        result.httpStatus = httpStatus;
+        result.reply = reply;
+        result.error = error;
+
+        connection->rx.clear();
+        emit finished(result);
+
+        dispatchNext(connection);
+    }
+
+    void ConnectionPoolWorker::failQueued(Connection* connection, const QString& error)
+    {
+        const qint64 now = monotonicNanoseconds();
+        while (!connection->queue.isEmpty()) {
+            const Pending pending = connection->queue.dequeue();
+
+            NetworkCommandResult result;
+            result.id = pending.id;
+            result.endpoint = connection->key;
+            result.latencyMs = (now - pending.submittedNs) / 1e6;
+            result.error = error;
+            emit finished(result);
+        }
+    }
+
+    bool ConnectionPoolWorker::parseHttpResponse(const QByteArray& data, bool atEof,
+        int& status, QByteArray& body, bool& closeAfter)
+    {
+        const int headerEnd = data.indexOf("\r\n\r\n");
+        if (headerEnd < 0) {
+            return false;
+        }
+
+        const QList<QByteArray> lines = data.left(headerEnd).split('\n');
+        const QList<QByteArray> statusLine = lines.value(0).trimmed().split(' ');
+        status = statusLine.value(1).toInt();
+
+        qint64 contentLength = -1;
+        bool chunked = false;
+        closeAfter = false;
+
+        for (int i = 1; i < lines.size(); ++i) {
+            const QByteArray& line = lines[i];
+            const int colon = line.indexOf(':');
+            if (colon <= 0) {
+                continue;
+            }
+            const QByteArray name = line.left(colon).trimmed().toLower();
+            const QByteArray value = line.mid(colon + 1).trimmed().toLower();
+
+            if (name == "content-length") {
+                contentLength = value.toLongLong();
+            }
+            else if (name == "transfer-encoding" && value.contains("chunked")) {
+                chunked = true;
+            }
+            else if (name == "connection" && value == "close") {
+                closeAfter = true;
+            }
+        }
+
+        const int bodyStart = headerEnd + 4;
+
+        if (status == 204 || status == 304 || (status >= 100 && status < 200)) {
+            body.clear();
+            return true;
+        }
+
+        if (chunked) {
+            body.clear();
+            int pos = bodyStart;
+            while (true) {
+                const int lineEnd = data.indexOf("\r\n", pos);
+                if (lineEnd < 0) {
+                    return false;
+                }
+                bool ok = false;
+                const int size = data.mid(pos, lineEnd - pos).split(';').value(0).trimmed().toInt(&ok, 16);
+                if (!ok) {
+                    return atEof;
+                }
+                if (size == 0) {
+                    return true;
+                }
+                if (data.size() < lineEnd + 2 + size + 2) {
+                    return false;
+                }
+                body += data.mid(lineEnd + 2, size);
+                pos = lineEnd + 2 + size + 2;
+            }
+        }
+
+        if (contentLength >= 0) {
+            if (data.size() - bodyStart < contentLength) {
+                return false;
+            }
+            body = data.mid(bodyStart, static_cast<int>(contentLength));
+            return true;
+        }
+
+        // No framing - the body runs until the server closes
+        closeAfter = true;
+        if (!atEof) {
+            return false;
+        }
+        body = data.mid(bodyStart);
+        return true;
+    }
+
+} // namespace CueForge
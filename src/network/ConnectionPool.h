@@ -0,0 +1,180 @@
+// ============================================================================
+// ConnectionPool.h - Persistent TCP/HTTP connections on an I/O thread
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QByteArray>
+#include <QHash>
+#include <QQueue>
+#include <QMutex>
+#include <QMetaType>
+#include <atomic>
+
+QT_BEGIN_NAMESPACE
+class QThread;
+class QTcpSocket;
+class QTimer;
+QT_END_NAMESPACE
+
+namespace CueForge {
+
+    /**
+     * One command for a device - raw bytes over TCP or an HTTP/1.1 request.
+     */
+    struct NetworkCommand {
+        enum class Protocol { Tcp, Http };
+
+        Protocol protocol = Protocol::Tcp;
+        QString host;
+        quint16 port = 0;
+
+        QByteArray payload;               // TCP bytes, or the HTTP body
+        QByteArray httpMethod = "GET";
+        QByteArray httpPath = "/";
+        QByteArray contentType;
+
+        bool expectReply = false;         // TCP only - HTTP always waits
+        QByteArray replyTerminator = "\n";
+        int timeoutMs = 2000;
+
+        QString endpointKey() const;
+        static QString endpointKey(Protocol protocol, const QString& host, quint16 port);
+    };
+
+    struct NetworkCommandResult {
+        quint64 id = 0;
+        QString endpoint;
+        bool ok = false;
+        double latencyMs = 0.0;   // send() call to reply (or write) complete
+        double dispatchMs = 0.0;  // send() call to bytes handed to the socket
+        int httpStatus = 0;
+        QByteArray reply;
+        QString error;
+    };
+
+    class ConnectionPoolWorker;
+
+    /**
+     * Keeps device connections open and warm so GO never pays for DNS,
+     * TCP handshake or HTTP connection setup.
+     *
+     * All socket work runs on a dedicated I/O thread; send() only queues
+     * the command and returns an id. Each command completes with
+     * commandFinished() carrying its round-trip latency. Dropped
+     * connections are re-opened with exponential backoff.
+     */
+    class ConnectionPool : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        explicit ConnectionPool(QObject* parent = nullptr);
+        ~ConnectionPool() override;
+
+        // Open (and keep open) a connection ahead of use. Reference counted
+        // per endpoint - it closes when every warm() has been released.
+        void warm(NetworkCommand::Protocol protocol, const QString& host, quint16 port);
+        void release(NetworkCommand::Protocol protocol, const QString& host, quint16 port);
+
+        // Thread-safe; returns the id reported in commandFinished()
+        quint64 send(const NetworkCommand& command);
+
+        void setReconnectBackoff(int minimumMs, int maximumMs);
+
+        bool isConnected(const QString& endpointKey) const;
+
+    signals:
+        void commandFinished(const CueForge::NetworkCommandResult& result);
+        void connectionStateChanged(const QString& endpointKey, bool connected);
+
+    private:
+        QThread* thread_;
+        ConnectionPoolWorker* worker_;
+        std::atomic<quint64> nextId_;
+
+        mutable QMutex stateMutex_;
+        QHash<QString, bool> connected_;
+    };
+
+    /**
+     * I/O thread side of ConnectionPool. Only ever touched through queued
+     * calls from the pool.
+     */
+    class ConnectionPoolWorker : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        explicit ConnectionPoolWorker(QObject* parent = nullptr);
+        ~ConnectionPoolWorker() override;
+
+    public slots:
+        void warm(int protocol, const QString& host, quint16 port);
+        void release(const QString& key);
+        void submit(quint64 id, const CueForge::NetworkCommand& command, qint64 submittedNs);
+        void setReconnectBackoff(int minimumMs, int maximumMs);
+        void shutdown();
+
+    signals:
+        void finished(const CueForge::NetworkCommandResult& result);
+        void connectionStateChanged(const QString& endpointKey, bool connected);
+
+    private:
+        struct Pending {
+            quint64 id = 0;
+            NetworkCommand command;
+            qint64 submittedNs = 0;
+            qint64 dispatchedNs = 0;
+        };
+
+        struct Connection {
+            QString key;
+            int users = 0;
+            NetworkCommand::Protocol protocol = NetworkCommand::Protocol::Tcp;
+            QString host;
+            quint16 port = 0;
+
+            QTcpSocket* socket = nullptr;
+            QTimer* reconnectTimer = nullptr;
+            QTimer* timeoutTimer = nullptr;
+            bool connected = false;
+            int failures = 0;
+
+            QQueue<Pending> queue;
+            bool inFlight = false;
+            Pending current;
+            QByteArray rx;
+        };
+
+        Connection* connectionFor(NetworkCommand::Protocol protocol, const QString& host, quint16 port);
+        void openConnection(Connection* connection);
+        void scheduleReconnect(Connection* connection);
+        void dispatchNext(Connection* connection);
+        void handleReadyRead(Connection* connection);
+        void handleBytesWritten(Connection* connection);
+        void handleDisconnected(Connection* connection);
+        void handleTimeout(Connection* connection);
+        void complete(Connection* connection, bool ok, const QByteArray& reply,
+            int httpStatus = 0, const QString& error = QString());
+        void failQueued(Connection* connection, const QString& error);
+        void closeConnection(Connection* connection);
+
+        // Returns true once a full HTTP response is buffered
+        static bool parseHttpResponse(const QByteArray& data, bool atEof,
+            int& status, QByteArray& body, bool& closeAfter);
+
+        QHash<QString, Connection*> connections_;
+        int backoffMinMs_;
+        int backoffMaxMs_;
+    };
+
+    qint64 monotonicNanoseconds();
+
+} // namespace CueForge
+
+Q_DECLARE_METATYPE(CueForge::NetworkCommand)
+Q_DECLARE_METATYPE(CueForge::NetworkCommandResult)
@@ -0,0 +1,61 @@
+// ============================================================================
+// MirrorProtocol.cpp - Mirror frame encoding/decoding
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#include "MirrorProtocol.h"
+#include <QtEndian>
+
+namespace CueForge {
+namespace MirrorProtocol {
+
+    void appendFrame(QByteArray& out, quint64 sequence, MirrorMessage type,
+        const QCborValue& payload)
+    {
+        QByteArray body = payload.isUndefined() ? QByteArray() : payload.toCbor();
+
+        char header[HeaderSize];
+        qToBigEndian<quint32>(static_cast<quint32>(8 + 1 + body.size()), header);
+        qToBigEndian<quint64>(sequence, header + 4);
+        header[12] = static_cast<char>(type);
+
+        out.append(header, HeaderSize);
+        out.append(body);
+    }
+
+    int decodeFrame(const QByteArray& buffer, int& offset, MirrorFrame& frame)
+    {
+        const int available = buffer.size() - offset;
+        if (available < HeaderSize) {
+            return 0;
+        }
+
+        const char* data = buffer.constData() + offset;
+        quint32 bodyLength = qFromBigEndian<quint32>(data);
+
+        if (bodyLength < 9 || bodyLength > MaxBodySize) {
+            return -1;
+        }
+
+        if (available < static_cast<int>(4 + bodyLength)) {
+            return 0;
+        }
+
+        frame.sequence = qFromBigEndian<quint64>(data + 4);
+        frame.type = static_cast<MirrorMessage>(static_cast<quint8>(data[12]));
+
+        const int payloadSize = static_cast<int>(bodyLength) - 9;
+        if (payloadSize > 0) {
+            frame.payload = QCborValue::fromCbor(
+                QByteArray::fromRawData(data + HeaderSize, payloadSize));
+        }
+        else {
+            frame.payload = QCborValue();
+        }
+
+        offset += 4 + static_cast<int>(bodyLength);
+        return 1;
+    }
+
+} // namespace MirrorProtocol
+} // namespace CueForge
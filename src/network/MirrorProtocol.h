@@ -0,0 +1,78 @@
+// ============================================================================
+// MirrorProtocol.h - Wire format for primary/backup mirror synchronization
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#pragma once
+
+#include <QByteArray>
+#include <QCborValue>
+#include <QCborMap>
+#include <QtGlobal>
+
+namespace CueForge {
+
+    /**
+     * Message types carried in a mirror frame.
+     * Values are part of the wire format - append only, never renumber.
+     */
+    enum class MirrorMessage : quint8 {
+        Snapshot = 1,       // Full workspace, sent on (re)connect
+        Go = 2,             // GO on a specific cue
+        StopAll = 3,
+        PauseToggle = 4,
+        Panic = 5,
+        StandBy = 6,
+        CueAdded = 7,
+        CueRemoved = 8,
+        CueMoved = 9,
+        CueEdited = 10,
+        VoicePositions = 11,
+        Heartbeat = 12,
+        Ack = 13,           // Backup -> primary: last applied sequence
+        ResyncRequest = 14  // Backup -> primary: gap detected, send snapshot
+    };
+
+    /**
+     * Integer keys used inside CBOR payload maps (smaller than string keys).
+     */
+    enum class MirrorKey : int {
+        CueId = 0,
+        Index = 1,
+        Cue = 2,
+        Workspace = 3,
+        ActiveCues = 4,
+        Positions = 5,
+        Timestamp = 6,
+        Sequence = 7
+    };
+
+    struct MirrorFrame {
+        quint64 sequence = 0;
+        MirrorMessage type = MirrorMessage::Heartbeat;
+        QCborValue payload;
+    };
+
+    namespace MirrorProtocol {
+
+        // Frame layout (big endian):
+        //   quint32 bodyLength | quint64 sequence | quint8 type | CBOR payload
+        // bodyLength counts everything after the length field itself.
+        constexpr int HeaderSize = 4 + 8 + 1;
+        constexpr quint32 MaxBodySize = 64 * 1024 * 1024;
+        constexpr quint16 DefaultPort = 53100;
+
+        /// Append one encoded frame to @p out (avoids a temporary per frame)
+        void appendFrame(QByteArray& out, quint64 sequence, MirrorMessage type,
+            const QCborValue& payload = QCborValue());
+
+        /// Decode the frame starting at @p offset.
+        /// @return 1 if a frame was decoded (offset advanced), 0 if more data is
+        ///         needed, -1 if the stream is corrupt.
+        int decodeFrame(const QByteArray& buffer, int& offset, MirrorFrame& frame);
+
+        inline QCborValue key(MirrorKey k) { return QCborValue(static_cast<int>(k)); }
+
+    } // namespace MirrorProtocol
+
+} // namespace CueForge
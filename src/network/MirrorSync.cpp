@@ -0,0 +1,715 @@
+// ============================================================================
+// MirrorSync.cpp - Primary/backup workspace mirroring implementation
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#include "MirrorSync.h"
+#include "../core/CueManager.h"
+#include "../core/cues/AudioCue.h"
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTimer>
+#include <QCborArray>
+#include <QJsonObject>
+#include <QDebug>
+#include <limits>
+#include <utility>
+
+namespace CueForge {
+
+    namespace {
+        // A backup holding more unsent data than this is treated as stalled
+        constexpr qint64 MaxBackupWriteBacklog = 16 * 1024 * 1024;
+
+        QCborValue cueToCbor(const Cue* cue)
+        {
+            return QCborMap::fromJsonObject(cue->toJson());
+        }
+    }
+
+    // ============================================================================
+    // MirrorPrimary
+    // ============================================================================
+
+    MirrorPrimary::MirrorPrimary(CueManager* cueManager, QObject* parent)
+        : QObject(parent)
+        , cueManager_(cueManager)
+        , server_(new QTcpServer(this))
+        , positionTimer_(new QTimer(this))
+        , nextSequence_(1)
+        , maxLagFrames_(100000)
+        , flushScheduled_(false)
+    {
+        clock_.start();
+
+        connect(server_, &QTcpServer::newConnection, this, &MirrorPrimary::onNewConnection);
+
+        positionTimer_->setInterval(50);
+        connect(positionTimer_, &QTimer::timeout, this, &MirrorPrimary::sampleVoicePositions);
+
+        if (cueManager_) {
+            connect(cueManager_, &CueManager::cueAdded, this, &MirrorPrimary::onCueAdded);
+            connect(cueManager_, &CueManager::cueRemoved, this, &MirrorPrimary::onCueRemoved);
+            connect(cueManager_, &CueManager::cueMoved, this, &MirrorPrimary::onCueMoved);
+            connect(cueManager_, &CueManager::cueUpdated, this, &MirrorPrimary::onCueUpdated);
+            connect(cueManager_, &CueManager::standByCueChanged, this, &MirrorPrimary::onStandByChanged);
+            connect(cueManager_, &CueManager::goTriggered, this, &MirrorPrimary::onGoTriggered);
+            connect(cueManager_, &CueManager::stopAllTriggered, this,
+                [this]() { queue(MirrorMessage::StopAll); });
+            connect(cueManager_, &CueManager::pauseToggled, this,
+                [this]() { queue(MirrorMessage::PauseToggle); });
+            connect(cueManager_, &CueManager::panicTriggered, this,
+                [this]() { queue(MirrorMessage::Panic); });
+        }
+    }
+
+    MirrorPrimary::~MirrorPrimary()
+    {
+        close();
+    }
+
+    bool MirrorPrimary::listen(const QHostAddress& address, quint16 port)
+    {
+        if (server_->isListening()) {
+            return true;
+        }
+
+        if (!server_->listen(address, port)) {
+            qWarning() << "MirrorPrimary: Failed to listen on" << address.toString()
+                << port << "-" << server_->errorString();
+            return false;
+        }
+
+        positionTimer_->start();
+        qDebug() << "MirrorPrimary: Listening on port" << server_->serverPort();
+        return true;
+    }
+
+    void MirrorPrimary::close()
+    {
+        positionTimer_->stop();
+        server_->close();
+
+        const auto sockets = backups_.keys();
+        for (QTcpSocket* socket : sockets) {
+            socket->disconnect(this);
+            socket->abort();
+            socket->deleteLater();
+        }
+        backups_.clear();
+        pending_.clear();
+        dirtyCues_.clear();
+    }
+
+    bool MirrorPrimary::isListening() const
+    {
+        return server_->isListening();
+    }
+
+    quint16 MirrorPrimary::serverPort() const
+    {
+        return server_->serverPort();
+    }
+
+    void MirrorPrimary::setPositionInterval(int ms)
+    {
+        positionTimer_->setInterval(qMax(1, ms));
+    }
+
+    void MirrorPrimary::onNewConnection()
+    {
+        while (QTcpSocket* socket = server_->nextPendingConnection()) {
+            socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+
+            connect(socket, &QTcpSocket::readyRead, this,
+                [this, socket]() { handleBackupData(socket); });
+            connect(socket, &QTcpSocket::disconnected, this,
+                [this, socket]() { dropBackup(socket); });
+
+            // Anything queued so far belongs to the existing backups
+            flush();
+
+            Backup& backup = backups_[socket];
+            backup.socket = socket;
+            sendSnapshot(backup);
+
+            QString peer = socket->peerAddress().toString();
+            qDebug() << "MirrorPrimary: Backup connected from" << peer;
+            emit backupConnected(peer);
+        }
+    }
+
+    void MirrorPrimary::sendSnapshot(Backup& backup)
+    {
+        if (!cueManager_) {
+            return;
+        }
+
+        QCborArray active;
+        for (const QString& id : cueManager_->activeCueIds()) {
+            active.append(id);
+        }
+
+        QCborMap payload;
+        payload[MirrorProtocol::key(MirrorKey::Workspace)] =
+            QCborMap::fromJsonObject(cueManager_->saveWorkspace());
+        payload[MirrorProtocol::key(MirrorKey::ActiveCues)] = active;
+        payload[MirrorProtocol::key(MirrorKey::Timestamp)] = clock_.elapsed();
+
+        // The snapshot carries the last sequence it already contains, so the
+        // next delta frame continues the stream without a gap
+        QByteArray frame;
+        MirrorProtocol::appendFrame(frame, nextSequence_ - 1, MirrorMessage::Snapshot, payload);
+
+        backup.socket->write(frame);
+        backup.ackedSequence = nextSequence_ - 1;
+        backup.needsSnapshot = false;
+    }
+
+    void MirrorPrimary::handleBackupData(QTcpSocket* socket)
+    {
+        auto it = backups_.find(socket);
+        if (it == backups_.end()) {
+            return;
+        }
+
+        QByteArray data = std::move(it.value().readBuffer);
+        data.append(socket->readAll());
+
+        int offset = 0;
+        MirrorFrame frame;
+        int result;
+        while ((result = MirrorProtocol::decodeFrame(data, offset, frame)) > 0) {
+            if (frame.type == MirrorMessage::Ack) {
+                backups_[socket].ackedSequence = static_cast<quint64>(
+                    frame.payload.toMap().value(MirrorProtocol::key(MirrorKey::Sequence)).toInteger());
+            }
+            else if (frame.type == MirrorMessage::ResyncRequest) {
+                // flush() may drop stalled backups, including this one
+                flush();
+                if (!backups_.contains(socket)) {
+                    return;
+                }
+                sendSnapshot(backups_[socket]);
+            }
+        }
+
+        if (result < 0) {
+            qWarning() << "MirrorPrimary: Corrupt data from backup, dropping connection";
+            socket->abort();
+            return;
+        }
+
+        data.remove(0, offset);
+        backups_[socket].readBuffer = std::move(data);
+    }
+
+    void MirrorPrimary::dropBackup(QTcpSocket* socket)
+    {
+        if (backups_.remove(socket) > 0) {
+            QString peer = socket->peerAddress().toString();
+            qDebug() << "MirrorPrimary: Backup disconnected" << peer;
+            emit backupDisconnected(peer);
+        }
+        socket->deleteLater();
+    }
+
+    // ============================================================================
+    // Delta capture
+    // ============================================================================
+
+    void MirrorPrimary::onCueAdded(Cue* cue, int index)
+    {
+        if (!cue) {
+            return;
+        }
+
+        QCborMap payload;
+        payload[MirrorProtocol::key(MirrorKey::Index)] = index;
+        payload[MirrorProtocol::key(MirrorKey::Cue)] = cueToCbor(cue);
+        queue(MirrorMessage::CueAdded, payload);
+
+        // The add already carries the current state
+        dirtyCues_.remove(cue->id());
+    }
+
+    void MirrorPrimary::onCueRemoved(const QString& cueId)
+    {
+        dirtyCues_.remove(cueId);
+
+        QCborMap payload;
+        payload[MirrorProtocol::key(MirrorKey::CueId)] = cueId;
+        queue(MirrorMessage::CueRemoved, payload);
+    }
+
+    void MirrorPrimary::onCueMoved(const QString& cueId, int oldIndex, int newIndex)
+    {
+        Q_UNUSED(oldIndex);
+
+        QCborMap payload;
+        payload[MirrorProtocol::key(MirrorKey::CueId)] = cueId;
+        payload[MirrorProtocol::key(MirrorKey::Index)] = newIndex;
+        queue(MirrorMessage::CueMoved, payload);
+    }
+
+    void MirrorPrimary::onCueUpdated(Cue* cue)
+    {
+        if (!cue || backups_.isEmpty()) {
+            return;
+        }
+
+        dirtyCues_.insert(cue->id());
+        scheduleFlush();
+    }
+
+    void MirrorPrimary::onStandByChanged(const QString& cueId)
+    {
+        QCborMap payload;
+        payload[MirrorProtocol::key(MirrorKey::CueId)] = cueId;
+        queue(MirrorMessage::StandBy, payload);
+    }
+
+    void MirrorPrimary::onGoTriggered(const QString& cueId)
+    {
+        QCborMap payload;
+        payload[MirrorProtocol::key(MirrorKey::CueId)] = cueId;
+        payload[MirrorProtocol::key(MirrorKey::Timestamp)] = clock_.elapsed();
+        queue(MirrorMessage::Go, payload);
+    }
+
+    void MirrorPrimary::sampleVoicePositions()
+    {
+        if (!cueManager_ || backups_.isEmpty()) {
+            return;
+        }
+
+        QCborArray positions;
+        for (const QString& id : cueManager_->activeCueIds()) {
+            AudioCue* audioCue = qobject_cast<AudioCue*>(cueManager_->getCue(id));
+            if (audioCue && audioCue->status() == CueStatus::Running) {
+                positions.append(QCborArray{ id, audioCue->playbackPosition() });
+            }
+        }
+
+        QCborMap payload;
+        payload[MirrorProtocol::key(MirrorKey::Timestamp)] = clock_.elapsed();
+
+        if (positions.isEmpty()) {
+            queue(MirrorMessage::Heartbeat, payload);
+        }
+        else {
+            payload[MirrorProtocol::key(MirrorKey::Positions)] = positions;
+            queue(MirrorMessage::VoicePositions, payload);
+        }
+    }
+
+    void MirrorPrimary::queue(MirrorMessage type, const QCborValue& payload)
+    {
+        if (backups_.isEmpty()) {
+            // Nobody is listening - the next backup starts from a snapshot
+            dirtyCues_.clear();
+            return;
+        }
+
+        // Keep causal order: edits made before this event are applied first
+        encodeDirtyEdits();
+
+        MirrorProtocol::appendFrame(pending_, nextSequence_++, type, payload);
+        scheduleFlush();
+    }
+
+    void MirrorPrimary::encodeDirtyEdits()
+    {
+        if (dirtyCues_.isEmpty() || !cueManager_) {
+            return;
+        }
+
+        for (const QString& id : std::as_const(dirtyCues_)) {
+            Cue* cue = cueManager_->getCue(id);
+            if (!cue) {
+                continue;
+            }
+
+            QCborMap payload;
+            payload[MirrorProtocol::key(MirrorKey::Cue)] = cueToCbor(cue);
+            MirrorProtocol::appendFrame(pending_, nextSequence_++, MirrorMessage::CueEdited, payload);
+        }
+
+        dirtyCues_.clear();
+    }
+
+    void MirrorPrimary::scheduleFlush()
+    {
+        if (!flushScheduled_) {
+            flushScheduled_ = true;
+            QTimer::singleShot(0, this, &MirrorPrimary::flush);
+        }
+    }
+
+    void MirrorPrimary::flush()
+    {
+        flushScheduled_ = false;
+        encodeDirtyEdits();
+
+        if (pending_.isEmpty()) {
+            return;
+        }
+
+        const quint64 last = nextSequence_ - 1;
+        QList<QTcpSocket*> stalled;
+
+        for (auto it = backups_.begin(); it != backups_.end(); ++it) {
+            Backup& backup = it.value();
+            backup.socket->write(pending_);
+
+            const quint64 lag = last - qMin(last, backup.ackedSequence);
+            if (lag > maxLagFrames_ || backup.socket->bytesToWrite() > MaxBackupWriteBacklog) {
+                emit backupLagging(backup.socket->peerAddress().toString(), lag);
+                stalled.append(backup.socket);
+            }
+        }
+
+        pending_.clear();
+
+        // A stalled backup would only fall further behind; cut it loose so it
+        // reconnects and restarts from a fresh snapshot
+        for (QTcpSocket* socket : stalled) {
+            qWarning() << "MirrorPrimary: Backup exceeded lag bound, forcing resync";
+            socket->abort();
+        }
+    }
+
+    // ============================================================================
+    // MirrorBackup
+    // ============================================================================
+
+    MirrorBackup::MirrorBackup(CueManager* cueManager, QObject* parent)
+        : QObject(parent)
+        , cueManager_(cueManager)
+        , socket_(new QTcpSocket(this))
+        , ackTimer_(new QTimer(this))
+        , reconnectTimer_(new QTimer(this))
+        , port_(MirrorProtocol::DefaultPort)
+        , lastSequence_(0)
+        , lagMs_(0)
+        , primaryClockOffsetMs_(std::numeric_limits<qint64>::max())
+        , driftTolerance_(0.02)
+        , minSeekIntervalMs_(500)
+        , awaitingSnapshot_(true)
+        , shadowPlayback_(true)
+        , tookOver_(false)
+    {
+        clock_.start();
+
+        connect(socket_, &QTcpSocket::connected, this, &MirrorBackup::onConnected);
+        connect(socket_, &QTcpSocket::disconnected, this, &MirrorBackup::onDisconnected);
+        connect(socket_, &QTcpSocket::readyRead, this, &MirrorBackup::onReadyRead);
+        connect(socket_, &QAbstractSocket::errorOccurred, this, [this]() {
+            if (!tookOver_ && !host_.isEmpty() && !reconnectTimer_->isActive()) {
+                reconnectTimer_->start();
+            }
+        });
+
+        ackTimer_->setInterval(100);
+        connect(ackTimer_, &QTimer::timeout, this, &MirrorBackup::sendAck);
+
+        reconnectTimer_->setInterval(1000);
+        reconnectTimer_->setSingleShot(true);
+        connect(reconnectTimer_, &QTimer::timeout, this, &MirrorBackup::attemptReconnect);
+    }
+
+    MirrorBackup::~MirrorBackup()
+    {
+        host_.clear();
+        socket_->abort();
+    }
+
+    void MirrorBackup::connectToPrimary(const QString& host, quint16 port)
+    {
+        host_ = host;
+        port_ = port;
+        tookOver_ = false;
+        attemptReconnect();
+    }
+
+    void MirrorBackup::disconnectFromPrimary()
+    {
+        host_.clear();
+        reconnectTimer_->stop();
+        ackTimer_->stop();
+        socket_->disconnectFromHost();
+    }
+
+    bool MirrorBackup::isConnected() const
+    {
+        return socket_->state() == QAbstractSocket::ConnectedState;
+    }
+
+    void MirrorBackup::attemptReconnect()
+    {
+        if (host_.isEmpty() || socket_->state() != QAbstractSocket::UnconnectedState) {
+            return;
+        }
+
+        qDebug() << "MirrorBackup: Connecting to primary" << host_ << port_;
+        socket_->connectToHost(host_, port_);
+    }
+
+    void MirrorBackup::onConnected()
+    {
+        socket_->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+        readBuffer_.clear();
+        awaitingSnapshot_ = true;
+        primaryClockOffsetMs_ = std::numeric_limits<qint64>::max();
+        ackTimer_->start();
+
+        qDebug() << "MirrorBackup: Connected to primary";
+        emit connectedChanged(true);
+    }
+
+    void MirrorBackup::onDisconnected()
+    {
+        ackTimer_->stop();
+        qDebug() << "MirrorBackup: Disconnected from primary";
+        emit connectedChanged(false);
+
+        if (!tookOver_ && !host_.isEmpty()) {
+            reconnectTimer_->start();
+        }
+    }
+
+    void MirrorBackup::onReadyRead()
+    {
+        readBuffer_.append(socket_->readAll());
+
+        int offset = 0;
+        MirrorFrame frame;
+        int result;
+        while ((result = MirrorProtocol::decodeFrame(readBuffer_, offset, frame)) > 0) {
+            applyFrame(frame);
+            if (tookOver_) {
+                return;
+            }
+        }
+
+        if (result < 0) {
+            qWarning() << "MirrorBackup: Corrupt stream from primary, reconnecting";
+            readBuffer_.clear();
+            socket_->abort();
+            return;
+        }
+
+        readBuffer_.remove(0, offset);
+    }
+
+    void MirrorBackup::applyFrame(const MirrorFrame& frame)
+    {
+        if (!cueManager_) {
+            return;
+        }
+
+        if (frame.type == MirrorMessage::Snapshot) {
+            applySnapshot(frame.payload.toMap());
+            lastSequence_ = frame.sequence;
+            awaitingSnapshot_ = false;
+            return;
+        }
+
+        if (awaitingSnapshot_) {
+            return;
+        }
+
+        if (frame.sequence != lastSequence_ + 1) {
+            emit sequenceGap(lastSequence_ + 1, frame.sequence);
+            requestResync();
+            return;
+        }
+        lastSequence_ = frame.sequence;
+
+        const QCborMap payload = frame.payload.toMap();
+        const QString cueId = payload.value(MirrorProtocol::key(MirrorKey::CueId)).toString();
+
+        switch (frame.type) {
+        case MirrorMessage::Go:
+            if (shadowPlayback_) {
+                cueManager_->goCue(cueId);
+            }
+            break;
+        case MirrorMessage::StopAll:
+            positions_.clear();
+            if (shadowPlayback_) {
+                cueManager_->stop();
+            }
+            break;
+        case MirrorMessage::PauseToggle:
+            if (shadowPlayback_) {
+                cueManager_->pause();
+            }
+            break;
+        case MirrorMessage::Panic:
+            positions_.clear();
+            if (shadowPlayback_) {
+                cueManager_->panic();
+            }
+            break;
+        case MirrorMessage::StandBy:
+            cueManager_->setStandByCue(cueId);
+            break;
+        case MirrorMessage::CueAdded:
+            cueManager_->insertCueFromJson(
+                payload.value(MirrorProtocol::key(MirrorKey::Cue)).toMap().toJsonObject(),
+                static_cast<int>(payload.value(MirrorProtocol::key(MirrorKey::Index)).toInteger(-1)));
+            break;
+        case MirrorMessage::CueRemoved:
+            positions_.remove(cueId);
+            cueManager_->removeCue(cueId);
+            break;
+        case MirrorMessage::CueMoved: {
+            // The primary reports the final index; moveCue() expects the
+            // pre-removal insertion index when moving down
+            int finalIndex = static_cast<int>(payload.value(MirrorProtocol::key(MirrorKey::Index)).toInteger());
+            int currentIndex = cueManager_->getCueIndex(cueId);
+            if (currentIndex >= 0 && currentIndex != finalIndex) {
+                cueManager_->moveCue(cueId, finalIndex > currentIndex ? finalIndex + 1 : finalIndex);
+            }
+            break;
+        }
+        case MirrorMessage::CueEdited:
+            cueManager_->updateCueFromJson(
+                payload.value(MirrorProtocol::key(MirrorKey::Cue)).toMap().toJsonObject());
+            break;
+        case MirrorMessage::VoicePositions:
+        case MirrorMessage::Heartbeat:
+            applyPositions(frame.payload);
+            break;
+        default:
+            break;
+        }
+    }
+
+    void MirrorBackup::applySnapshot(const QCborMap& payload)
+    {
+        const QJsonObject workspace =
+            payload.value(MirrorProtocol::key(MirrorKey::Workspace)).toMap().toJsonObject();
+
+        positions_.clear();
+        cueManager_->loadWorkspace(workspace);
+
+        qDebug() << "MirrorBackup: Snapshot applied with" << cueManager_->cueCount() << "cues";
+        emit snapshotApplied(cueManager_->cueCount());
+    }
+
+    void MirrorBackup::applyPositions(const QCborValue& payload)
+    {
+        const QCborMap map = payload.toMap();
+        const qint64 now = clock_.elapsed();
+
+        // One-way lag estimate: the smallest observed (local - primary) offset
+        // approximates pure transit time, anything above it is queueing delay
+        const qint64 primaryTime = map.value(MirrorProtocol::key(MirrorKey::Timestamp)).toInteger();
+        const qint64 offset = now - primaryTime;
+        primaryClockOffsetMs_ = qMin(primaryClockOffsetMs_, offset);
+        lagMs_ = offset - primaryClockOffsetMs_;
+
+        const QCborArray entries = map.value(MirrorProtocol::key(MirrorKey::Positions)).toArray();
+
+        QHash<QString, VoicePosition> latest;
+        latest.reserve(entries.size());
+
+        for (const QCborValue& entry : entries) {
+            const QCborArray pair = entry.toArray();
+            const QString id = pair.at(0).toString();
+
+            // The report left the primary lagMs_ ago; the primary has moved on since
+            VoicePosition& position = latest[id];
+            position.seconds = pair.at(1).toDouble() + lagMs_ / 1000.0;
+            position.receivedAtMs = now;
+            position.seekedAtMs = positions_.value(id).seekedAtMs;
+
+            if (!shadowPlayback_) {
+                continue;
+            }
+
+            AudioCue* audioCue = qobject_cast<AudioCue*>(cueManager_->getCue(id));
+            if (!audioCue) {
+                continue;
+            }
+
+            if (audioCue->status() != CueStatus::Running) {
+                // Joined mid-show or missed a GO - bring the voice up in place
+                if (cueManager_->startCue(id)) {
+                    audioCue->seekTo(position.seconds);
+                    position.seekedAtMs = now;
+                }
+            }
+            else if (qAbs(audioCue->playbackPosition() - position.seconds) > driftTolerance_
+                && (position.seekedAtMs < 0 || now - position.seekedAtMs >= minSeekIntervalMs_)) {
+                // A seek takes a few blocks to show in playbackPosition(), so
+                // correcting on every report would keep re-seeking the voice
+                audioCue->seekTo(position.seconds);
+                position.seekedAtMs = now;
+            }
+        }
+
+        positions_ = std::move(latest);
+    }
+
+    void MirrorBackup::requestResync()
+    {
+        awaitingSnapshot_ = true;
+        send(MirrorMessage::ResyncRequest);
+    }
+
+    void MirrorBackup::sendAck()
+    {
+        QCborMap payload;
+        payload[MirrorProtocol::key(MirrorKey::Sequence)] = static_cast<qint64>(lastSequence_);
+        send(MirrorMessage::Ack, payload);
+    }
+
+    void MirrorBackup::send(MirrorMessage type, const QCborValue& payload)
+    {
+        if (!isConnected()) {
+            return;
+        }
+
+        QByteArray frame;
+        MirrorProtocol::appendFrame(frame, 0, type, payload);
+        socket_->write(frame);
+    }
+
+    void MirrorBackup::takeOver()
+    {
+        if (tookOver_) {
+            return;
+        }
+
+        tookOver_ = true;
+        disconnectFromPrimary();
+
+        if (cueManager_) {
+            const qint64 now = clock_.elapsed();
+
+            for (auto it = positions_.constBegin(); it != positions_.constEnd(); ++it) {
+                AudioCue* audioCue = qobject_cast<AudioCue*>(cueManager_->getCue(it.key()));
+                if (!audioCue) {
+                    continue;
+                }
+
+                // Extrapolate from the last report to where the primary is now
+                const double target = it.value().seconds + (now - it.value().receivedAtMs) / 1000.0;
+
+                if (audioCue->status() != CueStatus::Running && !cueManager_->startCue(it.key())) {
+                    continue;
+                }
+                if (qAbs(audioCue->playbackPosition() - target) > driftTolerance_) {
+                    audioCue->seekTo(target);
+                }
+            }
+        }
+
+        qDebug() << "MirrorBackup: Took over as primary with" << positions_.size() << "active voices";
+        emit tookOver();
+    }
+
+} // namespace CueForge
@@ -0,0 +1,185 @@
+// ============================================================================
+// MirrorSync.h - Primary/backup workspace mirroring over TCP
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QSet>
+#include <QHash>
+#include <QByteArray>
+#include <QPointer>
+#include <QHostAddress>
+#include <QElapsedTimer>
+#include "MirrorProtocol.h"
+
+QT_BEGIN_NAMESPACE
+class QTcpServer;
+class QTcpSocket;
+class QTimer;
+QT_END_NAMESPACE
+
+namespace CueForge {
+
+    class CueManager;
+    class Cue;
+
+    /**
+     * Primary side of a mirrored pair.
+     * Streams sequence-numbered state deltas (GO events, edits, voice
+     * positions) from the local CueManager to every connected backup.
+     * Edits are coalesced per event-loop pass so bursts of thousands of
+     * property changes collapse into one frame per cue.
+     */
+    class MirrorPrimary : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        explicit MirrorPrimary(CueManager* cueManager, QObject* parent = nullptr);
+        ~MirrorPrimary() override;
+
+        bool listen(const QHostAddress& address = QHostAddress::Any,
+            quint16 port = MirrorProtocol::DefaultPort);
+        void close();
+        bool isListening() const;
+        quint16 serverPort() const;
+
+        int backupCount() const { return backups_.size(); }
+        quint64 lastSequence() const { return nextSequence_ - 1; }
+
+        // Voice position sampling interval (ms)
+        void setPositionInterval(int ms);
+
+        // Backups further behind than this many frames are resynchronized
+        void setMaxLagFrames(quint64 frames) { maxLagFrames_ = frames; }
+
+    signals:
+        void backupConnected(const QString& peer);
+        void backupDisconnected(const QString& peer);
+        void backupLagging(const QString& peer, quint64 frames);
+
+    private slots:
+        void onNewConnection();
+        void onCueAdded(Cue* cue, int index);
+        void onCueRemoved(const QString& cueId);
+        void onCueMoved(const QString& cueId, int oldIndex, int newIndex);
+        void onCueUpdated(Cue* cue);
+        void onStandByChanged(const QString& cueId);
+        void onGoTriggered(const QString& cueId);
+        void sampleVoicePositions();
+        void flush();
+
+    private:
+        struct Backup {
+            QTcpSocket* socket = nullptr;
+            QByteArray readBuffer;
+            quint64 ackedSequence = 0;
+            bool needsSnapshot = true;
+        };
+
+        void queue(MirrorMessage type, const QCborValue& payload = QCborValue());
+        void encodeDirtyEdits();
+        void scheduleFlush();
+        void sendSnapshot(Backup& backup);
+        void handleBackupData(QTcpSocket* socket);
+        void dropBackup(QTcpSocket* socket);
+
+        QPointer<CueManager> cueManager_;
+        QTcpServer* server_;
+        QTimer* positionTimer_;
+        QHash<QTcpSocket*, Backup> backups_;
+
+        QByteArray pending_;            // Encoded frames awaiting flush
+        QSet<QString> dirtyCues_;       // Edits coalesced until next structural event
+        quint64 nextSequence_;
+        quint64 maxLagFrames_;
+        bool flushScheduled_;
+        QElapsedTimer clock_;
+    };
+
+    /**
+     * Backup side of a mirrored pair.
+     * Applies the primary's deltas to the local CueManager. With shadow
+     * playback enabled (default) cues also run locally and voice positions
+     * are used to correct drift, so takeOver() is instantaneous.
+     */
+    class MirrorBackup : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        explicit MirrorBackup(CueManager* cueManager, QObject* parent = nullptr);
+        ~MirrorBackup() override;
+
+        void connectToPrimary(const QString& host,
+            quint16 port = MirrorProtocol::DefaultPort);
+        void disconnectFromPrimary();
+        bool isConnected() const;
+
+        // Promote this machine: stop following and leave cues running at
+        // the last positions reported by the primary
+        void takeOver();
+        bool hasTakenOver() const { return tookOver_; }
+
+        void setShadowPlayback(bool enabled) { shadowPlayback_ = enabled; }
+        bool shadowPlayback() const { return shadowPlayback_; }
+
+        // Positions further apart than this are corrected by seeking (seconds),
+        // at most once per minimum interval per voice (ms)
+        void setDriftTolerance(double seconds) { driftTolerance_ = seconds; }
+        void setMinSeekInterval(int ms) { minSeekIntervalMs_ = ms; }
+
+        quint64 lastAppliedSequence() const { return lastSequence_; }
+        qint64 lagMs() const { return lagMs_; }
+
+    signals:
+        void connectedChanged(bool connected);
+        void snapshotApplied(int cueCount);
+        void sequenceGap(quint64 expected, quint64 received);
+        void tookOver();
+
+    private slots:
+        void onConnected();
+        void onDisconnected();
+        void onReadyRead();
+        void sendAck();
+        void attemptReconnect();
+
+    private:
+        struct VoicePosition {
+            double seconds = 0.0;           // Primary's position at receivedAtMs, lag included
+            qint64 receivedAtMs = 0;
+            qint64 seekedAtMs = -1;         // Last drift correction, for the minimum interval
+        };
+
+        void applyFrame(const MirrorFrame& frame);
+        void applySnapshot(const QCborMap& payload);
+        void applyPositions(const QCborValue& payload);
+        void requestResync();
+        void send(MirrorMessage type, const QCborValue& payload = QCborValue());
+
+        QPointer<CueManager> cueManager_;
+        QTcpSocket* socket_;
+        QTimer* ackTimer_;
+        QTimer* reconnectTimer_;
+        QString host_;
+        quint16 port_;
+
+        QByteArray readBuffer_;
+        QHash<QString, VoicePosition> positions_;
+        QElapsedTimer clock_;
+
+        quint64 lastSequence_;
+        qint64 lagMs_;
+        qint64 primaryClockOffsetMs_;
+        double driftTolerance_;
+        int minSeekIntervalMs_;
+        bool awaitingSnapshot_;
+        bool shadowPlayback_;
+        bool tookOver_;
+    };
+
+} // namespace CueForge
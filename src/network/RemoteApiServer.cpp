@@ -0,0 +1,550 @@
+// ============================================================================
+// RemoteApiServer.cpp - WebSocket remote control implementation
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#include "RemoteApiServer.h"
+#include "WebSocketConnection.h"
+#include "ConnectionPool.h"
+#include "../core/CueManager.h"
+#include "../core/ErrorHandler.h"
+#include "../core/cues/AudioCue.h"
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTimer>
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QDebug>
+
+namespace CueForge {
+
+    namespace {
+        constexpr int DefaultClientRateHz = 20;
+        constexpr int MaxClientRateHz = 120;
+        constexpr int MaxPendingErrors = 100;
+        constexpr double PlayheadEpsilon = 0.001;
+
+        int topicFromString(const QString& name)
+        {
+            if (name == "standby") return RemoteApiServer::TopicStandby;
+            if (name == "active") return RemoteApiServer::TopicActive;
+            if (name == "playheads") return RemoteApiServer::TopicPlayheads;
+            if (name == "errors") return RemoteApiServer::TopicErrors;
+            return 0;
+        }
+    }
+
+    RemoteApiServer::RemoteApiServer(CueManager* cueManager,
+        ErrorHandler* errorHandler,
+        QObject* parent)
+        : QObject(parent)
+        , cueManager_(cueManager)
+        , errorHandler_(errorHandler)
+        , server_(new QTcpServer(this))
+        , playheadTimer_(new QTimer(this))
+        , backpressureLimit_(256 * 1024)
+    {
+        clock_.start();
+
+        connect(server_, &QTcpServer::newConnection, this, &RemoteApiServer::onNewConnection);
+
+        playheadTimer_->setInterval(33);
+        connect(playheadTimer_, &QTimer::timeout, this, &RemoteApiServer::samplePlayheads);
+
+        if (cueManager_) {
+            connect(cueManager_, &CueManager::standByCueChanged, this, &RemoteApiServer::onStandByChanged);
+            connect(cueManager_, &CueManager::playbackStateChanged, this, &RemoteApiServer::onActiveChanged);
+            connect(cueManager_, &CueManager::error, this,
+                [this](const QString& message) { pushError("Error", message, "CueManager"); });
+            connect(cueManager_, &CueManager::warning, this,
+                [this](const QString& message) { pushError("Warning", message, "CueManager"); });
+
+            Cue* standby = cueManager_->standByCue();
+            standbyId_ = standby ? standby->id() : QString();
+        }
+
+        if (errorHandler_) {
+            auto forward = [this](const ErrorEntry& entry) {
+                pushError(severityToString(entry.severity), entry.message, entry.source);
+            };
+            connect(errorHandler_, &ErrorHandler::errorOccurred, this, forward);
+            connect(errorHandler_, &ErrorHandler::warningOccurred, this, forward);
+            connect(errorHandler_, &ErrorHandler::criticalErrorOccurred, this, forward);
+        }
+    }
+
+    RemoteApiServer::~RemoteApiServer()
+    {
+        close();
+    }
+
+    bool RemoteApiServer::listen(const QHostAddress& address, quint16 port)
+    {
+        if (server_->isListening()) {
+            return true;
+        }
+
+        if (!server_->listen(address, port)) {
+            qWarning() << "RemoteApiServer: Failed to listen on" << address.toString()
+                << port << "-" << server_->errorString();
+            return false;
+        }
+
+        playheadTimer_->start();
+        qDebug() << "RemoteApiServer: Listening on port" << server_->serverPort();
+        return true;
+    }
+
+    void RemoteApiServer::close()
+    {
+        playheadTimer_->stop();
+        server_->close();
+
+        const auto connections = clients_.keys();
+        for (WebSocketConnection* connection : connections) {
+            connection->disconnect(this);
+            connection->abort();
+            connection->deleteLater();
+        }
+        clients_.clear();
+    }
+
+    bool RemoteApiServer::isListening() const
+    {
+        return server_->isListening();
+    }
+
+    quint16 RemoteApiServer::serverPort() const
+    {
+        return server_->serverPort();
+    }
+
+    void RemoteApiServer::setPlayheadSampleInterval(int ms)
+    {
+        playheadTimer_->setInterval(qMax(1, ms));
+    }
+
+    // ============================================================================
+    // Connections
+    // ============================================================================
+
+    void RemoteApiServer::onNewConnection()
+    {
+        while (QTcpSocket* socket = server_->nextPendingConnection()) {
+            auto* connection = new WebSocketConnection(socket, this);
+
+            Client& client = clients_[connection];
+            client.connection = connection;
+            client.flushTimer = new QTimer(connection);
+            client.flushTimer->setInterval(1000 / DefaultClientRateHz);
+
+            connect(client.flushTimer, &QTimer::timeout, this,
+                [this, connection]() { flushClient(connection); });
+            connect(connection, &WebSocketConnection::opened, client.flushTimer,
+                qOverload<>(&QTimer::start));
+            connect(connection, &WebSocketConnection::textMessageReceived, this,
+                [this, connection](const QByteArray& message) { handleMessage(connection, message); });
+            connect(connection, &WebSocketConnection::closed, this,
+                [this, connection]() { removeClient(connection); });
+
+            // The handshake may have completed inside the constructor
+            if (connection->isOpen()) {
+                client.flushTimer->start();
+            }
+
+            qDebug() << "RemoteApiServer: Client connected" << connection->peerAddress();
+            emit clientConnected(connection->peerAddress());
+        }
+    }
+
+    void RemoteApiServer::removeClient(WebSocketConnection* connection)
+    {
+        if (clients_.remove(connection) > 0) {
+            qDebug() << "RemoteApiServer: Client disconnected" << connection->peerAddress();
+            emit clientDisconnected(connection->peerAddress());
+        }
+        connection->deleteLater();
+    }
+
+    // ============================================================================
+    // Commands
+    // ============================================================================
+
+    void RemoteApiServer::handleMessage(WebSocketConnection* connection, const QByteArray& message)
+    {
+        const qint64 receivedNs = monotonicNanoseconds();
+
+        auto it = clients_.find(connection);
+        if (it == clients_.end()) {
+            return;
+        }
+
+        QJsonParseError parseError;
+        const QJsonDocument doc = QJsonDocument::fromJson(message, &parseError);
+
+        QJsonObject reply;
+        reply["type"] = "ack";
+
+        if (parseError.error != QJsonParseError::NoError || !doc.isObject()) {
+            reply["ok"] = false;
+            reply["error"] = "invalid JSON";
+            connection->sendText(QJsonDocument(reply).toJson(QJsonDocument::Compact));
+            return;
+        }
+
+        const QJsonObject command = doc.object();
+        const QString cmd = command["cmd"].toString();
+
+        reply["cmd"] = cmd;
+        if (command.contains("id")) {
+            reply["id"] = command["id"];
+        }
+
+        bool ok = false;
+        if (cmd == "subscribe" || cmd == "unsubscribe") {
+            handleSubscribe(it.value(), command, cmd == "subscribe");
+            ok = true;
+        }
+        else {
+            ok = executeCommand(cmd, command, reply);
+        }
+
+        reply["ok"] = ok;
+        if (!ok && !reply.contains("error")) {
+            reply["error"] = "unknown command: " + cmd;
+        }
+
+        // Monotonic stamps for latency measurement from the same host
+        if (command["timing"].toBool()) {
+            reply["rxNs"] = receivedNs;
+            reply["execNs"] = monotonicNanoseconds();
+        }
+
+        // Acks bypass coalescing - they are tiny and the sender is waiting
+        connection->sendText(QJsonDocument(reply).toJson(QJsonDocument::Compact));
+        emit commandReceived(cmd);
+    }
+
+    void RemoteApiServer::handleSubscribe(Client& client, const QJsonObject& command, bool subscribe)
+    {
+        int topics = 0;
+        const QJsonArray names = command["topics"].toArray();
+        for (const QJsonValue& name : names) {
+            topics |= topicFromString(name.toString());
+        }
+
+        if (subscribe) {
+            client.topics |= topics;
+
+            // Fresh subscribers get the full current state as their first delta
+            client.standbyDirty |= (topics & TopicStandby) != 0;
+            client.activeDirty |= (topics & TopicActive) != 0;
+            client.playheadsDirty |= (topics & TopicPlayheads) != 0;
+
+            if (command.contains("rateHz")) {
+                int rate = qBound(1, command["rateHz"].toInt(DefaultClientRateHz), MaxClientRateHz);
+                client.flushTimer->setInterval(1000 / rate);
+            }
+        }
+        else {
+            client.topics &= ~topics;
+
+            if (topics & TopicStandby) {
+                client.sentStandby.clear();
+            }
+            if (topics & TopicActive) {
+                client.sentActive.clear();
+            }
+            if (topics & TopicPlayheads) {
+                client.sentPlayheads.clear();
+            }
+            if (topics & TopicErrors) {
+                client.pendingErrors.clear();
+                client.droppedErrors = 0;
+            }
+        }
+    }
+
+    bool RemoteApiServer::executeCommand(const QString& cmd, const QJsonObject& command, QJsonObject& reply)
+    {
+        if (!cueManager_) {
+            reply["error"] = "no workspace";
+            return false;
+        }
+
+        const QString cueId = command["cueId"].toString();
+
+        if (cmd == "go") {
+            return cueId.isEmpty() ? cueManager_->go() : cueManager_->goCue(cueId);
+        }
+        if (cmd == "stop") {
+            cueManager_->stop();
+            return true;
+        }
+        if (cmd == "pause") {
+            cueManager_->pause();
+            return true;
+        }
+        if (cmd == "panic") {
+            cueManager_->panic();
+            return true;
+        }
+        if (cmd == "next") {
+            cueManager_->nextCue();
+            return true;
+        }
+        if (cmd == "previous") {
+            cueManager_->previousCue();
+            return true;
+        }
+        if (cmd == "standby") {
+            if (!cueManager_->getCue(cueId)) {
+                reply["error"] = "cue not found";
+                return false;
+            }
+            cueManager_->setStandByCue(cueId);
+            return true;
+        }
+        if (cmd == "state") {
+            QJsonArray active;
+            for (const QString& id : std::as_const(active_)) {
+                active.append(id);
+            }
+            QJsonObject playheads;
+            for (auto it = playheads_.constBegin(); it != playheads_.constEnd(); ++it) {
+                playheads[it.key()] = it.value();
+            }
+            reply["standby"] = standbyJson();
+            reply["active"] = active;
+            reply["playheads"] = playheads;
+            reply["cueCount"] = cueManager_->cueCount();
+            return true;
+        }
+
+        if (commandHandler_) {
+            return commandHandler_(command, reply);
+        }
+
+        return false;
+    }
+
+    // ============================================================================
+    // State tracking
+    // ============================================================================
+
+    void RemoteApiServer::onStandByChanged(const QString& cueId)
+    {
+        standbyId_ = cueId;
+        for (Client& client : clients_) {
+            if (client.topics & TopicStandby) {
+                client.standbyDirty = true;
+            }
+        }
+    }
+
+    void RemoteApiServer::onActiveChanged()
+    {
+        if (!cueManager_) {
+            return;
+        }
+
+        const QStringList ids = cueManager_->activeCueIds();
+        active_ = QSet<QString>(ids.begin(), ids.end());
+
+        // Drop playheads of voices that are no longer active
+        for (auto it = playheads_.begin(); it != playheads_.end();) {
+            it = active_.contains(it.key()) ? std::next(it) : playheads_.erase(it);
+        }
+
+        for (Client& client : clients_) {
+            if (client.topics & TopicActive) {
+                client.activeDirty = true;
+            }
+            if (client.topics & TopicPlayheads) {
+                client.playheadsDirty = true;
+            }
+        }
+    }
+
+    void RemoteApiServer::samplePlayheads()
+    {
+        if (!cueManager_) {
+            return;
+        }
+
+        bool anySubscriber = false;
+        for (const Client& client : std::as_const(clients_)) {
+            if (client.topics & TopicPlayheads) {
+                anySubscriber = true;
+                break;
+            }
+        }
+        if (!anySubscriber) {
+            return;
+        }
+
+        // Sampled once here and shared - per-client work is only the diff
+        for (const QString& id : std::as_const(active_)) {
+            AudioCue* audioCue = qobject_cast<AudioCue*>(cueManager_->getCue(id));
+            if (audioCue && audioCue->status() == CueStatus::Running) {
+                playheads_[id] = audioCue->playbackPosition();
+            }
+        }
+
+        for (Client& client : clients_) {
+            if (client.topics & TopicPlayheads) {
+                client.playheadsDirty = true;
+            }
+        }
+    }
+
+    void RemoteApiServer::pushError(const QString& severity, const QString& message, const QString& source)
+    {
+        QJsonObject entry;
+        entry["severity"] = severity;
+        entry["message"] = message;
+        entry["source"] = source;
+        entry["time"] = clock_.elapsed();
+
+        for (Client& client : clients_) {
+            if (!(client.topics & TopicErrors)) {
+                continue;
+            }
+
+            client.pendingErrors.append(entry);
+            if (client.pendingErrors.size() > MaxPendingErrors) {
+                client.pendingErrors.removeFirst();
+                client.droppedErrors++;
+            }
+        }
+    }
+
+    QJsonObject RemoteApiServer::standbyJson() const
+    {
+        QJsonObject json;
+        json["id"] = standbyId_;
+
+        Cue* cue = cueManager_ ? cueManager_->getCue(standbyId_) : nullptr;
+        if (cue) {
+            json["number"] = cue->number();
+            json["name"] = cue->name();
+            json["type"] = cueTypeToString(cue->type());
+        }
+
+        return json;
+    }
+
+    // ============================================================================
+    // Per-client flush
+    // ============================================================================
+
+    void RemoteApiServer::flushClient(WebSocketConnection* connection)
+    {
+        auto it = clients_.find(connection);
+        if (it == clients_.end() || !connection->isOpen()) {
+            return;
+        }
+
+        Client& client = it.value();
+
+        // Backpressure: leave state coalescing until the socket drains
+        if (connection->bytesToWrite() > backpressureLimit_) {
+            client.skippedFlushes++;
+            return;
+        }
+
+        QJsonObject delta;
+
+        if (client.standbyDirty) {
+            client.standbyDirty = false;
+            if (standbyId_ != client.sentStandby) {
+                delta["standby"] = standbyJson();
+                client.sentStandby = standbyId_;
+            }
+        }
+
+        if (client.activeDirty) {
+            client.activeDirty = false;
+
+            QJsonArray added;
+            QJsonArray removed;
+            for (const QString& id : std::as_const(active_)) {
+                if (!client.sentActive.contains(id)) {
+                    added.append(id);
+                }
+            }
+            for (const QString& id : std::as_const(client.sentActive)) {
+                if (!active_.contains(id)) {
+                    removed.append(id);
+                }
+            }
+
+            if (!added.isEmpty() || !removed.isEmpty()) {
+                QJsonObject active;
+                active["added"] = added;
+                active["removed"] = removed;
+                delta["active"] = active;
+                client.sentActive = active_;
+            }
+        }
+
+        if (client.playheadsDirty) {
+            client.playheadsDirty = false;
+
+            QJsonObject changed;
+            for (auto p = playheads_.constBegin(); p != playheads_.constEnd(); ++p) {
+                auto sent = client.sentPlayheads.constFind(p.key());
+                if (sent == client.sentPlayheads.constEnd()
+                    || qAbs(sent.value() - p.value()) > PlayheadEpsilon) {
+                    changed[p.key()] = p.value();
+                    client.sentPlayheads[p.key()] = p.value();
+                }
+            }
+
+            QJsonArray gone;
+            for (auto s = client.sentPlayheads.begin(); s != client.sentPlayheads.end();) {
+                if (!playheads_.contains(s.key())) {
+                    gone.append(s.key());
+                    s = client.sentPlayheads.erase(s);
+                }
+                else {
+                    ++s;
+                }
+            }
+
+            if (!changed.isEmpty()) {
+                delta["playheads"] = changed;
+            }
+            if (!gone.isEmpty()) {
+                delta["playheadsRemoved"] = gone;
+            }
+        }
+
+        if (!client.pendingErrors.isEmpty()) {
+            QJsonArray errors;
+            for (const QJsonObject& entry : std::as_const(client.pendingErrors)) {
+                errors.append(entry);
+            }
+            delta["errors"] = errors;
+            if (client.droppedErrors > 0) {
+                delta["errorsDropped"] = client.droppedErrors;
+            }
+            client.pendingErrors.clear();
+            client.droppedErrors = 0;
+        }
+
+        if (delta.isEmpty()) {
+            return;
+        }
+
+        delta["type"] = "delta";
+        delta["time"] = clock_.elapsed();
+        if (client.skippedFlushes > 0) {
+            delta["skipped"] = client.skippedFlushes;
+            client.skippedFlushes = 0;
+        }
+
+        connection->sendText(QJsonDocument(delta).toJson(QJsonDocument::Compact));
+    }
+
+} // namespace CueForge
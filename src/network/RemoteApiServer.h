@@ -0,0 +1,139 @@
+// ============================================================================
+// RemoteApiServer.h - WebSocket remote control with subscription push
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QSet>
+#include <QList>
+#include <QJsonObject>
+#include <QPointer>
+#include <QHostAddress>
+#include <QElapsedTimer>
+#include <functional>
+
+QT_BEGIN_NAMESPACE
+class QTcpServer;
+class QTimer;
+QT_END_NAMESPACE
+
+namespace CueForge {
+
+    class CueManager;
+    class ErrorHandler;
+    class WebSocketConnection;
+
+    /**
+     * Remote control API for tablets and laptops.
+     *
+     * Clients send JSON commands ({"cmd":"go"}, {"cmd":"subscribe",...}) and
+     * receive coalesced deltas for the topics they subscribed to: standby,
+     * active, playheads and errors. Each client is flushed on its own timer;
+     * a client whose socket is backed up is simply skipped until it drains,
+     * while its pending state keeps coalescing, so a slow tablet costs a
+     * bounded amount of memory and never blocks the UI thread.
+     *
+     * A command carrying "timing":true gets steady-clock rxNs/execNs stamps
+     * in its ack, so a client on the same host can measure dispatch latency.
+     */
+    class RemoteApiServer : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        enum Topic {
+            TopicStandby = 0x1,
+            TopicActive = 0x2,
+            TopicPlayheads = 0x4,
+            TopicErrors = 0x8
+        };
+
+        static constexpr quint16 DefaultPort = 53000;
+
+        explicit RemoteApiServer(CueManager* cueManager,
+            ErrorHandler* errorHandler = nullptr,
+            QObject* parent = nullptr);
+        ~RemoteApiServer() override;
+
+        bool listen(const QHostAddress& address = QHostAddress::Any, quint16 port = DefaultPort);
+        void close();
+        bool isListening() const;
+        quint16 serverPort() const;
+
+        int clientCount() const { return clients_.size(); }
+
+        // How often active playheads are sampled (ms)
+        void setPlayheadSampleInterval(int ms);
+
+        // Unsent bytes above which a client's flush is skipped
+        void setBackpressureLimit(qint64 bytes) { backpressureLimit_ = bytes; }
+
+        // Extension point for commands not handled by the server itself.
+        // The handler returns true if it handled the command; it may fill
+        // the reply object which is merged into the ack.
+        using CommandHandler = std::function<bool(const QJsonObject& command, QJsonObject& reply)>;
+        void setCommandHandler(CommandHandler handler) { commandHandler_ = std::move(handler); }
+
+    signals:
+        void clientConnected(const QString& peer);
+        void clientDisconnected(const QString& peer);
+        void commandReceived(const QString& command);
+
+    private slots:
+        void onNewConnection();
+        void onStandByChanged(const QString& cueId);
+        void onActiveChanged();
+        void samplePlayheads();
+
+    private:
+        struct Client {
+            WebSocketConnection* connection = nullptr;
+            QTimer* flushTimer = nullptr;
+            int topics = 0;
+
+            // Pending (coalesced) state
+            bool standbyDirty = false;
+            bool activeDirty = false;
+            bool playheadsDirty = false;
+            QList<QJsonObject> pendingErrors;
+            int droppedErrors = 0;
+
+            // Last state delivered, used to compute deltas
+            QString sentStandby;
+            QSet<QString> sentActive;
+            QHash<QString, double> sentPlayheads;
+
+            int skippedFlushes = 0;
+        };
+
+        void handleMessage(WebSocketConnection* connection, const QByteArray& message);
+        void handleSubscribe(Client& client, const QJsonObject& command, bool subscribe);
+        bool executeCommand(const QString& cmd, const QJsonObject& command, QJsonObject& reply);
+        void flushClient(WebSocketConnection* connection);
+        void removeClient(WebSocketConnection* connection);
+        void pushError(const QString& severity, const QString& message, const QString& source);
+
+        QJsonObject standbyJson() const;
+
+        QPointer<CueManager> cueManager_;
+        QPointer<ErrorHandler> errorHandler_;
+        QTcpServer* server_;
+        QTimer* playheadTimer_;
+        QHash<WebSocketConnection*, Client> clients_;
+        CommandHandler commandHandler_;
+
+        // Authoritative current state shared by all clients
+        QString standbyId_;
+        QSet<QString> active_;
+        QHash<QString, double> playheads_;
+
+        qint64 backpressureLimit_;
+        QElapsedTimer clock_;
+    };
+
+} // namespace CueForge
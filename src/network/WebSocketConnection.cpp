@@ -0,0 +1,363 @@
+// ============================================================================
+// WebSocketConnection.cpp - Minimal RFC 6455 endpoint implementation
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#include "WebSocketConnection.h"
+#include <QTcpSocket>
+#include <QCryptographicHash>
+#include <QRandomGenerator>
+#include <QtEndian>
+#include <QDebug>
+#include <cstring>
+
+namespace CueForge {
+
+    namespace {
+        const QByteArray HandshakeGuid = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+        constexpr int MaxHandshakeSize = 16 * 1024;
+
+        QByteArray acceptKeyFor(const QByteArray& clientKey)
+        {
+            return QCryptographicHash::hash(clientKey + HandshakeGuid,
+                QCryptographicHash::Sha1).toBase64();
+        }
+
+        QByteArray headerValue(const QByteArray& request, const QByteArray& name)
+        {
+            const QList<QByteArray> lines = request.split('\n');
+            for (const QByteArray& line : lines) {
+                int colon = line.indexOf(':');
+                if (colon > 0 && line.left(colon).trimmed().compare(name, Qt::CaseInsensitive) == 0) {
+                    return line.mid(colon + 1).trimmed();
+                }
+            }
+            return QByteArray();
+        }
+    }
+
+    WebSocketConnection::WebSocketConnection(QTcpSocket* socket, QObject* parent)
+        : QObject(parent)
+        , socket_(socket)
+        , role_(Role::Server)
+        , maxMessageSize_(1024 * 1024)
+        , fragmentOpcode_(Text)
+        , open_(false)
+        , closeSent_(false)
+    {
+        socket_->setParent(this);
+        attachSocket();
+
+        // The upgrade request may already be buffered
+        if (socket_->bytesAvailable() > 0) {
+            onReadyRead();
+        }
+    }
+
+    WebSocketConnection::WebSocketConnection(QObject* parent)
+        : QObject(parent)
+        , socket_(new QTcpSocket(this))
+        , role_(Role::Client)
+        , maxMessageSize_(1024 * 1024)
+        , fragmentOpcode_(Text)
+        , open_(false)
+        , closeSent_(false)
+    {
+        attachSocket();
+    }
+
+    WebSocketConnection::~WebSocketConnection()
+    {
+        if (socket_) {
+            socket_->disconnect(this);
+            socket_->abort();
+        }
+    }
+
+    void WebSocketConnection::attachSocket()
+    {
+        socket_->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+        connect(socket_, &QTcpSocket::readyRead, this, &WebSocketConnection::onReadyRead);
+        connect(socket_, &QTcpSocket::disconnected, this, &WebSocketConnection::onDisconnected);
+        connect(socket_, &QTcpSocket::bytesWritten, this, &WebSocketConnection::bytesWritten);
+    }
+
+    void WebSocketConnection::connectToHost(const QString& host, quint16 port, const QString& path)
+    {
+        if (role_ != Role::Client) {
+            return;
+        }
+
+        QByteArray nonce(16, Qt::Uninitialized);
+        for (int i = 0; i < nonce.size(); ++i) {
+            nonce[i] = static_cast<char>(QRandomGenerator::global()->bounded(256));
+        }
+        clientKey_ = nonce.toBase64();
+
+        connect(socket_, &QTcpSocket::connected, this, [this, host, port, path]() {
+            QByteArray request;
+            request += "GET " + path.toUtf8() + " HTTP/1.1\r\n";
+            request += "Host: " + host.toUtf8() + ":" + QByteArray::number(port) + "\r\n";
+            request += "Upgrade: websocket\r\n";
+            request += "Connection: Upgrade\r\n";
+            request += "Sec-WebSocket-Key: " + clientKey_ + "\r\n";
+            request += "Sec-WebSocket-Version: 13\r\n\r\n";
+            socket_->write(request);
+        });
+
+        socket_->connectToHost(host, port);
+    }
+
+    QString WebSocketConnection::peerAddress() const
+    {
+        return socket_ ? socket_->peerAddress().toString() + ":" + QString::number(socket_->peerPort())
+                       : QString();
+    }
+
+    qint64 WebSocketConnection::bytesToWrite() const
+    {
+        return socket_ ? socket_->bytesToWrite() : 0;
+    }
+
+    bool WebSocketConnection::sendText(const QByteArray& utf8)
+    {
+        if (!open_ || closeSent_) {
+            return false;
+        }
+
+        sendFrame(Text, utf8);
+        return true;
+    }
+
+    void WebSocketConnection::close(quint16 code)
+    {
+        if (!open_ || closeSent_) {
+            abort();
+            return;
+        }
+
+        QByteArray payload(2, Qt::Uninitialized);
+        qToBigEndian<quint16>(code, payload.data());
+        sendFrame(Close, payload);
+        closeSent_ = true;
+        socket_->disconnectFromHost();
+    }
+
+    void WebSocketConnection::abort()
+    {
+        if (socket_) {
+            socket_->abort();
+        }
+    }
+
+    void WebSocketConnection::onReadyRead()
+    {
+        buffer_.append(socket_->readAll());
+
+        if (!open_) {
+            if (!processHandshake()) {
+                return;
+            }
+        }
+
+        processFrames();
+    }
+
+    void WebSocketConnection::onDisconnected()
+    {
+        open_ = false;
+        emit closed();
+    }
+
+    bool WebSocketConnection::processHandshake()
+    {
+        int end = buffer_.indexOf("\r\n\r\n");
+        if (end < 0) {
+            if (buffer_.size() > MaxHandshakeSize) {
+                fail("handshake too large");
+            }
+            return false;
+        }
+
+        const QByteArray head = buffer_.left(end);
+        buffer_.remove(0, end + 4);
+
+        if (role_ == Role::Server) {
+            const QByteArray key = headerValue(head, "Sec-WebSocket-Key");
+            if (!head.startsWith("GET ") || key.isEmpty()) {
+                socket_->write("HTTP/1.1 400 Bad Request\r\nContent-Length: 0\r\n\r\n");
+                fail("not a websocket upgrade");
+                return false;
+            }
+
+            QByteArray response;
+            response += "HTTP/1.1 101 Switching Protocols\r\n";
+            response += "Upgrade: websocket\r\n";
+            response += "Connection: Upgrade\r\n";
+            response += "Sec-WebSocket-Accept: " + acceptKeyFor(key) + "\r\n\r\n";
+            socket_->write(response);
+        }
+        else {
+            if (!head.startsWith("HTTP/1.1 101")
+                || headerValue(head, "Sec-WebSocket-Accept") != acceptKeyFor(clientKey_)) {
+                fail("server rejected upgrade");
+                return false;
+            }
+        }
+
+        open_ = true;
+        emit opened();
+        return true;
+    }
+
+    void WebSocketConnection::processFrames()
+    {
+        int offset = 0;
+
+        while (open_) {
+            const int available = buffer_.size() - offset;
+            if (available < 2) {
+                break;
+            }
+
+            const uchar* data = reinterpret_cast<const uchar*>(buffer_.constData() + offset);
+            const bool fin = (data[0] & 0x80) != 0;
+            const quint8 opcode = data[0] & 0x0F;
+            const bool masked = (data[1] & 0x80) != 0;
+            quint64 length = data[1] & 0x7F;
+            int headerSize = 2;
+
+            if (length == 126) {
+                if (available < 4) {
+                    break;
+                }
+                length = qFromBigEndian<quint16>(data + 2);
+                headerSize = 4;
+            }
+            else if (length == 127) {
+                if (available < 10) {
+                    break;
+                }
+                length = qFromBigEndian<quint64>(data + 2);
+                headerSize = 10;
+            }
+
+            if (length > static_cast<quint64>(maxMessageSize_)) {
+                fail("frame too large");
+                return;
+            }
+
+            const int maskSize = masked ? 4 : 0;
+            const int frameSize = headerSize + maskSize + static_cast<int>(length);
+            if (available < frameSize) {
+                break;
+            }
+
+            QByteArray payload(reinterpret_cast<const char*>(data + headerSize + maskSize),
+                static_cast<int>(length));
+            if (masked) {
+                const uchar* mask = data + headerSize;
+                for (int i = 0; i < payload.size(); ++i) {
+                    payload[i] = static_cast<char>(payload[i] ^ mask[i & 3]);
+                }
+            }
+
+            offset += frameSize;
+
+            switch (opcode) {
+            case Text:
+            case Binary:
+            case Continuation:
+                if (opcode != Continuation) {
+                    fragments_.clear();
+                    fragmentOpcode_ = opcode;
+                }
+                fragments_.append(payload);
+                if (fragments_.size() > maxMessageSize_) {
+                    fail("message too large");
+                    return;
+                }
+                if (fin) {
+                    QByteArray message = std::move(fragments_);
+                    fragments_.clear();
+                    if (fragmentOpcode_ == Text) {
+                        emit textMessageReceived(message);
+                    }
+                }
+                break;
+            case Ping:
+                sendFrame(Pong, payload);
+                break;
+            case Pong:
+                break;
+            case Close:
+                if (!closeSent_) {
+                    sendFrame(Close, payload.left(2));
+                    closeSent_ = true;
+                }
+                socket_->disconnectFromHost();
+                buffer_.clear();
+                return;
+            default:
+                fail("unknown opcode");
+                return;
+            }
+        }
+
+        buffer_.remove(0, offset);
+    }
+
+    void WebSocketConnection::sendFrame(Opcode opcode, const QByteArray& payload)
+    {
+        const bool mask = (role_ == Role::Client);
+        const qint64 length = payload.size();
+
+        QByteArray frame;
+        frame.reserve(static_cast<int>(length) + 14);
+        frame.append(static_cast<char>(0x80 | opcode));
+
+        const char maskBit = mask ? static_cast<char>(0x80) : 0;
+        if (length < 126) {
+            frame.append(static_cast<char>(maskBit | length));
+        }
+        else if (length <= 0xFFFF) {
+            char ext[2];
+            qToBigEndian<quint16>(static_cast<quint16>(length), ext);
+            frame.append(static_cast<char>(maskBit | 126));
+            frame.append(ext, 2);
+        }
+        else {
+            char ext[8];
+            qToBigEndian<quint64>(static_cast<quint64>(length), ext);
+            frame.append(static_cast<char>(maskBit | 127));
+            frame.append(ext, 8);
+        }
+
+        if (mask) {
+            const quint32 key = QRandomGenerator::global()->generate();
+            char keyBytes[4];
+            memcpy(keyBytes, &key, 4);
+            frame.append(keyBytes, 4);
+
+            const int start = frame.size();
+            frame.append(payload);
+            for (int i = 0; i < payload.size(); ++i) {
+                frame[start + i] = static_cast<char>(frame[start + i] ^ keyBytes[i & 3]);
+            }
+        }
+        else {
+            frame.append(payload);
+        }
+
+        socket_->write(frame);
+    }
+
+    void WebSocketConnection::fail(const char* reason)
+    {
+        qWarning() << "WebSocketConnection:" << reason << "-" << peerAddress();
+        open_ = false;
+        buffer_.clear();
+        socket_->abort();
+    }
+
+} // namespace CueForge
@@ -0,0 +1,97 @@
+// ============================================================================
+// WebSocketConnection.h - Minimal RFC 6455 endpoint on top of QTcpSocket
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#pragma once
+
+#include <QObject>
+#include <QByteArray>
+#include <QString>
+
+QT_BEGIN_NAMESPACE
+class QTcpSocket;
+QT_END_NAMESPACE
+
+namespace CueForge {
+
+    /**
+     * One WebSocket connection (server or client side).
+     * Handles the HTTP upgrade handshake, framing, masking, fragmentation,
+     * ping/pong and close. Only depends on Qt Network, so it builds
+     * everywhere the rest of CueForge does.
+     */
+    class WebSocketConnection : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        enum class Role {
+            Server,   // Accepted socket - waits for the client's upgrade request
+            Client    // Outgoing socket - sends the upgrade request
+        };
+
+        // Server role: takes ownership of an accepted socket
+        WebSocketConnection(QTcpSocket* socket, QObject* parent = nullptr);
+
+        // Client role: call connectToHost() afterwards
+        explicit WebSocketConnection(QObject* parent = nullptr);
+
+        ~WebSocketConnection() override;
+
+        void connectToHost(const QString& host, quint16 port, const QString& path = "/");
+
+        bool isOpen() const { return open_; }
+        Role role() const { return role_; }
+        QString peerAddress() const;
+
+        // Queue a text message; returns false if the connection is not open
+        bool sendText(const QByteArray& utf8);
+        bool sendText(const QString& text) { return sendText(text.toUtf8()); }
+
+        // Bytes accepted but not yet handed to the OS (used for backpressure)
+        qint64 bytesToWrite() const;
+
+        void close(quint16 code = 1000);
+        void abort();
+
+        void setMaxMessageSize(int bytes) { maxMessageSize_ = bytes; }
+
+    signals:
+        void opened();
+        void textMessageReceived(const QByteArray& utf8);
+        void bytesWritten(qint64 bytes);
+        void closed();
+
+    private slots:
+        void onReadyRead();
+        void onDisconnected();
+
+    private:
+        enum Opcode : quint8 {
+            Continuation = 0x0,
+            Text = 0x1,
+            Binary = 0x2,
+            Close = 0x8,
+            Ping = 0x9,
+            Pong = 0xA
+        };
+
+        void attachSocket();
+        bool processHandshake();
+        void processFrames();
+        void sendFrame(Opcode opcode, const QByteArray& payload);
+        void fail(const char* reason);
+
+        QTcpSocket* socket_;
+        Role role_;
+        QByteArray buffer_;
+        QByteArray fragments_;
+        QByteArray clientKey_;
+        int maxMessageSize_;
+        quint8 fragmentOpcode_;
+        bool open_;
+        bool closeSent_;
+    };
+
+} // namespace CueForge
@@ -7,6 +7,8 @@
 #include "CueTreeModel.h"
 #include "../core/CueManager.h"
 #include "../core/Cue.h"
+#include "../core/cues/AudioCue.h"
+#include "../audio/AudioEngineQt.h"
 
 #include <QTreeView>
 #include <QVBoxLayout>
@@ -339,6 +341,26 @@ namespace CueForge {
                     cueManager_->setStandByCue(cueId);
                     });
 
+                // Audition on the preview bus without touching the show
+                QString cueId = model_->data(index, CueTreeModel::CueIdRole).toString();
+                if (auto* audioCue = qobject_cast<AudioCue*>(cueManager_->getCue(cueId))) {
+                    AudioEngineQt* audioEngine = cueManager_->audioEngine();
+                    if (audioCue->isPreviewing()) {
+                        menu.addAction("⏹️ Stop Preview", [audioCue]() {
+                            audioCue->stopPreview();
+                            });
+                    }
+                    else if (!audioEngine || !audioEngine->isPreviewAvailable()) {
+                        // Shown, but greyed out, so the operator knows why
+                        menu.addAction("🎧 Preview (no preview output)")->setEnabled(false);
+                    }
+                    else {
+                        menu.addAction("🎧 Preview", [audioCue]() {
+                            audioCue->startPreview();
+                            });
+                    }
+                }
+
                 menu.addSeparator();
             }
 
@@ -366,6 +388,30 @@ namespace CueForge {
                 cueManager_->createCue(CueType::Audio);
                 });
 
+            menu.addAction("🎬 New Video Cue", [this]() {
+                cueManager_->createCue(CueType::Video);
+                });
+
+            menu.addAction("🎤 New Live Input Cue", [this]() {
+                cueManager_->createCue(CueType::LiveInput);
+                });
+
+            menu.addAction("🎚️ New Stem Cue", [this]() {
+                cueManager_->createCue(CueType::Stem);
+                });
+
+            menu.addAction("📻 New Playlist Cue", [this]() {
+                cueManager_->createCue(CueType::Playlist);
+                });
+
+            menu.addAction("⏺️ New Record Cue", [this]() {
+                cueManager_->createCue(CueType::Record);
+                });
+
+            menu.addAction("🌐 New Network Cue", [this]() {
+                cueManager_->createCue(CueType::Network);
+                });
+
             menu.addAction("📁 New Group Cue", [this]() {
                 cueManager_->createCue(CueType::Group);
                 });
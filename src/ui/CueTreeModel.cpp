@@ -230,6 +230,11 @@ namespace CueForge {
             case CueType::Stop: return QString("⏹️");
             case CueType::Goto: return QString("➡️");
             case CueType::Pause: return QString("⏸️");
+            case CueType::Network: return QString("🌐");
+            case CueType::LiveInput: return QString("🎤");
+            case CueType::Stem: return QString("🎚️");
+            case CueType::Playlist: return QString("📻");
+            case CueType::Record: return QString("⏺️");
             default: return QString("⚙️");
             }
         }
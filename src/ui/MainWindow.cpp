@@ -10,6 +10,9 @@
 #include "../core/CueManager.h"
 #include "../core/ErrorHandler.h"
 #include "../audio/AudioEngineQt.h"
+#include "../video/VideoCompositor.h"
+#include "../video/VideoOutput.h"
+#include "../network/ConnectionPool.h"
 
 #include <QMenuBar>
 #include <QToolBar>
@@ -29,6 +32,7 @@ namespace CueForge {
 
     MainWindow::MainWindow(CueManager* cueManager,
         ErrorHandler* errorHandler,
+        const QString& nullAudioSpec,
         QWidget* parent)
         : QMainWindow(parent)
         , cueManager_(cueManager)
@@ -36,6 +40,9 @@ namespace CueForge {
         , cueListWidget_(nullptr)
         , inspectorWidget_(nullptr)
         , transportWidget_(nullptr)
+        , videoCompositor_(nullptr)
+        , videoOutput_(nullptr)
+        , connectionPool_(nullptr)
     {
         setWindowTitle("CueForge");
         resize(1400, 900);
@@ -49,6 +56,9 @@ namespace CueForge {
 
         #ifdef HAVE_JUCE_AUDIO
                 audioEngine_ = new AudioEngineQt(this);
+                if (!nullAudioSpec.isEmpty()) {
+                    audioEngine_->setNullAudio(nullAudioSpec);
+                }
                 if (audioEngine_->initialize()) {
                     qDebug() << "✓ Audio engine initialized";
                     statusLabel_->setText("Audio engine ready");
@@ -60,9 +70,28 @@ namespace CueForge {
                 cueManager_->setAudioEngine(audioEngine_);
                 qDebug() << "MainWindow: Connected audio engine to cue manager";
         #else
+                Q_UNUSED(nullAudioSpec);
                 qWarning() << "Built without JUCE audio support";
         #endif
 
+        // Video follows the audio clock when there is one
+        videoCompositor_ = new VideoCompositor(this);
+        #ifdef HAVE_JUCE_AUDIO
+                videoCompositor_->setAudioEngine(audioEngine_);
+        #endif
+        videoOutput_ = new VideoOutputWidget(this);
+        videoCompositor_->addOutput(videoOutput_);
+        connect(videoCompositor_, &VideoCompositor::activeChanged, this, [this](bool active) {
+            if (active && !videoOutput_->isVisible()) {
+                videoOutput_->show();
+            }
+        });
+        cueManager_->setVideoCompositor(videoCompositor_);
+
+        // Device connections for network cues, kept warm on their own thread
+        connectionPool_ = new ConnectionPool(this);
+        cueManager_->setConnectionPool(connectionPool_);
+
         setupConnections();
         applyStyleSheet();
         loadSettings();
@@ -23,20 +23,27 @@ namespace CueForge {
     class InspectorWidget;
     class TransportWidget;
     class AudioEngineQt;
+    class VideoCompositor;
+    class VideoOutputWidget;
+    class ConnectionPool;
 
     class MainWindow : public QMainWindow
     {
         Q_OBJECT
 
     public:
+        // nullAudioSpec: empty to open the soundcard, otherwise the null
+        // device to run on (see AudioEngineQt::setNullAudio)
         explicit MainWindow(CueManager* cueManager,
             ErrorHandler* errorHandler,
+            const QString& nullAudioSpec = QString(),
             QWidget* parent = nullptr);
         ~MainWindow() override;
 
 #ifdef HAVE_JUCE_AUDIO
         AudioEngineQt* audioEngine() const { return audioEngine_; }
 #endif
+        VideoCompositor* videoCompositor() const { return videoCompositor_; }
 
     protected:
         void closeEvent(QCloseEvent* event) override;
@@ -150,6 +157,9 @@ namespace CueForge {
 #ifdef HAVE_JUCE_AUDIO
         AudioEngineQt* audioEngine_;
 #endif
+        VideoCompositor* videoCompositor_;
+        VideoOutputWidget* videoOutput_;
+        ConnectionPool* connectionPool_;
     };
 
 } // namespace CueForge
\ No newline at end of file
@@ -0,0 +1,38 @@
+// ============================================================================
+// VideoBlend.h - CPU compositing of video layers (SSE2 with scalar fallback)
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#pragma once
+
+#include <QRect>
+#include <QtGlobal>
+#include <vector>
+
+namespace CueForge {
+
+    struct VideoFrame;
+
+    namespace VideoBlend {
+
+        // Scratch buffers reused across frames so compositing never allocates
+        struct Scratch {
+            std::vector<int> sourceX;
+            std::vector<quint32> row;
+        };
+
+        // dst = src * opacity + dst * (1 - srcAlpha * opacity), premultiplied
+        // ARGB32. opacity256 is the layer opacity scaled to 0..256.
+        void blendRow(quint32* dst, const quint32* src, int count, int opacity256);
+
+        // Nearest-neighbour scale src into target (clipped to the canvas)
+        // and blend it with the given opacity
+        void blendFrame(uchar* canvas, int canvasStride, int canvasWidth, int canvasHeight,
+            const VideoFrame& src, const QRect& target, double opacity, Scratch& scratch);
+
+        // True when blendRow uses the SIMD path on this build
+        bool simdEnabled();
+
+    } // namespace VideoBlend
+
+} // namespace CueForge
@@ -0,0 +1,368 @@
+// ============================================================================
+// VideoCompositor.cpp - Audio-clocked compositing of active video cues
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#include "VideoCompositor.h"
+#include "VideoPlayback.h"
+#include "VideoFramePool.h"
+#include "VideoOutput.h"
+#include "../audio/AudioEngineQt.h"
+#include <QTimer>
+#include <QDebug>
+#include <cmath>
+
+namespace CueForge {
+
+    namespace {
+        // The audio clock advances once per device buffer; between callbacks
+        // it is extrapolated from the wall clock, but never by more than this
+        constexpr double MaxClockExtrapolation = 0.05;
+    }
+
+    VideoCompositor::VideoCompositor(QObject* parent)
+        : QObject(parent)
+        , lastAudioClock_(-1.0)
+        , lastAudioClockWallNs_(0)
+        , canvas_(1920, 1080, QImage::Format_ARGB32_Premultiplied)
+        , timer_(new QTimer(this))
+        , frameRate_(60.0)
+        , autoRender_(true)
+        , nextLayerId_(1)
+    {
+        wallClock_.start();
+        canvas_.fill(0xFF000000);
+
+        timer_->setTimerType(Qt::PreciseTimer);
+        timer_->setInterval(static_cast<int>(1000.0 / frameRate_));
+        connect(timer_, &QTimer::timeout, this, &VideoCompositor::renderFrame);
+    }
+
+    VideoCompositor::~VideoCompositor() = default;
+
+    void VideoCompositor::setAudioEngine(AudioEngineQt* engine)
+    {
+        audioEngine_ = engine;
+        lastAudioClock_ = -1.0;
+    }
+
+    void VideoCompositor::setClock(Clock clock)
+    {
+        clock_ = std::move(clock);
+    }
+
+    double VideoCompositor::clockSeconds()
+    {
+        if (clock_) {
+            return clock_();
+        }
+
+        const qint64 wallNs = wallClock_.nsecsElapsed();
+
+        if (audioEngine_ && audioEngine_->isInitialized()) {
+            const double audioClock = audioEngine_->audioClockSeconds();
+            if (audioClock != lastAudioClock_) {
+                lastAudioClock_ = audioClock;
+                lastAudioClockWallNs_ = wallNs;
+                return audioClock;
+            }
+
+            const double sinceCallback = (wallNs - lastAudioClockWallNs_) / 1e9;
+            return audioClock + qMin(sinceCallback, MaxClockExtrapolation);
+        }
+
+        return wallNs / 1e9;
+    }
+
+    void VideoCompositor::setOutputSize(const QSize& size)
+    {
+        if (size.isEmpty() || size == canvas_.size()) {
+            return;
+        }
+
+        canvas_ = QImage(size, QImage::Format_ARGB32_Premultiplied);
+        canvas_.fill(0xFF000000);
+
+        for (Layer& layer : layers_) {
+            layer.sourceSize = QSize();
+        }
+    }
+
+    void VideoCompositor::setFrameRate(double fps)
+    {
+        frameRate_ = qBound(1.0, fps, 240.0);
+        timer_->setInterval(qMax(1, static_cast<int>(1000.0 / frameRate_)));
+    }
+
+    void VideoCompositor::setAutoRender(bool enabled)
+    {
+        autoRender_ = enabled;
+        updateTimer();
+    }
+
+    void VideoCompositor::addOutput(VideoOutput* output)
+    {
+        if (output && !outputs_.contains(output)) {
+            outputs_.append(output);
+        }
+    }
+
+    void VideoCompositor::removeOutput(VideoOutput* output)
+    {
+        outputs_.removeAll(output);
+    }
+
+    // ============================================================================
+    // Layers
+    // ============================================================================
+
+    int VideoCompositor::addLayer(VideoPlayback* playback, const QVariantMap& geometry, double opacity)
+    {
+        if (!playback) {
+            return -1;
+        }
+
+        const bool wasEmpty = layers_.isEmpty();
+        const int id = nextLayerId_++;
+
+        Layer& layer = layers_[id];
+        layer.playback = playback;
+        layer.geometry = geometry;
+        layer.opacity = qBound(0.0, opacity, 1.0);
+
+        // A pre-rolled layer starts exactly at GO; one still opening starts
+        // when its first frame is ready rather than skipping ahead to catch up
+        if (playback->isPrerolled()) {
+            layer.clockStart = clockSeconds();
+            layer.started = true;
+        }
+
+        if (wasEmpty) {
+            updateTimer();
+            emit activeChanged(true);
+        }
+
+        return id;
+    }
+
+    void VideoCompositor::removeLayer(int layerId)
+    {
+        if (layers_.remove(layerId) == 0) {
+            return;
+        }
+
+        if (layers_.isEmpty()) {
+            // Present one black frame so outputs don't freeze on the last image
+            canvas_.fill(0xFF000000);
+            const double now = clockSeconds();
+            for (VideoOutput* output : std::as_const(outputs_)) {
+                output->present(canvas_, now);
+            }
+            updateTimer();
+            emit activeChanged(false);
+        }
+    }
+
+    void VideoCompositor::setLayerGeometry(int layerId, const QVariantMap& geometry)
+    {
+        auto it = layers_.find(layerId);
+        if (it != layers_.end()) {
+            it->geometry = geometry;
+            it->sourceSize = QSize();
+        }
+    }
+
+    void VideoCompositor::fadeLayer(int layerId, double targetOpacity, double seconds)
+    {
+        auto it = layers_.find(layerId);
+        if (it == layers_.end()) {
+            return;
+        }
+
+        targetOpacity = qBound(0.0, targetOpacity, 1.0);
+
+        if (seconds <= 0.0) {
+            it->opacity = targetOpacity;
+            it->fading = false;
+            return;
+        }
+
+        it->fadeFrom = it->opacity;
+        it->fadeTo = targetOpacity;
+        it->fadeStart = clockSeconds();
+        it->fadeDuration = seconds;
+        it->fading = true;
+    }
+
+    double VideoCompositor::layerOpacity(int layerId) const
+    {
+        auto it = layers_.constFind(layerId);
+        return it != layers_.constEnd() ? it->opacity : 0.0;
+    }
+
+    void VideoCompositor::pauseLayer(int layerId)
+    {
+        auto it = layers_.find(layerId);
+        if (it != layers_.end() && !it->paused) {
+            it->paused = true;
+            it->pausedAt = clockSeconds();
+        }
+    }
+
+    void VideoCompositor::resumeLayer(int layerId)
+    {
+        auto it = layers_.find(layerId);
+        if (it != layers_.end() && it->paused) {
+            const double pausedFor = clockSeconds() - it->pausedAt;
+            it->clockStart += pausedFor;
+            it->fadeStart += pausedFor;
+            it->paused = false;
+        }
+    }
+
+    double VideoCompositor::layerMediaTime(int layerId)
+    {
+        auto it = layers_.constFind(layerId);
+        if (it == layers_.constEnd()) {
+            return 0.0;
+        }
+        return mediaTime(*it, clockSeconds());
+    }
+
+    double VideoCompositor::mediaTime(const Layer& layer, double now) const
+    {
+        const double start = layer.playback ? layer.playback->startTime() : 0.0;
+        if (!layer.started) {
+            return start;
+        }
+
+        const double reference = layer.paused ? layer.pausedAt : now;
+        return start + qMax(0.0, reference - layer.clockStart);
+    }
+
+    // ============================================================================
+    // Rendering
+    // ============================================================================
+
+    void VideoCompositor::renderFrame()
+    {
+        const double now = clockSeconds();
+
+        canvas_.fill(0xFF000000);
+        finishedScratch_.clear();
+        fadedScratch_.clear();
+
+        for (auto it = layers_.begin(); it != layers_.end(); ++it) {
+            Layer& layer = it.value();
+
+            if (!layer.playback) {
+                if (!layer.finished) {
+                    layer.finished = true;
+                    finishedScratch_.append(it.key());
+                }
+                continue;
+            }
+
+            if (!layer.started) {
+                if (layer.playback->isPrerolled()) {
+                    layer.clockStart = now;
+                    layer.started = true;
+                }
+                else if (layer.playback->isFailed() && !layer.finished) {
+                    layer.finished = true;
+                    finishedScratch_.append(it.key());
+                    continue;
+                }
+                else {
+                    continue;
+                }
+            }
+
+            if (layer.fading && !layer.paused) {
+                const double t = qBound(0.0, (now - layer.fadeStart) / layer.fadeDuration, 1.0);
+                layer.opacity = layer.fadeFrom + (layer.fadeTo - layer.fadeFrom) * t;
+                if (t >= 1.0) {
+                    layer.fading = false;
+                    fadedScratch_.append(it.key());
+                }
+            }
+
+            const double media = mediaTime(layer, now);
+            const VideoFrame* frame = layer.playback->frameAt(media);
+
+            if (frame) {
+                const QSize frameSize(frame->width, frame->height);
+                if (frameSize != layer.sourceSize) {
+                    layer.sourceSize = frameSize;
+                    layer.target = resolveGeometry(layer.geometry, frameSize, canvas_.size());
+                }
+
+                VideoBlend::blendFrame(canvas_.bits(), static_cast<int>(canvas_.bytesPerLine()),
+                    canvas_.width(), canvas_.height(), *frame, layer.target, layer.opacity, blendScratch_);
+            }
+
+            if (!layer.paused && !layer.finished && layer.playback->isFinished(media)) {
+                layer.finished = true;
+                finishedScratch_.append(it.key());
+            }
+        }
+
+        for (VideoOutput* output : std::as_const(outputs_)) {
+            output->present(canvas_, now);
+        }
+
+        // Signal after presenting - handlers typically remove layers
+        for (int layerId : std::as_const(fadedScratch_)) {
+            emit fadeFinished(layerId);
+        }
+        for (int layerId : std::as_const(finishedScratch_)) {
+            emit layerFinished(layerId);
+        }
+    }
+
+    void VideoCompositor::updateTimer()
+    {
+        const bool run = autoRender_ && !layers_.isEmpty();
+        if (run && !timer_->isActive()) {
+            timer_->start();
+        }
+        else if (!run && timer_->isActive()) {
+            timer_->stop();
+        }
+    }
+
+    QRect VideoCompositor::resolveGeometry(const QVariantMap& geometry, const QSize& source, const QSize& canvas)
+    {
+        QRectF box(0, 0, canvas.width(), canvas.height());
+        if (geometry.contains("width") && geometry.contains("height")) {
+            box = QRectF(geometry.value("x").toDouble(), geometry.value("y").toDouble(),
+                geometry.value("width").toDouble(), geometry.value("height").toDouble());
+        }
+        else if (geometry.contains("x") || geometry.contains("y")) {
+            box.translate(geometry.value("x").toDouble(), geometry.value("y").toDouble());
+        }
+
+        if (source.isEmpty() || box.isEmpty()) {
+            return QRect();
+        }
+
+        const QString mode = geometry.value("mode", "fit").toString();
+        const double scale = geometry.value("scale", 1.0).toDouble();
+
+        QSizeF size;
+        if (mode == "stretch") {
+            size = box.size();
+        }
+        else {
+            const double sx = box.width() / source.width();
+            const double sy = box.height() / source.height();
+            const double factor = (mode == "fill") ? qMax(sx, sy) : qMin(sx, sy);
+            size = QSizeF(source.width() * factor, source.height() * factor);
+        }
+        size *= scale;
+
+        const QPointF topLeft(box.center().x() - size.width() / 2.0, box.center().y() - size.height() / 2.0);
+        return QRect(qRound(topLeft.x()), qRound(topLeft.y()), qRound(size.width()), qRound(size.height()));
+    }
+
+} // namespace CueForge
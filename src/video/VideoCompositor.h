@@ -0,0 +1,136 @@
+// ============================================================================
+// VideoCompositor.h - Audio-clocked compositing of active video cues
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#pragma once
+
+#include "VideoBlend.h"
+#include <QObject>
+#include <QImage>
+#include <QMap>
+#include <QList>
+#include <QPointer>
+#include <QVariantMap>
+#include <QElapsedTimer>
+#include <functional>
+
+QT_BEGIN_NAMESPACE
+class QTimer;
+QT_END_NAMESPACE
+
+namespace CueForge {
+
+    class AudioEngineQt;
+    class VideoPlayback;
+    class VideoOutput;
+
+    /**
+     * Owns the output canvas and the list of playing video layers.
+     *
+     * Every tick reads the master clock (the audio engine's rendered-sample
+     * count, interpolated between callbacks), asks each layer's playback
+     * for the frame due at its media time, applies geometry and opacity
+     * fades, blends the layers in GO order and hands the canvas to every
+     * registered output. Nothing here allocates per frame.
+     */
+    class VideoCompositor : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        using Clock = std::function<double()>;
+
+        explicit VideoCompositor(QObject* parent = nullptr);
+        ~VideoCompositor() override;
+
+        // Master clock: the audio engine when set, else a monotonic timer.
+        // setClock() overrides both (headless tests, external sync).
+        void setAudioEngine(AudioEngineQt* engine);
+        void setClock(Clock clock);
+        double clockSeconds();
+
+        void setOutputSize(const QSize& size);
+        QSize outputSize() const { return canvas_.size(); }
+
+        void setFrameRate(double fps);
+        double frameRate() const { return frameRate_; }
+
+        // Disable to drive renderFrame() manually (offscreen tests)
+        void setAutoRender(bool enabled);
+
+        void addOutput(VideoOutput* output);
+        void removeOutput(VideoOutput* output);
+
+        // Layers - playback is not owned; it must stay alive until removed
+        int addLayer(VideoPlayback* playback, const QVariantMap& geometry, double opacity);
+        void removeLayer(int layerId);
+        bool hasLayer(int layerId) const { return layers_.contains(layerId); }
+        int layerCount() const { return layers_.size(); }
+
+        void setLayerGeometry(int layerId, const QVariantMap& geometry);
+        void fadeLayer(int layerId, double targetOpacity, double seconds);
+        double layerOpacity(int layerId) const;
+        void pauseLayer(int layerId);
+        void resumeLayer(int layerId);
+        double layerMediaTime(int layerId);
+
+        // Composite and present one frame at the current clock
+        void renderFrame();
+
+        const QImage& canvas() const { return canvas_; }
+
+        // Geometry keys: x, y, width, height (canvas pixels), mode
+        // ("fit", "fill", "stretch") and scale. Missing box = whole canvas.
+        static QRect resolveGeometry(const QVariantMap& geometry, const QSize& source, const QSize& canvas);
+
+    signals:
+        void layerFinished(int layerId);
+        void fadeFinished(int layerId);
+        void activeChanged(bool active);
+
+    private:
+        struct Layer {
+            QPointer<VideoPlayback> playback;
+            QVariantMap geometry;
+            QRect target;
+            QSize sourceSize;
+
+            double opacity = 1.0;
+            double fadeFrom = 1.0;
+            double fadeTo = 1.0;
+            double fadeStart = 0.0;
+            double fadeDuration = 0.0;
+            bool fading = false;
+
+            double clockStart = 0.0;
+            double pausedAt = 0.0;
+            bool started = false;
+            bool paused = false;
+            bool finished = false;
+        };
+
+        double mediaTime(const Layer& layer, double now) const;
+        void updateTimer();
+
+        QPointer<AudioEngineQt> audioEngine_;
+        Clock clock_;
+        QElapsedTimer wallClock_;
+        double lastAudioClock_;
+        qint64 lastAudioClockWallNs_;
+
+        QImage canvas_;
+        QTimer* timer_;
+        double frameRate_;
+        bool autoRender_;
+
+        QMap<int, Layer> layers_;
+        int nextLayerId_;
+        QList<VideoOutput*> outputs_;
+
+        QList<int> finishedScratch_;
+        QList<int> fadedScratch_;
+        VideoBlend::Scratch blendScratch_;
+    };
+
+} // namespace CueForge
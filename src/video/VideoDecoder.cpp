@@ -0,0 +1,431 @@
+// ============================================================================
+// VideoDecoder.cpp - Pattern and Qt Multimedia decoder implementations
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#include "VideoDecoder.h"
+#include "VideoFramePool.h"
+#include <QRegularExpression>
+#include <QDebug>
+#include <cmath>
+#include <cstring>
+
+#ifdef HAVE_MULTIMEDIA
+#include <QMediaPlayer>
+#include <QMediaMetaData>
+#include <QVideoSink>
+#include <QVideoFrame>
+#include <QVideoFrameFormat>
+#include <QImage>
+#include <QEventLoop>
+#include <QTimer>
+#include <QUrl>
+#include <deque>
+#endif
+
+namespace CueForge {
+
+    namespace {
+
+        const QRegularExpression PatternRegex(
+            QStringLiteral("^pattern:(\\d+)x(\\d+)@([0-9.]+):([0-9.]+)$"));
+
+        /**
+         * Synthetic source: scrolling colour bars with the frame index
+         * encoded in the first pixel (blue = low byte, green = high byte),
+         * so headless tests can check exactly which frame was presented.
+         */
+        class PatternVideoDecoder : public VideoDecoder
+        {
+        public:
+            bool open(const QString& path) override
+            {
+                const QRegularExpressionMatch match = PatternRegex.match(path);
+                if (!match.hasMatch()) {
+                    return false;
+                }
+
+                info_.width = qBound(16, match.captured(1).toInt(), 8192);
+                info_.height = qBound(16, match.captured(2).toInt(), 8192);
+                info_.frameRate = qBound(1.0, match.captured(3).toDouble(), 240.0);
+                info_.duration = qMax(0.0, match.captured(4).toDouble());
+                info_.codec = "pattern";
+                frameCount_ = static_cast<qint64>(std::floor(info_.duration * info_.frameRate));
+                nextFrame_ = 0;
+                return true;
+            }
+
+            VideoStreamInfo info() const override { return info_; }
+
+            bool seek(double seconds) override
+            {
+                nextFrame_ = qBound<qint64>(0, static_cast<qint64>(std::ceil(seconds * info_.frameRate - 1e-6)), frameCount_);
+                return true;
+            }
+
+            bool readFrame(VideoFrame& frame) override
+            {
+                if (nextFrame_ >= frameCount_) {
+                    return false;
+                }
+
+                static const quint32 Bars[8] = {
+                    0xFFC0C0C0, 0xFFC0C000, 0xFF00C0C0, 0xFF00C000,
+                    0xFFC000C0, 0xFFC00000, 0xFF0000C0, 0xFF101010
+                };
+
+                const int width = qMin(frame.width, info_.width);
+                const int height = qMin(frame.height, info_.height);
+                const int shift = static_cast<int>(nextFrame_ % 8);
+
+                for (int y = 0; y < height; ++y) {
+                    quint32* row = reinterpret_cast<quint32*>(frame.bits + y * frame.stride);
+                    for (int x = 0; x < width; ++x) {
+                        row[x] = Bars[((x * 8) / width + shift) & 7];
+                    }
+                }
+
+                quint32* first = reinterpret_cast<quint32*>(frame.bits);
+                first[0] = 0xFF000000u | static_cast<quint32>(nextFrame_ & 0xFFFF);
+
+                frame.pts = static_cast<double>(nextFrame_) / info_.frameRate;
+                nextFrame_++;
+                return true;
+            }
+
+        private:
+            VideoStreamInfo info_;
+            qint64 frameCount_ = 0;
+            qint64 nextFrame_ = 0;
+        };
+
+#ifdef HAVE_MULTIMEDIA
+
+        // Integer YUV -> RGB, 8.8 fixed point: R = Y' + rv*V, G = Y' - gu*U - gv*V,
+        // B = Y' + bu*U, with Y' = (Y - yOffset) * yScale
+        struct YuvMatrix {
+            int yOffset, yScale, rv, gu, gv, bu;
+        };
+
+        constexpr YuvMatrix Bt601Video{ 16, 298, 409, 100, 208, 516 };
+        constexpr YuvMatrix Bt601Full{ 0, 256, 359, 88, 183, 454 };
+        constexpr YuvMatrix Bt709Video{ 16, 298, 459, 55, 136, 541 };
+        constexpr YuvMatrix Bt709Full{ 0, 256, 403, 48, 120, 475 };
+
+        YuvMatrix yuvMatrix(const QVideoFrameFormat& format)
+        {
+            // Untagged streams follow the usual convention: HD is BT.709
+            bool bt709 = format.frameHeight() >= 720;
+            if (format.colorSpace() == QVideoFrameFormat::ColorSpace_BT601) {
+                bt709 = false;
+            }
+            else if (format.colorSpace() == QVideoFrameFormat::ColorSpace_BT709) {
+                bt709 = true;
+            }
+
+            const bool full = format.colorRange() == QVideoFrameFormat::ColorRange_Full;
+            return bt709 ? (full ? Bt709Full : Bt709Video) : (full ? Bt601Full : Bt601Video);
+        }
+
+        inline quint32 yuvToArgb(int y, int u, int v, const YuvMatrix& m)
+        {
+            const int luma = (y - m.yOffset) * m.yScale + 128;
+            const int d = u - 128;
+            const int e = v - 128;
+            const int r = qBound(0, (luma + m.rv * e) >> 8, 255);
+            const int g = qBound(0, (luma - m.gu * d - m.gv * e) >> 8, 255);
+            const int b = qBound(0, (luma + m.bu * d) >> 8, 255);
+            return 0xFF000000u | (static_cast<quint32>(r) << 16) | (static_cast<quint32>(g) << 8)
+                | static_cast<quint32>(b);
+        }
+
+        // 4:2:0 with separate or interleaved chroma; chromaStep is the byte
+        // distance between chroma samples (1 planar, 2 interleaved)
+        void convertYuv420(const uchar* yPlane, int yStride, const uchar* uPlane, const uchar* vPlane,
+            int chromaStride, int chromaStep, int width, int height, const YuvMatrix& matrix, VideoFrame& frame)
+        {
+            for (int y = 0; y < height; ++y) {
+                const uchar* luma = yPlane + y * yStride;
+                const uchar* u = uPlane + (y / 2) * chromaStride;
+                const uchar* v = vPlane + (y / 2) * chromaStride;
+                quint32* row = reinterpret_cast<quint32*>(frame.bits + y * frame.stride);
+                for (int x = 0; x < width; ++x) {
+                    const int c = (x / 2) * chromaStep;
+                    row[x] = yuvToArgb(luma[x], u[c], v[c], matrix);
+                }
+            }
+        }
+
+        /**
+         * Converts a QVideoFrame into a pooled frame straight from its mapped
+         * planes, without an intermediate QImage. Covers the formats decoders
+         * actually hand out; returns false for anything else.
+         */
+        bool convertMapped(QVideoFrame& source, VideoFrame& frame)
+        {
+            const QVideoFrameFormat::PixelFormat format = source.pixelFormat();
+            switch (format) {
+            case QVideoFrameFormat::Format_BGRA8888:
+            case QVideoFrameFormat::Format_BGRA8888_Premultiplied:
+            case QVideoFrameFormat::Format_BGRX8888:
+            case QVideoFrameFormat::Format_RGBA8888:
+            case QVideoFrameFormat::Format_RGBX8888:
+            case QVideoFrameFormat::Format_NV12:
+            case QVideoFrameFormat::Format_NV21:
+            case QVideoFrameFormat::Format_YUV420P:
+            case QVideoFrameFormat::Format_YV12:
+                break;
+            default:
+                return false;
+            }
+
+            if (!source.map(QVideoFrame::ReadOnly)) {
+                return false;
+            }
+
+            const int width = qMin(frame.width, source.width());
+            const int height = qMin(frame.height, source.height());
+
+            switch (format) {
+            case QVideoFrameFormat::Format_BGRA8888:
+            case QVideoFrameFormat::Format_BGRA8888_Premultiplied:
+            case QVideoFrameFormat::Format_BGRX8888:
+                // Already ARGB32 in memory. Decoded video is opaque, so
+                // straight and premultiplied alpha are the same pixels.
+                for (int y = 0; y < height; ++y) {
+                    const uchar* in = source.bits(0) + y * source.bytesPerLine(0);
+                    quint32* row = reinterpret_cast<quint32*>(frame.bits + y * frame.stride);
+                    std::memcpy(row, in, static_cast<size_t>(width) * 4);
+                    if (format == QVideoFrameFormat::Format_BGRX8888) {
+                        for (int x = 0; x < width; ++x) {
+                            row[x] |= 0xFF000000u;
+                        }
+                    }
+                }
+                break;
+            case QVideoFrameFormat::Format_RGBA8888:
+            case QVideoFrameFormat::Format_RGBX8888:
+                for (int y = 0; y < height; ++y) {
+                    const uchar* in = source.bits(0) + y * source.bytesPerLine(0);
+                    quint32* row = reinterpret_cast<quint32*>(frame.bits + y * frame.stride);
+                    for (int x = 0; x < width; ++x, in += 4) {
+                        row[x] = 0xFF000000u | (static_cast<quint32>(in[0]) << 16)
+                            | (static_cast<quint32>(in[1]) << 8) | in[2];
+                    }
+                }
+                break;
+            case QVideoFrameFormat::Format_NV12:
+            case QVideoFrameFormat::Format_NV21: {
+                const uchar* chroma = source.bits(1);
+                const bool nv12 = format == QVideoFrameFormat::Format_NV12;
+                convertYuv420(source.bits(0), source.bytesPerLine(0), nv12 ? chroma : chroma + 1,
+                    nv12 ? chroma + 1 : chroma, source.bytesPerLine(1), 2, width, height,
+                    yuvMatrix(source.surfaceFormat()), frame);
+                break;
+            }
+            default: {
+                const bool yv12 = format == QVideoFrameFormat::Format_YV12;
+                convertYuv420(source.bits(0), source.bytesPerLine(0), source.bits(yv12 ? 2 : 1),
+                    source.bits(yv12 ? 1 : 2), source.bytesPerLine(1), 1, width, height,
+                    yuvMatrix(source.surfaceFormat()), frame);
+                break;
+            }
+            }
+
+            source.unmap();
+            return true;
+        }
+
+        /**
+         * Qt Multimedia backed decoder. QMediaPlayer is push-based and runs
+         * in real time, so frames from the sink are buffered in a short queue
+         * and the player is paused when the queue is full - the frame pool
+         * then provides the backpressure all the way to the demuxer.
+         * Lives entirely on the decode thread, which spins local event loops
+         * while waiting for the player.
+         */
+        class MediaVideoDecoder : public VideoDecoder
+        {
+        public:
+            MediaVideoDecoder()
+                : player_(new QMediaPlayer)
+                , sink_(new QVideoSink)
+                , atEnd_(false)
+            {
+                player_->setVideoOutput(sink_.get());
+
+                QObject::connect(sink_.get(), &QVideoSink::videoFrameChanged, sink_.get(),
+                    [this](const QVideoFrame& frame) {
+                        if (!frame.isValid()) {
+                            return;
+                        }
+                        pending_.push_back(frame);
+                        if (pending_.size() >= MaxPending) {
+                            player_->pause();
+                        }
+                    });
+
+                QObject::connect(player_.get(), &QMediaPlayer::mediaStatusChanged, player_.get(),
+                    [this](QMediaPlayer::MediaStatus status) {
+                        if (status == QMediaPlayer::EndOfMedia) {
+                            atEnd_ = true;
+                        }
+                    });
+            }
+
+            ~MediaVideoDecoder() override
+            {
+                player_->stop();
+            }
+
+            bool open(const QString& path) override
+            {
+                player_->setSource(QUrl::fromLocalFile(path));
+
+                if (!waitFor([this]() {
+                        auto status = player_->mediaStatus();
+                        return status == QMediaPlayer::LoadedMedia
+                            || status == QMediaPlayer::InvalidMedia;
+                    }, OpenTimeoutMs)
+                    || player_->mediaStatus() == QMediaPlayer::InvalidMedia
+                    || !player_->hasVideo()) {
+                    error_ = player_->errorString().isEmpty() ? "No video stream" : player_->errorString();
+                    return false;
+                }
+
+                const QMediaMetaData meta = player_->metaData();
+                const QSize resolution = meta.value(QMediaMetaData::Resolution).toSize();
+                info_.width = resolution.width();
+                info_.height = resolution.height();
+                info_.frameRate = meta.value(QMediaMetaData::VideoFrameRate).toDouble();
+                info_.duration = player_->duration() / 1000.0;
+                info_.codec = meta.stringValue(QMediaMetaData::VideoCodec);
+                info_.hasAudio = player_->hasAudio();
+
+                if (info_.frameRate <= 0.0) {
+                    info_.frameRate = 30.0;
+                }
+
+                // Resolution metadata is optional - take it from the first frame
+                if (info_.width <= 0 || info_.height <= 0) {
+                    player_->play();
+                    waitFor([this]() { return !pending_.empty() || atEnd_; }, OpenTimeoutMs);
+                    player_->pause();
+                    if (pending_.empty()) {
+                        error_ = "No decodable frames";
+                        return false;
+                    }
+                    info_.width = pending_.front().width();
+                    info_.height = pending_.front().height();
+                }
+
+                return true;
+            }
+
+            VideoStreamInfo info() const override { return info_; }
+
+            bool seek(double seconds) override
+            {
+                pending_.clear();
+                atEnd_ = false;
+                player_->setPosition(static_cast<qint64>(seconds * 1000.0));
+                return true;
+            }
+
+            bool readFrame(VideoFrame& frame) override
+            {
+                if (pending_.empty()) {
+                    if (atEnd_) {
+                        return false;
+                    }
+                    player_->play();
+                    if (!waitFor([this]() { return !pending_.empty() || atEnd_; }, FrameTimeoutMs)
+                        || pending_.empty()) {
+                        return false;
+                    }
+                }
+
+                QVideoFrame videoFrame = pending_.front();
+                pending_.pop_front();
+
+                if (pending_.size() < MaxPending / 2 && !atEnd_
+                    && player_->playbackState() != QMediaPlayer::PlayingState) {
+                    player_->play();
+                }
+
+                // Qt Multimedia hands out its own buffers; convert straight
+                // from them into ours. Only unusual formats take the slow
+                // path through a QImage, allocated per frame.
+                if (!convertMapped(videoFrame, frame)) {
+                    QImage image = videoFrame.toImage();
+                    if (image.format() != QImage::Format_ARGB32_Premultiplied) {
+                        image.convertTo(QImage::Format_ARGB32_Premultiplied);
+                    }
+
+                    const int rows = qMin(frame.height, image.height());
+                    const int bytes = qMin(frame.width, image.width()) * 4;
+                    for (int y = 0; y < rows; ++y) {
+                        std::memcpy(frame.bits + y * frame.stride, image.constScanLine(y), bytes);
+                    }
+                }
+
+                frame.pts = videoFrame.startTime() / 1000000.0;
+                return true;
+            }
+
+            QString errorString() const override { return error_; }
+
+        private:
+            static constexpr size_t MaxPending = 4;
+            static constexpr int OpenTimeoutMs = 5000;
+            static constexpr int FrameTimeoutMs = 1000;
+
+            template<typename Predicate>
+            bool waitFor(Predicate done, int timeoutMs)
+            {
+                QEventLoop loop;
+                QTimer timeout;
+                timeout.setSingleShot(true);
+                QObject::connect(&timeout, &QTimer::timeout, &loop, &QEventLoop::quit);
+                QObject::connect(sink_.get(), &QVideoSink::videoFrameChanged, &loop, &QEventLoop::quit);
+                QObject::connect(player_.get(), &QMediaPlayer::mediaStatusChanged, &loop, &QEventLoop::quit);
+                timeout.start(timeoutMs);
+
+                while (!done() && timeout.isActive()) {
+                    loop.exec();
+                }
+                return done();
+            }
+
+            std::unique_ptr<QMediaPlayer> player_;
+            std::unique_ptr<QVideoSink> sink_;
+            std::deque<QVideoFrame> pending_;
+            VideoStreamInfo info_;
+            QString error_;
+            bool atEnd_;
+        };
+
+#endif // HAVE_MULTIMEDIA
+
+    } // namespace
+
+    bool VideoDecoder::isPatternSource(const QString& path)
+    {
+        return PatternRegex.match(path).hasMatch();
+    }
+
+    std::unique_ptr<VideoDecoder> VideoDecoder::create(const QString& path)
+    {
+        if (isPatternSource(path)) {
+            return std::make_unique<PatternVideoDecoder>();
+        }
+
+#ifdef HAVE_MULTIMEDIA
+        return std::make_unique<MediaVideoDecoder>();
+#else
+        qWarning() << "VideoDecoder: Built without Qt Multimedia, cannot decode" << path;
+        return nullptr;
+#endif
+    }
+
+} // namespace CueForge
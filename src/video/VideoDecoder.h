@@ -0,0 +1,49 @@
+// ============================================================================
+// VideoDecoder.h - Pull-style video decoder interface
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#pragma once
+
+#include <QString>
+#include <memory>
+
+namespace CueForge {
+
+    struct VideoFrame;
+
+    struct VideoStreamInfo {
+        int width = 0;
+        int height = 0;
+        double frameRate = 0.0;
+        double duration = 0.0;
+        QString codec;
+        bool hasAudio = false;
+    };
+
+    /**
+     * Decodes one video stream into caller-owned frames.
+     * All calls are made from the playback's decode thread.
+     */
+    class VideoDecoder
+    {
+    public:
+        virtual ~VideoDecoder() = default;
+
+        virtual bool open(const QString& path) = 0;
+        virtual VideoStreamInfo info() const = 0;
+        virtual bool seek(double seconds) = 0;
+
+        // Decode the next picture into frame (sized to info().width/height)
+        // and set its pts. Returns false at end of stream or on error.
+        virtual bool readFrame(VideoFrame& frame) = 0;
+
+        virtual QString errorString() const { return QString(); }
+
+        // "pattern:WxH@FPS:SECONDS" gives a synthetic test source; anything
+        // else is opened with Qt Multimedia when available
+        static std::unique_ptr<VideoDecoder> create(const QString& path);
+        static bool isPatternSource(const QString& path);
+    };
+
+} // namespace CueForge
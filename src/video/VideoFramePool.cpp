@@ -0,0 +1,138 @@
+// ============================================================================
+// VideoFramePool.cpp - Fixed set of recycled video frame buffers
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#include "VideoFramePool.h"
+#include <QMutexLocker>
+#include <cstring>
+
+namespace CueForge {
+
+    namespace {
+        constexpr int RowAlignment = 32;
+    }
+
+    VideoFramePool::VideoFramePool(int width, int height, int capacity)
+        : readyHead_(0)
+        , readyCount_(0)
+        , width_(width)
+        , height_(height)
+        , cancelled_(false)
+    {
+        capacity = qMax(2, capacity);
+        const int stride = ((width * 4) + RowAlignment - 1) & ~(RowAlignment - 1);
+
+        frames_.resize(capacity);
+        free_.reserve(capacity);
+        ready_.assign(capacity, nullptr);
+
+        for (VideoFrame& frame : frames_) {
+            frame.width = width;
+            frame.height = height;
+            frame.stride = stride;
+            frame.bits = static_cast<uchar*>(qMallocAligned(static_cast<size_t>(stride) * height, RowAlignment));
+            std::memset(frame.bits, 0, static_cast<size_t>(stride) * height);
+            free_.push_back(&frame);
+        }
+    }
+
+    VideoFramePool::~VideoFramePool()
+    {
+        for (VideoFrame& frame : frames_) {
+            qFreeAligned(frame.bits);
+        }
+    }
+
+    VideoFrame* VideoFramePool::acquire(int timeoutMs)
+    {
+        QMutexLocker locker(&mutex_);
+
+        while (free_.empty() && !cancelled_) {
+            if (!frameFreed_.wait(&mutex_, timeoutMs)) {
+                return nullptr;
+            }
+        }
+
+        if (cancelled_) {
+            return nullptr;
+        }
+
+        VideoFrame* frame = free_.back();
+        free_.pop_back();
+        return frame;
+    }
+
+    void VideoFramePool::publish(VideoFrame* frame)
+    {
+        QMutexLocker locker(&mutex_);
+
+        const int slot = (readyHead_ + readyCount_) % capacity();
+        ready_[slot] = frame;
+        readyCount_++;
+    }
+
+    void VideoFramePool::discard(VideoFrame* frame)
+    {
+        QMutexLocker locker(&mutex_);
+        free_.push_back(frame);
+        frameFreed_.wakeOne();
+    }
+
+    VideoFrame* VideoFramePool::peek(int index) const
+    {
+        QMutexLocker locker(&mutex_);
+
+        if (index < 0 || index >= readyCount_) {
+            return nullptr;
+        }
+        return ready_[(readyHead_ + index) % capacity()];
+    }
+
+    int VideoFramePool::readyCount() const
+    {
+        QMutexLocker locker(&mutex_);
+        return readyCount_;
+    }
+
+    void VideoFramePool::releaseFront()
+    {
+        QMutexLocker locker(&mutex_);
+
+        if (readyCount_ == 0) {
+            return;
+        }
+
+        free_.push_back(ready_[readyHead_]);
+        readyHead_ = (readyHead_ + 1) % capacity();
+        readyCount_--;
+        frameFreed_.wakeOne();
+    }
+
+    void VideoFramePool::flush()
+    {
+        QMutexLocker locker(&mutex_);
+
+        while (readyCount_ > 0) {
+            free_.push_back(ready_[readyHead_]);
+            readyHead_ = (readyHead_ + 1) % capacity();
+            readyCount_--;
+        }
+        readyHead_ = 0;
+        frameFreed_.wakeAll();
+    }
+
+    void VideoFramePool::cancel()
+    {
+        QMutexLocker locker(&mutex_);
+        cancelled_ = true;
+        frameFreed_.wakeAll();
+    }
+
+    void VideoFramePool::reset()
+    {
+        QMutexLocker locker(&mutex_);
+        cancelled_ = false;
+    }
+
+} // namespace CueForge
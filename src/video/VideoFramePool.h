@@ -0,0 +1,82 @@
+// ============================================================================
+// VideoFramePool.h - Fixed set of recycled video frame buffers
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#pragma once
+
+#include <QMutex>
+#include <QWaitCondition>
+#include <QtGlobal>
+#include <vector>
+
+namespace CueForge {
+
+    /**
+     * One decoded picture: premultiplied ARGB32, rows 32-byte aligned.
+     * Buffers belong to a VideoFramePool and are never freed while playing.
+     */
+    struct VideoFrame {
+        uchar* bits = nullptr;
+        int width = 0;
+        int height = 0;
+        int stride = 0;       // bytes per row
+        double pts = 0.0;     // presentation time in media seconds
+    };
+
+    /**
+     * All frame memory for one playback is allocated when the pool is
+     * created (at pre-roll); decoding and presentation only move pointers
+     * between the free list and the ready queue.
+     *
+     * The decode thread is the single producer and the UI thread the single
+     * consumer. A decoder that runs ahead blocks in acquire() until the
+     * presenter releases a frame, which bounds read-ahead to the pool size.
+     */
+    class VideoFramePool
+    {
+    public:
+        VideoFramePool(int width, int height, int capacity);
+        ~VideoFramePool();
+
+        VideoFramePool(const VideoFramePool&) = delete;
+        VideoFramePool& operator=(const VideoFramePool&) = delete;
+
+        int width() const { return width_; }
+        int height() const { return height_; }
+        int capacity() const { return static_cast<int>(frames_.size()); }
+
+        // Producer side: take a free frame (nullptr on timeout or cancel),
+        // then publish it once filled
+        VideoFrame* acquire(int timeoutMs);
+        void publish(VideoFrame* frame);
+        void discard(VideoFrame* frame);
+
+        // Consumer side: inspect / drop decoded frames in pts order
+        VideoFrame* peek(int index) const;
+        int readyCount() const;
+        void releaseFront();
+
+        // Return every frame to the free list (seek / stop)
+        void flush();
+
+        // Wake a blocked acquire() and make further calls return nullptr
+        void cancel();
+        void reset();
+
+    private:
+        std::vector<VideoFrame> frames_;
+        std::vector<VideoFrame*> free_;
+        std::vector<VideoFrame*> ready_;   // ring buffer, capacity slots
+        int readyHead_;
+        int readyCount_;
+
+        int width_;
+        int height_;
+
+        mutable QMutex mutex_;
+        QWaitCondition frameFreed_;
+        bool cancelled_;
+    };
+
+} // namespace CueForge
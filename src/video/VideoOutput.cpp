@@ -0,0 +1,109 @@
+// ============================================================================
+// VideoOutput.cpp - Destinations for the composited video canvas
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#include "VideoOutput.h"
+#include <QPainter>
+#include <QMutexLocker>
+#include <QDebug>
+#include <cstring>
+
+namespace CueForge {
+
+    namespace {
+
+        // Copy into dst without reallocating when the size is unchanged
+        void copyCanvas(QImage& dst, const QImage& src)
+        {
+            if (dst.size() != src.size() || dst.format() != src.format()) {
+                dst = QImage(src.size(), src.format());
+            }
+
+            const int bytes = qMin(dst.bytesPerLine(), src.bytesPerLine());
+            for (int y = 0; y < src.height(); ++y) {
+                std::memcpy(dst.scanLine(y), src.constScanLine(y), bytes);
+            }
+        }
+
+    } // namespace
+
+    // ============================================================================
+    // OffscreenVideoOutput
+    // ============================================================================
+
+    void OffscreenVideoOutput::present(const QImage& canvas, double clockSeconds)
+    {
+        QMutexLocker locker(&mutex_);
+        copyCanvas(frame_, canvas);
+        framesPresented_++;
+        lastClock_ = clockSeconds;
+    }
+
+    QImage OffscreenVideoOutput::lastFrame() const
+    {
+        QMutexLocker locker(&mutex_);
+        return frame_.copy();
+    }
+
+    quint32 OffscreenVideoOutput::pixel(int x, int y) const
+    {
+        QMutexLocker locker(&mutex_);
+        if (!frame_.valid(x, y)) {
+            return 0;
+        }
+        return reinterpret_cast<const quint32*>(frame_.constScanLine(y))[x];
+    }
+
+    bool OffscreenVideoOutput::saveLastFrame(const QString& path) const
+    {
+        QMutexLocker locker(&mutex_);
+        if (frame_.isNull()) {
+            qWarning() << "OffscreenVideoOutput: No frame to save";
+            return false;
+        }
+        return frame_.save(path);
+    }
+
+    // ============================================================================
+    // VideoOutputWidget
+    // ============================================================================
+
+    VideoOutputWidget::VideoOutputWidget(QWidget* parent)
+        : QWidget(parent, Qt::Window)
+    {
+        setWindowTitle("CueForge Video");
+        setAttribute(Qt::WA_OpaquePaintEvent);
+        setAttribute(Qt::WA_NoSystemBackground);
+        resize(960, 540);
+    }
+
+    void VideoOutputWidget::present(const QImage& canvas, double clockSeconds)
+    {
+        Q_UNUSED(clockSeconds);
+        if (!isVisible()) {
+            return;
+        }
+
+        copyCanvas(frame_, canvas);
+        update();
+    }
+
+    void VideoOutputWidget::paintEvent(QPaintEvent* event)
+    {
+        Q_UNUSED(event);
+
+        QPainter painter(this);
+        painter.fillRect(rect(), Qt::black);
+
+        if (frame_.isNull()) {
+            return;
+        }
+
+        QSize scaled = frame_.size().scaled(size(), Qt::KeepAspectRatio);
+        QRect target(QPoint((width() - scaled.width()) / 2, (height() - scaled.height()) / 2), scaled);
+        painter.setRenderHint(QPainter::SmoothPixmapTransform);
+        painter.drawImage(target, frame_);
+    }
+
+} // namespace CueForge
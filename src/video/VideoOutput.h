@@ -0,0 +1,71 @@
+// ============================================================================
+// VideoOutput.h - Destinations for the composited video canvas
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#pragma once
+
+#include <QImage>
+#include <QString>
+#include <QWidget>
+#include <QMutex>
+
+namespace CueForge {
+
+    /**
+     * Receives each composited canvas. present() is called on the UI thread
+     * and must copy what it needs - the canvas is reused for the next frame.
+     */
+    class VideoOutput
+    {
+    public:
+        virtual ~VideoOutput() = default;
+        virtual void present(const QImage& canvas, double clockSeconds) = 0;
+    };
+
+    /**
+     * Headless output for tests and render checks: keeps the latest frame
+     * in a preallocated image and counts presentations.
+     */
+    class OffscreenVideoOutput : public VideoOutput
+    {
+    public:
+        OffscreenVideoOutput() = default;
+
+        void present(const QImage& canvas, double clockSeconds) override;
+
+        QImage lastFrame() const;
+        quint32 pixel(int x, int y) const;
+        quint64 framesPresented() const { return framesPresented_; }
+        double lastClock() const { return lastClock_; }
+
+        bool saveLastFrame(const QString& path) const;
+
+    private:
+        mutable QMutex mutex_;
+        QImage frame_;
+        quint64 framesPresented_ = 0;
+        double lastClock_ = 0.0;
+    };
+
+    /**
+     * Simple on-screen output: a frameless top-level window showing the
+     * canvas scaled to fit.
+     */
+    class VideoOutputWidget : public QWidget, public VideoOutput
+    {
+        Q_OBJECT
+
+    public:
+        explicit VideoOutputWidget(QWidget* parent = nullptr);
+
+        void present(const QImage& canvas, double clockSeconds) override;
+
+    protected:
+        void paintEvent(QPaintEvent* event) override;
+
+    private:
+        QImage frame_;
+    };
+
+} // namespace CueForge
@@ -0,0 +1,218 @@
+// ============================================================================
+// VideoPlayback.cpp - Background decode + frame queue for one video cue
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#include "VideoPlayback.h"
+#include "VideoFramePool.h"
+#include <QThread>
+#include <QMutexLocker>
+#include <QDebug>
+
+namespace CueForge {
+
+    namespace {
+        constexpr int AcquireTimeoutMs = 50;
+    }
+
+    VideoPlayback::VideoPlayback(QObject* parent)
+        : QObject(parent)
+        , startTime_(0.0)
+        , endTime_(0.0)
+        , loop_(false)
+        , poolFrames_(DefaultPoolFrames)
+        , thread_(nullptr)
+        , stopRequested_(false)
+        , prerolled_(false)
+        , failed_(false)
+        , decodeFinished_(false)
+        , lastShown_(nullptr)
+        , droppedFrames_(0)
+    {
+    }
+
+    VideoPlayback::~VideoPlayback()
+    {
+        release();
+    }
+
+    void VideoPlayback::preroll(const QString& path, double startTime, double endTime, bool loop, int poolFrames)
+    {
+        release();
+
+        path_ = path;
+        startTime_ = qMax(0.0, startTime);
+        endTime_ = qMax(0.0, endTime);
+        loop_ = loop;
+        poolFrames_ = qMax(PrerollFrames + 1, poolFrames);
+
+        stopRequested_ = false;
+        prerolled_ = false;
+        failed_ = false;
+        decodeFinished_ = false;
+        lastShown_ = nullptr;
+        droppedFrames_ = 0;
+
+        thread_ = QThread::create([this]() { decodeLoop(); });
+        thread_->setObjectName("VideoDecode");
+        thread_->start(QThread::HighPriority);
+    }
+
+    void VideoPlayback::release()
+    {
+        if (thread_) {
+            stopRequested_ = true;
+            {
+                QMutexLocker locker(&infoMutex_);
+                if (pool_) {
+                    pool_->cancel();
+                }
+            }
+            thread_->wait();
+            delete thread_;
+            thread_ = nullptr;
+        }
+
+        pool_.reset();
+        prerolled_ = false;
+        lastShown_ = nullptr;
+    }
+
+    VideoStreamInfo VideoPlayback::info() const
+    {
+        QMutexLocker locker(&infoMutex_);
+        return info_;
+    }
+
+    // ============================================================================
+    // Decode thread
+    // ============================================================================
+
+    void VideoPlayback::decodeLoop()
+    {
+        std::unique_ptr<VideoDecoder> decoder = VideoDecoder::create(path_);
+
+        if (!decoder || !decoder->open(path_)) {
+            const QString message = decoder ? decoder->errorString() : QString("No decoder available");
+            qWarning() << "VideoPlayback: Failed to open" << path_ << "-" << message;
+            failed_ = true;
+            QMetaObject::invokeMethod(this, [this, message]() {
+                emit decodeError(message);
+                emit prerolled(false);
+            }, Qt::QueuedConnection);
+            return;
+        }
+
+        const VideoStreamInfo streamInfo = decoder->info();
+        {
+            // All frame memory for this playback is allocated here, once
+            QMutexLocker locker(&infoMutex_);
+            info_ = streamInfo;
+            pool_ = std::make_unique<VideoFramePool>(streamInfo.width, streamInfo.height, poolFrames_);
+        }
+
+        const double outPoint = (endTime_ > startTime_) ? endTime_ : streamInfo.duration;
+        const double loopLength = outPoint - startTime_;
+        double ptsOffset = 0.0;
+        int queued = 0;
+
+        if (startTime_ > 0.0) {
+            decoder->seek(startTime_);
+        }
+
+        while (!stopRequested_) {
+            VideoFrame* frame = pool_->acquire(AcquireTimeoutMs);
+            if (!frame) {
+                continue;
+            }
+
+            bool ok = decoder->readFrame(*frame);
+            bool pastOut = ok && outPoint > 0.0 && frame->pts >= outPoint;
+
+            if ((!ok || pastOut) && loop_ && loopLength > 0.0 && queued > 0) {
+                decoder->seek(startTime_);
+                ptsOffset += loopLength;
+                ok = decoder->readFrame(*frame);
+                pastOut = false;
+            }
+
+            if (!ok || pastOut) {
+                pool_->discard(frame);
+                break;
+            }
+
+            frame->pts += ptsOffset;
+            pool_->publish(frame);
+            queued++;
+
+            if (!prerolled_ && queued >= PrerollFrames) {
+                prerolled_ = true;
+                QMetaObject::invokeMethod(this, [this]() { emit prerolled(true); }, Qt::QueuedConnection);
+            }
+        }
+
+        if (!prerolled_ && !stopRequested_) {
+            // Clips shorter than the pre-roll depth
+            prerolled_ = queued > 0;
+            failed_ = queued == 0;
+            const bool ok = queued > 0;
+            QMetaObject::invokeMethod(this, [this, ok]() { emit prerolled(ok); }, Qt::QueuedConnection);
+        }
+
+        decodeFinished_ = true;
+    }
+
+    // ============================================================================
+    // Presentation (UI thread)
+    // ============================================================================
+
+    const VideoFrame* VideoPlayback::frameAt(double mediaTime)
+    {
+        if (!isPrerolled() || !pool_) {
+            return lastShown_;
+        }
+
+        // Drop every frame whose successor is already due
+        VideoFrame* next = pool_->peek(1);
+        while (next && next->pts <= mediaTime) {
+            if (pool_->peek(0) != lastShown_) {
+                droppedFrames_++;
+            }
+            pool_->releaseFront();
+            next = pool_->peek(1);
+        }
+
+        VideoFrame* current = pool_->peek(0);
+        if (current && current->pts <= mediaTime) {
+            lastShown_ = current;
+        }
+
+        return lastShown_;
+    }
+
+    bool VideoPlayback::isFinished(double mediaTime) const
+    {
+        if (isFailed()) {
+            return true;
+        }
+
+        if (!decodeFinished_.load(std::memory_order_acquire) || !pool_) {
+            return false;
+        }
+
+        const int remaining = pool_->readyCount();
+        if (remaining > 1) {
+            return false;
+        }
+
+        VideoFrame* last = pool_->peek(0);
+        if (!last) {
+            return true;
+        }
+
+        const double frameRate = info().frameRate;
+        const double frameDuration = frameRate > 0.0 ? 1.0 / frameRate : 0.04;
+        return mediaTime >= last->pts + frameDuration;
+    }
+
+} // namespace CueForge
@@ -0,0 +1,94 @@
+// ============================================================================
+// VideoPlayback.h - Background decode + frame queue for one video cue
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#pragma once
+
+#include "VideoDecoder.h"
+#include <QObject>
+#include <QString>
+#include <QMutex>
+#include <atomic>
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+class QThread;
+QT_END_NAMESPACE
+
+namespace CueForge {
+
+    class VideoFramePool;
+    struct VideoFrame;
+
+    /**
+     * Opens a decoder on its own thread, seeks to the in point and fills a
+     * VideoFramePool ahead of playback. Arming a video cue pre-rolls one of
+     * these so GO only has to start presenting.
+     *
+     * Presentation (frameAt) is called from the UI thread by the compositor
+     * with the current media time; frames that have become late are
+     * returned to the pool without being shown.
+     */
+    class VideoPlayback : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        explicit VideoPlayback(QObject* parent = nullptr);
+        ~VideoPlayback() override;
+
+        // Start decoding in the background; prerolled() fires once the first
+        // frames are queued (or with false if the file cannot be opened)
+        void preroll(const QString& path, double startTime, double endTime, bool loop,
+            int poolFrames = DefaultPoolFrames);
+        void release();
+
+        bool isPrerolled() const { return prerolled_.load(std::memory_order_acquire); }
+        bool isFailed() const { return failed_.load(std::memory_order_acquire); }
+        VideoStreamInfo info() const;
+
+        QString path() const { return path_; }
+        double startTime() const { return startTime_; }
+        double endTime() const { return endTime_; }
+        bool loops() const { return loop_; }
+
+        // UI thread: frame to show at mediaTime (held until the next is due)
+        const VideoFrame* frameAt(double mediaTime);
+        bool isFinished(double mediaTime) const;
+
+        int droppedFrames() const { return droppedFrames_; }
+
+        static constexpr int DefaultPoolFrames = 8;
+        static constexpr int PrerollFrames = 3;
+
+    signals:
+        void prerolled(bool ok);
+        void decodeError(const QString& message);
+
+    private:
+        void decodeLoop();
+
+        QString path_;
+        double startTime_;
+        double endTime_;
+        bool loop_;
+        int poolFrames_;
+
+        QThread* thread_;
+        std::unique_ptr<VideoFramePool> pool_;
+
+        mutable QMutex infoMutex_;
+        VideoStreamInfo info_;
+
+        std::atomic<bool> stopRequested_;
+        std::atomic<bool> prerolled_;
+        std::atomic<bool> failed_;
+        std::atomic<bool> decodeFinished_;
+
+        // Presenter state (UI thread only)
+        const VideoFrame* lastShown_;
+        int droppedFrames_;
+    };
+
+} // namespace CueForge
@@ -0,0 +1,214 @@
+// ============================================================================
+// main.cpp - Show capacity planning: per-voice cost and peak callback load
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+//
+// Calibrates what each voice configuration (format, channels, resampling,
+// output width, fades) costs the audio callback on this machine, using the
+// null device, then lays a workspace out on a timeline and reports every
+// moment where the estimated callback load exceeds the budget.
+//
+//   cueforge-capacity --calibrate --profile host.json          Measure and save
+//   cueforge-capacity --profile host.json --workspace show.json
+//   cueforge-capacity --calibrate --cues 400 --go-interval 2  Generated show
+//
+// Exit code: 0 within budget, 1 over budget, 2 setup error.
+
+#include "core/CueManager.h"
+#include "core/ShowCapacity.h"
+#include "audio/VoiceCostModel.h"
+#include "common/ShowGenerator.h"
+#include <juce_events/juce_events.h>
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QFile>
+#include <QJsonDocument>
+#include <QTextStream>
+
+using namespace CueForge;
+
+namespace {
+
+    bool verboseLogging = false;
+
+    void capacityMessageHandler(QtMsgType type, const QMessageLogContext&, const QString& message)
+    {
+        // Loading a large workspace logs every cue
+        if (!verboseLogging && type != QtCriticalMsg && type != QtFatalMsg) {
+            return;
+        }
+        QTextStream(stderr) << message << Qt::endl;
+    }
+
+    QString formatSeconds(double seconds)
+    {
+        const int minutes = static_cast<int>(seconds / 60.0);
+        return QString("%1:%2").arg(minutes).arg(seconds - minutes * 60.0, 6, 'f', 3, QChar('0'));
+    }
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("cueforge-capacity");
+    juce::ScopedJuceInitialiser_GUI juceInit;
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Per-voice CPU cost calibration and show capacity estimate");
+    parser.addHelpOption();
+    parser.addOptions({
+        { "calibrate", "Measure voice costs on this host (saved to --profile if given)." },
+        { "profile", "Cost profile to load, or to write after --calibrate.", "file" },
+        { "rate", "Calibration sample rate (default 48000).", "hz", "48000" },
+        { "buffer", "Calibration buffer size (default 256).", "n", "256" },
+        { "voices", "Players per calibration measurement (default 8).", "n", "8" },
+        { "blocks", "Timed callbacks per measurement (default 400).", "n", "400" },
+        { "outputs", "Device outputs each voice is mixed into (default 2).", "n", "2" },
+        { "workspace", "Workspace file to plan.", "file" },
+        { "cues", "Plan a generated show of this size instead of a workspace.", "n" },
+        { "seed", "Generated show seed (default 1).", "n", "1" },
+        { "budget", "Allowed fraction of the block period, 0..1 (default 0.7).", "x", "0.7" },
+        { "go-interval", "Assumed seconds between operator GOs (default 10).", "s", "10" },
+        { "mean", "Plan against mean instead of p99 voice costs." },
+        { "json", "Write the report as JSON to this file.", "file" },
+        { "verbose", "Keep debug and warning output." },
+    });
+    parser.process(app);
+
+    verboseLogging = parser.isSet("verbose");
+    qInstallMessageHandler(capacityMessageHandler);
+
+    QTextStream out(stdout);
+    const int outputs = qBound(1, parser.value("outputs").toInt(), 64);
+
+    // ------------------------------------------------------------------------
+    // Cost model
+    // ------------------------------------------------------------------------
+    VoiceCostModel model;
+    std::string error;
+
+    if (parser.isSet("calibrate")) {
+        VoiceCostModel::CalibrationSettings settings;
+        settings.sampleRate = parser.value("rate").toDouble();
+        settings.bufferSize = parser.value("buffer").toInt();
+        settings.voices = parser.value("voices").toInt();
+        settings.blocks = parser.value("blocks").toInt();
+        settings.configs = VoiceCostModel::defaultConfigs(settings.sampleRate, outputs);
+
+        out << "Calibrating at " << settings.sampleRate << " Hz / " << settings.bufferSize
+            << " samples, " << settings.voices << " voices" << Qt::endl;
+        const bool calibrated = model.calibrate(settings, &error, [&out](const std::string& line) {
+            out << "  " << QString::fromStdString(line) << Qt::endl;
+        });
+        if (!calibrated) {
+            qCritical() << "Calibration failed:" << QString::fromStdString(error);
+            return 2;
+        }
+
+        if (parser.isSet("profile")) {
+            if (!model.save(parser.value("profile").toStdString(), &error)) {
+                qCritical() << QString::fromStdString(error);
+                return 2;
+            }
+            out << "Saved " << parser.value("profile") << Qt::endl;
+        }
+    }
+    else if (parser.isSet("profile")) {
+        if (!model.load(parser.value("profile").toStdString(), &error)) {
+            qCritical() << QString::fromStdString(error);
+            return 2;
+        }
+    }
+    else {
+        qCritical() << "Need --calibrate or --profile";
+        return 2;
+    }
+
+    out << QString("Block period %1 us, idle callback %2 us (p99 %3)")
+               .arg(model.blockPeriodUs(), 0, 'f', 1)
+               .arg(model.baseUs(), 0, 'f', 1)
+               .arg(model.baseUs(true), 0, 'f', 1) << Qt::endl;
+
+    if (!parser.isSet("workspace") && !parser.isSet("cues")) {
+        return 0;
+    }
+
+    // ------------------------------------------------------------------------
+    // Show
+    // ------------------------------------------------------------------------
+    QJsonObject workspace;
+    if (parser.isSet("workspace")) {
+        QFile file(parser.value("workspace"));
+        if (!file.open(QIODevice::ReadOnly)) {
+            qCritical() << "Cannot open" << file.fileName();
+            return 2;
+        }
+        workspace = QJsonDocument::fromJson(file.readAll()).object();
+    }
+    else {
+        ShowProfile profile;
+        profile.cues = qMax(10, parser.value("cues").toInt());
+        profile.seed = parser.value("seed").toUInt();
+        profile.assetDir = QDir::temp().filePath("cueforge-capacity-audio");
+
+        ShowGenerator generator(profile);
+        workspace = generator.generateWorkspace();
+        QString generateError;
+        if (!generator.writeAssets(&generateError)) {
+            qCritical() << generateError;
+            return 2;
+        }
+        out << "Generated " << generator.summary() << Qt::endl;
+    }
+
+    CueManager cueManager;
+    if (!cueManager.loadWorkspace(workspace) || cueManager.cueCount() == 0) {
+        qCritical() << "Workspace did not load";
+        return 2;
+    }
+
+    // ------------------------------------------------------------------------
+    // Estimate
+    // ------------------------------------------------------------------------
+    CapacitySettings settings;
+    settings.budget = qBound(0.05, parser.value("budget").toDouble(), 1.0);
+    settings.goIntervalSeconds = qMax(0.0, parser.value("go-interval").toDouble());
+    settings.outputs = outputs;
+    settings.peak = !parser.isSet("mean");
+
+    ShowCapacity capacity(model, settings);
+    const CapacityReport report = capacity.estimate(cueManager);
+
+    out << QString("Show %1, peak load %2% at %3 with %4 voices (budget %5%)")
+               .arg(formatSeconds(report.showSeconds))
+               .arg(report.peakLoad * 100.0, 0, 'f', 1)
+               .arg(formatSeconds(report.peakSeconds))
+               .arg(report.peakVoices)
+               .arg(settings.budget * 100.0, 0, 'f', 0) << Qt::endl;
+
+    for (const CapacityMoment& moment : report.overBudget) {
+        out << QString("  OVER %1 - %2  peak %3% (%4 us), %5 voices after GO %6: %7")
+                   .arg(formatSeconds(moment.startSeconds), formatSeconds(moment.endSeconds))
+                   .arg(moment.peakLoad * 100.0, 0, 'f', 1)
+                   .arg(moment.peakCostUs, 0, 'f', 0)
+                   .arg(moment.voices)
+                   .arg(moment.goCue, moment.cues.join(' ')) << Qt::endl;
+    }
+    for (const QString& warning : report.warnings) {
+        out << "  note: " << warning << Qt::endl;
+    }
+
+    if (parser.isSet("json")) {
+        QFile file(parser.value("json"));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            qCritical() << "Cannot write" << file.fileName();
+            return 2;
+        }
+        file.write(QJsonDocument(report.toJson()).toJson());
+    }
+
+    out << (report.withinBudget() ? "PASS" : "FAIL") << Qt::endl;
+    return report.withinBudget() ? 0 : 1;
+}
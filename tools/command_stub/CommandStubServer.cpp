@@ -0,0 +1,149 @@
+// ============================================================================
+// CommandStubServer.cpp - Local stand-in for TCP/HTTP show devices
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#include "CommandStubServer.h"
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QPointer>
+#include <QTimer>
+#include <QDebug>
+
+namespace CueForge {
+
+    CommandStubServer::CommandStubServer(QObject* parent)
+        : QObject(parent)
+        , server_(new QTcpServer(this))
+        , replyDelayMs_(0)
+        , closeEvery_(0)
+        , silent_(false)
+        , commandsReceived_(0)
+        , connectionsAccepted_(0)
+    {
+        connect(server_, &QTcpServer::newConnection, this, &CommandStubServer::onNewConnection);
+    }
+
+    bool CommandStubServer::listen(const QHostAddress& address, quint16 port)
+    {
+        if (!server_->listen(address, port)) {
+            qWarning() << "CommandStubServer: Failed to listen -" << server_->errorString();
+            return false;
+        }
+        return true;
+    }
+
+    quint16 CommandStubServer::serverPort() const
+    {
+        return server_->serverPort();
+    }
+
+    void CommandStubServer::onNewConnection()
+    {
+        while (QTcpSocket* socket = server_->nextPendingConnection()) {
+            connectionsAccepted_++;
+            socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+            buffers_.insert(socket, QByteArray());
+
+            connect(socket, &QTcpSocket::readyRead, this, [this, socket]() { onReadyRead(socket); });
+            connect(socket, &QTcpSocket::disconnected, this, [this, socket]() {
+                buffers_.remove(socket);
+                socket->deleteLater();
+            });
+        }
+    }
+
+    void CommandStubServer::onReadyRead(QTcpSocket* socket)
+    {
+        QByteArray& buffer = buffers_[socket];
+        buffer += socket->readAll();
+
+        const bool http = buffer.startsWith("GET ") || buffer.startsWith("POST ")
+            || buffer.startsWith("PUT ") || buffer.startsWith("DELETE ") || buffer.startsWith("PATCH ");
+
+        while (!buffer.isEmpty()) {
+            QByteArray command;
+            QByteArray response;
+
+            if (http) {
+                QByteArray body;
+                if (!takeHttpRequest(buffer, body)) {
+                    return;
+                }
+                command = body;
+                const QByteArray json = "{\"ok\":true,\"n\":" + QByteArray::number(commandsReceived_ + 1) + "}";
+                response = "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nContent-Length: "
+                    + QByteArray::number(json.size()) + "\r\nConnection: keep-alive\r\n\r\n" + json;
+            }
+            else {
+                const int end = buffer.indexOf('\n');
+                if (end < 0) {
+                    return;
+                }
+                command = buffer.left(end).trimmed();
+                buffer.remove(0, end + 1);
+                response = "ACK " + command + "\r\n";
+            }
+
+            commandsReceived_++;
+            emit commandReceived(command);
+
+            if (!silent_) {
+                reply(socket, response);
+            }
+
+            if (closeEvery_ > 0 && commandsReceived_ % closeEvery_ == 0) {
+                // Let the reply go out, then drop the client
+                QPointer<QTcpSocket> guard(socket);
+                QTimer::singleShot(replyDelayMs_ + 5, this, [guard]() {
+                    if (guard) {
+                        guard->disconnectFromHost();
+                    }
+                });
+                return;
+            }
+        }
+    }
+
+    bool CommandStubServer::takeHttpRequest(QByteArray& buffer, QByteArray& body)
+    {
+        const int headerEnd = buffer.indexOf("\r\n\r\n");
+        if (headerEnd < 0) {
+            return false;
+        }
+
+        qint64 contentLength = 0;
+        const QList<QByteArray> lines = buffer.left(headerEnd).split('\n');
+        for (const QByteArray& line : lines) {
+            const int colon = line.indexOf(':');
+            if (colon > 0 && line.left(colon).trimmed().toLower() == "content-length") {
+                contentLength = line.mid(colon + 1).trimmed().toLongLong();
+            }
+        }
+
+        const int total = headerEnd + 4 + static_cast<int>(contentLength);
+        if (buffer.size() < total) {
+            return false;
+        }
+
+        body = buffer.mid(headerEnd + 4, static_cast<int>(contentLength));
+        buffer.remove(0, total);
+        return true;
+    }
+
+    void CommandStubServer::reply(QTcpSocket* socket, const QByteArray& bytes)
+    {
+        if (replyDelayMs_ <= 0) {
+            socket->write(bytes);
+            return;
+        }
+
+        QPointer<QTcpSocket> guard(socket);
+        QTimer::singleShot(replyDelayMs_, this, [guard, bytes]() {
+            if (guard) {
+                guard->write(bytes);
+            }
+        });
+    }
+
+} // namespace CueForge
@@ -0,0 +1,63 @@
+// ============================================================================
+// CommandStubServer.h - Local stand-in for TCP/HTTP show devices
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#pragma once
+
+#include <QObject>
+#include <QHash>
+#include <QByteArray>
+#include <QHostAddress>
+
+QT_BEGIN_NAMESPACE
+class QTcpServer;
+class QTcpSocket;
+QT_END_NAMESPACE
+
+namespace CueForge {
+
+    /**
+     * Accepts device-style connections and answers like a simple device:
+     * - raw TCP: every line is answered with "ACK <line>\r\n"
+     * - HTTP/1.1: every request gets "200 OK" with a small JSON body
+     *
+     * Reply delay and periodic connection drops can be injected to check
+     * latency reporting and the pool's reconnect behaviour.
+     */
+    class CommandStubServer : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        explicit CommandStubServer(QObject* parent = nullptr);
+
+        bool listen(const QHostAddress& address = QHostAddress::LocalHost, quint16 port = 0);
+        quint16 serverPort() const;
+
+        void setReplyDelayMs(int ms) { replyDelayMs_ = ms; }
+        void setCloseEvery(int commands) { closeEvery_ = commands; }
+        void setSilent(bool silent) { silent_ = silent; }
+
+        int commandsReceived() const { return commandsReceived_; }
+        int connectionsAccepted() const { return connectionsAccepted_; }
+
+    signals:
+        void commandReceived(const QByteArray& command);
+
+    private:
+        void onNewConnection();
+        void onReadyRead(QTcpSocket* socket);
+        bool takeHttpRequest(QByteArray& buffer, QByteArray& body);
+        void reply(QTcpSocket* socket, const QByteArray& bytes);
+
+        QTcpServer* server_;
+        QHash<QTcpSocket*, QByteArray> buffers_;
+        int replyDelayMs_;
+        int closeEvery_;
+        bool silent_;
+        int commandsReceived_;
+        int connectionsAccepted_;
+    };
+
+} // namespace CueForge
@@ -0,0 +1,144 @@
+// ============================================================================
+// main.cpp - Network cue stub server and connection pool self-check
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+//
+// Without --serve, starts a stub on an ephemeral port and drives the real
+// ConnectionPool against it, printing per-command latency. Exits non-zero
+// if any command fails. With --serve, only runs the stub so a show file's
+// Network cues can be pointed at it.
+
+#include "CommandStubServer.h"
+#include "network/ConnectionPool.h"
+#include "common/LatencyStats.h"
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QTextStream>
+#include <QTimer>
+
+using namespace CueForge;
+
+namespace {
+
+    struct Run
+    {
+        NetworkCommand::Protocol protocol = NetworkCommand::Protocol::Tcp;
+        int remaining = 0;
+        int failures = 0;
+        LatencyStats latency;
+    };
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("cueforge-command-stub");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("TCP/HTTP device stub for CueForge network cues");
+    parser.addHelpOption();
+    parser.addOptions({
+        { "serve", "Run the stub server only." },
+        { "port", "Listen port for --serve (default 9099).", "port", "9099" },
+        { "count", "Commands per protocol in self-check (default 200).", "n", "200" },
+        { "delay", "Stub reply delay in milliseconds.", "ms", "0" },
+        { "close-every", "Stub drops the connection every N commands.", "n", "0" },
+    });
+    parser.process(app);
+
+    CommandStubServer stub;
+    stub.setReplyDelayMs(parser.value("delay").toInt());
+    stub.setCloseEvery(parser.value("close-every").toInt());
+
+    QTextStream out(stdout);
+
+    if (parser.isSet("serve")) {
+        if (!stub.listen(QHostAddress::Any, static_cast<quint16>(parser.value("port").toUInt()))) {
+            return 1;
+        }
+        out << "Stub listening on port " << stub.serverPort() << Qt::endl;
+        QObject::connect(&stub, &CommandStubServer::commandReceived, [&out](const QByteArray& command) {
+            out << "<- " << command << Qt::endl;
+        });
+        return app.exec();
+    }
+
+    if (!stub.listen()) {
+        return 1;
+    }
+
+    const quint16 port = stub.serverPort();
+    const int count = qMax(1, parser.value("count").toInt());
+
+    ConnectionPool pool;
+    Run runs[2];
+    runs[0].protocol = NetworkCommand::Protocol::Tcp;
+    runs[1].protocol = NetworkCommand::Protocol::Http;
+    int current = 0;
+    quint64 pendingId = 0;
+
+    auto sendNext = [&]() {
+        Run& run = runs[current];
+        NetworkCommand command;
+        command.protocol = run.protocol;
+        command.host = "127.0.0.1";
+        command.port = port;
+        command.timeoutMs = 1000;
+        if (run.protocol == NetworkCommand::Protocol::Tcp) {
+            command.payload = "GO " + QByteArray::number(count - run.remaining) + "\r\n";
+            command.expectReply = true;
+            command.replyTerminator = "\r\n";
+        }
+        else {
+            command.httpMethod = "POST";
+            command.httpPath = "/go";
+            command.contentType = "application/json";
+            command.payload = "{\"cue\":" + QByteArray::number(count - run.remaining) + "}";
+        }
+        pendingId = pool.send(command);
+    };
+
+    auto startRun = [&]() {
+        Run& run = runs[current];
+        run.remaining = count;
+        pool.warm(run.protocol, "127.0.0.1", port);
+        // Give the warm connect a moment so the numbers measure the hot path
+        QTimer::singleShot(100, &app, sendNext);
+    };
+
+    QObject::connect(&pool, &ConnectionPool::commandFinished, &app, [&](const NetworkCommandResult& result) {
+        if (result.id != pendingId) {
+            return;
+        }
+
+        Run& run = runs[current];
+        if (result.ok) {
+            run.latency.add(result.latencyMs);
+        }
+        else {
+            run.failures++;
+            out << "FAIL " << result.endpoint << ": " << result.error << Qt::endl;
+        }
+
+        if (--run.remaining > 0) {
+            sendNext();
+            return;
+        }
+
+        pool.release(run.protocol, "127.0.0.1", port);
+        if (++current < 2) {
+            startRun();
+            return;
+        }
+
+        out << "tcp   fail=" << runs[0].failures << "  " << runs[0].latency.summary() << Qt::endl;
+        out << "http  fail=" << runs[1].failures << "  " << runs[1].latency.summary() << Qt::endl;
+        out << "stub: " << stub.commandsReceived() << " commands over "
+            << stub.connectionsAccepted() << " connections" << Qt::endl;
+        app.exit(runs[0].failures + runs[1].failures == 0 ? 0 : 1);
+    });
+
+    startRun();
+    return app.exec();
+}
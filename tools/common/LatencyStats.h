@@ -0,0 +1,83 @@
+// ============================================================================
+// LatencyStats.h - Sample collection and percentiles for tool reports
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#pragma once
+
+#include <QString>
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+namespace CueForge {
+
+    /**
+     * Collects latency samples (milliseconds) and reports nearest-rank
+     * percentiles. Samples are sorted lazily on first query.
+     */
+    class LatencyStats
+    {
+    public:
+        void add(double ms)
+        {
+            samples_.push_back(ms);
+            sorted_ = false;
+        }
+
+        void clear()
+        {
+            samples_.clear();
+            sorted_ = true;
+        }
+
+        int count() const { return static_cast<int>(samples_.size()); }
+        bool isEmpty() const { return samples_.empty(); }
+
+        double percentile(double p) const
+        {
+            if (samples_.empty()) {
+                return 0.0;
+            }
+            sort();
+            const double rank = std::clamp(p, 0.0, 1.0) * (samples_.size() - 1);
+            return samples_[static_cast<size_t>(rank + 0.5)];
+        }
+
+        double min() const { return percentile(0.0); }
+        double max() const { return percentile(1.0); }
+
+        double mean() const
+        {
+            if (samples_.empty()) {
+                return 0.0;
+            }
+            return std::accumulate(samples_.begin(), samples_.end(), 0.0) / samples_.size();
+        }
+
+        // "n=.. min=.. p50=.. p95=.. p99=.. max=.. ms"
+        QString summary() const
+        {
+            return QString("n=%1  min=%2  p50=%3  p95=%4  p99=%5  max=%6 ms")
+                .arg(count())
+                .arg(min(), 0, 'f', 3)
+                .arg(percentile(0.50), 0, 'f', 3)
+                .arg(percentile(0.95), 0, 'f', 3)
+                .arg(percentile(0.99), 0, 'f', 3)
+                .arg(max(), 0, 'f', 3);
+        }
+
+    private:
+        void sort() const
+        {
+            if (!sorted_) {
+                std::sort(samples_.begin(), samples_.end());
+                sorted_ = true;
+            }
+        }
+
+        mutable std::vector<double> samples_;
+        mutable bool sorted_ = true;
+    };
+
+} // namespace CueForge
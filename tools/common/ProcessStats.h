@@ -0,0 +1,62 @@
+// ============================================================================
+// ProcessStats.h - Resident memory, heap and handle counts of this process
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#pragma once
+
+#include "audio/ProcessMemory.h"
+#include <QDir>
+
+#if defined(Q_OS_WIN)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(Q_OS_MACOS)
+#include <malloc/malloc.h>
+#elif defined(Q_OS_LINUX)
+#include <malloc.h>
+#endif
+
+namespace CueForge {
+
+    /**
+     * Point-in-time process figures for leak and growth tracking. Values a
+     * platform cannot provide are -1.
+     */
+    struct ProcessStats
+    {
+        double residentMb = -1.0;   // Working set / RSS, see residentMemoryMb()
+        double heapMb = -1.0;       // Bytes the allocator reports in use
+        int handles = -1;           // Open file descriptors / kernel handles
+
+        static ProcessStats sample()
+        {
+            ProcessStats stats;
+            constexpr double MB = 1024.0 * 1024.0;
+            stats.residentMb = residentMemoryMb();
+
+#if defined(Q_OS_WIN)
+            DWORD handleCount = 0;
+            if (GetProcessHandleCount(GetCurrentProcess(), &handleCount)) {
+                stats.handles = static_cast<int>(handleCount);
+            }
+#elif defined(Q_OS_MACOS)
+            malloc_statistics_t heap;
+            malloc_zone_statistics(nullptr, &heap);
+            stats.heapMb = heap.size_in_use / MB;
+            stats.handles = QDir("/dev/fd").entryList(QDir::AllEntries | QDir::System | QDir::NoDotAndDotDot).size();
+#elif defined(Q_OS_LINUX)
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+            const struct mallinfo2 heap = mallinfo2();
+            stats.heapMb = (heap.uordblks + heap.hblkhd) / MB;
+#endif
+            stats.handles = QDir("/proc/self/fd").entryList(QDir::AllEntries | QDir::System | QDir::NoDotAndDotDot).size();
+#endif
+
+            return stats;
+        }
+    };
+
+} // namespace CueForge
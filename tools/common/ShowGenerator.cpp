@@ -0,0 +1,414 @@
+// ============================================================================
+// ShowGenerator.cpp - Seedable synthetic workspaces with realistic shape
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#include "ShowGenerator.h"
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QtEndian>
+#include <QtMath>
+#include <cmath>
+#include <iterator>
+
+namespace CueForge {
+
+    namespace {
+        const char* const LoremWords[] = {
+            "house", "lights", "fade", "on", "cue", "from", "stage", "left", "actor", "exits",
+            "check", "level", "with", "director", "before", "tech", "slower", "the", "door",
+            "opens", "after", "line", "music", "under", "dialogue", "hold", "until", "blackout",
+            "speaker", "delay", "retune", "preview", "loud", "in", "act", "two", "band", "go"
+        };
+
+        const char* const AudioNames[] = {
+            "Preshow", "Thunder", "Rain loop", "Birdsong", "Door slam", "Underscore", "Transition",
+            "Sting", "Applause", "Phone ring", "Car pass", "Wind", "Crowd walla", "Church bell",
+            "Clock tick", "Radio", "Gunshot", "Footsteps", "Train", "Interval music"
+        };
+
+        const char* const Colors[] = {
+            "#4080c0", "#c04040", "#40c060", "#c0a040", "#8040c0", "#40c0c0", "#808080"
+        };
+
+        double roundTo(double value, double step)
+        {
+            return std::round(value / step) * step;
+        }
+
+        void appendLe16(QByteArray& data, quint16 value)
+        {
+            char bytes[2];
+            qToLittleEndian(value, bytes);
+            data.append(bytes, 2);
+        }
+
+        void appendLe32(QByteArray& data, quint32 value)
+        {
+            char bytes[4];
+            qToLittleEndian(value, bytes);
+            data.append(bytes, 4);
+        }
+    }
+
+    ShowGenerator::ShowGenerator(const ShowProfile& profile)
+        : profile_(profile)
+        , rng_(profile.seed)
+        , made_(0)
+        , topNumber_(0)
+        , chainRemaining_(0)
+        , deepestGroup_(0)
+        , chainedCues_(0)
+        , notesBytes_(0)
+    {
+    }
+
+    QJsonObject ShowGenerator::generateWorkspace()
+    {
+        rng_.seed(profile_.seed);
+        made_ = 0;
+        topNumber_ = 0;
+        chainRemaining_ = 0;
+        audioIds_.clear();
+        typeCounts_.clear();
+        deepestGroup_ = 0;
+        chainedCues_ = 0;
+        notesBytes_ = 0;
+
+        // Size the asset pool from the expected number of audio cues
+        int weightTotal = 0;
+        for (int weight : profile_.typeWeights) {
+            weightTotal += weight;
+        }
+        const int expectedAudio = weightTotal > 0
+            ? profile_.cues * profile_.typeWeights.value("Audio") / weightTotal : 0;
+        const int assets = profile_.assetCount > 0 ? profile_.assetCount : qBound(1, expectedAudio / 4, 64);
+
+        // Squared uniform skews towards short effects with a few long beds
+        assetSeconds_.clear();
+        for (int i = 0; i < assets; ++i) {
+            const double u = rng_.generateDouble();
+            assetSeconds_.append(roundTo(profile_.assetMinSeconds
+                + (profile_.assetMaxSeconds - profile_.assetMinSeconds) * u * u, 0.01));
+        }
+
+        QJsonObject workspace;
+        const QJsonArray cues = generateList(profile_.cues, 0, QString());
+        workspace["cues"] = cues;
+        workspace["version"] = "2.0.0";
+        if (!cues.isEmpty()) {
+            workspace["standbyCue"] = cues.first().toObject()["id"].toString();
+        }
+        return workspace;
+    }
+
+    QJsonArray ShowGenerator::generateList(int count, int depth, const QString& parentNumber)
+    {
+        QJsonArray list;
+
+        // Inside a group at most one child is itself a group, and that gets
+        // less likely the deeper we are - real shows rarely nest past three
+        int nestAt = -1;
+        if (depth > 0 && depth < profile_.maxGroupDepth && count >= 4
+            && rng_.generateDouble() < profile_.nestedGroupChance / depth) {
+            nestAt = rng_.bounded(count - 2);
+        }
+
+        int remaining = count;
+        int index = 0;
+
+        while (remaining > 0) {
+            QString type;
+            if (depth == 0) {
+                type = pickType(remaining >= 3 && profile_.maxGroupDepth > 0);
+            } else {
+                type = index == nestAt ? QString("Group") : pickType(false);
+            }
+
+            QString number;
+            if (depth == 0) {
+                // Mostly whole numbers, with the odd point cue added in tech
+                number = (topNumber_ > 0 && rng_.bounded(10) == 0)
+                    ? QString("%1.5").arg(topNumber_) : QString::number(++topNumber_);
+            } else if (!parentNumber.isEmpty() && rng_.bounded(2) == 0) {
+                number = QString("%1.%2").arg(parentNumber).arg(index + 1);
+            }
+
+            QJsonObject cue = generateCue(type, number);
+            --remaining;
+
+            if (type == "Group") {
+                const int span = qMax(1, profile_.maxGroupChildren - 1);
+                const int children = qMin(remaining, 2 + static_cast<int>(rng_.bounded(span)));
+                cue["children"] = generateList(children, depth + 1, number);
+                remaining -= children;
+                deepestGroup_ = qMax(deepestGroup_, depth + 1);
+            }
+
+            list.append(cue);
+            ++index;
+        }
+
+        return list;
+    }
+
+    QJsonObject ShowGenerator::generateCue(const QString& type, const QString& number)
+    {
+        const int serial = made_++;
+        const QString id = idFor(serial);
+        typeCounts_[type]++;
+
+        QJsonObject cue;
+        cue["id"] = id;
+        cue["type"] = type;
+        cue["number"] = number;
+        cue["name"] = makeName(type);
+        cue["color"] = Colors[rng_.bounded(static_cast<int>(std::size(Colors)))];
+        cue["isArmed"] = rng_.bounded(100) >= 3;
+
+        const QDateTime base(QDate(2024, 1, 1), QTime(9, 0), Qt::UTC);
+        cue["createdTime"] = base.addSecs(serial * 37).toString(Qt::ISODate);
+        cue["modifiedTime"] = base.addSecs(serial * 37 + 600).toString(Qt::ISODate);
+
+        // Auto-continue chains: a run of cues that fire one after another
+        bool continues = false;
+        if (chainRemaining_ > 0) {
+            continues = --chainRemaining_ > 0;
+        } else if (rng_.generateDouble() < profile_.continueChance) {
+            chainRemaining_ = 1 + rng_.bounded(qMax(1, profile_.maxChainLength));
+            continues = true;
+        }
+        if (continues) {
+            ++chainedCues_;
+        }
+        cue["continueMode"] = continues;
+        cue["postWait"] = continues && rng_.bounded(2) == 0 ? roundTo(rng_.generateDouble() * 3.0, 0.1) : 0.0;
+        cue["preWait"] = rng_.generateDouble() < profile_.preWaitChance
+            ? roundTo(0.1 + rng_.generateDouble() * 4.9, 0.1) : 0.0;
+
+        if (rng_.generateDouble() < profile_.notesChance) {
+            const QString notes = makeNotes();
+            notesBytes_ += notes.size();
+            cue["notes"] = notes;
+        } else {
+            cue["notes"] = QString();
+        }
+
+        QString target;
+        double duration = 0.0;
+
+        if (type == "Audio") {
+            // Min of two draws: a few assets (beds, stings) are reused a lot
+            const int assets = assetSeconds_.size();
+            const int index = qMin(rng_.bounded(assets), rng_.bounded(assets));
+            cue["filePath"] = assetPath(index);
+            cue["volume"] = roundTo(0.3 + rng_.generateDouble() * 0.7, 0.01);
+            cue["pan"] = rng_.bounded(5) == 0 ? roundTo(rng_.generateDouble() * 2.0 - 1.0, 0.05) : 0.0;
+            cue["rate"] = 1.0;
+            cue["startTime"] = rng_.bounded(7) == 0 ? roundTo(rng_.generateDouble(), 0.01) : 0.0;
+            cue["endTime"] = 0.0;
+            cue["audioOutputPatch"] = QString();
+            duration = assetSeconds_[index];
+            audioIds_.append(id);
+        }
+        else if (type == "Video") {
+            cue["filePath"] = QDir(profile_.assetDir).filePath(QString("../video/clip_%1.mp4").arg(rng_.bounded(8)));
+            cue["opacity"] = 1.0;
+            cue["volume"] = 1.0;
+            cue["loopEnabled"] = rng_.bounded(10) == 0;
+            duration = roundTo(5.0 + rng_.generateDouble() * 55.0, 0.1);
+        }
+        else if (type == "Wait") {
+            duration = roundTo(0.5 + rng_.generateDouble() * 14.5, 0.1);
+        }
+        else if (type == "Stop" || type == "Start") {
+            // Stops usually kill something that started shortly before
+            if (!audioIds_.isEmpty()) {
+                const int window = type == "Stop" ? qMin(20, static_cast<int>(audioIds_.size())) : static_cast<int>(audioIds_.size());
+                target = audioIds_[audioIds_.size() - 1 - rng_.bounded(window)];
+            }
+            cue["fadeTime"] = type == "Stop" && rng_.bounded(5) < 2 ? roundTo(0.5 + rng_.generateDouble() * 4.5, 0.1) : 0.0;
+        }
+        else if (type == "Goto") {
+            // May point forward; every serial below the total exists
+            target = idFor(rng_.bounded(qMax(1, profile_.cues)));
+            cue["fadeTime"] = 0.0;
+        }
+        else if (type == "Network") {
+            const bool http = rng_.bounded(5) == 0;
+            cue["protocol"] = http ? "http" : "tcp";
+            cue["host"] = "127.0.0.1";
+            cue["port"] = 7000 + rng_.bounded(4);
+            cue["message"] = http ? QString("{\"cue\":\"%1\"}").arg(number) : QString("GO %1").arg(number);
+            cue["httpMethod"] = "POST";
+            cue["httpPath"] = "/cue";
+            cue["contentType"] = http ? "application/json" : QString();
+            cue["timeoutMs"] = 2000;
+        }
+        else if (type == "Group") {
+            cue["mode"] = rng_.bounded(5) < 3 ? "Sequential" : "Simultaneous";
+        }
+
+        cue["duration"] = duration;
+        cue["targetCueId"] = target;
+        return cue;
+    }
+
+    QString ShowGenerator::pickType(bool allowGroup)
+    {
+        int total = 0;
+        for (auto it = profile_.typeWeights.constBegin(); it != profile_.typeWeights.constEnd(); ++it) {
+            if (allowGroup || it.key() != "Group") {
+                total += qMax(0, it.value());
+            }
+        }
+        if (total <= 0) {
+            return "Wait";
+        }
+
+        int pick = rng_.bounded(total);
+        for (auto it = profile_.typeWeights.constBegin(); it != profile_.typeWeights.constEnd(); ++it) {
+            if (!allowGroup && it.key() == "Group") {
+                continue;
+            }
+            pick -= qMax(0, it.value());
+            if (pick < 0) {
+                return it.key();
+            }
+        }
+        return "Wait";
+    }
+
+    QString ShowGenerator::makeNotes()
+    {
+        // Mostly a short reminder, sometimes a paragraph, rarely a page
+        const int roll = rng_.bounded(100);
+        const int words = roll < 70 ? 3 + rng_.bounded(13)
+                        : roll < 95 ? 15 + rng_.bounded(66)
+                        : 80 + rng_.bounded(521);
+
+        QString notes;
+        for (int i = 0; i < words; ++i) {
+            if (i > 0) {
+                notes += (i % 12 == 0) ? ". " : " ";
+            }
+            notes += LoremWords[rng_.bounded(static_cast<int>(std::size(LoremWords)))];
+        }
+        return notes + ".";
+    }
+
+    QString ShowGenerator::makeName(const QString& type)
+    {
+        if (type == "Audio") {
+            return AudioNames[rng_.bounded(static_cast<int>(std::size(AudioNames)))];
+        }
+        if (type == "Group") {
+            return QString("Scene %1").arg(rng_.bounded(1, 40));
+        }
+        if (type == "Network") {
+            return "Trigger lighting desk";
+        }
+        if (type == "Video") {
+            return "Projection";
+        }
+        return type;
+    }
+
+    QString ShowGenerator::idFor(int serial) const
+    {
+        return QString("gen-%1-%2").arg(profile_.seed).arg(serial);
+    }
+
+    QString ShowGenerator::assetPath(int index) const
+    {
+        return QDir(profile_.assetDir).absoluteFilePath(QString("asset_%1.wav").arg(index, 4, 10, QChar('0')));
+    }
+
+    QStringList ShowGenerator::assetPaths() const
+    {
+        QStringList paths;
+        for (int i = 0; i < assetSeconds_.size(); ++i) {
+            paths.append(assetPath(i));
+        }
+        return paths;
+    }
+
+    bool ShowGenerator::writeAssets(QString* error) const
+    {
+        if (!QDir().mkpath(profile_.assetDir)) {
+            if (error) *error = "Cannot create " + profile_.assetDir;
+            return false;
+        }
+
+        const int rate = profile_.assetSampleRate;
+        const int channels = 2;
+
+        for (int i = 0; i < assetSeconds_.size(); ++i) {
+            // Own generator per asset so content doesn't depend on cue count
+            QRandomGenerator rng(profile_.seed * 7919u + static_cast<quint32>(i));
+            const int frames = static_cast<int>(assetSeconds_[i] * rate);
+            const quint32 dataBytes = static_cast<quint32>(frames) * channels * 2;
+
+            QByteArray data;
+            data.reserve(44 + static_cast<int>(dataBytes));
+            data.append("RIFF", 4);
+            appendLe32(data, 36 + dataBytes);
+            data.append("WAVEfmt ", 8);
+            appendLe32(data, 16);
+            appendLe16(data, 1);   // PCM
+            appendLe16(data, channels);
+            appendLe32(data, static_cast<quint32>(rate));
+            appendLe32(data, static_cast<quint32>(rate * channels * 2));
+            appendLe16(data, channels * 2);
+            appendLe16(data, 16);
+            data.append("data", 4);
+            appendLe32(data, dataBytes);
+
+            // A tone on a semitone grid over low noise, with 10 ms edges
+            const double frequency = 110.0 * std::pow(2.0, rng.bounded(48) / 12.0);
+            const double noise = 0.02 + rng.generateDouble() * 0.1;
+            const int edge = qMax(1, rate / 100);
+
+            for (int f = 0; f < frames; ++f) {
+                const double envelope = qMin(1.0, qMin(f, frames - 1 - f) / static_cast<double>(edge));
+                const double tone = 0.3 * std::sin(2.0 * M_PI * frequency * f / rate);
+                for (int ch = 0; ch < channels; ++ch) {
+                    const double sample = envelope * (tone + noise * (rng.generateDouble() * 2.0 - 1.0));
+                    appendLe16(data, static_cast<quint16>(static_cast<qint16>(qBound(-1.0, sample, 1.0) * 32767.0)));
+                }
+            }
+
+            QFile file(assetPath(i));
+            if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size()) {
+                if (error) *error = "Cannot write " + file.fileName();
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    QString ShowGenerator::summary() const
+    {
+        QStringList types;
+        for (auto it = typeCounts_.constBegin(); it != typeCounts_.constEnd(); ++it) {
+            types.append(QString("%1=%2").arg(it.key()).arg(it.value()));
+        }
+
+        double assetSeconds = 0.0;
+        for (double seconds : assetSeconds_) {
+            assetSeconds += seconds;
+        }
+
+        return QString("%1 cues (%2), group depth %3, %4 chained, %5 KB notes, %6 assets (%7 MB)")
+            .arg(made_)
+            .arg(types.join(", "))
+            .arg(deepestGroup_)
+            .arg(chainedCues_)
+            .arg(notesBytes_ / 1024)
+            .arg(assetSeconds_.size())
+            .arg(assetSeconds * profile_.assetSampleRate * 4 / (1024.0 * 1024.0), 0, 'f', 1);
+    }
+
+} // namespace CueForge
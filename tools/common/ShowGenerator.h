@@ -0,0 +1,90 @@
+// ============================================================================
+// ShowGenerator.h - Seedable synthetic workspaces with realistic shape
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#pragma once
+
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QMap>
+#include <QRandomGenerator>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+namespace CueForge {
+
+    /**
+     * Shape of a generated show. Defaults approximate a mid-size theatre
+     * sound design: mostly audio, scene groups two or three deep, stop
+     * cues trailing the audio they kill and short auto-continue chains.
+     */
+    struct ShowProfile
+    {
+        int cues = 1000;                 // Total including groups and children
+        quint32 seed = 1;
+
+        // Relative weights; only types CueManager can load are honoured
+        QMap<QString, int> typeWeights = {
+            { "Audio", 55 }, { "Group", 10 }, { "Stop", 10 }, { "Wait", 8 },
+            { "Start", 6 }, { "Network", 6 }, { "Goto", 3 }, { "Video", 2 }
+        };
+
+        int maxGroupDepth = 4;
+        int maxGroupChildren = 12;
+        double nestedGroupChance = 0.35; // Group inside a group, decays per level
+        double continueChance = 0.15;    // A cue starts an auto-continue chain
+        int maxChainLength = 6;
+        double notesChance = 0.4;
+        double preWaitChance = 0.1;
+
+        // Audio assets: audio cues reference a shared pool of files
+        QString assetDir = "audio";     // Absolute path written into filePath
+        int assetCount = 0;              // 0 = one per four audio cues, at most 64
+        double assetMinSeconds = 1.0;
+        double assetMaxSeconds = 10.0;
+        int assetSampleRate = 48000;
+    };
+
+    class ShowGenerator
+    {
+    public:
+        explicit ShowGenerator(const ShowProfile& profile);
+
+        // Same profile and seed always produce the same workspace JSON
+        QJsonObject generateWorkspace();
+
+        // Write the WAV files referenced by the last generated workspace
+        bool writeAssets(QString* error = nullptr) const;
+
+        QStringList assetPaths() const;
+        QString summary() const;
+
+    private:
+        QJsonArray generateList(int count, int depth, const QString& parentNumber);
+        QJsonObject generateCue(const QString& type, const QString& number);
+
+        QString pickType(bool allowGroup);
+        QString makeNotes();
+        QString makeName(const QString& type);
+        QString idFor(int serial) const;
+        QString assetPath(int index) const;
+
+        ShowProfile profile_;
+        QRandomGenerator rng_;
+
+        int made_;
+        int topNumber_;
+        int chainRemaining_;
+        QStringList audioIds_;
+        QVector<double> assetSeconds_;
+
+        // Statistics for summary()
+        QMap<QString, int> typeCounts_;
+        int deepestGroup_;
+        int chainedCues_;
+        qint64 notesBytes_;
+    };
+
+} // namespace CueForge
@@ -0,0 +1,160 @@
+// ============================================================================
+// main.cpp - Sample accuracy of voice-to-voice crossfades
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+//
+// Checks of JuceAudioEngine::crossfadePlayers() on a null device. A bed of
+// constant level A plays, then one command crossfades it into a cue of
+// constant level B, so every output sample shows both gains:
+//
+//   out[s0 + i] = A * gain(1 - i / L) + B * gain(i / L)
+//
+// where s0 is the first sample of the block after the command and L the
+// fade length, deliberately not a whole number of blocks. For each curve
+// the render must match that to float precision, before, during and after
+// the fade, the bed must report faded out once L samples have played, and
+// stopping it must make it audible again for the next play.
+//
+//   cueforge-crossfade
+//
+// Exit code: 0 pass, 1 mismatch, 2 setup error.
+
+#include "audio/JuceAudioEngine.h"
+#include "audio/NullAudioDevice.h"
+#include "golden_audio/AudioCompare.h"
+#include <juce_events/juce_events.h>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+using namespace CueForge;
+
+namespace {
+
+    constexpr double SampleRate = 48000.0;
+    constexpr int BufferSize = 240;
+    constexpr int LeadBlocks = 10;          // Bed alone before the command
+    constexpr int FadeSamples = 4801;       // 20 blocks and a sample, so it ends mid-block
+    constexpr int TailBlocks = 10;
+    constexpr float BedLevel = 0.5f;
+    constexpr float CueLevel = 0.25f;
+
+    juce::File tempFile(const juce::String& name)
+    {
+        return juce::File::getSpecialLocation(juce::File::tempDirectory).getChildFile(name);
+    }
+
+    bool writeLevel(const juce::File& file, float level)
+    {
+        juce::AudioBuffer<float> buffer(2, static_cast<int>(SampleRate * 2.0));
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch) {
+            juce::FloatVectorOperations::fill(buffer.getWritePointer(ch), level, buffer.getNumSamples());
+        }
+        return writeWav(file, buffer, SampleRate);
+    }
+
+    // Returns 0 pass, 1 mismatch, 2 setup error
+    int checkCurve(FadeCurve curve, const char* label, const juce::File& bed, const juce::File& cue)
+    {
+        NullAudioSettings settings;
+        settings.sampleRate = SampleRate;
+        settings.bufferSize = BufferSize;
+        settings.clock = NullAudioSettings::Clock::Manual;
+        settings.captureRingSeconds = 2.0;
+
+        JuceAudioEngine engine;
+        NullAudioIODevice* device = nullptr;
+        if (!engine.initializeNull(settings) || (device = engine.getNullDevice()) == nullptr) {
+            std::cerr << "Null device failed to start\n";
+            return 2;
+        }
+
+        const int bedPlayer = engine.createPlayer(bed.getFullPathName().toStdString());
+        const int cuePlayer = engine.createPlayer(cue.getFullPathName().toStdString());
+        if (bedPlayer < 0 || cuePlayer < 0) {
+            std::cerr << "Cannot load test files\n";
+            return 2;
+        }
+
+        engine.getPlayer(bedPlayer)->play();
+        device->renderBlocks(LeadBlocks);
+
+        const double seconds = FadeSamples / SampleRate;
+        std::string error;
+        if (!engine.crossfadePlayers(cuePlayer, { bedPlayer }, seconds, curve, &error)) {
+            std::cerr << "Crossfade failed: " << error << "\n";
+            return 2;
+        }
+
+        const int fadeBlocks = (FadeSamples + BufferSize - 1) / BufferSize;
+        device->renderBlocks(fadeBlocks + TailBlocks);
+        const bool fadedOut = engine.isPlayerFadedOut(bedPlayer) && !engine.isPlayerFadedOut(cuePlayer);
+
+        engine.getPlayer(bedPlayer)->stop();
+        const bool reset = !engine.isPlayerFadedOut(bedPlayer);
+
+        juce::AudioBuffer<float> rendered;
+        device->readCapture(rendered, device->getCaptureAvailable());
+        engine.shutdown();
+
+        juce::AudioBuffer<float> expected(rendered.getNumChannels(), rendered.getNumSamples());
+        const int start = LeadBlocks * BufferSize;
+        for (int i = 0; i < expected.getNumSamples(); ++i) {
+            float value = BedLevel;
+            if (i >= start) {
+                const double t = std::min(1.0, static_cast<double>(i - start) / FadeSamples);
+                value = BedLevel * VoiceFader::gainAt(curve, 1.0 - t) + CueLevel * VoiceFader::gainAt(curve, t);
+            }
+            for (int ch = 0; ch < expected.getNumChannels(); ++ch) {
+                expected.setSample(ch, i, value);
+            }
+        }
+
+        CompareSettings compare;
+        compare.peakTolerance = 1.0e-6;
+        compare.rmsTolerance = 1.0e-6;
+        const CompareResult result = compareAudio(rendered, expected, compare);
+
+        // Sum of the two gains halfway through: 1.414 for equal power, 1 for linear
+        const float middle = VoiceFader::gainAt(curve, 0.5) * 2.0f;
+        const bool ok = result.pass && fadedOut && reset;
+        std::cout << "  " << label << ": " << result.describe(SampleRate) << ", gains sum to " << middle
+                  << " halfway, bed " << (fadedOut ? "faded out" : "NOT FADED OUT") << ", "
+                  << (reset ? "reset by stop" : "NOT RESET BY STOP") << (ok ? "  ok" : "  FAIL") << "\n";
+        return ok ? 0 : 1;
+    }
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInit;
+
+    if (argc > 1) {
+        std::cerr << "usage: cueforge-crossfade\n";
+        return 2;
+    }
+
+    const juce::File bed = tempFile("cueforge-crossfade-bed.wav");
+    const juce::File cue = tempFile("cueforge-crossfade-cue.wav");
+    if (!writeLevel(bed, BedLevel) || !writeLevel(cue, CueLevel)) {
+        std::cerr << "Cannot write test files\n";
+        return 2;
+    }
+
+    std::cout << "Crossfade of " << FadeSamples << " samples in " << BufferSize << "-sample blocks at "
+              << SampleRate << " Hz\n";
+
+    int result = checkCurve(FadeCurve::EqualPower, "Equal power", bed, cue);
+    if (result != 2) {
+        result = std::max(result, checkCurve(FadeCurve::Linear, "Linear", bed, cue));
+    }
+    bed.deleteFile();
+    cue.deleteFile();
+    if (result == 2) {
+        return 2;
+    }
+
+    std::cout << "\n" << (result == 0 ? "PASS" : "FAIL") << "\n";
+    return result;
+}
@@ -0,0 +1,455 @@
+// ============================================================================
+// main.cpp - CueManager scalability microbenchmarks
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+//
+// Loads synthetic workspaces from 100 to 100k cues (with nested groups),
+// times each CueManager operation per call and fits a scaling exponent
+// (slope of log time vs log cue count). An exponent above an operation's
+// budget means it got worse than expected - e.g. a per-call cost that
+// grows linearly, making a full pass quadratic. Exits non-zero if any
+// operation is flagged, so CI can gate on it.
+//
+//   cueforge-cue-bench --max 30000 --repeats 3 --csv results.csv
+
+#include "core/CueManager.h"
+#include "core/Cue.h"
+#include "common/ShowGenerator.h"
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QRandomGenerator>
+#include <QTextStream>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <vector>
+
+using namespace CueForge;
+
+namespace {
+
+    // ------------------------------------------------------------------------
+    // Synthetic workspace
+    // ------------------------------------------------------------------------
+
+    CueType leafType(QRandomGenerator& rng)
+    {
+        static const CueType types[] = {
+            CueType::Wait, CueType::Wait, CueType::Wait,
+            CueType::Start, CueType::Stop, CueType::Goto
+        };
+        return types[rng.bounded(static_cast<int>(std::size(types)))];
+    }
+
+    QJsonObject makeCue(int serial, CueType type)
+    {
+        QJsonObject cue;
+        cue["id"] = QString("bench-%1").arg(serial);
+        cue["type"] = cueTypeToString(type);
+        cue["number"] = QString::number(serial + 1);
+        cue["name"] = QString("Cue %1").arg(serial + 1);
+        cue["duration"] = 1.0 + (serial % 7);
+        cue["color"] = "#4080c0";
+        cue["isArmed"] = true;
+        return cue;
+    }
+
+    // Roughly one top-level block in four is a group of eight, and one group
+    // in three holds a nested group of four - like a show with scene groups
+    QJsonObject buildWorkspace(int total, quint32 seed)
+    {
+        QRandomGenerator rng(seed);
+        QJsonArray top;
+        int made = 0;
+
+        while (made < total) {
+            if (total - made >= 14 && rng.bounded(4) == 0) {
+                QJsonObject group = makeCue(made++, CueType::Group);
+                QJsonArray children;
+                for (int i = 0; i < 8; ++i) {
+                    children.append(makeCue(made++, leafType(rng)));
+                }
+                if (rng.bounded(3) == 0) {
+                    QJsonObject nested = makeCue(made++, CueType::Group);
+                    QJsonArray nestedChildren;
+                    for (int i = 0; i < 4; ++i) {
+                        nestedChildren.append(makeCue(made++, leafType(rng)));
+                    }
+                    nested["children"] = nestedChildren;
+                    children.append(nested);
+                }
+                group["children"] = children;
+                top.append(group);
+            }
+            else {
+                top.append(makeCue(made++, leafType(rng)));
+            }
+        }
+
+        QJsonObject workspace;
+        workspace["cues"] = top;
+        workspace["version"] = "2.0.0";
+        return workspace;
+    }
+
+    // Same corpus cueforge-show-gen writes; audio files are referenced but
+    // not created, which only costs a failed stat per audio cue on load
+    QJsonObject buildRealisticWorkspace(int total, quint32 seed)
+    {
+        ShowProfile profile;
+        profile.cues = total;
+        profile.seed = seed;
+        profile.assetDir = QDir::temp().filePath("cueforge-cue-bench-audio");
+        return ShowGenerator(profile).generateWorkspace();
+    }
+
+    // ------------------------------------------------------------------------
+    // Operations
+    // ------------------------------------------------------------------------
+
+    struct Context
+    {
+        CueManager& manager;
+        const QJsonObject& workspace;
+        QRandomGenerator& rng;
+        int calls;   // Calls per measurement for per-item operations
+    };
+
+    // Returns nanoseconds per call
+    using OperationFn = std::function<double(Context&)>;
+
+    struct Operation
+    {
+        QString name;
+        double budget;   // Expected exponent of per-call time vs cue count
+        OperationFn run;
+    };
+
+    QString randomTopLevelId(Context& ctx)
+    {
+        const auto& cues = ctx.manager.allCues();
+        return cues[ctx.rng.bounded(cues.size())]->id();
+    }
+
+    QStringList randomTopLevelIds(Context& ctx, int count)
+    {
+        QStringList ids;
+        for (int i = 0; i < count; ++i) {
+            ids.append(randomTopLevelId(ctx));
+        }
+        return ids;
+    }
+
+    void selectRun(Context& ctx, int length)
+    {
+        const auto& cues = ctx.manager.allCues();
+        const int start = ctx.rng.bounded(qMax(1, static_cast<int>(cues.size()) - length));
+        ctx.manager.clearSelection();
+        for (int i = start; i < qMin(start + length, static_cast<int>(cues.size())); ++i) {
+            ctx.manager.addToSelection(cues[i]->id());
+        }
+    }
+
+    template <typename Fn>
+    qint64 timed(Fn&& fn)
+    {
+        QElapsedTimer timer;
+        timer.start();
+        fn();
+        return timer.nsecsElapsed();
+    }
+
+    std::vector<Operation> operations()
+    {
+        std::vector<Operation> ops;
+
+        // Per-item operations: ids are looked up by a linear scan today, so
+        // O(n) per call is the accepted baseline
+        ops.push_back({ "createCue", 1.0, [](Context& ctx) {
+            qint64 ns = 0;
+            for (int i = 0; i < ctx.calls; ++i) {
+                const int index = ctx.rng.bounded(ctx.manager.cueCount());
+                ns += timed([&] { ctx.manager.createCue(CueType::Wait, index); });
+            }
+            return double(ns) / ctx.calls;
+        } });
+
+        ops.push_back({ "removeCue", 1.0, [](Context& ctx) {
+            qint64 ns = 0;
+            for (int i = 0; i < ctx.calls; ++i) {
+                const QString id = randomTopLevelId(ctx);
+                ns += timed([&] { ctx.manager.removeCue(id); });
+            }
+            return double(ns) / ctx.calls;
+        } });
+
+        ops.push_back({ "moveCue", 1.0, [](Context& ctx) {
+            qint64 ns = 0;
+            for (int i = 0; i < ctx.calls; ++i) {
+                const QString id = randomTopLevelId(ctx);
+                const int index = ctx.rng.bounded(ctx.manager.cueCount());
+                ns += timed([&] { ctx.manager.moveCue(id, index); });
+            }
+            return double(ns) / ctx.calls;
+        } });
+
+        ops.push_back({ "duplicateCue", 1.0, [](Context& ctx) {
+            qint64 ns = 0;
+            const QStringList ids = randomTopLevelIds(ctx, ctx.calls);
+            for (const QString& id : ids) {
+                ns += timed([&] { ctx.manager.duplicateCue(id); });
+            }
+            return double(ns) / ctx.calls;
+        } });
+
+        ops.push_back({ "createGroupFromSelection", 1.0, [](Context& ctx) {
+            qint64 ns = 0;
+            for (int i = 0; i < ctx.calls; ++i) {
+                selectRun(ctx, 5);
+                ns += timed([&] { ctx.manager.createGroupFromSelection("Bench Group"); });
+            }
+            return double(ns) / ctx.calls;
+        } });
+
+        ops.push_back({ "ungroupCue", 1.0, [](Context& ctx) {
+            QStringList groups;
+            for (const auto& cue : ctx.manager.allCues()) {
+                if (cue->type() == CueType::Group) {
+                    groups.append(cue->id());
+                }
+            }
+            const int count = qMin(ctx.calls, static_cast<int>(groups.size()));
+            qint64 ns = 0;
+            for (int i = 0; i < count; ++i) {
+                ns += timed([&] { ctx.manager.ungroupCue(groups[i]); });
+            }
+            return count > 0 ? double(ns) / count : 0.0;
+        } });
+
+        ops.push_back({ "copy+paste", 1.0, [](Context& ctx) {
+            qint64 ns = 0;
+            for (int i = 0; i < ctx.calls; ++i) {
+                selectRun(ctx, 10);
+                const int index = ctx.rng.bounded(ctx.manager.cueCount());
+                ns += timed([&] {
+                    ctx.manager.copy();
+                    ctx.manager.paste(index);
+                });
+            }
+            return double(ns) / ctx.calls;
+        } });
+
+        ops.push_back({ "cut", 1.0, [](Context& ctx) {
+            qint64 ns = 0;
+            for (int i = 0; i < ctx.calls; ++i) {
+                selectRun(ctx, 10);
+                ns += timed([&] { ctx.manager.cut(); });
+            }
+            return double(ns) / ctx.calls;
+        } });
+
+        // Whole-workspace operations: one pass, so linear is expected
+        ops.push_back({ "selectAll", 1.0, [](Context& ctx) {
+            ctx.manager.clearSelection();
+            return double(timed([&] { ctx.manager.selectAll(); }));
+        } });
+
+        ops.push_back({ "renumberAllCues", 1.0, [](Context& ctx) {
+            return double(timed([&] { ctx.manager.renumberAllCues(); }));
+        } });
+
+        ops.push_back({ "save", 1.0, [](Context& ctx) {
+            QByteArray bytes;
+            const qint64 ns = timed([&] {
+                bytes = QJsonDocument(ctx.manager.saveWorkspace()).toJson(QJsonDocument::Compact);
+            });
+            return bytes.isEmpty() ? 0.0 : double(ns);
+        } });
+
+        ops.push_back({ "load", 1.0, [](Context& ctx) {
+            const QByteArray bytes = QJsonDocument(ctx.workspace).toJson(QJsonDocument::Compact);
+            return double(timed([&] {
+                ctx.manager.loadWorkspace(QJsonDocument::fromJson(bytes).object());
+            }));
+        } });
+
+        return ops;
+    }
+
+    // Least-squares slope of log(time) against log(n)
+    double scalingExponent(const std::vector<int>& sizes, const std::vector<double>& times)
+    {
+        std::vector<std::pair<double, double>> points;
+        for (size_t i = 0; i < sizes.size(); ++i) {
+            if (times[i] > 0.0) {
+                points.push_back({ std::log(double(sizes[i])), std::log(times[i]) });
+            }
+        }
+
+        // Small workspaces are dominated by fixed overhead - fit the top four
+        if (points.size() > 4) {
+            points.erase(points.begin(), points.end() - 4);
+        }
+        if (points.size() < 2) {
+            return 0.0;
+        }
+
+        double mx = 0.0, my = 0.0;
+        for (const auto& p : points) {
+            mx += p.first;
+            my += p.second;
+        }
+        mx /= points.size();
+        my /= points.size();
+
+        double sxy = 0.0, sxx = 0.0;
+        for (const auto& p : points) {
+            sxy += (p.first - mx) * (p.second - my);
+            sxx += (p.first - mx) * (p.first - mx);
+        }
+        return sxx > 0.0 ? sxy / sxx : 0.0;
+    }
+
+    QString formatTime(double ns)
+    {
+        if (ns >= 1.0e6) {
+            return QString::number(ns / 1.0e6, 'f', 2) + "ms";
+        }
+        return QString::number(ns / 1.0e3, 'f', 1) + "us";
+    }
+
+    void quietMessageHandler(QtMsgType type, const QMessageLogContext&, const QString& message)
+    {
+        // CueManager logs every cue it creates - far too much at 100k cues
+        if (type == QtDebugMsg || type == QtInfoMsg) {
+            return;
+        }
+        QTextStream(stderr) << message << Qt::endl;
+    }
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("cueforge-cue-bench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Scalability benchmarks for CueManager operations");
+    parser.addHelpOption();
+    parser.addOptions({
+        { "sizes", "Comma separated cue counts (default 100..100000).", "list",
+          "100,300,1000,3000,10000,30000,100000" },
+        { "max", "Skip sizes above this cue count.", "n" },
+        { "repeats", "Measurements per operation and size; the median is kept (default 3).", "n", "3" },
+        { "calls", "Calls per measurement for per-item operations (default 50).", "n", "50" },
+        { "only", "Comma separated operation names to run.", "list" },
+        { "tolerance", "Allowed exponent above each operation's budget (default 0.35).", "x", "0.35" },
+        { "csv", "Also write results to this CSV file.", "file" },
+        { "realistic", "Use the synthetic show generator corpus (all cue types, deep groups, notes, continue chains)." },
+        { "verbose", "Keep CueManager debug output." },
+    });
+    parser.process(app);
+
+    if (!parser.isSet("verbose")) {
+        qInstallMessageHandler(quietMessageHandler);
+    }
+
+    std::vector<int> sizes;
+    for (const QString& value : parser.value("sizes").split(',', Qt::SkipEmptyParts)) {
+        const int n = value.trimmed().toInt();
+        if (n >= 10 && (!parser.isSet("max") || n <= parser.value("max").toInt())) {
+            sizes.push_back(n);
+        }
+    }
+    std::sort(sizes.begin(), sizes.end());
+
+    const int repeats = qMax(1, parser.value("repeats").toInt());
+    const int calls = qMax(1, parser.value("calls").toInt());
+    const double tolerance = parser.value("tolerance").toDouble();
+    const QStringList only = parser.value("only").split(',', Qt::SkipEmptyParts);
+
+    QTextStream out(stdout);
+
+    std::vector<Operation> ops = operations();
+    if (!only.isEmpty()) {
+        ops.erase(std::remove_if(ops.begin(), ops.end(),
+            [&](const Operation& op) { return !only.contains(op.name); }), ops.end());
+    }
+
+    // Build each workspace once; every measurement starts from a fresh load
+    std::vector<QJsonObject> workspaces;
+    for (int n : sizes) {
+        workspaces.push_back(parser.isSet("realistic")
+            ? buildRealisticWorkspace(n, 0xC0EF0 + n)
+            : buildWorkspace(n, 0xC0EF0 + n));
+    }
+
+    std::vector<std::vector<double>> results(ops.size(), std::vector<double>(sizes.size(), 0.0));
+
+    for (size_t s = 0; s < sizes.size(); ++s) {
+        out << "Measuring " << sizes[s] << " cues..." << Qt::endl;
+
+        for (size_t o = 0; o < ops.size(); ++o) {
+            std::vector<double> samples;
+            for (int r = 0; r < repeats; ++r) {
+                CueManager manager;
+                manager.loadWorkspace(workspaces[s]);
+
+                QRandomGenerator rng(static_cast<quint32>(1000 * s + 10 * o + r));
+                Context ctx{ manager, workspaces[s], rng, calls };
+                samples.push_back(ops[o].run(ctx));
+            }
+            std::sort(samples.begin(), samples.end());
+            results[o][s] = samples[samples.size() / 2];
+        }
+    }
+
+    // Report
+    out << Qt::endl << QString("operation").leftJustified(26);
+    for (int n : sizes) {
+        out << QString::number(n).rightJustified(10);
+    }
+    out << "  exponent  budget" << Qt::endl;
+
+    int flagged = 0;
+    QString csv = "operation,cues,ns_per_call\n";
+
+    for (size_t o = 0; o < ops.size(); ++o) {
+        out << ops[o].name.leftJustified(26);
+        for (size_t s = 0; s < sizes.size(); ++s) {
+            out << formatTime(results[o][s]).rightJustified(10);
+            csv += QString("%1,%2,%3\n").arg(ops[o].name).arg(sizes[s]).arg(results[o][s], 0, 'f', 0);
+        }
+
+        const double exponent = scalingExponent(sizes, results[o]);
+        const bool bad = exponent > ops[o].budget + tolerance;
+        flagged += bad ? 1 : 0;
+
+        out << QString::number(exponent, 'f', 2).rightJustified(10)
+            << QString::number(ops[o].budget, 'f', 1).rightJustified(8)
+            << (bad ? "  << SUPERLINEAR" : "") << Qt::endl;
+    }
+
+    if (parser.isSet("csv")) {
+        QFile file(parser.value("csv"));
+        if (file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            file.write(csv.toUtf8());
+        }
+        else {
+            qWarning() << "Cannot write" << file.fileName();
+        }
+    }
+
+    out << Qt::endl << "Times are per call; exponent is the slope of log(time) vs log(cues)." << Qt::endl;
+    if (flagged > 0) {
+        out << flagged << " operation(s) scale worse than budget." << Qt::endl;
+        return 1;
+    }
+    return 0;
+}
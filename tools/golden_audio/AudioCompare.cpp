@@ -0,0 +1,133 @@
+// ============================================================================
+// AudioCompare.cpp - Sample-exact and tolerance comparison of rendered audio
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#include "AudioCompare.h"
+#include <cmath>
+
+namespace CueForge {
+
+    namespace {
+        juce::String dbfs(double value)
+        {
+            return value > 0.0 ? juce::String(juce::Decibels::gainToDecibels(value, -400.0), 1) + " dBFS"
+                               : juce::String("-inf dBFS");
+        }
+    }
+
+    juce::String CompareResult::describe(double sampleRate) const
+    {
+        juce::String text;
+
+        if (error.isNotEmpty()) {
+            text << error << "; ";
+        }
+
+        text << "peak=" << juce::String(peakError, 9) << " (" << dbfs(peakError) << ")"
+             << "  rms=" << juce::String(rmsError, 9) << " (" << dbfs(rmsError) << ")";
+
+        if (firstDivergentSample >= 0) {
+            text << "  first divergence @ sample " << juce::String(firstDivergentSample)
+                 << " (" << juce::String(firstDivergentSample / sampleRate, 4) << " s) ch "
+                 << juce::String(firstDivergentChannel)
+                 << ": got " << juce::String(actualAtDivergence, 7)
+                 << " expected " << juce::String(expectedAtDivergence, 7);
+        }
+
+        return text;
+    }
+
+    CompareResult compareAudio(const juce::AudioBuffer<float>& actual,
+        const juce::AudioBuffer<float>& expected,
+        const CompareSettings& settings)
+    {
+        CompareResult result;
+        result.actualLength = actual.getNumSamples();
+        result.expectedLength = expected.getNumSamples();
+
+        if (actual.getNumChannels() != expected.getNumChannels()) {
+            result.error = "channel count " + juce::String(actual.getNumChannels())
+                + " != " + juce::String(expected.getNumChannels());
+            return result;
+        }
+
+        if (result.actualLength != result.expectedLength) {
+            result.error = "length " + juce::String(result.actualLength)
+                + " != " + juce::String(result.expectedLength) + " samples";
+        }
+
+        const int channels = actual.getNumChannels();
+        const int length = juce::jmin(result.actualLength, result.expectedLength);
+        const double threshold = settings.exact ? 0.0 : settings.peakTolerance;
+
+        double sumSquares = 0.0;
+
+        // Sample-major, so the reported divergence is the earliest in time
+        for (int i = 0; i < length; ++i) {
+            for (int ch = 0; ch < channels; ++ch) {
+                const float a = actual.getSample(ch, i);
+                const float e = expected.getSample(ch, i);
+                const double diff = std::abs(static_cast<double>(a) - static_cast<double>(e));
+
+                sumSquares += diff * diff;
+                result.peakError = juce::jmax(result.peakError, diff);
+
+                if (diff > threshold && result.firstDivergentSample < 0) {
+                    result.firstDivergentSample = i;
+                    result.firstDivergentChannel = ch;
+                    result.actualAtDivergence = a;
+                    result.expectedAtDivergence = e;
+                }
+            }
+        }
+
+        if (length > 0 && channels > 0) {
+            result.rmsError = std::sqrt(sumSquares / (static_cast<double>(length) * channels));
+        }
+
+        const bool withinTolerance = settings.exact
+            ? result.peakError == 0.0
+            : result.peakError <= settings.peakTolerance && result.rmsError <= settings.rmsTolerance;
+
+        result.pass = result.error.isEmpty() && withinTolerance;
+        return result;
+    }
+
+    bool readWav(const juce::File& file, juce::AudioBuffer<float>& buffer, double& sampleRate)
+    {
+        juce::WavAudioFormat wav;
+        std::unique_ptr<juce::AudioFormatReader> reader(
+            wav.createReaderFor(file.createInputStream().release(), true));
+        if (!reader) {
+            return false;
+        }
+
+        buffer.setSize(static_cast<int>(reader->numChannels), static_cast<int>(reader->lengthInSamples));
+        reader->read(&buffer, 0, buffer.getNumSamples(), 0, true, true);
+        sampleRate = reader->sampleRate;
+        return true;
+    }
+
+    bool writeWav(const juce::File& file, const juce::AudioBuffer<float>& buffer, double sampleRate)
+    {
+        file.getParentDirectory().createDirectory();
+        file.deleteFile();
+
+        std::unique_ptr<juce::OutputStream> stream = file.createOutputStream();
+        if (!stream) {
+            return false;
+        }
+
+        juce::WavAudioFormat wav;
+        std::unique_ptr<juce::AudioFormatWriter> writer(wav.createWriterFor(stream.get(), sampleRate,
+            static_cast<unsigned int>(buffer.getNumChannels()), 32, {}, 0));
+        if (!writer) {
+            return false;
+        }
+        stream.release();   // Owned by the writer now
+
+        return writer->writeFromAudioSampleBuffer(buffer, 0, buffer.getNumSamples());
+    }
+
+} // namespace CueForge
@@ -0,0 +1,47 @@
+// ============================================================================
+// AudioCompare.h - Sample-exact and tolerance comparison of rendered audio
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_audio_formats/juce_audio_formats.h>
+
+namespace CueForge {
+
+    struct CompareSettings
+    {
+        bool exact = false;
+        double peakTolerance = 1.0e-6;   // Max absolute sample difference
+        double rmsTolerance = 1.0e-7;    // RMS of the difference signal
+    };
+
+    struct CompareResult
+    {
+        bool pass = false;
+        double peakError = 0.0;
+        double rmsError = 0.0;
+
+        // First sample whose difference exceeds the threshold (-1 if none)
+        int64_t firstDivergentSample = -1;
+        int firstDivergentChannel = -1;
+        float actualAtDivergence = 0.0f;
+        float expectedAtDivergence = 0.0f;
+
+        int actualLength = 0;
+        int expectedLength = 0;
+        juce::String error;   // Structural mismatch (channels, length)
+
+        juce::String describe(double sampleRate) const;
+    };
+
+    CompareResult compareAudio(const juce::AudioBuffer<float>& actual,
+        const juce::AudioBuffer<float>& expected,
+        const CompareSettings& settings);
+
+    // 32-bit float WAV, so goldens are bit-exact
+    bool readWav(const juce::File& file, juce::AudioBuffer<float>& buffer, double& sampleRate);
+    bool writeWav(const juce::File& file, const juce::AudioBuffer<float>& buffer, double sampleRate);
+
+} // namespace CueForge
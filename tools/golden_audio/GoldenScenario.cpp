@@ -0,0 +1,299 @@
+// ============================================================================
+// GoldenScenario.cpp - Scripted cue scenarios rendered through the null device
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#include "GoldenScenario.h"
+#include "audio/JuceAudioEngine.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+namespace CueForge {
+
+    namespace {
+        bool parseSourceKind(const juce::String& text, GoldenSource::Kind& kind)
+        {
+            if (text == "sine") kind = GoldenSource::Kind::Sine;
+            else if (text == "noise") kind = GoldenSource::Kind::Noise;
+            else if (text == "impulses") kind = GoldenSource::Kind::Impulses;
+            else if (text == "sweep") kind = GoldenSource::Kind::Sweep;
+            else return false;
+            return true;
+        }
+
+        bool parseAction(const juce::String& text, GoldenStep::Action& action)
+        {
+            if (text == "play") action = GoldenStep::Action::Play;
+            else if (text == "stop") action = GoldenStep::Action::Stop;
+            else if (text == "pause") action = GoldenStep::Action::Pause;
+            else if (text == "resume") action = GoldenStep::Action::Resume;
+            else if (text == "seek") action = GoldenStep::Action::Seek;
+            else if (text == "volume") action = GoldenStep::Action::Volume;
+            else if (text == "fade") action = GoldenStep::Action::Fade;
+            else return false;
+            return true;
+        }
+
+        // Deterministic across platforms, unlike std::rand / juce::Random seeding
+        float nextNoise(juce::uint32& state)
+        {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return static_cast<float>(state) / 2147483648.0f - 1.0f;
+        }
+
+        void synthesize(const GoldenSource& source, juce::AudioBuffer<float>& buffer)
+        {
+            const int length = static_cast<int>(std::lround(source.seconds * source.sampleRate));
+            buffer.setSize(source.channels, length);
+            buffer.clear();
+
+            const float amplitude = static_cast<float>(source.amplitude);
+            juce::uint32 state = source.seed != 0 ? source.seed : 1;
+            const int impulseSpacing = juce::jmax(1, static_cast<int>(std::lround(source.period * source.sampleRate)));
+            double phase = 0.0;
+
+            for (int i = 0; i < length; ++i) {
+                float sample = 0.0f;
+
+                switch (source.kind) {
+                case GoldenSource::Kind::Sine:
+                    sample = amplitude * static_cast<float>(
+                        std::sin(juce::MathConstants<double>::twoPi * source.frequency * i / source.sampleRate));
+                    break;
+                case GoldenSource::Kind::Noise:
+                    sample = amplitude * nextNoise(state);
+                    break;
+                case GoldenSource::Kind::Impulses:
+                    sample = (i % impulseSpacing) == 0 ? amplitude : 0.0f;
+                    break;
+                case GoldenSource::Kind::Sweep: {
+                    // Exponential sweep, phase accumulated so it stays continuous
+                    const double t = static_cast<double>(i) / length;
+                    const double f = source.frequency * std::pow(source.endFrequency / source.frequency, t);
+                    sample = amplitude * static_cast<float>(std::sin(phase));
+                    phase += juce::MathConstants<double>::twoPi * f / source.sampleRate;
+                    break;
+                }
+                }
+
+                for (int ch = 0; ch < source.channels; ++ch) {
+                    buffer.setSample(ch, i, sample);
+                }
+            }
+        }
+
+        struct ActiveFade
+        {
+            double start = 0.0;
+            double seconds = 0.0;
+            float from = 1.0f;
+            float to = 0.0f;
+        };
+    }
+
+    bool GoldenScenario::load(const juce::File& file, GoldenScenario& scenario, juce::String& error)
+    {
+        juce::var root;
+        const juce::Result parsed = juce::JSON::parse(file.loadFileAsString(), root);
+        if (parsed.failed() || !root.isObject()) {
+            error = "invalid JSON: " + parsed.getErrorMessage();
+            return false;
+        }
+
+        scenario = GoldenScenario();
+        scenario.name = root.getProperty("name", file.getFileNameWithoutExtension()).toString();
+        scenario.sampleRate = root.getProperty("sampleRate", scenario.sampleRate);
+        scenario.bufferSize = root.getProperty("bufferSize", scenario.bufferSize);
+        scenario.channels = root.getProperty("channels", scenario.channels);
+        scenario.duration = root.getProperty("duration", scenario.duration);
+
+        if (scenario.sampleRate <= 0.0 || scenario.bufferSize <= 0 || scenario.channels <= 0 || scenario.duration <= 0.0) {
+            error = "sampleRate, bufferSize, channels and duration must be positive";
+            return false;
+        }
+
+        if (const auto* sources = root["sources"].getDynamicObject()) {
+            for (const auto& entry : sources->getProperties()) {
+                const juce::var& spec = entry.value;
+                GoldenSource source;
+                source.name = entry.name.toString();
+
+                if (!parseSourceKind(spec.getProperty("kind", "sine").toString(), source.kind)) {
+                    error = "source '" + source.name + "': unknown kind";
+                    return false;
+                }
+
+                source.sampleRate = spec.getProperty("sampleRate", scenario.sampleRate);
+                source.channels = spec.getProperty("channels", scenario.channels);
+                source.seconds = spec.getProperty("seconds", scenario.duration);
+                source.amplitude = spec.getProperty("amplitude", source.amplitude);
+                source.frequency = spec.getProperty("frequency", source.frequency);
+                source.endFrequency = spec.getProperty("endFrequency", source.endFrequency);
+                source.period = spec.getProperty("period", source.period);
+                source.seed = static_cast<juce::uint32>(static_cast<int>(spec.getProperty("seed", 1)));
+
+                scenario.sources.push_back(source);
+            }
+        }
+
+        if (scenario.sources.empty()) {
+            error = "no sources";
+            return false;
+        }
+
+        if (const auto* steps = root["steps"].getArray()) {
+            for (const juce::var& spec : *steps) {
+                GoldenStep step;
+                step.at = spec.getProperty("at", 0.0);
+                step.source = spec.getProperty("source", scenario.sources.front().name).toString();
+                step.value = spec.getProperty("value", 0.0);
+                step.seconds = spec.getProperty("seconds", 0.0);
+
+                if (!parseAction(spec.getProperty("do", "").toString(), step.action)) {
+                    error = "step at " + juce::String(step.at) + ": unknown action";
+                    return false;
+                }
+
+                const bool known = std::any_of(scenario.sources.begin(), scenario.sources.end(),
+                    [&step](const GoldenSource& s) { return s.name == step.source; });
+                if (!known) {
+                    error = "step at " + juce::String(step.at) + ": unknown source '" + step.source + "'";
+                    return false;
+                }
+
+                scenario.steps.push_back(step);
+            }
+        }
+
+        std::stable_sort(scenario.steps.begin(), scenario.steps.end(),
+            [](const GoldenStep& a, const GoldenStep& b) { return a.at < b.at; });
+
+        const juce::var compare = root["compare"];
+        scenario.compare.exact = compare.getProperty("mode", "exact").toString() == "exact";
+        scenario.compare.peakTolerance = compare.getProperty("peak", scenario.compare.peakTolerance);
+        scenario.compare.rmsTolerance = compare.getProperty("rms", scenario.compare.rmsTolerance);
+
+        return true;
+    }
+
+    bool GoldenScenario::render(const juce::File& workDir, juce::AudioBuffer<float>& output, juce::String& error) const
+    {
+        // Synthesize the sources
+        std::map<juce::String, juce::File> sourceFiles;
+        for (const auto& source : sources) {
+            juce::AudioBuffer<float> signal;
+            synthesize(source, signal);
+
+            const juce::File file = workDir.getChildFile(name + "_" + source.name + ".wav");
+            if (!writeWav(file, signal, source.sampleRate)) {
+                error = "cannot write source " + file.getFullPathName();
+                return false;
+            }
+            sourceFiles[source.name] = file;
+        }
+
+        NullAudioSettings settings;
+        settings.sampleRate = sampleRate;
+        settings.bufferSize = bufferSize;
+        settings.outputChannels = channels;
+        settings.clock = NullAudioSettings::Clock::Manual;
+        settings.captureRingSeconds = 1.0;   // Drained after every block
+
+        JuceAudioEngine engine;
+        if (!engine.initializeNull(settings) || engine.getNullDevice() == nullptr) {
+            error = "null device failed to start";
+            return false;
+        }
+
+        NullAudioIODevice* device = engine.getNullDevice();
+
+        std::map<juce::String, int> players;
+        for (const auto& entry : sourceFiles) {
+            const int id = engine.createPlayer(entry.second.getFullPathName().toStdString());
+            if (id < 0) {
+                error = "cannot load source " + entry.first;
+                engine.shutdown();
+                return false;
+            }
+            players[entry.first] = id;
+        }
+
+        const int totalSamples = static_cast<int>(std::lround(duration * sampleRate));
+        output.setSize(channels, totalSamples);
+        output.clear();
+
+        juce::AudioBuffer<float> block(channels, bufferSize);
+        std::map<juce::String, ActiveFade> fades;
+        size_t nextStep = 0;
+        int written = 0;
+
+        while (written < totalSamples) {
+            const double now = written / sampleRate;
+
+            // Apply every step due at or before this block boundary
+            while (nextStep < steps.size() && steps[nextStep].at <= now) {
+                const GoldenStep& step = steps[nextStep++];
+                AudioPlayer* player = engine.getPlayer(players[step.source]);
+                if (!player) {
+                    continue;
+                }
+
+                switch (step.action) {
+                case GoldenStep::Action::Play:   player->play(); break;
+                case GoldenStep::Action::Stop:   player->stop(); break;
+                case GoldenStep::Action::Pause:  player->pause(); break;
+                case GoldenStep::Action::Resume: player->resume(); break;
+                case GoldenStep::Action::Seek:   player->setPosition(step.value); break;
+                case GoldenStep::Action::Volume:
+                    fades.erase(step.source);
+                    player->setVolume(static_cast<float>(step.value));
+                    break;
+                case GoldenStep::Action::Fade:
+                    fades[step.source] = { now, step.seconds, player->getVolume(), static_cast<float>(step.value) };
+                    break;
+                }
+            }
+
+            // Control-rate fades, one volume update per block like the cue engine
+            for (auto it = fades.begin(); it != fades.end();) {
+                AudioPlayer* player = engine.getPlayer(players[it->first]);
+                const ActiveFade& fade = it->second;
+                const double progress = fade.seconds > 0.0 ? juce::jlimit(0.0, 1.0, (now - fade.start) / fade.seconds) : 1.0;
+
+                if (player) {
+                    player->setVolume(fade.from + (fade.to - fade.from) * static_cast<float>(progress));
+                }
+                it = progress >= 1.0 ? fades.erase(it) : std::next(it);
+            }
+
+            if (device->renderBlocks(1) != 1) {
+                error = "render stalled at sample " + juce::String(written);
+                engine.shutdown();
+                return false;
+            }
+
+            const int got = device->readCapture(block, bufferSize);
+            const int toCopy = juce::jmin(got, totalSamples - written);
+            for (int ch = 0; ch < channels; ++ch) {
+                output.copyFrom(ch, written, block, ch, 0, toCopy);
+            }
+            written += toCopy;
+
+            if (got == 0) {
+                error = "capture ring empty at sample " + juce::String(written);
+                engine.shutdown();
+                return false;
+            }
+        }
+
+        for (const auto& entry : players) {
+            engine.removePlayer(entry.second);
+        }
+        engine.shutdown();
+        return true;
+    }
+
+} // namespace CueForge
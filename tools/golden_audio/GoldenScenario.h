@@ -0,0 +1,67 @@
+// ============================================================================
+// GoldenScenario.h - Scripted cue scenarios rendered through the null device
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#pragma once
+
+#include "AudioCompare.h"
+#include <juce_core/juce_core.h>
+#include <vector>
+
+namespace CueForge {
+
+    /**
+     * Test signal synthesized to a WAV before rendering, so scenarios never
+     * depend on media checked into the tree
+     */
+    struct GoldenSource
+    {
+        enum class Kind { Sine, Noise, Impulses, Sweep };
+
+        juce::String name;
+        Kind kind = Kind::Sine;
+        double sampleRate = 48000.0;   // File rate - differs from the device to exercise resampling
+        int channels = 2;
+        double seconds = 1.0;
+        double amplitude = 0.5;
+        double frequency = 1000.0;     // Sine; sweep start
+        double endFrequency = 8000.0;  // Sweep end
+        double period = 0.25;          // Impulse spacing
+        juce::uint32 seed = 1;         // Noise
+    };
+
+    /**
+     * Transport action applied at a block boundary
+     */
+    struct GoldenStep
+    {
+        enum class Action { Play, Stop, Pause, Resume, Seek, Volume, Fade };
+
+        double at = 0.0;
+        Action action = Action::Play;
+        juce::String source;
+        double value = 0.0;      // Seek position, volume, or fade target
+        double seconds = 0.0;    // Fade length
+    };
+
+    struct GoldenScenario
+    {
+        juce::String name;
+        double sampleRate = 48000.0;
+        int bufferSize = 256;
+        int channels = 2;
+        double duration = 1.0;
+
+        std::vector<GoldenSource> sources;
+        std::vector<GoldenStep> steps;   // Sorted by time after load
+        CompareSettings compare;
+
+        static bool load(const juce::File& file, GoldenScenario& scenario, juce::String& error);
+
+        // Render the scenario through JuceAudioEngine on a manually clocked
+        // null device. Source WAVs are written to workDir.
+        bool render(const juce::File& workDir, juce::AudioBuffer<float>& output, juce::String& error) const;
+    };
+
+} // namespace CueForge
@@ -0,0 +1,149 @@
+// ============================================================================
+// main.cpp - Golden-audio regression harness
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+//
+// Renders every scenario in scenarios/*.json through JuceAudioEngine on a
+// manually clocked null device and compares the result with golden/<name>.wav.
+//
+//   cueforge-golden-audio                  Compare all scenarios
+//   cueforge-golden-audio --update         Re-render and overwrite the goldens
+//   cueforge-golden-audio --filter fade    Only scenarios whose name contains "fade"
+//   cueforge-golden-audio --out /tmp/ga    Write <name>.actual.wav / <name>.diff.wav on failure
+//   cueforge-golden-audio --dir <path>     Scenario root (default: source tree)
+//
+// Exit code is 0 only if every selected scenario matched its golden.
+
+#include "GoldenScenario.h"
+#include <juce_events/juce_events.h>
+#include <iostream>
+
+#ifndef CUEFORGE_GOLDEN_AUDIO_DIR
+#define CUEFORGE_GOLDEN_AUDIO_DIR "."
+#endif
+
+using namespace CueForge;
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInit;
+
+    juce::File root(juce::String(CUEFORGE_GOLDEN_AUDIO_DIR));
+    juce::File outDir;
+    juce::String filter;
+    bool update = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const juce::String arg(argv[i]);
+        if (arg == "--update") {
+            update = true;
+        } else if (arg == "--filter" && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (arg == "--out" && i + 1 < argc) {
+            outDir = juce::File::getCurrentWorkingDirectory().getChildFile(argv[++i]);
+        } else if (arg == "--dir" && i + 1 < argc) {
+            root = juce::File::getCurrentWorkingDirectory().getChildFile(argv[++i]);
+        } else {
+            std::cerr << "usage: cueforge-golden-audio [--update] [--filter text] [--out dir] [--dir path]\n";
+            return 2;
+        }
+    }
+
+    const juce::File scenarioDir = root.getChildFile("scenarios");
+    const juce::File goldenDir = root.getChildFile("golden");
+    const juce::File workDir = juce::File::getSpecialLocation(juce::File::tempDirectory)
+        .getChildFile("cueforge-golden-audio");
+    workDir.createDirectory();
+
+    juce::Array<juce::File> files = scenarioDir.findChildFiles(juce::File::findFiles, false, "*.json");
+    files.sort();
+
+    if (files.isEmpty()) {
+        std::cerr << "No scenarios in " << scenarioDir.getFullPathName() << "\n";
+        return 2;
+    }
+
+    int passed = 0;
+    int failed = 0;
+    const juce::uint32 startMs = juce::Time::getMillisecondCounter();
+
+    for (const auto& file : files) {
+        GoldenScenario scenario;
+        juce::String error;
+
+        if (!GoldenScenario::load(file, scenario, error)) {
+            std::cout << "ERROR " << file.getFileName() << ": " << error << "\n";
+            ++failed;
+            continue;
+        }
+
+        if (filter.isNotEmpty() && !scenario.name.contains(filter)) {
+            continue;
+        }
+
+        juce::AudioBuffer<float> actual;
+        if (!scenario.render(workDir, actual, error)) {
+            std::cout << "ERROR " << scenario.name << ": " << error << "\n";
+            ++failed;
+            continue;
+        }
+
+        const juce::File goldenFile = goldenDir.getChildFile(scenario.name + ".wav");
+
+        if (update) {
+            if (writeWav(goldenFile, actual, scenario.sampleRate)) {
+                std::cout << "WROTE " << goldenFile.getFullPathName() << "\n";
+                ++passed;
+            } else {
+                std::cout << "ERROR cannot write " << goldenFile.getFullPathName() << "\n";
+                ++failed;
+            }
+            continue;
+        }
+
+        juce::AudioBuffer<float> expected;
+        double goldenRate = 0.0;
+        if (!readWav(goldenFile, expected, goldenRate)) {
+            std::cout << "MISSING " << scenario.name << ": no golden at "
+                      << goldenFile.getFullPathName() << " (run with --update)\n";
+            ++failed;
+            continue;
+        }
+
+        CompareResult result = compareAudio(actual, expected, scenario.compare);
+        if (goldenRate != scenario.sampleRate) {
+            result.pass = false;
+            result.error = "golden sample rate " + juce::String(goldenRate);
+        }
+
+        std::cout << (result.pass ? "PASS  " : "FAIL  ") << scenario.name
+                  << (scenario.compare.exact ? " [exact] " : " [tolerance] ")
+                  << result.describe(scenario.sampleRate) << "\n";
+
+        if (result.pass) {
+            ++passed;
+            continue;
+        }
+
+        ++failed;
+
+        if (outDir != juce::File()) {
+            // Difference signal over the overlapping region, for listening / inspection
+            const int length = juce::jmin(actual.getNumSamples(), expected.getNumSamples());
+            const int channels = juce::jmin(actual.getNumChannels(), expected.getNumChannels());
+            juce::AudioBuffer<float> diff(channels, length);
+            for (int ch = 0; ch < channels; ++ch) {
+                diff.copyFrom(ch, 0, actual, ch, 0, length);
+                diff.addFrom(ch, 0, expected, ch, 0, length, -1.0f);
+            }
+
+            writeWav(outDir.getChildFile(scenario.name + ".actual.wav"), actual, scenario.sampleRate);
+            writeWav(outDir.getChildFile(scenario.name + ".diff.wav"), diff, scenario.sampleRate);
+        }
+    }
+
+    std::cout << "\n" << passed << " passed, " << failed << " failed in "
+              << (juce::Time::getMillisecondCounter() - startMs) << " ms\n";
+
+    return failed == 0 ? 0 : 1;
+}
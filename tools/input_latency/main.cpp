@@ -0,0 +1,149 @@
+// ============================================================================
+// main.cpp - Live input passthrough latency check on a loopback null device
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+//
+// Plays an impulse on output 1 of a loopback null device (each output is
+// cabled back to the same-numbered input, one device block later, as on
+// hardware) and routes input 1 to output 2 through a live input. The
+// impulse must reappear on output 2 exactly one block after output 1 - the
+// device's own period - with unity gain, i.e. the passthrough itself adds
+// no buffering and no copy that changes the signal.
+//
+//   cueforge-input-latency                    Buffer sizes 32..1024
+//   cueforge-input-latency --buffer 256       One buffer size
+//
+// Exit code: 0 every size exactly one block, 1 mismatch, 2 setup error.
+
+#include "audio/JuceAudioEngine.h"
+#include "audio/NullAudioDevice.h"
+#include "golden_audio/AudioCompare.h"
+#include <juce_events/juce_events.h>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+using namespace CueForge;
+
+namespace {
+
+    constexpr double SampleRate = 48000.0;
+    constexpr int ImpulseAt = 1000;   // Samples into the file
+
+    int firstAbove(const juce::AudioBuffer<float>& buffer, int channel, float threshold)
+    {
+        for (int i = 0; i < buffer.getNumSamples(); ++i) {
+            if (std::abs(buffer.getSample(channel, i)) > threshold) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    // Returns the measured latency in samples, or -1 on a setup failure
+    int measure(int bufferSize, const juce::File& impulseFile, float& passthroughPeak, float& sourcePeak)
+    {
+        NullAudioSettings settings;
+        settings.sampleRate = SampleRate;
+        settings.bufferSize = bufferSize;
+        settings.outputChannels = 2;
+        settings.inputChannels = 2;
+        settings.loopback = true;
+        settings.clock = NullAudioSettings::Clock::Manual;
+        settings.captureRingSeconds = 2.0;
+
+        JuceAudioEngine engine;
+        if (!engine.initializeNull(settings) || engine.getNullDevice() == nullptr) {
+            std::cerr << "Null device failed to start\n";
+            return -1;
+        }
+        NullAudioIODevice* device = engine.getNullDevice();
+
+        // Input 1 -> output 2 at unity, fully ramped in before the impulse
+        const int liveInput = engine.createLiveInput();
+        engine.setLiveInputRoute(liveInput, 0, 1, 1.0f);
+        engine.setLiveInputGain(liveInput, 1.0f);
+        device->renderBlocks(4);
+
+        const int player = engine.createPlayer(impulseFile.getFullPathName().toStdString());
+        if (player < 0) {
+            std::cerr << "Cannot load " << impulseFile.getFullPathName() << "\n";
+            return -1;
+        }
+        engine.getPlayer(player)->play();
+
+        const int blocks = (ImpulseAt + 4 * bufferSize) / bufferSize + 4;
+        device->renderBlocks(blocks);
+
+        juce::AudioBuffer<float> captured;
+        device->readCapture(captured, device->getCaptureAvailable());
+        engine.removePlayer(player);
+        engine.removeLiveInput(liveInput);
+        engine.shutdown();
+
+        const int source = firstAbove(captured, 0, 0.5f);
+        const int passthrough = firstAbove(captured, 1, 0.5f);
+        if (source < 0 || passthrough < 0) {
+            std::cerr << "Impulse not found in the capture (buffer " << bufferSize << ")\n";
+            return -1;
+        }
+
+        sourcePeak = captured.getSample(0, source);
+        passthroughPeak = captured.getSample(1, passthrough);
+        return passthrough - source;
+    }
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInit;
+
+    std::vector<int> bufferSizes{ 32, 64, 128, 256, 512, 1024 };
+    for (int i = 1; i < argc; ++i) {
+        const juce::String arg(argv[i]);
+        if (arg == "--buffer" && i + 1 < argc) {
+            bufferSizes = { juce::jlimit(16, 8192, juce::String(argv[++i]).getIntValue()) };
+        } else {
+            std::cerr << "usage: cueforge-input-latency [--buffer n]\n";
+            return 2;
+        }
+    }
+
+    // Stereo file, single full-scale sample on the first channel
+    juce::AudioBuffer<float> impulse(2, static_cast<int>(SampleRate));
+    impulse.clear();
+    impulse.setSample(0, ImpulseAt, 1.0f);
+
+    const juce::File impulseFile = juce::File::getSpecialLocation(juce::File::tempDirectory)
+        .getChildFile("cueforge-input-latency-impulse.wav");
+    if (!writeWav(impulseFile, impulse, SampleRate)) {
+        std::cerr << "Cannot write " << impulseFile.getFullPathName() << "\n";
+        return 2;
+    }
+
+    bool pass = true;
+    for (int bufferSize : bufferSizes) {
+        float passthroughPeak = 0.0f;
+        float sourcePeak = 0.0f;
+        const int latency = measure(bufferSize, impulseFile, passthroughPeak, sourcePeak);
+        if (latency < 0) {
+            impulseFile.deleteFile();
+            return 2;
+        }
+
+        const bool exact = latency == bufferSize;
+        const bool unity = std::abs(passthroughPeak - sourcePeak) <= 1.0e-6f;
+        pass = pass && exact && unity;
+
+        std::cout << "buffer " << bufferSize << ": input to output " << latency << " samples ("
+                  << latency * 1000.0 / SampleRate << " ms), gain "
+                  << passthroughPeak / sourcePeak
+                  << ((exact && unity) ? "  ok" : "  MISMATCH") << "\n";
+    }
+
+    impulseFile.deleteFile();
+
+    std::cout << "\n" << (pass ? "PASS" : "FAIL") << "\n";
+    return pass ? 0 : 1;
+}
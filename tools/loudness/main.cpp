@@ -0,0 +1,198 @@
+// ============================================================================
+// main.cpp - Loudness measurement accuracy, speed and cache round trip
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+//
+// Checks of the BS.1770 / EBU R128 loudness meter against signals whose
+// answer is known:
+//
+//   1. Integrated: a 1 kHz stereo sine at -23 dBFS reads -23 LUFS.
+//   2. Gating: 10 s at -36, 60 s at -23, 10 s at -36 still reads -23,
+//      because the relative gate drops the quiet ends.
+//   3. Range: 20 s at -20 dBFS then 20 s at -30 has a 10 LU range.
+//   4. True peak: a 12 kHz sine at 48 kHz sampled 45 degrees off its
+//      crests peaks 3 dB above its highest sample.
+//   5. Analyser: files measured in the background match the meter, the
+//      cache survives a save and load, and an edited file is measured
+//      again. Analysis speed is reported in multiples of real time.
+//
+//   cueforge-loudness
+//
+// Exit code: 0 pass, 1 mismatch, 2 setup error.
+
+#include "audio/LoudnessAnalyzer.h"
+#include "golden_audio/AudioCompare.h"
+#include <juce_events/juce_events.h>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+using namespace CueForge;
+
+namespace {
+
+    constexpr double SampleRate = 48000.0;
+
+    struct Segment
+    {
+        double seconds;
+        double dbfs;
+    };
+
+    juce::File tempFile(const char* name)
+    {
+        return juce::File::getSpecialLocation(juce::File::tempDirectory).getChildFile(name);
+    }
+
+    // Stereo sine, each segment at its own peak level
+    juce::AudioBuffer<float> makeSine(double frequency, std::initializer_list<Segment> segments, double phase = 0.0)
+    {
+        int total = 0;
+        for (const Segment& segment : segments) {
+            total += static_cast<int>(segment.seconds * SampleRate);
+        }
+
+        juce::AudioBuffer<float> buffer(2, total);
+        int position = 0;
+        for (const Segment& segment : segments) {
+            const double amplitude = juce::Decibels::decibelsToGain(segment.dbfs);
+            const int end = position + static_cast<int>(segment.seconds * SampleRate);
+            for (; position < end; ++position) {
+                const float sample = static_cast<float>(amplitude
+                    * std::sin(juce::MathConstants<double>::twoPi * frequency * position / SampleRate + phase));
+                buffer.setSample(0, position, sample);
+                buffer.setSample(1, position, sample);
+            }
+        }
+        return buffer;
+    }
+
+    LoudnessInfo measure(const juce::AudioBuffer<float>& buffer)
+    {
+        LoudnessMeter meter;
+        meter.prepare(buffer.getNumChannels(), SampleRate);
+        meter.process(buffer.getArrayOfReadPointers(), buffer.getNumSamples());
+        return meter.getResult();
+    }
+
+    bool report(const char* name, double value, double expected, double tolerance, const char* unit)
+    {
+        const bool ok = std::abs(value - expected) <= tolerance;
+        std::cout << "  " << name << ": " << value << " " << unit << " (expected " << expected
+                  << " +/- " << tolerance << ")" << (ok ? "  ok" : "  FAIL") << "\n";
+        return ok;
+    }
+
+    int checkMeter()
+    {
+        std::cout << "Loudness meter at " << SampleRate << " Hz\n";
+        bool pass = true;
+
+        const LoudnessInfo sine = measure(makeSine(1000.0, { { 20.0, -23.0 } }));
+        pass = report("1 kHz at -23 dBFS, integrated", sine.integratedLufs, -23.0, 0.1, "LUFS") && pass;
+
+        const LoudnessInfo gated = measure(makeSine(1000.0, { { 10.0, -36.0 }, { 60.0, -23.0 }, { 10.0, -36.0 } }));
+        pass = report("Quiet ends gated, integrated", gated.integratedLufs, -23.0, 0.1, "LUFS") && pass;
+
+        const LoudnessInfo range = measure(makeSine(1000.0, { { 20.0, -20.0 }, { 20.0, -30.0 } }));
+        pass = report("-20 then -30 dBFS, range", range.loudnessRange, 10.0, 1.0, "LU") && pass;
+
+        // At 12 kHz there are four samples per cycle; a 45 degree offset puts
+        // every one of them at 0.707 of the crest
+        const juce::AudioBuffer<float> offset = makeSine(12000.0, { { 2.0, -6.0 } }, juce::MathConstants<double>::pi / 4.0);
+        const double samplePeak = juce::Decibels::gainToDecibels(offset.getMagnitude(0, 0, offset.getNumSamples()));
+        const LoudnessInfo peak = measure(offset);
+        std::cout << "  12 kHz at -6 dBFS, sample peak " << samplePeak << " dBFS\n";
+        pass = report("12 kHz at -6 dBFS, true peak", peak.truePeakDbtp, -6.0, 0.5, "dBTP") && pass;
+
+        return pass ? 0 : 1;
+    }
+
+    // Returns 0 pass, 1 mismatch, 2 setup error
+    int checkAnalyser(juce::AudioFormatManager& formats)
+    {
+        std::cout << "\nBackground analyser and cache\n";
+
+        const juce::AudioBuffer<float> programme = makeSine(1000.0, { { 10.0, -36.0 }, { 60.0, -23.0 }, { 10.0, -36.0 } });
+        const juce::File audioFile = tempFile("cueforge-loudness-programme.wav");
+        const juce::File cacheFile = tempFile("cueforge-loudness-cache.json");
+        if (!writeWav(audioFile, programme, SampleRate)) {
+            std::cerr << "Cannot write " << audioFile.getFullPathName() << "\n";
+            return 2;
+        }
+        const std::string path = audioFile.getFullPathName().toStdString();
+
+        bool pass = true;
+        {
+            LoudnessAnalyzer analyzer(formats);
+            const double start = juce::Time::getMillisecondCounterHiRes();
+            analyzer.request(path);
+            while (analyzer.getPendingCount() > 0) {
+                juce::Thread::sleep(1);
+            }
+            const double seconds = (juce::Time::getMillisecondCounterHiRes() - start) / 1000.0;
+
+            LoudnessInfo info;
+            if (!analyzer.find(path, info)) {
+                std::cerr << "No result for " << path << "\n";
+                audioFile.deleteFile();
+                return 2;
+            }
+            std::cout << "  Analysed " << info.seconds << " s in " << 1000.0 * seconds << " ms ("
+                      << info.seconds / seconds << "x real time)\n";
+            pass = report("Analysed, integrated", info.integratedLufs, -23.0, 0.1, "LUFS") && pass;
+            pass = report("Gain to -16 LUFS", info.normalizationGainDb(-16.0), 7.0, 0.1, "dB") && pass;
+
+            if (!analyzer.saveCache(cacheFile.getFullPathName().toStdString())) {
+                std::cerr << "Cannot write " << cacheFile.getFullPathName() << "\n";
+                audioFile.deleteFile();
+                return 2;
+            }
+        }
+
+        LoudnessAnalyzer reloaded(formats);
+        LoudnessInfo cached;
+        const bool loaded = reloaded.loadCache(cacheFile.getFullPathName().toStdString())
+            && reloaded.find(path, cached);
+        pass = loaded && pass;
+        std::cout << "  Cache reloaded: " << (loaded ? "yes" : "no") << (loaded ? "  ok" : "  FAIL") << "\n";
+        if (loaded) {
+            pass = report("Cached, integrated", cached.integratedLufs, -23.0, 0.1, "LUFS") && pass;
+        }
+
+        // A changed file must not be answered from the cache
+        audioFile.setLastModificationTime(juce::Time::getCurrentTime() + juce::RelativeTime::seconds(10.0));
+        const bool stale = !reloaded.find(path, cached);
+        pass = stale && pass;
+        std::cout << "  Edited file ignored in cache: " << (stale ? "yes  ok" : "no  FAIL") << "\n";
+
+        audioFile.deleteFile();
+        cacheFile.deleteFile();
+        return pass ? 0 : 1;
+    }
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInit;
+
+    if (argc > 1) {
+        std::cerr << "usage: cueforge-loudness\n";
+        return 2;
+    }
+
+    juce::AudioFormatManager formats;
+    formats.registerBasicFormats();
+
+    int result = checkMeter();
+    const int analyser = checkAnalyser(formats);
+    if (analyser == 2) {
+        return 2;
+    }
+    result = std::max(result, analyser);
+
+    std::cout << "\n" << (result == 0 ? "PASS" : "FAIL") << "\n";
+    return result;
+}
@@ -0,0 +1,249 @@
+// ============================================================================
+// main.cpp - Primary/backup mirror sequence and lag bounds under edit load
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+//
+// Runs a MirrorPrimary and a MirrorBackup in one process over localhost,
+// each on its own CueManager, and drives renames on the primary at a fixed
+// rate. Every name carries the edit's serial, so the backup side can time
+// each edit from the primary's setName() to its own cueUpdated. Checks:
+//
+//   1. Sequence: the backup never reports a gap, is never cut loose for
+//      lagging, and once the load stops it has applied the primary's last
+//      sequence and holds the same names.
+//   2. Lag: edit latency p99 and the backup's own queueing lag estimate
+//      (refreshed by every heartbeat) stay within the bounds.
+//
+// Shadow playback is off; there is no audio engine in the loop.
+//
+//   cueforge-mirror-bench --rate 5000 --seconds 10 --max-latency 50
+//
+// Exit code: 0 pass, 1 bound exceeded, 2 setup error.
+
+#include "core/CueManager.h"
+#include "core/Cue.h"
+#include "network/MirrorSync.h"
+#include "common/LatencyStats.h"
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QRandomGenerator>
+#include <QTextStream>
+#include <QTimer>
+
+using namespace CueForge;
+
+namespace {
+
+    QJsonObject buildWorkspace(int cues)
+    {
+        QJsonArray list;
+        for (int i = 0; i < cues; ++i) {
+            QJsonObject cue;
+            cue["id"] = QString("mirror-%1").arg(i);
+            cue["type"] = cueTypeToString(CueType::Wait);
+            cue["number"] = QString::number(i + 1);
+            cue["name"] = QString("Cue %1").arg(i + 1);
+            cue["duration"] = 1.0;
+            list.append(cue);
+        }
+
+        QJsonObject workspace;
+        workspace["cues"] = list;
+        return workspace;
+    }
+
+    // Edit names are "edit <serial>"; anything else is not an edit
+    qint64 editSerial(const QString& name)
+    {
+        if (!name.startsWith(QLatin1String("edit "))) {
+            return -1;
+        }
+        bool ok = false;
+        const qint64 serial = name.mid(5).toLongLong(&ok);
+        return ok ? serial : -1;
+    }
+
+    // Spins the event loop until done() or the timeout; returns done()
+    template <typename Predicate>
+    bool waitFor(Predicate done, int timeoutMs)
+    {
+        QElapsedTimer timer;
+        timer.start();
+        while (!done() && timer.elapsed() < timeoutMs) {
+            QCoreApplication::processEvents(QEventLoop::AllEvents, 5);
+        }
+        return done();
+    }
+
+    void quietMessageHandler(QtMsgType type, const QMessageLogContext&, const QString& message)
+    {
+        // Both CueManagers log every cue they create, and the backup logs
+        // every snapshot
+        if (type == QtDebugMsg || type == QtInfoMsg) {
+            return;
+        }
+        QTextStream(stderr) << message << Qt::endl;
+    }
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("cueforge-mirror-bench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Mirror sequence and lag bounds under edit load over localhost");
+    parser.addHelpOption();
+    parser.addOptions({
+        { "rate", "Edits per second on the primary (default 5000).", "n", "5000" },
+        { "seconds", "Length of the load (default 10).", "s", "10" },
+        { "cues", "Cues in the workspace; edits pick one at random (default 500).", "n", "500" },
+        { "max-latency", "Bound on edit latency p99, primary to backup (ms, default 50).", "ms", "50" },
+        { "max-lag", "Bound on the backup's worst lag estimate (ms, default 100).", "ms", "100" },
+        { "verbose", "Keep CueManager and mirror debug output." },
+    });
+    parser.process(app);
+
+    if (!parser.isSet("verbose")) {
+        qInstallMessageHandler(quietMessageHandler);
+    }
+
+    const int rate = qMax(1, parser.value("rate").toInt());
+    const int seconds = qMax(1, parser.value("seconds").toInt());
+    const int cueCount = qMax(1, parser.value("cues").toInt());
+    const double maxLatency = parser.value("max-latency").toDouble();
+    const double maxLag = parser.value("max-lag").toDouble();
+
+    QTextStream out(stdout);
+
+    CueManager primaryCues;
+    CueManager backupCues;
+    primaryCues.loadWorkspace(buildWorkspace(cueCount));
+
+    MirrorPrimary primary(&primaryCues);
+    MirrorBackup backup(&backupCues);
+    backup.setShadowPlayback(false);
+
+    if (!primary.listen(QHostAddress::LocalHost, 0)) {
+        QTextStream(stderr) << "Cannot listen on localhost" << Qt::endl;
+        return 2;
+    }
+
+    bool snapshot = false;
+    quint64 gaps = 0;
+    quint64 lagging = 0;
+    int disconnects = 0;
+    QObject::connect(&backup, &MirrorBackup::snapshotApplied, [&](int) { snapshot = true; });
+    QObject::connect(&backup, &MirrorBackup::sequenceGap, [&](quint64, quint64) { ++gaps; });
+    QObject::connect(&primary, &MirrorPrimary::backupLagging, [&](const QString&, quint64) { ++lagging; });
+    QObject::connect(&backup, &MirrorBackup::connectedChanged, [&](bool connected) {
+        if (!connected) {
+            ++disconnects;
+        }
+    });
+
+    backup.connectToPrimary(QStringLiteral("127.0.0.1"), primary.serverPort());
+    if (!waitFor([&]() { return snapshot; }, 5000)) {
+        QTextStream(stderr) << "Backup did not receive a snapshot" << Qt::endl;
+        return 2;
+    }
+
+    out << "Mirroring " << cueCount << " cues over localhost port " << primary.serverPort()
+        << ", " << rate << " edits/s for " << seconds << " s" << Qt::endl;
+
+    // Edit latency: each edit's send time, looked up when the backup applies it
+    QElapsedTimer clock;
+    clock.start();
+    QHash<qint64, qint64> sentAtNs;
+    LatencyStats latency;
+    QObject::connect(&backupCues, &CueManager::cueUpdated, [&](Cue* cue) {
+        const auto it = sentAtNs.constFind(editSerial(cue->name()));
+        if (it != sentAtNs.constEnd()) {
+            latency.add((clock.nsecsElapsed() - it.value()) / 1.0e6);
+        }
+    });
+
+    // The backup's own lag estimate, refreshed by every heartbeat it receives
+    LatencyStats lag;
+    QTimer lagTimer;
+    lagTimer.setInterval(50);
+    QObject::connect(&lagTimer, &QTimer::timeout, [&]() { lag.add(static_cast<double>(backup.lagMs())); });
+    lagTimer.start();
+
+    // Load: catch up to rate * elapsed on every tick
+    QRandomGenerator rng(0xC0EF0);
+    qint64 edits = 0;
+    const qint64 totalEdits = static_cast<qint64>(rate) * seconds;
+    QTimer editTimer;
+    editTimer.setTimerType(Qt::PreciseTimer);
+    editTimer.setInterval(1);
+    QObject::connect(&editTimer, &QTimer::timeout, [&]() {
+        const qint64 due = qMin(totalEdits, clock.nsecsElapsed() * rate / 1000000000);
+        for (; edits < due; ++edits) {
+            Cue* cue = primaryCues.getCue(QString("mirror-%1").arg(rng.bounded(cueCount)));
+            sentAtNs.insert(edits, clock.nsecsElapsed());
+            cue->setName(QString("edit %1").arg(edits));
+        }
+        if (edits >= totalEdits) {
+            editTimer.stop();
+        }
+    });
+    editTimer.start();
+
+    waitFor([&]() { return !editTimer.isActive(); }, (seconds + 30) * 1000);
+    const double loadSeconds = clock.elapsed() / 1000.0;
+
+    // Drain: the backup must reach the primary's last sequence
+    const bool caughtUp = waitFor([&]() {
+        return backup.isConnected() && backup.lastAppliedSequence() == primary.lastSequence();
+    }, 5000);
+    lagTimer.stop();
+
+    int mismatched = 0;
+    for (int i = 0; i < cueCount; ++i) {
+        const QString id = QString("mirror-%1").arg(i);
+        const Cue* mirrored = backupCues.getCue(id);
+        if (!mirrored || mirrored->name() != primaryCues.getCue(id)->name()) {
+            ++mismatched;
+        }
+    }
+
+    // Report
+    out << Qt::endl;
+    out << "  Edits            " << edits << " in " << QString::number(loadSeconds, 'f', 2) << " s ("
+        << qRound(edits / loadSeconds) << "/s), " << latency.count() << " applied after coalescing" << Qt::endl;
+    out << "  Sequence         primary " << primary.lastSequence() << ", backup " << backup.lastAppliedSequence()
+        << ", " << gaps << " gaps, " << lagging << " lag cutoffs, " << disconnects << " disconnects" << Qt::endl;
+    out << "  Names            " << (cueCount - mismatched) << " of " << cueCount << " match" << Qt::endl;
+    out << "  Edit latency     " << latency.summary() << Qt::endl;
+    out << "  Backup lag       " << lag.summary() << Qt::endl;
+
+    QStringList failures;
+    if (edits < totalEdits) {
+        failures << QString("only %1 of %2 edits made").arg(edits).arg(totalEdits);
+    }
+    if (!caughtUp || gaps > 0 || lagging > 0 || disconnects > 0) {
+        failures << "sequence";
+    }
+    if (mismatched > 0) {
+        failures << QString("%1 names differ").arg(mismatched);
+    }
+    if (latency.isEmpty() || latency.percentile(0.99) > maxLatency) {
+        failures << QString("edit latency p99 above %1 ms").arg(maxLatency);
+    }
+    if (lag.max() > maxLag) {
+        failures << QString("backup lag above %1 ms").arg(maxLag);
+    }
+
+    primary.close();
+    backup.disconnectFromPrimary();
+
+    out << Qt::endl << (failures.isEmpty() ? "PASS" : "FAIL: " + failures.join(", ")) << Qt::endl;
+    return failures.isEmpty() ? 0 : 1;
+}
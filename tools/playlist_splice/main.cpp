@@ -0,0 +1,151 @@
+// ============================================================================
+// main.cpp - Playlist gapless splice check on the null device
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+//
+// Writes a list of tracks of awkward lengths, each a constant level of its
+// own, plays them through one playlist player and checks the output sample
+// by sample: every track must start on the sample right after the previous
+// one ended - no gap, no overlap, no repeated or dropped samples - and the
+// shared read-ahead must never underrun across a boundary.
+//
+//   cueforge-playlist-splice                 12 tracks
+//   cueforge-playlist-splice --tracks 40
+//
+// Exit code: 0 every splice exact, 1 mismatch or underrun, 2 setup error.
+
+#include "audio/JuceAudioEngine.h"
+#include "audio/NullAudioDevice.h"
+#include "golden_audio/AudioCompare.h"
+#include <juce_events/juce_events.h>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+using namespace CueForge;
+
+namespace {
+
+    constexpr double SampleRate = 48000.0;
+    constexpr int BufferSize = 256;
+
+    float trackLevel(int track)
+    {
+        return 0.05f + 0.9f * static_cast<float>(track % 16) / 16.0f;
+    }
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInit;
+
+    int trackCount = 12;
+    for (int i = 1; i < argc; ++i) {
+        const juce::String arg(argv[i]);
+        if (arg == "--tracks" && i + 1 < argc) {
+            trackCount = juce::jlimit(2, 200, juce::String(argv[++i]).getIntValue());
+        } else {
+            std::cerr << "usage: cueforge-playlist-splice [--tracks n]\n";
+            return 2;
+        }
+    }
+
+    // Lengths that don't line up with the block size or the read-ahead chunk
+    const juce::File dir = juce::File::getSpecialLocation(juce::File::tempDirectory)
+        .getChildFile("cueforge-playlist-splice");
+    dir.createDirectory();
+
+    juce::Random random(42);
+    std::vector<std::string> paths;
+    std::vector<int> lengths;
+    int64_t total = 0;
+    for (int track = 0; track < trackCount; ++track) {
+        const int length = 1 + random.nextInt(static_cast<int>(SampleRate * 0.4));
+        juce::AudioBuffer<float> buffer(2, length);
+        for (int channel = 0; channel < 2; ++channel) {
+            juce::FloatVectorOperations::fill(buffer.getWritePointer(channel), trackLevel(track), length);
+        }
+
+        const juce::File file = dir.getChildFile("track" + juce::String(track) + ".wav");
+        if (!writeWav(file, buffer, SampleRate)) {
+            std::cerr << "Cannot write " << file.getFullPathName() << "\n";
+            return 2;
+        }
+        paths.push_back(file.getFullPathName().toStdString());
+        lengths.push_back(length);
+        total += length;
+    }
+
+    NullAudioSettings settings;
+    settings.sampleRate = SampleRate;
+    settings.bufferSize = BufferSize;
+    settings.clock = NullAudioSettings::Clock::Manual;
+    settings.captureRingSeconds = static_cast<double>(total) / SampleRate + 1.0;
+
+    JuceAudioEngine engine;
+    if (!engine.initializeNull(settings) || engine.getNullDevice() == nullptr) {
+        std::cerr << "Null device failed to start\n";
+        return 2;
+    }
+    NullAudioIODevice* device = engine.getNullDevice();
+
+    std::string error;
+    const int id = engine.createPlaylistPlayer(paths, PlaylistPlayer::Options(), &error);
+    if (id < 0) {
+        std::cerr << error << "\n";
+        return 2;
+    }
+    PlaylistPlayer* playlist = engine.getPlaylistPlayer(id);
+    playlist->play();
+
+    // Paced at roughly 4x real time so the read-ahead thread gets turns
+    const int blocks = static_cast<int>(total / BufferSize) + 8;
+    const int blocksPerPause = 16;
+    const int pauseMs = static_cast<int>(1000.0 * blocksPerPause * BufferSize / SampleRate / 4.0);
+    for (int done = 0; done < blocks; done += blocksPerPause) {
+        device->renderBlocks(std::min(blocksPerPause, blocks - done));
+        juce::Thread::sleep(pauseMs);
+    }
+
+    const int64_t underruns = playlist->getUnderruns();
+    const bool finished = playlist->isFinished();
+
+    juce::AudioBuffer<float> captured;
+    device->readCapture(captured, device->getCaptureAvailable());
+    engine.removePlaylistPlayer(id);
+    engine.shutdown();
+    dir.deleteRecursively();
+
+    // The first block ramps the gain in from silence; start checking after it
+    int64_t mismatches = 0;
+    int64_t position = 0;
+    for (int track = 0; track < trackCount; ++track) {
+        for (int i = 0; i < lengths[track]; ++i, ++position) {
+            if (position < BufferSize || position >= captured.getNumSamples()) {
+                continue;
+            }
+            const float expected = trackLevel(track);
+            if (std::abs(captured.getSample(0, static_cast<int>(position)) - expected) > 1.0e-5f) {
+                if (mismatches < 10) {
+                    std::cerr << "  sample " << position << " (track " << track + 1 << "): "
+                              << captured.getSample(0, static_cast<int>(position)) << ", expected " << expected << "\n";
+                }
+                ++mismatches;
+            }
+        }
+    }
+
+    // And silence after the last track
+    for (int64_t i = total; i < captured.getNumSamples(); ++i) {
+        if (captured.getSample(0, static_cast<int>(i)) != 0.0f) {
+            ++mismatches;
+        }
+    }
+
+    const bool pass = mismatches == 0 && underruns == 0 && finished;
+    std::cout << trackCount << " tracks, " << total << " samples: " << mismatches << " mismatched samples, "
+              << underruns << " underruns, " << (finished ? "finished" : "NOT FINISHED") << "\n";
+    std::cout << "\n" << (pass ? "PASS" : "FAIL") << "\n";
+    return pass ? 0 : 1;
+}
@@ -0,0 +1,233 @@
+// ============================================================================
+// main.cpp - Preview bus isolation and load shedding
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+//
+// Checks of the engine's preview bus on a four-output null device, with a
+// show cue on outputs 1-2 and previews routed to outputs 3-4:
+//
+//   1. Isolation: the show outputs must be sample-identical with and
+//      without previews playing, and the preview outputs must carry the
+//      previews.
+//   2. Shedding: with a zero budget every preview voice must be shed in
+//      every block and counted, and no output may change.
+//   3. Load: MaxVoices previews at the default budget; preview load and
+//      shed counts are reported.
+//
+//   cueforge-preview-bus
+//
+// Exit code: 0 pass, 1 mismatch or miscount, 2 setup error.
+
+#include "audio/JuceAudioEngine.h"
+#include "audio/NullAudioDevice.h"
+#include "golden_audio/AudioCompare.h"
+#include <juce_events/juce_events.h>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+using namespace CueForge;
+
+namespace {
+
+    constexpr double SampleRate = 48000.0;
+    constexpr int BufferSize = 256;
+    constexpr int Outputs = 4;
+    constexpr int PreviewOutput = 2;
+    constexpr double Seconds = 2.0;
+
+    juce::File tempFile(const juce::String& name)
+    {
+        return juce::File::getSpecialLocation(juce::File::tempDirectory).getChildFile(name);
+    }
+
+    bool writeTone(const juce::File& file, double frequency)
+    {
+        juce::AudioBuffer<float> tone(2, static_cast<int>(SampleRate * (Seconds + 1.0)));
+        for (int i = 0; i < tone.getNumSamples(); ++i) {
+            const double phase = juce::MathConstants<double>::twoPi * frequency * i / SampleRate;
+            tone.setSample(0, i, 0.25f * static_cast<float>(std::sin(phase)));
+            tone.setSample(1, i, 0.25f * static_cast<float>(std::cos(phase)));
+        }
+        return writeWav(file, tone, SampleRate);
+    }
+
+    struct Render
+    {
+        juce::AudioBuffer<float> output;
+        PreviewBus::Stats stats;
+        int blocks = 0;
+    };
+
+    // Plays the show tone, plus `previews` preview voices of the preview
+    // tone, for Seconds on a manually clocked null device
+    bool render(const juce::File& showTone, const juce::File& previewTone, int previews, double budget,
+        Render& result)
+    {
+        NullAudioSettings settings;
+        settings.sampleRate = SampleRate;
+        settings.bufferSize = BufferSize;
+        settings.outputChannels = Outputs;
+        settings.clock = NullAudioSettings::Clock::Manual;
+        settings.captureRingSeconds = Seconds + 1.0;
+
+        JuceAudioEngine engine;
+        NullAudioIODevice* device = nullptr;
+        if (!engine.initializeNull(settings) || (device = engine.getNullDevice()) == nullptr) {
+            std::cerr << "Null device failed to start\n";
+            return false;
+        }
+
+        engine.setPreviewOutput(PreviewOutput, 1.0f);
+        engine.setPreviewBudget(budget);
+
+        const int show = engine.createPlayer(showTone.getFullPathName().toStdString());
+        if (show < 0) {
+            std::cerr << "Cannot load " << showTone.getFullPathName() << "\n";
+            return false;
+        }
+        engine.getPlayer(show)->play();
+
+        for (int voice = 0; voice < previews; ++voice) {
+            std::string error;
+            const int preview = engine.createPreviewPlayer(previewTone.getFullPathName().toStdString(), &error);
+            if (preview < 0 || !engine.isPreviewPlayer(preview)) {
+                std::cerr << "Preview failed: " << error << "\n";
+                return false;
+            }
+            engine.getPlayer(preview)->play();
+        }
+
+        result.blocks = static_cast<int>(Seconds * SampleRate / BufferSize);
+        device->renderBlocks(result.blocks);
+        device->readCapture(result.output, device->getCaptureAvailable());
+        result.stats = engine.getPreviewStats();
+        engine.shutdown();
+        return true;
+    }
+
+    bool sameChannels(const juce::AudioBuffer<float>& a, const juce::AudioBuffer<float>& b, int first, int count)
+    {
+        if (a.getNumSamples() != b.getNumSamples()) {
+            return false;
+        }
+        for (int ch = first; ch < first + count; ++ch) {
+            const float* x = a.getReadPointer(ch);
+            const float* y = b.getReadPointer(ch);
+            if (!std::equal(x, x + a.getNumSamples(), y)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // RMS of what the previews added to the preview outputs
+    float previewLevel(const juce::AudioBuffer<float>& output, const juce::AudioBuffer<float>& reference)
+    {
+        float level = 0.0f;
+        for (int ch = PreviewOutput; ch < PreviewOutput + 2; ++ch) {
+            juce::AudioBuffer<float> added(1, output.getNumSamples());
+            added.copyFrom(0, 0, output, ch, 0, output.getNumSamples());
+            added.addFrom(0, 0, reference, ch, 0, output.getNumSamples(), -1.0f);
+            level = std::max(level, added.getRMSLevel(0, 0, added.getNumSamples()));
+        }
+        return level;
+    }
+
+    // Returns 0 pass, 1 mismatch, 2 setup error
+    int checkIsolation(const juce::File& showTone, const juce::File& previewTone, const Render& reference)
+    {
+        std::cout << "Show on outputs 1-2, one preview on outputs " << PreviewOutput + 1 << "-" << PreviewOutput + 2 << "\n";
+
+        Render withPreview;
+        if (!render(showTone, previewTone, 1, PreviewBus::DefaultBudget, withPreview)) {
+            return 2;
+        }
+
+        const bool showSame = sameChannels(reference.output, withPreview.output, 0, 2);
+        const float level = previewLevel(withPreview.output, reference.output);
+        const bool ok = showSame && level > 0.1f && withPreview.stats.voiceBlocksShed == 0;
+        std::cout << "  Show outputs " << (showSame ? "identical" : "DIFFER") << ", preview adds "
+                  << juce::Decibels::gainToDecibels(level) << " dBFS RMS, "
+                  << withPreview.stats.voiceBlocksShed << " voice blocks shed" << (ok ? "  ok" : "  FAIL") << "\n";
+        return ok ? 0 : 1;
+    }
+
+    // Returns 0 pass, 1 miscount, 2 setup error
+    int checkShedding(const juce::File& showTone, const juce::File& previewTone, const Render& reference)
+    {
+        std::cout << "\nZero budget, " << PreviewBus::MaxVoices << " previews\n";
+
+        Render shed;
+        if (!render(showTone, previewTone, PreviewBus::MaxVoices, 0.0, shed)) {
+            return 2;
+        }
+
+        const bool showSame = sameChannels(reference.output, shed.output, 0, 2);
+        const bool previewSame = sameChannels(reference.output, shed.output, PreviewOutput, 2);
+        const int64_t expected = static_cast<int64_t>(shed.blocks) * PreviewBus::MaxVoices;
+        const bool ok = showSame && previewSame && shed.stats.blocksShed == shed.blocks
+            && shed.stats.voiceBlocksShed == expected;
+        std::cout << "  " << shed.stats.blocksShed << " of " << shed.blocks << " blocks shed, "
+                  << shed.stats.voiceBlocksShed << " voice blocks (expected " << expected << "), show outputs "
+                  << (showSame ? "identical" : "DIFFER") << ", preview outputs "
+                  << (previewSame ? "untouched" : "CHANGED") << (ok ? "  ok" : "  FAIL") << "\n";
+        return ok ? 0 : 1;
+    }
+
+    // Returns 0 pass, 1 mismatch, 2 setup error
+    int reportLoad(const juce::File& showTone, const juce::File& previewTone, const Render& reference)
+    {
+        std::cout << "\n" << PreviewBus::MaxVoices << " previews at a budget of "
+                  << 100.0 * PreviewBus::DefaultBudget << "% of the block\n";
+
+        Render full;
+        if (!render(showTone, previewTone, PreviewBus::MaxVoices, PreviewBus::DefaultBudget, full)) {
+            return 2;
+        }
+
+        const bool showSame = sameChannels(reference.output, full.output, 0, 2);
+        std::cout << "  Preview load " << 100.0 * full.stats.load << "% of the block period, "
+                  << full.stats.voiceBlocksShed << " voice blocks shed, show outputs "
+                  << (showSame ? "identical" : "DIFFER") << (showSame ? "  ok" : "  FAIL") << "\n";
+        return showSame ? 0 : 1;
+    }
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInit;
+
+    if (argc > 1) {
+        std::cerr << "usage: cueforge-preview-bus\n";
+        return 2;
+    }
+
+    const juce::File showTone = tempFile("cueforge-preview-show.wav");
+    const juce::File previewTone = tempFile("cueforge-preview-audition.wav");
+    if (!writeTone(showTone, 440.0) || !writeTone(previewTone, 660.0)) {
+        std::cerr << "Cannot write test tones\n";
+        return 2;
+    }
+
+    Render reference;
+    int result = render(showTone, previewTone, 0, PreviewBus::DefaultBudget, reference) ? 0 : 2;
+    if (result != 2) {
+        result = std::max(result, checkIsolation(showTone, previewTone, reference));
+    }
+    if (result != 2) {
+        result = std::max(result, checkShedding(showTone, previewTone, reference));
+    }
+    if (result != 2) {
+        result = std::max(result, reportLoad(showTone, previewTone, reference));
+    }
+    showTone.deleteFile();
+    previewTone.deleteFile();
+    if (result == 2) {
+        return 2;
+    }
+
+    std::cout << "\n" << (result == 0 ? "PASS" : "FAIL") << "\n";
+    return result;
+}
@@ -0,0 +1,336 @@
+// ============================================================================
+// main.cpp - Recorder accuracy, drop accounting and disk throughput
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+//
+// Checks of the engine's disk recorders on a null device:
+//
+//   1. Mix: a take of the programme mix, in 32-bit float WAV and 24-bit
+//      FLAC, must match what the device rendered over the same blocks.
+//   2. Inputs: with the null device looped back, a take of the inputs must
+//      match the rendered output one block later.
+//   3. Drops: with the writer thread held back, a full ring must drop
+//      whole blocks and count every one; the file must hold exactly the
+//      blocks that were taken.
+//   4. Throughput: MaxTakes recorders of the mix at once, rendered about
+//      four times faster than real time, must drop nothing. Peak ring
+//      fill is reported.
+//
+//   cueforge-record
+//
+// Exit code: 0 pass, 1 mismatch or drops, 2 setup error.
+
+#include "audio/DiskRecorder.h"
+#include "audio/JuceAudioEngine.h"
+#include "audio/NullAudioDevice.h"
+#include "golden_audio/AudioCompare.h"
+#include <juce_events/juce_events.h>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+using namespace CueForge;
+
+namespace {
+
+    constexpr double SampleRate = 48000.0;
+    constexpr int BufferSize = 256;
+    constexpr int MaxTakes = 8;
+
+    juce::File tempFile(const juce::String& name)
+    {
+        return juce::File::getSpecialLocation(juce::File::tempDirectory).getChildFile(name);
+    }
+
+    bool readAudio(juce::AudioFormatManager& formats, const juce::File& file, juce::AudioBuffer<float>& buffer)
+    {
+        std::unique_ptr<juce::AudioFormatReader> reader(formats.createReaderFor(file));
+        if (!reader) {
+            return false;
+        }
+        buffer.setSize(static_cast<int>(reader->numChannels), static_cast<int>(reader->lengthInSamples));
+        reader->read(&buffer, 0, buffer.getNumSamples(), 0, true, true);
+        return true;
+    }
+
+    // Engine on a manually clocked null device, playing the tone from the
+    // first block
+    struct Rig
+    {
+        JuceAudioEngine engine;
+        NullAudioIODevice* device = nullptr;
+        int player = -1;
+
+        bool start(const juce::File& toneFile, bool loopback)
+        {
+            NullAudioSettings settings;
+            settings.sampleRate = SampleRate;
+            settings.bufferSize = BufferSize;
+            settings.inputChannels = loopback ? 2 : 0;
+            settings.loopback = loopback;
+            settings.clock = NullAudioSettings::Clock::Manual;
+            settings.captureRingSeconds = 12.0;
+
+            if (!engine.initializeNull(settings) || (device = engine.getNullDevice()) == nullptr) {
+                std::cerr << "Null device failed to start\n";
+                return false;
+            }
+            player = engine.createPlayer(toneFile.getFullPathName().toStdString());
+            if (player < 0) {
+                return false;
+            }
+            engine.getPlayer(player)->play();
+            return true;
+        }
+    };
+
+    // Returns 0 pass, 1 mismatch, 2 setup error
+    int checkTakes(juce::AudioFormatManager& formats, const juce::File& toneFile)
+    {
+        std::cout << "Takes of " << BufferSize << "-sample blocks at " << SampleRate << " Hz\n";
+
+        struct Take
+        {
+            const char* label;
+            RecordSettings::Source source;
+            RecordSettings::Format format;
+            int bitDepth;
+            const char* file;
+            double tolerance;
+        };
+        const Take takes[] = {
+            { "Mix, 32-bit float WAV", RecordSettings::Source::Mix, RecordSettings::Format::Wav, 32,
+                "cueforge-record-mix.wav", 1.0e-6 },
+            { "Mix, 24-bit FLAC", RecordSettings::Source::Mix, RecordSettings::Format::Flac, 24,
+                "cueforge-record-mix.flac", 2.0e-7 },
+            { "Looped-back inputs, 32-bit float WAV", RecordSettings::Source::Inputs, RecordSettings::Format::Wav, 32,
+                "cueforge-record-inputs.wav", 1.0e-6 },
+        };
+
+        bool pass = true;
+        for (const Take& take : takes) {
+            const bool inputs = take.source == RecordSettings::Source::Inputs;
+            Rig rig;
+            if (!rig.start(toneFile, inputs)) {
+                return 2;
+            }
+
+            RecordSettings settings;
+            settings.source = take.source;
+            settings.format = take.format;
+            settings.bitDepth = take.bitDepth;
+            settings.preallocateSeconds = 5.0;
+
+            const juce::File file = tempFile(take.file);
+            std::string error;
+            const int recorder = rig.engine.createRecorder(file.getFullPathName().toStdString(), settings, &error);
+            if (recorder < 0 || !rig.engine.startRecorder(recorder)) {
+                std::cerr << "Recorder failed: " << error << "\n";
+                return 2;
+            }
+
+            const int blocks = static_cast<int>(2.0 * SampleRate / BufferSize);
+            rig.device->renderBlocks(blocks);
+            const bool closed = rig.engine.stopRecorder(recorder);
+            const RecordStats stats = rig.engine.getRecorderStats(recorder);
+            rig.engine.removeRecorder(recorder);
+
+            juce::AudioBuffer<float> rendered;
+            rig.device->readCapture(rendered, rig.device->getCaptureAvailable());
+            rig.engine.shutdown();
+
+            juce::AudioBuffer<float> recorded;
+            if (!closed || !readAudio(formats, file, recorded)) {
+                std::cerr << "Cannot read back " << file.getFullPathName() << "\n";
+                return 2;
+            }
+            file.deleteFile();
+
+            // Inputs hear each block one block after it was rendered
+            juce::AudioBuffer<float> expected(rendered.getNumChannels(), rendered.getNumSamples());
+            expected.clear();
+            const int delay = inputs ? BufferSize : 0;
+            for (int ch = 0; ch < expected.getNumChannels(); ++ch) {
+                expected.copyFrom(ch, delay, rendered, ch, 0, rendered.getNumSamples() - delay);
+            }
+
+            CompareSettings compare;
+            compare.peakTolerance = take.tolerance;
+            compare.rmsTolerance = take.tolerance;
+            const CompareResult result = compareAudio(recorded, expected, compare);
+            const bool ok = result.pass && stats.droppedBlocks == 0;
+            pass = pass && ok;
+            std::cout << "  " << take.label << ": " << result.describe(SampleRate) << ", "
+                      << stats.droppedBlocks << " dropped" << (ok ? "  ok" : "  FAIL") << "\n";
+        }
+        return pass ? 0 : 1;
+    }
+
+    // Returns 0 pass, 1 miscount, 2 setup error
+    int checkDrops(juce::AudioFormatManager& formats)
+    {
+        std::cout << "\nRing full with the writer held back\n";
+
+        juce::TimeSliceThread writer("Held disk writer");
+        const juce::File file = tempFile("cueforge-record-drops.wav");
+
+        RecordSettings settings;
+        settings.channels = { 0 };
+        settings.preallocateSeconds = 0.0;
+
+        int64_t taken = 0;
+        int64_t written = 0;
+        RecordStats stats;
+        {
+            DiskRecorder recorder(1, writer);
+            std::string error;
+            if (!recorder.open(file.getFullPathName().toStdString(), settings, SampleRate, &error)) {
+                std::cerr << "Recorder failed: " << error << "\n";
+                return 2;
+            }
+            recorder.start();
+
+            // Twice the ring's length, with nothing draining it
+            std::vector<float> block(BufferSize, 0.25f);
+            const float* channels[] = { block.data() };
+            const int blocks = static_cast<int>(2.0 * DiskRecorder::RingSeconds * SampleRate / BufferSize);
+            for (int i = 0; i < blocks; ++i) {
+                recorder.push(channels, 1, BufferSize);
+            }
+
+            stats = recorder.getStats();
+            taken = stats.samplesRecorded;
+            writer.startThread();
+            recorder.finish();
+            written = recorder.getStats().samplesWritten;
+
+            const int capacity = static_cast<int>(SampleRate * DiskRecorder::RingSeconds) - 1;
+            const int64_t expectedTaken = static_cast<int64_t>(capacity / BufferSize) * BufferSize;
+            const bool ok = taken == expectedTaken
+                && stats.droppedBlocks == blocks - capacity / BufferSize
+                && stats.droppedSamples == stats.droppedBlocks * BufferSize
+                && written == taken;
+            std::cout << "  " << blocks << " blocks pushed: " << taken << " samples taken (expected "
+                      << expectedTaken << "), " << stats.droppedBlocks << " blocks dropped, "
+                      << written << " written" << (ok ? "  ok" : "  FAIL") << "\n";
+            if (!ok) {
+                writer.stopThread(2000);
+                file.deleteFile();
+                return 1;
+            }
+        }
+        writer.stopThread(2000);
+
+        juce::AudioBuffer<float> recorded;
+        const bool read = readAudio(formats, file, recorded);
+        file.deleteFile();
+        const bool ok = read && recorded.getNumSamples() == taken;
+        std::cout << "  File holds " << (read ? recorded.getNumSamples() : 0) << " samples"
+                  << (ok ? "  ok" : "  FAIL") << "\n";
+        return ok ? 0 : 1;
+    }
+
+    // Returns 0 pass, 1 drops, 2 setup error
+    int checkThroughput(const juce::File& toneFile)
+    {
+        std::cout << "\n" << MaxTakes << " takes of the mix at about 4x real time, 24-bit WAV\n";
+
+        Rig rig;
+        if (!rig.start(toneFile, false)) {
+            return 2;
+        }
+
+        RecordSettings settings;
+        settings.source = RecordSettings::Source::Mix;
+        settings.preallocateSeconds = 12.0;
+
+        std::vector<int> recorders;
+        std::vector<juce::File> files;
+        for (int take = 0; take < MaxTakes; ++take) {
+            files.push_back(tempFile("cueforge-record-take-" + juce::String(take) + ".wav"));
+            std::string error;
+            const int id = rig.engine.createRecorder(files.back().getFullPathName().toStdString(), settings, &error);
+            if (id < 0 || !rig.engine.startRecorder(id)) {
+                std::cerr << "Recorder failed: " << error << "\n";
+                return 2;
+            }
+            recorders.push_back(id);
+        }
+
+        const double start = juce::Time::getMillisecondCounterHiRes();
+        const int blocks = static_cast<int>(10.0 * SampleRate / BufferSize);
+        for (int block = 0; block < blocks; ++block) {
+            rig.device->renderBlocks(1);
+            if (block % 4 == 0) {
+                juce::Thread::sleep(5);     // Four blocks per 5 ms
+            }
+        }
+
+        int64_t dropped = 0;
+        double peakFill = 0.0;
+        bool closed = true;
+        for (int id : recorders) {
+            closed = rig.engine.stopRecorder(id) && closed;
+            const RecordStats stats = rig.engine.getRecorderStats(id);
+            dropped += stats.droppedBlocks;
+            peakFill = std::max(peakFill, stats.peakRingFill);
+            rig.engine.removeRecorder(id);
+        }
+        const double seconds = (juce::Time::getMillisecondCounterHiRes() - start) / 1000.0;
+        rig.engine.shutdown();
+
+        int64_t bytes = 0;
+        for (const juce::File& file : files) {
+            bytes += file.getSize();
+            file.deleteFile();
+        }
+
+        const bool ok = closed && dropped == 0;
+        std::cout << "  " << bytes / (1024.0 * 1024.0) << " MB in " << seconds << " s ("
+                  << bytes / (1024.0 * 1024.0) / seconds << " MB/s), peak ring fill "
+                  << 100.0 * peakFill << "%, " << dropped << " blocks dropped" << (ok ? "  ok" : "  FAIL") << "\n";
+        return ok ? 0 : 1;
+    }
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInit;
+
+    if (argc > 1) {
+        std::cerr << "usage: cueforge-record\n";
+        return 2;
+    }
+
+    juce::AudioFormatManager formats;
+    formats.registerBasicFormats();
+
+    juce::AudioBuffer<float> tone(2, static_cast<int>(SampleRate * 12.0));
+    for (int i = 0; i < tone.getNumSamples(); ++i) {
+        const double phase = juce::MathConstants<double>::twoPi * 440.0 * i / SampleRate;
+        tone.setSample(0, i, 0.5f * static_cast<float>(std::sin(phase)));
+        tone.setSample(1, i, 0.5f * static_cast<float>(std::cos(phase)));
+    }
+    const juce::File toneFile = tempFile("cueforge-record-tone.wav");
+    if (!writeWav(toneFile, tone, SampleRate)) {
+        std::cerr << "Cannot write " << toneFile.getFullPathName() << "\n";
+        return 2;
+    }
+
+    int result = checkTakes(formats, toneFile);
+    if (result != 2) {
+        result = std::max(result, checkDrops(formats));
+    }
+    if (result != 2) {
+        result = std::max(result, checkThroughput(toneFile));
+    }
+    toneFile.deleteFile();
+    if (result == 2) {
+        return 2;
+    }
+
+    std::cout << "\n" << (result == 0 ? "PASS" : "FAIL") << "\n";
+    return result;
+}
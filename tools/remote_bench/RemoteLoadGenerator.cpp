@@ -0,0 +1,474 @@
+// ============================================================================
+// RemoteLoadGenerator.cpp - Drives the WebSocket remote API with command mixes
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#include "RemoteLoadGenerator.h"
+#include "network/WebSocketConnection.h"
+#include <QTimer>
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QRandomGenerator>
+#include <QSet>
+#include <chrono>
+
+namespace CueForge {
+
+    namespace {
+        constexpr int ConnectAttemptMs = 500;
+        constexpr int TrialSettleMs = 300;
+        constexpr int TrialListenMs = 500;
+        constexpr int MaxCommandsPerTick = 1000;
+
+        // Same clock the server stamps acks with (steady_clock on this host)
+        qint64 nowNs()
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        // Commands that move the playhead - kept out of background load
+        // while audio trials need a quiet, predictable transport
+        bool isTransportCommand(const QString& cmd)
+        {
+            static const QSet<QString> transport = {
+                "go", "stop", "pause", "panic", "next", "previous", "standby"
+            };
+            return transport.contains(cmd);
+        }
+    }
+
+    RemoteLoadGenerator::RemoteLoadGenerator(const LoadOptions& options, QObject* parent)
+        : QObject(parent)
+        , options_(options)
+        , phase_(Phase::Connecting)
+        , openClients_(0)
+        , loadTimer_(new QTimer(this))
+        , loadSent_(0)
+        , transportInLoad_(true)
+        , trialsDone_(0)
+        , trialGoSentNs_(0)
+        , silentTrials_(0)
+        , sent_(0)
+        , acked_(0)
+        , dropped_(0)
+        , reordered_(0)
+        , unexpected_(0)
+        , deltas_(0)
+    {
+        options_.clients = qMax(1, options_.clients);
+        if (options_.mix.isEmpty()) {
+            options_.mix = parseMix(defaultMix(), nullptr);
+        }
+
+        loadTimer_->setTimerType(Qt::PreciseTimer);
+        loadTimer_->setInterval(1);
+        connect(loadTimer_, &QTimer::timeout, this, &RemoteLoadGenerator::onLoadTick);
+    }
+
+    RemoteLoadGenerator::~RemoteLoadGenerator() = default;
+
+    QString RemoteLoadGenerator::defaultMix()
+    {
+        // Roughly what an operator plus a couple of tablets produce
+        return "state=40,go=15,next=15,previous=10,standby=10,stop=5,pause=5";
+    }
+
+    QList<QPair<QString, int>> RemoteLoadGenerator::parseMix(const QString& text, QString* error)
+    {
+        QList<QPair<QString, int>> mix;
+        const QStringList entries = text.split(',', Qt::SkipEmptyParts);
+
+        for (const QString& entry : entries) {
+            const QStringList parts = entry.split('=');
+            bool ok = false;
+            const int weight = parts.size() == 2 ? parts[1].trimmed().toInt(&ok) : 0;
+            if (!ok || weight < 0 || parts[0].trimmed().isEmpty()) {
+                if (error) {
+                    *error = "bad mix entry: " + entry;
+                }
+                return {};
+            }
+            if (weight > 0) {
+                mix.append({ parts[0].trimmed(), weight });
+            }
+        }
+
+        if (mix.isEmpty() && error) {
+            *error = "empty command mix";
+        }
+        return mix;
+    }
+
+    void RemoteLoadGenerator::start()
+    {
+        clients_.resize(options_.clients);
+        connectClock_.start();
+        for (int i = 0; i < clients_.size(); ++i) {
+            connectClient(i);
+        }
+    }
+
+    // ============================================================================
+    // Connections
+    // ============================================================================
+
+    void RemoteLoadGenerator::connectClient(int index)
+    {
+        Client& client = clients_[index];
+        if (client.connection) {
+            client.connection->abort();
+            client.connection->deleteLater();
+        }
+
+        auto* connection = new WebSocketConnection(this);
+        client.connection = connection;
+
+        connect(connection, &WebSocketConnection::opened, this, [this, index]() { onClientOpened(index); });
+        connect(connection, &WebSocketConnection::textMessageReceived, this,
+            [this, index](const QByteArray& message) { onMessage(index, message); });
+        connect(connection, &WebSocketConnection::closed, this, [this, index, connection]() {
+            if (phase_ != Phase::Connecting && phase_ != Phase::Done
+                && clients_[index].connection == connection) {
+                emit failed(QString("client %1 lost its connection").arg(index));
+            }
+        });
+
+        connection->connectToHost(options_.host, options_.port);
+
+        // A refused connect never reports "closed", so poll for progress and
+        // retry until the server (possibly still starting) accepts us
+        QTimer::singleShot(ConnectAttemptMs, this, [this, index, connection]() {
+            if (phase_ != Phase::Connecting || clients_[index].connection != connection
+                || connection->isOpen()) {
+                return;
+            }
+            if (connectClock_.elapsed() > options_.connectTimeoutMs) {
+                phase_ = Phase::Done;
+                emit failed(QString("could not connect to %1:%2").arg(options_.host).arg(options_.port));
+                return;
+            }
+            connectClient(index);
+        });
+    }
+
+    void RemoteLoadGenerator::onClientOpened(int index)
+    {
+        // Realistic clients watch the show while they send
+        QJsonObject subscribe;
+        subscribe["cmd"] = "subscribe";
+        subscribe["topics"] = QJsonArray{ "standby", "active", "errors" };
+        subscribe["rateHz"] = 30;
+        send(index, subscribe);
+
+        if (++openClients_ == clients_.size()) {
+            QJsonObject state;
+            state["cmd"] = "state";
+            send(0, state);
+            beginLoad();
+        }
+    }
+
+    // ============================================================================
+    // Sending
+    // ============================================================================
+
+    quint64 RemoteLoadGenerator::send(int index, QJsonObject command)
+    {
+        Client& client = clients_[index];
+        const quint64 id = client.nextId++;
+        command["id"] = static_cast<qint64>(id);
+        command["timing"] = true;
+
+        Pending pending;
+        pending.cmd = command["cmd"].toString();
+        pending.sentNs = nowNs();
+        client.pending.insert(id, pending);
+
+        client.connection->sendText(QJsonDocument(command).toJson(QJsonDocument::Compact));
+        sent_++;
+        sentByCommand_[pending.cmd]++;
+        return id;
+    }
+
+    QString RemoteLoadGenerator::pickCommand()
+    {
+        int total = 0;
+        for (const auto& entry : std::as_const(options_.mix)) {
+            if (transportInLoad_ || !isTransportCommand(entry.first)) {
+                total += entry.second;
+            }
+        }
+        if (total == 0) {
+            return "state";
+        }
+
+        int pick = QRandomGenerator::global()->bounded(total);
+        for (const auto& entry : std::as_const(options_.mix)) {
+            if (!transportInLoad_ && isTransportCommand(entry.first)) {
+                continue;
+            }
+            if (pick < entry.second) {
+                return entry.first;
+            }
+            pick -= entry.second;
+        }
+        return "state";
+    }
+
+    void RemoteLoadGenerator::sendLoadCommand(int index)
+    {
+        QString cmd = pickCommand();
+        if (cmd == "standby" && standbyId_.isEmpty()) {
+            cmd = "state";
+        }
+
+        QJsonObject command;
+        command["cmd"] = cmd;
+        if (cmd == "standby") {
+            command["cueId"] = standbyId_;
+        }
+        send(index, command);
+    }
+
+    // ============================================================================
+    // Phases
+    // ============================================================================
+
+    void RemoteLoadGenerator::beginLoad()
+    {
+        phase_ = Phase::Load;
+        loadSent_ = 0;
+        phaseClock_.start();
+        loadTimer_->start();
+    }
+
+    void RemoteLoadGenerator::onLoadTick()
+    {
+        // Clients that carry background load: all of them, except client 0
+        // while it runs audio trials
+        const int first = phase_ == Phase::AudioTrials ? 1 : 0;
+        if (first >= clients_.size()) {
+            return;
+        }
+
+        const qint64 due = static_cast<qint64>(options_.rate * phaseClock_.nsecsElapsed() / 1.0e9);
+        const qint64 owed = qMin<qint64>(due - loadSent_, MaxCommandsPerTick);
+        const int span = clients_.size() - first;
+
+        for (qint64 i = 0; i < owed; ++i) {
+            sendLoadCommand(first + static_cast<int>(loadSent_ % span));
+            loadSent_++;
+        }
+
+        if (phase_ == Phase::Load && phaseClock_.elapsed() >= options_.durationSec * 1000LL) {
+            beginDrain();
+        }
+    }
+
+    void RemoteLoadGenerator::beginDrain()
+    {
+        phase_ = Phase::Drain;
+        loadTimer_->stop();
+        phaseClock_.start();
+        checkDrained();
+    }
+
+    void RemoteLoadGenerator::checkDrained()
+    {
+        if (phase_ != Phase::Drain) {
+            return;
+        }
+
+        int outstanding = 0;
+        for (const Client& client : std::as_const(clients_)) {
+            outstanding += client.pending.size();
+        }
+
+        if (outstanding > 0 && phaseClock_.elapsed() < options_.drainMs) {
+            QTimer::singleShot(20, this, &RemoteLoadGenerator::checkDrained);
+            return;
+        }
+
+        dropped_ += outstanding;
+        for (Client& client : clients_) {
+            client.pending.clear();
+        }
+
+        if (options_.audioTrials > 0) {
+            beginAudioTrials();
+        }
+        else {
+            finish();
+        }
+    }
+
+    void RemoteLoadGenerator::beginAudioTrials()
+    {
+        phase_ = Phase::AudioTrials;
+        trialsDone_ = 0;
+        transportInLoad_ = false;
+
+        // Pin the cue now - every GO advances the standby
+        trialCueId_ = options_.trialCueId.isEmpty() ? standbyId_ : options_.trialCueId;
+
+        // Background load keeps running on the other clients
+        loadSent_ = 0;
+        phaseClock_.start();
+        loadTimer_->start();
+
+        QJsonObject probe;
+        probe["cmd"] = "latencyProbe";
+        probe["enable"] = true;
+        send(0, probe);
+    }
+
+    void RemoteLoadGenerator::runTrial()
+    {
+        if (phase_ != Phase::AudioTrials) {
+            return;
+        }
+
+        if (trialsDone_ >= options_.audioTrials) {
+            QJsonObject probe;
+            probe["cmd"] = "latencyProbe";
+            probe["enable"] = false;
+            send(0, probe);
+            finish();
+            return;
+        }
+
+        // Silence first, so the onset detector re-arms
+        QJsonObject panic;
+        panic["cmd"] = "panic";
+        send(0, panic);
+
+        QTimer::singleShot(TrialSettleMs, this, [this]() {
+            QJsonObject go;
+            go["cmd"] = "go";
+            if (!trialCueId_.isEmpty()) {
+                go["cueId"] = trialCueId_;
+            }
+            const quint64 id = send(0, go);
+            trialGoSentNs_ = clients_[0].pending.value(id).sentNs;
+
+            QTimer::singleShot(TrialListenMs, this, [this]() {
+                QJsonObject probe;
+                probe["cmd"] = "latencyProbe";
+                send(0, probe);
+            });
+        });
+    }
+
+    void RemoteLoadGenerator::onTrialAck(const QString& cmd, const QJsonObject& ack, qint64 sentNs)
+    {
+        Q_UNUSED(sentNs);
+
+        if (cmd != "latencyProbe") {
+            return;
+        }
+
+        if (!ack["ok"].toBool()) {
+            audioProbeError_ = ack["error"].toString();
+            finish();
+            return;
+        }
+
+        // The enable ack arrives before any GO has been sent
+        if (trialGoSentNs_ == 0) {
+            runTrial();
+            return;
+        }
+
+        const qint64 onsetNs = static_cast<qint64>(ack["onsetNs"].toDouble());
+        if (onsetNs > trialGoSentNs_) {
+            audioLatency_.add((onsetNs - trialGoSentNs_) / 1.0e6 + ack["outputLatencyMs"].toDouble());
+        }
+        else {
+            silentTrials_++;
+        }
+
+        trialsDone_++;
+        trialGoSentNs_ = 0;
+        runTrial();
+    }
+
+    void RemoteLoadGenerator::finish()
+    {
+        if (phase_ == Phase::Done) {
+            return;
+        }
+
+        phase_ = Phase::Done;
+        loadTimer_->stop();
+
+        for (Client& client : clients_) {
+            if (client.connection) {
+                client.connection->close();
+            }
+        }
+
+        emit finished();
+    }
+
+    // ============================================================================
+    // Receiving
+    // ============================================================================
+
+    void RemoteLoadGenerator::onMessage(int index, const QByteArray& message)
+    {
+        const QJsonObject object = QJsonDocument::fromJson(message).object();
+        const QString type = object["type"].toString();
+
+        if (type == "ack") {
+            handleAck(index, object);
+        }
+        else if (type == "delta") {
+            deltas_++;
+            if (object.contains("standby")) {
+                standbyId_ = object["standby"].toObject()["id"].toString();
+            }
+        }
+    }
+
+    void RemoteLoadGenerator::handleAck(int index, const QJsonObject& ack)
+    {
+        const qint64 receivedNs = nowNs();
+        Client& client = clients_[index];
+
+        const quint64 id = static_cast<quint64>(ack["id"].toDouble());
+        auto it = client.pending.find(id);
+        if (it == client.pending.end()) {
+            // Duplicate, or an ack for a command already written off as dropped
+            unexpected_++;
+            return;
+        }
+
+        const Pending pending = it.value();
+        client.pending.erase(it);
+        acked_++;
+
+        if (id < client.highestAckId) {
+            reordered_++;
+        }
+        client.highestAckId = qMax(client.highestAckId, id);
+
+        ackLatency_.add((receivedNs - pending.sentNs) / 1.0e6);
+        if (ack.contains("execNs")) {
+            executeLatency_.add((static_cast<qint64>(ack["execNs"].toDouble()) - pending.sentNs) / 1.0e6);
+        }
+
+        if (!ack["ok"].toBool()) {
+            rejectedByCommand_[pending.cmd]++;
+        }
+
+        if (pending.cmd == "state" && ack.contains("standby")) {
+            standbyId_ = ack["standby"].toObject()["id"].toString();
+        }
+
+        if (phase_ == Phase::AudioTrials && index == 0) {
+            onTrialAck(pending.cmd, ack, pending.sentNs);
+        }
+    }
+
+} // namespace CueForge
@@ -0,0 +1,157 @@
+// ============================================================================
+// RemoteLoadGenerator.h - Drives the WebSocket remote API with command mixes
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+
+#pragma once
+
+#include "common/LatencyStats.h"
+#include <QObject>
+#include <QString>
+#include <QList>
+#include <QPair>
+#include <QHash>
+#include <QMap>
+#include <QElapsedTimer>
+#include <QJsonObject>
+
+QT_BEGIN_NAMESPACE
+class QTimer;
+QT_END_NAMESPACE
+
+namespace CueForge {
+
+    class WebSocketConnection;
+
+    struct LoadOptions
+    {
+        QString host = "127.0.0.1";
+        quint16 port = 53000;
+        int clients = 4;
+        double rate = 200.0;            // Commands per second, all clients together
+        int durationSec = 10;
+        QList<QPair<QString, int>> mix; // Command name and weight
+        int audioTrials = 0;
+        QString trialCueId;             // Cue fired by audio trials (default: standby)
+        int connectTimeoutMs = 5000;
+        int drainMs = 2000;
+    };
+
+    /**
+     * Floods the remote API from several WebSocket clients at a fixed total
+     * rate with a weighted command mix, then optionally runs GO-to-audio
+     * trials while background load continues.
+     *
+     * Every command carries a per-client increasing id and "timing":true, so
+     * each ack yields a round-trip latency and (from the server's steady
+     * clock stamps) a command-to-execute latency. Acks that never arrive are
+     * counted as dropped; acks arriving below an already-seen id as reordered.
+     */
+    class RemoteLoadGenerator : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        explicit RemoteLoadGenerator(const LoadOptions& options, QObject* parent = nullptr);
+        ~RemoteLoadGenerator() override;
+
+        void start();
+
+        // "state=40,go=15,..." - returns an empty list and sets error on failure
+        static QList<QPair<QString, int>> parseMix(const QString& text, QString* error);
+        static QString defaultMix();
+
+        const LatencyStats& ackLatency() const { return ackLatency_; }
+        const LatencyStats& executeLatency() const { return executeLatency_; }
+        const LatencyStats& audioLatency() const { return audioLatency_; }
+
+        qint64 sent() const { return sent_; }
+        qint64 acked() const { return acked_; }
+        qint64 dropped() const { return dropped_; }
+        qint64 reordered() const { return reordered_; }
+        qint64 unexpected() const { return unexpected_; }
+        qint64 deltasReceived() const { return deltas_; }
+        int silentTrials() const { return silentTrials_; }
+        QString audioProbeError() const { return audioProbeError_; }
+
+        // Per command: sent and rejected (ok:false) counts
+        const QMap<QString, qint64>& sentByCommand() const { return sentByCommand_; }
+        const QMap<QString, qint64>& rejectedByCommand() const { return rejectedByCommand_; }
+
+    signals:
+        void finished();
+        void failed(const QString& reason);
+
+    private:
+        enum class Phase {
+            Connecting,
+            Load,
+            Drain,
+            AudioTrials,
+            Done
+        };
+
+        struct Pending {
+            qint64 sentNs = 0;
+            QString cmd;
+        };
+
+        struct Client {
+            WebSocketConnection* connection = nullptr;
+            quint64 nextId = 1;
+            quint64 highestAckId = 0;
+            QHash<quint64, Pending> pending;
+        };
+
+        void connectClient(int index);
+        void onClientOpened(int index);
+        void onMessage(int index, const QByteArray& message);
+        void handleAck(int index, const QJsonObject& ack);
+
+        quint64 send(int index, QJsonObject command);
+        void sendLoadCommand(int index);
+        QString pickCommand();
+
+        void beginLoad();
+        void onLoadTick();
+        void beginDrain();
+        void checkDrained();
+        void beginAudioTrials();
+        void runTrial();
+        void onTrialAck(const QString& cmd, const QJsonObject& ack, qint64 sentNs);
+        void finish();
+
+        LoadOptions options_;
+        Phase phase_;
+        QList<Client> clients_;
+        int openClients_;
+
+        QTimer* loadTimer_;
+        QElapsedTimer phaseClock_;
+        QElapsedTimer connectClock_;
+        qint64 loadSent_;
+        bool transportInLoad_;  // false while audio trials own the transport
+
+        QString standbyId_;
+
+        // Audio trials run on client 0
+        QString trialCueId_;
+        int trialsDone_;
+        qint64 trialGoSentNs_;
+        int silentTrials_;
+        QString audioProbeError_;
+
+        LatencyStats ackLatency_;
+        LatencyStats executeLatency_;
+        LatencyStats audioLatency_;
+        qint64 sent_;
+        qint64 acked_;
+        qint64 dropped_;
+        qint64 reordered_;
+        qint64 unexpected_;
+        qint64 deltas_;
+        QMap<QString, qint64> sentByCommand_;
+        QMap<QString, qint64> rejectedByCommand_;
+    };
+
+} // namespace CueForge
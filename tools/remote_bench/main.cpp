@@ -0,0 +1,162 @@
+// ============================================================================
+// main.cpp - Remote GO latency benchmark and load generator
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+//
+// Floods a CueForge instance's WebSocket remote API on localhost and reports
+// ack, command-to-execute and (with --audio-trials) command-to-audio latency
+// percentiles, plus dropped/reordered commands. Exits non-zero when a gate
+// fails, so release checks can run it as-is:
+//
+//   cueforge-remote-bench --launch ./CueForge --duration 30 --audio-trials 20 \
+//       --max-p99-ms 5 --max-audio-p99-ms 30
+//
+// Audio trials need a workspace whose trial cue is an audio cue; the server
+// stamps the first audible block via the engine's onset probe. A launched
+// server renders on the real-time null device unless --device-audio is
+// given, so the bench runs the same on a machine without a soundcard.
+
+#include "RemoteLoadGenerator.h"
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QProcess>
+#include <QTextStream>
+
+using namespace CueForge;
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("cueforge-remote-bench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Load generator and latency benchmark for the CueForge remote API");
+    parser.addHelpOption();
+    parser.addOptions({
+        { "host", "Remote API host (default 127.0.0.1).", "host", "127.0.0.1" },
+        { "port", "Remote API port (default 53000).", "port", "53000" },
+        { "clients", "Concurrent WebSocket clients (default 4).", "n", "4" },
+        { "rate", "Total commands per second (default 200).", "hz", "200" },
+        { "duration", "Load phase length in seconds (default 10).", "s", "10" },
+        { "mix", "Weighted command mix (default " + RemoteLoadGenerator::defaultMix() + ").", "mix" },
+        { "audio-trials", "GO-to-audio trials after the load phase (default 0).", "n", "0" },
+        { "trial-cue", "Cue id fired by audio trials (default: standby cue).", "id" },
+        { "launch", "Start this CueForge executable with --remote-port first.", "program" },
+        { "launch-args", "Extra arguments for --launch, space separated.", "args" },
+        { "null-audio", "Null device spec for --launch (default \"default\").", "spec", "default" },
+        { "device-audio", "Let --launch open the default soundcard instead of the null device." },
+        { "max-p99-ms", "Fail if ack p99 exceeds this.", "ms" },
+        { "max-audio-p99-ms", "Fail if command-to-audio p99 exceeds this.", "ms" },
+    });
+    parser.process(app);
+
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    LoadOptions options;
+    options.host = parser.value("host");
+    options.port = static_cast<quint16>(parser.value("port").toUInt());
+    options.clients = parser.value("clients").toInt();
+    options.rate = parser.value("rate").toDouble();
+    options.durationSec = parser.value("duration").toInt();
+    options.audioTrials = parser.value("audio-trials").toInt();
+    options.trialCueId = parser.value("trial-cue");
+
+    if (parser.isSet("mix")) {
+        QString error;
+        options.mix = RemoteLoadGenerator::parseMix(parser.value("mix"), &error);
+        if (options.mix.isEmpty()) {
+            err << error << Qt::endl;
+            return 2;
+        }
+    }
+
+    QProcess server;
+    if (parser.isSet("launch")) {
+        QStringList args = { "--remote-port", QString::number(options.port) };
+        if (!parser.isSet("device-audio")) {
+            args << "--null-audio" << parser.value("null-audio");
+        }
+        args += parser.value("launch-args").split(' ', Qt::SkipEmptyParts);
+        server.setProcessChannelMode(QProcess::ForwardedErrorChannel);
+        server.start(parser.value("launch"), args);
+        if (!server.waitForStarted(5000)) {
+            err << "Failed to launch " << parser.value("launch") << ": " << server.errorString() << Qt::endl;
+            return 2;
+        }
+        options.connectTimeoutMs = 20000;
+    }
+
+    RemoteLoadGenerator generator(options);
+    int exitCode = 0;
+
+    QObject::connect(&generator, &RemoteLoadGenerator::failed, &app, [&](const QString& reason) {
+        err << "FAILED: " << reason << Qt::endl;
+        exitCode = 2;
+        app.quit();
+    });
+
+    QObject::connect(&generator, &RemoteLoadGenerator::finished, &app, [&]() {
+        out << "commands  sent=" << generator.sent() << "  acked=" << generator.acked()
+            << "  dropped=" << generator.dropped() << "  reordered=" << generator.reordered()
+            << "  unexpected=" << generator.unexpected()
+            << "  deltas=" << generator.deltasReceived() << Qt::endl;
+
+        const auto& sentBy = generator.sentByCommand();
+        for (auto it = sentBy.constBegin(); it != sentBy.constEnd(); ++it) {
+            out << "  " << it.key().leftJustified(14) << it.value();
+            const qint64 rejected = generator.rejectedByCommand().value(it.key());
+            if (rejected > 0) {
+                out << "  (rejected " << rejected << ")";
+            }
+            out << Qt::endl;
+        }
+
+        out << "ack       " << generator.ackLatency().summary() << Qt::endl;
+        out << "execute   " << generator.executeLatency().summary() << Qt::endl;
+
+        if (options.audioTrials > 0) {
+            if (!generator.audioProbeError().isEmpty()) {
+                out << "audio     unavailable: " << generator.audioProbeError() << Qt::endl;
+            }
+            else {
+                out << "audio     " << generator.audioLatency().summary()
+                    << "  silent=" << generator.silentTrials() << Qt::endl;
+            }
+        }
+
+        // Gates
+        if (generator.dropped() > 0 || generator.reordered() > 0 || generator.unexpected() > 0) {
+            err << "GATE: dropped or reordered commands" << Qt::endl;
+            exitCode = 1;
+        }
+        if (parser.isSet("max-p99-ms")
+            && generator.ackLatency().percentile(0.99) > parser.value("max-p99-ms").toDouble()) {
+            err << "GATE: ack p99 above " << parser.value("max-p99-ms") << " ms" << Qt::endl;
+            exitCode = 1;
+        }
+        if (parser.isSet("max-audio-p99-ms") && options.audioTrials > 0) {
+            const LatencyStats& audio = generator.audioLatency();
+            if (audio.isEmpty() || audio.percentile(0.99) > parser.value("max-audio-p99-ms").toDouble()) {
+                err << "GATE: command-to-audio p99 above " << parser.value("max-audio-p99-ms")
+                    << " ms (or no audible trials)" << Qt::endl;
+                exitCode = 1;
+            }
+        }
+
+        app.quit();
+    });
+
+    generator.start();
+    app.exec();
+
+    if (server.state() != QProcess::NotRunning) {
+        server.terminate();
+        if (!server.waitForFinished(3000)) {
+            server.kill();
+            server.waitForFinished(1000);
+        }
+    }
+
+    return exitCode;
+}
@@ -0,0 +1,330 @@
+// ============================================================================
+// main.cpp - Cue serialization throughput benchmark
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+//
+// Measures cues per second for every cue type through toJson()/fromJson(),
+// the encode/decode cost of each on-disk format (indented JSON, compact
+// JSON, CBOR), and a full CueManager save/load of a generated show against
+// a plain write+read of the same bytes - the I/O floor a save or load
+// should approach.
+//
+//   cueforge-serialize-bench --cues 20000 --repeats 5 --csv serialize.csv
+
+#include "core/CueManager.h"
+#include "core/cues/AudioCue.h"
+#include "core/cues/ControlCue.h"
+#include "core/cues/GroupCue.h"
+#include "core/cues/NetworkCue.h"
+#include "core/cues/VideoCue.h"
+#include "core/cues/WaitCue.h"
+#include "common/ShowGenerator.h"
+#include <QCborValue>
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QTemporaryFile>
+#include <QTextStream>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <vector>
+
+using namespace CueForge;
+
+namespace {
+
+    struct CueKind
+    {
+        QString name;
+        std::function<Cue*()> create;
+        std::function<void(QJsonObject&, int)> fill;   // Type specific fields
+    };
+
+    std::vector<CueKind> cueKinds()
+    {
+        return {
+            { "Audio", [] { return new AudioCue(); }, [](QJsonObject& json, int i) {
+                // No file: probing the asset is I/O, not serialization
+                json["volume"] = 0.5 + (i % 5) * 0.1;
+                json["pan"] = -0.5 + (i % 3) * 0.5;
+                json["rate"] = 1.0;
+                json["startTime"] = 0.25;
+                json["endTime"] = 12.0 + i % 4;
+                json["audioOutputPatch"] = "Main";
+                QJsonObject routing;
+                for (int ch = 0; ch < 4; ++ch) {
+                    routing[QString("%1:%2").arg(ch).arg(ch % 2)] = -6.0 * ch;
+                }
+                json["matrixRouting"] = routing;
+            } },
+            { "Video", [] { return new VideoCue(); }, [](QJsonObject& json, int i) {
+                json["opacity"] = 0.9;
+                json["volume"] = 0.8;
+                json["startTime"] = 1.0;
+                json["endTime"] = 30.0 + i % 10;
+                json["loopEnabled"] = i % 2 == 0;
+                json["videoStage"] = "Main";
+                json["geometry"] = QJsonObject{ { "x", 0 }, { "y", 0 }, { "width", 1920 }, { "height", 1080 } };
+            } },
+            { "Network", [] { return new NetworkCue(); }, [](QJsonObject& json, int i) {
+                json["protocol"] = i % 2 ? "http" : "tcp";
+                json["message"] = QString("/scene/%1/go").arg(i);
+                json["httpMethod"] = "POST";
+                json["httpPath"] = "/api/cue";
+                json["contentType"] = "application/json";
+                json["expectReply"] = true;
+                json["timeoutMs"] = 1500;
+                // No host: an endpoint would warm a pooled connection
+            } },
+            { "Wait", [] { return new WaitCue(); }, [](QJsonObject&, int) {} },
+            { "Control", [] { return new ControlCue(CueType::Start); }, [](QJsonObject& json, int i) {
+                json["targetCueId"] = QString("target-%1").arg(i);
+                json["fadeTime"] = 2.0;
+            } },
+            { "Group", [] { return new GroupCue(); }, [](QJsonObject& json, int) {
+                json["mode"] = "Simultaneous";
+            } },
+        };
+    }
+
+    QJsonObject makeCueJson(const CueKind& kind, int i)
+    {
+        QJsonObject json;
+        json["id"] = QString("bench-%1-%2").arg(kind.name).arg(i);
+        json["type"] = kind.name == "Control" ? "Start" : kind.name;
+        json["number"] = QString::number(i + 1);
+        json["name"] = QString("%1 cue %2").arg(kind.name).arg(i + 1);
+        json["duration"] = 1.0 + i % 7;
+        json["preWait"] = i % 3 ? 0.0 : 0.5;
+        json["continueMode"] = i % 4 == 0;
+        json["color"] = "#4080c0";
+        json["notes"] = i % 5 ? QString() : QString("Standby on the line \"%1\" - watch the LX cue").arg(i);
+        json["isArmed"] = true;
+        json["createdTime"] = "2026-01-10T19:30:00";
+        json["modifiedTime"] = "2026-01-11T14:05:12";
+        kind.fill(json, i);
+        return json;
+    }
+
+    // ------------------------------------------------------------------------
+    // Formats
+    // ------------------------------------------------------------------------
+
+    struct Format
+    {
+        QString name;
+        std::function<QByteArray(const QJsonObject&)> encode;
+        std::function<QJsonObject(const QByteArray&)> decode;
+    };
+
+    std::vector<Format> formats()
+    {
+        return {
+            { "json",
+              [](const QJsonObject& o) { return QJsonDocument(o).toJson(QJsonDocument::Indented); },
+              [](const QByteArray& b) { return QJsonDocument::fromJson(b).object(); } },
+            { "json-compact",
+              [](const QJsonObject& o) { return QJsonDocument(o).toJson(QJsonDocument::Compact); },
+              [](const QByteArray& b) { return QJsonDocument::fromJson(b).object(); } },
+            { "cbor",
+              [](const QJsonObject& o) { return QCborValue::fromJsonValue(o).toCbor(); },
+              [](const QByteArray& b) { return QCborValue::fromCbor(b).toJsonValue().toObject(); } },
+        };
+    }
+
+    // ------------------------------------------------------------------------
+    // Measurement
+    // ------------------------------------------------------------------------
+
+    // Median seconds over repeats
+    double measure(int repeats, const std::function<void()>& body)
+    {
+        std::vector<double> samples;
+        for (int r = 0; r < repeats; ++r) {
+            QElapsedTimer timer;
+            timer.start();
+            body();
+            samples.push_back(timer.nsecsElapsed() / 1.0e9);
+        }
+        std::sort(samples.begin(), samples.end());
+        return samples[samples.size() / 2];
+    }
+
+    QString rate(double items, double seconds)
+    {
+        const double perSecond = seconds > 0.0 ? items / seconds : 0.0;
+        if (perSecond >= 1.0e6) {
+            return QString::number(perSecond / 1.0e6, 'f', 2) + "M/s";
+        }
+        return QString::number(perSecond / 1.0e3, 'f', 1) + "k/s";
+    }
+
+    void quietMessageHandler(QtMsgType type, const QMessageLogContext&, const QString& message)
+    {
+        if (type == QtDebugMsg || type == QtInfoMsg || type == QtWarningMsg) {
+            return;
+        }
+        QTextStream(stderr) << message << Qt::endl;
+    }
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("cueforge-serialize-bench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Cue serialization throughput per type and format");
+    parser.addHelpOption();
+    parser.addOptions({
+        { "cues", "Cues per type, and size of the generated show (default 20000).", "n", "20000" },
+        { "repeats", "Measurements per case; the median is kept (default 5).", "n", "5" },
+        { "seed", "Generated show seed (default 1).", "n", "1" },
+        { "csv", "Also write results to this CSV file.", "file" },
+        { "verbose", "Keep debug and warning output." },
+    });
+    parser.process(app);
+
+    if (!parser.isSet("verbose")) {
+        qInstallMessageHandler(quietMessageHandler);
+    }
+
+    const int count = qMax(100, parser.value("cues").toInt());
+    const int repeats = qMax(1, parser.value("repeats").toInt());
+    const std::vector<Format> formatList = formats();
+
+    QTextStream out(stdout);
+    QString csv = "case,type,format,items,seconds,items_per_second\n";
+    auto record = [&](const QString& what, const QString& type, const QString& format, double items, double seconds) {
+        csv += QString("%1,%2,%3,%4,%5,%6\n").arg(what, type, format).arg(items).arg(seconds, 0, 'f', 6)
+            .arg(seconds > 0.0 ? items / seconds : 0.0, 0, 'f', 0);
+    };
+
+    // ------------------------------------------------------------------------
+    // Per cue type
+    // ------------------------------------------------------------------------
+    out << "Per type, " << count << " cues, median of " << repeats << Qt::endl;
+    out << QString("type").leftJustified(10) << QString("toJson").rightJustified(11) << QString("fromJson").rightJustified(11);
+    for (const Format& format : formatList) {
+        out << (format.name + " enc").rightJustified(18) << (format.name + " dec").rightJustified(18);
+    }
+    out << Qt::endl;
+
+    for (const CueKind& kind : cueKinds()) {
+        std::vector<std::unique_ptr<Cue>> cues;
+        QJsonArray source;
+        for (int i = 0; i < count; ++i) {
+            cues.emplace_back(kind.create());
+            source.append(makeCueJson(kind, i));
+        }
+
+        const double fromSeconds = measure(repeats, [&] {
+            for (int i = 0; i < count; ++i) {
+                cues[i]->fromJson(source[i].toObject());
+            }
+        });
+
+        QJsonArray saved;
+        const double toSeconds = measure(repeats, [&] {
+            QJsonArray array;
+            for (const auto& cue : cues) {
+                array.append(cue->toJson());
+            }
+            saved = array;
+        });
+
+        record("toJson", kind.name, "-", count, toSeconds);
+        record("fromJson", kind.name, "-", count, fromSeconds);
+        out << kind.name.leftJustified(10) << rate(count, toSeconds).rightJustified(11)
+            << rate(count, fromSeconds).rightJustified(11);
+
+        const QJsonObject document{ { "cues", saved } };
+        for (const Format& format : formatList) {
+            QByteArray bytes;
+            const double encodeSeconds = measure(repeats, [&] { bytes = format.encode(document); });
+            QJsonObject decoded;
+            const double decodeSeconds = measure(repeats, [&] { decoded = format.decode(bytes); });
+
+            record("encode", kind.name, format.name, count, encodeSeconds);
+            record("decode", kind.name, format.name, count, decodeSeconds);
+            out << rate(count, encodeSeconds).rightJustified(18) << rate(count, decodeSeconds).rightJustified(18);
+        }
+        out << Qt::endl;
+    }
+
+    // ------------------------------------------------------------------------
+    // Whole show through CueManager vs the I/O floor
+    // ------------------------------------------------------------------------
+    ShowProfile profile;
+    profile.cues = count;
+    profile.seed = parser.value("seed").toUInt();
+    profile.assetDir = QDir::temp().filePath("cueforge-serialize-bench-audio");
+    const QJsonObject workspace = ShowGenerator(profile).generateWorkspace();
+
+    CueManager loaded;
+    loaded.loadWorkspace(workspace);
+
+    out << Qt::endl << "Generated show, " << count << " cues" << Qt::endl;
+    out << QString("format").leftJustified(14) << QString("bytes").rightJustified(12)
+        << QString("save").rightJustified(11) << QString("load").rightJustified(11)
+        << QString("write+read").rightJustified(12) << QString("save/io").rightJustified(9)
+        << QString("load/io").rightJustified(9) << Qt::endl;
+
+    for (const Format& format : formatList) {
+        const QByteArray bytes = format.encode(loaded.saveWorkspace());
+
+        const double saveSeconds = measure(repeats, [&] {
+            const QByteArray encoded = format.encode(loaded.saveWorkspace());
+            Q_UNUSED(encoded);
+        });
+
+        const double loadSeconds = measure(repeats, [&] {
+            CueManager manager;
+            manager.loadWorkspace(format.decode(bytes));
+        });
+
+        // Same bytes through the filesystem; the page cache makes this the
+        // best case a save/load could reach
+        QTemporaryFile file;
+        const double ioSeconds = file.open() ? measure(repeats, [&] {
+            file.resize(0);
+            file.seek(0);
+            file.write(bytes);
+            file.flush();
+            file.seek(0);
+            const QByteArray readBack = file.readAll();
+            Q_UNUSED(readBack);
+        }) : 0.0;
+
+        record("save", "show", format.name, count, saveSeconds);
+        record("load", "show", format.name, count, loadSeconds);
+        record("io", "show", format.name, count, ioSeconds);
+
+        out << format.name.leftJustified(14) << QString::number(bytes.size()).rightJustified(12)
+            << rate(count, saveSeconds).rightJustified(11) << rate(count, loadSeconds).rightJustified(11)
+            << rate(count, ioSeconds).rightJustified(12)
+            << QString::number(ioSeconds > 0.0 ? saveSeconds / ioSeconds : 0.0, 'f', 1).rightJustified(8) << "x"
+            << QString::number(ioSeconds > 0.0 ? loadSeconds / ioSeconds : 0.0, 'f', 1).rightJustified(8) << "x"
+            << Qt::endl;
+    }
+
+    if (parser.isSet("csv")) {
+        QFile file(parser.value("csv"));
+        if (file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            file.write(csv.toUtf8());
+        }
+        else {
+            qWarning() << "Cannot write" << file.fileName();
+        }
+    }
+
+    out << Qt::endl << "Rates are cues per second; save/io and load/io are multiples of the write+read time." << Qt::endl;
+    return 0;
+}
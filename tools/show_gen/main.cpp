@@ -0,0 +1,84 @@
+// ============================================================================
+// main.cpp - Synthetic show generator
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+//
+// Writes a reproducible workspace plus the audio files it references, so
+// load/save, render and UI benchmarks can all run on the same corpus.
+//
+//   cueforge-show-gen --cues 5000 --seed 7 --out corpus/5k
+//     -> corpus/5k/show.cueforge, corpus/5k/audio/asset_0000.wav ...
+
+#include "common/ShowGenerator.h"
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QJsonDocument>
+#include <QTextStream>
+
+using namespace CueForge;
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("cueforge-show-gen");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Generate a synthetic CueForge workspace with realistic shape");
+    parser.addHelpOption();
+    parser.addOptions({
+        { "cues", "Total cue count including groups (default 1000).", "n", "1000" },
+        { "seed", "Random seed (default 1).", "n", "1" },
+        { "out", "Output directory (default ./show-<cues>-<seed>).", "dir" },
+        { "max-depth", "Deepest group nesting (default 4).", "n", "4" },
+        { "assets", "Audio files in the pool (default: audio cues / 4, at most 64).", "n", "0" },
+        { "asset-max-seconds", "Longest generated audio file (default 10).", "s", "10" },
+        { "no-assets", "Write the workspace only; audio files are referenced but not created." },
+        { "compact", "Write compact rather than indented JSON." },
+    });
+    parser.process(app);
+
+    ShowProfile profile;
+    profile.cues = qMax(1, parser.value("cues").toInt());
+    profile.seed = parser.value("seed").toUInt();
+    profile.maxGroupDepth = qMax(0, parser.value("max-depth").toInt());
+    profile.assetCount = qMax(0, parser.value("assets").toInt());
+    profile.assetMaxSeconds = qMax(profile.assetMinSeconds, parser.value("asset-max-seconds").toDouble());
+
+    const QString outDir = parser.isSet("out")
+        ? parser.value("out")
+        : QString("show-%1-%2").arg(profile.cues).arg(profile.seed);
+    QDir dir(outDir);
+    if (!dir.mkpath(".")) {
+        qCritical() << "Cannot create" << outDir;
+        return 1;
+    }
+    profile.assetDir = dir.absoluteFilePath("audio");
+
+    ShowGenerator generator(profile);
+    const QJsonObject workspace = generator.generateWorkspace();
+
+    QFile file(dir.filePath("show.cueforge"));
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCritical() << "Cannot write" << file.fileName();
+        return 1;
+    }
+    file.write(QJsonDocument(workspace).toJson(
+        parser.isSet("compact") ? QJsonDocument::Compact : QJsonDocument::Indented));
+    file.close();
+
+    if (!parser.isSet("no-assets")) {
+        QString error;
+        if (!generator.writeAssets(&error)) {
+            qCritical() << error;
+            return 1;
+        }
+    }
+
+    QTextStream out(stdout);
+    out << file.fileName() << Qt::endl;
+    out << generator.summary() << Qt::endl;
+    return 0;
+}
@@ -0,0 +1,405 @@
+// ============================================================================
+// main.cpp - Long-run soak test: memory growth and timing drift
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+//
+// Loops a show through CueManager on the null audio device for hours,
+// firing GOs far faster than an operator would. Every sample interval it
+// records process memory, allocator usage, handle counts, engine players,
+// ErrorHandler entries, callback load, audio clock drift and GO latency.
+// At the end a least-squares slope per hour is fitted to each metric
+// (after a warm-up) and any upward trend above its limit fails the run.
+//
+//   cueforge-soak --hours 4 --cues 400 --go-interval-ms 150 --csv soak.csv
+
+#include "core/CueManager.h"
+#include "core/Cue.h"
+#include "core/ErrorHandler.h"
+#include "audio/AudioEngineQt.h"
+#include "audio/LockProfiler.h"
+#include "network/ConnectionPool.h"
+#include "common/LatencyStats.h"
+#include "common/ProcessStats.h"
+#include "common/ShowGenerator.h"
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QTextStream>
+#include <QTimer>
+#include <functional>
+#include <memory>
+#include <vector>
+
+using namespace CueForge;
+
+namespace {
+
+    struct Sample
+    {
+        double hours = 0.0;
+        double rssMb = 0.0;
+        double heapMb = 0.0;
+        double handles = 0.0;
+        double players = 0.0;
+        double errors = 0.0;
+        double load = 0.0;
+        double xruns = 0.0;
+        double driftMs = 0.0;
+        double goP95Ms = 0.0;
+        double onsetMs = 0.0;
+    };
+
+    struct Metric
+    {
+        QString name;
+        QString unit;
+        std::function<double(const Sample&)> value;
+        double maxSlopePerHour;   // < 0 disables the check
+        bool optional;            // Skip when the platform reports -1
+    };
+
+    // Least-squares slope of value against time
+    double slopePerHour(const std::vector<Sample>& samples, const std::function<double(const Sample&)>& value)
+    {
+        const double n = static_cast<double>(samples.size());
+        if (n < 3) {
+            return 0.0;
+        }
+
+        double sumX = 0, sumY = 0, sumXX = 0, sumXY = 0;
+        for (const Sample& s : samples) {
+            const double y = value(s);
+            sumX += s.hours;
+            sumY += y;
+            sumXX += s.hours * s.hours;
+            sumXY += s.hours * y;
+        }
+
+        const double denominator = n * sumXX - sumX * sumX;
+        return denominator > 0.0 ? (n * sumXY - sumX * sumY) / denominator : 0.0;
+    }
+
+    bool verboseLogging = false;
+
+    void soakMessageHandler(QtMsgType type, const QMessageLogContext&, const QString& message)
+    {
+        // Hours of GOs produce millions of debug lines and per-cue warnings
+        if (!verboseLogging && type != QtCriticalMsg && type != QtFatalMsg) {
+            return;
+        }
+        QTextStream(stderr) << message << Qt::endl;
+    }
+
+    QString firstAudioCueId(CueManager& manager)
+    {
+        for (const auto& cue : manager.allCues()) {
+            if (cue->type() == CueType::Audio) {
+                return cue->id();
+            }
+        }
+        return QString();
+    }
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("cueforge-soak");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Long-run soak test for memory growth and timing drift");
+    parser.addHelpOption();
+    parser.addOptions({
+        { "hours", "Run length in hours (default 1).", "h", "1" },
+        { "workspace", "Workspace file to loop instead of a generated show.", "file" },
+        { "cues", "Generated show size (default 300).", "n", "300" },
+        { "seed", "Generated show seed (default 1).", "n", "1" },
+        { "asset-max-seconds", "Longest generated audio file (default 3).", "s", "3" },
+        { "go-interval-ms", "Time between GOs (default 200).", "ms", "200" },
+        { "sample-seconds", "Time between samples (default 10).", "s", "10" },
+        { "trial-seconds", "Time between GO-to-audio onset trials (default 60).", "s", "60" },
+        { "warmup", "Fraction of the run ignored by the trend fit (default 0.1).", "x", "0.1" },
+        { "null-audio", "Null device spec (default clock=realtime,ring=0).", "spec", "clock=realtime,ring=0" },
+        { "csv", "Also write samples to this CSV file.", "file" },
+        { "max-rss-mb-per-hour", "Resident memory growth limit (default 16).", "x", "16" },
+        { "max-heap-mb-per-hour", "Allocator in-use growth limit (default 16).", "x", "16" },
+        { "max-handles-per-hour", "Handle count growth limit (default 10).", "x", "10" },
+        { "max-players-per-hour", "Engine player count growth limit (default 5).", "x", "5" },
+        { "max-errors-per-hour", "ErrorHandler entry growth limit (default 50).", "x", "50" },
+        { "max-load-per-hour", "Callback load growth limit, 0..1 (default 0.05).", "x", "0.05" },
+        { "max-drift-ms-per-hour", "Audio clock vs wall clock drift limit (default 20).", "x", "20" },
+        { "max-latency-ms-per-hour", "GO p95 latency growth limit (default 1).", "x", "1" },
+        { "lock-profile", "Profile engine lock wait/hold times and print them at the end." },
+        { "verbose", "Keep debug and warning output." },
+    });
+    parser.process(app);
+
+    verboseLogging = parser.isSet("verbose");
+    qInstallMessageHandler(soakMessageHandler);
+
+    QTextStream out(stdout);
+    const double hours = parser.value("hours").toDouble();
+    const qint64 runMs = static_cast<qint64>(hours * 3600.0 * 1000.0);
+    const double warmupHours = hours * qBound(0.0, parser.value("warmup").toDouble(), 0.9);
+
+    // Core systems, wired the way main.cpp wires them
+    ErrorHandler errorHandler;
+    AudioEngineQt audioEngine;
+    CueManager cueManager;
+
+    if (!audioEngine.initializeNull(parser.value("null-audio"))) {
+        qCritical() << "Null audio device failed to start";
+        return 1;
+    }
+    cueManager.setAudioEngine(&audioEngine);
+    audioEngine.setLockProfilingEnabled(parser.isSet("lock-profile"));
+
+    QObject::connect(&cueManager, &CueManager::error, &errorHandler,
+        [&errorHandler](const QString& message) { errorHandler.reportError(message, "CueManager"); });
+    QObject::connect(&cueManager, &CueManager::warning, &errorHandler,
+        [&errorHandler](const QString& message) { errorHandler.reportWarning(message, "CueManager"); });
+    QObject::connect(&audioEngine, &AudioEngineQt::error, &errorHandler,
+        [&errorHandler](const QString& message) { errorHandler.reportError(message, "AudioEngine"); });
+
+    // Show
+    QJsonObject workspace;
+    if (parser.isSet("workspace")) {
+        QFile file(parser.value("workspace"));
+        if (!file.open(QIODevice::ReadOnly)) {
+            qCritical() << "Cannot open" << file.fileName();
+            return 1;
+        }
+        workspace = QJsonDocument::fromJson(file.readAll()).object();
+    }
+    else {
+        ShowProfile profile;
+        profile.cues = qMax(10, parser.value("cues").toInt());
+        profile.seed = parser.value("seed").toUInt();
+        profile.assetMaxSeconds = qMax(profile.assetMinSeconds, parser.value("asset-max-seconds").toDouble());
+        profile.assetDir = QDir::temp().filePath("cueforge-soak-audio");
+
+        ShowGenerator generator(profile);
+        workspace = generator.generateWorkspace();
+        QString error;
+        if (!generator.writeAssets(&error)) {
+            qCritical() << error;
+            return 1;
+        }
+        out << "Generated " << generator.summary() << Qt::endl;
+    }
+
+    if (!cueManager.loadWorkspace(workspace) || cueManager.cueCount() == 0) {
+        qCritical() << "Workspace did not load";
+        return 1;
+    }
+
+    const QString firstCueId = cueManager.allCues().first()->id();
+    const QString trialCueId = firstAudioCueId(cueManager);
+    cueManager.setStandByCue(firstCueId);
+
+    // ------------------------------------------------------------------------
+    // GO loop
+    // ------------------------------------------------------------------------
+    LatencyStats goWindow;
+    qint64 goCount = 0;
+    int loops = 0;
+
+    QTimer goTimer;
+    goTimer.setInterval(qMax(1, parser.value("go-interval-ms").toInt()));
+    QObject::connect(&goTimer, &QTimer::timeout, [&]() {
+        if (!cueManager.standByCue()) {
+            // End of the list - stop everything and go round again
+            cueManager.panic();
+            cueManager.setStandByCue(firstCueId);
+            ++loops;
+            return;
+        }
+
+        QElapsedTimer timer;
+        timer.start();
+        cueManager.go();
+        goWindow.add(timer.nsecsElapsed() / 1.0e6);
+        ++goCount;
+    });
+
+    // ------------------------------------------------------------------------
+    // GO-to-audio onset trials (panic, then GO into silence)
+    // ------------------------------------------------------------------------
+    double lastOnsetMs = 0.0;
+    qint64 trialStartNs = 0;
+    QElapsedTimer trialClock;
+
+    QTimer trialPoll;
+    trialPoll.setInterval(2);
+    QObject::connect(&trialPoll, &QTimer::timeout, [&]() {
+        const qint64 onset = audioEngine.lastAudioOnsetNanos();
+        if (onset > trialStartNs || trialClock.elapsed() > 1000) {
+            if (onset > trialStartNs) {
+                lastOnsetMs = (onset - trialStartNs) / 1.0e6 + audioEngine.outputLatencyMs();
+            }
+            trialPoll.stop();
+            audioEngine.setLatencyProbeEnabled(false);
+            goTimer.start();
+        }
+    });
+
+    QTimer trialTimer;
+    trialTimer.setInterval(qMax(1, parser.value("trial-seconds").toInt()) * 1000);
+    QObject::connect(&trialTimer, &QTimer::timeout, [&]() {
+        if (trialCueId.isEmpty() || trialPoll.isActive()) {
+            return;
+        }
+        goTimer.stop();
+        cueManager.panic();
+
+        // Let the last block drain so the probe sees silence first
+        QTimer::singleShot(150, &app, [&]() {
+            audioEngine.setLatencyProbeEnabled(true);
+            trialClock.start();
+            trialStartNs = monotonicNanoseconds();
+            cueManager.goCue(trialCueId);
+            trialPoll.start();
+        });
+    });
+
+    // ------------------------------------------------------------------------
+    // Sampling
+    // ------------------------------------------------------------------------
+    std::vector<Sample> samples;
+    QElapsedTimer wallClock;
+    wallClock.start();
+    const double audioClockStart = audioEngine.audioClockSeconds();
+
+    std::unique_ptr<QFile> csvFile;
+    std::unique_ptr<QTextStream> csv;
+    if (parser.isSet("csv")) {
+        csvFile = std::make_unique<QFile>(parser.value("csv"));
+        if (csvFile->open(QIODevice::WriteOnly | QIODevice::Text)) {
+            csv = std::make_unique<QTextStream>(csvFile.get());
+            *csv << "hours,rss_mb,heap_mb,handles,players,errors,load,xruns,drift_ms,go_p95_ms,onset_ms,gos,loops" << Qt::endl;
+        }
+    }
+
+    out << "  hours   RSS MB  heap MB  handles  players  errors   load  xruns  drift ms  GO p95 ms  onset ms" << Qt::endl;
+
+    auto takeSample = [&]() {
+        const ProcessStats process = ProcessStats::sample();
+
+        Sample s;
+        s.hours = wallClock.elapsed() / 3600000.0;
+        s.rssMb = process.residentMb;
+        s.heapMb = process.heapMb;
+        s.handles = process.handles;
+        s.players = audioEngine.playerCount();
+        s.errors = errorHandler.errors().size();
+        s.load = audioEngine.callbackLoad();
+        s.xruns = audioEngine.xrunCount();
+        s.driftMs = (wallClock.elapsed() / 1000.0 - (audioEngine.audioClockSeconds() - audioClockStart)) * 1000.0;
+        s.goP95Ms = goWindow.isEmpty() ? 0.0 : goWindow.percentile(0.95);
+        s.onsetMs = lastOnsetMs;
+        samples.push_back(s);
+        goWindow.clear();
+
+        out << QString("%1 %2 %3 %4 %5 %6 %7 %8 %9 %10 %11")
+            .arg(s.hours, 7, 'f', 3).arg(s.rssMb, 8, 'f', 1).arg(s.heapMb, 8, 'f', 1)
+            .arg(s.handles, 8, 'f', 0).arg(s.players, 8, 'f', 0).arg(s.errors, 7, 'f', 0)
+            .arg(s.load, 6, 'f', 3).arg(s.xruns, 6, 'f', 0).arg(s.driftMs, 9, 'f', 1)
+            .arg(s.goP95Ms, 10, 'f', 3).arg(s.onsetMs, 9, 'f', 2) << Qt::endl;
+
+        if (csv) {
+            *csv << s.hours << ',' << s.rssMb << ',' << s.heapMb << ',' << s.handles << ','
+                 << s.players << ',' << s.errors << ',' << s.load << ',' << s.xruns << ','
+                 << s.driftMs << ',' << s.goP95Ms << ',' << s.onsetMs << ',' << goCount << ','
+                 << loops << Qt::endl;
+        }
+    };
+
+    QTimer sampleTimer;
+    sampleTimer.setInterval(qMax(1, parser.value("sample-seconds").toInt()) * 1000);
+    QObject::connect(&sampleTimer, &QTimer::timeout, takeSample);
+
+    QTimer::singleShot(runMs, &app, [&]() {
+        goTimer.stop();
+        trialTimer.stop();
+        trialPoll.stop();
+        sampleTimer.stop();
+        takeSample();
+        app.quit();
+    });
+
+    takeSample();
+    goTimer.start();
+    trialTimer.start();
+    sampleTimer.start();
+    app.exec();
+
+    cueManager.panic();
+    audioEngine.shutdown();
+
+    // ------------------------------------------------------------------------
+    // Trend analysis
+    // ------------------------------------------------------------------------
+    std::vector<Sample> steady;
+    for (const Sample& s : samples) {
+        if (s.hours >= warmupHours) {
+            steady.push_back(s);
+        }
+    }
+
+    const std::vector<Metric> metrics = {
+        { "RSS", "MB", [](const Sample& s) { return s.rssMb; }, parser.value("max-rss-mb-per-hour").toDouble(), true },
+        { "Heap", "MB", [](const Sample& s) { return s.heapMb; }, parser.value("max-heap-mb-per-hour").toDouble(), true },
+        { "Handles", "", [](const Sample& s) { return s.handles; }, parser.value("max-handles-per-hour").toDouble(), true },
+        { "Players", "", [](const Sample& s) { return s.players; }, parser.value("max-players-per-hour").toDouble(), false },
+        { "Errors", "", [](const Sample& s) { return s.errors; }, parser.value("max-errors-per-hour").toDouble(), false },
+        { "Callback load", "", [](const Sample& s) { return s.load; }, parser.value("max-load-per-hour").toDouble(), false },
+        { "Clock drift", "ms", [](const Sample& s) { return s.driftMs; }, parser.value("max-drift-ms-per-hour").toDouble(), false },
+        { "GO p95", "ms", [](const Sample& s) { return s.goP95Ms; }, parser.value("max-latency-ms-per-hour").toDouble(), false },
+    };
+
+    out << Qt::endl << goCount << " GOs, " << loops << " loops, "
+        << (samples.empty() ? 0.0 : samples.back().xruns) << " xruns, "
+        << steady.size() << " samples after warm-up" << Qt::endl;
+    out << "Metric            start        end    slope/h      limit" << Qt::endl;
+
+    bool passed = true;
+    for (const Metric& metric : metrics) {
+        if (steady.size() < 3) {
+            break;
+        }
+        if (metric.optional && metric.value(steady.front()) < 0.0) {
+            out << QString("%1  n/a on this platform").arg(metric.name, -14) << Qt::endl;
+            continue;
+        }
+
+        const double slope = slopePerHour(steady, metric.value);
+        const bool ok = metric.maxSlopePerHour < 0.0 || slope <= metric.maxSlopePerHour;
+        passed = passed && ok;
+
+        out << QString("%1 %2 %3 %4 %5  %6")
+            .arg(metric.name + (metric.unit.isEmpty() ? QString() : " (" + metric.unit + ")"), -14)
+            .arg(metric.value(steady.front()), 10, 'f', 2)
+            .arg(metric.value(steady.back()), 10, 'f', 2)
+            .arg(slope, 10, 'f', 3)
+            .arg(metric.maxSlopePerHour, 10, 'f', 3)
+            .arg(ok ? "ok" : "TRENDING UP") << Qt::endl;
+    }
+
+    if (parser.isSet("lock-profile")) {
+        out << Qt::endl << "Engine locks (by total wait)" << Qt::endl
+            << QString::fromStdString(LockProfiler::describe());
+    }
+
+    if (steady.size() < 3) {
+        out << "Too few samples after warm-up for a trend - run longer or sample more often" << Qt::endl;
+        return 2;
+    }
+
+    out << (passed ? "Soak PASSED" : "Soak FAILED") << Qt::endl;
+    return passed ? 0 : 1;
+}
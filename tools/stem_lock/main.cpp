@@ -0,0 +1,198 @@
+// ============================================================================
+// main.cpp - Stem player sample-lock check on the null device
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+//
+// Writes a set of stems (mono and stereo) that each carry the same impulse
+// train, plays them through one stem player with every stem channel routed
+// to its own null device output, and checks that each impulse lands on the
+// same output sample on every channel - once with stems at the device rate
+// and once resampled - and that the shared read-ahead never underran.
+//
+//   cueforge-stem-lock                 12 mono + 2 stereo stems
+//   cueforge-stem-lock --stems 8       8 mono + 2 stereo stems
+//
+// Exit code: 0 all stems locked, 1 drift or underrun, 2 setup error.
+
+#include "audio/JuceAudioEngine.h"
+#include "audio/NullAudioDevice.h"
+#include "golden_audio/AudioCompare.h"
+#include <juce_events/juce_events.h>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+using namespace CueForge;
+
+namespace {
+
+    constexpr double DeviceRate = 48000.0;
+    constexpr int BufferSize = 256;
+    constexpr double StemSeconds = 3.0;
+    constexpr int StereoStems = 2;
+    const std::vector<double> ImpulseSeconds{ 0.1, 1.0, 2.5 };
+
+    std::vector<juce::File> writeStems(int monoStems, double fileRate)
+    {
+        const juce::File dir = juce::File::getSpecialLocation(juce::File::tempDirectory)
+            .getChildFile("cueforge-stem-lock");
+        dir.createDirectory();
+
+        std::vector<juce::File> files;
+        const int length = static_cast<int>(StemSeconds * fileRate);
+        for (int i = 0; i < monoStems + StereoStems; ++i) {
+            juce::AudioBuffer<float> stem(i < monoStems ? 1 : 2, length);
+            stem.clear();
+            for (int channel = 0; channel < stem.getNumChannels(); ++channel) {
+                for (double seconds : ImpulseSeconds) {
+                    stem.setSample(channel, static_cast<int>(seconds * fileRate), 1.0f);
+                }
+            }
+
+            const juce::File file = dir.getChildFile(juce::String("stem") + juce::String(i) + "-"
+                + juce::String(static_cast<int>(fileRate)) + ".wav");
+            if (!writeWav(file, stem, fileRate)) {
+                return {};
+            }
+            files.push_back(file);
+        }
+        return files;
+    }
+
+    // Loudest sample within +-window of the expected position
+    int peakNear(const juce::AudioBuffer<float>& buffer, int channel, int expected, int window)
+    {
+        int best = -1;
+        float bestLevel = 0.1f;
+        const int from = std::max(0, expected - window);
+        const int to = std::min(buffer.getNumSamples(), expected + window);
+        for (int i = from; i < to; ++i) {
+            const float level = std::abs(buffer.getSample(channel, i));
+            if (level > bestLevel) {
+                bestLevel = level;
+                best = i;
+            }
+        }
+        return best;
+    }
+
+    // Returns false on a setup failure; locked/underruns report the result
+    bool run(int monoStems, double fileRate, bool& locked, int64_t& underruns)
+    {
+        const std::vector<juce::File> files = writeStems(monoStems, fileRate);
+        if (files.empty()) {
+            std::cerr << "Cannot write stems\n";
+            return false;
+        }
+        const int outputs = monoStems + 2 * StereoStems;
+
+        NullAudioSettings settings;
+        settings.sampleRate = DeviceRate;
+        settings.bufferSize = BufferSize;
+        settings.outputChannels = outputs;
+        settings.clock = NullAudioSettings::Clock::Manual;
+        settings.captureRingSeconds = StemSeconds + 1.0;
+
+        JuceAudioEngine engine;
+        if (!engine.initializeNull(settings) || engine.getNullDevice() == nullptr) {
+            std::cerr << "Null device failed to start\n";
+            return false;
+        }
+        NullAudioIODevice* device = engine.getNullDevice();
+
+        std::vector<std::string> paths;
+        for (const juce::File& file : files) {
+            paths.push_back(file.getFullPathName().toStdString());
+        }
+
+        std::string error;
+        const int id = engine.createStemPlayer(paths, &error);
+        if (id < 0) {
+            std::cerr << error << "\n";
+            return false;
+        }
+        StemPlayer* stems = engine.getStemPlayer(id);
+
+        // Every stem channel to its own output
+        int output = 0;
+        for (int stem = 0; stem < stems->getNumStems(); ++stem) {
+            stems->clearRoutes(stem);
+            for (int channel = 0; channel < stems->getStemChannels(stem); ++channel) {
+                stems->setRoute(stem, channel, output++, 1.0f);
+            }
+        }
+
+        stems->play();
+
+        // Paced at roughly 4x real time so the read-ahead thread gets turns,
+        // as it would against a hardware callback
+        const int blocks = static_cast<int>(StemSeconds * DeviceRate / BufferSize) + 4;
+        const int blocksPerPause = 16;
+        const int pauseMs = static_cast<int>(1000.0 * blocksPerPause * BufferSize / DeviceRate / 4.0);
+        for (int done = 0; done < blocks; done += blocksPerPause) {
+            device->renderBlocks(std::min(blocksPerPause, blocks - done));
+            juce::Thread::sleep(pauseMs);
+        }
+
+        underruns = stems->getUnderruns();
+
+        juce::AudioBuffer<float> captured;
+        device->readCapture(captured, device->getCaptureAvailable());
+        engine.removeStemPlayer(id);
+        engine.shutdown();
+
+        for (const juce::File& file : files) {
+            file.deleteFile();
+        }
+
+        locked = true;
+        for (double seconds : ImpulseSeconds) {
+            const int expected = static_cast<int>(seconds * DeviceRate);
+            const int reference = peakNear(captured, 0, expected, BufferSize * 4);
+
+            for (int channel = 1; channel < outputs; ++channel) {
+                const int position = peakNear(captured, channel, expected, BufferSize * 4);
+                if (reference < 0 || position != reference) {
+                    std::cerr << "  impulse at " << seconds << " s: output 1 at " << reference
+                              << ", output " << channel + 1 << " at " << position << "\n";
+                    locked = false;
+                }
+            }
+        }
+        return true;
+    }
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInit;
+
+    int monoStems = 12;
+    for (int i = 1; i < argc; ++i) {
+        const juce::String arg(argv[i]);
+        if (arg == "--stems" && i + 1 < argc) {
+            monoStems = juce::jlimit(1, StemPlayer::MaxStems - StereoStems, juce::String(argv[++i]).getIntValue());
+        } else {
+            std::cerr << "usage: cueforge-stem-lock [--stems n]\n";
+            return 2;
+        }
+    }
+
+    bool pass = true;
+    for (double fileRate : { DeviceRate, 44100.0 }) {
+        bool locked = false;
+        int64_t underruns = 0;
+        if (!run(monoStems, fileRate, locked, underruns)) {
+            return 2;
+        }
+
+        pass = pass && locked && underruns == 0;
+        std::cout << monoStems << " mono + " << StereoStems << " stereo stems at " << fileRate << " Hz: "
+                  << (locked ? "sample-locked" : "DRIFT") << ", " << underruns << " underruns"
+                  << ((locked && underruns == 0) ? "  ok" : "  FAIL") << "\n";
+    }
+
+    std::cout << "\n" << (pass ? "PASS" : "FAIL") << "\n";
+    return pass ? 0 : 1;
+}
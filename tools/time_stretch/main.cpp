@@ -0,0 +1,235 @@
+// ============================================================================
+// main.cpp - Time-stretch accuracy, pitch and per-voice cost
+// CueForge Qt6 - Professional show control software
+// ============================================================================
+//
+// Three checks of the WSOLA time stretch:
+//
+//   1. Identity: a render at rate 1.0 must reproduce noise to within
+//      float rounding, so the frame bookkeeping adds no offset or gain.
+//   2. Render: a 440 Hz tone rendered at 0.5x..2x must come out
+//      length / rate samples long and still at 440 Hz. Render time per
+//      second of output is reported.
+//   3. Live: 1 to MaxLiveStretchVoices players stretch live on a null
+//      device paced at about twice real time, with the rate swept while
+//      they play; no block may underrun. Load per voice is reported.
+//
+//   cueforge-time-stretch
+//
+// Exit code: 0 pass, 1 mismatch or underruns, 2 setup error.
+
+#include "audio/JuceAudioEngine.h"
+#include "audio/NullAudioDevice.h"
+#include "audio/TimeStretch.h"
+#include "golden_audio/AudioCompare.h"
+#include <juce_events/juce_events.h>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+using namespace CueForge;
+
+namespace {
+
+    constexpr double SampleRate = 48000.0;
+    constexpr int BufferSize = 256;
+    constexpr double Frequency = 440.0;
+
+    juce::File tempFile(const char* name)
+    {
+        return juce::File::getSpecialLocation(juce::File::tempDirectory).getChildFile(name);
+    }
+
+    // Frequency from the spacing of rising zero crossings, skipping the
+    // first and last 10% where the stretch starts and ends
+    double measureFrequency(const juce::AudioBuffer<float>& buffer, int channel)
+    {
+        const int from = buffer.getNumSamples() / 10;
+        const int to = buffer.getNumSamples() - from;
+        int first = -1;
+        int last = -1;
+        int crossings = 0;
+        for (int i = from + 1; i < to; ++i) {
+            if (buffer.getSample(channel, i - 1) < 0.0f && buffer.getSample(channel, i) >= 0.0f) {
+                first = first < 0 ? i : first;
+                last = i;
+                ++crossings;
+            }
+        }
+        return crossings > 1 ? (crossings - 1) * SampleRate / (last - first) : 0.0;
+    }
+
+    std::unique_ptr<juce::AudioFormatReader> openReader(juce::AudioFormatManager& formats, const juce::File& file)
+    {
+        return std::unique_ptr<juce::AudioFormatReader>(formats.createReaderFor(file));
+    }
+
+    // Returns 0 pass, 1 mismatch, 2 setup error
+    int checkIdentity(juce::AudioFormatManager& formats)
+    {
+        juce::AudioBuffer<float> noise(2, static_cast<int>(SampleRate * 2.0));
+        juce::Random random(3);
+        for (int channel = 0; channel < 2; ++channel) {
+            for (int i = 0; i < noise.getNumSamples(); ++i) {
+                noise.setSample(channel, i, 0.5f * (random.nextFloat() * 2.0f - 1.0f));
+            }
+        }
+
+        const juce::File file = tempFile("cueforge-time-stretch-noise.wav");
+        if (!writeWav(file, noise, SampleRate)) {
+            std::cerr << "Cannot write " << file.getFullPathName() << "\n";
+            return 2;
+        }
+        auto reader = openReader(formats, file);
+        if (!reader) {
+            return 2;
+        }
+
+        auto rendered = TimeStretchCache::render(*reader, 1.0);
+        reader.reset();
+        file.deleteFile();
+
+        const CompareResult result = compareAudio(rendered->audio, noise, CompareSettings());
+        std::cout << "Identity at 1.0x: " << result.describe(SampleRate) << (result.pass ? "  ok" : "  FAIL") << "\n";
+        return result.pass ? 0 : 1;
+    }
+
+    // Returns 0 pass, 1 mismatch, 2 setup error
+    int checkRenders(juce::AudioFormatManager& formats, const juce::File& toneFile)
+    {
+        bool pass = true;
+        std::cout << "\nRendered stretch of a " << Frequency << " Hz tone\n";
+        for (double rate : { 0.5, 0.75, 1.25, 1.5, 2.0 }) {
+            auto reader = openReader(formats, toneFile);
+            if (!reader) {
+                return 2;
+            }
+
+            auto rendered = TimeStretchCache::render(*reader, rate);
+            const int expectedLength = static_cast<int>(std::ceil(reader->lengthInSamples / rate));
+            const double frequency = measureFrequency(rendered->audio, 0);
+            const double outputSeconds = rendered->audio.getNumSamples() / SampleRate;
+
+            const bool ok = rendered->audio.getNumSamples() == expectedLength
+                && std::abs(frequency - Frequency) < Frequency * 0.01;
+            pass = pass && ok;
+
+            std::cout << "  " << rate << "x: " << rendered->audio.getNumSamples() << " samples (expected "
+                      << expectedLength << "), " << frequency << " Hz, render "
+                      << 1000.0 * rendered->renderSeconds / outputSeconds << " ms per output second"
+                      << (ok ? "  ok" : "  FAIL") << "\n";
+        }
+        return pass ? 0 : 1;
+    }
+
+    // Returns 0 pass, 1 underruns or wrong pitch, 2 setup error
+    int checkLive(const juce::File& toneFile)
+    {
+        std::cout << "\nLive stretch, rate swept 0.8x..1.6x while playing, "
+                  << BufferSize << "-sample blocks at " << SampleRate << " Hz\n";
+
+        bool pass = true;
+        for (int voices : { 1, 4, JuceAudioEngine::MaxLiveStretchVoices }) {
+            NullAudioSettings settings;
+            settings.sampleRate = SampleRate;
+            settings.bufferSize = BufferSize;
+            settings.clock = NullAudioSettings::Clock::Manual;
+            settings.captureRingSeconds = 4.0;
+
+            JuceAudioEngine engine;
+            if (!engine.initializeNull(settings) || engine.getNullDevice() == nullptr) {
+                std::cerr << "Null device failed to start\n";
+                return 2;
+            }
+            NullAudioIODevice* device = engine.getNullDevice();
+
+            std::vector<int> players;
+            for (int voice = 0; voice < voices; ++voice) {
+                const int id = engine.createPlayer(toneFile.getFullPathName().toStdString());
+                std::string error;
+                if (id < 0 || !engine.setPlayerTimeStretch(id, 0.8, true, &error)) {
+                    std::cerr << "Live stretch setup failed: " << error << "\n";
+                    return 2;
+                }
+                engine.getPlayer(id)->setVolume(1.0f / voices);
+                players.push_back(id);
+            }
+            for (int id : players) {
+                engine.getPlayer(id)->play();
+            }
+
+            const int blocks = static_cast<int>(3.0 * SampleRate / BufferSize);
+            for (int block = 0; block < blocks; ++block) {
+                const double rate = 0.8 + 0.8 * block / blocks;
+                for (int id : players) {
+                    engine.setPlayerStretchRate(id, rate);
+                }
+                device->renderBlocks(1);
+                juce::Thread::sleep(block % 2 == 0 ? 2 : 3);     // About twice real time
+            }
+
+            juce::AudioBuffer<float> captured;
+            device->readCapture(captured, device->getCaptureAvailable());
+
+            double load = 0.0;
+            int64_t underruns = 0;
+            for (int id : players) {
+                const StretchStats stats = engine.getPlayerStretchStats(id);
+                load += stats.load;
+                underruns += stats.underruns;
+                engine.removePlayer(id);
+            }
+            engine.shutdown();
+
+            // Identical voices sum to the tone, so the pitch still shows
+            const double frequency = measureFrequency(captured, 0);
+            const bool ok = underruns == 0 && std::abs(frequency - Frequency) < Frequency * 0.02;
+            pass = pass && ok;
+            std::cout << "  " << voices << " voices: " << 100.0 * load / voices << "% of a core per voice, "
+                      << underruns << " underruns, " << frequency << " Hz" << (ok ? "  ok" : "  FAIL") << "\n";
+        }
+        return pass ? 0 : 1;
+    }
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInit;
+
+    if (argc > 1) {
+        std::cerr << "usage: cueforge-time-stretch\n";
+        return 2;
+    }
+
+    juce::AudioFormatManager formats;
+    formats.registerBasicFormats();
+
+    juce::AudioBuffer<float> tone(2, static_cast<int>(SampleRate * 4.0));
+    for (int i = 0; i < tone.getNumSamples(); ++i) {
+        const float sample = 0.5f * static_cast<float>(std::sin(juce::MathConstants<double>::twoPi * Frequency * i / SampleRate));
+        tone.setSample(0, i, sample);
+        tone.setSample(1, i, sample);
+    }
+    const juce::File toneFile = tempFile("cueforge-time-stretch-tone.wav");
+    if (!writeWav(toneFile, tone, SampleRate)) {
+        std::cerr << "Cannot write " << toneFile.getFullPathName() << "\n";
+        return 2;
+    }
+
+    int result = checkIdentity(formats);
+    if (result != 2) {
+        result = std::max(result, checkRenders(formats, toneFile));
+    }
+    if (result != 2) {
+        result = std::max(result, checkLive(toneFile));
+    }
+    toneFile.deleteFile();
+    if (result == 2) {
+        return 2;
+    }
+
+    std::cout << "\n" << (result == 0 ? "PASS" : "FAIL") << "\n";
+    return result;
+}